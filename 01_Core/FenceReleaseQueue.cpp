@@ -0,0 +1,56 @@
+#include "FenceReleaseQueue.h"
+
+#include <vector>
+
+FenceReleaseQueue::~FenceReleaseQueue()
+{
+    ReleaseAll();
+}
+
+void FenceReleaseQueue::Enqueue(std::uint64_t fence, std::function<void()> release)
+{
+    if (!release)
+        return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // 보통은 펜스가 커지는 순서로 들어오므로 뒤에 붙는다.
+    auto it = mEntries.end();
+    while (it != mEntries.begin() && (it - 1)->Fence > fence)
+        --it;
+
+    Entry entry;
+    entry.Fence = fence;
+    entry.Release = std::move(release);
+    mEntries.insert(it, std::move(entry));
+}
+
+size_t FenceReleaseQueue::ReleaseCompleted(std::uint64_t completedValue)
+{
+    // 해제 콜백이 다시 Enqueue할 수 있으므로 잠금 밖에서 해제한다.
+    std::vector<Entry> released;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        while (!mEntries.empty() && mEntries.front().Fence <= completedValue)
+        {
+            released.push_back(std::move(mEntries.front()));
+            mEntries.pop_front();
+        }
+    }
+
+    for (Entry& entry : released)
+        entry.Release();
+
+    return released.size();
+}
+
+void FenceReleaseQueue::ReleaseAll()
+{
+    ReleaseCompleted(UINT64_MAX);
+}
+
+size_t FenceReleaseQueue::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+// 펜스 값을 키로 해제를 미루는 큐
+// GPU가 아직 쓰고 있을 수 있는 리소스/힙/디스크립터를 큐를 비우지 않고 놓을 때 사용한다.
+// 펜스 객체를 직접 들고 있지 않고 완료된 값만 받으므로, 값만 넘겨서 따로 검사할 수 있다.
+// (D3D12 객체를 바로 넣는 쪽은 02_Engine의 DeferredReleaseQueue)
+class FenceReleaseQueue
+{
+public:
+    FenceReleaseQueue() = default;
+    FenceReleaseQueue(const FenceReleaseQueue& rhs) = delete;
+    FenceReleaseQueue& operator=(const FenceReleaseQueue& rhs) = delete;
+    ~FenceReleaseQueue();
+
+    // fence가 끝나면 release를 호출한다. (리소스 참조 해제, 디스크립터 슬롯 반환 등)
+    void Enqueue(std::uint64_t fence, std::function<void()> release);
+
+    // completedValue 이하 펜스의 항목을 해제하고 해제한 개수를 돌려준다.
+    size_t ReleaseCompleted(std::uint64_t completedValue);
+
+    // 남은 항목 모두 해제 (GPU가 idle인 것이 확실할 때만)
+    void ReleaseAll();
+
+    size_t GetPendingCount();
+
+private:
+    struct Entry
+    {
+        std::uint64_t Fence = 0;
+        std::function<void()> Release;
+    };
+
+private:
+    std::mutex mMutex;
+    std::deque<Entry> mEntries;     // Fence 오름차순
+};
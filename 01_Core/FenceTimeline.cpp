@@ -0,0 +1,38 @@
+#include "FenceTimeline.h"
+
+void FenceTimeline::Initialize(ITimelineFence* fence, std::uint64_t initialValue)
+{
+    mFence = fence;
+    mLastSignaled = initialValue;
+    mLastCompleted = initialValue;
+}
+
+std::uint64_t FenceTimeline::GetCompletedValue()
+{
+    // 디바이스 제거 시 UINT64_MAX가 오므로 그대로 넘겨서 대기가 풀리게 한다.
+    std::uint64_t completed = mFence->GetCompletedValue();
+
+    std::uint64_t cached = mLastCompleted;
+    while (completed > cached && !mLastCompleted.compare_exchange_weak(cached, completed))
+    {
+    }
+
+    return completed;
+}
+
+bool FenceTimeline::IsComplete(std::uint64_t value)
+{
+    if (value <= mLastCompleted)
+        return true;
+
+    return GetCompletedValue() >= value;
+}
+
+void FenceTimeline::Wait(std::uint64_t value)
+{
+    if (IsComplete(value))
+        return;
+
+    mFence->WaitForValue(value);
+    GetCompletedValue();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// FenceTimeline이 값을 확인하고 기다리는 펜스 (D3D12 펜스, 테스트용 가짜 펜스 등)
+class ITimelineFence
+{
+public:
+    virtual ~ITimelineFence() = default;
+
+    // 디바이스 제거 등으로 더 진행할 수 없으면 UINT64_MAX를 돌려준다.
+    virtual std::uint64_t GetCompletedValue() = 0;
+
+    // CPU에서 value가 끝날 때까지 대기
+    virtual void WaitForValue(std::uint64_t value) = 0;
+};
+
+// 큐 하나의 펜스 값 흐름 (Signal한 마지막 값, 끝난 마지막 값)
+// 끝난 값은 캐시해 두고, 이미 지난 값을 물으면 펜스를 다시 읽지 않는다.
+// Advance/Wait/IsComplete는 여러 스레드에서 불러도 된다.
+class FenceTimeline
+{
+public:
+    FenceTimeline() = default;
+    FenceTimeline(const FenceTimeline& rhs) = delete;
+    FenceTimeline& operator=(const FenceTimeline& rhs) = delete;
+
+    void Initialize(ITimelineFence* fence, std::uint64_t initialValue = 0);
+
+    // 다음 Signal 값을 정해서 돌려준다. (큐에 Signal하는 것은 호출하는 쪽)
+    std::uint64_t Advance() { return ++mLastSignaled; }
+
+    std::uint64_t GetLastSignaled()const { return mLastSignaled; }
+    std::uint64_t GetCompletedValue();
+    bool IsComplete(std::uint64_t value);
+
+    // CPU에서 value가 끝날 때까지 대기 (이미 끝났으면 바로 돌아온다)
+    void Wait(std::uint64_t value);
+
+private:
+    ITimelineFence* mFence = nullptr;
+    std::atomic<std::uint64_t> mLastSignaled{ 0 };
+    std::atomic<std::uint64_t> mLastCompleted{ 0 };     // GetCompletedValue 캐시
+};
@@ -0,0 +1,307 @@
+#include "FileWatcher.h"
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+struct FileWatcher::Directory
+{
+    std::string Path;
+    bool IsRecursive = false;
+
+    HANDLE Handle = INVALID_HANDLE_VALUE;
+    OVERLAPPED Overlapped = {};
+    DWORD Buffer[16 * 1024];    // FILE_NOTIFY_INFORMATION은 DWORD 정렬이어야 한다.
+    bool IsReading = false;
+
+    ~Directory()
+    {
+        if (Handle != INVALID_HANDLE_VALUE)
+        {
+            // 진행 중인 읽기가 버퍼를 다 놓을 때까지 기다린 뒤 닫는다.
+            if (IsReading)
+            {
+                DWORD bytes = 0;
+                CancelIoEx(Handle, &Overlapped);
+                GetOverlappedResult(Handle, &Overlapped, &bytes, TRUE);
+            }
+            CloseHandle(Handle);
+        }
+        if (Overlapped.hEvent != nullptr)
+            CloseHandle(Overlapped.hEvent);
+    }
+
+    bool BeginRead()
+    {
+        const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+        IsReading = ReadDirectoryChangesW(Handle, Buffer, sizeof(Buffer), IsRecursive ? TRUE : FALSE,
+            filter, nullptr, &Overlapped, nullptr) != FALSE;
+        return IsReading;
+    }
+};
+
+FileWatcher::~FileWatcher()
+{
+    Stop();
+    mDirectories.clear();
+}
+
+bool FileWatcher::AddDirectory(const std::string& path, bool isRecursive)
+{
+    std::unique_ptr<Directory> directory = std::make_unique<Directory>();
+    directory->Path = path;
+    directory->IsRecursive = isRecursive;
+
+    directory->Handle = CreateFileA(path.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (directory->Handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    directory->Overlapped.hEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    if (directory->Overlapped.hEvent == nullptr)
+        return false;
+
+    mDirectories.push_back(std::move(directory));
+    return true;
+}
+
+void FileWatcher::Start(std::chrono::milliseconds settleTime)
+{
+    if (mIsRunning)
+        return;
+
+    mSettleTime = settleTime;
+    mStopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+    for (std::unique_ptr<Directory>& directory : mDirectories)
+        directory->BeginRead();
+
+    mIsRunning = true;
+    mThread = std::thread(&FileWatcher::WatchLoop, this);
+}
+
+void FileWatcher::Stop()
+{
+    if (!mIsRunning)
+        return;
+
+    mIsRunning = false;
+    SetEvent((HANDLE)mStopEvent);
+    mThread.join();
+
+    CloseHandle((HANDLE)mStopEvent);
+    mStopEvent = nullptr;
+}
+
+void FileWatcher::WatchLoop()
+{
+    // 디렉터리마다 이벤트 하나 + 종료 이벤트
+    std::vector<HANDLE> events;
+    for (std::unique_ptr<Directory>& directory : mDirectories)
+        events.push_back(directory->Overlapped.hEvent);
+    events.push_back((HANDLE)mStopEvent);
+
+    while (mIsRunning)
+    {
+        const DWORD result = WaitForMultipleObjects((DWORD)events.size(), events.data(), FALSE, INFINITE);
+        const DWORD index = result - WAIT_OBJECT_0;
+        if (index >= mDirectories.size())
+            break;  // 종료 요청 또는 대기 실패
+
+        Directory& directory = *mDirectories[index];
+        DWORD bytes = 0;
+        if (GetOverlappedResult(directory.Handle, &directory.Overlapped, &bytes, FALSE))
+        {
+            if (bytes == 0)
+            {
+                // 버퍼가 넘쳐서 알림을 잃었다 : 디렉터리 전체가 바뀐 것으로 본다.
+                OnChanged(directory.Path);
+            }
+            else
+            {
+                const std::uint8_t* cursor = reinterpret_cast<const std::uint8_t*>(directory.Buffer);
+                for (;;)
+                {
+                    const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+                    if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME)
+                    {
+                        const int length = (int)(info->FileNameLength / sizeof(WCHAR));
+                        const int size = WideCharToMultiByte(CP_ACP, 0, info->FileName, length, nullptr, 0, nullptr, nullptr);
+                        std::string name(size, '\0');
+                        WideCharToMultiByte(CP_ACP, 0, info->FileName, length, &name[0], size, nullptr, nullptr);
+
+                        OnChanged(directory.Path + "\\" + name);
+                    }
+
+                    if (info->NextEntryOffset == 0)
+                        break;
+                    cursor += info->NextEntryOffset;
+                }
+            }
+        }
+
+        directory.BeginRead();
+    }
+}
+
+#else
+
+struct FileWatcher::Directory
+{
+    std::string Path;
+    bool IsRecursive = false;
+};
+
+namespace
+{
+    const std::uint32_t WatchMask = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+    // inotify는 재귀 감시가 없으므로 하위 디렉터리마다 감시를 추가한다.
+    bool AddWatch(int inotify, const std::string& path, bool isRecursive, std::unordered_map<int, std::string>& watchPaths)
+    {
+        const int watch = inotify_add_watch(inotify, path.c_str(), WatchMask);
+        if (watch < 0)
+            return false;
+        watchPaths[watch] = path;
+
+        if (!isRecursive)
+            return true;
+
+        DIR* dir = opendir(path.c_str());
+        if (dir == nullptr)
+            return true;
+
+        while (dirent* entry = readdir(dir))
+        {
+            const std::string name = entry->d_name;
+            if (entry->d_type == DT_DIR && name != "." && name != "..")
+                AddWatch(inotify, path + "/" + name, true, watchPaths);
+        }
+        closedir(dir);
+        return true;
+    }
+}
+
+FileWatcher::~FileWatcher()
+{
+    Stop();
+    if (mInotify >= 0)
+        close(mInotify);
+}
+
+bool FileWatcher::AddDirectory(const std::string& path, bool isRecursive)
+{
+    if (mInotify < 0)
+    {
+        mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (mInotify < 0)
+            return false;
+    }
+
+    if (!AddWatch(mInotify, path, isRecursive, mWatchPaths))
+        return false;
+
+    std::unique_ptr<Directory> directory = std::make_unique<Directory>();
+    directory->Path = path;
+    directory->IsRecursive = isRecursive;
+    mDirectories.push_back(std::move(directory));
+    return true;
+}
+
+void FileWatcher::Start(std::chrono::milliseconds settleTime)
+{
+    if (mIsRunning || mInotify < 0)
+        return;
+
+    mSettleTime = settleTime;
+    mIsRunning = true;
+    mThread = std::thread(&FileWatcher::WatchLoop, this);
+}
+
+void FileWatcher::Stop()
+{
+    if (!mIsRunning)
+        return;
+
+    mIsRunning = false;
+    mThread.join();
+}
+
+void FileWatcher::WatchLoop()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+
+    while (mIsRunning)
+    {
+        // 종료 요청을 확인할 수 있도록 짧게 기다린다.
+        pollfd fd = { mInotify, POLLIN, 0 };
+        if (poll(&fd, 1, 100) <= 0)
+            continue;
+
+        const ssize_t bytes = read(mInotify, buffer, sizeof(buffer));
+        if (bytes <= 0)
+            continue;
+
+        for (ssize_t offset = 0; offset < bytes; )
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // 알림을 잃었다 : 감시 중인 디렉터리 전체가 바뀐 것으로 본다.
+                for (const std::unique_ptr<Directory>& directory : mDirectories)
+                    OnChanged(directory->Path);
+                continue;
+            }
+
+            auto it = mWatchPaths.find(event->wd);
+            if (it == mWatchPaths.end() || event->len == 0 || (event->mask & IN_ISDIR))
+                continue;
+
+            OnChanged(it->second + "/" + event->name);
+        }
+    }
+}
+
+#endif
+
+// Directory가 여기서 완성되므로 생성자도 여기서 (unique_ptr 소멸자)
+FileWatcher::FileWatcher() = default;
+
+void FileWatcher::OnChanged(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending[path] = std::chrono::steady_clock::now();
+}
+
+bool FileWatcher::PollChanges(std::vector<std::string>& changedPaths)
+{
+    changedPaths.clear();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (auto it = mPending.begin(); it != mPending.end(); )
+    {
+        if (now - it->second >= mSettleTime)
+        {
+            changedPaths.push_back(it->first);
+            it = mPending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return !changedPaths.empty();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 디렉터리 변경 감시 (핫 리로드용)
+// 백그라운드 스레드가 Win32(ReadDirectoryChangesW) / Linux(inotify) 알림을 받아서 바뀐 파일 경로를 모아 둔다.
+// 에디터는 저장할 때 여러 번 쓰거나 임시 파일을 바꿔치기하므로, 마지막 알림 뒤 잠깐 조용해진 파일만 PollChanges로 돌려준다.
+class FileWatcher
+{
+public:
+    FileWatcher();
+    FileWatcher(const FileWatcher& rhs) = delete;
+    FileWatcher& operator=(const FileWatcher& rhs) = delete;
+    ~FileWatcher();
+
+    // 감시할 디렉터리 추가 (Start 전에 호출). 디렉터리를 열 수 없으면 false
+    // Linux는 추가할 때 있던 하위 디렉터리까지만 감시한다.
+    bool AddDirectory(const std::string& path, bool isRecursive);
+
+    void Start(std::chrono::milliseconds settleTime = std::chrono::milliseconds(100));
+    void Stop();
+
+    // 바뀐 뒤 settleTime 동안 더 바뀌지 않은 파일 경로 (디렉터리 경로 + 상대 경로). 없으면 false
+    bool PollChanges(std::vector<std::string>& changedPaths);
+
+private:
+    struct Directory;
+
+    void WatchLoop();
+    void OnChanged(const std::string& path);
+
+private:
+    std::vector<std::unique_ptr<Directory>> mDirectories;
+    std::thread mThread;
+    std::atomic<bool> mIsRunning{ false };
+    std::chrono::milliseconds mSettleTime{ 100 };
+
+#if defined(_WIN32)
+    void* mStopEvent = nullptr;     // HANDLE
+#else
+    int mInotify = -1;
+    std::unordered_map<int, std::string> mWatchPaths;   // inotify 감시 번호 -> 디렉터리 경로
+#endif
+
+    std::mutex mMutex;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> mPending;   // 경로 -> 마지막 알림 시각
+};
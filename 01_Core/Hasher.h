@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// 64비트 FNV-1a 해시를 조금씩 이어서 계산한다.
+// 포인터나 구조체 패딩 없이 값만 넣으면 실행/플랫폼과 상관없이 같은 결과가 나오므로 디스크 캐시 키로 쓸 수 있다.
+class Hasher
+{
+public:
+    static const std::uint64_t Seed = 14695981039346656037ull;
+
+public:
+    explicit Hasher(std::uint64_t seed = Seed) : mHash(seed) {}
+
+    Hasher& AddBytes(const void* data, std::size_t size)
+    {
+        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            mHash ^= bytes[i];
+            mHash *= 1099511628211ull;
+        }
+        return *this;
+    }
+
+    // 정수, 실수, enum 값 (구조체는 필드별로 넣는다)
+    template<typename T>
+    Hasher& Add(const T& value)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Hasher::Add takes scalar values only");
+        return AddBytes(&value, sizeof(T));
+    }
+
+    // 길이도 같이 넣어서 "ab"+"c" 와 "a"+"bc"가 같은 해시가 되지 않도록 한다.
+    Hasher& AddString(const std::string& str)
+    {
+        Add((std::uint64_t)str.size());
+        return AddBytes(str.data(), str.size());
+    }
+
+    // nullptr과 빈 문자열은 다르게 취급한다.
+    Hasher& AddString(const char* str)
+    {
+        if (str == nullptr)
+            return Add((std::uint64_t)~0ull);
+        return AddString(std::string(str));
+    }
+
+    std::uint64_t Get()const { return mHash; }
+
+    static std::uint64_t HashBytes(const void* data, std::size_t size)
+    {
+        return Hasher().AddBytes(data, size).Get();
+    }
+
+private:
+    std::uint64_t mHash;
+};
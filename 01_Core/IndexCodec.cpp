@@ -0,0 +1,305 @@
+#include "IndexCodec.h"
+
+#include <cstring>
+
+namespace
+{
+    using uint8 = std::uint8_t;
+    using uint32 = std::uint32_t;
+
+    // 코드 바이트 상위 4비트 : 변 FIFO 위치 (EdgeFifoReach가 "공유 변 없음")
+    // 하위 4비트 (정점 하나) : 0 = 다음 새 정점, 1 ~ VertexFifoReach = 정점 FIFO 위치 + 1, 15 = 델타 직접
+    const uint32 FifoSize = 16;
+    const uint32 EdgeFifoReach = 15;
+    const uint32 VertexFifoReach = 14;
+    const uint32 NoEdge = 15;
+    const uint32 NextVertex = 0;
+    const uint32 ExplicitVertex = 15;
+
+    // 인코더와 디코더가 같은 순서로 갱신하는 상태
+    struct CodecState
+    {
+        uint32 EdgeFifo[FifoSize][2] = {};
+        uint32 VertexFifo[FifoSize] = {};
+        uint32 EdgeOffset = 0;
+        uint32 VertexOffset = 0;
+        uint32 Next = 0;        // 아직 한 번도 안 나온 정점 중 가장 작은 번호 (fetch 순서로 정리된 메시면 새 정점은 항상 이것)
+        uint32 Last = 0;        // 마지막으로 직접 쓴 정점
+
+        // i번째로 최근 것
+        const uint32* GetEdge(uint32 i)const { return EdgeFifo[(EdgeOffset - 1 - i) & (FifoSize - 1)]; }
+        uint32 GetVertex(uint32 i)const { return VertexFifo[(VertexOffset - 1 - i) & (FifoSize - 1)]; }
+
+        // 삼각형 (a, b, c)의 변을 뒤집어서 넣는다. 이웃 삼각형은 (b, a, x)처럼 이 변을 앞에 두고 나온다.
+        void PushEdge(uint32 a, uint32 b)
+        {
+            uint32* edge = EdgeFifo[EdgeOffset++ & (FifoSize - 1)];
+            edge[0] = b;
+            edge[1] = a;
+        }
+
+        void PushVertex(uint32 v) { VertexFifo[VertexOffset++ & (FifoSize - 1)] = v; }
+    };
+
+    void WriteVarint(std::vector<uint8>& out, uint32 value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back((uint8)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((uint8)value);
+    }
+
+    // 잘린 데이터면 end를 넘지 않고 false
+    bool ReadVarint(const uint8*& p, const uint8* end, uint32& value)
+    {
+        value = 0;
+        for (uint32 shift = 0; shift < 35; shift += 7)
+        {
+            if (p == end)
+                return false;
+            const uint8 byte = *p++;
+            value |= (uint32)(byte & 0x7F) << shift;
+            if (byte < 0x80)
+                return true;
+        }
+        return false;
+    }
+
+    uint32 LoadIndex(const void* indices, std::size_t i, uint32 stride)
+    {
+        return stride == 2 ? static_cast<const std::uint16_t*>(indices)[i] : static_cast<const uint32*>(indices)[i];
+    }
+
+    // 정점 하나의 4비트 코드. 델타를 직접 쓸 때는 data 뒤에 붙인다.
+    uint32 EncodeVertex(CodecState& state, uint32 v, std::vector<uint8>& data)
+    {
+        if (v == state.Next)
+        {
+            ++state.Next;
+            state.PushVertex(v);
+            return NextVertex;
+        }
+
+        for (uint32 i = 0; i < VertexFifoReach; ++i)
+        {
+            if (state.GetVertex(i) == v)
+                return i + 1;
+        }
+
+        // 앞 값 기준 부호 있는 델타 -> 작은 양수 (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+        const std::int32_t delta = (std::int32_t)(v - state.Last);
+        WriteVarint(data, ((uint32)delta << 1) ^ (uint32)(delta >> 31));
+        state.Last = v;
+        state.Next = v >= state.Next ? v + 1 : state.Next;
+        state.PushVertex(v);
+        return ExplicitVertex;
+    }
+
+    bool DecodeVertex(CodecState& state, uint32 code, const uint8*& p, const uint8* end, uint32& v)
+    {
+        if (code == NextVertex)
+        {
+            v = state.Next++;
+            state.PushVertex(v);
+            return true;
+        }
+
+        if (code != ExplicitVertex)
+        {
+            v = state.GetVertex(code - 1);
+            return true;
+        }
+
+        uint32 zigzag;
+        if (!ReadVarint(p, end, zigzag))
+            return false;
+        v = state.Last + ((zigzag >> 1) ^ (0u - (zigzag & 1)));
+        state.Last = v;
+        state.Next = v >= state.Next ? v + 1 : state.Next;
+        state.PushVertex(v);
+        return true;
+    }
+
+    template<typename TIndex>
+    bool DecodeTriangles(const uint8* codes, const uint8* p, const uint8* end, TIndex* dst, std::size_t triangleCount)
+    {
+        CodecState state;
+        uint32 overflow = 0;    // 16비트 출력에서 넘친 비트
+
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            const uint32 code = codes[t];
+            const uint32 edgeCode = code >> 4;
+
+            const uint32 vertexCode = code & 15;
+
+            uint32 a, b, c;
+            if (edgeCode != NoEdge && vertexCode != ExplicitVertex)
+            {
+                // 대부분 여기 (앞 삼각형과 변을 공유하고 세 번째 정점은 새 정점이거나 FIFO 안)
+                // 새 정점 / FIFO는 메시마다 반반 섞여서 예측이 안 되므로 분기 없이 고른다.
+                // FIFO에서 찾은 경우에도 다음 칸에 써 두지만 오프셋을 올리지 않으므로 보이지 않는다. (VertexFifoReach < FifoSize)
+                const uint32* edge = state.GetEdge(edgeCode);
+                a = edge[0];
+                b = edge[1];
+
+                const uint32 isNext = vertexCode == NextVertex ? 1 : 0;
+                const uint32 cached = state.VertexFifo[(state.VertexOffset - vertexCode) & (FifoSize - 1)];
+                c = isNext ? state.Next : cached;
+                state.VertexFifo[state.VertexOffset & (FifoSize - 1)] = c;
+                state.VertexOffset += isNext;
+                state.Next += isNext;
+
+                state.PushEdge(b, c);
+                state.PushEdge(c, a);
+            }
+            else if (edgeCode != NoEdge)
+            {
+                const uint32* edge = state.GetEdge(edgeCode);
+                a = edge[0];
+                b = edge[1];
+                if (!DecodeVertex(state, vertexCode, p, end, c))
+                    return false;
+
+                state.PushEdge(b, c);
+                state.PushEdge(c, a);
+            }
+            else
+            {
+                if (p == end)
+                    return false;
+                const uint32 extra = *p++;
+                if (!DecodeVertex(state, extra >> 4, p, end, a) ||
+                    !DecodeVertex(state, extra & 15, p, end, b) ||
+                    !DecodeVertex(state, vertexCode, p, end, c))
+                    return false;
+
+                state.PushEdge(a, b);
+                state.PushEdge(b, c);
+                state.PushEdge(c, a);
+            }
+
+            dst[t * 3 + 0] = (TIndex)a;
+            dst[t * 3 + 1] = (TIndex)b;
+            dst[t * 3 + 2] = (TIndex)c;
+            if (sizeof(TIndex) == 2)
+                overflow |= (a | b | c) >> 16;
+        }
+
+        return overflow == 0 && p == end;
+    }
+}
+
+std::uint32_t IndexCodec::GetMaxIndex(const std::uint32_t* indices, std::size_t count)
+{
+    uint32 maxIndex = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        maxIndex = indices[i] > maxIndex ? indices[i] : maxIndex;
+    return maxIndex;
+}
+
+bool IndexCodec::Convert(const std::uint32_t* indices, std::size_t count, void* dst, std::uint32_t stride)
+{
+    if (stride == 4)
+    {
+        // 빈 메시는 포인터가 null일 수 있다.
+        if (count > 0)
+            std::memcpy(dst, indices, count * sizeof(uint32));
+        return true;
+    }
+
+    if (stride != 2 || GetMaxIndex(indices, count) > 0xFFFF)
+        return false;
+
+    std::uint16_t* dst16 = static_cast<std::uint16_t*>(dst);
+    for (std::size_t i = 0; i < count; ++i)
+        dst16[i] = (std::uint16_t)indices[i];
+    return true;
+}
+
+void IndexCodec::Encode(const void* indices, std::size_t count, std::uint32_t indexStride, std::vector<std::uint8_t>& out)
+{
+    const uint32 triangleCount = (uint32)(count / 3);
+
+    // 코드 (삼각형마다 1바이트)는 자리만 잡아 두고, 나머지는 data에 모았다가 뒤에 붙인다.
+    const std::size_t codeOffset = out.size() + sizeof(uint32);
+    out.resize(codeOffset + triangleCount);
+    std::memcpy(&out[codeOffset - sizeof(uint32)], &triangleCount, sizeof(uint32));
+
+    std::vector<uint8> data;
+    data.reserve(triangleCount);
+
+    CodecState state;
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        const uint32 tri[3] = {
+            LoadIndex(indices, t * 3 + 0, indexStride),
+            LoadIndex(indices, t * 3 + 1, indexStride),
+            LoadIndex(indices, t * 3 + 2, indexStride) };
+
+        // 변 FIFO에서 (tri[r], tri[r + 1])과 같은 변 찾기 (회전해서 공유 변을 앞에 둔다)
+        uint32 edgeCode = NoEdge;
+        uint32 rotation = 0;
+        for (uint32 i = 0; i < EdgeFifoReach && edgeCode == NoEdge; ++i)
+        {
+            const uint32* edge = state.GetEdge(i);
+            for (uint32 r = 0; r < 3; ++r)
+            {
+                if (tri[r] == edge[0] && tri[(r + 1) % 3] == edge[1])
+                {
+                    edgeCode = i;
+                    rotation = r;
+                    break;
+                }
+            }
+        }
+
+        // FIFO를 처음 채우기 전에는 0으로 초기화된 변이 우연히 맞을 수 있지만 디코더도 같은 값을 보므로 상관없다.
+        if (edgeCode != NoEdge)
+        {
+            const uint32 a = tri[rotation];
+            const uint32 b = tri[(rotation + 1) % 3];
+            const uint32 c = tri[(rotation + 2) % 3];
+            out[codeOffset + t] = (uint8)((edgeCode << 4) | EncodeVertex(state, c, data));
+
+            state.PushEdge(b, c);
+            state.PushEdge(c, a);
+        }
+        else
+        {
+            // 세 정점 코드 중 두 개는 data의 바이트 하나, 델타는 그 뒤에 (디코더가 읽는 순서)
+            const std::size_t extraOffset = data.size();
+            data.push_back(0);
+            const uint32 codeA = EncodeVertex(state, tri[0], data);
+            const uint32 codeB = EncodeVertex(state, tri[1], data);
+            const uint32 codeC = EncodeVertex(state, tri[2], data);
+            data[extraOffset] = (uint8)((codeA << 4) | codeB);
+            out[codeOffset + t] = (uint8)((NoEdge << 4) | codeC);
+
+            state.PushEdge(tri[0], tri[1]);
+            state.PushEdge(tri[1], tri[2]);
+            state.PushEdge(tri[2], tri[0]);
+        }
+    }
+
+    out.insert(out.end(), data.begin(), data.end());
+}
+
+bool IndexCodec::Decode(const std::uint8_t* data, std::size_t size, void* dst, std::size_t count, std::uint32_t stride)
+{
+    uint32 triangleCount = 0;
+    if (size < sizeof(uint32) || (stride != 2 && stride != 4))
+        return false;
+    std::memcpy(&triangleCount, data, sizeof(uint32));
+
+    if ((std::size_t)triangleCount * 3 != count || size - sizeof(uint32) < triangleCount)
+        return false;
+
+    const uint8* codes = data + sizeof(uint32);
+    const uint8* end = data + size;
+    if (stride == 2)
+        return DecodeTriangles(codes, codes + triangleCount, end, static_cast<std::uint16_t*>(dst), triangleCount);
+    return DecodeTriangles(codes, codes + triangleCount, end, static_cast<uint32*>(dst), triangleCount);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 삼각형 리스트 인덱스 압축 (디스크 저장용, 정점 캐시/fetch 최적화를 거친 메시에서 삼각형당 10~12비트)
+// 삼각형마다 코드 1바이트 : 상위 4비트는 최근 변 FIFO에서 공유하는 변 위치 (15면 공유 변 없음),
+// 하위 4비트는 나머지 정점이 "다음 새 정점" / 최근 정점 FIFO 위치 / 직접 쓴 델타(zigzag 가변 길이 정수) 중 무엇인지
+// 공유 변이 없는 삼각형은 나머지 두 정점의 4비트 코드를 한 바이트 더 쓴다.
+// 공유 변을 앞에 두도록 삼각형 안 정점 순서를 회전할 수 있다. (감기 방향과 삼각형 순서는 그대로)
+//
+// [삼각형 수 u32][코드 (삼각형마다 1바이트)][추가 코드 바이트와 델타 ...]
+class IndexCodec
+{
+public:
+    // 최대 인덱스에 맞는 인덱스 크기 (2 또는 4바이트)
+    static std::uint32_t GetIndexStride(std::uint32_t maxIndex) { return maxIndex <= 0xFFFF ? 2 : 4; }
+    static std::uint32_t GetMaxIndex(const std::uint32_t* indices, std::size_t count);
+
+    // 32비트 인덱스 -> stride(2 또는 4) 크기로 복사. 16비트에 들어가지 않는 값이 있으면 false (dst는 건드리지 않는다)
+    static bool Convert(const std::uint32_t* indices, std::size_t count, void* dst, std::uint32_t stride);
+
+    // indexStride 크기(2 또는 4) 인덱스를 압축해서 out 뒤에 붙인다. count는 3의 배수
+    static void Encode(const void* indices, std::size_t count, std::uint32_t indexStride, std::vector<std::uint8_t>& out);
+
+    // dst에 count개를 stride 크기로 푼다. 데이터가 잘렸거나 개수가 다르거나 stride에 들어가지 않는 값이 있으면 false
+    static bool Decode(const std::uint8_t* data, std::size_t size, void* dst, std::size_t count, std::uint32_t stride);
+};
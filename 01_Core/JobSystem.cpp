@@ -0,0 +1,177 @@
+#include "JobSystem.h"
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize(unsigned workerCount)
+{
+    Shutdown();
+
+    if (workerCount == 0)
+    {
+        const unsigned cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 0;
+    }
+
+    mIsStopping = false;
+    for (unsigned i = 0; i < workerCount; ++i)
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this);
+}
+
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mJobAvailable.notify_all();
+
+    for (std::thread& worker : mWorkers)
+        worker.join();
+    mWorkers.clear();
+
+    // 남은 작업은 호출한 스레드에서 마저 처리 (카운터를 기다리는 쪽이 멈추지 않도록)
+    while (TryRunOne())
+    {
+    }
+}
+
+JobCounter JobSystem::Run(Job job)
+{
+    JobCounter counter;
+    counter.mState = std::make_shared<JobCounter::State>();
+    counter.mState->Pending = 1;
+
+    std::vector<QueuedJob> jobs(1);
+    jobs[0].Function = std::move(job);
+    jobs[0].Counter = counter.mState;
+    Enqueue(std::move(jobs));
+
+    return counter;
+}
+
+JobCounter JobSystem::ParallelFor(std::uint32_t count, std::uint32_t batchSize, const std::function<void(std::uint32_t)>& body)
+{
+    JobCounter counter;
+    counter.mState = std::make_shared<JobCounter::State>();
+    if (count == 0)
+        return counter;
+
+    if (batchSize == 0)
+        batchSize = 1;
+
+    const std::uint32_t batchCount = (count + batchSize - 1) / batchSize;
+    counter.mState->Pending = batchCount;
+
+    std::vector<QueuedJob> jobs(batchCount);
+    for (std::uint32_t batch = 0; batch < batchCount; ++batch)
+    {
+        const std::uint32_t begin = batch * batchSize;
+        const std::uint32_t end = begin + batchSize < count ? begin + batchSize : count;
+
+        jobs[batch].Function = [body, begin, end]()
+        {
+            for (std::uint32_t i = begin; i < end; ++i)
+                body(i);
+        };
+        jobs[batch].Counter = counter.mState;
+    }
+    Enqueue(std::move(jobs));
+
+    return counter;
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    if (!counter.IsValid())
+        return;
+
+    while (!counter.IsDone())
+    {
+        if (TryRunOne())
+            continue;
+
+        // 큐가 비었으면 다른 스레드가 처리 중인 작업이 끝나거나 (그 작업이 넣은) 새 작업이 들어올 때까지 잔다.
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWaitProgress.wait(lock, [this, &counter]() { return counter.IsDone() || !mQueue.empty(); });
+    }
+
+    if (counter.mState->Exception)
+        std::rethrow_exception(counter.mState->Exception);
+}
+
+void JobSystem::Enqueue(std::vector<QueuedJob>&& jobs)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (QueuedJob& job : jobs)
+            mQueue.push_back(std::move(job));
+    }
+
+    if (jobs.size() == 1)
+        mJobAvailable.notify_one();
+    else
+        mJobAvailable.notify_all();
+    mWaitProgress.notify_all();
+}
+
+bool JobSystem::TryRunOne()
+{
+    QueuedJob job;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mQueue.empty())
+            return false;
+
+        job = std::move(mQueue.front());
+        mQueue.pop_front();
+    }
+
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(QueuedJob& job)
+{
+    try
+    {
+        job.Function();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(job.Counter->ExceptionMutex);
+        if (!job.Counter->Exception)
+            job.Counter->Exception = std::current_exception();
+    }
+
+    if (job.Counter->Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // 잠금을 거쳐야 조건을 확인하고 잠들려는 Wait가 알림을 놓치지 않는다.
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+        }
+        mWaitProgress.notify_all();
+    }
+}
+
+void JobSystem::WorkerLoop()
+{
+    for (;;)
+    {
+        QueuedJob job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mJobAvailable.wait(lock, [this]() { return mIsStopping || !mQueue.empty(); });
+
+            if (mQueue.empty())
+                return;     // 종료 요청 + 남은 작업 없음
+
+            job = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+
+        Execute(job);
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 작업 묶음의 완료 카운터
+// Run/ParallelFor가 돌려주고, Wait로 끝날 때까지 기다린다.
+class JobCounter
+{
+public:
+    bool IsValid()const { return mState != nullptr; }
+    bool IsDone()const { return mState == nullptr || mState->Pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    struct State
+    {
+        std::atomic<std::uint32_t> Pending{ 0 };
+        std::mutex ExceptionMutex;
+        std::exception_ptr Exception;   // 작업에서 처음 던진 예외 (Wait에서 다시 던진다)
+    };
+    std::shared_ptr<State> mState;
+};
+
+// 작업자 스레드 풀
+// 기다리는 스레드도 큐의 작업을 같이 처리하므로 작업 안에서 다른 작업을 기다려도 교착되지 않는다.
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+
+public:
+    JobSystem() = default;
+    JobSystem(const JobSystem& rhs) = delete;
+    JobSystem& operator=(const JobSystem& rhs) = delete;
+    ~JobSystem();
+
+    // workerCount가 0이면 (코어 수 - 1)개. 작업자가 없으면 Wait하는 스레드가 모두 처리한다.
+    void Initialize(unsigned workerCount = 0);
+    void Shutdown();
+
+    JobCounter Run(Job job);
+
+    // [0, count)를 batchSize개씩 나눠서 body(index)를 병렬로 호출
+    JobCounter ParallelFor(std::uint32_t count, std::uint32_t batchSize, const std::function<void(std::uint32_t)>& body);
+
+    // 끝날 때까지 큐의 작업을 같이 처리하며 기다린다. 작업에서 예외가 났으면 여기서 다시 던진다.
+    // 큐가 비면 카운터가 끝나거나 새 작업이 들어올 때까지 잠든다. (긴 컴파일 작업을 기다리며 코어를 쓰지 않도록)
+    void Wait(const JobCounter& counter);
+
+    unsigned GetWorkerCount()const { return (unsigned)mWorkers.size(); }
+
+private:
+    struct QueuedJob
+    {
+        Job Function;
+        std::shared_ptr<JobCounter::State> Counter;
+    };
+
+    void Enqueue(std::vector<QueuedJob>&& jobs);
+    bool TryRunOne();
+    void Execute(QueuedJob& job);
+    void WorkerLoop();
+
+private:
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mMutex;
+    std::condition_variable mJobAvailable;
+    std::condition_variable mWaitProgress;     // Wait하는 스레드용 (카운터가 0이 됨 / 작업 추가)
+    std::deque<QueuedJob> mQueue;
+    bool mIsStopping = false;
+};
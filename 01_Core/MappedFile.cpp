@@ -0,0 +1,183 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+{
+    Swap(rhs);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        Close();
+        Swap(rhs);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    mFile = file;
+    mIsOpen = true;
+
+    // 크기가 0인 파일은 매핑을 만들 수 없다.
+    if (size.QuadPart == 0)
+        return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+    mMapping = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    mData = static_cast<const std::uint8_t*>(view);
+    mSize = (std::size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (mData != nullptr)
+        UnmapViewOfFile(mData);
+    if (mMapping != nullptr)
+        CloseHandle((HANDLE)mMapping);
+    if (mFile != nullptr)
+        CloseHandle((HANDLE)mFile);
+
+    mData = nullptr;
+    mSize = 0;
+    mMapping = nullptr;
+    mFile = nullptr;
+    mIsOpen = false;
+}
+
+void MappedFile::Prefetch(std::size_t offset, std::size_t size)const
+{
+    if (mData == nullptr || offset >= mSize)
+        return;
+
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<std::uint8_t*>(mData + offset);
+    range.NumberOfBytes = size < mSize - offset ? size : mSize - offset;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+void MappedFile::Swap(MappedFile& rhs) noexcept
+{
+    std::swap(mData, rhs.mData);
+    std::swap(mSize, rhs.mSize);
+    std::swap(mIsOpen, rhs.mIsOpen);
+    std::swap(mFile, rhs.mFile);
+    std::swap(mMapping, rhs.mMapping);
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(file, &st) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    mFile = file;
+    mIsOpen = true;
+
+    if (st.st_size == 0)
+        return true;
+
+    void* view = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (view == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+
+    mData = static_cast<const std::uint8_t*>(view);
+    mSize = (std::size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (mData != nullptr)
+        munmap(const_cast<std::uint8_t*>(mData), mSize);
+    if (mFile >= 0)
+        ::close(mFile);
+
+    mData = nullptr;
+    mSize = 0;
+    mFile = -1;
+    mIsOpen = false;
+}
+
+void MappedFile::Prefetch(std::size_t offset, std::size_t size)const
+{
+    if (mData == nullptr || offset >= mSize)
+        return;
+
+    // madvise는 페이지 경계에서 시작해야 한다.
+    const std::size_t pageSize = (std::size_t)sysconf(_SC_PAGESIZE);
+    const std::size_t begin = offset & ~(pageSize - 1);
+    const std::size_t end = size < mSize - offset ? offset + size : mSize;
+    madvise(const_cast<std::uint8_t*>(mData + begin), end - begin, MADV_WILLNEED);
+}
+
+void MappedFile::Swap(MappedFile& rhs) noexcept
+{
+    std::swap(mData, rhs.mData);
+    std::swap(mSize, rhs.mSize);
+    std::swap(mIsOpen, rhs.mIsOpen);
+    std::swap(mFile, rhs.mFile);
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 읽기 전용 메모리 맵 파일
+// 파일 내용을 복사하지 않고 주소 공간에 매핑해서 포인터로 바로 읽는다.
+// Win32(CreateFileMapping)와 POSIX(mmap) 모두 지원한다.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile& rhs) = delete;
+    MappedFile& operator=(const MappedFile& rhs) = delete;
+    MappedFile(MappedFile&& rhs) noexcept;
+    MappedFile& operator=(MappedFile&& rhs) noexcept;
+    ~MappedFile();
+
+    // 파일이 없거나 열 수 없으면 false. 빈 파일은 열리지만 GetData()가 nullptr
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen()const { return mIsOpen; }
+    const std::uint8_t* GetData()const { return mData; }
+    std::size_t GetSize()const { return mSize; }
+
+    // [offset, offset + size) 구간을 곧 읽을 것이라고 OS에 알린다. (미리 읽기 힌트, 실패해도 무시)
+    void Prefetch(std::size_t offset, std::size_t size)const;
+
+private:
+    void Swap(MappedFile& rhs) noexcept;
+
+private:
+    const std::uint8_t* mData = nullptr;
+    std::size_t mSize = 0;
+    bool mIsOpen = false;
+
+#if defined(_WIN32)
+    void* mFile = nullptr;      // HANDLE
+    void* mMapping = nullptr;   // HANDLE
+#else
+    int mFile = -1;
+#endif
+};
@@ -63,8 +63,8 @@ XMFLOAT3 MathHelper::QuaternionToEuler(const DirectX::XMVECTOR& q)
 
 void MathHelper::WrapAngle360(float& angle)
 {
-	angle = fmodf(angle, 360.0f); // 360  
-	if (angle < 0.0f)             //  0~360  
+	angle = fmodf(angle, 360.0f); // 360으로 나눈 나머지
+	if (angle < 0.0f)             // 음수면 0~360 범위로 보정
 		angle += 360.0f;
 }
 
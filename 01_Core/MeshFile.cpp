@@ -0,0 +1,245 @@
+#include "MeshFile.h"
+#include "IndexCodec.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // [offset, offset + size)가 파일 안에 있는지 (덧셈 넘침 포함)
+    bool IsInside(std::uint64_t offset, std::uint64_t size, std::uint64_t fileSize)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+}
+
+bool MeshFile::Open(const std::string& path)
+{
+    Close();
+
+    if (!mFile.Open(path) || mFile.GetSize() < sizeof(MeshFileHeader))
+    {
+        mFile.Close();
+        return false;
+    }
+
+    // 매핑 시작은 페이지 정렬이므로 헤더/표를 그대로 가리켜도 정렬이 맞는다.
+    const std::uint8_t* data = mFile.GetData();
+    mHeader = reinterpret_cast<const MeshFileHeader*>(data);
+    if (!Validate())
+    {
+        Close();
+        return false;
+    }
+
+    mSubmeshes = reinterpret_cast<const MeshFileSubmesh*>(data + mHeader->SubmeshOffset);
+    mLods = reinterpret_cast<const MeshFileLod*>(data + mHeader->LodOffset);
+    mMeshlets = reinterpret_cast<const MeshFileMeshlet*>(data + mHeader->MeshletOffset);
+    mMeshletVertices = reinterpret_cast<const std::uint32_t*>(data + mHeader->MeshletVertexOffset);
+    mMeshletTriangles = reinterpret_cast<const std::uint32_t*>(data + mHeader->MeshletTriangleOffset);
+    return true;
+}
+
+void MeshFile::Close()
+{
+    mFile.Close();
+    mHeader = nullptr;
+    mSubmeshes = nullptr;
+    mLods = nullptr;
+    mMeshlets = nullptr;
+    mMeshletVertices = nullptr;
+    mMeshletTriangles = nullptr;
+}
+
+bool MeshFile::Validate()const
+{
+    const MeshFileHeader& header = *mHeader;
+    const std::uint64_t fileSize = mFile.GetSize();
+
+    if (header.Magic != MeshFileMagic || header.Version != MeshFileVersion || header.FileSize != fileSize)
+        return false;
+    if (header.IndexStride != 2 && header.IndexStride != 4)
+        return false;
+    if (header.VertexStreamCount == 0 || header.VertexStreamCount > MeshFileMaxVertexStreams)
+        return false;
+    // 압축된 인덱스는 크기를 알 수 없으므로 풀 때 검사한다.
+    if (header.IndexEncoding == MeshFileIndexEncoding::Raw)
+    {
+        if (header.IndexDataSize != (std::uint64_t)header.IndexStride * header.IndexCount)
+            return false;
+    }
+    else if (header.IndexEncoding != MeshFileIndexEncoding::Compressed)
+    {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < header.VertexStreamCount; ++i)
+    {
+        if (!IsInside(header.VertexStreamOffsets[i], (std::uint64_t)header.VertexStrides[i] * header.VertexCount, fileSize))
+            return false;
+    }
+
+    if (header.SubmeshOffset % alignof(MeshFileSubmesh) != 0 || header.LodOffset % alignof(MeshFileLod) != 0 ||
+        header.MeshletOffset % 16 != 0 || header.MeshletVertexOffset % 4 != 0 || header.MeshletTriangleOffset % 4 != 0)
+        return false;
+    if (!IsInside(header.SubmeshOffset, (std::uint64_t)header.SubmeshCount * sizeof(MeshFileSubmesh), fileSize) ||
+        !IsInside(header.LodOffset, (std::uint64_t)header.LodCount * sizeof(MeshFileLod), fileSize) ||
+        !IsInside(header.MeshletOffset, (std::uint64_t)header.MeshletCount * sizeof(MeshFileMeshlet), fileSize) ||
+        !IsInside(header.MeshletVertexOffset, (std::uint64_t)header.MeshletVertexCount * sizeof(std::uint32_t), fileSize) ||
+        !IsInside(header.MeshletTriangleOffset, (std::uint64_t)header.MeshletTriangleCount * sizeof(std::uint32_t), fileSize) ||
+        !IsInside(header.IndexDataOffset, header.IndexDataSize, fileSize))
+        return false;
+
+    // 서브메시/LOD가 가리키는 인덱스 구간도 확인해 두면 그리는 쪽에서 다시 볼 필요가 없다.
+    const std::uint8_t* data = mFile.GetData();
+    const MeshFileSubmesh* submeshes = reinterpret_cast<const MeshFileSubmesh*>(data + header.SubmeshOffset);
+    const MeshFileLod* lods = reinterpret_cast<const MeshFileLod*>(data + header.LodOffset);
+    for (std::uint32_t i = 0; i < header.SubmeshCount; ++i)
+    {
+        const MeshFileSubmesh& submesh = submeshes[i];
+        if (submesh.Name[sizeof(submesh.Name) - 1] != '\0' ||
+            !IsInside(submesh.StartIndex, submesh.IndexCount, header.IndexCount) ||
+            !IsInside(submesh.FirstLod, submesh.LodCount, header.LodCount))
+            return false;
+    }
+    for (std::uint32_t i = 0; i < header.LodCount; ++i)
+    {
+        if (!IsInside(lods[i].StartIndex, lods[i].IndexCount, header.IndexCount))
+            return false;
+    }
+    const MeshFileMeshlet* meshlets = reinterpret_cast<const MeshFileMeshlet*>(data + header.MeshletOffset);
+    for (std::uint32_t i = 0; i < header.MeshletCount; ++i)
+    {
+        if (!IsInside(meshlets[i].VertexOffset, meshlets[i].VertexCount, header.MeshletVertexCount) ||
+            !IsInside(meshlets[i].TriangleOffset, meshlets[i].TriangleCount, header.MeshletTriangleCount))
+            return false;
+    }
+
+    return true;
+}
+
+void MeshFile::Prefetch()const
+{
+    if (!IsOpen())
+        return;
+
+    for (std::uint32_t i = 0; i < mHeader->VertexStreamCount; ++i)
+        mFile.Prefetch((std::size_t)mHeader->VertexStreamOffsets[i], (std::size_t)GetVertexDataSize(i));
+    mFile.Prefetch((std::size_t)mHeader->IndexDataOffset, (std::size_t)mHeader->IndexDataSize);
+}
+
+bool MeshFile::DecodeIndices(void* dst)const
+{
+    if (!IsOpen())
+        return false;
+
+    if (!IsIndexCompressed())
+    {
+        std::memcpy(dst, GetIndexData(), (std::size_t)mHeader->IndexDataSize);
+        return true;
+    }
+
+    return IndexCodec::Decode(GetIndexData(), (std::size_t)mHeader->IndexDataSize, dst, mHeader->IndexCount, mHeader->IndexStride);
+}
+
+bool MeshFile::Write(const std::string& path, const MeshFileDesc& desc)
+{
+    if (desc.IndexStride != 2 && desc.IndexStride != 4)
+        return false;
+    if (desc.VertexStreams.empty() || desc.VertexStreams.size() > MeshFileMaxVertexStreams)
+        return false;
+
+    MeshFileHeader header;
+    header.VertexCount = desc.VertexCount;
+    header.VertexStreamCount = (std::uint32_t)desc.VertexStreams.size();
+    header.IndexStride = desc.IndexStride;
+    header.IndexCount = desc.IndexCount;
+    header.IndexEncoding = desc.CompressIndices ? MeshFileIndexEncoding::Compressed : MeshFileIndexEncoding::Raw;
+    header.SubmeshCount = (std::uint32_t)desc.Submeshes.size();
+    header.LodCount = (std::uint32_t)desc.Lods.size();
+    header.MeshletCount = (std::uint32_t)desc.Meshlets.size();
+    header.MeshletVertexCount = (std::uint32_t)desc.MeshletVertices.size();
+    header.MeshletTriangleCount = (std::uint32_t)desc.MeshletTriangles.size();
+    header.Bounds = desc.Bounds;
+    for (int i = 0; i < 3; ++i)
+    {
+        header.PositionScale[i] = desc.PositionScale[i];
+        header.PositionOffset[i] = desc.PositionOffset[i];
+    }
+
+    // 표는 헤더 바로 뒤, 데이터는 페이지 경계부터
+    header.SubmeshOffset = sizeof(MeshFileHeader);
+    header.LodOffset = header.SubmeshOffset + desc.Submeshes.size() * sizeof(MeshFileSubmesh);
+    header.MeshletOffset = AlignUp(header.LodOffset + desc.Lods.size() * sizeof(MeshFileLod), 16);
+    header.MeshletVertexOffset = header.MeshletOffset + desc.Meshlets.size() * sizeof(MeshFileMeshlet);
+    header.MeshletTriangleOffset = header.MeshletVertexOffset + desc.MeshletVertices.size() * sizeof(std::uint32_t);
+    std::uint64_t dataEnd = header.MeshletTriangleOffset + desc.MeshletTriangles.size() * sizeof(std::uint32_t);
+    for (std::uint32_t i = 0; i < header.VertexStreamCount; ++i)
+    {
+        header.VertexStrides[i] = desc.VertexStreams[i].Stride;
+        header.VertexStreamOffsets[i] = AlignUp(dataEnd, MeshFilePageSize);
+        dataEnd = header.VertexStreamOffsets[i] + (std::uint64_t)header.VertexStrides[i] * header.VertexCount;
+    }
+    std::vector<std::uint8_t> compressedIndices;
+    if (desc.CompressIndices)
+        IndexCodec::Encode(desc.Indices, desc.IndexCount, desc.IndexStride, compressedIndices);
+
+    header.IndexDataOffset = AlignUp(dataEnd, MeshFilePageSize);
+    header.IndexDataSize = desc.CompressIndices ? compressedIndices.size() : (std::uint64_t)desc.IndexStride * desc.IndexCount;
+    header.FileSize = header.IndexDataOffset + header.IndexDataSize;
+
+    // 임시 파일에 다 쓴 다음 바꿔치기 (읽는 쪽이 반쯤 쓰인 파일을 매핑하지 않도록)
+    const std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    // 쓴 위치를 직접 센다. (ftell은 Win32에서 32비트)
+    std::uint64_t offset = 0;
+    auto write = [&](const void* data, std::uint64_t size)
+    {
+        offset += size;
+        return size == 0 || std::fwrite(data, 1, (std::size_t)size, file) == size;
+    };
+
+    // 정렬용 빈 공간은 0으로 채운다.
+    const std::uint8_t zeros[MeshFilePageSize] = {};
+    auto pad = [&](std::uint64_t alignedOffset)
+    {
+        return write(zeros, alignedOffset - offset);
+    };
+
+    bool isWritten =
+        write(&header, sizeof(header)) &&
+        write(desc.Submeshes.data(), desc.Submeshes.size() * sizeof(MeshFileSubmesh)) &&
+        write(desc.Lods.data(), desc.Lods.size() * sizeof(MeshFileLod)) &&
+        pad(header.MeshletOffset) &&
+        write(desc.Meshlets.data(), desc.Meshlets.size() * sizeof(MeshFileMeshlet)) &&
+        write(desc.MeshletVertices.data(), desc.MeshletVertices.size() * sizeof(std::uint32_t)) &&
+        write(desc.MeshletTriangles.data(), desc.MeshletTriangles.size() * sizeof(std::uint32_t));
+
+    for (std::uint32_t i = 0; i < header.VertexStreamCount && isWritten; ++i)
+    {
+        isWritten =
+            pad(header.VertexStreamOffsets[i]) &&
+            write(desc.VertexStreams[i].Data, (std::uint64_t)header.VertexStrides[i] * header.VertexCount);
+    }
+
+    isWritten = isWritten &&
+        pad(header.IndexDataOffset) &&
+        write(desc.CompressIndices ? compressedIndices.data() : desc.Indices, header.IndexDataSize);
+
+    isWritten = std::fclose(file) == 0 && isWritten;
+    if (!isWritten)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::remove(path.c_str());
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 쿠킹된 메시 파일 (.mesh)
+// [헤더][서브메시 표][LOD 표][메시렛 표][메시렛 정점][메시렛 삼각형] ... [정점 스트림 0] ... [정점 스트림 1] ... [인덱스 데이터]
+// 정점 스트림/인덱스 데이터는 페이지(4KB) 경계에서 시작하므로 메모리 맵에서 바로 업로드 링으로 복사할 수 있다.
+// 인덱스는 IndexCodec으로 압축해서 저장할 수도 있다. (이때는 로드할 때 풀어서 올린다)
+// 모든 값은 리틀 엔디언, 구조체는 그대로 파일에 쓴다. (형식이 바뀌면 MeshFileVersion을 올린다)
+const std::uint32_t MeshFileMagic = 0x4853454D;     // 'MESH'
+const std::uint32_t MeshFileVersion = 5;     // 2: 양자화된 위치 복원 값, 3: 정점 스트림 분리, 4: 메시렛, 5: 인덱스 압축
+const std::uint32_t MeshFilePageSize = 4096;
+const std::uint32_t MeshFileMaxVertexStreams = 4;
+
+enum class MeshFileIndexEncoding : std::uint32_t
+{
+    Raw,            // IndexStride * IndexCount 바이트 그대로
+    Compressed,     // IndexCodec
+};
+
+// 경계 상자 (DirectX::BoundingBox와 같은 중심 + 반지름 표현)
+struct MeshFileBounds
+{
+    float Center[3] = { 0.0f, 0.0f, 0.0f };
+    float Extents[3] = { 0.0f, 0.0f, 0.0f };
+};
+
+struct MeshFileHeader
+{
+    std::uint32_t Magic = MeshFileMagic;
+    std::uint32_t Version = MeshFileVersion;
+    std::uint64_t FileSize = 0;
+
+    std::uint32_t VertexCount = 0;
+    std::uint32_t VertexStreamCount = 0;    // 1 ~ MeshFileMaxVertexStreams
+    std::uint32_t IndexStride = 0;      // 2 또는 4
+    std::uint32_t IndexCount = 0;
+    MeshFileIndexEncoding IndexEncoding = MeshFileIndexEncoding::Raw;
+    std::uint32_t IndexReserved = 0;
+
+    std::uint32_t SubmeshCount = 0;
+    std::uint32_t LodCount = 0;
+    std::uint64_t SubmeshOffset = 0;
+    std::uint64_t LodOffset = 0;
+
+    std::uint32_t MeshletCount = 0;             // 0이면 메시렛 없음
+    std::uint32_t MeshletVertexCount = 0;
+    std::uint32_t MeshletTriangleCount = 0;
+    std::uint32_t MeshletReserved = 0;
+    std::uint64_t MeshletOffset = 0;
+    std::uint64_t MeshletVertexOffset = 0;
+    std::uint64_t MeshletTriangleOffset = 0;
+
+    // 스트림 i의 크기는 VertexStrides[i] * VertexCount
+    std::uint32_t VertexStrides[MeshFileMaxVertexStreams] = {};
+    std::uint64_t VertexStreamOffsets[MeshFileMaxVertexStreams] = {};
+    std::uint64_t IndexDataOffset = 0;
+    std::uint64_t IndexDataSize = 0;    // 파일 안 크기 (압축했으면 압축된 크기)
+
+    MeshFileBounds Bounds;              // 메시 전체
+
+    // 양자화된 위치 복원 : PosL = q * PositionScale + PositionOffset (양자화하지 않았으면 1, 0)
+    float PositionScale[3] = { 1.0f, 1.0f, 1.0f };
+    float PositionOffset[3] = { 0.0f, 0.0f, 0.0f };
+};
+
+// 서브메시 하나. LOD 0은 서브메시 자체 (IndexCount/StartIndex)이고,
+// 그보다 거친 LOD는 LOD 표의 [FirstLod, FirstLod + LodCount) 구간에 들어 있다. (같은 정점을 쓴다)
+struct MeshFileSubmesh
+{
+    char Name[48] = {};
+    std::uint32_t IndexCount = 0;
+    std::uint32_t StartIndex = 0;
+    std::int32_t BaseVertex = 0;
+    std::uint32_t FirstLod = 0;
+    std::uint32_t LodCount = 0;
+    MeshFileBounds Bounds;
+};
+
+struct MeshFileLod
+{
+    std::uint32_t IndexCount = 0;
+    std::uint32_t StartIndex = 0;
+    float ScreenSize = 0.0f;            // 화면 높이 대비 크기가 이보다 작으면 이 LOD를 쓴다.
+    std::uint32_t Reserved = 0;
+};
+
+// 메시렛 하나 (64바이트, GPU 버퍼에 그대로 올릴 수 있게 16바이트 단위로 맞춘다)
+// 정점은 메시렛 정점 표의 [VertexOffset, VertexOffset + VertexCount) : 메시 정점 번호
+// 삼각형은 메시렛 삼각형 표의 [TriangleOffset, TriangleOffset + TriangleCount) : 메시렛 안 정점 번호 3개를 8비트씩 (a | b << 8 | c << 16)
+// 법선 원뿔 : dot(normalize(ConeApex - 카메라 위치), ConeAxis) >= ConeCutoff 이면 모든 삼각형이 뒷면 (ConeCutoff가 1이면 컬링 불가)
+struct MeshFileMeshlet
+{
+    std::uint32_t VertexOffset = 0;
+    std::uint32_t TriangleOffset = 0;
+    std::uint32_t VertexCount = 0;
+    std::uint32_t TriangleCount = 0;
+
+    float Center[3] = { 0.0f, 0.0f, 0.0f };     // 경계 구
+    float Radius = 0.0f;
+    float ConeApex[3] = { 0.0f, 0.0f, 0.0f };
+    float ConeCutoff = 1.0f;
+    float ConeAxis[3] = { 0.0f, 0.0f, 0.0f };
+    std::uint32_t Reserved = 0;
+};
+
+// 쿠킹할 내용 (정점/인덱스는 호출한 쪽 메모리를 가리킨다)
+struct MeshFileVertexStream
+{
+    const void* Data = nullptr;
+    std::uint32_t Stride = 0;
+};
+
+struct MeshFileDesc
+{
+    std::vector<MeshFileVertexStream> VertexStreams;    // 입력 슬롯 순서
+    std::uint32_t VertexCount = 0;
+
+    const void* Indices = nullptr;
+    std::uint32_t IndexStride = 2;
+    std::uint32_t IndexCount = 0;
+    bool CompressIndices = false;       // 파일은 작아지고 로드할 때 푸는 시간이 든다.
+
+    std::vector<MeshFileSubmesh> Submeshes;
+    std::vector<MeshFileLod> Lods;
+    MeshFileBounds Bounds;
+
+    std::vector<MeshFileMeshlet> Meshlets;
+    std::vector<std::uint32_t> MeshletVertices;
+    std::vector<std::uint32_t> MeshletTriangles;
+
+    float PositionScale[3] = { 1.0f, 1.0f, 1.0f };
+    float PositionOffset[3] = { 0.0f, 0.0f, 0.0f };
+};
+
+// 쿠킹된 메시 파일 읽기
+// 파일을 매핑만 하고 복사하지 않는다. 반환하는 포인터는 Close 전까지 유효하다.
+class MeshFile
+{
+public:
+    MeshFile() = default;
+    MeshFile(const MeshFile& rhs) = delete;
+    MeshFile& operator=(const MeshFile& rhs) = delete;
+
+    // 파일이 없거나 형식/버전이 다르거나 잘렸으면 false
+    bool Open(const std::string& path);
+    void Close();
+
+    // 쿠킹 (임시 파일에 쓴 다음 바꿔치기)
+    static bool Write(const std::string& path, const MeshFileDesc& desc);
+
+    bool IsOpen()const { return mHeader != nullptr; }
+
+    const MeshFileHeader& GetHeader()const { return *mHeader; }
+    const MeshFileSubmesh* GetSubmeshes()const { return mSubmeshes; }
+    const MeshFileLod* GetLods()const { return mLods; }
+    const MeshFileMeshlet* GetMeshlets()const { return mMeshlets; }
+    const std::uint32_t* GetMeshletVertices()const { return mMeshletVertices; }
+    const std::uint32_t* GetMeshletTriangles()const { return mMeshletTriangles; }
+
+    const std::uint8_t* GetVertexData(std::uint32_t stream)const { return mFile.GetData() + mHeader->VertexStreamOffsets[stream]; }
+    std::uint64_t GetVertexDataSize(std::uint32_t stream)const { return (std::uint64_t)mHeader->VertexStrides[stream] * mHeader->VertexCount; }
+    const std::uint8_t* GetIndexData()const { return mFile.GetData() + mHeader->IndexDataOffset; }
+    bool IsIndexCompressed()const { return mHeader->IndexEncoding == MeshFileIndexEncoding::Compressed; }
+
+    // 압축 여부와 상관없이 dst(IndexStride * IndexCount 바이트)에 인덱스를 푼다. 압축 데이터가 깨졌으면 false
+    bool DecodeIndices(void* dst)const;
+
+    // 정점/인덱스 페이지를 미리 읽어 두도록 OS에 알린다. (복사 중 페이지 폴트를 줄인다)
+    void Prefetch()const;
+
+private:
+    bool Validate()const;
+
+private:
+    MappedFile mFile;
+    const MeshFileHeader* mHeader = nullptr;
+    const MeshFileSubmesh* mSubmeshes = nullptr;
+    const MeshFileLod* mLods = nullptr;
+    const MeshFileMeshlet* mMeshlets = nullptr;
+    const std::uint32_t* mMeshletVertices = nullptr;
+    const std::uint32_t* mMeshletTriangles = nullptr;
+};
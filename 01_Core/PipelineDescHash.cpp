@@ -0,0 +1,164 @@
+#include "PipelineDescHash.h"
+#include "Hasher.h"
+
+#include <algorithm>
+
+namespace
+{
+    // -0.0과 0.0을 같은 값으로
+    float NormalizeFloat(float value)
+    {
+        return value + 0.0f;
+    }
+
+    void HashShader(Hasher& hasher, const PipelineShaderDesc& shader)
+    {
+        hasher.Add((std::uint64_t)shader.Size);
+        if (shader.Size > 0)
+            hasher.Add(Hasher::HashBytes(shader.Data, shader.Size));
+    }
+
+    void HashStreamOutput(Hasher& hasher, const GraphicsPipelineDesc& desc)
+    {
+        hasher.Add((std::uint32_t)desc.StreamOutputEntries.size());
+        if (desc.StreamOutputEntries.empty())
+            return;
+
+        for (const PipelineStreamOutputEntry& entry : desc.StreamOutputEntries)
+        {
+            hasher.Add(entry.Stream);
+            hasher.AddString(entry.SemanticName != nullptr ? entry.SemanticName : "");
+            hasher.Add(entry.SemanticIndex);
+            hasher.Add(entry.StartComponent);
+            hasher.Add(entry.ComponentCount);
+            hasher.Add(entry.OutputSlot);
+        }
+
+        hasher.Add((std::uint32_t)desc.StreamOutputStrides.size());
+        for (std::uint32_t stride : desc.StreamOutputStrides)
+            hasher.Add(stride);
+        hasher.Add(desc.RasterizedStream);
+    }
+
+    void HashBlend(Hasher& hasher, const PipelineBlendDesc& desc, std::uint32_t numRenderTargets)
+    {
+        hasher.Add(desc.AlphaToCoverageEnable);
+        hasher.Add(desc.IndependentBlendEnable);
+
+        // IndependentBlendEnable이 꺼져 있으면 0번 설정만 쓰인다.
+        const std::uint32_t count = desc.IndependentBlendEnable ? numRenderTargets : 1;
+        for (std::uint32_t i = 0; i < count && i < 8; ++i)
+        {
+            const PipelineRenderTargetBlendDesc& rt = desc.RenderTarget[i];
+            hasher.Add(rt.BlendEnable);
+            hasher.Add(rt.LogicOpEnable);
+            if (rt.BlendEnable)
+            {
+                hasher.Add(rt.SrcBlend);
+                hasher.Add(rt.DestBlend);
+                hasher.Add(rt.BlendOp);
+                hasher.Add(rt.SrcBlendAlpha);
+                hasher.Add(rt.DestBlendAlpha);
+                hasher.Add(rt.BlendOpAlpha);
+            }
+            if (rt.LogicOpEnable)
+                hasher.Add(rt.LogicOp);
+            hasher.Add(rt.RenderTargetWriteMask);
+        }
+    }
+
+    void HashRasterizer(Hasher& hasher, const PipelineRasterizerDesc& desc)
+    {
+        hasher.Add(desc.FillMode);
+        hasher.Add(desc.CullMode);
+        hasher.Add(desc.FrontCounterClockwise);
+        hasher.Add(desc.DepthBias);
+        hasher.Add(NormalizeFloat(desc.DepthBiasClamp));
+        hasher.Add(NormalizeFloat(desc.SlopeScaledDepthBias));
+        hasher.Add(desc.DepthClipEnable);
+        hasher.Add(desc.MultisampleEnable);
+        hasher.Add(desc.AntialiasedLineEnable);
+        hasher.Add(desc.ForcedSampleCount);
+        hasher.Add(desc.ConservativeRaster);
+    }
+
+    void HashStencilOp(Hasher& hasher, const PipelineStencilOpDesc& desc)
+    {
+        hasher.Add(desc.StencilFailOp);
+        hasher.Add(desc.StencilDepthFailOp);
+        hasher.Add(desc.StencilPassOp);
+        hasher.Add(desc.StencilFunc);
+    }
+
+    void HashDepthStencil(Hasher& hasher, const PipelineDepthStencilDesc& desc)
+    {
+        // 꺼진 테스트의 세부 설정은 결과에 영향이 없다.
+        hasher.Add(desc.DepthEnable);
+        if (desc.DepthEnable)
+        {
+            hasher.Add(desc.DepthWriteMask);
+            hasher.Add(desc.DepthFunc);
+        }
+
+        hasher.Add(desc.StencilEnable);
+        if (desc.StencilEnable)
+        {
+            hasher.Add(desc.StencilReadMask);
+            hasher.Add(desc.StencilWriteMask);
+            HashStencilOp(hasher, desc.FrontFace);
+            HashStencilOp(hasher, desc.BackFace);
+        }
+    }
+
+    void HashInputLayout(Hasher& hasher, const std::vector<PipelineInputElementDesc>& elements)
+    {
+        hasher.Add((std::uint32_t)elements.size());
+        for (const PipelineInputElementDesc& element : elements)
+        {
+            hasher.AddString(element.SemanticName != nullptr ? element.SemanticName : "");
+            hasher.Add(element.SemanticIndex);
+            hasher.Add(element.Format);
+            hasher.Add(element.InputSlot);
+            hasher.Add(element.AlignedByteOffset);
+            hasher.Add(element.InputSlotClass);
+            if (element.InputSlotClass == 1)
+                hasher.Add(element.InstanceDataStepRate);
+        }
+    }
+}
+
+std::uint64_t HashGraphicsPipelineDesc(const GraphicsPipelineDesc& desc)
+{
+    Hasher hasher;
+    hasher.Add(desc.RootSignatureHash);
+
+    HashShader(hasher, desc.VS);
+    HashShader(hasher, desc.PS);
+    HashShader(hasher, desc.DS);
+    HashShader(hasher, desc.HS);
+    HashShader(hasher, desc.GS);
+    HashStreamOutput(hasher, desc);
+
+    const std::uint32_t numRenderTargets = std::min<std::uint32_t>(desc.NumRenderTargets, 8);
+    HashBlend(hasher, desc.BlendState, numRenderTargets);
+    hasher.Add(desc.SampleMask);
+    HashRasterizer(hasher, desc.RasterizerState);
+    HashDepthStencil(hasher, desc.DepthStencilState);
+    HashInputLayout(hasher, desc.InputLayout);
+    hasher.Add(desc.IBStripCutValue);
+    hasher.Add(desc.PrimitiveTopologyType);
+
+    // 쓰지 않는 렌더 타겟 슬롯의 포맷은 무시
+    hasher.Add(numRenderTargets);
+    for (std::uint32_t i = 0; i < numRenderTargets; ++i)
+        hasher.Add(desc.RTVFormats[i]);
+    hasher.Add(desc.DSVFormat);
+
+    hasher.Add(desc.SampleCount);
+    hasher.Add(desc.SampleQuality);
+    hasher.Add(desc.NodeMask);
+    hasher.Add(desc.Flags);
+
+    // CachedPSO는 결과가 아니라 만드는 방법이므로 설명에 없다.
+    return hasher.Get();
+}
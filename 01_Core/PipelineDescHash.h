@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// PSO 키를 만들 때 쓰는 그래픽스 파이프라인 설명 (그래픽스 API 헤더 없이)
+// 값은 D3D12_GRAPHICS_PIPELINE_STATE_DESC와 같다. (enum은 정수, BOOL은 0/1, 포인터는 내용으로)
+// PipelineStateCache가 D3D12 설명을 이 구조체로 옮겨서 해시한다.
+
+struct PipelineShaderDesc
+{
+    const void* Data = nullptr;
+    std::size_t Size = 0;
+};
+
+struct PipelineRenderTargetBlendDesc
+{
+    std::uint32_t BlendEnable = 0;
+    std::uint32_t LogicOpEnable = 0;
+    std::uint32_t SrcBlend = 0;
+    std::uint32_t DestBlend = 0;
+    std::uint32_t BlendOp = 0;
+    std::uint32_t SrcBlendAlpha = 0;
+    std::uint32_t DestBlendAlpha = 0;
+    std::uint32_t BlendOpAlpha = 0;
+    std::uint32_t LogicOp = 0;
+    std::uint8_t RenderTargetWriteMask = 0;
+};
+
+struct PipelineBlendDesc
+{
+    std::uint32_t AlphaToCoverageEnable = 0;
+    std::uint32_t IndependentBlendEnable = 0;
+    PipelineRenderTargetBlendDesc RenderTarget[8];
+};
+
+struct PipelineRasterizerDesc
+{
+    std::uint32_t FillMode = 0;
+    std::uint32_t CullMode = 0;
+    std::uint32_t FrontCounterClockwise = 0;
+    std::int32_t DepthBias = 0;
+    float DepthBiasClamp = 0.0f;
+    float SlopeScaledDepthBias = 0.0f;
+    std::uint32_t DepthClipEnable = 0;
+    std::uint32_t MultisampleEnable = 0;
+    std::uint32_t AntialiasedLineEnable = 0;
+    std::uint32_t ForcedSampleCount = 0;
+    std::uint32_t ConservativeRaster = 0;
+};
+
+struct PipelineStencilOpDesc
+{
+    std::uint32_t StencilFailOp = 0;
+    std::uint32_t StencilDepthFailOp = 0;
+    std::uint32_t StencilPassOp = 0;
+    std::uint32_t StencilFunc = 0;
+};
+
+struct PipelineDepthStencilDesc
+{
+    std::uint32_t DepthEnable = 0;
+    std::uint32_t DepthWriteMask = 0;
+    std::uint32_t DepthFunc = 0;
+    std::uint32_t StencilEnable = 0;
+    std::uint8_t StencilReadMask = 0;
+    std::uint8_t StencilWriteMask = 0;
+    PipelineStencilOpDesc FrontFace;
+    PipelineStencilOpDesc BackFace;
+};
+
+struct PipelineInputElementDesc
+{
+    const char* SemanticName = nullptr;
+    std::uint32_t SemanticIndex = 0;
+    std::uint32_t Format = 0;
+    std::uint32_t InputSlot = 0;
+    std::uint32_t AlignedByteOffset = 0;
+    std::uint32_t InputSlotClass = 0;       // 1 = 인스턴스 데이터
+    std::uint32_t InstanceDataStepRate = 0;
+};
+
+struct PipelineStreamOutputEntry
+{
+    std::uint32_t Stream = 0;
+    const char* SemanticName = nullptr;
+    std::uint32_t SemanticIndex = 0;
+    std::uint8_t StartComponent = 0;
+    std::uint8_t ComponentCount = 0;
+    std::uint8_t OutputSlot = 0;
+};
+
+struct GraphicsPipelineDesc
+{
+    std::uint64_t RootSignatureHash = 0;    // 직렬화된 루트 시그니처 내용 해시
+
+    PipelineShaderDesc VS;
+    PipelineShaderDesc PS;
+    PipelineShaderDesc DS;
+    PipelineShaderDesc HS;
+    PipelineShaderDesc GS;
+
+    std::vector<PipelineStreamOutputEntry> StreamOutputEntries;
+    std::vector<std::uint32_t> StreamOutputStrides;
+    std::uint32_t RasterizedStream = 0;
+
+    PipelineBlendDesc BlendState;
+    std::uint32_t SampleMask = 0;
+    PipelineRasterizerDesc RasterizerState;
+    PipelineDepthStencilDesc DepthStencilState;
+    std::vector<PipelineInputElementDesc> InputLayout;
+    std::uint32_t IBStripCutValue = 0;
+    std::uint32_t PrimitiveTopologyType = 0;
+    std::uint32_t NumRenderTargets = 0;
+    std::uint32_t RTVFormats[8] = {};
+    std::uint32_t DSVFormat = 0;
+    std::uint32_t SampleCount = 1;
+    std::uint32_t SampleQuality = 0;
+    std::uint32_t NodeMask = 0;
+    std::uint32_t Flags = 0;
+};
+
+// 결과에 영향을 주지 않는 필드(쓰지 않는 렌더 타겟, 꺼진 블렌드/스텐실 설정, 포인터 값 등)를 빼고 해시한다.
+// 포인터 값이 들어가지 않으므로 실행/플랫폼이 바뀌어도 같은 설명이면 같은 키가 나온다.
+std::uint64_t HashGraphicsPipelineDesc(const GraphicsPipelineDesc& desc);
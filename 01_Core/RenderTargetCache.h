@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 크기/포맷별 렌더 타겟 재사용 규칙 (그래픽스 API 없이 동작)
+// TTarget은 Width, Height, Format, ReleaseFrame, IsInUse 멤버를 가진다.
+// 실제 텍스처는 호출하는 쪽이 만들고 놓는다. (Acquire의 create, Collect/Clear의 destroy)
+// 프레임 번호는 호출하는 쪽이 정하는 단조 증가 값이다. (GPU 펜스 또는 스냅샷 번호)
+template<typename TTarget>
+class RenderTargetCache
+{
+public:
+    using Format = decltype(TTarget::Format);
+
+    // 요청 면적(버킷 단위로 올림)의 이 배수를 넘는 타겟에는 그리지 않는다.
+    // 빌릴 때와 빌린 타겟을 계속 쓸지 정할 때 같은 기준을 쓴다.
+    // 4배 = 한 축 0.5배이므로 동적 해상도 배율(0.5~1.0)이 바뀌어도 같은 타겟 안에서 뷰포트만 바뀐다.
+    static constexpr std::uint64_t MaxAreaRatio = 4;
+
+public:
+    void SetBucketSize(std::uint32_t bucketSize) { mBucketSize = std::max<std::uint32_t>(bucketSize, 1); }
+    std::uint32_t RoundUp(std::uint32_t value)const { return (value + mBucketSize - 1) / mBucketSize * mBucketSize; }
+
+    // target에 width x height를 그려도 되는지 (들어가고, 면적이 MaxAreaRatio배를 넘지 않는다)
+    bool IsFit(const TTarget& target, std::uint32_t width, std::uint32_t height)const
+    {
+        width = std::max<std::uint32_t>(width, 1);
+        height = std::max<std::uint32_t>(height, 1);
+        if (target.Width < width || target.Height < height)
+            return false;
+
+        const std::uint64_t requestArea = (std::uint64_t)RoundUp(width) * RoundUp(height);
+        return (std::uint64_t)target.Width * target.Height <= requestArea * MaxAreaRatio;
+    }
+
+    // 다시 빌려줄 수 있는 타겟 중 면적이 가장 작은 것을 빌린다.
+    // 없으면 create(버킷 단위 너비, 높이, 포맷)로 만든 std::unique_ptr<TTarget>를 넣는다.
+    template<typename TCreate>
+    TTarget* Acquire(std::uint32_t width, std::uint32_t height, Format format, TCreate&& create)
+    {
+        width = std::max<std::uint32_t>(width, 1);
+        height = std::max<std::uint32_t>(height, 1);
+
+        TTarget* best = nullptr;
+        for (auto& target : mTargets)
+        {
+            if (target->IsInUse || target->ReleaseFrame > mCompletedFrame)
+                continue;
+            if (target->Format != format || !IsFit(*target, width, height))
+                continue;
+
+            if (best == nullptr || (std::uint64_t)target->Width * target->Height < (std::uint64_t)best->Width * best->Height)
+                best = target.get();
+        }
+
+        if (best == nullptr)
+        {
+            mTargets.push_back(create(RoundUp(width), RoundUp(height), format));
+            best = mTargets.back().get();
+        }
+
+        best->IsInUse = true;
+        return best;
+    }
+
+    // frame 이후로는 쓰지 않는다는 뜻 (completedFrame이 frame 이상이 되면 다시 빌려준다)
+    void Release(TTarget* target, std::uint64_t frame)
+    {
+        if (target == nullptr)
+            return;
+
+        target->IsInUse = false;
+        target->ReleaseFrame = frame;
+    }
+
+    // completedFrame : GPU가 다 쓴 마지막 프레임
+    // 반환된 뒤 maxIdleFrames 동안 아무도 빌리지 않은 타겟은 destroy(TTarget&) 후 뺀다.
+    template<typename TDestroy>
+    void Collect(std::uint64_t completedFrame, std::uint64_t maxIdleFrames, TDestroy&& destroy)
+    {
+        mCompletedFrame = std::max<std::uint64_t>(mCompletedFrame, completedFrame);
+
+        auto it = std::remove_if(mTargets.begin(), mTargets.end(), [&](std::unique_ptr<TTarget>& target)
+        {
+            if (target->IsInUse || target->ReleaseFrame + maxIdleFrames > mCompletedFrame)
+                return false;
+
+            destroy(*target);
+            return true;
+        });
+        mTargets.erase(it, mTargets.end());
+    }
+
+    // 빌려준 타겟까지 모두 뺀다.
+    template<typename TDestroy>
+    void Clear(TDestroy&& destroy)
+    {
+        for (auto& target : mTargets)
+            destroy(*target);
+        mTargets.clear();
+    }
+
+    std::uint64_t GetCompletedFrame()const { return mCompletedFrame; }
+    const std::vector<std::unique_ptr<TTarget>>& GetTargets()const { return mTargets; }
+
+private:
+    std::uint32_t mBucketSize = 64;
+    std::uint64_t mCompletedFrame = 0;
+
+    std::vector<std::unique_ptr<TTarget>> mTargets;
+};
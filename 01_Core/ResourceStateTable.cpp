@@ -0,0 +1,244 @@
+#include "ResourceStateTable.h"
+
+#include <cassert>
+#include <iterator>
+
+void ResourceStateTable::SetState(const void* resource, std::uint32_t state, std::uint32_t subresourceCount)
+{
+    TrackedResource& tracked = mResources[resource];
+    tracked.State = state;
+    tracked.SubresourceCount = subresourceCount > 0 ? subresourceCount : 1;
+    tracked.SubresourceStates.clear();
+}
+
+void ResourceStateTable::Untrack(const void* resource)
+{
+    mResources.erase(resource);
+}
+
+bool ResourceStateTable::IsTracked(const void* resource)const
+{
+    return mResources.find(resource) != mResources.end();
+}
+
+std::uint32_t ResourceStateTable::GetState(const void* resource, std::uint32_t subresource)const
+{
+    auto it = mResources.find(resource);
+    if (it == mResources.end())
+        return 0;
+
+    const TrackedResource& tracked = it->second;
+    if (tracked.SubresourceStates.empty() || subresource == AllSubresources)
+        return tracked.State;
+
+    return tracked.SubresourceStates[subresource];
+}
+
+void ResourceStateTable::Transition(const void* resource, std::uint32_t after, std::uint32_t subresource)
+{
+    auto it = mResources.find(resource);
+    assert(it != mResources.end() && "추적하지 않는 리소스");
+    if (it == mResources.end())
+        return;
+
+    TrackedResource& tracked = it->second;
+    ++mStats.Requested;
+
+    if (subresource == AllSubresources)
+    {
+        if (tracked.SubresourceStates.empty())
+        {
+            if (IsSatisfied(tracked.State, after))
+            {
+                ++mStats.Dropped;
+                return;
+            }
+
+            AddTransition(resource, subresource, tracked.State, after);
+            tracked.State = after;
+            return;
+        }
+
+        // 서브리소스마다 상태가 다르면 다른 것만 전환
+        for (std::uint32_t i = 0; i < tracked.SubresourceCount; ++i)
+        {
+            if (IsSatisfied(tracked.SubresourceStates[i], after))
+                continue;
+
+            AddTransition(resource, i, tracked.SubresourceStates[i], after);
+            SetSubresourceState(tracked, i, after);
+        }
+        return;
+    }
+
+    std::uint32_t before = tracked.SubresourceStates.empty() ? tracked.State : tracked.SubresourceStates[subresource];
+    if (IsSatisfied(before, after))
+    {
+        ++mStats.Dropped;
+        return;
+    }
+
+    AddTransition(resource, subresource, before, after);
+    SetSubresourceState(tracked, subresource, after);
+}
+
+void ResourceStateTable::BeginTransition(const void* resource, std::uint32_t after, std::uint32_t subresource)
+{
+    auto it = mResources.find(resource);
+    assert(it != mResources.end() && "추적하지 않는 리소스");
+    if (it == mResources.end())
+        return;
+
+    TrackedResource& tracked = it->second;
+    ++mStats.Requested;
+
+    std::uint32_t before = (tracked.SubresourceStates.empty() || subresource == AllSubresources)
+        ? tracked.State : tracked.SubresourceStates[subresource];
+    if (IsSatisfied(before, after))
+    {
+        ++mStats.Dropped;
+        return;
+    }
+
+    StateBarrier barrier;
+    barrier.Split = StateBarrierSplit::Begin;
+    barrier.Resource = resource;
+    barrier.Subresource = subresource;
+    barrier.StateBefore = before;
+    barrier.StateAfter = after;
+    mPending.push_back(barrier);
+
+    SplitTransition split;
+    split.Resource = resource;
+    split.Subresource = subresource;
+    split.Before = before;
+    split.After = after;
+    mSplits.push_back(split);
+
+    if (subresource == AllSubresources)
+    {
+        tracked.State = after;
+        tracked.SubresourceStates.clear();
+    }
+    else
+    {
+        SetSubresourceState(tracked, subresource, after);
+    }
+}
+
+void ResourceStateTable::EndTransition(const void* resource, std::uint32_t subresource)
+{
+    for (auto it = mSplits.begin(); it != mSplits.end(); ++it)
+    {
+        if (it->Resource != resource || it->Subresource != subresource)
+            continue;
+
+        StateBarrier barrier;
+        barrier.Split = StateBarrierSplit::End;
+        barrier.Resource = resource;
+        barrier.Subresource = subresource;
+        barrier.StateBefore = it->Before;
+        barrier.StateAfter = it->After;
+        mPending.push_back(barrier);
+
+        mSplits.erase(it);
+        return;
+    }
+
+    // Begin이 버려진 경우 (이미 같은 상태) End도 필요 없다.
+}
+
+void ResourceStateTable::Aliasing(const void* before, const void* after)
+{
+    ++mStats.Requested;
+
+    StateBarrier barrier;
+    barrier.Type = StateBarrierType::Aliasing;
+    barrier.Resource = before;
+    barrier.ResourceAfter = after;
+    mPending.push_back(barrier);
+}
+
+void ResourceStateTable::UAV(const void* resource)
+{
+    ++mStats.Requested;
+
+    StateBarrier barrier;
+    barrier.Type = StateBarrierType::UAV;
+    barrier.Resource = resource;
+    mPending.push_back(barrier);
+}
+
+void ResourceStateTable::ClearPending()
+{
+    if (mPending.empty())
+        return;
+
+    mStats.Submitted += mPending.size();
+    ++mStats.FlushCalls;
+
+    mPending.clear();
+}
+
+// 현재 상태가 요청한 읽기 상태를 모두 포함하면 전환이 필요 없다.
+bool ResourceStateTable::IsSatisfied(std::uint32_t current, std::uint32_t required)const
+{
+    if (current == required)
+        return true;
+
+    return IsReadState(current) && IsReadState(required) && (current & required) == required;
+}
+
+// 같은 배치 안에 같은 리소스의 전환이 있으면 하나로 합친다. (A->B, B->C => A->C)
+// 그 리소스에 대한 마지막 배리어일 때만 합친다. (뒤에 다른 서브리소스 전환이나 Split/UAV/Aliasing이 있으면 순서가 바뀐다)
+void ResourceStateTable::AddTransition(const void* resource, std::uint32_t subresource, std::uint32_t before, std::uint32_t after)
+{
+    for (auto it = mPending.rbegin(); it != mPending.rend(); ++it)
+    {
+        if (it->Resource != resource && it->ResourceAfter != resource)
+            continue;
+
+        if (it->Type != StateBarrierType::Transition || it->Split != StateBarrierSplit::None || it->Subresource != subresource)
+            break;
+
+        it->StateAfter = after;
+        ++mStats.Dropped;
+
+        // A->B, B->A 는 서로 상쇄
+        if (it->StateBefore == it->StateAfter)
+        {
+            mPending.erase(std::next(it).base());
+            ++mStats.Dropped;
+        }
+        return;
+    }
+
+    StateBarrier barrier;
+    barrier.Resource = resource;
+    barrier.Subresource = subresource;
+    barrier.StateBefore = before;
+    barrier.StateAfter = after;
+    mPending.push_back(barrier);
+}
+
+void ResourceStateTable::SetSubresourceState(TrackedResource& tracked, std::uint32_t subresource, std::uint32_t state)
+{
+    if (tracked.SubresourceStates.empty())
+    {
+        if (tracked.State == state)
+            return;
+        tracked.SubresourceStates.assign(tracked.SubresourceCount, tracked.State);
+    }
+
+    tracked.SubresourceStates[subresource] = state;
+
+    // 모든 서브리소스가 같은 상태가 되면 다시 하나로 합친다.
+    for (std::uint32_t i = 1; i < tracked.SubresourceCount; ++i)
+    {
+        if (tracked.SubresourceStates[i] != tracked.SubresourceStates[0])
+            return;
+    }
+
+    tracked.State = tracked.SubresourceStates[0];
+    tracked.SubresourceStates.clear();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 배리어 통계
+struct ResourceStateTrackerStats
+{
+    std::uint64_t Requested = 0;    // 요청된 전환 수
+    std::uint64_t Dropped = 0;      // 이미 같은 상태라서 (또는 서로 상쇄되어) 버려진 전환 수
+    std::uint64_t Submitted = 0;    // 실제로 제출된 배리어 수
+    std::uint64_t FlushCalls = 0;   // ResourceBarrier 호출 수
+};
+
+enum class StateBarrierType
+{
+    Transition,
+    Aliasing,
+    UAV
+};
+
+enum class StateBarrierSplit
+{
+    None,
+    Begin,
+    End
+};
+
+// 쌓인 배리어 하나 (D3D12_RESOURCE_BARRIER와 같은 내용)
+struct StateBarrier
+{
+    StateBarrierType Type = StateBarrierType::Transition;
+    StateBarrierSplit Split = StateBarrierSplit::None;
+    const void* Resource = nullptr;         // Aliasing : 앞서 쓰던 리소스
+    const void* ResourceAfter = nullptr;    // Aliasing : 새로 쓸 리소스
+    std::uint32_t Subresource = 0;
+    std::uint32_t StateBefore = 0;
+    std::uint32_t StateAfter = 0;
+};
+
+// 리소스(서브리소스)의 현재 상태를 기억하고 필요한 배리어만 쌓아 두는 상태 표
+// 그래픽스 API 헤더 없이 동작한다. (ResourceStateTracker가 D3D12 배리어로 바꿔서 제출)
+// 상태는 비트 집합이고 0이 COMMON이다. 쓰기 상태 비트는 생성할 때 받는다.
+// 리소스는 포인터 값으로만 구분한다.
+class ResourceStateTable
+{
+public:
+    static constexpr std::uint32_t AllSubresources = 0xFFFFFFFF;
+
+public:
+    explicit ResourceStateTable(std::uint32_t writeStates) : mWriteStates(writeStates) {}
+    ResourceStateTable(const ResourceStateTable& rhs) = delete;
+    ResourceStateTable& operator=(const ResourceStateTable& rhs) = delete;
+
+    // 리소스 등록 (이미 있으면 상태를 덮어쓴다)
+    void SetState(const void* resource, std::uint32_t state, std::uint32_t subresourceCount = 1);
+    void Untrack(const void* resource);
+    bool IsTracked(const void* resource)const;
+
+    std::uint32_t GetState(const void* resource, std::uint32_t subresource = AllSubresources)const;
+
+    // 상태 전환 요청 (필요 없는 전환은 버린다)
+    void Transition(const void* resource, std::uint32_t after, std::uint32_t subresource = AllSubresources);
+
+    // Split 배리어 : Begin과 End 사이의 작업과 전환이 겹칠 수 있다.
+    // Begin 이후 End 전까지 리소스를 사용하면 안 된다.
+    void BeginTransition(const void* resource, std::uint32_t after, std::uint32_t subresource = AllSubresources);
+    void EndTransition(const void* resource, std::uint32_t subresource = AllSubresources);
+
+    void Aliasing(const void* before, const void* after);
+    void UAV(const void* resource);
+
+    const std::vector<StateBarrier>& GetPending()const { return mPending; }
+    // 쌓인 배리어를 제출한 뒤 호출
+    void ClearPending();
+
+    const ResourceStateTrackerStats& GetStats()const { return mStats; }
+    void ResetStats() { mStats = ResourceStateTrackerStats(); }
+
+    // 쓰기 상태가 없는 읽기 상태끼리는 합쳐서 한 번에 전환할 수 있다.
+    bool IsReadState(std::uint32_t state)const { return state != 0 && (state & mWriteStates) == 0; }
+
+private:
+    struct TrackedResource
+    {
+        std::uint32_t State = 0;
+        std::uint32_t SubresourceCount = 1;
+
+        // 서브리소스마다 상태가 다를 때만 사용 (비어 있으면 모두 State)
+        std::vector<std::uint32_t> SubresourceStates;
+    };
+
+    struct SplitTransition
+    {
+        const void* Resource = nullptr;
+        std::uint32_t Subresource = 0;
+        std::uint32_t Before = 0;
+        std::uint32_t After = 0;
+    };
+
+    bool IsSatisfied(std::uint32_t current, std::uint32_t required)const;
+
+    void AddTransition(const void* resource, std::uint32_t subresource, std::uint32_t before, std::uint32_t after);
+    void SetSubresourceState(TrackedResource& tracked, std::uint32_t subresource, std::uint32_t state);
+
+private:
+    std::uint32_t mWriteStates = 0;
+
+    std::unordered_map<const void*, TrackedResource> mResources;
+    std::vector<StateBarrier> mPending;
+    std::vector<SplitTransition> mSplits;
+
+    ResourceStateTrackerStats mStats;
+};
@@ -0,0 +1,371 @@
+#include "ShaderCache.h"
+#include "Hasher.h"
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
+namespace
+{
+    const std::uint32_t CacheMagic = 0x43444853;   // 'SHDC'
+    const std::uint32_t CacheVersion = 1;
+
+    // 캐시 파일 읽기 (범위를 넘으면 실패)
+    class Reader
+    {
+    public:
+        Reader(const std::uint8_t* data, std::size_t size) : mData(data), mSize(size) {}
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            if (mSize - mOffset < sizeof(T))
+                return false;
+            std::memcpy(&value, mData + mOffset, sizeof(T));
+            mOffset += sizeof(T);
+            return true;
+        }
+
+        bool ReadBytes(std::size_t size, const std::uint8_t*& bytes)
+        {
+            if (mSize - mOffset < size)
+                return false;
+            bytes = mData + mOffset;
+            mOffset += size;
+            return true;
+        }
+
+        std::size_t GetRemaining()const { return mSize - mOffset; }
+
+    private:
+        const std::uint8_t* mData;
+        std::size_t mSize;
+        std::size_t mOffset = 0;
+    };
+
+    template<typename T>
+    void Write(std::vector<std::uint8_t>& buffer, const T& value)
+    {
+        const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+void ShaderCache::Open(const std::string& cachePath, IShaderCompiler* compiler)
+{
+    Close();
+
+    mCachePath = cachePath;
+    mCompiler = compiler;
+    mCompilerHash = Hasher().AddString(compiler->GetIdentity()).Get();
+
+    if (!Load())
+    {
+        // 손상되었거나 다른 버전의 캐시 : 버리고 새로 만든다.
+        // (Save 전에 끝나도 다음 실행이 같은 파일을 다시 읽지 않도록 파일도 지운다)
+        mEntries.clear();
+        mBlobs.clear();
+        mFile.Close();
+        std::remove(mCachePath.c_str());
+        mIsDirty = true;
+    }
+}
+
+void ShaderCache::Close()
+{
+    mEntries.clear();
+    mBlobs.clear();
+    mFileHashes.clear();
+    mFile.Close();
+    mIsDirty = false;
+    mStats = Stats();
+}
+
+bool ShaderCache::GetOrCompile(const ShaderCompileDesc& desc, ShaderBytecode& bytecode, std::string* errors)
+{
+    const std::uint64_t requestKey = GetRequestKey(desc);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // 마지막 컴파일 때의 의존 파일이 모두 그대로면 히트
+        auto it = mEntries.find(requestKey);
+        if (it != mEntries.end())
+        {
+            bool isValid = true;
+            for (const Dependency& dependency : it->second.Dependencies)
+            {
+                std::uint64_t hash = 0;
+                if (!HashFile(dependency.Path, hash) || hash != dependency.Hash)
+                {
+                    isValid = false;
+                    break;
+                }
+            }
+
+            auto blob = mBlobs.find(it->second.ContentKey);
+            if (isValid && blob != mBlobs.end())
+            {
+                ++mStats.Hits;
+                bytecode.Data = blob->second.Data;
+                bytecode.Size = blob->second.Size;
+                return true;
+            }
+
+            ++mStats.Invalidated;
+        }
+        else
+        {
+            ++mStats.Misses;
+        }
+    }
+
+    // 컴파일은 잠그지 않고 한다. (여러 스레드에서 서로 다른 변형을 동시에 컴파일)
+    ShaderCompileOutput output;
+    const bool isCompiled = mCompiler->Compile(desc, output);
+    if (errors != nullptr)
+        *errors = output.Errors;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (!isCompiled)
+    {
+        ++mStats.Failures;
+        return false;
+    }
+
+    // 컴파일에 쓰인 파일들의 내용 해시 (원본이 0번)
+    Entry entry;
+    entry.Dependencies.reserve(output.Dependencies.size() + 1);
+
+    Dependency source;
+    source.Path = desc.SourcePath;
+    HashFile(source.Path, source.Hash);
+    entry.Dependencies.push_back(source);
+
+    for (const std::string& path : output.Dependencies)
+    {
+        Dependency dependency;
+        dependency.Path = path;
+        HashFile(path, dependency.Hash);
+        entry.Dependencies.push_back(dependency);
+    }
+
+    entry.ContentKey = GetContentKey(desc, entry.Dependencies);
+
+    // 내용 키가 같으면 결과도 같으므로 이미 있는 바이트코드는 바꾸지 않는다. (다른 스레드가 들고 있을 수 있다)
+    Blob& blob = mBlobs[entry.ContentKey];
+    if (blob.Data == nullptr)
+    {
+        blob.Owned = std::move(output.Bytecode);
+        blob.Data = blob.Owned.data();
+        blob.Size = blob.Owned.size();
+    }
+
+    mEntries[requestKey] = std::move(entry);
+    mIsDirty = true;
+
+    bytecode.Data = blob.Data;
+    bytecode.Size = blob.Size;
+    return true;
+}
+
+bool ShaderCache::Save()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (!mIsDirty || mCachePath.empty())
+        return true;
+
+    // 요청에서 참조하는 바이트코드만 저장 (옛 내용 키는 여기서 정리된다)
+    std::unordered_set<std::uint64_t> liveBlobs;
+    for (const auto& pair : mEntries)
+        liveBlobs.insert(pair.second.ContentKey);
+
+    std::vector<std::uint8_t> buffer;
+    Write(buffer, CacheMagic);
+    Write(buffer, CacheVersion);
+    Write(buffer, mCompilerHash);
+    Write(buffer, (std::uint32_t)mEntries.size());
+    Write(buffer, (std::uint32_t)liveBlobs.size());
+
+    for (const auto& pair : mEntries)
+    {
+        const Entry& entry = pair.second;
+        Write(buffer, pair.first);
+        Write(buffer, entry.ContentKey);
+        Write(buffer, (std::uint32_t)entry.Dependencies.size());
+        for (const Dependency& dependency : entry.Dependencies)
+        {
+            Write(buffer, dependency.Hash);
+            Write(buffer, (std::uint32_t)dependency.Path.size());
+            buffer.insert(buffer.end(), dependency.Path.begin(), dependency.Path.end());
+        }
+    }
+
+    for (auto it = mBlobs.begin(); it != mBlobs.end(); )
+    {
+        if (liveBlobs.count(it->first) == 0)
+        {
+            it = mBlobs.erase(it);
+            continue;
+        }
+
+        Write(buffer, it->first);
+        Write(buffer, (std::uint32_t)it->second.Size);
+        buffer.insert(buffer.end(), it->second.Data, it->second.Data + it->second.Size);
+        ++it;
+    }
+
+    // 매핑을 닫아야 파일을 바꿀 수 있으므로 매핑된 바이트코드는 메모리로 옮긴다.
+    for (auto& pair : mBlobs)
+    {
+        Blob& blob = pair.second;
+        if (blob.Owned.empty())
+        {
+            blob.Owned.assign(blob.Data, blob.Data + blob.Size);
+            blob.Data = blob.Owned.data();
+        }
+    }
+    mFile.Close();
+
+    // 임시 파일에 다 쓴 다음 바꿔치기 (중간에 죽어도 캐시 파일이 반쯤 쓰인 채로 남지 않는다)
+    const std::string tempPath = mCachePath + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const bool isWritten = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    std::fclose(file);
+    if (!isWritten)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::remove(mCachePath.c_str());
+    if (std::rename(tempPath.c_str(), mCachePath.c_str()) != 0)
+        return false;
+
+    mIsDirty = false;
+    return true;
+}
+
+std::uint64_t ShaderCache::GetRequestKey(const ShaderCompileDesc& desc)const
+{
+    Hasher hasher(mCompilerHash);
+    hasher.AddString(desc.SourcePath);
+    hasher.AddString(desc.EntryPoint);
+    hasher.AddString(desc.Target);
+    hasher.Add((std::uint64_t)desc.Flags);
+
+    hasher.Add((std::uint64_t)desc.Defines.size());
+    for (const auto& define : desc.Defines)
+    {
+        hasher.AddString(define.first);
+        hasher.AddString(define.second);
+    }
+    return hasher.Get();
+}
+
+std::uint64_t ShaderCache::GetContentKey(const ShaderCompileDesc& desc, const std::vector<Dependency>& dependencies)const
+{
+    // 경로가 아니라 내용으로 정하므로, 같은 파일을 다른 경로로 불러도 같은 바이트코드를 공유한다.
+    Hasher hasher(mCompilerHash);
+    hasher.AddString(desc.EntryPoint);
+    hasher.AddString(desc.Target);
+    hasher.Add((std::uint64_t)desc.Flags);
+
+    hasher.Add((std::uint64_t)desc.Defines.size());
+    for (const auto& define : desc.Defines)
+    {
+        hasher.AddString(define.first);
+        hasher.AddString(define.second);
+    }
+
+    hasher.Add((std::uint64_t)dependencies.size());
+    for (const Dependency& dependency : dependencies)
+        hasher.Add(dependency.Hash);
+    return hasher.Get();
+}
+
+bool ShaderCache::HashFile(const std::string& path, std::uint64_t& hash)
+{
+    auto it = mFileHashes.find(path);
+    if (it != mFileHashes.end())
+    {
+        hash = it->second;
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        hash = 0;
+        return false;
+    }
+
+    hash = Hasher(Hasher::HashBytes(file.GetData(), file.GetSize())).Add((std::uint64_t)file.GetSize()).Get();
+    mFileHashes[path] = hash;
+    return true;
+}
+
+bool ShaderCache::Load()
+{
+    if (!mFile.Open(mCachePath))
+        return true;    // 캐시 파일 없음
+
+    Reader reader(mFile.GetData(), mFile.GetSize());
+
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint64_t compilerHash = 0;
+    std::uint32_t entryCount = 0;
+    std::uint32_t blobCount = 0;
+    if (!reader.Read(magic) || magic != CacheMagic ||
+        !reader.Read(version) || version != CacheVersion ||
+        !reader.Read(compilerHash) || compilerHash != mCompilerHash ||
+        !reader.Read(entryCount) || !reader.Read(blobCount))
+        return false;
+
+    for (std::uint32_t i = 0; i < entryCount; ++i)
+    {
+        std::uint64_t requestKey = 0;
+        std::uint32_t dependencyCount = 0;
+        Entry entry;
+        if (!reader.Read(requestKey) || !reader.Read(entry.ContentKey) || !reader.Read(dependencyCount))
+            return false;
+
+        // 개수를 그대로 믿으면 손상된 파일에서 큰 할당을 한다. (의존 파일 하나 = 해시 + 길이 이상)
+        if (dependencyCount > reader.GetRemaining() / (sizeof(std::uint64_t) + sizeof(std::uint32_t)))
+            return false;
+
+        entry.Dependencies.resize(dependencyCount);
+        for (Dependency& dependency : entry.Dependencies)
+        {
+            std::uint32_t length = 0;
+            const std::uint8_t* path = nullptr;
+            if (!reader.Read(dependency.Hash) || !reader.Read(length) || !reader.ReadBytes(length, path))
+                return false;
+            dependency.Path.assign(reinterpret_cast<const char*>(path), length);
+        }
+
+        mEntries[requestKey] = std::move(entry);
+    }
+
+    // 바이트코드는 복사하지 않고 매핑된 메모리를 그대로 가리킨다.
+    for (std::uint32_t i = 0; i < blobCount; ++i)
+    {
+        std::uint64_t contentKey = 0;
+        std::uint32_t size = 0;
+        Blob blob;
+        if (!reader.Read(contentKey) || !reader.Read(size) || !reader.ReadBytes(size, blob.Data))
+            return false;
+        blob.Size = size;
+
+        mBlobs[contentKey] = std::move(blob);
+    }
+
+    mIsDirty = false;
+    return true;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 셰이더 컴파일 요청
+struct ShaderCompileDesc
+{
+    std::string SourcePath;
+    std::vector<std::pair<std::string, std::string>> Defines;   // 이름, 값
+    std::string EntryPoint;
+    std::string Target;                                         // vs_5_1, ps_6_0 ...
+    std::uint32_t Flags = 0;                                    // 컴파일러 플래그 (D3DCOMPILE_* 등)
+};
+
+// 컴파일 결과
+struct ShaderCompileOutput
+{
+    std::vector<std::uint8_t> Bytecode;     // DXBC/DXIL
+    std::vector<std::string> Dependencies;  // 컴파일 중에 연 include 파일 (원본 제외, 중복 없음)
+    std::string Errors;                     // 경고/에러 메시지
+};
+
+// 실제 컴파일러 (D3DCompile, DXC, 테스트용 가짜 컴파일러 등)
+class IShaderCompiler
+{
+public:
+    virtual ~IShaderCompiler() = default;
+
+    // 컴파일러 종류/버전. 바뀌면 이전 캐시는 모두 무효가 된다.
+    virtual std::string GetIdentity()const = 0;
+
+    virtual bool Compile(const ShaderCompileDesc& desc, ShaderCompileOutput& output) = 0;
+};
+
+// 캐시에서 꺼낸 바이트코드 (다음 Save/Close 전까지만 유효)
+struct ShaderBytecode
+{
+    const std::uint8_t* Data = nullptr;
+    std::size_t Size = 0;
+};
+
+// 디스크 셰이더 바이트코드 캐시
+// 요청(경로, define, 진입점, 타겟, 플래그)마다 마지막으로 컴파일할 때 쓴 파일들의 해시를 기억해 두고,
+// 원본과 include가 하나도 바뀌지 않았으면 컴파일하지 않고 캐시 파일의 바이트코드를 그대로 돌려준다.
+// 바이트코드는 내용 키(컴파일러 + 옵션 + 모든 의존 파일 내용의 해시)로 저장되므로 같은 결과는 한 번만 저장된다.
+// 캐시 파일은 메모리 맵으로 읽고, Save에서 통째로 다시 쓴다.
+// GetOrCompile은 여러 스레드에서 동시에 불러도 된다. (Open/Close/Save는 컴파일 중에 부르면 안 된다)
+class ShaderCache
+{
+public:
+    struct Stats
+    {
+        std::uint32_t Hits = 0;
+        std::uint32_t Misses = 0;           // 처음 보는 요청
+        std::uint32_t Invalidated = 0;      // 의존 파일이 바뀌어서 다시 컴파일한 요청
+        std::uint32_t Failures = 0;         // 컴파일 실패
+    };
+
+public:
+    ShaderCache() = default;
+    ShaderCache(const ShaderCache& rhs) = delete;
+    ShaderCache& operator=(const ShaderCache& rhs) = delete;
+
+    // 캐시 파일을 연다. 파일이 없거나 손상되었으면 빈 캐시로 시작한다.
+    void Open(const std::string& cachePath, IShaderCompiler* compiler);
+    void Close();
+
+    // 캐시에 있으면 그대로, 없거나 의존 파일이 바뀌었으면 컴파일해서 돌려준다.
+    // 컴파일에 실패하면 false (errors에 메시지)
+    bool GetOrCompile(const ShaderCompileDesc& desc, ShaderBytecode& bytecode, std::string* errors = nullptr);
+
+    // 새로 컴파일한 항목이 있으면 캐시 파일을 다시 쓴다.
+    bool Save();
+
+    // 파일 해시는 한 번 실행하는 동안 캐시해 두므로, 파일이 바뀐 걸 알면 호출한다.
+    void InvalidateFileHashes() { std::lock_guard<std::mutex> lock(mMutex); mFileHashes.clear(); }
+
+    const Stats& GetStats()const { return mStats; }
+    std::size_t GetEntryCount()const { return mEntries.size(); }
+    std::size_t GetBlobCount()const { return mBlobs.size(); }
+
+private:
+    struct Dependency
+    {
+        std::string Path;
+        std::uint64_t Hash = 0;
+    };
+
+    struct Entry
+    {
+        std::uint64_t ContentKey = 0;
+        std::vector<Dependency> Dependencies;   // 0번은 원본 파일
+    };
+
+    struct Blob
+    {
+        const std::uint8_t* Data = nullptr;     // 매핑된 캐시 파일 또는 Owned
+        std::size_t Size = 0;
+        std::vector<std::uint8_t> Owned;        // 이번 실행에서 컴파일한 바이트코드
+    };
+
+    std::uint64_t GetRequestKey(const ShaderCompileDesc& desc)const;
+    std::uint64_t GetContentKey(const ShaderCompileDesc& desc, const std::vector<Dependency>& dependencies)const;
+
+    // 파일 내용 해시. 파일이 없으면 false
+    bool HashFile(const std::string& path, std::uint64_t& hash);
+
+    bool Load();
+
+private:
+    std::string mCachePath;
+    IShaderCompiler* mCompiler = nullptr;
+    std::uint64_t mCompilerHash = 0;
+
+    MappedFile mFile;
+    std::unordered_map<std::uint64_t, Entry> mEntries;     // 요청 키 -> 의존 파일, 내용 키
+    std::unordered_map<std::uint64_t, Blob> mBlobs;        // 내용 키 -> 바이트코드
+    std::unordered_map<std::string, std::uint64_t> mFileHashes;
+    bool mIsDirty = false;
+
+    Stats mStats;
+    mutable std::mutex mMutex;     // GetOrCompile에서 위 컨테이너/통계를 보호
+};
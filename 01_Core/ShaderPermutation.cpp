@@ -0,0 +1,246 @@
+#include "ShaderPermutation.h"
+#include "JobSystem.h"
+#include "ShaderCache.h"
+
+#include <cassert>
+#include <chrono>
+
+namespace
+{
+    // 한 프로그램의 변형 수 상한 (이보다 많으면 키워드 설계를 다시 봐야 한다)
+    const std::uint64_t MaxVariantCount = 1u << 16;
+}
+
+void ShaderPermutationSet::AddProgram(const ShaderProgramDesc& desc)
+{
+    Program program;
+    program.Desc = desc;
+
+    std::uint64_t count = 1;
+    for (std::uint32_t group = 0; group < (std::uint32_t)desc.KeywordGroups.size(); ++group)
+    {
+        const ShaderKeywordGroup& keywords = desc.KeywordGroups[group];
+        assert(!keywords.empty() && "keyword group must have at least one keyword");
+
+        program.Strides.push_back((std::uint32_t)count);
+        for (std::uint32_t index = 0; index < (std::uint32_t)keywords.size(); ++index)
+        {
+            if (keywords[index].empty())
+                continue;
+
+            assert(program.Keywords.count(keywords[index]) == 0 && "keyword declared twice");
+            program.Keywords[keywords[index]] = std::make_pair(group, index);
+        }
+
+        count *= keywords.empty() ? 1 : keywords.size();
+        assert(count <= MaxVariantCount && "too many shader variants");
+    }
+    program.VariantCount = (std::uint32_t)count;
+
+    mPrograms[desc.Name] = std::move(program);
+}
+
+ShaderVariantKey ShaderPermutationSet::GetVariantKey(const std::string& program, const std::vector<std::string>& keywords)const
+{
+    const Program& target = GetProgram(program);
+
+    // 그룹마다 고른 번호 (같은 그룹의 키워드를 여러 개 주면 마지막 것)
+    std::vector<std::uint32_t> selected(target.Strides.size(), 0);
+    for (const std::string& keyword : keywords)
+    {
+        auto it = target.Keywords.find(keyword);
+        assert(it != target.Keywords.end() && "keyword is not declared by the program");
+        if (it != target.Keywords.end())
+            selected[it->second.first] = it->second.second;
+    }
+
+    ShaderVariantKey key = 0;
+    for (std::size_t group = 0; group < selected.size(); ++group)
+        key += selected[group] * target.Strides[group];
+    return key;
+}
+
+std::uint32_t ShaderPermutationSet::GetVariantCount(const std::string& program)const
+{
+    return GetProgram(program).VariantCount;
+}
+
+std::vector<std::pair<std::string, std::string>> ShaderPermutationSet::GetDefines(const std::string& program, ShaderVariantKey key)const
+{
+    return GetDefines(GetProgram(program), key);
+}
+
+ShaderVariantKey ShaderPermutationSet::Request(const std::string& program, const std::vector<std::string>& keywords)
+{
+    const ShaderVariantKey key = GetVariantKey(program, keywords);
+    RequestVariant(program, key);
+    return key;
+}
+
+void ShaderPermutationSet::RequestVariant(const std::string& program, ShaderVariantKey key)
+{
+    Program& target = GetProgram(program);
+    assert(key < target.VariantCount);
+
+    if (target.Variants.count(key) == 0)
+    {
+        target.Variants[key].Bytecode.resize(target.Desc.Stages.size());
+        ++mStats.Requested;
+    }
+}
+
+void ShaderPermutationSet::RequestAll()
+{
+    for (auto& pair : mPrograms)
+    {
+        for (ShaderVariantKey key = 0; key < pair.second.VariantCount; ++key)
+            RequestVariant(pair.first, key);
+    }
+}
+
+void ShaderPermutationSet::InvalidateAll()
+{
+    for (auto& programPair : mPrograms)
+    {
+        for (auto& variantPair : programPair.second.Variants)
+            variantPair.second.IsCompiled = false;
+    }
+}
+
+bool ShaderPermutationSet::CompileRequested(ShaderCache& cache, JobSystem& jobs, std::uint32_t flags, std::string* errors)
+{
+    // (변형, 스테이지) 하나가 작업 하나
+    struct Task
+    {
+        const Program* Owner = nullptr;
+        ShaderVariantKey Key = 0;
+        Variant* Target = nullptr;
+        std::uint32_t Stage = 0;
+    };
+
+    std::vector<Task> tasks;
+    for (auto& programPair : mPrograms)
+    {
+        Program& program = programPair.second;
+        for (auto& variantPair : program.Variants)
+        {
+            if (variantPair.second.IsCompiled)
+                continue;
+
+            for (std::uint32_t stage = 0; stage < (std::uint32_t)program.Desc.Stages.size(); ++stage)
+            {
+                Task task;
+                task.Owner = &program;
+                task.Key = variantPair.first;
+                task.Target = &variantPair.second;
+                task.Stage = stage;
+                tasks.push_back(task);
+            }
+        }
+    }
+
+    if (tasks.empty())
+        return true;
+
+    // 작업마다 결과 칸을 따로 두므로 작업끼리는 잠글 필요가 없다. (캐시는 내부에서 잠근다)
+    std::vector<std::string> taskErrors(tasks.size());
+    std::vector<std::uint8_t> taskResults(tasks.size(), 0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    JobCounter counter = jobs.ParallelFor((std::uint32_t)tasks.size(), 1, [&](std::uint32_t index)
+    {
+        const Task& task = tasks[index];
+        const ShaderStageDesc& stage = task.Owner->Desc.Stages[task.Stage];
+
+        ShaderCompileDesc desc;
+        desc.SourcePath = task.Owner->Desc.SourcePath;
+        desc.Defines = GetDefines(*task.Owner, task.Key);
+        desc.EntryPoint = stage.EntryPoint;
+        desc.Target = stage.Target;
+        desc.Flags = flags;
+
+        ShaderBytecode bytecode;
+        if (cache.GetOrCompile(desc, bytecode, &taskErrors[index]))
+        {
+            task.Target->Bytecode[task.Stage].assign(bytecode.Data, bytecode.Data + bytecode.Size);
+            taskResults[index] = 1;
+        }
+    });
+    jobs.Wait(counter);
+
+    mStats.CompileMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    // 모든 스테이지가 성공한 변형만 완료 (실패한 변형은 다음 호출에서 다시 컴파일)
+    for (const Task& task : tasks)
+        task.Target->IsCompiled = true;
+
+    bool isSucceeded = true;
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+    {
+        const Task& task = tasks[i];
+        if (taskResults[i])
+        {
+            ++mStats.Compiled;
+        }
+        else
+        {
+            ++mStats.Failures;
+            task.Target->IsCompiled = false;
+            isSucceeded = false;
+        }
+
+        if (errors != nullptr && !taskErrors[i].empty())
+        {
+            *errors += task.Owner->Desc.Name + " [";
+            for (const auto& define : GetDefines(*task.Owner, task.Key))
+                *errors += " " + define.first;
+            *errors += " ] " + task.Owner->Desc.Stages[task.Stage].EntryPoint + "\n" + taskErrors[i];
+        }
+    }
+
+    return isSucceeded;
+}
+
+const std::vector<std::uint8_t>* ShaderPermutationSet::GetBytecode(const std::string& program, ShaderVariantKey key, const std::string& entryPoint)const
+{
+    const Program& target = GetProgram(program);
+
+    auto it = target.Variants.find(key);
+    if (it == target.Variants.end() || !it->second.IsCompiled)
+        return nullptr;
+
+    for (std::size_t stage = 0; stage < target.Desc.Stages.size(); ++stage)
+    {
+        if (target.Desc.Stages[stage].EntryPoint == entryPoint)
+            return &it->second.Bytecode[stage];
+    }
+    return nullptr;
+}
+
+ShaderPermutationSet::Program& ShaderPermutationSet::GetProgram(const std::string& name)
+{
+    assert(mPrograms.count(name) != 0 && "shader program is not registered");
+    return mPrograms.at(name);
+}
+
+const ShaderPermutationSet::Program& ShaderPermutationSet::GetProgram(const std::string& name)const
+{
+    assert(mPrograms.count(name) != 0 && "shader program is not registered");
+    return mPrograms.at(name);
+}
+
+std::vector<std::pair<std::string, std::string>> ShaderPermutationSet::GetDefines(const Program& program, ShaderVariantKey key)
+{
+    // 그룹 순서대로 나오므로 같은 변형이면 항상 같은 define 목록 (캐시 키가 흔들리지 않는다)
+    std::vector<std::pair<std::string, std::string>> defines;
+    for (std::size_t group = 0; group < program.Strides.size(); ++group)
+    {
+        const ShaderKeywordGroup& keywords = program.Desc.KeywordGroups[group];
+        const std::uint32_t index = (key / program.Strides[group]) % (std::uint32_t)keywords.size();
+
+        if (!keywords[index].empty())
+            defines.emplace_back(keywords[index], "1");
+    }
+    return defines;
+}
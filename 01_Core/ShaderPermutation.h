@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ShaderCache;
+class JobSystem;
+
+// 셰이더 스테이지 (한 원본 파일의 진입점 하나)
+struct ShaderStageDesc
+{
+    std::string EntryPoint;
+    std::string Target;
+};
+
+// 키워드 그룹 : 그룹마다 하나만 켜진다. 빈 문자열은 "아무것도 켜지 않음"
+// ex) { "", "INSTANCING" }, { "VERTEX_COLOR", "VERTEX_PACKED" }
+using ShaderKeywordGroup = std::vector<std::string>;
+
+// 셰이더 프로그램 : 원본 파일 + 스테이지들 + 키워드 그룹들
+struct ShaderProgramDesc
+{
+    std::string Name;
+    std::string SourcePath;
+    std::vector<ShaderStageDesc> Stages;
+    std::vector<ShaderKeywordGroup> KeywordGroups;
+};
+
+// 변형 키 : 그룹마다 고른 키워드 번호를 섞은 값 (그룹 크기를 자릿수로 쓰는 혼합 기수)
+// 0은 모든 그룹의 첫 번째 키워드
+using ShaderVariantKey = std::uint32_t;
+
+// 셰이더 변형(permutation) 모음
+// 프로그램마다 키워드 그룹을 선언해 두고, 실제로 쓰는 조합만 요청해서 작업 스레드에서 한꺼번에 컴파일한다.
+// 켜진 키워드는 "KEYWORD=1" define으로 넘어가고, 컴파일 결과는 ShaderCache를 거치므로 바뀌지 않은 변형은 다시 컴파일하지 않는다.
+// 오프라인 굽기(bake)는 RequestAll로 모든 조합을 요청하면 된다.
+class ShaderPermutationSet
+{
+public:
+    struct Stats
+    {
+        std::uint32_t Requested = 0;    // 요청된 변형 수
+        std::uint32_t Compiled = 0;     // 바이트코드를 얻은 (변형, 스테이지) 수 (캐시 히트 포함)
+        std::uint32_t Failures = 0;
+        double CompileMs = 0.0;         // 마지막 CompileRequested에 걸린 시간
+    };
+
+public:
+    ShaderPermutationSet() = default;
+    ShaderPermutationSet(const ShaderPermutationSet& rhs) = delete;
+    ShaderPermutationSet& operator=(const ShaderPermutationSet& rhs) = delete;
+
+    void AddProgram(const ShaderProgramDesc& desc);
+
+    // 켤 키워드 목록 -> 변형 키. 목록에 없는 그룹은 첫 번째 키워드
+    ShaderVariantKey GetVariantKey(const std::string& program, const std::vector<std::string>& keywords)const;
+    std::uint32_t GetVariantCount(const std::string& program)const;
+    std::vector<std::pair<std::string, std::string>> GetDefines(const std::string& program, ShaderVariantKey key)const;
+
+    // 컴파일할 변형 등록
+    ShaderVariantKey Request(const std::string& program, const std::vector<std::string>& keywords);
+    void RequestVariant(const std::string& program, ShaderVariantKey key);
+    void RequestAll();
+
+    // 요청한 변형을 모두 다시 컴파일 대상으로 돌린다. (핫 리로드 - 바뀌지 않은 변형은 캐시에서 바로 나온다)
+    // 다음 CompileRequested가 끝날 때까지 GetBytecode는 nullptr
+    void InvalidateAll();
+
+    // 요청되었지만 아직 바이트코드가 없는 변형을 병렬로 컴파일한다. 하나라도 실패하면 false (errors에 메시지)
+    bool CompileRequested(ShaderCache& cache, JobSystem& jobs, std::uint32_t flags, std::string* errors = nullptr);
+
+    // 컴파일된 바이트코드. 요청하지 않았거나 실패했으면 nullptr
+    const std::vector<std::uint8_t>* GetBytecode(const std::string& program, ShaderVariantKey key, const std::string& entryPoint)const;
+
+    std::size_t GetProgramCount()const { return mPrograms.size(); }
+    const Stats& GetStats()const { return mStats; }
+
+private:
+    struct Variant
+    {
+        std::vector<std::vector<std::uint8_t>> Bytecode;    // 스테이지 순서
+        bool IsCompiled = false;
+    };
+
+    struct Program
+    {
+        ShaderProgramDesc Desc;
+        std::vector<std::uint32_t> Strides;                 // 그룹별 자릿값
+        std::uint32_t VariantCount = 1;
+        std::unordered_map<std::string, std::pair<std::uint32_t, std::uint32_t>> Keywords;    // 키워드 -> (그룹, 번호)
+        std::unordered_map<ShaderVariantKey, Variant> Variants;
+    };
+
+    Program& GetProgram(const std::string& name);
+    const Program& GetProgram(const std::string& name)const;
+    static std::vector<std::pair<std::string, std::string>> GetDefines(const Program& program, ShaderVariantKey key);
+
+private:
+    std::unordered_map<std::string, Program> mPrograms;
+    Stats mStats;
+};
@@ -0,0 +1,389 @@
+#include "TlsfAllocator.h"
+
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+void TlsfAllocator::Initialize(std::uint64_t size)
+{
+    mSize = size;
+
+    mBlocks.clear();
+    mUnusedBlocks.clear();
+
+    mFLBitmap = 0;
+    for (int fl = 0; fl < FLCount; ++fl)
+    {
+        mSLBitmap[fl] = 0;
+        for (int sl = 0; sl < SLCount; ++sl)
+            mFreeHeads[fl][sl] = InvalidBlock;
+    }
+
+    mAllocationCount = 0;
+
+    // 전체 범위를 하나의 빈 블록으로 시작 (0번 블록은 항상 물리적으로 첫 블록)
+    std::uint32_t block = NewBlock();
+    mBlocks[block].Offset = 0;
+    mBlocks[block].Size = size;
+    mBlocks[block].IsFree = true;
+    if (size > 0)
+        InsertFree(block);
+}
+
+TlsfAllocator::Allocation TlsfAllocator::Allocate(std::uint64_t size, std::uint64_t alignment)
+{
+    Allocation allocation;
+
+    if (size == 0)
+        size = 1;
+    if (alignment == 0)
+        alignment = 1;
+    assert((alignment & (alignment - 1)) == 0);
+
+    if (size > mSize)
+        return allocation;
+
+    // 정렬이 필요하면 먼저 딱 맞는 크기로 찾아보고, 정렬이 안 맞으면 여백을 포함한 크기로 다시 찾는다.
+    std::uint32_t block = FindFree(size);
+    if (block != InvalidBlock && alignment > 1)
+    {
+        const Block& b = mBlocks[block];
+        std::uint64_t aligned = (b.Offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + size > b.Offset + b.Size)
+            block = InvalidBlock;
+    }
+    if (block == InvalidBlock && alignment > 1 && size <= mSize - (alignment - 1))
+        block = FindFree(size + alignment - 1);
+    if (block == InvalidBlock)
+        return allocation;
+
+    RemoveFree(block);
+
+    // 앞쪽 정렬 여백은 빈 블록으로 돌려준다.
+    std::uint64_t offset = mBlocks[block].Offset;
+    std::uint64_t padding = ((offset + alignment - 1) & ~(alignment - 1)) - offset;
+    if (padding > 0)
+    {
+        SplitTail(block, padding);
+        std::uint32_t tail = mBlocks[block].NextPhysical;
+
+        mBlocks[block].IsFree = true;
+        InsertFree(block);
+
+        block = tail;
+    }
+
+    // 남는 뒤쪽도 빈 블록으로 돌려준다.
+    if (mBlocks[block].Size > size)
+    {
+        SplitTail(block, size);
+        std::uint32_t tail = mBlocks[block].NextPhysical;
+        mBlocks[tail].IsFree = true;
+        InsertFree(tail);
+    }
+
+    mBlocks[block].IsFree = false;
+    ++mAllocationCount;
+
+    allocation.Offset = mBlocks[block].Offset;
+    allocation.Size = size;
+    allocation.Block = block;
+    return allocation;
+}
+
+void TlsfAllocator::Free(const Allocation& allocation)
+{
+    if (!allocation.IsValid())
+        return;
+
+    std::uint32_t block = allocation.Block;
+    assert(block < mBlocks.size() && !mBlocks[block].IsFree);
+
+    mBlocks[block].IsFree = true;
+    --mAllocationCount;
+
+    // 뒤쪽 빈 블록과 합치기
+    std::uint32_t next = mBlocks[block].NextPhysical;
+    if (next != InvalidBlock && mBlocks[next].IsFree)
+    {
+        RemoveFree(next);
+        MergeNext(block);
+    }
+
+    // 앞쪽 빈 블록과 합치기
+    std::uint32_t prev = mBlocks[block].PrevPhysical;
+    if (prev != InvalidBlock && mBlocks[prev].IsFree)
+    {
+        RemoveFree(prev);
+        MergeNext(prev);
+        block = prev;
+    }
+
+    InsertFree(block);
+}
+
+TlsfAllocator::Stats TlsfAllocator::GetStats()const
+{
+    Stats stats;
+    stats.TotalSize = mSize;
+    stats.AllocationCount = mAllocationCount;
+
+    if (mBlocks.empty())
+        return stats;
+
+    for (std::uint32_t block = 0; block != InvalidBlock; block = mBlocks[block].NextPhysical)
+    {
+        const Block& b = mBlocks[block];
+        if (b.IsFree)
+        {
+            stats.FreeSize += b.Size;
+            stats.FreeBlockCount += b.Size > 0 ? 1 : 0;
+            if (b.Size > stats.LargestFreeBlock)
+                stats.LargestFreeBlock = b.Size;
+        }
+        else
+        {
+            stats.UsedSize += b.Size;
+        }
+    }
+
+    return stats;
+}
+
+bool TlsfAllocator::Validate()const
+{
+    if (mBlocks.empty())
+        return mSize == 0;
+
+    // 물리적 순서 검사
+    std::uint64_t offset = 0;
+    std::uint32_t usedCount = 0;
+    std::uint32_t freeCount = 0;
+    std::uint32_t prev = InvalidBlock;
+    for (std::uint32_t block = 0; block != InvalidBlock; block = mBlocks[block].NextPhysical)
+    {
+        const Block& b = mBlocks[block];
+        if (b.Offset != offset || b.PrevPhysical != prev)
+            return false;
+        if (b.IsFree && prev != InvalidBlock && mBlocks[prev].IsFree)
+            return false;   // 빈 블록이 연속이면 합쳐졌어야 한다.
+
+        if (b.IsFree && b.Size > 0)
+            ++freeCount;
+        else if (!b.IsFree)
+            ++usedCount;
+
+        offset += b.Size;
+        prev = block;
+    }
+    if (offset != mSize || usedCount != mAllocationCount)
+        return false;
+
+    // 빈 블록 리스트 검사
+    std::uint32_t listedCount = 0;
+    for (int fl = 0; fl < FLCount; ++fl)
+    {
+        bool hasFL = (mFLBitmap & (1ull << fl)) != 0;
+        if (hasFL != (mSLBitmap[fl] != 0))
+            return false;
+
+        for (int sl = 0; sl < SLCount; ++sl)
+        {
+            std::uint32_t head = mFreeHeads[fl][sl];
+            bool hasSL = (mSLBitmap[fl] & (1u << sl)) != 0;
+            if (hasSL != (head != InvalidBlock))
+                return false;
+
+            std::uint32_t prevFree = InvalidBlock;
+            for (std::uint32_t block = head; block != InvalidBlock; block = mBlocks[block].NextFree)
+            {
+                const Block& b = mBlocks[block];
+                int blockFL = 0;
+                int blockSL = 0;
+                MappingInsert(b.Size, blockFL, blockSL);
+                if (!b.IsFree || b.PrevFree != prevFree || blockFL != fl || blockSL != sl)
+                    return false;
+
+                ++listedCount;
+                prevFree = block;
+            }
+        }
+    }
+
+    return listedCount == freeCount;
+}
+
+int TlsfAllocator::FindLastSet(std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+int TlsfAllocator::FindFirstSet(std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// 크기 -> (1단계, 2단계) 인덱스
+void TlsfAllocator::MappingInsert(std::uint64_t size, int& fl, int& sl)
+{
+    if (size < (std::uint64_t)SLCount)
+    {
+        fl = 0;
+        sl = (int)size;
+        return;
+    }
+
+    int msb = FindLastSet(size);
+    sl = (int)(size >> (msb - SLBits)) ^ SLCount;
+    fl = msb - SLBits + 1;
+}
+
+// 찾는 크기 이상을 보장하는 리스트 (다음 구간으로 올림)
+void TlsfAllocator::MappingSearch(std::uint64_t size, int& fl, int& sl)
+{
+    if (size >= (std::uint64_t)SLCount)
+    {
+        std::uint64_t round = (1ull << (FindLastSet(size) - SLBits)) - 1;
+        if (size <= ~0ull - round)
+            size += round;
+    }
+
+    MappingInsert(size, fl, sl);
+}
+
+std::uint32_t TlsfAllocator::NewBlock()
+{
+    if (!mUnusedBlocks.empty())
+    {
+        std::uint32_t block = mUnusedBlocks.back();
+        mUnusedBlocks.pop_back();
+        mBlocks[block] = Block();
+        return block;
+    }
+
+    mBlocks.push_back(Block());
+    return (std::uint32_t)mBlocks.size() - 1;
+}
+
+void TlsfAllocator::ReleaseBlock(std::uint32_t block)
+{
+    mBlocks[block] = Block();
+    mUnusedBlocks.push_back(block);
+}
+
+void TlsfAllocator::InsertFree(std::uint32_t block)
+{
+    int fl = 0;
+    int sl = 0;
+    MappingInsert(mBlocks[block].Size, fl, sl);
+
+    std::uint32_t head = mFreeHeads[fl][sl];
+    mBlocks[block].PrevFree = InvalidBlock;
+    mBlocks[block].NextFree = head;
+    if (head != InvalidBlock)
+        mBlocks[head].PrevFree = block;
+
+    mFreeHeads[fl][sl] = block;
+    mFLBitmap |= 1ull << fl;
+    mSLBitmap[fl] |= 1u << sl;
+}
+
+void TlsfAllocator::RemoveFree(std::uint32_t block)
+{
+    int fl = 0;
+    int sl = 0;
+    MappingInsert(mBlocks[block].Size, fl, sl);
+
+    std::uint32_t prev = mBlocks[block].PrevFree;
+    std::uint32_t next = mBlocks[block].NextFree;
+    if (prev != InvalidBlock)
+        mBlocks[prev].NextFree = next;
+    if (next != InvalidBlock)
+        mBlocks[next].PrevFree = prev;
+
+    if (mFreeHeads[fl][sl] == block)
+    {
+        mFreeHeads[fl][sl] = next;
+        if (next == InvalidBlock)
+        {
+            mSLBitmap[fl] &= ~(1u << sl);
+            if (mSLBitmap[fl] == 0)
+                mFLBitmap &= ~(1ull << fl);
+        }
+    }
+
+    mBlocks[block].PrevFree = InvalidBlock;
+    mBlocks[block].NextFree = InvalidBlock;
+}
+
+std::uint32_t TlsfAllocator::FindFree(std::uint64_t size)
+{
+    int fl = 0;
+    int sl = 0;
+    MappingSearch(size, fl, sl);
+    if (fl >= FLCount)
+        return InvalidBlock;
+
+    // 같은 1단계 안에서 sl 이상인 리스트
+    std::uint32_t slMap = mSLBitmap[fl] & (~0u << sl);
+    if (slMap == 0)
+    {
+        // 더 큰 1단계
+        if (fl + 1 >= FLCount)
+            return InvalidBlock;
+
+        std::uint64_t flMap = mFLBitmap & (~0ull << (fl + 1));
+        if (flMap == 0)
+            return InvalidBlock;
+
+        fl = FindFirstSet(flMap);
+        slMap = mSLBitmap[fl];
+    }
+
+    sl = FindFirstSet(slMap);
+    return mFreeHeads[fl][sl];
+}
+
+void TlsfAllocator::SplitTail(std::uint32_t block, std::uint64_t size)
+{
+    std::uint32_t tail = NewBlock();
+
+    Block& b = mBlocks[block];
+    Block& t = mBlocks[tail];
+
+    t.Offset = b.Offset + size;
+    t.Size = b.Size - size;
+    t.PrevPhysical = block;
+    t.NextPhysical = b.NextPhysical;
+    if (t.NextPhysical != InvalidBlock)
+        mBlocks[t.NextPhysical].PrevPhysical = tail;
+
+    b.Size = size;
+    b.NextPhysical = tail;
+}
+
+void TlsfAllocator::MergeNext(std::uint32_t block)
+{
+    std::uint32_t next = mBlocks[block].NextPhysical;
+
+    mBlocks[block].Size += mBlocks[next].Size;
+    mBlocks[block].NextPhysical = mBlocks[next].NextPhysical;
+    if (mBlocks[block].NextPhysical != InvalidBlock)
+        mBlocks[mBlocks[block].NextPhysical].PrevPhysical = block;
+
+    ReleaseBlock(next);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// TLSF (Two-Level Segregated Fit) 오프셋 할당기
+// 실제 메모리를 다루지 않고 [0, size) 범위의 오프셋만 관리한다.
+// 할당/해제 모두 O(1)이고, 해제 시 인접한 빈 블록과 바로 합쳐진다.
+// GPU 힙처럼 CPU에서 직접 접근할 수 없는 메모리의 서브 할당에 사용한다.
+class TlsfAllocator
+{
+public:
+    struct Allocation
+    {
+        std::uint64_t Offset = 0;
+        std::uint64_t Size = 0;         // 요청한 크기
+        std::uint32_t Block = InvalidBlock;
+
+        bool IsValid()const { return Block != InvalidBlock; }
+    };
+
+    struct Stats
+    {
+        std::uint64_t TotalSize = 0;
+        std::uint64_t UsedSize = 0;         // 할당된 블록 크기 합 (정렬 여백 포함)
+        std::uint64_t FreeSize = 0;
+        std::uint64_t LargestFreeBlock = 0;
+        std::uint32_t AllocationCount = 0;
+        std::uint32_t FreeBlockCount = 0;
+
+        // 0 : 빈 공간이 한 덩어리, 1에 가까울수록 잘게 쪼개져 있음
+        double Fragmentation()const { return FreeSize > 0 ? 1.0 - (double)LargestFreeBlock / (double)FreeSize : 0.0; }
+        double Utilization()const { return TotalSize > 0 ? (double)UsedSize / (double)TotalSize : 0.0; }
+    };
+
+    static const std::uint32_t InvalidBlock = 0xffffffff;
+
+public:
+    TlsfAllocator() = default;
+    explicit TlsfAllocator(std::uint64_t size) { Initialize(size); }
+
+    void Initialize(std::uint64_t size);
+
+    // alignment는 2의 거듭제곱. 공간이 없으면 IsValid()가 false
+    Allocation Allocate(std::uint64_t size, std::uint64_t alignment = 1);
+    void Free(const Allocation& allocation);
+
+    std::uint64_t GetSize()const { return mSize; }
+    bool IsEmpty()const { return mAllocationCount == 0; }
+
+    Stats GetStats()const;
+
+    // 내부 자료구조 검사 (디버그/테스트용). 문제가 없으면 true
+    bool Validate()const;
+
+private:
+    static const int SLBits = 4;
+    static const int SLCount = 1 << SLBits;
+    static const int FLCount = 64 - SLBits + 1;
+
+    struct Block
+    {
+        std::uint64_t Offset = 0;
+        std::uint64_t Size = 0;
+        std::uint32_t PrevPhysical = InvalidBlock;
+        std::uint32_t NextPhysical = InvalidBlock;
+        std::uint32_t PrevFree = InvalidBlock;
+        std::uint32_t NextFree = InvalidBlock;
+        bool IsFree = false;
+    };
+
+    static int FindLastSet(std::uint64_t value);
+    static int FindFirstSet(std::uint64_t value);
+    static void MappingInsert(std::uint64_t size, int& fl, int& sl);
+    static void MappingSearch(std::uint64_t size, int& fl, int& sl);
+
+    std::uint32_t NewBlock();
+    void ReleaseBlock(std::uint32_t block);
+
+    void InsertFree(std::uint32_t block);
+    void RemoveFree(std::uint32_t block);
+    std::uint32_t FindFree(std::uint64_t size);
+
+    // block 앞쪽 size만 남기고 뒤쪽을 새 빈 블록으로 분리
+    void SplitTail(std::uint32_t block, std::uint64_t size);
+    // next를 block에 합친다.
+    void MergeNext(std::uint32_t block);
+
+private:
+    std::uint64_t mSize = 0;
+
+    std::vector<Block> mBlocks;
+    std::vector<std::uint32_t> mUnusedBlocks;   // 재사용할 Block 슬롯
+
+    std::uint64_t mFLBitmap = 0;
+    std::uint32_t mSLBitmap[FLCount] = {};
+    std::uint32_t mFreeHeads[FLCount][SLCount];
+
+    std::uint32_t mAllocationCount = 0;
+};
@@ -73,6 +73,9 @@ public:
 	// After modifying camera position/orientation, call to rebuild the view matrix.
 	void UpdateViewMatrix();
 
+	// Incremented whenever the view or projection matrix changes.
+	UINT64 GetVersion()const;
+
 private:
 
 	// Camera coordinate system with coordinates relative to world space.
@@ -90,6 +93,7 @@ private:
 	float mFarWindowHeight = 0.0f;
 
 	bool mViewDirty = true;
+	UINT64 mVersion = 0;
 
 	// Cache View/Proj matrices.
 	DirectX::XMFLOAT4X4 mView = MathHelper::Identity4x4();
@@ -0,0 +1,11 @@
+#include "DeferredReleaseQueue.h"
+
+void DeferredReleaseQueue::Enqueue(UINT64 fence, IUnknown* object)
+{
+    if (object == nullptr)
+        return;
+
+    // 항목이 참조 하나를 들고 있다가 펜스가 지나면 놓는다.
+    Microsoft::WRL::ComPtr<IUnknown> reference = object;
+    FenceReleaseQueue::Enqueue(fence, [reference]() mutable { reference.Reset(); });
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/FenceReleaseQueue.h"
+
+// 펜스 값을 키로 해제를 미루는 큐 (D3D12 객체용)
+// 순서/해제 처리는 FenceReleaseQueue가 하고, 여기서는 COM 객체의 참조를 항목으로 바꿔 넣는다.
+class DeferredReleaseQueue : public FenceReleaseQueue
+{
+public:
+    using FenceReleaseQueue::Enqueue;
+
+    // fence가 끝나면 object의 참조를 놓는다.
+    void Enqueue(UINT64 fence, IUnknown* object);
+
+    // 넘긴 ComPtr는 비워진다.
+    template<typename T>
+    void Enqueue(UINT64 fence, Microsoft::WRL::ComPtr<T>& object)
+    {
+        if (object != nullptr)
+            Enqueue(fence, static_cast<IUnknown*>(object.Get()));
+        object.Reset();
+    }
+};
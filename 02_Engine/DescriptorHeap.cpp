@@ -0,0 +1,241 @@
+#include "DescriptorHeap.h"
+
+using Microsoft::WRL::ComPtr;
+
+void DescriptorRangeAllocator::Initialize(UINT start, UINT count)
+{
+    mFreeRanges.clear();
+    mFreeRanges.push_back({ start, count });
+    mFreeCount = count;
+}
+
+UINT DescriptorRangeAllocator::Allocate(UINT count)
+{
+    for (size_t i = 0; i < mFreeRanges.size(); ++i)
+    {
+        Range& range = mFreeRanges[i];
+        if (range.Count < count)
+            continue;
+
+        UINT start = range.Start;
+        range.Start += count;
+        range.Count -= count;
+        if (range.Count == 0)
+            mFreeRanges.erase(mFreeRanges.begin() + i);
+
+        mFreeCount -= count;
+        return start;
+    }
+
+    return UINT_MAX;
+}
+
+void DescriptorRangeAllocator::Free(UINT start, UINT count)
+{
+    auto it = std::lower_bound(mFreeRanges.begin(), mFreeRanges.end(), start,
+        [](const Range& range, UINT value) { return range.Start < value; });
+    it = mFreeRanges.insert(it, { start, count });
+    mFreeCount += count;
+
+    // 뒤쪽 범위와 합치기
+    auto next = it + 1;
+    if (next != mFreeRanges.end() && it->Start + it->Count == next->Start)
+    {
+        it->Count += next->Count;
+        mFreeRanges.erase(next);
+    }
+
+    // 앞쪽 범위와 합치기
+    if (it != mFreeRanges.begin())
+    {
+        auto prev = it - 1;
+        if (prev->Start + prev->Count == it->Start)
+        {
+            prev->Count += it->Count;
+            mFreeRanges.erase(it);
+        }
+    }
+}
+
+void GpuDescriptorHeap::Initialize(ID3D12Device* device, UINT persistentCount, UINT transientCount)
+{
+    md3dDevice = device;
+    mPersistentCount = persistentCount;
+    mRingCount = transientCount;
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = persistentCount + transientCount;
+    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+    heapDesc.NodeMask = 0;
+    ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mHeap)));
+
+    mCpuStart = mHeap->GetCPUDescriptorHandleForHeapStart();
+    mGpuStart = mHeap->GetGPUDescriptorHandleForHeapStart();
+    mDescriptorSize = md3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    mPersistent.Initialize(0, persistentCount);
+
+    mRingHead = 0;
+    mRingUsed = 0;
+    mRingFrameUsed = 0;
+    mRingFrames.clear();
+}
+
+void GpuDescriptorHeap::Bind(ID3D12GraphicsCommandList* cmdList)const
+{
+    ID3D12DescriptorHeap* descriptorHeaps[] = { mHeap.Get() };
+    cmdList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+}
+
+DescriptorHandle GpuDescriptorHeap::AllocatePersistent(UINT count)
+{
+    std::lock_guard<std::mutex> lock(mPersistentMutex);
+
+    UINT index = mPersistent.Allocate(count);
+    if (index == UINT_MAX)
+        ThrowIfFailed(E_OUTOFMEMORY);
+
+    return MakeHandle(index, count);
+}
+
+void GpuDescriptorHeap::FreePersistent(const DescriptorHandle& handle)
+{
+    if (!handle.IsValid())
+        return;
+
+    std::lock_guard<std::mutex> lock(mPersistentMutex);
+
+    RetiredFree retired;
+    retired.Start = handle.Index;
+    retired.Count = handle.Count;
+    mPendingFrees.push_back(retired);
+}
+
+void GpuDescriptorHeap::FreePersistent(D3D12_CPU_DESCRIPTOR_HANDLE cpu, UINT count)
+{
+    UINT index = (UINT)((cpu.ptr - mCpuStart.ptr) / mDescriptorSize);
+    assert(index < mPersistentCount);
+
+    FreePersistent(MakeHandle(index, count));
+}
+
+DescriptorHandle GpuDescriptorHeap::AllocateTransient(UINT count)
+{
+    if (count > mRingCount)
+        ThrowIfFailed(E_OUTOFMEMORY);
+
+    // 끝에 연속으로 들어갈 자리가 없으면 남은 부분을 건너뛰고 처음부터
+    UINT padding = 0;
+    if (mRingHead + count > mRingCount)
+        padding = mRingCount - mRingHead;
+
+    // 링이 가득 참 (GPU가 3프레임 넘게 밀려 있어야 생기는 상황)
+    if (mRingUsed + padding + count > mRingCount)
+        ThrowIfFailed(E_OUTOFMEMORY);
+
+    if (padding > 0)
+        mRingHead = 0;
+
+    UINT index = mPersistentCount + mRingHead;
+
+    mRingHead = (mRingHead + count) % mRingCount;
+    mRingUsed += padding + count;
+    mRingFrameUsed += padding + count;
+
+    return MakeHandle(index, count);
+}
+
+DescriptorHandle GpuDescriptorHeap::CopyToTransient(D3D12_CPU_DESCRIPTOR_HANDLE src, UINT count)
+{
+    DescriptorHandle handle = AllocateTransient(count);
+    md3dDevice->CopyDescriptorsSimple(count, handle.CPU, src, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    return handle;
+}
+
+void GpuDescriptorHeap::FinishFrame(UINT64 fence)
+{
+    RingFrame frame;
+    frame.Fence = fence;
+    frame.Used = mRingFrameUsed;
+    mRingFrames.push_back(frame);
+    mRingFrameUsed = 0;
+
+    std::lock_guard<std::mutex> lock(mPersistentMutex);
+    for (RetiredFree& retired : mPendingFrees)
+    {
+        retired.Fence = fence;
+        mRetiredFrees.push_back(retired);
+    }
+    mPendingFrees.clear();
+}
+
+void GpuDescriptorHeap::ReleaseCompleted(UINT64 completedFence)
+{
+    while (!mRingFrames.empty() && mRingFrames.front().Fence <= completedFence)
+    {
+        mRingUsed -= mRingFrames.front().Used;
+        mRingFrames.pop_front();
+    }
+
+    std::lock_guard<std::mutex> lock(mPersistentMutex);
+    auto it = std::remove_if(mRetiredFrees.begin(), mRetiredFrees.end(), [this, completedFence](const RetiredFree& retired)
+    {
+        if (retired.Fence > completedFence)
+            return false;
+
+        mPersistent.Free(retired.Start, retired.Count);
+        return true;
+    });
+    mRetiredFrees.erase(it, mRetiredFrees.end());
+}
+
+UINT GpuDescriptorHeap::GetPersistentUsed()
+{
+    std::lock_guard<std::mutex> lock(mPersistentMutex);
+    return mPersistentCount - mPersistent.GetFreeCount();
+}
+
+DescriptorHandle GpuDescriptorHeap::MakeHandle(UINT index, UINT count)const
+{
+    DescriptorHandle handle;
+    handle.CPU.ptr = mCpuStart.ptr + (SIZE_T)index * mDescriptorSize;
+    handle.GPU.ptr = mGpuStart.ptr + (UINT64)index * mDescriptorSize;
+    handle.Index = index;
+    handle.Count = count;
+    return handle;
+}
+
+void StagingDescriptorHeap::Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count)
+{
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = count;
+    heapDesc.Type = type;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    heapDesc.NodeMask = 0;
+    ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mHeap)));
+
+    mCpuStart = mHeap->GetCPUDescriptorHandleForHeapStart();
+    mDescriptorSize = device->GetDescriptorHandleIncrementSize(type);
+
+    mAllocator.Initialize(0, count);
+}
+
+DescriptorHandle StagingDescriptorHeap::Allocate(UINT count)
+{
+    UINT index = mAllocator.Allocate(count);
+    if (index == UINT_MAX)
+        ThrowIfFailed(E_OUTOFMEMORY);
+
+    DescriptorHandle handle;
+    handle.CPU.ptr = mCpuStart.ptr + (SIZE_T)index * mDescriptorSize;
+    handle.Index = index;
+    handle.Count = count;
+    return handle;
+}
+
+void StagingDescriptorHeap::Free(const DescriptorHandle& handle)
+{
+    if (handle.IsValid())
+        mAllocator.Free(handle.Index, handle.Count);
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include <mutex>
+#include <deque>
+
+// 디스크립터 위치
+struct DescriptorHandle
+{
+    D3D12_CPU_DESCRIPTOR_HANDLE CPU = {};
+    D3D12_GPU_DESCRIPTOR_HANDLE GPU = {};    // CPU 전용 힙이면 0
+    UINT Index = UINT_MAX;                  // 힙 안에서의 인덱스
+    UINT Count = 0;
+
+    bool IsValid()const { return Index != UINT_MAX; }
+
+    // 연속으로 할당한 범위 안의 i번째 디스크립터
+    DescriptorHandle Offset(UINT i, UINT descriptorSize)const
+    {
+        DescriptorHandle handle = *this;
+        handle.CPU.ptr += (SIZE_T)i * descriptorSize;
+        if (handle.GPU.ptr != 0)
+            handle.GPU.ptr += (UINT64)i * descriptorSize;
+        handle.Index += i;
+        handle.Count = 1;
+        return handle;
+    }
+};
+
+// 연속 범위 first-fit 할당기 (해제 시 이웃 범위와 합친다)
+class DescriptorRangeAllocator
+{
+public:
+    void Initialize(UINT start, UINT count);
+
+    // 실패하면 UINT_MAX
+    UINT Allocate(UINT count);
+    void Free(UINT start, UINT count);
+
+    UINT GetFreeCount()const { return mFreeCount; }
+
+private:
+    struct Range
+    {
+        UINT Start = 0;
+        UINT Count = 0;
+    };
+
+    std::vector<Range> mFreeRanges;     // Start 순으로 정렬
+    UINT mFreeCount = 0;
+};
+
+// 셰이더에서 보이는 하나뿐인 CBV/SRV/UAV 힙
+//  [0, persistentCount)                  : 영구 영역 (텍스처, 렌더 타겟 SRV, 오브젝트 CBV 등)
+//  [persistentCount, +transientCount)    : 프레임마다 쓰고 버리는 링 영역 (펜스로 회수)
+// 프레임 동안 SetDescriptorHeaps는 이 힙 하나로만 호출한다.
+class GpuDescriptorHeap
+{
+public:
+    GpuDescriptorHeap() = default;
+    GpuDescriptorHeap(const GpuDescriptorHeap& rhs) = delete;
+    GpuDescriptorHeap& operator=(const GpuDescriptorHeap& rhs) = delete;
+
+    void Initialize(ID3D12Device* device, UINT persistentCount, UINT transientCount);
+
+    ID3D12DescriptorHeap* GetHeap()const { return mHeap.Get(); }
+    UINT GetDescriptorSize()const { return mDescriptorSize; }
+
+    void Bind(ID3D12GraphicsCommandList* cmdList)const;
+
+    // 영구 영역 (여러 스레드에서 호출 가능)
+    DescriptorHandle AllocatePersistent(UINT count = 1);
+    // GPU가 아직 사용 중일 수 있으므로 다음 FinishFrame의 펜스가 지난 뒤에 재사용된다.
+    void FreePersistent(const DescriptorHandle& handle);
+    void FreePersistent(D3D12_CPU_DESCRIPTOR_HANDLE cpu, UINT count = 1);
+
+    // 링 영역 (렌더 스레드에서만 호출)
+    DescriptorHandle AllocateTransient(UINT count = 1);
+    // CPU 전용 힙의 디스크립터를 링 영역으로 복사
+    DescriptorHandle CopyToTransient(D3D12_CPU_DESCRIPTOR_HANDLE src, UINT count = 1);
+
+    // 프레임 제출 후 : 이번 프레임에 할당한 링 영역/해제한 영구 영역을 fence에 묶는다.
+    void FinishFrame(UINT64 fence);
+    // GPU가 끝낸 프레임의 링 영역/영구 영역 회수
+    void ReleaseCompleted(UINT64 completedFence);
+
+    UINT GetPersistentUsed();
+    UINT GetTransientUsed()const { return mRingUsed; }
+
+private:
+    DescriptorHandle MakeHandle(UINT index, UINT count)const;
+
+    struct RetiredFree
+    {
+        UINT64 Fence = 0;
+        UINT Start = 0;
+        UINT Count = 0;
+    };
+
+    struct RingFrame
+    {
+        UINT64 Fence = 0;
+        UINT Used = 0;
+    };
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mHeap;
+    D3D12_CPU_DESCRIPTOR_HANDLE mCpuStart = {};
+    D3D12_GPU_DESCRIPTOR_HANDLE mGpuStart = {};
+    UINT mDescriptorSize = 0;
+
+    // 영구 영역
+    std::mutex mPersistentMutex;
+    DescriptorRangeAllocator mPersistent;
+    UINT mPersistentCount = 0;
+    std::vector<RetiredFree> mPendingFrees;     // 아직 펜스가 정해지지 않은 해제
+    std::vector<RetiredFree> mRetiredFrees;     // 펜스를 기다리는 해제
+
+    // 링 영역
+    UINT mRingCount = 0;
+    UINT mRingHead = 0;         // 다음 할당 위치 (링 안에서의 인덱스)
+    UINT mRingUsed = 0;         // 사용 중인 수 (끝에서 건너뛴 부분 포함)
+    UINT mRingFrameUsed = 0;    // 이번 프레임에 사용한 수
+    std::deque<RingFrame> mRingFrames;
+};
+
+// CPU 전용 디스크립터 힙
+// 뷰를 미리 만들어 두고 필요할 때 GpuDescriptorHeap으로 복사한다.
+// CPU 전용 디스크립터는 복사 시점에 읽히므로 해제 즉시 재사용해도 된다.
+class StagingDescriptorHeap
+{
+public:
+    StagingDescriptorHeap() = default;
+    StagingDescriptorHeap(const StagingDescriptorHeap& rhs) = delete;
+    StagingDescriptorHeap& operator=(const StagingDescriptorHeap& rhs) = delete;
+
+    void Initialize(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count);
+
+    DescriptorHandle Allocate(UINT count = 1);
+    void Free(const DescriptorHandle& handle);
+
+    UINT GetDescriptorSize()const { return mDescriptorSize; }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mHeap;
+    D3D12_CPU_DESCRIPTOR_HANDLE mCpuStart = {};
+    UINT mDescriptorSize = 0;
+
+    DescriptorRangeAllocator mAllocator;
+};
@@ -0,0 +1,77 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+void DynamicResolutionController::SetSettings(const DynamicResolutionSettings& settings)
+{
+    mSettings = settings;
+    mScale = Clamp(mScale);
+}
+
+void DynamicResolutionController::Reset()
+{
+    mScale = mSettings.MaxScale;
+    mIntegral = 0.0f;
+    mSmoothedMs = 0.0f;
+    mHasSample = false;
+    mSettleCount = 0;
+}
+
+float DynamicResolutionController::Update(float frameMs)
+{
+    if (!(frameMs > 0.0f))
+        return mScale;
+
+    // 창 드래그, 중단점 같은 한 번 튀는 프레임이 배율을 크게 흔들지 않도록 자른다.
+    frameMs = std::min(frameMs, mSettings.TargetFrameMs * 4.0f);
+
+    if (!mHasSample)
+    {
+        mSmoothedMs = frameMs;
+        mHasSample = true;
+    }
+    else
+    {
+        mSmoothedMs += (frameMs - mSmoothedMs) * mSettings.Smoothing;
+    }
+
+    if (mSettleCount > 0)
+    {
+        --mSettleCount;
+        return mScale;
+    }
+
+    // 지금 배율에서 목표 시간이 되려면 필요한 배율 (픽셀 수 = 배율^2)
+    const float goalMs = mSettings.TargetFrameMs * mSettings.Headroom;
+    const float idealScale = mScale * std::sqrt(goalMs / mSmoothedMs);
+    const float error = idealScale - mScale;
+
+    float next = mScale + mSettings.Kp * error + mSettings.Ki * (mIntegral + error);
+
+    // 한계에 닿아 있으면 적분을 더 쌓지 않는다. (anti-windup)
+    if (next == Clamp(next))
+        mIntegral += error;
+    else
+        mIntegral = 0.0f;
+
+    next = Clamp(next);
+
+    if (std::fabs(next - mScale) >= mSettings.ScaleStep ||
+        (next != mScale && (next == mSettings.MinScale || next == mSettings.MaxScale)))
+    {
+        mScale = next;
+        mIntegral = 0.0f;
+        mSettleCount = mSettings.SettleFrames;
+
+        // 바뀐 배율에서 다시 측정하도록 평균도 새 배율 기준으로 옮긴다.
+        mHasSample = false;
+    }
+
+    return mScale;
+}
+
+float DynamicResolutionController::Clamp(float value)const
+{
+    return std::max(mSettings.MinScale, std::min(mSettings.MaxScale, value));
+}
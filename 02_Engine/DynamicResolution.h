@@ -0,0 +1,50 @@
+#pragma once
+
+// 동적 해상도 컨트롤러 설정
+struct DynamicResolutionSettings
+{
+    float TargetFrameMs = 1000.0f / 60.0f;  // 프레임 시간 예산
+    float Headroom = 0.9f;                  // 예산의 이 비율을 목표로 잡는다. (튀는 프레임 여유)
+
+    float MinScale = 0.5f;                  // 한 축 기준 배율
+    float MaxScale = 1.0f;
+    float ScaleStep = 0.05f;                // 이보다 작은 변화는 무시 (해상도가 매 프레임 흔들리지 않도록)
+
+    float Kp = 0.6f;                        // 비례 이득
+    float Ki = 0.05f;                       // 적분 이득
+    float Smoothing = 0.2f;                 // 프레임 시간 지수 이동 평균 계수 (0~1, 클수록 빠르게 반응)
+    int SettleFrames = 4;                   // 배율을 바꾼 뒤 측정을 건너뛸 프레임 수 (파이프라인 지연)
+};
+
+// 프레임 시간을 받아서 렌더 해상도 배율을 정하는 PI 컨트롤러
+// 비용이 픽셀 수(배율^2)에 비례한다고 보고, 목표 시간에 맞는 배율을 계산해서 그쪽으로 따라간다.
+// D3D에 의존하지 않으므로 기록해둔 프레임 시간으로 그대로 돌려볼 수 있다.
+class DynamicResolutionController
+{
+public:
+    DynamicResolutionController() = default;
+    explicit DynamicResolutionController(const DynamicResolutionSettings& settings) : mSettings(settings) { Reset(); }
+
+    void SetSettings(const DynamicResolutionSettings& settings);
+    const DynamicResolutionSettings& GetSettings()const { return mSettings; }
+
+    void Reset();
+
+    // 이번 프레임 시간을 넣고 다음 프레임에 쓸 배율을 받는다.
+    float Update(float frameMs);
+
+    float GetScale()const { return mScale; }
+    float GetSmoothedFrameMs()const { return mSmoothedMs; }
+
+private:
+    float Clamp(float value)const;
+
+private:
+    DynamicResolutionSettings mSettings;
+
+    float mScale = 1.0f;
+    float mIntegral = 0.0f;
+    float mSmoothedMs = 0.0f;
+    bool mHasSample = false;
+    int mSettleCount = 0;
+};
@@ -0,0 +1,85 @@
+#include "FramePipeline.h"
+
+void FramePipeline::Initialize(int slotCount)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mSlotCount = slotCount > 0 ? slotCount : 1;
+    mWrittenCount = 0;
+    mReadCount = 0;
+    mIsShutdown = false;
+}
+
+int FramePipeline::BeginWrite()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    // N 프레임 전에 넘겨준 슬롯을 렌더 스레드가 아직 쓰고 있으면 대기
+    mCondition.wait(lock, [this]
+    {
+        return mIsShutdown || mWrittenCount - mReadCount < (std::uint64_t)mSlotCount;
+    });
+
+    if (mIsShutdown)
+        return -1;
+
+    return (int)(mWrittenCount % mSlotCount);
+}
+
+void FramePipeline::EndWrite()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mWrittenCount;
+    }
+    mCondition.notify_all();
+}
+
+bool FramePipeline::WaitForFrame()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mCondition.wait(lock, [this] { return mIsShutdown || mReadCount < mWrittenCount; });
+
+    return !mIsShutdown;
+}
+
+int FramePipeline::BeginRead()
+{
+    if (!WaitForFrame())
+        return -1;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return (int)(mReadCount % mSlotCount);
+}
+
+void FramePipeline::EndRead()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mReadCount;
+    }
+    mCondition.notify_all();
+}
+
+void FramePipeline::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mCondition.wait(lock, [this] { return mIsShutdown || mReadCount == mWrittenCount; });
+}
+
+void FramePipeline::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsShutdown = true;
+    }
+    mCondition.notify_all();
+}
+
+bool FramePipeline::IsShutdown()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mIsShutdown;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+// 게임 스레드(생산자)와 렌더 스레드(소비자) 사이에서 프레임 스냅샷 슬롯을 주고받는 링.
+// 슬롯 수는 FrameResource 수와 같고, 슬롯 인덱스가 곧 FrameResource 인덱스이다.
+// 게임 스레드는 N 프레임 전 슬롯을 렌더 스레드가 다 쓸 때까지 대기하므로
+// 게임 스레드가 렌더 스레드보다 최대 N 프레임까지만 앞서 나갈 수 있다.
+class FramePipeline
+{
+public:
+    FramePipeline() = default;
+    FramePipeline(const FramePipeline& rhs) = delete;
+    FramePipeline& operator=(const FramePipeline& rhs) = delete;
+
+    void Initialize(int slotCount);
+
+    // 게임 스레드: 쓸 슬롯을 받아온다. 종료 중이면 -1.
+    int  BeginWrite();
+    // 게임 스레드: 스냅샷 작성 완료, 렌더 스레드에 넘긴다.
+    void EndWrite();
+
+    // 렌더 스레드: 넘겨받을 프레임이 생길 때까지 대기. 종료 중이면 false.
+    bool WaitForFrame();
+    // 렌더 스레드: 읽을 슬롯을 받아온다. 종료 중이면 -1.
+    int  BeginRead();
+    // 렌더 스레드: 기록/제출 완료, 슬롯을 게임 스레드에 돌려준다.
+    void EndRead();
+
+    // 넘겨준 프레임이 모두 렌더 스레드에서 처리될 때까지 대기 (리사이즈 등)
+    void WaitIdle();
+
+    // 대기 중인 스레드를 모두 깨우고 종료 상태로 만든다.
+    void Shutdown();
+    bool IsShutdown();
+
+    int SlotCount()const { return mSlotCount; }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    int mSlotCount = 1;
+
+    std::uint64_t mWrittenCount = 0;   // 게임 스레드가 넘겨준 프레임 수
+    std::uint64_t mReadCount = 0;      // 렌더 스레드가 처리 완료한 프레임 수
+
+    bool mIsShutdown = false;
+};
@@ -3,10 +3,15 @@
 #include "../01_Core/MathHelper.h"
 #include "d3dUtil.h"
 #include "UploadBuffer.h"
+#include "VertexLayout.h"
 
 struct ObjectConstants
 {
     DirectX::XMFLOAT4X4 World = MathHelper::Identity4x4();
+    DirectX::XMFLOAT3 PositionScale = { 1.0f, 1.0f, 1.0f };    // 양자화된 위치 복원 (MeshGeometry와 같은 값)
+    float cbPerObjectPad0 = 0.0f;
+    DirectX::XMFLOAT3 PositionOffset = { 0.0f, 0.0f, 0.0f };
+    float cbPerObjectPad1 = 0.0f;
 };
 
 struct PassConstants
@@ -27,19 +32,35 @@ struct PassConstants
     float DeltaTime = 0.0f;
 };
 
-struct Vertex
+// 씬 정점은 두 스트림으로 나눈다. 깊이 전용 패스는 스트림 0(8바이트)만 읽는다.
+// (float3 위치 + float4 색을 한 버퍼에 넣으면 28바이트)
+// 스트림 0 : 위치 (MeshGeometry::PositionScale/PositionOffset 기준 half)
+struct VertexPosition
 {
-    DirectX::XMFLOAT3 Pos;
-    DirectX::XMFLOAT4 Color;
+    DirectX::PackedVector::XMHALF4 Pos;
+
+    using Layout = VertexLayout<VertexPosition,
+        VertexAttribute<VertexSemantic::Position, DirectX::PackedVector::XMHALF4>>;
 };
 
+// 스트림 1 : 색 (unorm8)
+struct VertexColor
+{
+    DirectX::PackedVector::XMUBYTEN4 Color;
+
+    using Layout = VertexLayout<VertexColor,
+        VertexAttribute<VertexSemantic::Color, DirectX::PackedVector::XMUBYTEN4>>;
+};
+
+using SceneVertexLayout = VertexStreamLayout<VertexPosition::Layout, VertexColor::Layout>;
+
 // Stores the resources needed for the CPU to build the command lists
 // for a frame.  
 struct FrameResource
 {
 public:
     
-    FrameResource(ID3D12Device* device, UINT passCount, UINT objectCount);
+    FrameResource(ID3D12Device* device, UINT passCount, UINT objectCount, GpuMemoryAllocator* allocator = nullptr);
     FrameResource(const FrameResource& rhs) = delete;
     FrameResource& operator=(const FrameResource& rhs) = delete;
     ~FrameResource();
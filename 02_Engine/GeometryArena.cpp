@@ -0,0 +1,455 @@
+#include "GeometryArena.h"
+#include "GpuMemoryAllocator.h"
+#include "../01_Core/IndexCodec.h"
+#include <algorithm>
+#include <cstdio>
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+    // 인덱스 구간 단위 (16비트 칸, 32비트 인덱스는 두 칸)
+    const UINT IndexUnitSize = 2;
+
+    DXGI_FORMAT GetIndexFormat(UINT indexStride)
+    {
+        return indexStride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    }
+}
+
+void GeometryArena::Initialize(
+    ID3D12Device* device,
+    UploadManager* uploadManager,
+    GpuMemoryAllocator* allocator,
+    const UINT* streamStrides,
+    UINT streamCount,
+    UINT vertexCapacity,
+    UINT indexCapacity)
+{
+    assert(streamCount > 0 && streamCount <= MeshGeometry::MaxVertexStreams);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    md3dDevice = device;
+    mUploadManager = uploadManager;
+    mAllocator = allocator;
+
+    mStreamStrides.assign(streamStrides, streamStrides + streamCount);
+    mVertexStride = 0;
+    for (UINT stride : mStreamStrides)
+        mVertexStride += stride;
+
+    mEntries.clear();
+    mFreeHandles.clear();
+    mRetiredFrees.clear();
+    mRetiredBuffers.clear();
+
+    CreateBuffers(vertexCapacity, indexCapacity);
+}
+
+void GeometryArena::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mVertexBuffers.clear();
+    mIndexBuffer = nullptr;
+    mEntries.clear();
+    mFreeHandles.clear();
+    mRetiredFrees.clear();
+    mRetiredBuffers.clear();
+
+    mUploadManager = nullptr;
+    mAllocator = nullptr;
+    md3dDevice = nullptr;
+}
+
+GeometryArena::Handle GeometryArena::Allocate(const void* const* streams, UINT vertexCount, const std::vector<std::uint32_t>& indices)
+{
+    if (vertexCount == 0 || indices.empty())
+        return InvalidHandle;
+
+    // 가장 큰 번호가 16비트에 들어가면 16비트로 담는다.
+    const UINT indexStride = IndexCodec::GetIndexStride(IndexCodec::GetMaxIndex(indices.data(), indices.size()));
+    std::vector<std::uint8_t> converted(indices.size() * indexStride);
+    IndexCodec::Convert(indices.data(), indices.size(), converted.data(), indexStride);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const Handle handle = AllocateEntry(vertexCount, (UINT)indices.size(), indexStride);
+    if (handle == InvalidHandle)
+        return InvalidHandle;
+    const Entry& entry = mEntries[handle];
+
+    // 모든 스트림이 같은 정점 위치에 들어간다.
+    for (size_t i = 0; i < mStreamStrides.size(); ++i)
+    {
+        const UINT stride = mStreamStrides[i];
+        mUploadManager->CopyBuffer(mVertexBuffers[i].Get(), entry.Vertices.Offset * stride, streams[i], (UINT64)vertexCount * stride);
+    }
+    mUploadManager->CopyBuffer(mIndexBuffer.Get(), entry.Indices.Offset * IndexUnitSize, converted.data(), converted.size());
+
+    mCopiedUploadBytes += (UINT64)vertexCount * mVertexStride + converted.size();
+    return handle;
+}
+
+GeometryArena::Handle GeometryArena::AllocateMapped(UINT vertexCount, UINT indexCount, void** streams, void** indices)
+{
+    if (vertexCount == 0 || indexCount == 0)
+        return InvalidHandle;
+
+    // 인덱스는 메시 정점 기준이라 정점 수만 보면 16비트에 들어가는지 안다.
+    const UINT indexStride = GetIndexStride(vertexCount);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const Handle handle = AllocateEntry(vertexCount, indexCount, indexStride);
+    if (handle == InvalidHandle)
+        return InvalidHandle;
+    const Entry& entry = mEntries[handle];
+
+    // 스트림들과 인덱스를 스테이징 한 구간에서 복사한다.
+    BufferCopyRegion regions[MeshGeometry::MaxVertexStreams + 1];
+    void* data[MeshGeometry::MaxVertexStreams + 1];
+    const UINT streamCount = (UINT)mStreamStrides.size();
+    for (UINT i = 0; i < streamCount; ++i)
+    {
+        const UINT stride = mStreamStrides[i];
+        regions[i].Resource = mVertexBuffers[i].Get();
+        regions[i].Offset = entry.Vertices.Offset * stride;
+        regions[i].ByteSize = (UINT64)vertexCount * stride;
+    }
+    regions[streamCount].Resource = mIndexBuffer.Get();
+    regions[streamCount].Offset = entry.Indices.Offset * IndexUnitSize;
+    regions[streamCount].ByteSize = (UINT64)indexCount * indexStride;
+    mUploadManager->AllocateBufferCopies(regions, streamCount + 1, data);
+
+    for (UINT i = 0; i < streamCount; ++i)
+        streams[i] = data[i];
+    *indices = data[streamCount];
+
+    mMappedUploadBytes += (UINT64)vertexCount * mVertexStride + (UINT64)indexCount * indexStride;
+    return handle;
+}
+
+GeometryArena::Handle GeometryArena::AllocateEntry(UINT vertexCount, UINT indexCount, UINT indexStride)
+{
+    // 32비트 구간은 두 칸씩, 4바이트 정렬
+    const UINT indexUnits = indexStride / IndexUnitSize;
+
+    Entry entry;
+    entry.Vertices = mVertexAllocator.Allocate(vertexCount);
+    entry.Indices = mIndexAllocator.Allocate((UINT64)indexCount * indexUnits, indexUnits);
+    entry.IndexStride = indexStride;
+    if (!entry.Vertices.IsValid() || !entry.Indices.IsValid())
+    {
+        if (entry.Vertices.IsValid())
+            mVertexAllocator.Free(entry.Vertices);
+        if (entry.Indices.IsValid())
+            mIndexAllocator.Free(entry.Indices);
+        return InvalidHandle;
+    }
+
+    entry.IsLive = true;
+
+    Handle handle;
+    if (!mFreeHandles.empty())
+    {
+        handle = mFreeHandles.back();
+        mFreeHandles.pop_back();
+        mEntries[handle] = entry;
+    }
+    else
+    {
+        handle = (Handle)mEntries.size();
+        mEntries.push_back(entry);
+    }
+    return handle;
+}
+
+void GeometryArena::Free(Handle handle, UINT64 fence)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    assert(handle < mEntries.size() && mEntries[handle].IsLive && !mEntries[handle].IsPendingFree);
+    mEntries[handle].IsPendingFree = true;
+
+    RetiredFree retired;
+    retired.Fence = fence;
+    retired.Mesh = handle;
+    mRetiredFrees.push_back(retired);
+}
+
+void GeometryArena::ReleaseCompleted(UINT64 completedFence)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = std::remove_if(mRetiredFrees.begin(), mRetiredFrees.end(), [this, completedFence](const RetiredFree& retired)
+    {
+        if (retired.Fence > completedFence)
+            return false;
+
+        ReleaseEntry(retired.Mesh);
+        return true;
+    });
+    mRetiredFrees.erase(it, mRetiredFrees.end());
+
+    while (!mRetiredBuffers.empty() && mRetiredBuffers.front().Fence <= completedFence && mRetiredBuffers.front().Copy.IsReady())
+        mRetiredBuffers.pop_front();
+}
+
+UploadFuture GeometryArena::Compact(UINT64 fence, UINT vertexCapacity, UINT indexCapacity)
+{
+    // 아직 제출하지 않은 업로드가 옛 버퍼에 먼저 써지도록 내보낸다. (같은 제출 안에서는 쓴 구간을 다시 읽으려면 배리어가 필요하다)
+    mUploadManager->Submit();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::vector<Handle> live;
+    UINT64 liveVertices = 0;
+    UINT64 liveIndices = 0;
+    UINT64 largestVertices = 0;
+    UINT64 largestIndices = 0;
+    for (Handle handle = 0; handle < (Handle)mEntries.size(); ++handle)
+    {
+        Entry& entry = mEntries[handle];
+        if (!entry.IsLive)
+            continue;
+
+        // 해제를 기다리는 구간은 그리던 프레임이 옛 버퍼에서 읽으므로 새 버퍼에는 자리가 필요 없다.
+        if (entry.IsPendingFree)
+        {
+            entry.Vertices = TlsfAllocator::Allocation();
+            entry.Indices = TlsfAllocator::Allocation();
+            continue;
+        }
+
+        live.push_back(handle);
+        liveVertices += entry.Vertices.Size;
+        liveIndices += entry.Indices.Size;
+        largestVertices = std::max<UINT64>(largestVertices, entry.Vertices.Size);
+        largestIndices = std::max<UINT64>(largestIndices, entry.Indices.Size);
+    }
+
+    // 옛 위치 순서로 채워야 붙어 있던 구간이 계속 붙어 있어서 복사를 합칠 수 있다.
+    std::sort(live.begin(), live.end(), [this](Handle a, Handle b)
+    {
+        return mEntries[a].Vertices.Offset < mEntries[b].Vertices.Offset;
+    });
+
+    // TLSF는 요청 크기를 다음 크기 등급으로 올려서 찾으므로 마지막 구간까지 들어가도록 가장 큰 구간의 1/16만큼 여유를 둔다.
+    // 인덱스는 32비트 구간 정렬로 구간마다 한 칸까지 빌 수 있다.
+    const UINT minVertexCapacity = (UINT)(liveVertices + largestVertices / 16 + 16);
+    const UINT minIndexCapacity = (UINT)(liveIndices + live.size() + largestIndices / 16 + 16);
+    vertexCapacity = std::max<UINT>(vertexCapacity > 0 ? vertexCapacity : mVertexCapacity, minVertexCapacity);
+    indexCapacity = std::max<UINT>(indexCapacity > 0 ? indexCapacity : mIndexCapacity, minIndexCapacity);
+
+    std::vector<ComPtr<ID3D12Resource>> oldVertexBuffers = std::move(mVertexBuffers);
+    ComPtr<ID3D12Resource> oldIndexBuffer = std::move(mIndexBuffer);
+    CreateBuffers(vertexCapacity, indexCapacity);
+
+    // 원본과 대상이 모두 이어지는 구간은 복사 하나로 합친다. (개수 단위)
+    struct CopyRun
+    {
+        UINT64 Src = 0;
+        UINT64 Dst = 0;
+        UINT64 Count = 0;
+    };
+    std::vector<CopyRun> vertexRuns;
+    std::vector<CopyRun> indexRuns;
+    auto addRun = [](std::vector<CopyRun>& runs, UINT64 src, UINT64 dst, UINT64 count)
+    {
+        if (!runs.empty() && runs.back().Src + runs.back().Count == src && runs.back().Dst + runs.back().Count == dst)
+        {
+            runs.back().Count += count;
+            return;
+        }
+
+        CopyRun run;
+        run.Src = src;
+        run.Dst = dst;
+        run.Count = count;
+        runs.push_back(run);
+    };
+
+    // 빈 할당기에서 순서대로 잡으면 앞쪽부터 빈틈없이 채워진다.
+    for (Handle handle : live)
+    {
+        Entry& entry = mEntries[handle];
+        TlsfAllocator::Allocation vertices = mVertexAllocator.Allocate(entry.Vertices.Size);
+        TlsfAllocator::Allocation indices = mIndexAllocator.Allocate(entry.Indices.Size, entry.IndexStride / IndexUnitSize);
+        assert(vertices.IsValid() && indices.IsValid());
+
+        addRun(vertexRuns, entry.Vertices.Offset, vertices.Offset, entry.Vertices.Size);
+        addRun(indexRuns, entry.Indices.Offset, indices.Offset, entry.Indices.Size);
+        entry.Vertices = vertices;
+        entry.Indices = indices;
+    }
+
+    UINT64 copiedBytes = 0;
+    for (const CopyRun& run : vertexRuns)
+    {
+        for (size_t i = 0; i < mStreamStrides.size(); ++i)
+        {
+            const UINT stride = mStreamStrides[i];
+            mUploadManager->CopyBufferRegion(mVertexBuffers[i].Get(), run.Dst * stride, oldVertexBuffers[i].Get(), run.Src * stride, run.Count * stride);
+            copiedBytes += run.Count * stride;
+        }
+    }
+    for (const CopyRun& run : indexRuns)
+    {
+        mUploadManager->CopyBufferRegion(mIndexBuffer.Get(), run.Dst * IndexUnitSize, oldIndexBuffer.Get(), run.Src * IndexUnitSize, run.Count * IndexUnitSize);
+        copiedBytes += run.Count * IndexUnitSize;
+    }
+
+    ++mCompactCount;
+    mCompactedBytes += copiedBytes;
+    mCompactCopies += (UINT)(vertexRuns.size() * mStreamStrides.size() + indexRuns.size());
+
+    const UploadFuture future = mUploadManager->Submit();
+
+    // 그리던 프레임(직접 큐)과 방금 제출한 복사(복사 큐)가 모두 끝나야 옛 버퍼를 놓는다.
+    oldVertexBuffers.push_back(std::move(oldIndexBuffer));
+    for (ComPtr<ID3D12Resource>& buffer : oldVertexBuffers)
+    {
+        RetiredBuffer retired;
+        retired.Fence = fence;
+        retired.Copy = future;
+        retired.Resource = std::move(buffer);
+        mRetiredBuffers.push_back(std::move(retired));
+    }
+
+    return future;
+}
+
+GeometryRange GeometryArena::GetRange(Handle handle)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    GeometryRange range;
+    const Entry& entry = mEntries[handle];
+    if (!entry.IsLive || !entry.Vertices.IsValid())
+        return range;
+
+    // 32비트 구간은 4바이트 정렬이라 칸 위치가 짝수다.
+    const UINT indexUnits = entry.IndexStride / IndexUnitSize;
+    range.IndexCount = (UINT)(entry.Indices.Size / indexUnits);
+    range.StartIndex = (UINT)(entry.Indices.Offset / indexUnits);
+    range.BaseVertex = (INT)entry.Vertices.Offset;
+    range.VertexCount = (UINT)entry.Vertices.Size;
+    range.IndexFormat = GetIndexFormat(entry.IndexStride);
+    return range;
+}
+
+UINT GeometryArena::VertexBufferViews(D3D12_VERTEX_BUFFER_VIEW* views, UINT streamCount)const
+{
+    streamCount = std::min<UINT>(streamCount, GetStreamCount());
+    for (UINT i = 0; i < streamCount; ++i)
+    {
+        views[i].BufferLocation = mVertexBuffers[i]->GetGPUVirtualAddress();
+        views[i].StrideInBytes = mStreamStrides[i];
+        views[i].SizeInBytes = mVertexCapacity * mStreamStrides[i];
+    }
+    return streamCount;
+}
+
+D3D12_INDEX_BUFFER_VIEW GeometryArena::IndexBufferView(DXGI_FORMAT format)const
+{
+    assert(format == DXGI_FORMAT_R16_UINT || format == DXGI_FORMAT_R32_UINT);
+
+    D3D12_INDEX_BUFFER_VIEW ibv;
+    ibv.BufferLocation = mIndexBuffer->GetGPUVirtualAddress();
+    ibv.Format = format;
+    ibv.SizeInBytes = (mIndexCapacity * IndexUnitSize + 3) & ~3u;  // 버퍼 크기 (4바이트 단위)
+
+    return ibv;
+}
+
+GeometryArena::Stats GeometryArena::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Stats stats;
+    stats.MeshCount = (UINT)(mEntries.size() - mFreeHandles.size());
+    stats.PendingFreeCount = (UINT)mRetiredFrees.size();
+    stats.Vertices = mVertexAllocator.GetStats();
+    stats.Indices = mIndexAllocator.GetStats();
+    stats.CompactCount = mCompactCount;
+    stats.CompactedBytes = mCompactedBytes;
+    stats.CompactCopies = mCompactCopies;
+    stats.CopiedUploadBytes = mCopiedUploadBytes;
+    stats.MappedUploadBytes = mMappedUploadBytes;
+    return stats;
+}
+
+std::string GeometryArena::GetStatsString(const char* name)
+{
+    const Stats stats = GetStats();
+
+    char text[512];
+    snprintf(text, sizeof(text),
+        "GeometryArena %s: %u meshes (%u pending free), vertices %llu / %llu (fragmentation %.1f%%), indices %llu / %llu (fragmentation %.1f%%), compact %u (%.2f MB, %u copies), upload %.2f MB copied / %.2f MB written in place\n",
+        name,
+        stats.MeshCount,
+        stats.PendingFreeCount,
+        (unsigned long long)stats.Vertices.UsedSize, (unsigned long long)stats.Vertices.TotalSize,
+        stats.Vertices.Fragmentation() * 100.0,
+        (unsigned long long)stats.Indices.UsedSize, (unsigned long long)stats.Indices.TotalSize,
+        stats.Indices.Fragmentation() * 100.0,
+        stats.CompactCount,
+        stats.CompactedBytes / (1024.0 * 1024.0),
+        stats.CompactCopies,
+        stats.CopiedUploadBytes / (1024.0 * 1024.0),
+        stats.MappedUploadBytes / (1024.0 * 1024.0));
+    return text;
+}
+
+ComPtr<ID3D12Resource> GeometryArena::CreateBuffer(UINT64 byteSize)
+{
+    if (mAllocator != nullptr)
+        return mAllocator->CreateBuffer(D3D12_HEAP_TYPE_DEFAULT, byteSize, D3D12_RESOURCE_STATE_COMMON);
+
+    ComPtr<ID3D12Resource> buffer;
+    CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
+    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+    ThrowIfFailed(md3dDevice->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_COMMON,
+        nullptr,
+        IID_PPV_ARGS(buffer.GetAddressOf())));
+    return buffer;
+}
+
+void GeometryArena::CreateBuffers(UINT vertexCapacity, UINT indexCapacity)
+{
+    mVertexBuffers.clear();
+    for (UINT stride : mStreamStrides)
+    {
+        mVertexBuffers.push_back(CreateBuffer((UINT64)vertexCapacity * stride));
+        mVertexBuffers.back()->SetName(L"GeometryArena Vertices");
+    }
+
+    // 16비트 칸 수가 홀수여도 버퍼 크기는 4바이트 단위로
+    mIndexBuffer = CreateBuffer(((UINT64)indexCapacity * IndexUnitSize + 3) & ~(UINT64)3);
+    mIndexBuffer->SetName(L"GeometryArena Indices");
+
+    mVertexCapacity = vertexCapacity;
+    mIndexCapacity = indexCapacity;
+    mVertexAllocator.Initialize(vertexCapacity);
+    mIndexAllocator.Initialize(indexCapacity);
+}
+
+void GeometryArena::ReleaseEntry(Handle handle)
+{
+    Entry& entry = mEntries[handle];
+
+    // Compact가 이미 버린 구간이면 핸들만 돌려준다.
+    if (entry.Vertices.IsValid())
+        mVertexAllocator.Free(entry.Vertices);
+    if (entry.Indices.IsValid())
+        mIndexAllocator.Free(entry.Indices);
+
+    entry = Entry();
+    mFreeHandles.push_back(handle);
+}
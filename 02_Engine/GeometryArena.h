@@ -0,0 +1,164 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "UploadManager.h"
+#include "../01_Core/TlsfAllocator.h"
+#include <deque>
+#include <mutex>
+
+class GpuMemoryAllocator;
+
+// 아레나 안의 메시 하나 (DrawIndexedInstanced 인자 그대로)
+struct GeometryRange
+{
+    UINT IndexCount = 0;
+    UINT StartIndex = 0;
+    INT BaseVertex = 0;
+    UINT VertexCount = 0;
+    DXGI_FORMAT IndexFormat = DXGI_FORMAT_R16_UINT;     // StartIndex는 이 형식 크기 단위
+};
+
+// 여러 메시가 함께 쓰는 큰 정점/인덱스 버퍼
+// - 정점 스트림마다 기본 힙 버퍼 하나, 인덱스 버퍼 하나. 메시는 그 안의 정점 구간 + 인덱스 구간이다.
+//   모든 스트림이 같은 정점 번호를 쓰므로 BaseVertex 하나로 모든 스트림을 가리킨다.
+// - 구간은 TLSF로 나누고 (정점/인덱스 개수 단위), 메시는 핸들로 가리킨다. Compact가 구간을 옮겨도 핸들은 그대로다.
+// - 씬 전체가 같은 IA 바인딩으로 그려지고, 구간이 그대로 ExecuteIndirect 인자가 된다.
+// - 인덱스 버퍼 하나에 16비트 구간과 32비트 구간이 섞인다. (IndexBufferBuilder와 같은 방식)
+//   메시 정점이 65536개 이하면 16비트, 넘으면 32비트로 담는다. 인덱스 구간은 16비트 칸 단위로 나누고 32비트 구간은 4바이트 정렬
+//   그릴 때는 IndexBufferView(range.IndexFormat)로 같은 버퍼를 그 구간의 형식으로 본다.
+// - 업로드는 UploadManager로 기록만 하므로 그리기 전에 Submit()의 future를 기다린다.
+//   버퍼는 동시 접근이 되므로 복사 큐가 새 구간을 쓰는 동안 다른 구간을 그려도 된다.
+class GeometryArena
+{
+public:
+    using Handle = UINT;
+    static const Handle InvalidHandle = UINT_MAX;
+
+    struct Stats
+    {
+        UINT MeshCount = 0;
+        UINT PendingFreeCount = 0;
+        TlsfAllocator::Stats Vertices;      // 정점 개수 단위
+        TlsfAllocator::Stats Indices;       // 16비트 인덱스 칸 단위 (32비트 인덱스는 두 칸)
+        UINT CompactCount = 0;
+        UINT64 CompactedBytes = 0;          // Compact가 GPU에서 옮긴 바이트
+        UINT CompactCopies = 0;             // 이웃 구간을 합친 뒤의 CopyBufferRegion 수
+        UINT64 CopiedUploadBytes = 0;       // Allocate : 호출한 쪽 버퍼에서 스테이징으로 memcpy한 바이트
+        UINT64 MappedUploadBytes = 0;       // AllocateMapped : 호출한 쪽이 스테이징에 바로 쓴 바이트
+    };
+
+public:
+    GeometryArena() = default;
+    GeometryArena(const GeometryArena& rhs) = delete;
+    GeometryArena& operator=(const GeometryArena& rhs) = delete;
+
+    // streamStrides : 입력 슬롯 순서대로 정점 크기 (MeshGeometry::MaxVertexStreams 이하)
+    // indexCapacity : 16비트 인덱스 칸 수 (32비트 인덱스는 두 칸)
+    void Initialize(
+        ID3D12Device* device,
+        UploadManager* uploadManager,
+        GpuMemoryAllocator* allocator,
+        const UINT* streamStrides,
+        UINT streamCount,
+        UINT vertexCapacity,
+        UINT indexCapacity);
+    // GPU가 아레나를 다 쓴 뒤에 호출
+    void Shutdown();
+
+    // streams[i]는 스트림 i의 정점 vertexCount개, indices는 메시 정점 기준 번호 (가장 큰 번호에 맞는 크기로 담는다)
+    // 자리가 없으면 InvalidHandle (Compact로 용량을 늘린 뒤 다시 시도)
+    Handle Allocate(const void* const* streams, UINT vertexCount, const std::vector<std::uint32_t>& indices);
+
+    // Allocate와 같지만 데이터를 받지 않고 업로드 스테이징 자리를 돌려준다. 호출한 쪽이 최종 형식으로 바로 쓴다.
+    // streams[i]에 스트림 i의 정점 vertexCount개, indices에 GetIndexStride(vertexCount) 크기 인덱스 indexCount개
+    // UploadManager::AllocateBufferCopies와 같이 다음 업로드 기록이나 Submit() 전에 다 써야 한다.
+    Handle AllocateMapped(UINT vertexCount, UINT indexCount, void** streams, void** indices);
+
+    // 정점 vertexCount개인 메시의 인덱스 크기 (2 또는 4바이트)
+    static UINT GetIndexStride(UINT vertexCount) { return vertexCount <= 0x10000 ? 2 : 4; }
+
+    // GPU가 아직 그리고 있을 수 있으므로 fence(직접 큐)가 지난 뒤에 자리를 돌려준다.
+    void Free(Handle handle, UINT64 fence);
+    void ReleaseCompleted(UINT64 completedFence);
+
+    // 살아 있는 구간을 새 버퍼 앞쪽부터 빈틈없이 다시 채운다. (복사 큐에서 GPU -> GPU 복사)
+    // 용량이 0이면 지금 용량, 살아 있는 구간이 들어가지 않으면 필요한 만큼으로 늘린다.
+    // 옛 버퍼는 fence가 지나면 놓는다. 새 버퍼로 그리기 전에 반환한 future를 WaitOnQueue로 기다려야 한다.
+    // 그리기 기록과 동시에 부르지 않는다. (버퍼가 바뀌므로 렌더 스레드가 아레나를 읽지 않을 때)
+    UploadFuture Compact(UINT64 fence, UINT vertexCapacity = 0, UINT indexCapacity = 0);
+
+    // Compact 후에는 값이 바뀌므로 그릴 때마다 읽는다.
+    GeometryRange GetRange(Handle handle);
+
+    // 앞 streamCount개 스트림의 뷰 (IASetVertexBuffers(0, streamCount, views)에 그대로 넘긴다)
+    UINT VertexBufferViews(D3D12_VERTEX_BUFFER_VIEW* views, UINT streamCount)const;
+    // format은 그리는 구간의 GeometryRange::IndexFormat
+    D3D12_INDEX_BUFFER_VIEW IndexBufferView(DXGI_FORMAT format)const;
+
+    UINT GetStreamCount()const { return (UINT)mStreamStrides.size(); }
+    UINT GetStreamStride(UINT stream)const { return mStreamStrides[stream]; }
+
+    Stats GetStats();
+    std::string GetStatsString(const char* name);
+
+    bool IsInitialized()const { return md3dDevice != nullptr; }
+
+private:
+    struct Entry
+    {
+        TlsfAllocator::Allocation Vertices;
+        TlsfAllocator::Allocation Indices;  // 16비트 칸 단위
+        UINT IndexStride = 2;
+        bool IsLive = false;
+        bool IsPendingFree = false;
+    };
+
+    struct RetiredFree
+    {
+        UINT64 Fence = 0;
+        Handle Mesh = InvalidHandle;
+    };
+
+    // 직접 큐는 fence, 복사 큐는 Copy까지 옛 버퍼를 읽는다.
+    struct RetiredBuffer
+    {
+        UINT64 Fence = 0;
+        UploadFuture Copy;
+        Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+    };
+
+    // mMutex를 잡은 상태에서 호출
+    // 정점/인덱스 구간을 잡고 핸들을 붙인다. (자리가 없으면 InvalidHandle)
+    Handle AllocateEntry(UINT vertexCount, UINT indexCount, UINT indexStride);
+    Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(UINT64 byteSize);
+    void CreateBuffers(UINT vertexCapacity, UINT indexCapacity);
+    void ReleaseEntry(Handle handle);
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+    UploadManager* mUploadManager = nullptr;
+    GpuMemoryAllocator* mAllocator = nullptr;
+
+    std::mutex mMutex;
+
+    std::vector<UINT> mStreamStrides;
+    UINT mVertexStride = 0;                 // 모든 스트림 크기의 합
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> mVertexBuffers;    // 스트림마다 하나
+    Microsoft::WRL::ComPtr<ID3D12Resource> mIndexBuffer;
+    UINT mVertexCapacity = 0;
+    UINT mIndexCapacity = 0;                // 16비트 칸 수
+
+    TlsfAllocator mVertexAllocator;
+    TlsfAllocator mIndexAllocator;
+
+    std::vector<Entry> mEntries;            // 핸들 -> 구간
+    std::vector<Handle> mFreeHandles;
+    std::vector<RetiredFree> mRetiredFrees;
+    std::deque<RetiredBuffer> mRetiredBuffers;
+
+    UINT mCompactCount = 0;
+    UINT64 mCompactedBytes = 0;
+    UINT mCompactCopies = 0;
+    UINT64 mCopiedUploadBytes = 0;
+    UINT64 mMappedUploadBytes = 0;
+};
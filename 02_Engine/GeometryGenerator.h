@@ -14,10 +14,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <DirectXMath.h>
+#include <functional>
 #include <vector>
 
+class JobSystem;
+
+// 정점/인덱스 수를 미리 계산해 한 번에 잡고 제자리에 쓴다.
+// JobSystem을 넘기면 큰 메시는 링/행 단위로 나눠서 병렬로 만든다. (결과는 직렬과 같다)
+//
+// MeshData를 돌려주는 함수 외에 출력 싱크를 받는 템플릿 버전이 있다. 싱크는 다음을 제공한다.
+//   void Begin(uint32 vertexCount, uint32 indexCount);    // 쓰기 전에 한 번 (개수가 정해지면)
+//   void WriteVertex(uint32 i, const Vertex& vertex);     // 정점마다 정확히 한 번
+//   void WriteIndex(uint32 i, uint32 index);              // 인덱스마다 정확히 한 번
+// 서로 다른 i에 대한 Write는 작업자 스레드에서 동시에 불린다. 싱크가 대상 형식으로 바꿔서
+// 최종 메모리 (매핑된 스테이징 버퍼 등)에 바로 쓰면 중간 MeshData 없이 한 번만 복사된다.
 class GeometryGenerator
 {
 public:
@@ -25,6 +39,9 @@ public:
     using uint16 = std::uint16_t;
     using uint32 = std::uint32_t;
 
+    GeometryGenerator() = default;
+    explicit GeometryGenerator(JobSystem* jobs);
+
 	struct Vertex
 	{
 		Vertex(){}
@@ -58,10 +75,13 @@ public:
 		std::vector<Vertex> Vertices;
         std::vector<uint32> Indices32;
 
+        // 인덱스를 그대로 16비트로 자르므로 정점이 65536개 이하일 때만 쓴다.
+        // 더 크면 IndexBufferBuilder::SplitForIndex16으로 나누거나 IndexBufferBuilder::Add로 폭을 고르게 한다.
         std::vector<uint16>& GetIndices16()
         {
 			if(mIndices16.empty())
 			{
+				assert(Vertices.size() <= 0x10000 && "16-bit indices would truncate");
 				mIndices16.resize(Indices32.size());
 				for(size_t i = 0; i < Indices32.size(); ++i)
 					mIndices16[i] = static_cast<uint16>(Indices32[i]);
@@ -74,6 +94,24 @@ public:
 		std::vector<uint16> mIndices16;
 	};
 
+    // MeshData에 그대로 쓰는 싱크 (MeshData를 돌려주는 함수들이 쓴다)
+    class MeshDataSink
+    {
+    public:
+        explicit MeshDataSink(MeshData& mesh) : mMesh(mesh) {}
+
+        void Begin(uint32 vertexCount, uint32 indexCount)
+        {
+            mMesh.Vertices.resize(vertexCount);
+            mMesh.Indices32.resize(indexCount);
+        }
+        void WriteVertex(uint32 i, const Vertex& vertex) { mMesh.Vertices[i] = vertex; }
+        void WriteIndex(uint32 i, uint32 index) { mMesh.Indices32[i] = index; }
+
+    private:
+        MeshData& mMesh;
+    };
+
 	///<summary>
 	/// Creates a box centered at the origin with the given dimensions, where each
     /// face has m rows and n columns of vertices.
@@ -89,6 +127,7 @@ public:
 	///<summary>
 	/// Creates a geosphere centered at the origin with the given radius.  The
 	/// depth controls the level of tessellation.
+	/// 변을 공유하는 삼각형끼리 중점 정점을 같이 쓰므로 정점 수는 약 삼각형 수 / 2다.
 	///</summary>
     MeshData CreateGeosphere(float radius, uint32 numSubdivisions);
 
@@ -110,10 +149,557 @@ public:
 	///</summary>
     MeshData CreateQuad(float x, float y, float w, float h, float depth);
 
+    // 싱크 버전 (정점/인덱스 순서와 값은 MeshData 버전과 같다)
+    // 박스는 분할 결과 격자를 면마다 바로 쓰고, 지오스피어는 분할한 위치를 구에 투영하면서 싱크에 쓴다.
+    template<typename TSink>
+    void CreateBox(TSink& sink, float width, float height, float depth, uint32 numSubdivisions);
+    template<typename TSink>
+    void CreateSphere(TSink& sink, float radius, uint32 sliceCount, uint32 stackCount);
+    template<typename TSink>
+    void CreateGeosphere(TSink& sink, float radius, uint32 numSubdivisions);
+    template<typename TSink>
+    void CreateCylinder(TSink& sink, float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount);
+    template<typename TSink>
+    void CreateGrid(TSink& sink, float width, float depth, uint32 m, uint32 n);
+
 private:
+    // 링 하나를 작업 하나로 나누기에는 너무 짧을 때 묶는 정점 수
+    static const uint32 ParallelBatchVertices = 4096;
+
+    // sin/cos(i * step), i = 0 ~ count (XMVectorSinCos로 네 개씩)
+    // 링마다 같은 각도를 쓰므로 한 번만 계산해 두고 모든 링이 같이 읽는다.
+    static void BuildSinCosTable(uint32 count, float step, std::vector<float>& sines, std::vector<float>& cosines);
+
+    // 정이십면체를 numSubdivisions번 분할한 위치와 인덱스 (아직 구에 투영하기 전)
+    MeshData CreateSubdividedIcosahedron(uint32 numSubdivisions);
+
+    // 박스 면마다 꼭짓점 네 개 (v[4*face]부터 한 바퀴 순서, 삼각형은 0-1-2, 0-2-3)
+    static void GetBoxCorners(float width, float height, float depth, Vertex v[24]);
+
 	void Subdivide(MeshData& meshData);
     Vertex MidPoint(const Vertex& v0, const Vertex& v1);
-    void BuildCylinderTopCap(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount, MeshData& meshData);
-    void BuildCylinderBottomCap(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount, MeshData& meshData);
+    // sines/cosines : 옆면과 같은 각도 표 (sliceCount + 1개)
+    // baseVertex/baseIndex부터 정점 sliceCount + 2개, 인덱스 sliceCount * 3개를 쓴다.
+    template<typename TSink>
+    void BuildCylinderTopCap(TSink& sink, float topRadius, float height, uint32 sliceCount,
+        const std::vector<float>& sines, const std::vector<float>& cosines, uint32 baseVertex, uint32 baseIndex);
+    template<typename TSink>
+    void BuildCylinderBottomCap(TSink& sink, float bottomRadius, float height, uint32 sliceCount,
+        const std::vector<float>& sines, const std::vector<float>& cosines, uint32 baseVertex, uint32 baseIndex);
+
+    // mJobs가 없거나 count가 batchSize 이하이면 그 자리에서 차례로 실행
+    void ParallelFor(uint32 count, uint32 batchSize, const std::function<void(uint32)>& body);
+
+private:
+    JobSystem* mJobs = nullptr;
 };
 
+template<typename TSink>
+void GeometryGenerator::CreateBox(TSink& sink, float width, float height, float depth, uint32 numSubdivisions)
+{
+	Vertex corners[24];
+	GetBoxCorners(width, height, depth, corners);
+
+	// Put a cap on the number of subdivisions.
+	numSubdivisions = std::min<uint32>(numSubdivisions, 6u);
+
+	// 면의 두 삼각형을 중점으로 n번 나누면 면은 (2^n + 1) x (2^n + 1) 격자가 되고 대각선은 모두 0-2와 같은 방향이다.
+	// 법선/접선은 면 안에서 같으므로 격자 정점을 꼭짓점에서 바로 보간해서 쓴다.
+	const uint32 cellCount = 1u << numSubdivisions;
+	const uint32 rowVertexCount = cellCount + 1;
+	const uint32 faceVertexCount = rowVertexCount*rowVertexCount;
+	const uint32 faceIndexCount = 6*cellCount*cellCount;
+	sink.Begin(6*faceVertexCount, 6*faceIndexCount);
+
+	// 면마다 격자 한 줄씩 (줄끼리 독립이라 병렬)
+	const float step = 1.0f/cellCount;
+	const uint32 rowBatch = std::max<uint32>(ParallelBatchVertices / rowVertexCount, 1);
+	ParallelFor(6*rowVertexCount, rowBatch, [&](uint32 faceRow)
+	{
+		const uint32 face = faceRow / rowVertexCount;
+		const uint32 row = faceRow % rowVertexCount;
+		const Vertex& c0 = corners[4*face + 0];
+		const Vertex& c1 = corners[4*face + 1];
+		const Vertex& c3 = corners[4*face + 3];
+
+		// s : c0 -> c1, t : c0 -> c3
+		const float t = row*step;
+		const uint32 baseVertex = face*faceVertexCount + row*rowVertexCount;
+		for(uint32 column = 0; column <= cellCount; ++column)
+		{
+			const float s = column*step;
+
+			Vertex v;
+			v.Position = DirectX::XMFLOAT3(
+				c0.Position.x + s*(c1.Position.x - c0.Position.x) + t*(c3.Position.x - c0.Position.x),
+				c0.Position.y + s*(c1.Position.y - c0.Position.y) + t*(c3.Position.y - c0.Position.y),
+				c0.Position.z + s*(c1.Position.z - c0.Position.z) + t*(c3.Position.z - c0.Position.z));
+			v.Normal = c0.Normal;
+			v.TangentU = c0.TangentU;
+			v.TexC = DirectX::XMFLOAT2(
+				c0.TexC.x + s*(c1.TexC.x - c0.TexC.x) + t*(c3.TexC.x - c0.TexC.x),
+				c0.TexC.y + s*(c1.TexC.y - c0.TexC.y) + t*(c3.TexC.y - c0.TexC.y));
+
+			sink.WriteVertex(baseVertex + column, v);
+		}
+
+		// 이 줄과 다음 줄 사이의 칸들
+		if(row == cellCount)
+			return;
+
+		uint32 k = face*faceIndexCount + row*cellCount*6;
+		for(uint32 column = 0; column < cellCount; ++column)
+		{
+			const uint32 q0 = baseVertex + column;
+			const uint32 q1 = q0 + 1;
+			const uint32 q3 = q0 + rowVertexCount;
+			const uint32 q2 = q3 + 1;
+
+			sink.WriteIndex(k++, q0);
+			sink.WriteIndex(k++, q1);
+			sink.WriteIndex(k++, q2);
+
+			sink.WriteIndex(k++, q0);
+			sink.WriteIndex(k++, q2);
+			sink.WriteIndex(k++, q3);
+		}
+	});
+}
+
+template<typename TSink>
+void GeometryGenerator::CreateSphere(TSink& sink, float radius, uint32 sliceCount, uint32 stackCount)
+{
+	//
+	// Compute the vertices stating at the top pole and moving down the stacks.
+	//
+
+	// Poles: note that there will be texture coordinate distortion as there is
+	// not a unique point on the texture map to assign to the pole when mapping
+	// a rectangular texture onto a sphere.
+	Vertex topVertex(0.0f, +radius, 0.0f, 0.0f, +1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+	Vertex bottomVertex(0.0f, -radius, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+	float phiStep   = DirectX::XM_PI/stackCount;
+	float thetaStep = 2.0f*DirectX::XM_PI/sliceCount;
+
+    // Add one because we duplicate the first and last vertex per ring
+	// since the texture coordinates are different.
+    uint32 ringVertexCount = sliceCount + 1;
+	uint32 ringCount = stackCount - 1;
+
+	// 정점/인덱스 수를 미리 알고 있으므로 링마다 자기 자리에 쓴다. (링끼리 독립이라 병렬)
+	const uint32 vertexCount = 2 + ringCount*ringVertexCount;
+	const uint32 indexCount = 6*sliceCount*ringCount;
+	sink.Begin(vertexCount, indexCount);
+
+	sink.WriteVertex(0, topVertex);
+	sink.WriteVertex(vertexCount - 1, bottomVertex);
+
+	std::vector<float> sines, cosines;
+	BuildSinCosTable(sliceCount, thetaStep, sines, cosines);
+
+	// Compute vertices for each stack ring (do not count the poles as rings).
+	const uint32 ringBatch = std::max<uint32>(ParallelBatchVertices / ringVertexCount, 1);
+	ParallelFor(ringCount, ringBatch, [&](uint32 ring)
+	{
+		uint32 i = ring + 1;
+		float phi = i*phiStep;
+		float sinPhi, cosPhi;
+		DirectX::XMScalarSinCos(&sinPhi, &cosPhi, phi);
+
+		const uint32 base = 1 + ring*ringVertexCount;
+
+		// Vertices of ring.
+        for(uint32 j = 0; j <= sliceCount; ++j)
+		{
+			Vertex v;
+
+			// spherical to cartesian (normal = position / radius)
+			v.Normal = DirectX::XMFLOAT3(sinPhi*cosines[j], cosPhi, sinPhi*sines[j]);
+			v.Position = DirectX::XMFLOAT3(radius*v.Normal.x, radius*v.Normal.y, radius*v.Normal.z);
+
+			// Partial derivative of P with respect to theta, normalized (sin(phi) > 0 off the poles).
+			v.TangentU = DirectX::XMFLOAT3(-sines[j], 0.0f, cosines[j]);
+
+			v.TexC.x = j*thetaStep / DirectX::XM_2PI;
+			v.TexC.y = phi / DirectX::XM_PI;
+
+			sink.WriteVertex(base + j, v);
+		}
+	});
+
+	//
+	// Compute indices for top stack.  The top stack was written first to the vertex buffer
+	// and connects the top pole to the first ring.
+	//
+
+	uint32 k = 0;
+    for(uint32 i = 1; i <= sliceCount; ++i)
+	{
+		sink.WriteIndex(k++, 0);
+		sink.WriteIndex(k++, i+1);
+		sink.WriteIndex(k++, i);
+	}
+
+	//
+	// Compute indices for inner stacks (not connected to poles).
+	//
+
+	// Offset the indices to the index of the first vertex in the first ring.
+	// This is just skipping the top pole vertex.
+    uint32 baseIndex = 1;
+	const uint32 innerStart = k;
+	const uint32 innerStackCount = ringCount > 0 ? ringCount - 1 : 0;
+	const uint32 stackBatch = std::max<uint32>(ParallelBatchVertices / sliceCount, 1);
+	ParallelFor(innerStackCount, stackBatch, [&](uint32 i)
+	{
+		uint32 q = innerStart + i*sliceCount*6;
+		for(uint32 j = 0; j < sliceCount; ++j)
+		{
+			sink.WriteIndex(q++, baseIndex + i*ringVertexCount + j);
+			sink.WriteIndex(q++, baseIndex + i*ringVertexCount + j+1);
+			sink.WriteIndex(q++, baseIndex + (i+1)*ringVertexCount + j);
+
+			sink.WriteIndex(q++, baseIndex + (i+1)*ringVertexCount + j);
+			sink.WriteIndex(q++, baseIndex + i*ringVertexCount + j+1);
+			sink.WriteIndex(q++, baseIndex + (i+1)*ringVertexCount + j+1);
+		}
+	});
+	k += innerStackCount*sliceCount*6;
+
+	//
+	// Compute indices for bottom stack.  The bottom stack was written last to the vertex buffer
+	// and connects the bottom pole to the bottom ring.
+	//
+
+	// South pole vertex was added last.
+	uint32 southPoleIndex = vertexCount-1;
+
+	// Offset the indices to the index of the first vertex in the last ring.
+	baseIndex = southPoleIndex - ringVertexCount;
+
+	for(uint32 i = 0; i < sliceCount; ++i)
+	{
+		sink.WriteIndex(k++, southPoleIndex);
+		sink.WriteIndex(k++, baseIndex+i);
+		sink.WriteIndex(k++, baseIndex+i+1);
+	}
+	assert(k == indexCount);
+}
+
+template<typename TSink>
+void GeometryGenerator::CreateGeosphere(TSink& sink, float radius, uint32 numSubdivisions)
+{
+	using namespace DirectX;
+
+	const MeshData meshData = CreateSubdividedIcosahedron(numSubdivisions);
+
+	const uint32 vertexCount = (uint32)meshData.Vertices.size();
+	const uint32 indexCount = (uint32)meshData.Indices32.size();
+	sink.Begin(vertexCount, indexCount);
+
+	// Project vertices onto sphere and scale.
+	// 네 정점씩 묶어서 atan2/acos/sincos를 벡터 함수로 한 번에 계산한다.
+	const uint32 batchCount = (vertexCount + ParallelBatchVertices - 1) / ParallelBatchVertices;
+	ParallelFor(batchCount, 1, [&](uint32 batch)
+	{
+		const uint32 end = std::min<uint32>((batch + 1)*ParallelBatchVertices, vertexCount);
+		for(uint32 i = batch*ParallelBatchVertices; i < end; i += 4)
+		{
+			const uint32 count = std::min<uint32>(end - i, 4);
+
+			// Project onto unit sphere.
+			XMFLOAT4 x, y, z;
+			float* xs = &x.x;
+			float* ys = &y.x;
+			float* zs = &z.x;
+			for(uint32 lane = 0; lane < 4; ++lane)
+			{
+				const Vertex& v = meshData.Vertices[i + std::min<uint32>(lane, count - 1)];
+				XMFLOAT3 n;
+				XMStoreFloat3(&n, XMVector3Normalize(XMLoadFloat3(&v.Position)));
+				xs[lane] = n.x;
+				ys[lane] = n.y;
+				zs[lane] = n.z;
+			}
+
+			// Derive texture coordinates from spherical coordinates.
+			// theta는 [0, 2pi]로 옮긴다.
+			XMVECTOR theta = XMVectorATan2(XMLoadFloat4(&z), XMLoadFloat4(&x));
+			theta = XMVectorSelect(theta, XMVectorAdd(theta, XMVectorReplicate(XM_2PI)), XMVectorLess(theta, XMVectorZero()));
+			XMVECTOR phi = XMVectorACos(XMVectorClamp(XMLoadFloat4(&y), XMVectorReplicate(-1.0f), XMVectorReplicate(1.0f)));
+
+			// Partial derivative of P with respect to theta, normalized = (-sin(theta), 0, cos(theta))
+			// 극점에서도 길이가 0이 되지 않는다.
+			XMVECTOR sinTheta, cosTheta;
+			XMVectorSinCos(&sinTheta, &cosTheta, theta);
+
+			XMFLOAT4 u, w, ts, tc;
+			XMStoreFloat4(&u, XMVectorScale(theta, 1.0f/XM_2PI));
+			XMStoreFloat4(&w, XMVectorScale(phi, 1.0f/XM_PI));
+			XMStoreFloat4(&ts, sinTheta);
+			XMStoreFloat4(&tc, cosTheta);
+			const float* us = &u.x;
+			const float* ws = &w.x;
+			const float* sines = &ts.x;
+			const float* cosines = &tc.x;
+
+			for(uint32 lane = 0; lane < count; ++lane)
+			{
+				Vertex v;
+
+				// Project onto sphere.
+				v.Normal = XMFLOAT3(xs[lane], ys[lane], zs[lane]);
+				v.Position = XMFLOAT3(radius*xs[lane], radius*ys[lane], radius*zs[lane]);
+
+				v.TexC.x = us[lane];
+				v.TexC.y = ws[lane];
+
+				v.TangentU = XMFLOAT3(-sines[lane], 0.0f, cosines[lane]);
+
+				sink.WriteVertex(i + lane, v);
+			}
+		}
+	});
+
+	for(uint32 i = 0; i < indexCount; ++i)
+		sink.WriteIndex(i, meshData.Indices32[i]);
+}
+
+template<typename TSink>
+void GeometryGenerator::CreateCylinder(TSink& sink, float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount)
+{
+	using namespace DirectX;
+
+	//
+	// Build Stacks.
+	//
+
+	float stackHeight = height / stackCount;
+
+	// Amount to increment radius as we move up each stack level from bottom to top.
+	float radiusStep = (topRadius - bottomRadius) / stackCount;
+
+	uint32 ringCount = stackCount+1;
+
+	// Add one because we duplicate the first and last vertex per ring
+	// since the texture coordinates are different.
+	uint32 ringVertexCount = sliceCount+1;
+
+	// 옆면 링 다음에 뚜껑 두 개 (링 + 중심)
+	const uint32 sideVertexCount = ringCount*ringVertexCount;
+	const uint32 sideIndexCount = 6*sliceCount*stackCount;
+	const uint32 capVertexCount = ringVertexCount + 1;
+	const uint32 capIndexCount = 3*sliceCount;
+	sink.Begin(sideVertexCount + 2*capVertexCount, sideIndexCount + 2*capIndexCount);
+
+	float dTheta = 2.0f*XM_PI/sliceCount;
+	std::vector<float> sines, cosines;
+	BuildSinCosTable(sliceCount, dTheta, sines, cosines);
+
+	// 법선은 링과 상관없이 각도로만 정해진다.
+	//
+	// Cylinder can be parameterized as follows, where we introduce v
+	// parameter that goes in the same direction as the v tex-coord
+	// so that the bitangent goes in the same direction as the v tex-coord.
+	//   Let r0 be the bottom radius and let r1 be the top radius.
+	//   y(v) = h - hv for v in [0,1].
+	//   r(v) = r1 + (r0-r1)v
+	//
+	//   x(t, v) = r(v)*cos(t)
+	//   y(t, v) = h - hv
+	//   z(t, v) = r(v)*sin(t)
+	//
+	//  dx/dt = -r(v)*sin(t)
+	//  dy/dt = 0
+	//  dz/dt = +r(v)*cos(t)
+	//
+	//  dx/dv = (r0-r1)*cos(t)
+	//  dy/dv = -h
+	//  dz/dv = (r0-r1)*sin(t)
+	std::vector<XMFLOAT3> normals(ringVertexCount);
+	float dr = bottomRadius-topRadius;
+	for(uint32 j = 0; j <= sliceCount; ++j)
+	{
+		XMVECTOR T = XMVectorSet(-sines[j], 0.0f, cosines[j], 0.0f);
+		XMVECTOR B = XMVectorSet(dr*cosines[j], -height, dr*sines[j], 0.0f);
+		XMStoreFloat3(&normals[j], XMVector3Normalize(XMVector3Cross(T, B)));
+	}
+
+	// Compute vertices for each stack ring starting at the bottom and moving up.
+	const uint32 ringBatch = std::max<uint32>(ParallelBatchVertices / ringVertexCount, 1);
+	ParallelFor(ringCount, ringBatch, [&](uint32 i)
+	{
+		float y = -0.5f*height + i*stackHeight;
+		float r = bottomRadius + i*radiusStep;
+
+		// vertices of ring
+		for(uint32 j = 0; j <= sliceCount; ++j)
+		{
+			float c = cosines[j];
+			float s = sines[j];
+
+			Vertex v;
+			v.Position = XMFLOAT3(r*c, y, r*s);
+
+			v.TexC.x = (float)j/sliceCount;
+			v.TexC.y = 1.0f - (float)i/stackCount;
+
+			// This is unit length.
+			v.TangentU = XMFLOAT3(-s, 0.0f, c);
+			v.Normal = normals[j];
+
+			sink.WriteVertex(i*ringVertexCount + j, v);
+		}
+	});
+
+	// Compute indices for each stack.
+	const uint32 stackBatch = std::max<uint32>(ParallelBatchVertices / sliceCount, 1);
+	ParallelFor(stackCount, stackBatch, [&](uint32 i)
+	{
+		uint32 k = i*sliceCount*6;
+		for(uint32 j = 0; j < sliceCount; ++j)
+		{
+			sink.WriteIndex(k++, i*ringVertexCount + j);
+			sink.WriteIndex(k++, (i+1)*ringVertexCount + j);
+			sink.WriteIndex(k++, (i+1)*ringVertexCount + j+1);
+
+			sink.WriteIndex(k++, i*ringVertexCount + j);
+			sink.WriteIndex(k++, (i+1)*ringVertexCount + j+1);
+			sink.WriteIndex(k++, i*ringVertexCount + j+1);
+		}
+	});
+
+	BuildCylinderTopCap(sink, topRadius, height, sliceCount, sines, cosines, sideVertexCount, sideIndexCount);
+	BuildCylinderBottomCap(sink, bottomRadius, height, sliceCount, sines, cosines,
+		sideVertexCount + capVertexCount, sideIndexCount + capIndexCount);
+}
+
+template<typename TSink>
+void GeometryGenerator::BuildCylinderTopCap(TSink& sink, float topRadius, float height, uint32 sliceCount,
+											const std::vector<float>& sines, const std::vector<float>& cosines, uint32 baseVertex, uint32 baseIndex)
+{
+	float y = 0.5f*height;
+
+	// Duplicate cap ring vertices because the texture coordinates and normals differ.
+	for(uint32 i = 0; i <= sliceCount; ++i)
+	{
+		float x = topRadius*cosines[i];
+		float z = topRadius*sines[i];
+
+		// Scale down by the height to try and make top cap texture coord area
+		// proportional to base.
+		float u = x/height + 0.5f;
+		float v = z/height + 0.5f;
+
+		sink.WriteVertex(baseVertex + i, Vertex(x, y, z, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, u, v));
+	}
+
+	// Cap center vertex.
+	uint32 centerIndex = baseVertex + sliceCount + 1;
+	sink.WriteVertex(centerIndex, Vertex(0.0f, y, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.5f, 0.5f));
+
+	uint32 k = baseIndex;
+	for(uint32 i = 0; i < sliceCount; ++i)
+	{
+		sink.WriteIndex(k++, centerIndex);
+		sink.WriteIndex(k++, baseVertex + i+1);
+		sink.WriteIndex(k++, baseVertex + i);
+	}
+}
+
+template<typename TSink>
+void GeometryGenerator::BuildCylinderBottomCap(TSink& sink, float bottomRadius, float height, uint32 sliceCount,
+											   const std::vector<float>& sines, const std::vector<float>& cosines, uint32 baseVertex, uint32 baseIndex)
+{
+	//
+	// Build bottom cap.
+	//
+
+	float y = -0.5f*height;
+
+	// vertices of ring
+	for(uint32 i = 0; i <= sliceCount; ++i)
+	{
+		float x = bottomRadius*cosines[i];
+		float z = bottomRadius*sines[i];
+
+		// Scale down by the height to try and make top cap texture coord area
+		// proportional to base.
+		float u = x/height + 0.5f;
+		float v = z/height + 0.5f;
+
+		sink.WriteVertex(baseVertex + i, Vertex(x, y, z, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, u, v));
+	}
+
+	// Cap center vertex.
+	uint32 centerIndex = baseVertex + sliceCount + 1;
+	sink.WriteVertex(centerIndex, Vertex(0.0f, y, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.5f, 0.5f));
+
+	uint32 k = baseIndex;
+	for(uint32 i = 0; i < sliceCount; ++i)
+	{
+		sink.WriteIndex(k++, centerIndex);
+		sink.WriteIndex(k++, baseVertex + i);
+		sink.WriteIndex(k++, baseVertex + i+1);
+	}
+}
+
+template<typename TSink>
+void GeometryGenerator::CreateGrid(TSink& sink, float width, float depth, uint32 m, uint32 n)
+{
+	uint32 vertexCount = m*n;
+	uint32 faceCount   = (m-1)*(n-1)*2;
+
+	sink.Begin(vertexCount, faceCount*3); // 3 indices per face
+
+	//
+	// Create the vertices.
+	//
+
+	float halfWidth = 0.5f*width;
+	float halfDepth = 0.5f*depth;
+
+	float dx = width / (n-1);
+	float dz = depth / (m-1);
+
+	float du = 1.0f / (n-1);
+	float dv = 1.0f / (m-1);
+
+	// 행끼리 독립이므로 행 단위로 나눠서 쓴다.
+	const uint32 rowBatch = std::max<uint32>(ParallelBatchVertices / n, 1);
+
+	ParallelFor(m, rowBatch, [&](uint32 i)
+	{
+		float z = halfDepth - i*dz;
+		for(uint32 j = 0; j < n; ++j)
+		{
+			float x = -halfWidth + j*dx;
+
+			// Stretch texture over grid.
+			sink.WriteVertex(i*n+j, Vertex(x, 0.0f, z, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, j*du, i*dv));
+		}
+	});
+
+    //
+	// Create the indices.
+	//
+
+	// Iterate over each quad and compute indices.
+	ParallelFor(m-1, rowBatch, [&](uint32 i)
+	{
+		uint32 k = i*(n-1)*6;
+		for(uint32 j = 0; j < n-1; ++j)
+		{
+			sink.WriteIndex(k,   i*n+j);
+			sink.WriteIndex(k+1, i*n+j+1);
+			sink.WriteIndex(k+2, (i+1)*n+j);
+
+			sink.WriteIndex(k+3, (i+1)*n+j);
+			sink.WriteIndex(k+4, i*n+j+1);
+			sink.WriteIndex(k+5, (i+1)*n+j+1);
+
+			k += 6; // next quad
+		}
+	});
+}
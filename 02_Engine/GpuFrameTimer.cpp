@@ -0,0 +1,65 @@
+#include "GpuFrameTimer.h"
+
+using Microsoft::WRL::ComPtr;
+
+GpuFrameTimer::~GpuFrameTimer()
+{
+    if (mReadback != nullptr)
+        mReadback->Unmap(0, nullptr);
+}
+
+void GpuFrameTimer::Initialize(ID3D12Device* device, ID3D12CommandQueue* queue, UINT frameCount)
+{
+    const UINT queryCount = frameCount * 2;
+
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    queryHeapDesc.Count = queryCount;
+    ThrowIfFailed(device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&mQueryHeap)));
+
+    CD3DX12_HEAP_PROPERTIES readbackHeap(D3D12_HEAP_TYPE_READBACK);
+    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(UINT64) * queryCount);
+    ThrowIfFailed(device->CreateCommittedResource(
+        &readbackHeap,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(&mReadback)));
+
+    // 리드백 버퍼는 계속 매핑해 둔다. (GPU가 쓰는 동안 해당 슬롯은 읽지 않는다)
+    ThrowIfFailed(mReadback->Map(0, nullptr, reinterpret_cast<void**>(&mMappedData)));
+
+    UINT64 frequency = 0;
+    ThrowIfFailed(queue->GetTimestampFrequency(&frequency));
+    mTicksToMs = 1000.0 / (double)frequency;
+
+    mIsRecorded.assign(frameCount, 0);
+}
+
+void GpuFrameTimer::Begin(ID3D12GraphicsCommandList* cmdList, UINT frame)
+{
+    cmdList->EndQuery(mQueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, frame * 2);
+}
+
+void GpuFrameTimer::End(ID3D12GraphicsCommandList* cmdList, UINT frame)
+{
+    cmdList->EndQuery(mQueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, frame * 2 + 1);
+    cmdList->ResolveQueryData(mQueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, frame * 2, 2, mReadback.Get(), sizeof(UINT64) * frame * 2);
+    mIsRecorded[frame] = 1;
+}
+
+bool GpuFrameTimer::ReadFrameMs(UINT frame, float& frameMs)
+{
+    if (!mIsRecorded[frame])
+        return false;
+    mIsRecorded[frame] = 0;
+
+    const UINT64 begin = mMappedData[frame * 2];
+    const UINT64 end = mMappedData[frame * 2 + 1];
+    if (end <= begin)
+        return false;
+
+    frameMs = (float)((end - begin) * mTicksToMs);
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "d3dUtil.h"
+
+// 타임스탬프 쿼리로 재는 프레임별 GPU 시간
+// 프레임 슬롯마다 시작/끝 쿼리 두 개를 쓰고, 끝날 때 리드백 버퍼로 복사해 둔다.
+// 결과는 그 슬롯의 펜스가 끝난 뒤에 읽는다. (같은 슬롯을 다시 기록하기 전)
+class GpuFrameTimer
+{
+public:
+    GpuFrameTimer() = default;
+    GpuFrameTimer(const GpuFrameTimer& rhs) = delete;
+    GpuFrameTimer& operator=(const GpuFrameTimer& rhs) = delete;
+    ~GpuFrameTimer();
+
+    // queue : 타임스탬프 주기를 얻을 커맨드 큐 (측정할 커맨드 리스트를 실행하는 큐)
+    void Initialize(ID3D12Device* device, ID3D12CommandQueue* queue, UINT frameCount);
+
+    // 커맨드 리스트 처음과 마지막(Close 전)에 기록
+    void Begin(ID3D12GraphicsCommandList* cmdList, UINT frame);
+    void End(ID3D12GraphicsCommandList* cmdList, UINT frame);
+
+    // frame 슬롯에서 마지막으로 잰 GPU 시간 (ms). 아직 결과가 없거나 이미 읽었으면 false
+    bool ReadFrameMs(UINT frame, float& frameMs);
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12QueryHeap> mQueryHeap;
+    Microsoft::WRL::ComPtr<ID3D12Resource> mReadback;
+    UINT64* mMappedData = nullptr;
+
+    double mTicksToMs = 0.0;
+    std::vector<UINT8> mIsRecorded;     // 슬롯마다 아직 읽지 않은 결과가 있는지
+};
@@ -0,0 +1,336 @@
+#include "GpuMemoryAllocator.h"
+#include <atomic>
+#include <cstdio>
+
+using Microsoft::WRL::ComPtr;
+
+// 리소스에 붙이는 할당 토큰의 private data GUID
+static const GUID kAllocationTokenGuid = { 0x6c9a3f7e, 0x2d41, 0x4b8a, { 0x9e, 0x13, 0x5f, 0x0c, 0x8d, 0x72, 0xa4, 0x3b } };
+
+class GpuMemoryAllocator::AllocationToken : public IUnknown
+{
+public:
+    AllocationToken(const std::shared_ptr<Pool>& pool, HeapBlock* block, const TlsfAllocator::Allocation& allocation)
+        : mPool(pool), mBlock(block), mAllocation(allocation) {}
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+    {
+        if (object == nullptr)
+            return E_POINTER;
+
+        if (riid == __uuidof(IUnknown))
+        {
+            *object = static_cast<IUnknown*>(this);
+            AddRef();
+            return S_OK;
+        }
+
+        *object = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override
+    {
+        return ++mRefCount;
+    }
+
+    // 리소스가 해제되면서 private data를 놓을 때 자리를 돌려준다.
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        ULONG refCount = --mRefCount;
+        if (refCount == 0)
+        {
+            mPool->Free(mBlock, mAllocation);
+            delete this;
+        }
+        return refCount;
+    }
+
+private:
+    std::atomic<ULONG> mRefCount{ 1 };
+
+    std::shared_ptr<Pool> mPool;
+    HeapBlock* mBlock = nullptr;
+    TlsfAllocator::Allocation mAllocation;
+};
+
+void GpuMemoryAllocator::Pool::Free(HeapBlock* block, const TlsfAllocator::Allocation& allocation)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    block->Allocator.Free(allocation);
+}
+
+GpuMemoryAllocator::~GpuMemoryAllocator()
+{
+    // 아직 살아있는 리소스가 있으면 토큰이 풀을 붙잡고 있으므로 여기서는 참조만 놓는다.
+}
+
+void GpuMemoryAllocator::Initialize(ID3D12Device* device, UINT64 blockSize)
+{
+    md3dDevice = device;
+    mBlockSize = blockSize;
+
+    const D3D12_HEAP_TYPE heapTypes[] = { D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_TYPE_READBACK };
+    for (int t = 0; t < 3; ++t)
+    {
+        for (int c = 0; c < (int)GpuMemoryCategory::Count; ++c)
+        {
+            mPools[t][c] = std::make_shared<Pool>();
+            mPools[t][c]->HeapType = heapTypes[t];
+            mPools[t][c]->Category = (GpuMemoryCategory)c;
+        }
+    }
+}
+
+ComPtr<ID3D12Resource> GpuMemoryAllocator::CreateBuffer(
+    D3D12_HEAP_TYPE heapType,
+    UINT64 byteSize,
+    D3D12_RESOURCE_STATES initialState,
+    D3D12_RESOURCE_FLAGS flags)
+{
+    CD3DX12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(byteSize, flags);
+    return CreateResource(heapType, desc, initialState, nullptr);
+}
+
+ComPtr<ID3D12Resource> GpuMemoryAllocator::CreateResource(
+    D3D12_HEAP_TYPE heapType,
+    const D3D12_RESOURCE_DESC& desc,
+    D3D12_RESOURCE_STATES initialState,
+    const D3D12_CLEAR_VALUE* clearValue)
+{
+    GpuMemoryCategory category = GetCategory(desc);
+
+    // 작은 텍스처는 4KB 정렬을 시도 (안 되면 기본 64KB)
+    D3D12_RESOURCE_DESC placedDesc = desc;
+    D3D12_RESOURCE_ALLOCATION_INFO info = {};
+    if (category == GpuMemoryCategory::Texture && placedDesc.SampleDesc.Count <= 1)
+    {
+        placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+        info = md3dDevice->GetResourceAllocationInfo(0, 1, &placedDesc);
+        if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+            placedDesc.Alignment = 0;
+    }
+    if (placedDesc.Alignment == 0)
+        info = md3dDevice->GetResourceAllocationInfo(0, 1, &placedDesc);
+
+    if (info.SizeInBytes == UINT64_MAX)
+        ThrowIfFailed(E_INVALIDARG);
+
+    std::shared_ptr<Pool>& pool = GetPool(heapType, category);
+    std::lock_guard<std::mutex> lock(pool->Mutex);
+
+    // 기존 블록에서 자리 찾기
+    HeapBlock* block = nullptr;
+    TlsfAllocator::Allocation allocation;
+    for (auto& candidate : pool->Blocks)
+    {
+        // 힙 정렬은 생성할 때 정해지므로 MSAA(4MB 정렬) 리소스는 MSAA 정렬 블록에만 놓을 수 있다.
+        if (candidate->Alignment < info.Alignment)
+            continue;
+
+        allocation = candidate->Allocator.Allocate(info.SizeInBytes, info.Alignment);
+        if (allocation.IsValid())
+        {
+            block = candidate.get();
+            break;
+        }
+    }
+
+    // 없으면 새 블록 (큰 리소스는 전용 블록)
+    if (block == nullptr)
+    {
+        const UINT64 heapAlignment = GetHeapAlignment(category, info.Alignment);
+        UINT64 heapSize = std::max<UINT64>(mBlockSize, info.SizeInBytes);
+        heapSize = (heapSize + heapAlignment - 1) / heapAlignment * heapAlignment;
+
+        D3D12_HEAP_DESC heapDesc = {};
+        heapDesc.SizeInBytes = heapSize;
+        heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(heapType);
+        heapDesc.Alignment = heapAlignment;
+        heapDesc.Flags = GetHeapFlags(category);
+
+        auto newBlock = std::make_unique<HeapBlock>();
+        ThrowIfFailed(md3dDevice->CreateHeap(&heapDesc, IID_PPV_ARGS(&newBlock->Heap)));
+        newBlock->Allocator.Initialize(heapSize);
+        newBlock->Alignment = heapAlignment;
+
+        allocation = newBlock->Allocator.Allocate(info.SizeInBytes, info.Alignment);
+        block = newBlock.get();
+        pool->Blocks.push_back(std::move(newBlock));
+    }
+
+    ComPtr<ID3D12Resource> resource;
+    HRESULT hr = md3dDevice->CreatePlacedResource(
+        block->Heap.Get(),
+        allocation.Offset,
+        &placedDesc,
+        initialState,
+        clearValue,
+        IID_PPV_ARGS(&resource));
+    if (FAILED(hr))
+    {
+        block->Allocator.Free(allocation);
+        ThrowIfFailed(hr);
+    }
+
+    // 리소스가 해제될 때 토큰도 함께 해제되면서 자리를 돌려준다.
+    AllocationToken* token = new AllocationToken(pool, block, allocation);
+    hr = resource->SetPrivateDataInterface(kAllocationTokenGuid, token);
+    token->Release();
+    ThrowIfFailed(hr);
+
+    return resource;
+}
+
+void GpuMemoryAllocator::Trim()
+{
+    for (auto& pools : mPools)
+    {
+        for (auto& pool : pools)
+        {
+            if (pool == nullptr)
+                continue;
+
+            std::lock_guard<std::mutex> lock(pool->Mutex);
+
+            bool isEmptyKept = false;
+            auto it = std::remove_if(pool->Blocks.begin(), pool->Blocks.end(), [&isEmptyKept](const std::unique_ptr<HeapBlock>& block)
+            {
+                if (!block->Allocator.IsEmpty())
+                    return false;
+
+                if (!isEmptyKept)
+                {
+                    isEmptyKept = true;
+                    return false;
+                }
+                return true;
+            });
+            pool->Blocks.erase(it, pool->Blocks.end());
+        }
+    }
+}
+
+std::vector<GpuMemoryPoolStats> GpuMemoryAllocator::GetStats()
+{
+    std::vector<GpuMemoryPoolStats> result;
+
+    for (auto& pools : mPools)
+    {
+        for (auto& pool : pools)
+        {
+            if (pool == nullptr)
+                continue;
+
+            std::lock_guard<std::mutex> lock(pool->Mutex);
+            if (pool->Blocks.empty())
+                continue;
+
+            GpuMemoryPoolStats stats;
+            stats.HeapType = pool->HeapType;
+            stats.Category = pool->Category;
+            stats.BlockCount = (UINT)pool->Blocks.size();
+
+            for (auto& block : pool->Blocks)
+            {
+                TlsfAllocator::Stats blockStats = block->Allocator.GetStats();
+                stats.Memory.TotalSize += blockStats.TotalSize;
+                stats.Memory.UsedSize += blockStats.UsedSize;
+                stats.Memory.FreeSize += blockStats.FreeSize;
+                stats.Memory.AllocationCount += blockStats.AllocationCount;
+                stats.Memory.FreeBlockCount += blockStats.FreeBlockCount;
+                stats.Memory.LargestFreeBlock = std::max<std::uint64_t>(stats.Memory.LargestFreeBlock, blockStats.LargestFreeBlock);
+            }
+
+            result.push_back(stats);
+        }
+    }
+
+    return result;
+}
+
+std::string GpuMemoryAllocator::GetStatsString()
+{
+    std::string out = "GpuMemoryAllocator\n";
+    char line[256];
+
+    for (const GpuMemoryPoolStats& stats : GetStats())
+    {
+        snprintf(line, sizeof(line),
+            "  %-8s %-12s blocks %2u  allocs %5u  used %8.2f / %8.2f MB (%5.1f%%)  fragmentation %5.1f%%\n",
+            GetHeapTypeName(stats.HeapType),
+            GetCategoryName(stats.Category),
+            stats.BlockCount,
+            stats.Memory.AllocationCount,
+            stats.Memory.UsedSize / (1024.0 * 1024.0),
+            stats.Memory.TotalSize / (1024.0 * 1024.0),
+            stats.Memory.Utilization() * 100.0,
+            stats.Memory.Fragmentation() * 100.0);
+        out += line;
+    }
+
+    return out;
+}
+
+GpuMemoryCategory GpuMemoryAllocator::GetCategory(const D3D12_RESOURCE_DESC& desc)
+{
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        return GpuMemoryCategory::Buffer;
+
+    if (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+        return GpuMemoryCategory::RenderTarget;
+
+    return GpuMemoryCategory::Texture;
+}
+
+D3D12_HEAP_FLAGS GpuMemoryAllocator::GetHeapFlags(GpuMemoryCategory category)
+{
+    switch (category)
+    {
+    case GpuMemoryCategory::Buffer:         return D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    case GpuMemoryCategory::Texture:        return D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+    case GpuMemoryCategory::RenderTarget:   return D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    default:                                return D3D12_HEAP_FLAG_NONE;
+    }
+}
+
+// RT/DS 블록은 MSAA 리소스도 받을 수 있게 항상 MSAA 정렬로 만든다. (일반 RT/DS도 같은 블록을 같이 쓴다)
+UINT64 GpuMemoryAllocator::GetHeapAlignment(GpuMemoryCategory category, UINT64 resourceAlignment)
+{
+    if (category == GpuMemoryCategory::RenderTarget || resourceAlignment > D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT)
+        return D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+    return D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+}
+
+const char* GpuMemoryAllocator::GetHeapTypeName(D3D12_HEAP_TYPE heapType)
+{
+    switch (heapType)
+    {
+    case D3D12_HEAP_TYPE_DEFAULT:   return "DEFAULT";
+    case D3D12_HEAP_TYPE_UPLOAD:    return "UPLOAD";
+    case D3D12_HEAP_TYPE_READBACK:  return "READBACK";
+    default:                        return "CUSTOM";
+    }
+}
+
+const char* GpuMemoryAllocator::GetCategoryName(GpuMemoryCategory category)
+{
+    switch (category)
+    {
+    case GpuMemoryCategory::Buffer:         return "Buffer";
+    case GpuMemoryCategory::Texture:        return "Texture";
+    case GpuMemoryCategory::RenderTarget:   return "RenderTarget";
+    default:                                return "";
+    }
+}
+
+std::shared_ptr<GpuMemoryAllocator::Pool>& GpuMemoryAllocator::GetPool(D3D12_HEAP_TYPE heapType, GpuMemoryCategory category)
+{
+    int t = 0;
+    if (heapType == D3D12_HEAP_TYPE_UPLOAD)
+        t = 1;
+    else if (heapType == D3D12_HEAP_TYPE_READBACK)
+        t = 2;
+
+    return mPools[t][(int)category];
+}
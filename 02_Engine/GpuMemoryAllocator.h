@@ -0,0 +1,95 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/TlsfAllocator.h"
+#include <mutex>
+
+// 힙 종류 (Resource Heap Tier 1에서도 동작하도록 버퍼/텍스처/RT·DS 텍스처 힙을 나눈다)
+enum class GpuMemoryCategory
+{
+    Buffer,
+    Texture,
+    RenderTarget,
+    Count
+};
+
+// 풀 하나의 통계
+struct GpuMemoryPoolStats
+{
+    D3D12_HEAP_TYPE HeapType = D3D12_HEAP_TYPE_DEFAULT;
+    GpuMemoryCategory Category = GpuMemoryCategory::Buffer;
+    UINT BlockCount = 0;
+    TlsfAllocator::Stats Memory;    // 블록 전체 합계 (LargestFreeBlock은 블록 중 최대)
+};
+
+// 큰 ID3D12Heap 블록을 미리 잡아두고 TLSF로 나눠서 Placed Resource를 만드는 할당기
+// 반환한 리소스가 해제되면 (마지막 ComPtr가 Release되면) 자리도 자동으로 돌려받는다.
+// 따라서 호출하는 쪽은 CreateCommittedResource로 만든 리소스와 똑같이 다루면 된다.
+class GpuMemoryAllocator
+{
+public:
+    GpuMemoryAllocator() = default;
+    GpuMemoryAllocator(const GpuMemoryAllocator& rhs) = delete;
+    GpuMemoryAllocator& operator=(const GpuMemoryAllocator& rhs) = delete;
+    ~GpuMemoryAllocator();
+
+    // blockSize : 힙 블록 하나의 크기 (이보다 큰 리소스는 전용 블록을 만든다)
+    void Initialize(ID3D12Device* device, UINT64 blockSize = 64 * 1024 * 1024);
+
+    Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(
+        D3D12_HEAP_TYPE heapType,
+        UINT64 byteSize,
+        D3D12_RESOURCE_STATES initialState,
+        D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE);
+
+    Microsoft::WRL::ComPtr<ID3D12Resource> CreateResource(
+        D3D12_HEAP_TYPE heapType,
+        const D3D12_RESOURCE_DESC& desc,
+        D3D12_RESOURCE_STATES initialState,
+        const D3D12_CLEAR_VALUE* clearValue = nullptr);
+
+    // 빈 블록 반환 (빈 블록은 종류마다 하나만 남긴다)
+    void Trim();
+
+    std::vector<GpuMemoryPoolStats> GetStats();
+    std::string GetStatsString();
+
+    bool IsInitialized()const { return md3dDevice != nullptr; }
+
+private:
+    struct HeapBlock
+    {
+        Microsoft::WRL::ComPtr<ID3D12Heap> Heap;
+        TlsfAllocator Allocator;
+        UINT64 Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;   // 힙 생성 시 정렬 (이보다 큰 정렬의 리소스는 놓을 수 없다)
+    };
+
+    // 리소스의 private data로 붙어서, 리소스가 해제될 때 자리를 돌려준다.
+    class AllocationToken;
+
+    // 풀은 리소스보다 오래 살아야 하므로 shared_ptr로 토큰과 공유한다.
+    struct Pool
+    {
+        std::mutex Mutex;
+        D3D12_HEAP_TYPE HeapType = D3D12_HEAP_TYPE_DEFAULT;
+        GpuMemoryCategory Category = GpuMemoryCategory::Buffer;
+        std::vector<std::unique_ptr<HeapBlock>> Blocks;
+
+        void Free(HeapBlock* block, const TlsfAllocator::Allocation& allocation);
+    };
+
+    static GpuMemoryCategory GetCategory(const D3D12_RESOURCE_DESC& desc);
+    static D3D12_HEAP_FLAGS GetHeapFlags(GpuMemoryCategory category);
+    static UINT64 GetHeapAlignment(GpuMemoryCategory category, UINT64 resourceAlignment);
+    static const char* GetHeapTypeName(D3D12_HEAP_TYPE heapType);
+    static const char* GetCategoryName(GpuMemoryCategory category);
+
+    std::shared_ptr<Pool>& GetPool(D3D12_HEAP_TYPE heapType, GpuMemoryCategory category);
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+    UINT64 mBlockSize = 0;
+
+    // [힙 타입(DEFAULT, UPLOAD, READBACK)][종류]
+    std::shared_ptr<Pool> mPools[3][(int)GpuMemoryCategory::Count];
+};
@@ -0,0 +1,59 @@
+#include "GpuTimeline.h"
+
+void GpuTimeline::Initialize(ID3D12Device* device, UINT64 initialValue)
+{
+    ThrowIfFailed(device->CreateFence(initialValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mFence.Fence)));
+    mTimeline.Initialize(&mFence, initialValue);
+}
+
+UINT64 GpuTimeline::Signal(ID3D12CommandQueue* queue)
+{
+    UINT64 value = mTimeline.Advance();
+    ThrowIfFailed(queue->Signal(mFence.Fence.Get(), value));
+    return value;
+}
+
+void GpuTimeline::WaitIdle(ID3D12CommandQueue* queue)
+{
+    Wait(Signal(queue));
+}
+
+GpuTimeline::D3DFence::~D3DFence()
+{
+    for (HANDLE eventHandle : mAllEvents)
+        CloseHandle(eventHandle);
+}
+
+void GpuTimeline::D3DFence::WaitForValue(std::uint64_t value)
+{
+    HANDLE eventHandle = AcquireEvent();
+    ThrowIfFailed(Fence->SetEventOnCompletion(value, eventHandle));
+    WaitForSingleObject(eventHandle, INFINITE);
+    ReleaseEvent(eventHandle);
+}
+
+HANDLE GpuTimeline::D3DFence::AcquireEvent()
+{
+    std::lock_guard<std::mutex> lock(mEventMutex);
+
+    if (!mFreeEvents.empty())
+    {
+        HANDLE eventHandle = mFreeEvents.back();
+        mFreeEvents.pop_back();
+        return eventHandle;
+    }
+
+    // 자동 리셋 이벤트라서 대기가 끝나면 바로 다시 쓸 수 있다.
+    HANDLE eventHandle = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
+    if (eventHandle == nullptr)
+        ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
+
+    mAllEvents.push_back(eventHandle);
+    return eventHandle;
+}
+
+void GpuTimeline::D3DFence::ReleaseEvent(HANDLE eventHandle)
+{
+    std::lock_guard<std::mutex> lock(mEventMutex);
+    mFreeEvents.push_back(eventHandle);
+}
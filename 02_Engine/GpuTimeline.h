@@ -0,0 +1,60 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/FenceTimeline.h"
+#include <mutex>
+
+// 큐 하나의 펜스 타임라인
+// Signal()로 값을 올리고, 완료 여부 확인/대기를 한 곳에서 처리한다.
+// 값 관리는 FenceTimeline이 하고, 여기서는 D3D12 펜스와 대기 이벤트를 맡는다.
+// 대기용 이벤트는 매번 만들지 않고 풀에서 꺼내 쓴다.
+class GpuTimeline
+{
+public:
+    GpuTimeline() = default;
+    GpuTimeline(const GpuTimeline& rhs) = delete;
+    GpuTimeline& operator=(const GpuTimeline& rhs) = delete;
+
+    void Initialize(ID3D12Device* device, UINT64 initialValue = 0);
+
+    // queue에 다음 값을 Signal하고 그 값을 돌려준다.
+    UINT64 Signal(ID3D12CommandQueue* queue);
+
+    UINT64 GetLastSignaled()const { return mTimeline.GetLastSignaled(); }
+    UINT64 GetCompletedValue() { return mTimeline.GetCompletedValue(); }
+    bool IsComplete(UINT64 value) { return mTimeline.IsComplete(value); }
+
+    // CPU에서 value가 끝날 때까지 대기
+    void Wait(UINT64 value) { mTimeline.Wait(value); }
+
+    // 지금까지 제출한 모든 작업이 끝날 때까지 대기
+    void WaitIdle(ID3D12CommandQueue* queue);
+
+    ID3D12Fence* GetFence()const { return mFence.Fence.Get(); }
+
+private:
+    // D3D12 펜스 + 대기 이벤트 풀
+    class D3DFence : public ITimelineFence
+    {
+    public:
+        ~D3DFence();
+
+        std::uint64_t GetCompletedValue() override { return Fence->GetCompletedValue(); }
+        void WaitForValue(std::uint64_t value) override;
+
+        Microsoft::WRL::ComPtr<ID3D12Fence> Fence;
+
+    private:
+        HANDLE AcquireEvent();
+        void ReleaseEvent(HANDLE eventHandle);
+
+    private:
+        std::mutex mEventMutex;
+        std::vector<HANDLE> mFreeEvents;
+        std::vector<HANDLE> mAllEvents;
+    };
+
+private:
+    D3DFence mFence;
+    FenceTimeline mTimeline;
+};
@@ -0,0 +1,95 @@
+#include "IndexBufferBuilder.h"
+#include "../01_Core/IndexCodec.h"
+
+namespace
+{
+    using uint32 = IndexBufferBuilder::uint32;
+
+    const uint32 InvalidIndex = 0xFFFFFFFF;
+}
+
+void IndexBufferBuilder::Add(const std::vector<uint32>& indices, SubmeshGeometry& submesh)
+{
+    const uint32 stride = IndexCodec::GetIndexStride(IndexCodec::GetMaxIndex(indices.data(), indices.size()));
+
+    // 32비트 구간은 4바이트 경계에서 시작해야 StartIndexLocation으로 가리킬 수 있다.
+    size_t offset = mData.size();
+    if (offset % stride != 0)
+        offset += stride - offset % stride;
+
+    // 전체 크기도 4바이트 단위로 맞춰 두면 어느 형식으로 봐도 뷰 크기가 인덱스 크기의 배수가 된다.
+    size_t size = offset + indices.size() * stride;
+    mData.resize((size + 3) & ~(size_t)3, 0);
+    IndexCodec::Convert(indices.data(), indices.size(), mData.data() + offset, stride);
+
+    submesh.IndexCount = (UINT)indices.size();
+    submesh.StartIndexLocation = (UINT)(offset / stride);
+    submesh.IndexFormat = stride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
+    mSavedBytes += (UINT)indices.size() * (sizeof(uint32) - stride);
+}
+
+std::vector<IndexBufferBuilder::Part> IndexBufferBuilder::SplitForIndex16(GeometryGenerator::MeshData& mesh, uint32 maxVertices)
+{
+    const uint32 vertexCount = (uint32)mesh.Vertices.size();
+    if (vertexCount <= maxVertices)
+    {
+        Part part;
+        part.IndexCount = (uint32)mesh.Indices32.size();
+        part.VertexCount = vertexCount;
+        return { part };
+    }
+
+    std::vector<Part> parts;
+    std::vector<GeometryGenerator::Vertex> vertices;
+    std::vector<uint32> indices;
+    vertices.reserve(vertexCount);
+    indices.reserve(mesh.Indices32.size());
+
+    // partOf[v] : v가 마지막으로 들어간 조각, localIndex[v] : 그 조각 안 번호
+    std::vector<uint32> partOf(vertexCount, InvalidIndex);
+    std::vector<uint32> localIndex(vertexCount, 0);
+
+    Part part;
+    for (size_t i = 0; i + 2 < mesh.Indices32.size(); i += 3)
+    {
+        const uint32* triangle = &mesh.Indices32[i];
+        const uint32 partIndex = (uint32)parts.size();
+
+        uint32 newVertices = 0;
+        for (uint32 corner = 0; corner < 3; ++corner)
+        {
+            const uint32 v = triangle[corner];
+            const bool isRepeated = (corner > 0 && v == triangle[0]) || (corner > 1 && v == triangle[1]);
+            if (partOf[v] != partIndex && !isRepeated)
+                ++newVertices;
+        }
+
+        if (part.VertexCount + newVertices > maxVertices)
+        {
+            parts.push_back(part);
+            part = Part();
+            part.StartIndex = (uint32)indices.size();
+            part.BaseVertex = (uint32)vertices.size();
+        }
+
+        for (uint32 corner = 0; corner < 3; ++corner)
+        {
+            const uint32 v = triangle[corner];
+            if (partOf[v] != (uint32)parts.size())
+            {
+                partOf[v] = (uint32)parts.size();
+                localIndex[v] = part.VertexCount++;
+                vertices.push_back(mesh.Vertices[v]);
+            }
+            indices.push_back(localIndex[v]);
+        }
+        part.IndexCount += 3;
+    }
+    if (part.IndexCount > 0)
+        parts.push_back(part);
+
+    mesh.Vertices.swap(vertices);
+    mesh.Indices32.swap(indices);
+    return parts;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "GeometryGenerator.h"
+
+// 여러 서브메시의 인덱스 -> 인덱스 버퍼 하나 (서브메시마다 16/32비트를 따로 고른다)
+// 인덱스는 서브메시의 BaseVertexLocation 기준이라 정점 버퍼 전체가 커도 서브메시 하나의 정점이 65536개 이하면 16비트로 충분하다.
+// 한 버퍼에 16비트 구간과 32비트 구간이 섞이므로 StartIndexLocation은 그 서브메시의 인덱스 크기 단위로 센다. (32비트 구간은 4바이트 정렬)
+// 그릴 때는 MeshGeometry::IndexBufferView(submesh.IndexFormat)로 같은 버퍼를 그 형식으로 본다.
+class IndexBufferBuilder
+{
+public:
+    using uint32 = std::uint32_t;
+
+    // SplitForIndex16이 나눈 조각 (서브메시 하나로 그린다)
+    struct Part
+    {
+        uint32 StartIndex = 0;
+        uint32 IndexCount = 0;
+        uint32 BaseVertex = 0;
+        uint32 VertexCount = 0;
+    };
+
+public:
+    // indices를 버퍼 끝에 붙이고 submesh의 IndexCount / StartIndexLocation / IndexFormat을 채운다.
+    void Add(const std::vector<uint32>& indices, SubmeshGeometry& submesh);
+
+    const std::vector<std::uint8_t>& GetData()const { return mData; }
+    UINT GetByteSize()const { return (UINT)mData.size(); }
+
+    // 모두 32비트로 담았을 때보다 줄어든 바이트
+    UINT GetSavedBytes()const { return mSavedBytes; }
+
+    // 정점이 maxVertices개를 넘는 메시를 16비트 인덱스로 그릴 수 있는 조각으로 나눈다.
+    // 삼각형 순서대로 조각을 채우므로 정점 캐시 최적화를 먼저 하면 조각도 공간적으로 모인다.
+    // 조각 경계의 정점은 복제되고, mesh의 정점/인덱스가 조각 순서로 다시 배치된다. (인덱스는 조각의 BaseVertex 기준)
+    // 정점이 maxVertices개 이하면 mesh를 건드리지 않고 조각 하나를 돌려준다.
+    static std::vector<Part> SplitForIndex16(GeometryGenerator::MeshData& mesh, uint32 maxVertices = 65536);
+
+private:
+    std::vector<std::uint8_t> mData;
+    UINT mSavedBytes = 0;
+};
@@ -0,0 +1,1724 @@
+#include "MeshImporter.h"
+#include "../01_Core/JobSystem.h"
+#include "../01_Core/MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    double ElapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    bool Fail(std::string* error, const std::string& message)
+    {
+        if (error != nullptr)
+            *error = message;
+        return false;
+    }
+
+    // 조각 수가 작업자 수의 몇 배는 되어야 늦게 끝나는 조각 때문에 노는 스레드가 적다.
+    std::size_t GetChunkSize(std::size_t size, JobSystem& jobs)
+    {
+        const std::size_t minChunkSize = 256 * 1024;
+        const std::size_t chunkSize = size / ((std::size_t)(jobs.GetWorkerCount() + 1) * 8);
+        return std::max<std::size_t>(chunkSize, minChunkSize);
+    }
+
+    // 오른손 좌표계(OBJ/PLY/glTF) -> 왼손 좌표계 : z를 뒤집는다. (삼각형 감는 순서도 같이 바꾼다)
+    XMFLOAT3 ToLeftHanded(float x, float y, float z)
+    {
+        return XMFLOAT3(x, y, -z);
+    }
+
+    //
+    // 텍스트
+    //
+
+    // 줄 경계로 나눈 텍스트 조각
+    struct TextChunk
+    {
+        const char* Begin = nullptr;
+        const char* End = nullptr;
+    };
+
+    std::vector<TextChunk> SplitLines(const char* text, std::size_t size, std::size_t chunkSize)
+    {
+        std::vector<TextChunk> chunks;
+        const char* end = text + size;
+        for (const char* begin = text; begin < end; )
+        {
+            const char* split = end;
+            if ((std::size_t)(end - begin) > chunkSize)
+            {
+                const char* newline = static_cast<const char*>(std::memchr(begin + chunkSize, '\n', end - (begin + chunkSize)));
+                split = newline != nullptr ? newline + 1 : end;
+            }
+
+            TextChunk chunk;
+            chunk.Begin = begin;
+            chunk.End = split;
+            chunks.push_back(chunk);
+            begin = split;
+        }
+        return chunks;
+    }
+
+    // 줄바꿈을 뺀 공백 (토큰 나누기와 건너뛰기가 같은 기준을 써야 커서가 멈추지 않는다)
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // 한 줄 안에서 공백으로 나뉜 값 읽기
+    struct TextCursor
+    {
+        const char* Pos;
+        const char* End;
+
+        void SkipSpaces()
+        {
+            while (Pos < End && IsSpace(*Pos))
+                ++Pos;
+        }
+
+        bool IsLineEnd()
+        {
+            SkipSpaces();
+            return Pos >= End || *Pos == '\n';
+        }
+
+        void NextLine()
+        {
+            const char* newline = static_cast<const char*>(std::memchr(Pos, '\n', End - Pos));
+            Pos = newline != nullptr ? newline + 1 : End;
+        }
+
+        bool StartsWith(const char* token)
+        {
+            const std::size_t length = std::strlen(token);
+            if ((std::size_t)(End - Pos) < length || std::memcmp(Pos, token, length) != 0)
+                return false;
+            Pos += length;
+            return true;
+        }
+
+        template<typename T>
+        bool Parse(T& value)
+        {
+            SkipSpaces();
+            // from_chars는 '+'를 받지 않는다.
+            if (Pos < End && *Pos == '+')
+                ++Pos;
+            const std::from_chars_result result = std::from_chars(Pos, End, value);
+            if (result.ec != std::errc())
+                return false;
+            Pos = result.ptr;
+            return true;
+        }
+
+        std::string GetLine(const char* lineBegin)const
+        {
+            const char* lineEnd = lineBegin;
+            while (lineEnd < End && *lineEnd != '\n' && *lineEnd != '\r' && lineEnd - lineBegin < 64)
+                ++lineEnd;
+            return std::string(lineBegin, lineEnd);
+        }
+    };
+
+    //
+    // OBJ
+    //
+
+    const std::int32_t NoIndex = -1;
+
+    // 삼각형 꼭짓점 하나 (전역 0부터 시작하는 번호, 없으면 NoIndex)
+    struct ObjCorner
+    {
+        std::int32_t Position = NoIndex;
+        std::int32_t TexC = NoIndex;
+        std::int32_t Normal = NoIndex;
+
+        bool operator==(const ObjCorner& rhs)const
+        {
+            return Position == rhs.Position && TexC == rhs.TexC && Normal == rhs.Normal;
+        }
+    };
+
+    std::uint64_t HashCorner(const ObjCorner& corner)
+    {
+        // 64비트 섞기 (MurmurHash3 fmix64)
+        std::uint64_t hash = (std::uint64_t)(std::uint32_t)corner.Position | ((std::uint64_t)(std::uint32_t)corner.TexC << 32);
+        hash ^= (std::uint64_t)(std::uint32_t)corner.Normal * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    // 음수(상대) 번호를 쓴 꼭짓점 표시 : 조각 안 번호로 바꿔 두고, 합칠 때 앞 조각들의 개수를 더한다.
+    enum ObjRelativeBits : std::uint8_t
+    {
+        RelativePosition = 1 << 0,
+        RelativeTexC = 1 << 1,
+        RelativeNormal = 1 << 2,
+    };
+
+    struct ObjChunk
+    {
+        std::vector<XMFLOAT3> Positions;
+        std::vector<XMFLOAT2> TexCs;
+        std::vector<XMFLOAT3> Normals;
+        std::vector<ObjCorner> Corners;             // 삼각형마다 3개
+        std::vector<std::uint8_t> RelativeMasks;    // HasRelative일 때만 Corners와 같은 크기
+        bool HasRelative = false;
+        std::string Error;
+    };
+
+    // OBJ 번호 (1부터, 음수는 뒤에서부터) -> 0부터 시작하는 번호
+    bool ResolveObjIndex(int value, std::size_t localCount, std::int32_t& index, std::uint8_t bit, std::uint8_t& mask)
+    {
+        if (value > 0)
+        {
+            index = value - 1;
+            return true;
+        }
+        if (value < 0)
+        {
+            index = (std::int32_t)localCount + value;
+            mask |= bit;
+            return true;
+        }
+        return false;
+    }
+
+    bool ParseObjCorner(TextCursor& cursor, const ObjChunk& chunk, ObjCorner& corner, std::uint8_t& mask)
+    {
+        int value = 0;
+        if (!cursor.Parse(value) || !ResolveObjIndex(value, chunk.Positions.size(), corner.Position, RelativePosition, mask))
+            return false;
+
+        // v, v/t, v//n, v/t/n
+        if (cursor.Pos >= cursor.End || *cursor.Pos != '/')
+            return true;
+        ++cursor.Pos;
+
+        if (cursor.Pos < cursor.End && *cursor.Pos != '/')
+        {
+            if (!cursor.Parse(value) || !ResolveObjIndex(value, chunk.TexCs.size(), corner.TexC, RelativeTexC, mask))
+                return false;
+        }
+
+        if (cursor.Pos >= cursor.End || *cursor.Pos != '/')
+            return true;
+        ++cursor.Pos;
+
+        return cursor.Parse(value) && ResolveObjIndex(value, chunk.Normals.size(), corner.Normal, RelativeNormal, mask);
+    }
+
+    void ParseObjChunk(const TextChunk& text, ObjChunk& chunk)
+    {
+        std::vector<ObjCorner> polygon;
+        std::vector<std::uint8_t> polygonMasks;
+
+        TextCursor cursor = { text.Begin, text.End };
+        while (cursor.Pos < cursor.End)
+        {
+            cursor.SkipSpaces();
+            const char* line = cursor.Pos;
+            bool isParsed = true;
+
+            if (cursor.StartsWith("v ") || cursor.StartsWith("v\t"))
+            {
+                float x = 0.0f, y = 0.0f, z = 0.0f;
+                isParsed = cursor.Parse(x) && cursor.Parse(y) && cursor.Parse(z);
+                chunk.Positions.push_back(ToLeftHanded(x, y, z));
+            }
+            else if (cursor.StartsWith("vt"))
+            {
+                // v는 없을 수 있다. OBJ의 UV 원점은 왼쪽 아래라서 v를 뒤집는다.
+                float u = 0.0f, v = 0.0f;
+                isParsed = cursor.Parse(u);
+                if (!cursor.IsLineEnd())
+                    isParsed = isParsed && cursor.Parse(v);
+                chunk.TexCs.push_back(XMFLOAT2(u, 1.0f - v));
+            }
+            else if (cursor.StartsWith("vn"))
+            {
+                float x = 0.0f, y = 0.0f, z = 0.0f;
+                isParsed = cursor.Parse(x) && cursor.Parse(y) && cursor.Parse(z);
+                chunk.Normals.push_back(ToLeftHanded(x, y, z));
+            }
+            else if (cursor.StartsWith("f ") || cursor.StartsWith("f\t"))
+            {
+                polygon.clear();
+                polygonMasks.clear();
+                while (isParsed && !cursor.IsLineEnd())
+                {
+                    ObjCorner corner;
+                    std::uint8_t mask = 0;
+                    isParsed = ParseObjCorner(cursor, chunk, corner, mask);
+                    polygon.push_back(corner);
+                    polygonMasks.push_back(mask);
+                }
+                isParsed = isParsed && polygon.size() >= 3;
+
+                if (isParsed)
+                {
+                    // 상대 번호가 처음 나오면 그때부터 표시를 남긴다.
+                    if (!chunk.HasRelative && std::find_if(polygonMasks.begin(), polygonMasks.end(), [](std::uint8_t mask) { return mask != 0; }) != polygonMasks.end())
+                    {
+                        chunk.HasRelative = true;
+                        chunk.RelativeMasks.resize(chunk.Corners.size(), 0);
+                    }
+
+                    // 부채꼴 분할 (왼손 좌표계로 바꿨으므로 감는 순서를 뒤집는다)
+                    for (std::size_t k = 1; k + 1 < polygon.size(); ++k)
+                    {
+                        const std::size_t triangle[3] = { 0, k + 1, k };
+                        for (std::size_t corner : triangle)
+                        {
+                            chunk.Corners.push_back(polygon[corner]);
+                            if (chunk.HasRelative)
+                                chunk.RelativeMasks.push_back(polygonMasks[corner]);
+                        }
+                    }
+                }
+            }
+
+            if (!isParsed)
+            {
+                chunk.Error = "OBJ: cannot parse '" + cursor.GetLine(line) + "'";
+                return;
+            }
+
+            // 나머지(주석, o, g, s, usemtl, 정점 색 등)는 무시
+            cursor.NextLine();
+        }
+    }
+
+    // 조각별 꼭짓점을 전역 번호로 모은다.
+    bool MergeObjCorners(
+        std::vector<ObjChunk>& chunks,
+        JobSystem& jobs,
+        std::vector<XMFLOAT3>& positions,
+        std::vector<XMFLOAT2>& texCs,
+        std::vector<XMFLOAT3>& normals,
+        std::vector<ObjCorner>& corners,
+        std::string* error)
+    {
+        struct Offsets
+        {
+            std::size_t Position = 0;
+            std::size_t TexC = 0;
+            std::size_t Normal = 0;
+            std::size_t Corner = 0;
+        };
+
+        std::vector<Offsets> offsets(chunks.size() + 1);
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            offsets[i + 1].Position = offsets[i].Position + chunks[i].Positions.size();
+            offsets[i + 1].TexC = offsets[i].TexC + chunks[i].TexCs.size();
+            offsets[i + 1].Normal = offsets[i].Normal + chunks[i].Normals.size();
+            offsets[i + 1].Corner = offsets[i].Corner + chunks[i].Corners.size();
+        }
+
+        const Offsets& total = offsets.back();
+        if (total.Corner / 3 > 0xFFFFFFFFull / 3 || total.Position > 0x7FFFFFFF || total.TexC > 0x7FFFFFFF || total.Normal > 0x7FFFFFFF)
+            return Fail(error, "OBJ: mesh is too large");
+
+        positions.resize(total.Position);
+        texCs.resize(total.TexC);
+        normals.resize(total.Normal);
+        corners.resize(total.Corner);
+
+        std::vector<std::uint8_t> isValid(chunks.size(), 0);
+        JobCounter counter = jobs.ParallelFor((std::uint32_t)chunks.size(), 1, [&](std::uint32_t index)
+        {
+            ObjChunk& chunk = chunks[index];
+            const Offsets& base = offsets[index];
+
+            std::copy(chunk.Positions.begin(), chunk.Positions.end(), positions.begin() + base.Position);
+            std::copy(chunk.TexCs.begin(), chunk.TexCs.end(), texCs.begin() + base.TexC);
+            std::copy(chunk.Normals.begin(), chunk.Normals.end(), normals.begin() + base.Normal);
+
+            for (std::size_t i = 0; i < chunk.Corners.size(); ++i)
+            {
+                ObjCorner corner = chunk.Corners[i];
+                if (chunk.HasRelative)
+                {
+                    const std::uint8_t mask = chunk.RelativeMasks[i];
+                    if (mask & RelativePosition)
+                        corner.Position += (std::int32_t)base.Position;
+                    if (mask & RelativeTexC)
+                        corner.TexC += (std::int32_t)base.TexC;
+                    if (mask & RelativeNormal)
+                        corner.Normal += (std::int32_t)base.Normal;
+
+                    if (((mask & RelativeTexC) && corner.TexC < 0) || ((mask & RelativeNormal) && corner.Normal < 0))
+                        return;
+                }
+
+                if (corner.Position < 0 || corner.Position >= (std::int32_t)total.Position ||
+                    corner.TexC >= (std::int32_t)total.TexC || corner.Normal >= (std::int32_t)total.Normal)
+                    return;
+
+                corners[base.Corner + i] = corner;
+            }
+
+            // 조각 메모리는 바로 놓는다.
+            chunk = ObjChunk();
+            isValid[index] = 1;
+        });
+        jobs.Wait(counter);
+
+        if (std::find(isValid.begin(), isValid.end(), 0) != isValid.end())
+            return Fail(error, "OBJ: face references a vertex that does not exist");
+        return true;
+    }
+
+    // (위치, UV, 법선)이 같은 꼭짓점을 하나의 정점으로 합친다.
+    // 해시로 꼭짓점을 샤드에 나눠서 샤드마다 해시 맵 하나로 병렬 처리하고, 꼭짓점마다 "같은 값이 처음 나온 꼭짓점"을 찾는다.
+    // 처음 나온 꼭짓점의 순서대로 정점 번호를 매기므로 한 스레드로 처리한 것과 결과가 같다.
+    void WeldObjCorners(
+        const std::vector<ObjCorner>& corners,
+        const std::vector<XMFLOAT3>& positions,
+        const std::vector<XMFLOAT2>& texCs,
+        const std::vector<XMFLOAT3>& normals,
+        JobSystem& jobs,
+        GeometryGenerator::MeshData& mesh)
+    {
+        const std::uint32_t cornerCount = (std::uint32_t)corners.size();
+        const std::uint32_t batchSize = 64 * 1024;
+        const std::uint32_t batchCount = (cornerCount + batchSize - 1) / batchSize;
+        const std::uint32_t shardCount = std::min<std::uint32_t>(256, (jobs.GetWorkerCount() + 1) * 4);
+
+        // 1. 꼭짓점마다 샤드 번호, 배치마다 샤드별 개수
+        std::vector<std::uint8_t> shards(cornerCount);
+        std::vector<std::uint32_t> batchShardCounts((std::size_t)batchCount * shardCount, 0);
+        JobCounter counter = jobs.ParallelFor(batchCount, 1, [&](std::uint32_t batch)
+        {
+            const std::uint32_t begin = batch * batchSize;
+            const std::uint32_t end = std::min<std::uint32_t>(begin + batchSize, cornerCount);
+            std::uint32_t* counts = &batchShardCounts[(std::size_t)batch * shardCount];
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                // 맵 버킷은 해시 아래 비트를 쓰므로 샤드는 위 비트로 고른다.
+                const std::uint8_t shard = (std::uint8_t)((HashCorner(corners[i]) >> 32) % shardCount);
+                shards[i] = shard;
+                ++counts[shard];
+            }
+        });
+        jobs.Wait(counter);
+
+        // 2. 샤드별로 꼭짓점 번호를 모은다. (샤드 안에서는 꼭짓점 순서 그대로)
+        std::vector<std::uint32_t> shardOffsets(shardCount + 1, 0);
+        std::vector<std::uint32_t> batchShardOffsets(batchShardCounts.size());
+        {
+            std::uint32_t offset = 0;
+            for (std::uint32_t shard = 0; shard < shardCount; ++shard)
+            {
+                shardOffsets[shard] = offset;
+                for (std::uint32_t batch = 0; batch < batchCount; ++batch)
+                {
+                    const std::size_t slot = (std::size_t)batch * shardCount + shard;
+                    batchShardOffsets[slot] = offset;
+                    offset += batchShardCounts[slot];
+                }
+            }
+            shardOffsets[shardCount] = offset;
+        }
+
+        std::vector<std::uint32_t> shardCorners(cornerCount);
+        counter = jobs.ParallelFor(batchCount, 1, [&](std::uint32_t batch)
+        {
+            const std::uint32_t begin = batch * batchSize;
+            const std::uint32_t end = std::min<std::uint32_t>(begin + batchSize, cornerCount);
+            std::uint32_t* offsets = &batchShardOffsets[(std::size_t)batch * shardCount];
+            for (std::uint32_t i = begin; i < end; ++i)
+                shardCorners[offsets[shards[i]]++] = i;
+        });
+        jobs.Wait(counter);
+
+        shards.clear();
+        shards.shrink_to_fit();
+
+        // 3. 샤드마다 해시 맵 : 꼭짓점 -> 같은 값이 처음 나온 꼭짓점
+        // 대부분이 이미 있는 값을 찾는 것이라 노드 할당이 없는 열린 주소(선형 탐사) 테이블을 쓰고,
+        // 키를 슬롯에 같이 넣어서 비교할 때 corners를 다시 읽지 않는다.
+        std::vector<std::uint32_t> firstCorners(cornerCount);
+        counter = jobs.ParallelFor(shardCount, 1, [&](std::uint32_t shard)
+        {
+            struct Slot
+            {
+                ObjCorner Key;
+                std::uint32_t First;
+            };
+            const std::uint32_t emptySlot = 0xFFFFFFFF;
+
+            const std::uint32_t begin = shardOffsets[shard];
+            const std::uint32_t end = shardOffsets[shard + 1];
+
+            // 닫힌 메시는 정점 하나를 꼭짓점 약 6개가 공유하므로 그 정도로 시작해서 모자라면 늘린다.
+            std::size_t capacity = 64;
+            while (capacity < (std::size_t)(end - begin) / 4)
+                capacity *= 2;
+            std::vector<Slot> table(capacity, Slot{ ObjCorner(), emptySlot });
+            std::size_t size = 0;
+
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                const std::uint32_t corner = shardCorners[i];
+                const ObjCorner& key = corners[corner];
+                std::size_t index = (std::size_t)HashCorner(key) & (capacity - 1);
+                for (;;)
+                {
+                    Slot& slot = table[index];
+                    if (slot.First == emptySlot)
+                    {
+                        slot.Key = key;
+                        slot.First = corner;
+                        firstCorners[corner] = corner;
+                        ++size;
+                        break;
+                    }
+                    if (slot.Key == key)
+                    {
+                        firstCorners[corner] = slot.First;
+                        break;
+                    }
+                    index = (index + 1) & (capacity - 1);
+                }
+
+                // 절반이 차면 두 배로 다시 만든다.
+                if (size * 2 > capacity)
+                {
+                    std::vector<Slot> oldTable(capacity * 2, Slot{ ObjCorner(), emptySlot });
+                    oldTable.swap(table);
+                    capacity *= 2;
+                    for (const Slot& slot : oldTable)
+                    {
+                        if (slot.First == emptySlot)
+                            continue;
+                        std::size_t newIndex = (std::size_t)HashCorner(slot.Key) & (capacity - 1);
+                        while (table[newIndex].First != emptySlot)
+                            newIndex = (newIndex + 1) & (capacity - 1);
+                        table[newIndex] = slot;
+                    }
+                }
+            }
+        });
+        jobs.Wait(counter);
+
+        // 4. 처음 나온 꼭짓점에 정점 번호 (배치별 개수 -> 누적)
+        std::vector<std::uint32_t> batchVertexOffsets(batchCount + 1, 0);
+        counter = jobs.ParallelFor(batchCount, 1, [&](std::uint32_t batch)
+        {
+            const std::uint32_t begin = batch * batchSize;
+            const std::uint32_t end = std::min<std::uint32_t>(begin + batchSize, cornerCount);
+            std::uint32_t count = 0;
+            for (std::uint32_t i = begin; i < end; ++i)
+                count += firstCorners[i] == i ? 1 : 0;
+            batchVertexOffsets[batch + 1] = count;
+        });
+        jobs.Wait(counter);
+
+        for (std::uint32_t batch = 0; batch < batchCount; ++batch)
+            batchVertexOffsets[batch + 1] += batchVertexOffsets[batch];
+
+        // shardCorners는 다 썼으므로 꼭짓점 -> 정점 번호로 다시 쓴다.
+        std::vector<std::uint32_t>& vertexIndices = shardCorners;
+        mesh.Vertices.resize(batchVertexOffsets[batchCount]);
+        counter = jobs.ParallelFor(batchCount, 1, [&](std::uint32_t batch)
+        {
+            const std::uint32_t begin = batch * batchSize;
+            const std::uint32_t end = std::min<std::uint32_t>(begin + batchSize, cornerCount);
+            std::uint32_t vertexIndex = batchVertexOffsets[batch];
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                if (firstCorners[i] != i)
+                    continue;
+
+                const ObjCorner& corner = corners[i];
+                GeometryGenerator::Vertex& vertex = mesh.Vertices[vertexIndex];
+                vertex.Position = positions[corner.Position];
+                vertex.Normal = corner.Normal != NoIndex ? normals[corner.Normal] : XMFLOAT3(0.0f, 0.0f, 0.0f);
+                vertex.TangentU = XMFLOAT3(0.0f, 0.0f, 0.0f);
+                vertex.TexC = corner.TexC != NoIndex ? texCs[corner.TexC] : XMFLOAT2(0.0f, 0.0f);
+
+                vertexIndices[i] = vertexIndex++;
+            }
+        });
+        jobs.Wait(counter);
+
+        // 5. 인덱스 버퍼
+        mesh.Indices32.resize(cornerCount);
+        counter = jobs.ParallelFor(batchCount, 1, [&](std::uint32_t batch)
+        {
+            const std::uint32_t begin = batch * batchSize;
+            const std::uint32_t end = std::min<std::uint32_t>(begin + batchSize, cornerCount);
+            for (std::uint32_t i = begin; i < end; ++i)
+                mesh.Indices32[i] = vertexIndices[firstCorners[i]];
+        });
+        jobs.Wait(counter);
+    }
+
+    //
+    // PLY
+    //
+
+    enum class PlyType
+    {
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64
+    };
+
+    struct PlyProperty
+    {
+        std::string Name;
+        PlyType Type = PlyType::Float32;
+        bool IsList = false;
+        PlyType CountType = PlyType::UInt8;
+    };
+
+    struct PlyElement
+    {
+        std::string Name;
+        std::uint32_t Count = 0;
+        std::vector<PlyProperty> Properties;
+    };
+
+    enum class PlyFormat
+    {
+        Ascii, BinaryLittleEndian, BinaryBigEndian
+    };
+
+    bool ParsePlyType(const std::string& name, PlyType& type)
+    {
+        static const std::pair<const char*, PlyType> types[] =
+        {
+            { "char", PlyType::Int8 }, { "int8", PlyType::Int8 },
+            { "uchar", PlyType::UInt8 }, { "uint8", PlyType::UInt8 },
+            { "short", PlyType::Int16 }, { "int16", PlyType::Int16 },
+            { "ushort", PlyType::UInt16 }, { "uint16", PlyType::UInt16 },
+            { "int", PlyType::Int32 }, { "int32", PlyType::Int32 },
+            { "uint", PlyType::UInt32 }, { "uint32", PlyType::UInt32 },
+            { "float", PlyType::Float32 }, { "float32", PlyType::Float32 },
+            { "double", PlyType::Float64 }, { "float64", PlyType::Float64 },
+        };
+
+        for (const auto& pair : types)
+        {
+            if (name == pair.first)
+            {
+                type = pair.second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t GetPlyTypeSize(PlyType type)
+    {
+        switch (type)
+        {
+        case PlyType::Int8:
+        case PlyType::UInt8: return 1;
+        case PlyType::Int16:
+        case PlyType::UInt16: return 2;
+        case PlyType::Int32:
+        case PlyType::UInt32:
+        case PlyType::Float32: return 4;
+        default: return 8;
+        }
+    }
+
+    // 바이너리 값 하나를 double로 (빅 엔디언이면 바이트를 뒤집는다)
+    double ReadPlyValue(const std::uint8_t* data, PlyType type, bool isBigEndian)
+    {
+        std::uint8_t bytes[8];
+        const std::size_t size = GetPlyTypeSize(type);
+        for (std::size_t i = 0; i < size; ++i)
+            bytes[i] = data[isBigEndian ? size - 1 - i : i];
+
+        switch (type)
+        {
+        case PlyType::Int8: { std::int8_t value; std::memcpy(&value, bytes, 1); return value; }
+        case PlyType::UInt8: return bytes[0];
+        case PlyType::Int16: { std::int16_t value; std::memcpy(&value, bytes, 2); return value; }
+        case PlyType::UInt16: { std::uint16_t value; std::memcpy(&value, bytes, 2); return value; }
+        case PlyType::Int32: { std::int32_t value; std::memcpy(&value, bytes, 4); return value; }
+        case PlyType::UInt32: { std::uint32_t value; std::memcpy(&value, bytes, 4); return value; }
+        case PlyType::Float32: { float value; std::memcpy(&value, bytes, 4); return value; }
+        default: { double value; std::memcpy(&value, bytes, 8); return value; }
+        }
+    }
+
+    // 정점 요소에서 쓰는 속성 번호 (없으면 -1)
+    struct PlyVertexLayout
+    {
+        int Position[3] = { -1, -1, -1 };
+        int Normal[3] = { -1, -1, -1 };
+        int TexC[2] = { -1, -1 };
+    };
+
+    PlyVertexLayout GetPlyVertexLayout(const PlyElement& element)
+    {
+        PlyVertexLayout layout;
+        for (int i = 0; i < (int)element.Properties.size(); ++i)
+        {
+            const std::string& name = element.Properties[i].Name;
+            if (name == "x") layout.Position[0] = i;
+            else if (name == "y") layout.Position[1] = i;
+            else if (name == "z") layout.Position[2] = i;
+            else if (name == "nx") layout.Normal[0] = i;
+            else if (name == "ny") layout.Normal[1] = i;
+            else if (name == "nz") layout.Normal[2] = i;
+            else if (name == "u" || name == "s" || name == "texture_u" || name == "texture_s") layout.TexC[0] = i;
+            else if (name == "v" || name == "t" || name == "texture_v" || name == "texture_t") layout.TexC[1] = i;
+        }
+        return layout;
+    }
+
+    // 속성 값 -> 정점 (values는 속성 순서)
+    void SetPlyVertex(const PlyVertexLayout& layout, const double* values, GeometryGenerator::Vertex& vertex)
+    {
+        auto get = [values](int property) { return property >= 0 ? (float)values[property] : 0.0f; };
+
+        vertex.Position = ToLeftHanded(get(layout.Position[0]), get(layout.Position[1]), get(layout.Position[2]));
+        vertex.Normal = ToLeftHanded(get(layout.Normal[0]), get(layout.Normal[1]), get(layout.Normal[2]));
+        vertex.TangentU = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        vertex.TexC = XMFLOAT2(get(layout.TexC[0]), layout.TexC[1] >= 0 ? 1.0f - get(layout.TexC[1]) : 0.0f);
+    }
+
+    bool ParsePlyHeader(const std::uint8_t* data, std::size_t size, PlyFormat& format, std::vector<PlyElement>& elements, std::size_t& bodyOffset, std::string* error)
+    {
+        const char* text = reinterpret_cast<const char*>(data);
+        TextCursor cursor = { text, text + size };
+        if (!cursor.StartsWith("ply"))
+            return Fail(error, "PLY: missing 'ply' signature");
+        cursor.NextLine();
+
+        bool hasFormat = false;
+        while (cursor.Pos < cursor.End)
+        {
+            // 한 줄을 공백으로 나눈다.
+            std::vector<std::string> tokens;
+            while (!cursor.IsLineEnd())
+            {
+                const char* begin = cursor.Pos;
+                while (cursor.Pos < cursor.End && !IsSpace(*cursor.Pos) && *cursor.Pos != '\n')
+                    ++cursor.Pos;
+                tokens.emplace_back(begin, cursor.Pos);
+            }
+            cursor.NextLine();
+
+            if (tokens.empty() || tokens[0] == "comment" || tokens[0] == "obj_info")
+                continue;
+
+            if (tokens[0] == "end_header")
+            {
+                if (!hasFormat)
+                    return Fail(error, "PLY: missing format");
+                bodyOffset = (std::size_t)(cursor.Pos - text);
+                return true;
+            }
+
+            if (tokens[0] == "format" && tokens.size() >= 2)
+            {
+                if (tokens[1] == "ascii") format = PlyFormat::Ascii;
+                else if (tokens[1] == "binary_little_endian") format = PlyFormat::BinaryLittleEndian;
+                else if (tokens[1] == "binary_big_endian") format = PlyFormat::BinaryBigEndian;
+                else return Fail(error, "PLY: unknown format '" + tokens[1] + "'");
+                hasFormat = true;
+            }
+            else if (tokens[0] == "element" && tokens.size() >= 3)
+            {
+                PlyElement element;
+                element.Name = tokens[1];
+                const std::from_chars_result result = std::from_chars(tokens[2].data(), tokens[2].data() + tokens[2].size(), element.Count);
+                if (result.ec != std::errc())
+                    return Fail(error, "PLY: bad element count '" + tokens[2] + "'");
+                elements.push_back(element);
+            }
+            else if (tokens[0] == "property" && !elements.empty())
+            {
+                PlyProperty property;
+                const bool isValid = tokens.size() >= 5 && tokens[1] == "list"
+                    ? (property.IsList = true, ParsePlyType(tokens[2], property.CountType) && ParsePlyType(tokens[3], property.Type))
+                    : tokens.size() >= 3 && ParsePlyType(tokens[1], property.Type);
+                if (!isValid)
+                    return Fail(error, "PLY: bad property '" + tokens.back() + "'");
+
+                property.Name = tokens.back();
+                elements.back().Properties.push_back(property);
+            }
+        }
+
+        return Fail(error, "PLY: missing end_header");
+    }
+
+    // 면 하나 (정점 번호들) -> 삼각형 (부채꼴, 감는 순서 뒤집기)
+    template<typename GetIndex>
+    bool AppendPlyFace(std::uint32_t count, GetIndex getIndex, std::uint32_t vertexCount, std::uint32_t* indices)
+    {
+        for (std::uint32_t k = 1; k + 1 < count; ++k)
+        {
+            const std::uint32_t triangle[3] = { 0, k + 1, k };
+            for (std::uint32_t corner : triangle)
+            {
+                const double index = getIndex(corner);
+                if (index < 0.0 || index >= (double)vertexCount)
+                    return false;
+                *indices++ = (std::uint32_t)index;
+            }
+        }
+        return true;
+    }
+
+    bool ImportPlyBinary(const std::uint8_t* body, std::size_t size, bool isBigEndian, const std::vector<PlyElement>& elements,
+        JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error)
+    {
+        const std::uint8_t* cursor = body;
+        const std::uint8_t* end = body + size;
+
+        for (const PlyElement& element : elements)
+        {
+            bool hasList = false;
+            std::size_t stride = 0;
+            std::size_t minRecordSize = 0;  // 리스트는 개수만 있는 경우
+            std::vector<std::size_t> offsets;
+            for (const PlyProperty& property : element.Properties)
+            {
+                hasList = hasList || property.IsList;
+                offsets.push_back(stride);
+                stride += GetPlyTypeSize(property.Type);
+                minRecordSize += GetPlyTypeSize(property.IsList ? property.CountType : property.Type);
+            }
+
+            // 남은 바이트로 담을 수 없는 개수는 읽기 전에 거른다. (속성 없는 요소는 읽을 것이 없다)
+            if (minRecordSize == 0)
+                continue;
+            if ((std::size_t)(end - cursor) / minRecordSize < element.Count)
+                return Fail(error, "PLY: file is truncated");
+
+            if (element.Name == "vertex")
+            {
+                // 고정 크기 레코드라서 정점마다 위치를 바로 알 수 있다 : 병렬 변환
+                if (hasList)
+                    return Fail(error, "PLY: list properties in vertex element are not supported");
+                if ((std::size_t)(end - cursor) / (stride == 0 ? 1 : stride) < element.Count)
+                    return Fail(error, "PLY: file is truncated");
+
+                const PlyVertexLayout layout = GetPlyVertexLayout(element);
+                const std::uint8_t* vertexData = cursor;
+                mesh.Vertices.resize(element.Count);
+
+                JobCounter counter = jobs.ParallelFor(element.Count, 16 * 1024, [&](std::uint32_t index)
+                {
+                    double values[64] = {};
+                    const std::uint8_t* record = vertexData + (std::size_t)index * stride;
+                    const std::size_t propertyCount = std::min<std::size_t>(element.Properties.size(), 64);
+                    for (std::size_t i = 0; i < propertyCount; ++i)
+                        values[i] = ReadPlyValue(record + offsets[i], element.Properties[i].Type, isBigEndian);
+                    SetPlyVertex(layout, values, mesh.Vertices[index]);
+                });
+                jobs.Wait(counter);
+
+                cursor += (std::size_t)element.Count * stride;
+                continue;
+            }
+
+            // 면과 나머지 요소는 가변 길이라서 순서대로 읽는다.
+            const bool isFace = element.Name == "face";
+            for (std::uint32_t i = 0; i < element.Count; ++i)
+            {
+                for (const PlyProperty& property : element.Properties)
+                {
+                    if (!property.IsList)
+                    {
+                        if ((std::size_t)(end - cursor) < GetPlyTypeSize(property.Type))
+                            return Fail(error, "PLY: file is truncated");
+                        cursor += GetPlyTypeSize(property.Type);
+                        continue;
+                    }
+
+                    const std::size_t countSize = GetPlyTypeSize(property.CountType);
+                    const std::size_t valueSize = GetPlyTypeSize(property.Type);
+                    if ((std::size_t)(end - cursor) < countSize)
+                        return Fail(error, "PLY: file is truncated");
+                    const std::uint32_t count = (std::uint32_t)ReadPlyValue(cursor, property.CountType, isBigEndian);
+                    cursor += countSize;
+                    if ((std::size_t)(end - cursor) / valueSize < count)
+                        return Fail(error, "PLY: file is truncated");
+
+                    if (isFace && (property.Name == "vertex_indices" || property.Name == "vertex_index") && count >= 3)
+                    {
+                        const std::size_t first = mesh.Indices32.size();
+                        mesh.Indices32.resize(first + (count - 2) * 3);
+                        const std::uint8_t* values = cursor;
+                        auto getIndex = [&](std::uint32_t corner) { return ReadPlyValue(values + corner * valueSize, property.Type, isBigEndian); };
+                        if (!AppendPlyFace(count, getIndex, (std::uint32_t)mesh.Vertices.size(), &mesh.Indices32[first]))
+                            return Fail(error, "PLY: face references a vertex that does not exist");
+                    }
+                    cursor += count * valueSize;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // 텍스트 조각 하나의 숫자들 (줄마다 시작 위치)
+    struct PlyTextChunk
+    {
+        std::vector<double> Values;
+        std::vector<std::uint32_t> LineStarts;
+        std::size_t FirstLine = 0;      // 전역 줄 번호 (합칠 때 채운다)
+        std::size_t FirstIndex = 0;     // 이 조각의 면이 쓰기 시작할 인덱스 위치
+        std::string Error;
+    };
+
+    bool ImportPlyAscii(const char* body, std::size_t size, const std::vector<PlyElement>& elements,
+        JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::uint32_t& chunkCount, std::string* error)
+    {
+        // 1. 줄 단위 조각으로 나눠서 숫자만 병렬로 읽는다. (빈 줄은 세지 않는다)
+        const std::vector<TextChunk> textChunks = SplitLines(body, size, GetChunkSize(size, jobs));
+        std::vector<PlyTextChunk> chunks(textChunks.size());
+        chunkCount = (std::uint32_t)chunks.size();
+
+        JobCounter counter = jobs.ParallelFor((std::uint32_t)chunks.size(), 1, [&](std::uint32_t index)
+        {
+            PlyTextChunk& chunk = chunks[index];
+            TextCursor cursor = { textChunks[index].Begin, textChunks[index].End };
+            while (cursor.Pos < cursor.End)
+            {
+                const char* line = cursor.Pos;
+                if (!cursor.IsLineEnd())
+                {
+                    chunk.LineStarts.push_back((std::uint32_t)chunk.Values.size());
+                    while (!cursor.IsLineEnd())
+                    {
+                        double value = 0.0;
+                        if (!cursor.Parse(value))
+                        {
+                            chunk.Error = "PLY: cannot parse '" + cursor.GetLine(line) + "'";
+                            return;
+                        }
+                        chunk.Values.push_back(value);
+                    }
+                }
+                cursor.NextLine();
+            }
+        });
+        jobs.Wait(counter);
+
+        std::size_t lineCount = 0;
+        for (PlyTextChunk& chunk : chunks)
+        {
+            if (!chunk.Error.empty())
+                return Fail(error, chunk.Error);
+            chunk.FirstLine = lineCount;
+            lineCount += chunk.LineStarts.size();
+        }
+
+        // 요소별 줄 구간
+        std::size_t vertexLine = 0, faceLine = 0, line = 0;
+        const PlyElement* vertexElement = nullptr;
+        const PlyElement* faceElement = nullptr;
+        for (const PlyElement& element : elements)
+        {
+            if (element.Name == "vertex") { vertexElement = &element; vertexLine = line; }
+            if (element.Name == "face") { faceElement = &element; faceLine = line; }
+            line += element.Count;
+        }
+        if (lineCount < line)
+            return Fail(error, "PLY: file is truncated");
+
+        const std::uint32_t vertexCount = vertexElement != nullptr ? vertexElement->Count : 0;
+        const std::uint32_t faceCount = faceElement != nullptr ? faceElement->Count : 0;
+        const PlyVertexLayout layout = vertexElement != nullptr ? GetPlyVertexLayout(*vertexElement) : PlyVertexLayout();
+
+        // 면 줄에서 정점 번호 목록이 시작하는 값 위치 (앞의 스칼라/리스트 속성을 건너뛴다)
+        int faceListProperty = -1;
+        if (faceElement != nullptr)
+        {
+            for (int i = 0; i < (int)faceElement->Properties.size(); ++i)
+            {
+                const PlyProperty& property = faceElement->Properties[i];
+                if (property.IsList && (property.Name == "vertex_indices" || property.Name == "vertex_index"))
+                    faceListProperty = i;
+            }
+        }
+
+        auto findFaceList = [&](const double* values, const double* valuesEnd, const double*& list, std::uint32_t& count)
+        {
+            const double* cursor = values;
+            for (int i = 0; i <= faceListProperty; ++i)
+            {
+                if (cursor >= valuesEnd)
+                    return false;
+                if (!faceElement->Properties[i].IsList)
+                {
+                    ++cursor;
+                    continue;
+                }
+
+                const double listCount = *cursor++;
+                if (listCount < 0.0 || listCount > (double)(valuesEnd - cursor))
+                    return false;
+                if (i == faceListProperty)
+                {
+                    list = cursor;
+                    count = (std::uint32_t)listCount;
+                    return true;
+                }
+                cursor += (std::size_t)listCount;
+            }
+            return false;
+        };
+
+        auto getLineValues = [](const PlyTextChunk& chunk, std::size_t localLine, const double*& begin, const double*& end)
+        {
+            begin = chunk.Values.data() + chunk.LineStarts[localLine];
+            end = localLine + 1 < chunk.LineStarts.size() ? chunk.Values.data() + chunk.LineStarts[localLine + 1] : chunk.Values.data() + chunk.Values.size();
+        };
+
+        // 2. 조각마다 면이 만드는 인덱스 수 -> 누적 (조각이 인덱스를 쓸 위치)
+        std::vector<std::size_t> chunkIndexCounts(chunks.size(), 0);
+        std::vector<std::uint8_t> isValid(chunks.size(), 1);
+        if (faceListProperty >= 0)
+        {
+            counter = jobs.ParallelFor((std::uint32_t)chunks.size(), 1, [&](std::uint32_t index)
+            {
+                const PlyTextChunk& chunk = chunks[index];
+                for (std::size_t local = 0; local < chunk.LineStarts.size(); ++local)
+                {
+                    const std::size_t globalLine = chunk.FirstLine + local;
+                    if (globalLine < faceLine || globalLine >= faceLine + faceCount)
+                        continue;
+
+                    const double* begin;
+                    const double* end;
+                    getLineValues(chunk, local, begin, end);
+
+                    const double* list = nullptr;
+                    std::uint32_t count = 0;
+                    if (!findFaceList(begin, end, list, count))
+                    {
+                        isValid[index] = 0;
+                        return;
+                    }
+                    if (count >= 3)
+                        chunkIndexCounts[index] += (count - 2) * 3;
+                }
+            });
+            jobs.Wait(counter);
+        }
+
+        std::size_t indexCount = 0;
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            chunks[i].FirstIndex = indexCount;
+            indexCount += chunkIndexCounts[i];
+        }
+        if (std::find(isValid.begin(), isValid.end(), 0) != isValid.end())
+            return Fail(error, "PLY: bad face");
+
+        // 3. 정점/인덱스 쓰기
+        mesh.Vertices.resize(vertexCount);
+        mesh.Indices32.resize(indexCount);
+        counter = jobs.ParallelFor((std::uint32_t)chunks.size(), 1, [&](std::uint32_t index)
+        {
+            const PlyTextChunk& chunk = chunks[index];
+            std::uint32_t* indices = mesh.Indices32.data() + chunk.FirstIndex;
+
+            for (std::size_t local = 0; local < chunk.LineStarts.size(); ++local)
+            {
+                const std::size_t globalLine = chunk.FirstLine + local;
+                const double* begin;
+                const double* end;
+                getLineValues(chunk, local, begin, end);
+
+                if (globalLine >= vertexLine && globalLine < vertexLine + vertexCount)
+                {
+                    double values[64] = {};
+                    std::copy(begin, begin + std::min<std::size_t>(end - begin, 64), values);
+                    SetPlyVertex(layout, values, mesh.Vertices[globalLine - vertexLine]);
+                }
+                else if (faceListProperty >= 0 && globalLine >= faceLine && globalLine < faceLine + faceCount)
+                {
+                    const double* list = nullptr;
+                    std::uint32_t count = 0;
+                    findFaceList(begin, end, list, count);
+                    if (count < 3)
+                        continue;
+
+                    if (!AppendPlyFace(count, [list](std::uint32_t corner) { return list[corner]; }, vertexCount, indices))
+                    {
+                        isValid[index] = 0;
+                        return;
+                    }
+                    indices += (count - 2) * 3;
+                }
+            }
+        });
+        jobs.Wait(counter);
+
+        if (std::find(isValid.begin(), isValid.end(), 0) != isValid.end())
+            return Fail(error, "PLY: face references a vertex that does not exist");
+        return true;
+    }
+
+    //
+    // glTF
+    //
+
+    // glTF에 필요한 만큼만 읽는 JSON 값
+    struct JsonValue
+    {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+
+        Type Kind = Type::Null;
+        bool Bool = false;
+        double Number = 0.0;
+        std::string String;
+        std::vector<JsonValue> Array;
+        std::vector<std::pair<std::string, JsonValue>> Object;
+
+        const JsonValue* Find(const char* key)const
+        {
+            for (const auto& pair : Object)
+            {
+                if (pair.first == key)
+                    return &pair.second;
+            }
+            return nullptr;
+        }
+
+        double GetNumber(const char* key, double defaultValue)const
+        {
+            const JsonValue* value = Find(key);
+            return value != nullptr && value->Kind == Type::Number ? value->Number : defaultValue;
+        }
+
+        const JsonValue* GetElement(const char* key, double index)const
+        {
+            const JsonValue* array = Find(key);
+            if (array == nullptr || array->Kind != Type::Array || index < 0.0 || index >= (double)array->Array.size())
+                return nullptr;
+            return &array->Array[(std::size_t)index];
+        }
+    };
+
+    class JsonParser
+    {
+    public:
+        JsonParser(const char* text, std::size_t size) : mPos(text), mEnd(text + size) {}
+
+        bool Parse(JsonValue& value)
+        {
+            return ParseValue(value, 0) && (SkipSpaces(), mPos == mEnd || *mPos == '\0');
+        }
+
+    private:
+        void SkipSpaces()
+        {
+            while (mPos < mEnd && (*mPos == ' ' || *mPos == '\t' || *mPos == '\r' || *mPos == '\n'))
+                ++mPos;
+        }
+
+        bool Consume(char c)
+        {
+            SkipSpaces();
+            if (mPos >= mEnd || *mPos != c)
+                return false;
+            ++mPos;
+            return true;
+        }
+
+        bool ParseValue(JsonValue& value, int depth)
+        {
+            // 깨진 파일로 스택이 넘치지 않도록
+            if (depth > 64)
+                return false;
+
+            SkipSpaces();
+            if (mPos >= mEnd)
+                return false;
+
+            switch (*mPos)
+            {
+            case '{':
+            {
+                ++mPos;
+                value.Kind = JsonValue::Type::Object;
+                if (Consume('}'))
+                    return true;
+                do
+                {
+                    std::pair<std::string, JsonValue> member;
+                    SkipSpaces();
+                    if (!ParseString(member.first) || !Consume(':') || !ParseValue(member.second, depth + 1))
+                        return false;
+                    value.Object.push_back(std::move(member));
+                } while (Consume(','));
+                return Consume('}');
+            }
+            case '[':
+            {
+                ++mPos;
+                value.Kind = JsonValue::Type::Array;
+                if (Consume(']'))
+                    return true;
+                do
+                {
+                    value.Array.emplace_back();
+                    if (!ParseValue(value.Array.back(), depth + 1))
+                        return false;
+                } while (Consume(','));
+                return Consume(']');
+            }
+            case '"':
+                value.Kind = JsonValue::Type::String;
+                return ParseString(value.String);
+            case 't':
+                value.Kind = JsonValue::Type::Bool;
+                value.Bool = true;
+                return ParseLiteral("true");
+            case 'f':
+                value.Kind = JsonValue::Type::Bool;
+                return ParseLiteral("false");
+            case 'n':
+                return ParseLiteral("null");
+            default:
+            {
+                value.Kind = JsonValue::Type::Number;
+                const std::from_chars_result result = std::from_chars(mPos, mEnd, value.Number);
+                if (result.ec != std::errc())
+                    return false;
+                mPos = result.ptr;
+                return true;
+            }
+            }
+        }
+
+        bool ParseLiteral(const char* literal)
+        {
+            const std::size_t length = std::strlen(literal);
+            if ((std::size_t)(mEnd - mPos) < length || std::memcmp(mPos, literal, length) != 0)
+                return false;
+            mPos += length;
+            return true;
+        }
+
+        bool ParseString(std::string& str)
+        {
+            if (mPos >= mEnd || *mPos != '"')
+                return false;
+            ++mPos;
+
+            while (mPos < mEnd && *mPos != '"')
+            {
+                if (*mPos != '\\')
+                {
+                    str += *mPos++;
+                    continue;
+                }
+
+                if (++mPos >= mEnd)
+                    return false;
+                const char escape = *mPos++;
+                switch (escape)
+                {
+                case 'b': str += '\b'; break;
+                case 'f': str += '\f'; break;
+                case 'n': str += '\n'; break;
+                case 'r': str += '\r'; break;
+                case 't': str += '\t'; break;
+                case 'u':
+                {
+                    // 기본 다국어 평면만 UTF-8로 (서로게이트 쌍은 쓰지 않는다 - 이름에만 나온다)
+                    unsigned code = 0;
+                    if (mEnd - mPos < 4 || std::from_chars(mPos, mPos + 4, code, 16).ptr != mPos + 4)
+                        return false;
+                    mPos += 4;
+                    if (code < 0x80)
+                    {
+                        str += (char)code;
+                    }
+                    else if (code < 0x800)
+                    {
+                        str += (char)(0xC0 | (code >> 6));
+                        str += (char)(0x80 | (code & 0x3F));
+                    }
+                    else
+                    {
+                        str += (char)(0xE0 | (code >> 12));
+                        str += (char)(0x80 | ((code >> 6) & 0x3F));
+                        str += (char)(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default: str += escape; break;
+                }
+            }
+
+            if (mPos >= mEnd)
+                return false;
+            ++mPos;
+            return true;
+        }
+
+    private:
+        const char* mPos;
+        const char* mEnd;
+    };
+
+    const std::uint32_t GlbMagic = 0x46546C67;         // 'glTF'
+    const std::uint32_t GlbJsonChunk = 0x4E4F534A;     // 'JSON'
+    const std::uint32_t GlbBinaryChunk = 0x004E4942;   // 'BIN\0'
+
+    enum GltfComponentType
+    {
+        GltfByte = 5120,
+        GltfUnsignedByte = 5121,
+        GltfShort = 5122,
+        GltfUnsignedShort = 5123,
+        GltfUnsignedInt = 5125,
+        GltfFloat = 5126,
+    };
+
+    struct GltfBuffer
+    {
+        const std::uint8_t* Data = nullptr;
+        std::size_t Size = 0;
+    };
+
+    // 검사를 마친 접근자 : Count개의 원소가 Stride 간격으로 있다.
+    struct GltfAccessor
+    {
+        const std::uint8_t* Data = nullptr;     // nullptr이면 모두 0
+        std::size_t Stride = 0;
+        std::uint32_t Count = 0;
+        std::uint32_t ComponentType = GltfFloat;
+        std::uint32_t ComponentCount = 1;
+        bool IsNormalized = false;
+    };
+
+    std::size_t GetGltfComponentSize(std::uint32_t componentType)
+    {
+        switch (componentType)
+        {
+        case GltfByte:
+        case GltfUnsignedByte: return 1;
+        case GltfShort:
+        case GltfUnsignedShort: return 2;
+        case GltfUnsignedInt:
+        case GltfFloat: return 4;
+        default: return 0;
+        }
+    }
+
+    std::uint32_t GetGltfComponentCount(const std::string& type)
+    {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        return 0;
+    }
+
+    bool GetGltfAccessor(const JsonValue& root, const std::vector<GltfBuffer>& buffers, double index, GltfAccessor& accessor, std::string* error)
+    {
+        const JsonValue* json = root.GetElement("accessors", index);
+        if (json == nullptr)
+            return Fail(error, "glTF: accessor does not exist");
+        if (json->Find("sparse") != nullptr)
+            return Fail(error, "glTF: sparse accessors are not supported");
+
+        const JsonValue* type = json->Find("type");
+        const JsonValue* normalized = json->Find("normalized");
+        accessor.Count = (std::uint32_t)json->GetNumber("count", 0.0);
+        accessor.ComponentType = (std::uint32_t)json->GetNumber("componentType", 0.0);
+        accessor.ComponentCount = type != nullptr ? GetGltfComponentCount(type->String) : 0;
+        accessor.IsNormalized = normalized != nullptr && normalized->Bool;
+
+        const std::size_t elementSize = GetGltfComponentSize(accessor.ComponentType) * accessor.ComponentCount;
+        if (elementSize == 0)
+            return Fail(error, "glTF: unsupported accessor type");
+
+        // bufferView가 없으면 값이 모두 0
+        const JsonValue* viewIndex = json->Find("bufferView");
+        if (viewIndex == nullptr)
+            return true;
+
+        const JsonValue* view = root.GetElement("bufferViews", viewIndex->Number);
+        if (view == nullptr)
+            return Fail(error, "glTF: buffer view does not exist");
+
+        const double bufferIndex = view->GetNumber("buffer", 0.0);
+        if (bufferIndex < 0.0 || bufferIndex >= (double)buffers.size())
+            return Fail(error, "glTF: buffer does not exist");
+        const GltfBuffer& buffer = buffers[(std::size_t)bufferIndex];
+
+        const std::uint64_t viewOffset = (std::uint64_t)view->GetNumber("byteOffset", 0.0);
+        const std::uint64_t viewLength = (std::uint64_t)view->GetNumber("byteLength", 0.0);
+        const std::uint64_t accessorOffset = (std::uint64_t)json->GetNumber("byteOffset", 0.0);
+        accessor.Stride = (std::size_t)view->GetNumber("byteStride", (double)elementSize);
+
+        // 마지막 원소까지 버퍼 뷰와 버퍼 안에 있어야 한다.
+        const std::uint64_t accessorSize = accessor.Count == 0 ? 0 : (std::uint64_t)accessor.Stride * (accessor.Count - 1) + elementSize;
+        if (accessor.Stride < elementSize || viewOffset > buffer.Size || viewLength > buffer.Size - viewOffset ||
+            accessorOffset > viewLength || accessorSize > viewLength - accessorOffset)
+            return Fail(error, "glTF: accessor is out of range");
+
+        accessor.Data = buffer.Data + viewOffset + accessorOffset;
+        return true;
+    }
+
+    // 접근자 원소의 성분 하나 -> float (정규화 정수는 [0, 1] 또는 [-1, 1])
+    float ReadGltfComponent(const GltfAccessor& accessor, std::uint32_t element, std::uint32_t component)
+    {
+        if (accessor.Data == nullptr)
+            return 0.0f;
+
+        const std::uint8_t* data = accessor.Data + (std::size_t)element * accessor.Stride + component * GetGltfComponentSize(accessor.ComponentType);
+        switch (accessor.ComponentType)
+        {
+        case GltfByte: { std::int8_t value; std::memcpy(&value, data, 1); return accessor.IsNormalized ? std::max<float>(value / 127.0f, -1.0f) : value; }
+        case GltfUnsignedByte: return accessor.IsNormalized ? data[0] / 255.0f : data[0];
+        case GltfShort: { std::int16_t value; std::memcpy(&value, data, 2); return accessor.IsNormalized ? std::max<float>(value / 32767.0f, -1.0f) : value; }
+        case GltfUnsignedShort: { std::uint16_t value; std::memcpy(&value, data, 2); return accessor.IsNormalized ? value / 65535.0f : value; }
+        case GltfUnsignedInt: { std::uint32_t value; std::memcpy(&value, data, 4); return (float)value; }
+        default: { float value; std::memcpy(&value, data, 4); return value; }
+        }
+    }
+
+    std::uint32_t ReadGltfIndex(const GltfAccessor& accessor, std::uint32_t element)
+    {
+        const std::uint8_t* data = accessor.Data + (std::size_t)element * accessor.Stride;
+        switch (accessor.ComponentType)
+        {
+        case GltfUnsignedByte: return data[0];
+        case GltfUnsignedShort: { std::uint16_t value; std::memcpy(&value, data, 2); return value; }
+        default: { std::uint32_t value; std::memcpy(&value, data, 4); return value; }
+        }
+    }
+
+    // 프리미티브 하나를 mesh 끝에 붙인다. (노드 변환은 적용하지 않는다)
+    bool AppendGltfPrimitive(const JsonValue& root, const JsonValue& primitive, const std::vector<GltfBuffer>& buffers,
+        JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error)
+    {
+        const double mode = primitive.GetNumber("mode", 4.0);
+        if (mode != 4.0)
+            return true;    // 삼각형 리스트만 (점/선/스트립은 건너뛴다)
+
+        const JsonValue* attributes = primitive.Find("attributes");
+        const JsonValue* position = attributes != nullptr ? attributes->Find("POSITION") : nullptr;
+        if (position == nullptr)
+            return Fail(error, "glTF: primitive has no POSITION");
+
+        GltfAccessor positions, normals, texCs, indices;
+        if (!GetGltfAccessor(root, buffers, position->Number, positions, error))
+            return false;
+        if (const JsonValue* normal = attributes->Find("NORMAL"))
+        {
+            if (!GetGltfAccessor(root, buffers, normal->Number, normals, error))
+                return false;
+        }
+        if (const JsonValue* texC = attributes->Find("TEXCOORD_0"))
+        {
+            if (!GetGltfAccessor(root, buffers, texC->Number, texCs, error))
+                return false;
+        }
+        const JsonValue* indexAccessor = primitive.Find("indices");
+        if (indexAccessor != nullptr && !GetGltfAccessor(root, buffers, indexAccessor->Number, indices, error))
+            return false;
+
+        if (positions.ComponentCount != 3 ||
+            (normals.Data != nullptr && (normals.ComponentCount != 3 || normals.Count < positions.Count)) ||
+            (texCs.Data != nullptr && (texCs.ComponentCount != 2 || texCs.Count < positions.Count)) ||
+            (indexAccessor != nullptr && (indices.ComponentCount != 1 || indices.Data == nullptr ||
+                (indices.ComponentType != GltfUnsignedByte && indices.ComponentType != GltfUnsignedShort && indices.ComponentType != GltfUnsignedInt))))
+            return Fail(error, "glTF: unsupported attribute layout");
+
+        const std::uint32_t baseVertex = (std::uint32_t)mesh.Vertices.size();
+        const std::size_t baseIndex = mesh.Indices32.size();
+        const std::uint32_t indexCount = indexAccessor != nullptr ? indices.Count : positions.Count;
+        mesh.Vertices.resize(baseVertex + (std::size_t)positions.Count);
+        mesh.Indices32.resize(baseIndex + indexCount / 3 * 3);
+
+        JobCounter counter = jobs.ParallelFor(positions.Count, 16 * 1024, [&](std::uint32_t i)
+        {
+            GeometryGenerator::Vertex& vertex = mesh.Vertices[baseVertex + i];
+            vertex.Position = ToLeftHanded(ReadGltfComponent(positions, i, 0), ReadGltfComponent(positions, i, 1), ReadGltfComponent(positions, i, 2));
+            vertex.Normal = ToLeftHanded(ReadGltfComponent(normals, i, 0), ReadGltfComponent(normals, i, 1), ReadGltfComponent(normals, i, 2));
+            vertex.TangentU = XMFLOAT3(0.0f, 0.0f, 0.0f);
+            vertex.TexC = XMFLOAT2(ReadGltfComponent(texCs, i, 0), ReadGltfComponent(texCs, i, 1));   // glTF UV 원점은 이미 왼쪽 위
+        });
+        jobs.Wait(counter);
+
+        // 삼각형 단위로 감는 순서를 뒤집는다.
+        std::atomic<bool> isValid{ true };
+        counter = jobs.ParallelFor(indexCount / 3, 16 * 1024, [&](std::uint32_t triangle)
+        {
+            const std::uint32_t order[3] = { 0, 2, 1 };
+            for (std::uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const std::uint32_t element = triangle * 3 + order[corner];
+                const std::uint32_t index = indexAccessor != nullptr ? ReadGltfIndex(indices, element) : element;
+                if (index >= positions.Count)
+                {
+                    isValid = false;
+                    return;
+                }
+                mesh.Indices32[baseIndex + triangle * 3 + corner] = baseVertex + index;
+            }
+        });
+        jobs.Wait(counter);
+
+        return isValid || Fail(error, "glTF: index references a vertex that does not exist");
+    }
+}
+
+bool MeshImporter::Import(
+    const std::string& path,
+    JobSystem& jobs,
+    GeometryGenerator::MeshData& mesh,
+    std::string* error,
+    Stats* stats)
+{
+    auto start = Clock::now();
+
+    std::string extension = path.substr(path.find_last_of('.') == std::string::npos ? path.size() : path.find_last_of('.'));
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+
+    MappedFile file;
+    if (!file.Open(path))
+        return Fail(error, "cannot open " + path);
+    if (file.GetData() == nullptr)
+        return Fail(error, path + " is empty");
+
+    bool isImported = false;
+    if (extension == ".obj")
+        isImported = ImportObj(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), jobs, mesh, error, stats);
+    else if (extension == ".ply")
+        isImported = ImportPly(file.GetData(), file.GetSize(), jobs, mesh, error, stats);
+    else if (extension == ".glb" || extension == ".gltf")
+        isImported = ImportGltf(path, file.GetData(), file.GetSize(), jobs, mesh, error, stats);
+    else
+        return Fail(error, "unknown mesh format " + extension);
+
+    if (isImported && stats != nullptr)
+    {
+        stats->Bytes = file.GetSize();
+        stats->TotalMs = ElapsedMs(start);
+    }
+    return isImported;
+}
+
+bool MeshImporter::ImportObj(const char* text, std::size_t size, JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error, Stats* stats)
+{
+    auto start = Clock::now();
+
+    // 1. 줄 경계로 나눈 조각을 병렬 파싱
+    const std::vector<TextChunk> textChunks = SplitLines(text, size, GetChunkSize(size, jobs));
+    std::vector<ObjChunk> chunks(textChunks.size());
+
+    JobCounter counter = jobs.ParallelFor((std::uint32_t)chunks.size(), 1, [&](std::uint32_t index)
+    {
+        ParseObjChunk(textChunks[index], chunks[index]);
+    });
+    jobs.Wait(counter);
+
+    for (const ObjChunk& chunk : chunks)
+    {
+        if (!chunk.Error.empty())
+            return Fail(error, chunk.Error);
+    }
+
+    const double parseMs = ElapsedMs(start);
+    auto mergeStart = Clock::now();
+
+    // 2. 합치기 + 정점 중복 제거
+    std::vector<XMFLOAT3> positions;
+    std::vector<XMFLOAT2> texCs;
+    std::vector<XMFLOAT3> normals;
+    std::vector<ObjCorner> corners;
+    if (!MergeObjCorners(chunks, jobs, positions, texCs, normals, corners, error))
+        return false;
+
+    mesh = GeometryGenerator::MeshData();
+    WeldObjCorners(corners, positions, texCs, normals, jobs, mesh);
+
+    if (stats != nullptr)
+    {
+        stats->Bytes = size;
+        stats->Chunks = (std::uint32_t)chunks.size();
+        stats->Triangles = (std::uint32_t)(mesh.Indices32.size() / 3);
+        stats->Vertices = (std::uint32_t)mesh.Vertices.size();
+        stats->ParseMs = parseMs;
+        stats->MergeMs = ElapsedMs(mergeStart);
+        stats->TotalMs = ElapsedMs(start);
+    }
+    return true;
+}
+
+bool MeshImporter::ImportPly(const std::uint8_t* data, std::size_t size, JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error, Stats* stats)
+{
+    auto start = Clock::now();
+
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<PlyElement> elements;
+    std::size_t bodyOffset = 0;
+    if (!ParsePlyHeader(data, size, format, elements, bodyOffset, error))
+        return false;
+
+    mesh = GeometryGenerator::MeshData();
+    std::uint32_t chunkCount = 1;
+    const bool isImported = format == PlyFormat::Ascii
+        ? ImportPlyAscii(reinterpret_cast<const char*>(data) + bodyOffset, size - bodyOffset, elements, jobs, mesh, chunkCount, error)
+        : ImportPlyBinary(data + bodyOffset, size - bodyOffset, format == PlyFormat::BinaryBigEndian, elements, jobs, mesh, error);
+    if (!isImported)
+        return false;
+
+    if (stats != nullptr)
+    {
+        stats->Bytes = size;
+        stats->Chunks = chunkCount;
+        stats->Triangles = (std::uint32_t)(mesh.Indices32.size() / 3);
+        stats->Vertices = (std::uint32_t)mesh.Vertices.size();
+        stats->ParseMs = ElapsedMs(start);
+        stats->MergeMs = 0.0;
+        stats->TotalMs = stats->ParseMs;
+    }
+    return true;
+}
+
+bool MeshImporter::ImportGltf(const std::string& path, const std::uint8_t* data, std::size_t size, JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error, Stats* stats)
+{
+    auto start = Clock::now();
+
+    // .glb : [헤더 12바이트][JSON 청크][BIN 청크], .gltf : 파일 전체가 JSON
+    const char* json = reinterpret_cast<const char*>(data);
+    std::size_t jsonSize = size;
+    std::vector<GltfBuffer> buffers;
+
+    std::uint32_t magic = 0;
+    if (size >= 4)
+        std::memcpy(&magic, data, 4);
+
+    GltfBuffer binaryChunk;
+    if (magic == GlbMagic)
+    {
+        std::uint32_t header[3] = {};
+        if (size < 20)
+            return Fail(error, "glTF: file is truncated");
+        std::memcpy(header, data, sizeof(header));
+        if (header[1] != 2)
+            return Fail(error, "glTF: only version 2 is supported");
+
+        std::size_t offset = 12;
+        while (offset + 8 <= size)
+        {
+            std::uint32_t chunkHeader[2] = {};
+            std::memcpy(chunkHeader, data + offset, sizeof(chunkHeader));
+            offset += 8;
+            if (chunkHeader[0] > size - offset)
+                return Fail(error, "glTF: file is truncated");
+
+            if (chunkHeader[1] == GlbJsonChunk)
+            {
+                json = reinterpret_cast<const char*>(data + offset);
+                jsonSize = chunkHeader[0];
+            }
+            else if (chunkHeader[1] == GlbBinaryChunk && binaryChunk.Data == nullptr)
+            {
+                binaryChunk.Data = data + offset;
+                binaryChunk.Size = chunkHeader[0];
+            }
+            offset += (chunkHeader[0] + 3) & ~3u;
+        }
+    }
+
+    JsonValue root;
+    if (!JsonParser(json, jsonSize).Parse(root) || root.Kind != JsonValue::Type::Object)
+        return Fail(error, "glTF: cannot parse JSON");
+
+    // 버퍼 : uri가 없으면 .glb의 BIN 청크, 있으면 같은 폴더의 외부 파일을 매핑
+    std::vector<MappedFile> externalFiles;
+    if (const JsonValue* bufferList = root.Find("buffers"))
+    {
+        externalFiles.reserve(bufferList->Array.size());
+        for (const JsonValue& buffer : bufferList->Array)
+        {
+            const JsonValue* uri = buffer.Find("uri");
+            if (uri == nullptr)
+            {
+                buffers.push_back(binaryChunk);
+                continue;
+            }
+            if (uri->String.compare(0, 5, "data:") == 0)
+                return Fail(error, "glTF: embedded (data URI) buffers are not supported");
+
+            const std::size_t slash = path.find_last_of("/\\");
+            const std::string bufferPath = (slash == std::string::npos ? std::string() : path.substr(0, slash + 1)) + uri->String;
+            externalFiles.emplace_back();
+            if (!externalFiles.back().Open(bufferPath))
+                return Fail(error, "glTF: cannot open " + bufferPath);
+
+            GltfBuffer external;
+            external.Data = externalFiles.back().GetData();
+            external.Size = externalFiles.back().GetSize();
+            buffers.push_back(external);
+        }
+    }
+
+    const double parseMs = ElapsedMs(start);
+    auto mergeStart = Clock::now();
+
+    // 모든 메시의 프리미티브를 하나로 합친다.
+    mesh = GeometryGenerator::MeshData();
+    std::uint32_t primitiveCount = 0;
+    if (const JsonValue* meshes = root.Find("meshes"))
+    {
+        for (const JsonValue& gltfMesh : meshes->Array)
+        {
+            const JsonValue* primitives = gltfMesh.Find("primitives");
+            if (primitives == nullptr)
+                continue;
+
+            for (const JsonValue& primitive : primitives->Array)
+            {
+                if (!AppendGltfPrimitive(root, primitive, buffers, jobs, mesh, error))
+                    return false;
+                ++primitiveCount;
+            }
+        }
+    }
+
+    if (stats != nullptr)
+    {
+        stats->Bytes = size;
+        stats->Chunks = primitiveCount;
+        stats->Triangles = (std::uint32_t)(mesh.Indices32.size() / 3);
+        stats->Vertices = (std::uint32_t)mesh.Vertices.size();
+        stats->ParseMs = parseMs;
+        stats->MergeMs = ElapsedMs(mergeStart);
+        stats->TotalMs = ElapsedMs(start);
+    }
+    return true;
+}
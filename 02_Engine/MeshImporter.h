@@ -0,0 +1,42 @@
+#pragma once
+
+#include "GeometryGenerator.h"
+
+#include <cstdint>
+#include <string>
+
+class JobSystem;
+
+// 외부 메시 파일 -> GeometryGenerator::MeshData
+// - OBJ, PLY(ascii / binary), glTF(.glb, 외부 .bin을 쓰는 .gltf)를 지원한다.
+// - 원본 파일은 메모리 맵으로 열고, 텍스트는 줄 경계로 나눈 조각을 작업 스레드에서 std::from_chars로 병렬 파싱한 뒤 합친다.
+// - OBJ는 (위치, UV, 법선) 조합이 같은 꼭짓점을 해시 맵으로 합친다. 정점 순서는 처음 나온 순서라 스레드 수와 관계없이 같은 결과가 나온다.
+// - 폴리곤은 부채꼴로 삼각형 분할한다. 파일에 없는 법선/UV/탄젠트는 0
+class MeshImporter
+{
+public:
+    struct Stats
+    {
+        std::uint64_t Bytes = 0;        // 원본 파일 크기
+        std::uint32_t Chunks = 0;       // 병렬로 파싱한 조각 수
+        std::uint32_t Triangles = 0;
+        std::uint32_t Vertices = 0;     // 중복 제거 후
+        double ParseMs = 0.0;           // 조각 파싱
+        double MergeMs = 0.0;           // 조각 합치기 + 정점 중복 제거
+        double TotalMs = 0.0;           // 파일 열기부터 끝까지
+    };
+
+public:
+    // 확장자로 형식을 고른다. 실패하면 false (error에 이유)
+    static bool Import(
+        const std::string& path,
+        JobSystem& jobs,
+        GeometryGenerator::MeshData& mesh,
+        std::string* error = nullptr,
+        Stats* stats = nullptr);
+
+    // 메모리에 있는 내용 파싱 (path는 .gltf의 외부 버퍼 경로를 찾는 데만 쓴다)
+    static bool ImportObj(const char* text, std::size_t size, JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error = nullptr, Stats* stats = nullptr);
+    static bool ImportPly(const std::uint8_t* data, std::size_t size, JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error = nullptr, Stats* stats = nullptr);
+    static bool ImportGltf(const std::string& path, const std::uint8_t* data, std::size_t size, JobSystem& jobs, GeometryGenerator::MeshData& mesh, std::string* error = nullptr, Stats* stats = nullptr);
+};
@@ -0,0 +1,131 @@
+#include "MeshLoader.h"
+#include "UploadManager.h"
+
+#include <chrono>
+
+using namespace DirectX;
+
+std::unique_ptr<MeshGeometry> MeshLoader::Load(
+    const std::string& path,
+    const std::string& name,
+    UploadManager& uploadManager,
+    GpuMemoryAllocator* allocator,
+    Stats* stats)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    MeshFile file;
+    if (!file.Open(path))
+        return nullptr;
+
+    // 복사하기 전에 페이지를 미리 읽어 두면 memcpy가 페이지 폴트마다 멈추지 않는다.
+    file.Prefetch();
+
+    auto opened = std::chrono::high_resolution_clock::now();
+
+    std::unique_ptr<MeshGeometry> geo = Create(file, name, uploadManager, allocator, stats);
+
+    if (stats != nullptr)
+    {
+        const MeshFileHeader& header = file.GetHeader();
+        stats->Bytes = (UINT64)header.IndexStride * header.IndexCount;
+        stats->FileIndexBytes = header.IndexDataSize;
+        for (UINT i = 0; i < header.VertexStreamCount; ++i)
+            stats->Bytes += file.GetVertexDataSize(i);
+        stats->OpenMs = std::chrono::duration<double, std::milli>(opened - start).count();
+        stats->CopyMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - opened).count();
+    }
+
+    return geo;
+}
+
+std::unique_ptr<MeshGeometry> MeshLoader::Create(
+    const MeshFile& file,
+    const std::string& name,
+    UploadManager& uploadManager,
+    GpuMemoryAllocator* allocator,
+    Stats* stats)
+{
+    const MeshFileHeader& header = file.GetHeader();
+    const UINT64 indexByteSize = (UINT64)header.IndexStride * header.IndexCount;
+
+    // 압축된 인덱스는 버퍼를 만들기 전에 푼다. (깨졌으면 복사를 기록하기 전에 그만둔다)
+    std::vector<std::uint8_t> decodedIndices;
+    const void* indexData = file.GetIndexData();
+    if (file.IsIndexCompressed())
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        decodedIndices.resize((size_t)indexByteSize);
+        if (!file.DecodeIndices(decodedIndices.data()))
+            return nullptr;
+        indexData = decodedIndices.data();
+
+        if (stats != nullptr)
+            stats->DecodeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    auto geo = std::make_unique<MeshGeometry>();
+    geo->Name = name;
+
+    // 매핑 -> 스테이징 링 memcpy 한 번으로 끝난다. (스트림마다 버퍼 하나씩)
+    geo->VertexStreams.resize(header.VertexStreamCount);
+    for (UINT i = 0; i < header.VertexStreamCount; ++i)
+    {
+        VertexStream& stream = geo->VertexStreams[i];
+        stream.ByteStride = header.VertexStrides[i];
+        stream.ByteSize = (UINT)file.GetVertexDataSize(i);
+        stream.BufferGPU = uploadManager.CreateDefaultBuffer(file.GetVertexData(i), stream.ByteSize, allocator);
+    }
+    geo->IndexBufferGPU = uploadManager.CreateDefaultBuffer(indexData, indexByteSize, allocator);
+
+    geo->IndexFormat = header.IndexStride == 4 ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+    geo->IndexBufferByteSize = (UINT)indexByteSize;
+    geo->PositionScale = XMFLOAT3(header.PositionScale);
+    geo->PositionOffset = XMFLOAT3(header.PositionOffset);
+
+    const MeshFileSubmesh* submeshes = file.GetSubmeshes();
+    const MeshFileLod* lods = file.GetLods();
+    for (UINT i = 0; i < header.SubmeshCount; ++i)
+    {
+        const MeshFileSubmesh& source = submeshes[i];
+
+        SubmeshGeometry submesh;
+        submesh.IndexCount = source.IndexCount;
+        submesh.StartIndexLocation = source.StartIndex;
+        submesh.BaseVertexLocation = source.BaseVertex;
+        submesh.Bounds = ToBoundingBox(source.Bounds);
+
+        for (UINT lod = source.FirstLod; lod < source.FirstLod + source.LodCount; ++lod)
+        {
+            SubmeshLod submeshLod;
+            submeshLod.IndexCount = lods[lod].IndexCount;
+            submeshLod.StartIndexLocation = lods[lod].StartIndex;
+            submeshLod.ScreenSize = lods[lod].ScreenSize;
+            submesh.Lods.push_back(submeshLod);
+        }
+
+        geo->DrawArgs[source.Name] = std::move(submesh);
+    }
+
+    return geo;
+}
+
+MeshFileBounds MeshLoader::ToFileBounds(const BoundingBox& bounds)
+{
+    MeshFileBounds result;
+    result.Center[0] = bounds.Center.x;
+    result.Center[1] = bounds.Center.y;
+    result.Center[2] = bounds.Center.z;
+    result.Extents[0] = bounds.Extents.x;
+    result.Extents[1] = bounds.Extents.y;
+    result.Extents[2] = bounds.Extents.z;
+    return result;
+}
+
+BoundingBox MeshLoader::ToBoundingBox(const MeshFileBounds& bounds)
+{
+    return BoundingBox(
+        XMFLOAT3(bounds.Center[0], bounds.Center[1], bounds.Center[2]),
+        XMFLOAT3(bounds.Extents[0], bounds.Extents[1], bounds.Extents[2]));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/MeshFile.h"
+
+class GpuMemoryAllocator;
+class UploadManager;
+
+// 쿠킹된 메시 파일(.mesh) -> MeshGeometry
+// 파일을 매핑한 뒤 정점/인덱스를 매핑에서 바로 업로드 링으로 복사한다. (힙에 중간 복사본을 만들지 않는다)
+// 그래서 반환하는 MeshGeometry는 정점 스트림의 BufferCPU와 IndexBufferCPU가 비어 있다.
+// 인덱스가 압축되어 있으면 힙에 풀고 거기서 복사한다. (압축 해제가 디스크 읽기보다 빠르므로 파일이 작은 쪽이 이득)
+// 복사는 기록만 되므로 GPU 버퍼를 쓰기 전에 UploadManager::Submit()의 future를 기다려야 한다.
+class MeshLoader
+{
+public:
+    struct Stats
+    {
+        UINT64 Bytes = 0;           // 업로드한 정점 + 인덱스 크기
+        UINT64 FileIndexBytes = 0;  // 파일 안 인덱스 크기 (압축했으면 압축된 크기)
+        double OpenMs = 0.0;        // 파일 열기 + 검사
+        double CopyMs = 0.0;        // 매핑 -> 업로드 링 복사 기록 (인덱스 압축 해제 포함)
+        double DecodeMs = 0.0;      // 인덱스 압축 해제
+    };
+
+public:
+    // 파일이 없거나 형식이 맞지 않으면 nullptr
+    static std::unique_ptr<MeshGeometry> Load(
+        const std::string& path,
+        const std::string& name,
+        UploadManager& uploadManager,
+        GpuMemoryAllocator* allocator = nullptr,
+        Stats* stats = nullptr);
+
+    // 이미 연 파일에서 만든다. (file은 이 함수가 끝나면 닫아도 된다) 압축된 인덱스가 깨졌으면 nullptr
+    static std::unique_ptr<MeshGeometry> Create(
+        const MeshFile& file,
+        const std::string& name,
+        UploadManager& uploadManager,
+        GpuMemoryAllocator* allocator = nullptr,
+        Stats* stats = nullptr);
+
+    static MeshFileBounds ToFileBounds(const DirectX::BoundingBox& bounds);
+    static DirectX::BoundingBox ToBoundingBox(const MeshFileBounds& bounds);
+};
@@ -0,0 +1,403 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace DirectX;
+
+namespace
+{
+    using uint32 = MeshOptimizer::uint32;
+
+    const uint32 InvalidIndex = 0xFFFFFFFF;
+
+    // 정점 -> 그 정점을 쓰는 삼각형 목록 (CSR)
+    struct Adjacency
+    {
+        std::vector<uint32> Counts;     // 아직 출력하지 않은 삼각형 수
+        std::vector<uint32> Offsets;
+        std::vector<uint32> Triangles;
+    };
+
+    void BuildAdjacency(const uint32* indices, std::size_t indexCount, uint32 vertexCount, Adjacency& adjacency)
+    {
+        adjacency.Counts.assign(vertexCount, 0);
+        adjacency.Offsets.assign(vertexCount + 1, 0);
+        adjacency.Triangles.resize(indexCount);
+
+        for (std::size_t i = 0; i < indexCount; ++i)
+            ++adjacency.Counts[indices[i]];
+
+        for (uint32 v = 0; v < vertexCount; ++v)
+            adjacency.Offsets[v + 1] = adjacency.Offsets[v] + adjacency.Counts[v];
+
+        std::vector<uint32> cursors(adjacency.Offsets.begin(), adjacency.Offsets.end() - 1);
+        for (uint32 i = 0; i < (uint32)indexCount; ++i)
+            adjacency.Triangles[cursors[indices[i]]++] = i / 3;
+    }
+
+    // 타임스탬프로 흉내 낸 FIFO 캐시 : 마지막 cacheSize번의 미스 안에 들어온 정점이면 적중
+    // 클러스터마다 캐시를 비울 때는 Timestamp를 cacheSize + 1만큼 올리면 된다.
+    struct FifoCache
+    {
+        std::vector<uint32> Times;
+        uint32 Timestamp;
+        uint32 Size;
+
+        FifoCache(uint32 vertexCount, uint32 cacheSize) : Times(vertexCount, 0), Timestamp(cacheSize + 1), Size(cacheSize) {}
+
+        uint32 Access(uint32 vertex)
+        {
+            if (Timestamp - Times[vertex] <= Size)
+                return 0;
+            Times[vertex] = Timestamp++;
+            return 1;
+        }
+
+        void Reset() { Timestamp += Size + 1; }
+    };
+
+    // 삼각형 [begin, end)를 빈 캐시에서 그릴 때의 미스 수
+    uint32 CountMisses(const std::vector<uint32>& indices, uint32 begin, uint32 end, FifoCache& cache)
+    {
+        cache.Reset();
+        uint32 misses = 0;
+        for (uint32 triangle = begin; triangle < end; ++triangle)
+        {
+            for (uint32 corner = 0; corner < 3; ++corner)
+                misses += cache.Access(indices[triangle * 3 + corner]);
+        }
+        return misses;
+    }
+
+    // Tipsify 결과를 output에 쓴다. (입력을 끝까지 읽으므로 제자리에서 바꿀 수 없다)
+    void Tipsify(const uint32* indices, std::size_t indexCount, uint32 vertexCount, uint32 cacheSize, std::vector<uint32>& output, std::vector<uint32>* clusters)
+    {
+        const uint32 triangleCount = (uint32)indexCount / 3;
+
+        Adjacency adjacency;
+        BuildAdjacency(indices, indexCount, vertexCount, adjacency);
+
+        std::vector<uint32> cacheTimes(vertexCount, 0);
+        std::vector<bool> isEmitted(triangleCount, false);
+        std::vector<uint32> deadEnds;       // 최근에 쓴 정점 (막다른 곳에서 돌아갈 후보)
+        std::vector<uint32> candidates;
+        output.clear();
+        output.reserve(indexCount);
+
+        uint32 timestamp = cacheSize + 1;
+        uint32 inputCursor = 0;             // 후보가 다 떨어졌을 때 순서대로 찾을 위치
+        uint32 fanning = indices[0];        // 지금 부채꼴로 삼각형을 내보내는 정점
+
+        if (clusters != nullptr)
+            clusters->push_back(0);
+
+        for (;;)
+        {
+            // fanning 정점의 남은 삼각형을 모두 출력
+            candidates.clear();
+            for (uint32 i = adjacency.Offsets[fanning]; i < adjacency.Offsets[fanning + 1]; ++i)
+            {
+                const uint32 triangle = adjacency.Triangles[i];
+                if (isEmitted[triangle])
+                    continue;
+
+                for (uint32 corner = 0; corner < 3; ++corner)
+                {
+                    const uint32 v = indices[triangle * 3 + corner];
+                    output.push_back(v);
+                    deadEnds.push_back(v);
+                    candidates.push_back(v);
+                    --adjacency.Counts[v];
+
+                    if (timestamp - cacheTimes[v] > cacheSize)
+                        cacheTimes[v] = timestamp++;
+                }
+                isEmitted[triangle] = true;
+            }
+
+            // 다음 정점 : 캐시에 남아 있는 후보 중, 남은 삼각형을 다 내보내도 캐시에서 밀려나지 않을 만큼 최근 것
+            uint32 next = InvalidIndex;
+            uint32 bestPriority = 0;
+            for (uint32 v : candidates)
+            {
+                if (adjacency.Counts[v] == 0)
+                    continue;
+
+                uint32 priority = 0;
+                if (timestamp - cacheTimes[v] + 2 * adjacency.Counts[v] <= cacheSize)
+                    priority = timestamp - cacheTimes[v];
+
+                if (next == InvalidIndex || priority > bestPriority)
+                {
+                    next = v;
+                    bestPriority = priority;
+                }
+            }
+
+            if (next == InvalidIndex)
+            {
+                // 막다른 곳 : 최근에 쓴 정점을 거꾸로 보고, 그것도 없으면 입력 순서대로
+                while (!deadEnds.empty() && next == InvalidIndex)
+                {
+                    const uint32 v = deadEnds.back();
+                    deadEnds.pop_back();
+                    if (adjacency.Counts[v] > 0)
+                        next = v;
+                }
+
+                while (next == InvalidIndex && inputCursor < vertexCount)
+                {
+                    if (adjacency.Counts[inputCursor] > 0)
+                        next = inputCursor;
+                    ++inputCursor;
+                }
+
+                if (next == InvalidIndex)
+                    break;
+
+                // 캐시를 이어 쓰지 못하는 지점 = 오버드로 정렬의 클러스터 경계
+                if (clusters != nullptr)
+                    clusters->push_back((uint32)output.size() / 3);
+            }
+
+            fanning = next;
+        }
+    }
+}
+
+MeshOptimizer::Stats MeshOptimizer::Optimize(GeometryGenerator::MeshData& mesh, float overdrawThreshold, uint32 cacheSize)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Stats stats;
+    const uint32 vertexCount = (uint32)mesh.Vertices.size();
+    stats.FifoBefore = AnalyzeVertexCache(mesh.Indices32, vertexCount, cacheSize, CacheType::Fifo);
+    stats.LruBefore = AnalyzeVertexCache(mesh.Indices32, vertexCount, cacheSize, CacheType::Lru);
+
+    std::vector<uint32> clusters;
+    OptimizeVertexCache(mesh.Indices32, vertexCount, cacheSize, &clusters);
+    stats.ClusterCount = OptimizeOverdraw(mesh.Indices32, mesh.Vertices, clusters, cacheSize, overdrawThreshold);
+    OptimizeVertexFetch(mesh);
+
+    // 정점 fetch 순서는 캐시 효율에 영향이 없다. (정점 번호만 바뀐다)
+    stats.FifoAfter = AnalyzeVertexCache(mesh.Indices32, (uint32)mesh.Vertices.size(), cacheSize, CacheType::Fifo);
+    stats.LruAfter = AnalyzeVertexCache(mesh.Indices32, (uint32)mesh.Vertices.size(), cacheSize, CacheType::Lru);
+
+    stats.Ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize, std::vector<uint32>* clusters)
+{
+    if (clusters != nullptr)
+        clusters->clear();
+    if (indices.size() < 3)
+        return;
+
+    std::vector<uint32> output;
+    Tipsify(indices.data(), indices.size(), vertexCount, cacheSize, output, clusters);
+    indices.swap(output);
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32* indices, std::size_t indexCount, uint32 vertexCount, uint32 cacheSize, std::vector<uint32>* clusters)
+{
+    if (clusters != nullptr)
+        clusters->clear();
+    if (indexCount < 3)
+        return;
+
+    std::vector<uint32> output;
+    Tipsify(indices, indexCount, vertexCount, cacheSize, output, clusters);
+    std::copy(output.begin(), output.end(), indices);
+}
+
+uint32 MeshOptimizer::OptimizeOverdraw(
+    std::vector<uint32>& indices,
+    const std::vector<GeometryGenerator::Vertex>& vertices,
+    const std::vector<uint32>& hardClusters,
+    uint32 cacheSize,
+    float threshold)
+{
+    const uint32 triangleCount = (uint32)indices.size() / 3;
+    if (triangleCount == 0 || hardClusters.empty())
+        return 0;
+
+    // 1. 클러스터를 더 잘게 자른다. 클러스터 앞부분만으로 ACMR이 (클러스터 ACMR * threshold) 이하가 되면
+    //    그 지점에서 잘라도 캐시 효율이 크게 나빠지지 않는다.
+    FifoCache cache((uint32)vertices.size(), cacheSize);
+    std::vector<uint32> clusters;
+    for (std::size_t i = 0; i < hardClusters.size(); ++i)
+    {
+        const uint32 begin = hardClusters[i];
+        const uint32 end = i + 1 < hardClusters.size() ? hardClusters[i + 1] : triangleCount;
+        if (begin >= end)
+            continue;
+
+        const float clusterThreshold = threshold * CountMisses(indices, begin, end, cache) / (float)(end - begin);
+
+        clusters.push_back(begin);
+        cache.Reset();
+        uint32 misses = 0;
+        uint32 triangles = 0;
+        for (uint32 triangle = begin; triangle < end; ++triangle)
+        {
+            for (uint32 corner = 0; corner < 3; ++corner)
+                misses += cache.Access(indices[triangle * 3 + corner]);
+            ++triangles;
+
+            if ((float)misses / (float)triangles <= clusterThreshold && triangle + 1 < end)
+            {
+                clusters.push_back(triangle + 1);
+                cache.Reset();
+                misses = 0;
+                triangles = 0;
+            }
+        }
+    }
+
+    // 2. 클러스터마다 (중심 - 메시 중심) · 평균 법선 : 클수록 바깥을 향하므로 먼저 그린다.
+    XMVECTOR meshCenter = XMVectorZero();
+    for (const GeometryGenerator::Vertex& vertex : vertices)
+        meshCenter = XMVectorAdd(meshCenter, XMLoadFloat3(&vertex.Position));
+    meshCenter = XMVectorScale(meshCenter, vertices.empty() ? 0.0f : 1.0f / (float)vertices.size());
+
+    const uint32 clusterCount = (uint32)clusters.size();
+    std::vector<float> sortKeys(clusterCount);
+    for (uint32 cluster = 0; cluster < clusterCount; ++cluster)
+    {
+        const uint32 begin = clusters[cluster];
+        const uint32 end = cluster + 1 < clusterCount ? clusters[cluster + 1] : triangleCount;
+
+        // 면적 가중 (외적 길이 = 면적 * 2)
+        XMVECTOR center = XMVectorZero();
+        XMVECTOR normal = XMVectorZero();
+        float area = 0.0f;
+        for (uint32 triangle = begin; triangle < end; ++triangle)
+        {
+            const XMVECTOR p0 = XMLoadFloat3(&vertices[indices[triangle * 3 + 0]].Position);
+            const XMVECTOR p1 = XMLoadFloat3(&vertices[indices[triangle * 3 + 1]].Position);
+            const XMVECTOR p2 = XMLoadFloat3(&vertices[indices[triangle * 3 + 2]].Position);
+
+            const XMVECTOR cross = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+            const float triangleArea = XMVectorGetX(XMVector3Length(cross));
+
+            center = XMVectorAdd(center, XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), p2), triangleArea / 3.0f));
+            normal = XMVectorAdd(normal, cross);
+            area += triangleArea;
+        }
+
+        center = XMVectorScale(center, area > 0.0f ? 1.0f / area : 0.0f);
+        normal = XMVector3Normalize(normal);
+        sortKeys[cluster] = XMVectorGetX(XMVector3Dot(XMVectorSubtract(center, meshCenter), normal));
+    }
+
+    // 3. 키가 큰 클러스터부터 (같으면 원래 순서)
+    std::vector<uint32> order(clusterCount);
+    for (uint32 i = 0; i < clusterCount; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32 a, uint32 b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<uint32> output;
+    output.reserve(indices.size());
+    for (uint32 cluster : order)
+    {
+        const uint32 begin = clusters[cluster];
+        const uint32 end = cluster + 1 < clusterCount ? clusters[cluster + 1] : triangleCount;
+        output.insert(output.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+    }
+    indices.swap(output);
+
+    return clusterCount;
+}
+
+void MeshOptimizer::OptimizeVertexFetch(GeometryGenerator::MeshData& mesh)
+{
+    std::vector<uint32> remap(mesh.Vertices.size(), InvalidIndex);
+    std::vector<GeometryGenerator::Vertex> vertices;
+    vertices.reserve(mesh.Vertices.size());
+
+    for (uint32& index : mesh.Indices32)
+    {
+        if (remap[index] == InvalidIndex)
+        {
+            remap[index] = (uint32)vertices.size();
+            vertices.push_back(mesh.Vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    mesh.Vertices.swap(vertices);
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize, CacheType type)
+{
+    return AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, cacheSize, type);
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const uint32* indices, std::size_t indexCount, uint32 vertexCount, uint32 cacheSize, CacheType type)
+{
+    CacheStats stats;
+    if (indexCount < 3)
+        return stats;
+
+    uint32 misses = 0;
+    if (type == CacheType::Fifo)
+    {
+        FifoCache cache(vertexCount, cacheSize);
+        for (std::size_t i = 0; i < indexCount; ++i)
+            misses += cache.Access(indices[i]);
+    }
+    else
+    {
+        // 캐시가 작아서 배열에서 찾아 앞으로 옮기는 것으로 충분하다.
+        std::vector<uint32> cache;
+        cache.reserve(cacheSize + 1);
+        for (std::size_t i = 0; i < indexCount; ++i)
+        {
+            const uint32 index = indices[i];
+            auto it = std::find(cache.begin(), cache.end(), index);
+            if (it == cache.end())
+            {
+                ++misses;
+                cache.insert(cache.begin(), index);
+                if (cache.size() > cacheSize)
+                    cache.pop_back();
+            }
+            else
+            {
+                std::rotate(cache.begin(), it, it + 1);
+            }
+        }
+    }
+
+    // ATVR은 실제로 쓰인 정점 기준
+    std::vector<bool> isUsed(vertexCount, false);
+    uint32 usedCount = 0;
+    for (std::size_t i = 0; i < indexCount; ++i)
+    {
+        if (!isUsed[indices[i]])
+        {
+            isUsed[indices[i]] = true;
+            ++usedCount;
+        }
+    }
+
+    stats.Acmr = (float)misses / (float)(indexCount / 3);
+    stats.Atvr = (float)misses / (float)usedCount;
+    return stats;
+}
+
+std::string MeshOptimizer::GetStatsString(const std::string& name, const Stats& stats)
+{
+    char text[512];
+    snprintf(text, sizeof(text),
+        "MeshOptimizer %s: FIFO ACMR %.3f -> %.3f, ATVR %.3f -> %.3f / LRU ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %u clusters (%.2f ms)\n",
+        name.c_str(),
+        stats.FifoBefore.Acmr, stats.FifoAfter.Acmr, stats.FifoBefore.Atvr, stats.FifoAfter.Atvr,
+        stats.LruBefore.Acmr, stats.LruAfter.Acmr, stats.LruBefore.Atvr, stats.LruAfter.Atvr,
+        stats.ClusterCount, stats.Ms);
+    return text;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "GeometryGenerator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// MeshData 최적화 (빌드/임포트할 때 한 번)
+// 1. 정점 캐시 : Tipsify (Sander 2007)로 삼각형 순서를 바꿔서 변환 후 캐시 적중을 늘린다.
+// 2. 오버드로 : Tipsify 결과를 캐시 효율이 크게 나빠지지 않는 지점에서 클러스터로 자르고,
+//    바깥을 향하는 클러스터가 먼저 그려지도록 정렬한다. (가려질 면이 나중에 깊이 테스트에서 버려진다)
+// 3. 정점 fetch : 새 인덱스 순서에서 처음 쓰이는 순서대로 정점을 다시 배치한다.
+// 캐시 효율은 FIFO/LRU 캐시를 흉내 내서 ACMR(삼각형당 미스), ATVR(정점당 미스)로 잰다. (둘 다 낮을수록 좋고 ATVR 최소는 1)
+class MeshOptimizer
+{
+public:
+    using uint32 = std::uint32_t;
+
+    enum class CacheType
+    {
+        Fifo,   // 고정 기능 GPU 정점 캐시
+        Lru,
+    };
+
+    struct CacheStats
+    {
+        float Acmr = 0.0f;
+        float Atvr = 0.0f;
+    };
+
+    struct Stats
+    {
+        CacheStats FifoBefore;
+        CacheStats FifoAfter;
+        CacheStats LruBefore;
+        CacheStats LruAfter;
+        uint32 ClusterCount = 0;    // 오버드로 정렬에 쓴 클러스터 수
+        double Ms = 0.0;
+    };
+
+    static const uint32 DefaultCacheSize = 16;
+
+public:
+    // 세 단계를 모두 적용한다. overdrawThreshold는 클러스터를 자를 때 허용하는 ACMR 배율 (1이면 정점 캐시 순서 그대로)
+    static Stats Optimize(GeometryGenerator::MeshData& mesh, float overdrawThreshold = 1.05f, uint32 cacheSize = DefaultCacheSize);
+
+    // Tipsify. clusters가 있으면 막다른 곳에서 건너뛴 지점(삼각형 번호)을 받는다. (첫 값은 항상 0)
+    static void OptimizeVertexCache(std::vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize, std::vector<uint32>* clusters = nullptr);
+    // 메시 버퍼에 바로 쓴 인덱스를 그 자리에서 바꾼다.
+    static void OptimizeVertexCache(uint32* indices, std::size_t indexCount, uint32 vertexCount, uint32 cacheSize, std::vector<uint32>* clusters = nullptr);
+
+    // hardClusters는 OptimizeVertexCache가 돌려준 경계. 정렬한 클러스터 수를 돌려준다.
+    static uint32 OptimizeOverdraw(
+        std::vector<uint32>& indices,
+        const std::vector<GeometryGenerator::Vertex>& vertices,
+        const std::vector<uint32>& hardClusters,
+        uint32 cacheSize,
+        float threshold);
+
+    // 쓰이지 않는 정점은 빠진다.
+    static void OptimizeVertexFetch(GeometryGenerator::MeshData& mesh);
+
+    static CacheStats AnalyzeVertexCache(const std::vector<uint32>& indices, uint32 vertexCount, uint32 cacheSize, CacheType type);
+    static CacheStats AnalyzeVertexCache(const uint32* indices, std::size_t indexCount, uint32 vertexCount, uint32 cacheSize, CacheType type);
+
+    static std::string GetStatsString(const std::string& name, const Stats& stats);
+};
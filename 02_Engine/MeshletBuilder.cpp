@@ -0,0 +1,315 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace DirectX;
+
+namespace
+{
+    using uint32 = MeshletBuilder::uint32;
+
+    const uint32 InvalidIndex = 0xFFFFFFFF;
+
+    // 법선이 이보다 넓게 퍼져 있으면 (원뿔 반각이 약 84도 이상) 원뿔 컬링이 거의 맞지 않으므로 쓰지 않는다.
+    const float MinConeDot = 0.1f;
+
+    XMVECTOR LoadPosition(const GeometryGenerator::MeshData& mesh, uint32 vertex)
+    {
+        return XMLoadFloat3(&mesh.Vertices[vertex].Position);
+    }
+
+    // 경계 구 (Ritter) : 축마다 가장 먼 두 점 중 제일 먼 쌍으로 시작해서 밖에 있는 점을 만날 때마다 키운다.
+    void ComputeSphere(const GeometryGenerator::MeshData& mesh, const uint32* vertices, uint32 count, MeshFileMeshlet& meshlet)
+    {
+        uint32 minVertex[3] = { vertices[0], vertices[0], vertices[0] };
+        uint32 maxVertex[3] = { vertices[0], vertices[0], vertices[0] };
+        for (uint32 i = 1; i < count; ++i)
+        {
+            const XMFLOAT3& p = mesh.Vertices[vertices[i]].Position;
+            const float coords[3] = { p.x, p.y, p.z };
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                const XMFLOAT3& minP = mesh.Vertices[minVertex[axis]].Position;
+                const XMFLOAT3& maxP = mesh.Vertices[maxVertex[axis]].Position;
+                const float minCoords[3] = { minP.x, minP.y, minP.z };
+                const float maxCoords[3] = { maxP.x, maxP.y, maxP.z };
+                if (coords[axis] < minCoords[axis])
+                    minVertex[axis] = vertices[i];
+                if (coords[axis] > maxCoords[axis])
+                    maxVertex[axis] = vertices[i];
+            }
+        }
+
+        int bestAxis = 0;
+        float bestDistance = -1.0f;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float distance = XMVectorGetX(XMVector3LengthSq(LoadPosition(mesh, maxVertex[axis]) - LoadPosition(mesh, minVertex[axis])));
+            if (distance > bestDistance)
+            {
+                bestAxis = axis;
+                bestDistance = distance;
+            }
+        }
+
+        XMVECTOR center = (LoadPosition(mesh, minVertex[bestAxis]) + LoadPosition(mesh, maxVertex[bestAxis])) * 0.5f;
+        float radius = std::sqrt(bestDistance) * 0.5f;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const XMVECTOR p = LoadPosition(mesh, vertices[i]);
+            const float distance = XMVectorGetX(XMVector3Length(p - center));
+            if (distance > radius)
+            {
+                // 구가 원래 구와 p를 모두 감싸도록 p 쪽으로 옮긴다.
+                const float newRadius = (radius + distance) * 0.5f;
+                center += (p - center) * ((newRadius - radius) / distance);
+                radius = newRadius;
+            }
+        }
+
+        XMFLOAT3 c;
+        XMStoreFloat3(&c, center);
+        meshlet.Center[0] = c.x;
+        meshlet.Center[1] = c.y;
+        meshlet.Center[2] = c.z;
+        meshlet.Radius = radius;
+    }
+
+    // 법선 원뿔 : 축은 삼각형 법선의 평균, cutoff는 축과 가장 벌어진 법선의 sin
+    // 꼭짓점은 축을 따라 뒤로 물려서 모든 삼각형 평면의 뒤쪽에 오게 한다. (원근 투영에서도 보수적)
+    void ComputeCone(const GeometryGenerator::MeshData& mesh, const MeshletBuilder::MeshletData& data, MeshFileMeshlet& meshlet)
+    {
+        const uint32* localVertices = &data.Vertices[meshlet.VertexOffset];
+        const uint32* triangles = &data.Triangles[meshlet.TriangleOffset];
+
+        std::vector<XMVECTOR> normals;
+        normals.reserve(meshlet.TriangleCount);
+
+        XMVECTOR axis = XMVectorZero();
+        for (uint32 i = 0; i < meshlet.TriangleCount; ++i)
+        {
+            uint32 a, b, c;
+            MeshletBuilder::UnpackTriangle(triangles[i], a, b, c);
+            const XMVECTOR p0 = LoadPosition(mesh, localVertices[a]);
+            const XMVECTOR p1 = LoadPosition(mesh, localVertices[b]);
+            const XMVECTOR p2 = LoadPosition(mesh, localVertices[c]);
+
+            // 왼손 좌표계, 시계 방향이 앞면
+            const XMVECTOR normal = XMVector3Cross(p1 - p0, p2 - p0);
+            if (XMVectorGetX(XMVector3LengthSq(normal)) == 0.0f)
+                continue;
+
+            normals.push_back(XMVector3Normalize(normal));
+            axis += normals.back();
+        }
+
+        meshlet.ConeCutoff = 1.0f;
+        if (normals.empty() || XMVectorGetX(XMVector3LengthSq(axis)) == 0.0f)
+            return;
+
+        axis = XMVector3Normalize(axis);
+        float minDot = 1.0f;
+        for (const XMVECTOR& normal : normals)
+            minDot = std::min<float>(minDot, XMVectorGetX(XMVector3Dot(axis, normal)));
+        if (minDot <= MinConeDot)
+            return;
+
+        // 삼각형 평면이 축과 만나는 점 중 가장 뒤 (구 중심 기준)
+        const XMVECTOR center = XMVectorSet(meshlet.Center[0], meshlet.Center[1], meshlet.Center[2], 0.0f);
+        float maxT = 0.0f;
+        for (uint32 i = 0, n = 0; i < meshlet.TriangleCount; ++i)
+        {
+            uint32 a, b, c;
+            MeshletBuilder::UnpackTriangle(triangles[i], a, b, c);
+            const XMVECTOR p0 = LoadPosition(mesh, localVertices[a]);
+            const XMVECTOR p1 = LoadPosition(mesh, localVertices[b]);
+            const XMVECTOR p2 = LoadPosition(mesh, localVertices[c]);
+            if (XMVectorGetX(XMVector3LengthSq(XMVector3Cross(p1 - p0, p2 - p0))) == 0.0f)
+                continue;
+
+            const XMVECTOR& normal = normals[n++];
+            const float dc = XMVectorGetX(XMVector3Dot(center - p0, normal));
+            const float dn = XMVectorGetX(XMVector3Dot(axis, normal));
+            maxT = std::max<float>(maxT, dc / dn);
+        }
+
+        XMFLOAT3 apex;
+        XMFLOAT3 coneAxis;
+        XMStoreFloat3(&apex, center - axis * maxT);
+        XMStoreFloat3(&coneAxis, axis);
+        meshlet.ConeApex[0] = apex.x;
+        meshlet.ConeApex[1] = apex.y;
+        meshlet.ConeApex[2] = apex.z;
+        meshlet.ConeAxis[0] = coneAxis.x;
+        meshlet.ConeAxis[1] = coneAxis.y;
+        meshlet.ConeAxis[2] = coneAxis.z;
+        meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+MeshletBuilder::Stats MeshletBuilder::Build(
+    const GeometryGenerator::MeshData& mesh,
+    MeshletData& data,
+    uint32 maxVertices,
+    uint32 maxTriangles)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    data.Meshlets.clear();
+    data.Vertices.clear();
+    data.Triangles.clear();
+
+    maxVertices = std::min<uint32>(std::max<uint32>(maxVertices, 3), MaxVerticesLimit);
+    maxTriangles = std::min<uint32>(std::max<uint32>(maxTriangles, 1), MaxTrianglesLimit);
+
+    const std::vector<uint32>& indices = mesh.Indices32;
+    const uint32 vertexCount = (uint32)mesh.Vertices.size();
+    const uint32 triangleCount = (uint32)indices.size() / 3;
+
+    // 정점 -> 삼각형 (CSR). liveCounts는 아직 메시렛에 들어가지 않은 삼각형 수
+    std::vector<uint32> liveCounts(vertexCount, 0);
+    std::vector<uint32> offsets(vertexCount + 1, 0);
+    std::vector<uint32> adjacency(indices.size());
+    for (uint32 index : indices)
+        ++liveCounts[index];
+    for (uint32 v = 0; v < vertexCount; ++v)
+        offsets[v + 1] = offsets[v] + liveCounts[v];
+    {
+        std::vector<uint32> cursors(offsets.begin(), offsets.end() - 1);
+        for (uint32 i = 0; i < (uint32)indices.size(); ++i)
+            adjacency[cursors[indices[i]]++] = i / 3;
+    }
+
+    std::vector<bool> isEmitted(triangleCount, false);
+    std::vector<uint32> localIndex(vertexCount, InvalidIndex);     // 지금 메시렛 안의 정점 번호
+    std::vector<uint32> candidateMark(triangleCount, InvalidIndex);  // 후보 목록에 넣은 메시렛 번호 (중복 방지)
+    std::vector<uint32> candidates;
+
+    MeshFileMeshlet meshlet;
+    uint32 seedCursor = 0;
+
+    auto addTriangle = [&](uint32 triangle)
+    {
+        uint32 corners[3];
+        for (uint32 corner = 0; corner < 3; ++corner)
+        {
+            const uint32 v = indices[triangle * 3 + corner];
+            if (localIndex[v] == InvalidIndex)
+            {
+                localIndex[v] = meshlet.VertexCount++;
+                data.Vertices.push_back(v);
+
+                // 새 정점에 붙은 삼각형이 다음 후보
+                const uint32 meshletIndex = (uint32)data.Meshlets.size();
+                for (uint32 i = offsets[v]; i < offsets[v + 1]; ++i)
+                {
+                    const uint32 neighbor = adjacency[i];
+                    if (!isEmitted[neighbor] && candidateMark[neighbor] != meshletIndex)
+                    {
+                        candidateMark[neighbor] = meshletIndex;
+                        candidates.push_back(neighbor);
+                    }
+                }
+            }
+            corners[corner] = localIndex[v];
+            --liveCounts[v];
+        }
+
+        data.Triangles.push_back(PackTriangle(corners[0], corners[1], corners[2]));
+        ++meshlet.TriangleCount;
+        isEmitted[triangle] = true;
+    };
+
+    auto finishMeshlet = [&]()
+    {
+        for (uint32 i = meshlet.VertexOffset; i < meshlet.VertexOffset + meshlet.VertexCount; ++i)
+            localIndex[data.Vertices[i]] = InvalidIndex;
+
+        ComputeSphere(mesh, &data.Vertices[meshlet.VertexOffset], meshlet.VertexCount, meshlet);
+        ComputeCone(mesh, data, meshlet);
+        data.Meshlets.push_back(meshlet);
+
+        meshlet = MeshFileMeshlet();
+        meshlet.VertexOffset = (uint32)data.Vertices.size();
+        meshlet.TriangleOffset = (uint32)data.Triangles.size();
+        candidates.clear();
+    };
+
+    for (;;)
+    {
+        // 시작 삼각형 : 입력 순서대로 아직 안 쓴 첫 삼각형
+        while (seedCursor < triangleCount && isEmitted[seedCursor])
+            ++seedCursor;
+        if (seedCursor == triangleCount)
+            break;
+
+        addTriangle(seedCursor);
+
+        while (meshlet.TriangleCount < maxTriangles)
+        {
+            // 후보 중 새 정점이 가장 적은 것, 같으면 남은 삼각형이 적은 정점을 쓰는 것
+            uint32 best = InvalidIndex;
+            uint32 bestNew = 4;
+            uint32 bestLive = 0;
+            uint32 kept = 0;
+            for (uint32 triangle : candidates)
+            {
+                if (isEmitted[triangle])
+                    continue;
+                candidates[kept++] = triangle;
+
+                uint32 newVertices = 0;
+                uint32 live = 0;
+                for (uint32 corner = 0; corner < 3; ++corner)
+                {
+                    const uint32 v = indices[triangle * 3 + corner];
+                    newVertices += localIndex[v] == InvalidIndex ? 1 : 0;
+                    live += liveCounts[v];
+                }
+
+                if (meshlet.VertexCount + newVertices > maxVertices)
+                    continue;
+                if (newVertices < bestNew || (newVertices == bestNew && live < bestLive))
+                {
+                    best = triangle;
+                    bestNew = newVertices;
+                    bestLive = live;
+                }
+            }
+            candidates.resize(kept);
+
+            if (best == InvalidIndex)
+                break;
+            addTriangle(best);
+        }
+
+        finishMeshlet();
+    }
+
+    Stats stats;
+    stats.MeshletCount = (uint32)data.Meshlets.size();
+    if (stats.MeshletCount > 0)
+    {
+        uint32 cullable = 0;
+        for (const MeshFileMeshlet& m : data.Meshlets)
+            cullable += m.ConeCutoff < 1.0f ? 1 : 0;
+
+        stats.AverageVertices = (float)data.Vertices.size() / stats.MeshletCount;
+        stats.AverageTriangles = (float)data.Triangles.size() / stats.MeshletCount;
+        stats.ConeCullable = (float)cullable / stats.MeshletCount;
+    }
+    stats.Ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return stats;
+}
+
+std::string MeshletBuilder::GetStatsString(const std::string& name, const Stats& stats)
+{
+    char text[512];
+    snprintf(text, sizeof(text),
+        "MeshletBuilder %s: %u meshlets, %.1f vertices / %.1f triangles per meshlet, %.0f%% cone cullable (%.2f ms)\n",
+        name.c_str(), stats.MeshletCount, stats.AverageVertices, stats.AverageTriangles, stats.ConeCullable * 100.0f, stats.Ms);
+    return text;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "GeometryGenerator.h"
+#include "../01_Core/MeshFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// MeshData -> 메시렛 (메시 셰이더 / GPU 컬링용, 빌드/임포트할 때 한 번)
+// - 삼각형 하나에서 시작해서, 이미 들어간 정점에 붙은 삼각형 중 새 정점이 가장 적게 늘어나는 것을 하나씩 더한다.
+//   (같으면 남은 삼각형이 적은 정점 쪽 = 경계부터 채워서 구멍이 덜 생긴다)
+//   붙은 삼각형이 없거나 정점/삼각형 수가 차면 다음 메시렛을 시작한다.
+// - 메시렛마다 경계 구와 법선 원뿔을 계산한다. (형식은 MeshFile.h의 MeshFileMeshlet)
+// - 삼각형 순서가 지역성이 좋을수록 (MeshOptimizer를 먼저 돌리면) 시작 삼각형도 가까운 곳에서 고른다.
+class MeshletBuilder
+{
+public:
+    using uint32 = std::uint32_t;
+
+    // 메시 셰이더 권장값 (정점 64개, 삼각형 124개면 출력 버퍼가 16KB 안에 들어간다)
+    static const uint32 DefaultMaxVertices = 64;
+    static const uint32 DefaultMaxTriangles = 124;
+
+    // 삼각형을 메시렛 정점 번호 8비트 3개로 묶으므로 정점은 256개까지
+    static const uint32 MaxVerticesLimit = 256;
+    static const uint32 MaxTrianglesLimit = 512;
+
+    // MeshFileDesc의 메시렛 표에 그대로 옮길 수 있는 형식
+    struct MeshletData
+    {
+        std::vector<MeshFileMeshlet> Meshlets;
+        std::vector<uint32> Vertices;       // 메시 정점 번호
+        std::vector<uint32> Triangles;      // 메시렛 안 정점 번호 3개 (8비트씩)
+    };
+
+    struct Stats
+    {
+        uint32 MeshletCount = 0;
+        float AverageVertices = 0.0f;
+        float AverageTriangles = 0.0f;
+        float ConeCullable = 0.0f;          // 법선 원뿔로 컬링할 수 있는 메시렛 비율
+        double Ms = 0.0;
+    };
+
+public:
+    static Stats Build(
+        const GeometryGenerator::MeshData& mesh,
+        MeshletData& meshlets,
+        uint32 maxVertices = DefaultMaxVertices,
+        uint32 maxTriangles = DefaultMaxTriangles);
+
+    static uint32 PackTriangle(uint32 a, uint32 b, uint32 c) { return a | (b << 8) | (c << 16); }
+    static void UnpackTriangle(uint32 packed, uint32& a, uint32& b, uint32& c)
+    {
+        a = packed & 0xFF;
+        b = (packed >> 8) & 0xFF;
+        c = (packed >> 16) & 0xFF;
+    }
+
+    static std::string GetStatsString(const std::string& name, const Stats& stats);
+};
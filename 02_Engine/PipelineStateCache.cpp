@@ -0,0 +1,548 @@
+#include "PipelineStateCache.h"
+#include "DeferredReleaseQueue.h"
+#include "../01_Core/Hasher.h"
+#include "../01_Core/PipelineDescHash.h"
+#include "../01_Core/MappedFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // 작업 스레드에서 쓸 PSO 설명 사본 (포인터가 가리키는 내용까지 복사)
+    struct GraphicsDescCopy
+    {
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC Desc = {};
+        std::vector<std::uint8_t> Shaders[5];
+        std::vector<D3D12_INPUT_ELEMENT_DESC> InputElements;
+        std::vector<D3D12_SO_DECLARATION_ENTRY> StreamOutputEntries;
+        std::vector<UINT> StreamOutputStrides;
+        std::deque<std::string> Names;      // 시맨틱 이름 (deque라서 추가해도 앞의 문자열 주소가 바뀌지 않는다)
+    };
+
+    D3D12_SHADER_BYTECODE CopyShader(const D3D12_SHADER_BYTECODE& shader, std::vector<std::uint8_t>& storage)
+    {
+        if (shader.BytecodeLength == 0)
+            return D3D12_SHADER_BYTECODE{ nullptr, 0 };
+
+        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(shader.pShaderBytecode);
+        storage.assign(bytes, bytes + shader.BytecodeLength);
+        return D3D12_SHADER_BYTECODE{ storage.data(), storage.size() };
+    }
+
+    const char* CopyName(const char* name, std::deque<std::string>& names)
+    {
+        if (name == nullptr)
+            return nullptr;
+
+        names.emplace_back(name);
+        return names.back().c_str();
+    }
+
+    std::shared_ptr<GraphicsDescCopy> CopyGraphicsDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+    {
+        std::shared_ptr<GraphicsDescCopy> copy = std::make_shared<GraphicsDescCopy>();
+        copy->Desc = desc;
+
+        D3D12_SHADER_BYTECODE* shaders[] = { &copy->Desc.VS, &copy->Desc.PS, &copy->Desc.DS, &copy->Desc.HS, &copy->Desc.GS };
+        for (size_t i = 0; i < _countof(shaders); ++i)
+            *shaders[i] = CopyShader(*shaders[i], copy->Shaders[i]);
+
+        const D3D12_INPUT_LAYOUT_DESC& inputLayout = desc.InputLayout;
+        if (inputLayout.NumElements > 0)
+        {
+            copy->InputElements.assign(inputLayout.pInputElementDescs, inputLayout.pInputElementDescs + inputLayout.NumElements);
+            for (D3D12_INPUT_ELEMENT_DESC& element : copy->InputElements)
+                element.SemanticName = CopyName(element.SemanticName, copy->Names);
+        }
+        copy->Desc.InputLayout = { copy->InputElements.data(), (UINT)copy->InputElements.size() };
+
+        const D3D12_STREAM_OUTPUT_DESC& streamOutput = desc.StreamOutput;
+        if (streamOutput.NumEntries > 0)
+        {
+            copy->StreamOutputEntries.assign(streamOutput.pSODeclaration, streamOutput.pSODeclaration + streamOutput.NumEntries);
+            for (D3D12_SO_DECLARATION_ENTRY& entry : copy->StreamOutputEntries)
+                entry.SemanticName = CopyName(entry.SemanticName, copy->Names);
+        }
+        if (streamOutput.NumStrides > 0)
+            copy->StreamOutputStrides.assign(streamOutput.pBufferStrides, streamOutput.pBufferStrides + streamOutput.NumStrides);
+        copy->Desc.StreamOutput.pSODeclaration = copy->StreamOutputEntries.data();
+        copy->Desc.StreamOutput.pBufferStrides = copy->StreamOutputStrides.data();
+
+        // 드라이버 캐시 블롭은 파이프라인 라이브러리가 대신한다.
+        copy->Desc.CachedPSO = {};
+        return copy;
+    }
+
+    PipelineShaderDesc ToPipelineShader(const D3D12_SHADER_BYTECODE& shader)
+    {
+        PipelineShaderDesc result;
+        result.Data = shader.pShaderBytecode;
+        result.Size = shader.BytecodeLength;
+        return result;
+    }
+
+    PipelineStencilOpDesc ToPipelineStencilOp(const D3D12_DEPTH_STENCILOP_DESC& desc)
+    {
+        PipelineStencilOpDesc result;
+        result.StencilFailOp = desc.StencilFailOp;
+        result.StencilDepthFailOp = desc.StencilDepthFailOp;
+        result.StencilPassOp = desc.StencilPassOp;
+        result.StencilFunc = desc.StencilFunc;
+        return result;
+    }
+
+    // 해시용 설명으로 옮긴다. (포인터가 가리키는 내용은 복사하지 않으므로 desc가 살아 있는 동안만 쓴다)
+    GraphicsPipelineDesc ToPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, std::uint64_t rootSignatureHash)
+    {
+        GraphicsPipelineDesc result;
+        result.RootSignatureHash = rootSignatureHash;
+
+        result.VS = ToPipelineShader(desc.VS);
+        result.PS = ToPipelineShader(desc.PS);
+        result.DS = ToPipelineShader(desc.DS);
+        result.HS = ToPipelineShader(desc.HS);
+        result.GS = ToPipelineShader(desc.GS);
+
+        const D3D12_STREAM_OUTPUT_DESC& streamOutput = desc.StreamOutput;
+        for (UINT i = 0; i < streamOutput.NumEntries; ++i)
+        {
+            const D3D12_SO_DECLARATION_ENTRY& entry = streamOutput.pSODeclaration[i];
+            PipelineStreamOutputEntry element;
+            element.Stream = entry.Stream;
+            element.SemanticName = entry.SemanticName;
+            element.SemanticIndex = entry.SemanticIndex;
+            element.StartComponent = entry.StartComponent;
+            element.ComponentCount = entry.ComponentCount;
+            element.OutputSlot = entry.OutputSlot;
+            result.StreamOutputEntries.push_back(element);
+        }
+        if (streamOutput.NumEntries > 0)
+            result.StreamOutputStrides.assign(streamOutput.pBufferStrides, streamOutput.pBufferStrides + streamOutput.NumStrides);
+        result.RasterizedStream = streamOutput.RasterizedStream;
+
+        result.BlendState.AlphaToCoverageEnable = desc.BlendState.AlphaToCoverageEnable;
+        result.BlendState.IndependentBlendEnable = desc.BlendState.IndependentBlendEnable;
+        for (UINT i = 0; i < 8; ++i)
+        {
+            const D3D12_RENDER_TARGET_BLEND_DESC& rt = desc.BlendState.RenderTarget[i];
+            PipelineRenderTargetBlendDesc& target = result.BlendState.RenderTarget[i];
+            target.BlendEnable = rt.BlendEnable;
+            target.LogicOpEnable = rt.LogicOpEnable;
+            target.SrcBlend = rt.SrcBlend;
+            target.DestBlend = rt.DestBlend;
+            target.BlendOp = rt.BlendOp;
+            target.SrcBlendAlpha = rt.SrcBlendAlpha;
+            target.DestBlendAlpha = rt.DestBlendAlpha;
+            target.BlendOpAlpha = rt.BlendOpAlpha;
+            target.LogicOp = rt.LogicOp;
+            target.RenderTargetWriteMask = rt.RenderTargetWriteMask;
+        }
+        result.SampleMask = desc.SampleMask;
+
+        const D3D12_RASTERIZER_DESC& rasterizer = desc.RasterizerState;
+        result.RasterizerState.FillMode = rasterizer.FillMode;
+        result.RasterizerState.CullMode = rasterizer.CullMode;
+        result.RasterizerState.FrontCounterClockwise = rasterizer.FrontCounterClockwise;
+        result.RasterizerState.DepthBias = rasterizer.DepthBias;
+        result.RasterizerState.DepthBiasClamp = rasterizer.DepthBiasClamp;
+        result.RasterizerState.SlopeScaledDepthBias = rasterizer.SlopeScaledDepthBias;
+        result.RasterizerState.DepthClipEnable = rasterizer.DepthClipEnable;
+        result.RasterizerState.MultisampleEnable = rasterizer.MultisampleEnable;
+        result.RasterizerState.AntialiasedLineEnable = rasterizer.AntialiasedLineEnable;
+        result.RasterizerState.ForcedSampleCount = rasterizer.ForcedSampleCount;
+        result.RasterizerState.ConservativeRaster = rasterizer.ConservativeRaster;
+
+        const D3D12_DEPTH_STENCIL_DESC& depthStencil = desc.DepthStencilState;
+        result.DepthStencilState.DepthEnable = depthStencil.DepthEnable;
+        result.DepthStencilState.DepthWriteMask = depthStencil.DepthWriteMask;
+        result.DepthStencilState.DepthFunc = depthStencil.DepthFunc;
+        result.DepthStencilState.StencilEnable = depthStencil.StencilEnable;
+        result.DepthStencilState.StencilReadMask = depthStencil.StencilReadMask;
+        result.DepthStencilState.StencilWriteMask = depthStencil.StencilWriteMask;
+        result.DepthStencilState.FrontFace = ToPipelineStencilOp(depthStencil.FrontFace);
+        result.DepthStencilState.BackFace = ToPipelineStencilOp(depthStencil.BackFace);
+
+        result.InputLayout.resize(desc.InputLayout.NumElements);
+        for (UINT i = 0; i < desc.InputLayout.NumElements; ++i)
+        {
+            const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+            PipelineInputElementDesc& target = result.InputLayout[i];
+            target.SemanticName = element.SemanticName;
+            target.SemanticIndex = element.SemanticIndex;
+            target.Format = element.Format;
+            target.InputSlot = element.InputSlot;
+            target.AlignedByteOffset = element.AlignedByteOffset;
+            target.InputSlotClass = element.InputSlotClass;
+            target.InstanceDataStepRate = element.InstanceDataStepRate;
+        }
+
+        result.IBStripCutValue = desc.IBStripCutValue;
+        result.PrimitiveTopologyType = desc.PrimitiveTopologyType;
+        result.NumRenderTargets = desc.NumRenderTargets;
+        for (UINT i = 0; i < 8; ++i)
+            result.RTVFormats[i] = desc.RTVFormats[i];
+        result.DSVFormat = desc.DSVFormat;
+        result.SampleCount = desc.SampleDesc.Count;
+        result.SampleQuality = desc.SampleDesc.Quality;
+        result.NodeMask = desc.NodeMask;
+        result.Flags = desc.Flags;
+        return result;
+    }
+}
+
+PipelineStateCache::~PipelineStateCache()
+{
+    // 작업 스레드가 이 객체에 결과를 쓰므로 끝날 때까지 기다린다.
+    WaitForPending();
+}
+
+void PipelineStateCache::Initialize(ID3D12Device* device, const std::string& libraryPath, JobSystem* jobSystem, DeferredReleaseQueue* releaseQueue)
+{
+    md3dDevice = device;
+    mJobSystem = jobSystem;
+    mReleaseQueue = releaseQueue;
+    mLibraryPath = libraryPath;
+
+    // 파이프라인 라이브러리는 ID3D12Device1부터 지원
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(&device1))))
+        return;
+
+    MappedFile file;
+    if (file.Open(libraryPath) && file.GetSize() > 0)
+    {
+        mLibraryData.assign(file.GetData(), file.GetData() + file.GetSize());
+
+        // 드라이버/어댑터가 바뀌었거나 손상된 파일이면 실패한다. (D3D12_ERROR_DRIVER_VERSION_MISMATCH 등)
+        if (FAILED(device1->CreatePipelineLibrary(mLibraryData.data(), mLibraryData.size(), IID_PPV_ARGS(&mLibrary))))
+        {
+            mLibrary = nullptr;
+            mLibraryData.clear();
+        }
+    }
+
+    if (mLibrary == nullptr)
+    {
+        // 빈 라이브러리로 시작. 드라이버가 지원하지 않으면(DXGI_ERROR_UNSUPPORTED) 저장 없이 메모리 캐시만 쓴다.
+        if (FAILED(device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&mLibrary))))
+            mLibrary = nullptr;
+    }
+}
+
+void PipelineStateCache::RegisterRootSignature(ID3D12RootSignature* rootSignature, const void* serializedData, size_t serializedSize)
+{
+    mRootSignatures[rootSignature] = Hasher::HashBytes(serializedData, serializedSize);
+}
+
+PipelineHandle PipelineStateCache::RequestGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, PipelineHandle fallback)
+{
+    const std::uint64_t key = HashGraphicsDesc(desc, GetRootSignatureHash(desc.pRootSignature));
+
+    PipelineHandle handle;
+    Pipeline* pipeline = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto it = mPipelineIndices.find(key);
+        if (it != mPipelineIndices.end())
+        {
+            ++mStats.Hits;
+            handle.Index = it->second;
+            return handle;
+        }
+
+        // 대체 PSO는 먼저 요청한 것만 허용 (Resolve가 번호가 줄어드는 쪽으로만 따라가므로 순환이 없다)
+        assert(fallback.Index < (int)mPipelines.size() && "fallback pipeline must be requested first");
+
+        handle.Index = (int)mPipelines.size();
+        mPipelines.push_back(std::make_unique<Pipeline>());
+        pipeline = mPipelines.back().get();
+        pipeline->Key = key;
+        pipeline->Fallback = fallback;
+        mPipelineIndices[key] = handle.Index;
+        ++mPendingCount;
+
+        // 작업은 키를 등록한 잠금 안에서 만든다.
+        // (다른 스레드가 같은 설명으로 핸들을 받자마자 Wait해도 빈 JobCounter를 읽지 않는다)
+        // 호출한 쪽의 셰이더/입력 레이아웃 메모리는 작업이 끝날 때까지 살아 있지 않을 수 있으므로 복사해서 넘긴다.
+        if (mJobSystem != nullptr && mJobSystem->GetWorkerCount() > 0)
+        {
+            std::shared_ptr<GraphicsDescCopy> copy = CopyGraphicsDesc(desc);
+            pipeline->Job = mJobSystem->Run([this, pipeline, copy]()
+            {
+                Compile(*pipeline, copy->Desc);
+            });
+            return handle;
+        }
+    }
+
+    // 작업자 스레드가 없으면 누군가 Wait하기 전까지 작업이 돌지 않으므로 바로 컴파일한다.
+    // (그동안 다른 스레드의 Wait는 mCompiled로 기다린다)
+    Compile(*pipeline, desc);
+    return handle;
+}
+
+ID3D12PipelineState* PipelineStateCache::Resolve(PipelineHandle handle)const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    while (handle.IsValid())
+    {
+        const Pipeline& pipeline = *mPipelines[handle.Index];
+        if (pipeline.State != nullptr)
+            return pipeline.State.Get();
+
+        handle = pipeline.Fallback;
+    }
+    return nullptr;
+}
+
+bool PipelineStateCache::IsReady(PipelineHandle handle)const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return handle.IsValid() && mPipelines[handle.Index]->State != nullptr;
+}
+
+bool PipelineStateCache::IsPending(PipelineHandle handle)const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return handle.IsValid() && !mPipelines[handle.Index]->IsDone;
+}
+
+void PipelineStateCache::Wait(PipelineHandle handle)
+{
+    WaitForCompile(handle);
+
+    HRESULT result = S_OK;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        result = mPipelines[handle.Index]->Result;
+    }
+    ThrowIfFailed(result);
+}
+
+void PipelineStateCache::WaitForCompile(PipelineHandle handle)
+{
+    JobCounter job;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        const Pipeline& pipeline = *mPipelines[handle.Index];
+        job = pipeline.Job;
+
+        // 작업 없이 요청한 스레드에서 컴파일하는 중이면 그 스레드가 끝낼 때까지 기다린다.
+        if (!job.IsValid())
+            mCompiled.wait(lock, [&pipeline]() { return pipeline.IsDone; });
+    }
+
+    if (mJobSystem != nullptr)
+        mJobSystem->Wait(job);
+}
+
+void PipelineStateCache::WaitForPending()
+{
+    std::vector<JobCounter> jobs;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (const std::unique_ptr<Pipeline>& pipeline : mPipelines)
+        {
+            if (!pipeline->IsDone && pipeline->Job.IsValid())
+                jobs.push_back(pipeline->Job);
+        }
+
+        // 요청한 스레드에서 바로 컴파일하는 중인 PSO
+        mCompiled.wait(lock, [this]()
+        {
+            for (const std::unique_ptr<Pipeline>& pipeline : mPipelines)
+            {
+                if (!pipeline->IsDone && !pipeline->Job.IsValid())
+                    return false;
+            }
+            return true;
+        });
+    }
+
+    if (mJobSystem == nullptr)
+        return;
+
+    for (const JobCounter& job : jobs)
+        mJobSystem->Wait(job);
+}
+
+UINT PipelineStateCache::GetPendingCount()const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPendingCount;
+}
+
+ID3D12PipelineState* PipelineStateCache::GetGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    PipelineHandle handle = RequestGraphicsPipelineState(desc);
+    Wait(handle);
+    return Resolve(handle);
+}
+
+void PipelineStateCache::Retire(PipelineHandle handle, UINT64 fence)
+{
+    if (!handle.IsValid())
+        return;
+
+    // 컴파일이 끝나야 작업 스레드가 더 이상 이 PSO를 건드리지 않는다. (실패한 PSO도 그냥 놓는다)
+    WaitForCompile(handle);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    Pipeline& pipeline = *mPipelines[handle.Index];
+    if (pipeline.IsRetired)
+        return;
+
+    // 같은 설명을 다시 요청하면 새로 만든다. (라이브러리에 있으면 로드만 한다)
+    mPipelineIndices.erase(pipeline.Key);
+    pipeline.IsRetired = true;
+    ++mStats.Retired;
+
+    // 아직 GPU가 쓰는 중일 수 있으므로 fence가 지난 뒤 놓는다.
+    assert(mReleaseQueue != nullptr && "Initialize with a release queue to retire pipelines");
+    if (mReleaseQueue != nullptr)
+        mReleaseQueue->Enqueue(fence, pipeline.State);
+}
+
+void PipelineStateCache::Compile(Pipeline& pipeline, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    wchar_t name[32];
+    swprintf_s(name, L"GFX_%016llx", (unsigned long long)pipeline.Key);
+
+    // 파이프라인 라이브러리는 내부에서 동기화한다. (같은 이름을 여러 스레드가 동시에 로드하는 경우만 제외 - 키마다 작업은 하나)
+    ComPtr<ID3D12PipelineState> pso;
+    HRESULT result = S_OK;
+    bool isLoaded = false;
+    bool isStored = false;
+    double elapsedMs = 0.0;
+
+    if (mLibrary != nullptr)
+    {
+        // 이름이 없거나 저장된 설명과 다르면 E_INVALIDARG
+        auto start = std::chrono::high_resolution_clock::now();
+        isLoaded = SUCCEEDED(mLibrary->LoadGraphicsPipeline(name, &desc, IID_PPV_ARGS(&pso)));
+        if (isLoaded)
+            elapsedMs = ElapsedMs(start);
+        else
+            pso = nullptr;
+    }
+
+    if (!isLoaded)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        result = md3dDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pso));
+        elapsedMs = ElapsedMs(start);
+
+        if (SUCCEEDED(result) && mLibrary != nullptr)
+            isStored = SUCCEEDED(mLibrary->StorePipeline(name, pso.Get()));
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    pipeline.State = SUCCEEDED(result) ? pso : nullptr;
+    pipeline.Result = result;
+    pipeline.IsDone = true;
+    --mPendingCount;
+    mCompiled.notify_all();
+
+    if (isLoaded)
+    {
+        ++mStats.LibraryHits;
+        mStats.LoadMs += elapsedMs;
+    }
+    else if (SUCCEEDED(result))
+    {
+        ++mStats.Misses;
+        mStats.CompileMs += elapsedMs;
+    }
+    else
+    {
+        ++mStats.Failures;
+    }
+
+    if (isStored)
+        mIsDirty = true;
+}
+
+bool PipelineStateCache::Save()
+{
+    // 직렬화 중에 StorePipeline이 불리면 안 되므로 진행 중인 컴파일을 먼저 끝낸다.
+    WaitForPending();
+
+    if (mLibrary == nullptr || !mIsDirty)
+        return true;
+
+    std::vector<std::uint8_t> data(mLibrary->GetSerializedSize());
+    if (FAILED(mLibrary->Serialize(data.data(), data.size())))
+        return false;
+
+    // 임시 파일에 다 쓴 다음 바꿔치기
+    const std::string tempPath = mLibraryPath + ".tmp";
+    FILE* file = nullptr;
+    if (fopen_s(&file, tempPath.c_str(), "wb") != 0 || file == nullptr)
+        return false;
+
+    const bool isWritten = fwrite(data.data(), 1, data.size(), file) == data.size();
+    fclose(file);
+    if (!isWritten)
+    {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    remove(mLibraryPath.c_str());
+    if (rename(tempPath.c_str(), mLibraryPath.c_str()) != 0)
+        return false;
+
+    mIsDirty = false;
+    return true;
+}
+
+PipelineStateCache::Stats PipelineStateCache::GetStats()const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+std::string PipelineStateCache::GetStatsString()const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    char line[256];
+    snprintf(line, sizeof(line),
+        "PipelineStateCache\n  pipelines %3u  pending %3u  hits %3u  library %3u (%7.2f ms)  compiled %3u (%7.2f ms)  failed %u  retired %u\n",
+        (UINT)mPipelines.size(),
+        mPendingCount,
+        mStats.Hits,
+        mStats.LibraryHits,
+        mStats.LoadMs,
+        mStats.Misses,
+        mStats.CompileMs,
+        mStats.Failures,
+        mStats.Retired);
+    return line;
+}
+
+std::uint64_t PipelineStateCache::HashGraphicsDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, std::uint64_t rootSignatureHash)
+{
+    // CachedPSO는 결과가 아니라 만드는 방법이므로 키에 넣지 않는다.
+    return HashGraphicsPipelineDesc(ToPipelineDesc(desc, rootSignatureHash));
+}
+
+std::uint64_t PipelineStateCache::GetRootSignatureHash(ID3D12RootSignature* rootSignature)const
+{
+    auto it = mRootSignatures.find(rootSignature);
+    assert(it != mRootSignatures.end() && "RegisterRootSignature must be called before creating PSOs");
+
+    // 등록하지 않았으면 이번 실행에서만 유효한 키 (라이브러리에서 다시 찾지 못하고 새로 컴파일된다)
+    return it != mRootSignatures.end() ? it->second : (std::uint64_t)(uintptr_t)rootSignature;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/JobSystem.h"
+
+#include <condition_variable>
+#include <mutex>
+
+class DeferredReleaseQueue;
+
+// 비동기로 요청한 PSO
+struct PipelineHandle
+{
+    int Index = -1;
+
+    bool IsValid()const { return Index >= 0; }
+};
+
+// 그래픽스 PSO 캐시
+// - PSO 설명을 정규화해서 해시하고, 같은 설명이면 이미 만든 PSO를 돌려준다. (중복 제거)
+// - 드라이버가 컴파일한 결과는 ID3D12PipelineLibrary에 담아서 디스크에 저장하고, 다음 실행에서 다시 읽는다.
+// - RequestGraphicsPipelineState는 바로 핸들을 돌려주고 컴파일은 작업 스레드에서 한다.
+//   준비되기 전에는 Resolve가 대체 PSO(없으면 nullptr)를 돌려주므로 그리는 쪽은 멈추지 않는다.
+// 키에는 포인터 값이 들어가지 않으므로(셰이더/루트 시그니처는 내용 해시) 실행이 바뀌어도 같은 키가 나온다.
+class PipelineStateCache
+{
+public:
+    struct Stats
+    {
+        UINT Hits = 0;              // 이번 실행에서 이미 요청한 PSO 재사용
+        UINT LibraryHits = 0;       // 파이프라인 라이브러리에서 로드
+        UINT Misses = 0;            // 새로 컴파일
+        UINT Failures = 0;          // 컴파일 실패 (대체 PSO를 계속 쓴다)
+        UINT Retired = 0;           // 핫 리로드로 교체되어 놓은 PSO
+        double LoadMs = 0.0;        // 라이브러리 로드에 쓴 시간 (작업 스레드 합)
+        double CompileMs = 0.0;     // 새로 컴파일하는 데 쓴 시간 (작업 스레드 합)
+    };
+
+public:
+    PipelineStateCache() = default;
+    PipelineStateCache(const PipelineStateCache& rhs) = delete;
+    PipelineStateCache& operator=(const PipelineStateCache& rhs) = delete;
+    ~PipelineStateCache();
+
+    // libraryPath의 라이브러리를 읽는다. 지원하지 않는 드라이버거나 다른 드라이버에서 만든 파일이면 빈 라이브러리로 시작한다.
+    // jobSystem이 없으면 요청한 자리에서 바로 컴파일한다.
+    // releaseQueue : Retire한 PSO를 GPU가 다 쓴 뒤 놓을 큐
+    void Initialize(ID3D12Device* device, const std::string& libraryPath, JobSystem* jobSystem = nullptr, DeferredReleaseQueue* releaseQueue = nullptr);
+
+    // 루트 시그니처는 직렬화된 내용으로 키를 만든다. PSO를 요청하기 전에 등록해야 한다.
+    void RegisterRootSignature(ID3D12RootSignature* rootSignature, const void* serializedData, size_t serializedSize);
+
+    // 컴파일을 작업 스레드에 맡기고 바로 돌아온다. 설명은 복사해 두므로 셰이더/입력 레이아웃 메모리는 바로 버려도 된다.
+    // (루트 시그니처는 PSO가 준비될 때까지 살아 있어야 한다)
+    // fallback은 준비되기 전에 대신 쓸 호환 PSO (먼저 요청한 것이어야 한다)
+    PipelineHandle RequestGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, PipelineHandle fallback = PipelineHandle());
+
+    // 준비된 PSO. 아직이면 대체 PSO를 따라가고, 그것도 없으면 nullptr (그리지 않는다)
+    ID3D12PipelineState* Resolve(PipelineHandle handle)const;
+    bool IsReady(PipelineHandle handle)const;
+    bool IsPending(PipelineHandle handle)const;     // 아직 컴파일 중 (끝났으면 성공/실패와 상관없이 false)
+
+    // 준비될 때까지 기다린다. (기다리는 동안 다른 컴파일 작업을 같이 처리) 컴파일에 실패했으면 예외
+    void Wait(PipelineHandle handle);
+    void WaitForPending();      // 요청한 PSO를 모두 기다린다. (벤치마크용 미리 컴파일)
+    UINT GetPendingCount()const;
+
+    // 요청하고 바로 기다린다.
+    ID3D12PipelineState* GetGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+    // 더 쓰지 않는 PSO (핫 리로드로 교체된 것). fence가 지나면 해제 큐에서 놓는다.
+    // 이후 핸들은 준비되지 않은 것으로 보고, 같은 설명을 요청하면 새로 만든다.
+    void Retire(PipelineHandle handle, UINT64 fence);
+
+    // 새로 컴파일한 PSO가 있으면 라이브러리를 파일로 저장한다. (진행 중인 컴파일을 먼저 기다린다)
+    bool Save();
+
+    Stats GetStats()const;
+    std::string GetStatsString()const;
+
+    // 결과에 영향을 주지 않는 필드(쓰지 않는 렌더 타겟, 꺼진 블렌드/스텐실 설정, 포인터 값 등)를 빼고 해시한다.
+    // (해시 규칙은 01_Core의 HashGraphicsPipelineDesc)
+    static std::uint64_t HashGraphicsDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, std::uint64_t rootSignatureHash);
+
+private:
+    struct Pipeline
+    {
+        std::uint64_t Key = 0;
+        PipelineHandle Fallback;
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> State;
+        HRESULT Result = S_OK;
+        bool IsDone = false;        // 성공/실패와 상관없이 컴파일이 끝났는지
+        bool IsRetired = false;
+        JobCounter Job;             // 요청한 스레드에서 바로 컴파일하면 비어 있다.
+    };
+
+    std::uint64_t GetRootSignatureHash(ID3D12RootSignature* rootSignature)const;
+    // 컴파일이 끝날 때까지 기다린다. (실패해도 예외 없음)
+    void WaitForCompile(PipelineHandle handle);
+    void Compile(Pipeline& pipeline, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+    JobSystem* mJobSystem = nullptr;
+    DeferredReleaseQueue* mReleaseQueue = nullptr;
+    Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> mLibrary;
+
+    // 라이브러리는 생성할 때 넘긴 메모리를 계속 참조하므로 파일 내용을 들고 있는다.
+    // (메모리 맵으로 두면 Save에서 같은 파일을 덮어쓸 수 없다)
+    std::vector<std::uint8_t> mLibraryData;
+    std::string mLibraryPath;
+    bool mIsDirty = false;
+
+    std::unordered_map<ID3D12RootSignature*, std::uint64_t> mRootSignatures;
+
+    // 작업 스레드가 결과를 채우므로 아래는 mMutex로 보호
+    mutable std::mutex mMutex;
+    std::condition_variable mCompiled;                          // 컴파일이 하나 끝날 때마다 알린다.
+    std::vector<std::unique_ptr<Pipeline>> mPipelines;          // 핸들 번호 순
+    std::unordered_map<std::uint64_t, int> mPipelineIndices;    // 키 -> 핸들 번호
+    UINT mPendingCount = 0;
+
+    Stats mStats;
+};
@@ -0,0 +1,278 @@
+#include "ProceduralMeshCache.h"
+#include "../01_Core/Hasher.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+void ProceduralMesh::Allocate(std::uint32_t vertexCount, std::uint32_t indexCount, const std::uint32_t* strides, std::uint32_t streamCount)
+{
+    mVertexCount = vertexCount;
+    mIndexCount = indexCount;
+    mStreamCount = streamCount;
+    for (std::uint32_t i = 0; i < streamCount; ++i)
+    {
+        mStrides[i] = strides[i];
+        mOwnedStreams[i].resize((size_t)strides[i] * vertexCount);
+        mVertexData[i] = mOwnedStreams[i].data();
+    }
+    mOwnedIndices.resize(indexCount);
+    mIndices = mOwnedIndices.data();
+}
+
+void ProceduralMesh::SetPositionTransform(const float scale[3], const float offset[3])
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        mPositionScale[i] = scale[i];
+        mPositionOffset[i] = offset[i];
+    }
+}
+
+std::uint64_t ProceduralMesh::GetByteSize()const
+{
+    std::uint64_t size = (std::uint64_t)mIndexCount * sizeof(std::uint32_t);
+    for (std::uint32_t i = 0; i < mStreamCount; ++i)
+        size += (std::uint64_t)mStrides[i] * mVertexCount;
+    return size;
+}
+
+bool ProceduralMesh::Load(const std::string& path, const std::string& name)
+{
+    if (!mFile.Open(path))
+        return false;
+
+    // 서브메시 이름에 키를 적어 두므로 키가 다른 파일(다른 버전이 같은 이름으로 쓴 파일 등)은 버린다.
+    const MeshFileHeader& header = mFile.GetHeader();
+    if (header.IndexStride != 4 || mFile.IsIndexCompressed() || header.SubmeshCount != 1 ||
+        std::strcmp(mFile.GetSubmeshes()[0].Name, name.c_str()) != 0)
+    {
+        mFile.Close();
+        return false;
+    }
+
+    // 바로 업로드 스테이징으로 복사할 것이므로 페이지를 미리 읽어 둔다.
+    mFile.Prefetch();
+
+    mVertexCount = header.VertexCount;
+    mIndexCount = header.IndexCount;
+    mStreamCount = header.VertexStreamCount;
+    for (std::uint32_t i = 0; i < mStreamCount; ++i)
+    {
+        mStrides[i] = header.VertexStrides[i];
+        mVertexData[i] = mFile.GetVertexData(i);
+    }
+    mIndices = reinterpret_cast<const std::uint32_t*>(mFile.GetIndexData());
+    SetPositionTransform(header.PositionScale, header.PositionOffset);
+    return true;
+}
+
+bool ProceduralMesh::Write(const std::string& path, const std::string& name)const
+{
+    MeshFileDesc desc;
+    for (std::uint32_t i = 0; i < mStreamCount; ++i)
+        desc.VertexStreams.push_back({ mVertexData[i], mStrides[i] });
+    desc.VertexCount = mVertexCount;
+
+    // 압축하지 않는다. (다시 읽을 때 매핑에서 바로 복사하는 쪽이 빠르다)
+    desc.Indices = mIndices;
+    desc.IndexStride = 4;
+    desc.IndexCount = mIndexCount;
+
+    MeshFileSubmesh submesh;
+    std::strncpy(submesh.Name, name.c_str(), sizeof(submesh.Name) - 1);
+    submesh.IndexCount = mIndexCount;
+    desc.Submeshes.push_back(submesh);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        desc.PositionScale[i] = mPositionScale[i];
+        desc.PositionOffset[i] = mPositionOffset[i];
+    }
+
+    return MeshFile::Write(path, desc);
+}
+
+void ProceduralMeshCache::Open(const std::string& pathPrefix, std::uint64_t memoryBudget)
+{
+    Close();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPathPrefix = pathPrefix;
+    mMemoryBudget = memoryBudget;
+}
+
+void ProceduralMeshCache::Close()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mLru.clear();
+    mStats = Stats();
+}
+
+void ProceduralMeshCache::SetMemoryBudget(std::uint64_t memoryBudget)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMemoryBudget = memoryBudget;
+    Evict();
+}
+
+std::shared_ptr<const ProceduralMesh> ProceduralMeshCache::GetOrCreate(const ProceduralMeshDesc& desc, std::uint64_t formatKey, const BuildFunction& build)
+{
+    const std::uint64_t key = GetKey(desc, formatKey);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::shared_ptr<const ProceduralMesh> mesh = Find(key);
+        if (mesh != nullptr)
+        {
+            ++mStats.Hits;
+            return mesh;
+        }
+    }
+
+    const std::string name = GetName(key);
+
+    // 파일 열기와 생성은 잠금 밖에서 한다. (다른 메시 요청을 막지 않도록)
+    bool isInserted = false;
+    if (!mPathPrefix.empty())
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        auto mesh = std::make_shared<ProceduralMesh>();
+        if (mesh->Load(GetPath(name), name))
+        {
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mStats.DiskHits;
+            mStats.LoadMs += ms;
+            return Insert(key, std::move(mesh), isInserted);
+        }
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    auto mesh = std::make_shared<ProceduralMesh>();
+    build(desc, *mesh);
+
+    std::shared_ptr<const ProceduralMesh> result;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mStats.Misses;
+        result = Insert(key, mesh, isInserted);
+    }
+
+    // 먼저 넣은 쪽만 파일을 쓴다. (같은 임시 파일에 동시에 쓰지 않도록)
+    const bool isWriteFailed = isInserted && !mPathPrefix.empty() && !mesh->Write(GetPath(name), name);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.BuildMs += ms;
+    if (isWriteFailed)
+        ++mStats.WriteFailures;
+    return result;
+}
+
+std::shared_ptr<const ProceduralMesh> ProceduralMeshCache::Find(std::uint64_t key)
+{
+    auto it = mEntries.find(key);
+    if (it == mEntries.end())
+        return nullptr;
+
+    mLru.splice(mLru.begin(), mLru, it->second.LruPosition);
+    return it->second.Mesh;
+}
+
+std::shared_ptr<const ProceduralMesh> ProceduralMeshCache::Insert(std::uint64_t key, std::shared_ptr<const ProceduralMesh> mesh, bool& isInserted)
+{
+    std::shared_ptr<const ProceduralMesh> existing = Find(key);
+    isInserted = existing == nullptr;
+    if (!isInserted)
+        return existing;
+
+    mLru.push_front(key);
+    mStats.MemoryBytes += mesh->GetByteSize();
+
+    Entry& entry = mEntries[key];
+    entry.Mesh = std::move(mesh);
+    entry.LruPosition = mLru.begin();
+
+    std::shared_ptr<const ProceduralMesh> result = entry.Mesh;
+    Evict();
+    return result;
+}
+
+void ProceduralMeshCache::Evict()
+{
+    // 방금 쓴 메시 하나는 예산보다 커도 남긴다.
+    while (mStats.MemoryBytes > mMemoryBudget && mLru.size() > 1)
+    {
+        auto it = mEntries.find(mLru.back());
+        mStats.MemoryBytes -= it->second.Mesh->GetByteSize();
+        ++mStats.Evictions;
+
+        mEntries.erase(it);
+        mLru.pop_back();
+    }
+}
+
+ProceduralMeshCache::Stats ProceduralMeshCache::GetStats()const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Stats stats = mStats;
+    stats.MeshCount = (std::uint32_t)mEntries.size();
+    return stats;
+}
+
+std::string ProceduralMeshCache::GetStatsString()const
+{
+    const Stats stats = GetStats();
+    std::uint64_t memoryBudget = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        memoryBudget = mMemoryBudget;
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line),
+        "ProceduralMeshCache\n  meshes %3u (%7.2f / %7.2f MB)  hits %3u  disk %3u (%7.2f ms)  built %3u (%7.2f ms)  evicted %u  write failed %u\n",
+        stats.MeshCount,
+        stats.MemoryBytes / (1024.0 * 1024.0),
+        memoryBudget / (1024.0 * 1024.0),
+        stats.Hits,
+        stats.DiskHits,
+        stats.LoadMs,
+        stats.Misses,
+        stats.BuildMs,
+        stats.Evictions,
+        stats.WriteFailures);
+    return line;
+}
+
+std::uint64_t ProceduralMeshCache::GetKey(const ProceduralMeshDesc& desc, std::uint64_t formatKey)
+{
+    Hasher hasher;
+    hasher.Add((std::uint32_t)GeneratorVersion);
+    hasher.Add(desc.Primitive);
+    for (float dimension : desc.Dimensions)
+        hasher.Add(dimension);
+    for (std::uint32_t count : desc.Counts)
+        hasher.Add(count);
+    hasher.Add(formatKey);
+    return hasher.Get();
+}
+
+std::string ProceduralMeshCache::GetFilePath(const ProceduralMeshDesc& desc, std::uint64_t formatKey)const
+{
+    if (mPathPrefix.empty())
+        return std::string();
+    return GetPath(GetName(GetKey(desc, formatKey)));
+}
+
+std::string ProceduralMeshCache::GetName(std::uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    return name;
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "GeometryGenerator.h"
+#include "../01_Core/MeshFile.h"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class ProceduralPrimitive : std::uint32_t
+{
+    Box,
+    Sphere,
+    Geosphere,
+    Cylinder,
+    Grid,
+};
+
+// GeometryGenerator::Create* 호출 하나 (도형 + 매개변수)
+struct ProceduralMeshDesc
+{
+    ProceduralPrimitive Primitive = ProceduralPrimitive::Box;
+    float Dimensions[3] = { 0.0f, 0.0f, 0.0f };     // Box : 폭/높이/깊이, Sphere/Geosphere : 반지름, Cylinder : 아래/위 반지름, 높이, Grid : 폭/깊이
+    std::uint32_t Counts[2] = { 0, 0 };             // Box/Geosphere : 분할 횟수, Sphere/Cylinder : slice/stack, Grid : m/n
+
+    static ProceduralMeshDesc Box(float width, float height, float depth, std::uint32_t numSubdivisions)
+    {
+        return { ProceduralPrimitive::Box, { width, height, depth }, { numSubdivisions, 0 } };
+    }
+    static ProceduralMeshDesc Sphere(float radius, std::uint32_t sliceCount, std::uint32_t stackCount)
+    {
+        return { ProceduralPrimitive::Sphere, { radius, 0.0f, 0.0f }, { sliceCount, stackCount } };
+    }
+    static ProceduralMeshDesc Geosphere(float radius, std::uint32_t numSubdivisions)
+    {
+        return { ProceduralPrimitive::Geosphere, { radius, 0.0f, 0.0f }, { numSubdivisions, 0 } };
+    }
+    static ProceduralMeshDesc Cylinder(float bottomRadius, float topRadius, float height, std::uint32_t sliceCount, std::uint32_t stackCount)
+    {
+        return { ProceduralPrimitive::Cylinder, { bottomRadius, topRadius, height }, { sliceCount, stackCount } };
+    }
+    static ProceduralMeshDesc Grid(float width, float depth, std::uint32_t m, std::uint32_t n)
+    {
+        return { ProceduralPrimitive::Grid, { width, depth, 0.0f }, { m, n } };
+    }
+
+    // 도형에 맞는 GeometryGenerator 싱크 함수를 부른다.
+    template<typename TSink>
+    void Create(GeometryGenerator& generator, TSink& sink)const;
+};
+
+// 캐시에 든 메시 하나 (최종 정점 형식의 스트림들 + 32비트 인덱스)
+// 새로 만든 메시는 자체 버퍼를, 디스크에서 읽은 메시는 매핑된 .mesh 파일을 가리킨다.
+class ProceduralMesh
+{
+public:
+    ProceduralMesh() = default;
+    ProceduralMesh(const ProceduralMesh& rhs) = delete;
+    ProceduralMesh& operator=(const ProceduralMesh& rhs) = delete;
+
+    // 만드는 쪽 : 자리를 잡은 뒤 GetVertexData/GetIndices에 쓴다. (streamCount는 MeshFileMaxVertexStreams 이하)
+    void Allocate(std::uint32_t vertexCount, std::uint32_t indexCount, const std::uint32_t* strides, std::uint32_t streamCount);
+    std::uint8_t* GetVertexData(std::uint32_t stream) { return mOwnedStreams[stream].data(); }
+    std::uint32_t* GetIndices() { return mOwnedIndices.data(); }
+
+    // 양자화된 위치 복원 값 (.mesh 헤더에 같이 저장해서 MeshLoader로도 읽을 수 있게 한다)
+    void SetPositionTransform(const float scale[3], const float offset[3]);
+
+    std::uint32_t GetVertexCount()const { return mVertexCount; }
+    std::uint32_t GetIndexCount()const { return mIndexCount; }
+    std::uint32_t GetStreamCount()const { return mStreamCount; }
+    std::uint32_t GetVertexStride(std::uint32_t stream)const { return mStrides[stream]; }
+    const std::uint8_t* GetVertexData(std::uint32_t stream)const { return mVertexData[stream]; }
+    const std::uint32_t* GetIndices()const { return mIndices; }
+    const float* GetPositionScale()const { return mPositionScale; }
+    const float* GetPositionOffset()const { return mPositionOffset; }
+
+    // 정점 + 인덱스 바이트 (캐시 메모리 예산에 세는 크기)
+    std::uint64_t GetByteSize()const;
+
+private:
+    friend class ProceduralMeshCache;
+
+    // 파일이 없거나 이름(키)/형식이 다르면 false
+    bool Load(const std::string& path, const std::string& name);
+    bool Write(const std::string& path, const std::string& name)const;
+
+private:
+    std::uint32_t mVertexCount = 0;
+    std::uint32_t mIndexCount = 0;
+    std::uint32_t mStreamCount = 0;
+    std::uint32_t mStrides[MeshFileMaxVertexStreams] = {};
+    const std::uint8_t* mVertexData[MeshFileMaxVertexStreams] = {};
+    const std::uint32_t* mIndices = nullptr;
+    float mPositionScale[3] = { 1.0f, 1.0f, 1.0f };
+    float mPositionOffset[3] = { 0.0f, 0.0f, 0.0f };
+
+    std::vector<std::uint8_t> mOwnedStreams[MeshFileMaxVertexStreams];
+    std::vector<std::uint32_t> mOwnedIndices;
+    MeshFile mFile;
+};
+
+// 절차적 메시 캐시 (GeometryGenerator 결과를 최종 정점 형식으로 기억해 둔다)
+// 키는 (도형, 매개변수, 정점 형식). 메모리 -> 디스크(.mesh) -> 생성 순서로 찾고, 새로 만든 메시는 디스크에도 쓴다.
+// 그래서 같은 요청은 메모리에서, 다시 실행하면 파일 매핑에서 바로 나온다. (생성과 정점 캐시 최적화를 건너뛴다)
+// 메모리에 둔 메시 크기가 예산을 넘으면 가장 오래 안 쓴 메시부터 놓는다. (디스크 파일은 남는다)
+// 돌려준 shared_ptr을 들고 있는 동안은 놓여도 메시가 살아 있다.
+// GetOrCreate는 여러 스레드에서 동시에 불러도 된다.
+class ProceduralMeshCache
+{
+public:
+    // 결과가 바뀌게 GeometryGenerator를 고치면 올린다. (이전 디스크 파일은 모두 무효)
+    static const std::uint32_t GeneratorVersion = 2;
+
+    struct Stats
+    {
+        std::uint32_t Hits = 0;             // 메모리
+        std::uint32_t DiskHits = 0;
+        std::uint32_t Misses = 0;           // 새로 생성
+        std::uint32_t Evictions = 0;
+        std::uint32_t WriteFailures = 0;
+        std::uint32_t MeshCount = 0;
+        std::uint64_t MemoryBytes = 0;
+        double LoadMs = 0.0;                // 디스크 파일 열기
+        double BuildMs = 0.0;               // 생성 + 파일 쓰기
+    };
+
+    // desc의 메시를 mesh에 만든다. (mesh.Allocate부터 부른다)
+    using BuildFunction = std::function<void(const ProceduralMeshDesc& desc, ProceduralMesh& mesh)>;
+
+public:
+    ProceduralMeshCache() = default;
+    ProceduralMeshCache(const ProceduralMeshCache& rhs) = delete;
+    ProceduralMeshCache& operator=(const ProceduralMeshCache& rhs) = delete;
+
+    // pathPrefix : 디스크 파일 이름 앞부분 (pathPrefix + 키 16자리 + ".mesh"). 비어 있으면 메모리에만 둔다.
+    // memoryBudget : 메모리에 둘 메시 바이트 상한
+    // Open/Close는 GetOrCreate 중에 부르면 안 된다.
+    void Open(const std::string& pathPrefix, std::uint64_t memoryBudget);
+    void Close();
+
+    // formatKey : build가 쓰는 정점 값을 정하는 모든 것 (스트림 형식, 양자화 변환, 색 등)의 해시
+    // build는 잠금 밖에서 불린다. 같은 키를 동시에 만들면 먼저 넣은 쪽을 돌려준다.
+    std::shared_ptr<const ProceduralMesh> GetOrCreate(const ProceduralMeshDesc& desc, std::uint64_t formatKey, const BuildFunction& build);
+
+    void SetMemoryBudget(std::uint64_t memoryBudget);
+
+    Stats GetStats()const;
+    std::string GetStatsString()const;
+
+    static std::uint64_t GetKey(const ProceduralMeshDesc& desc, std::uint64_t formatKey);
+    // 디스크 파일 경로 (Open에서 pathPrefix를 비웠으면 빈 문자열)
+    std::string GetFilePath(const ProceduralMeshDesc& desc, std::uint64_t formatKey)const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<const ProceduralMesh> Mesh;
+        std::list<std::uint64_t>::iterator LruPosition;
+    };
+
+    // mMutex를 잡은 상태에서 호출
+    std::shared_ptr<const ProceduralMesh> Find(std::uint64_t key);
+    // 이미 있으면 있던 것을 돌려준다.
+    std::shared_ptr<const ProceduralMesh> Insert(std::uint64_t key, std::shared_ptr<const ProceduralMesh> mesh, bool& isInserted);
+    void Evict();
+
+    static std::string GetName(std::uint64_t key);
+    std::string GetPath(const std::string& name)const { return mPathPrefix + name + ".mesh"; }
+
+private:
+    std::string mPathPrefix;
+    std::uint64_t mMemoryBudget = 0;
+
+    std::unordered_map<std::uint64_t, Entry> mEntries;
+    std::list<std::uint64_t> mLru;          // 앞이 최근에 쓴 메시
+
+    Stats mStats;
+    mutable std::mutex mMutex;
+};
+
+template<typename TSink>
+void ProceduralMeshDesc::Create(GeometryGenerator& generator, TSink& sink)const
+{
+    switch (Primitive)
+    {
+    case ProceduralPrimitive::Box:
+        generator.CreateBox(sink, Dimensions[0], Dimensions[1], Dimensions[2], Counts[0]);
+        break;
+    case ProceduralPrimitive::Sphere:
+        generator.CreateSphere(sink, Dimensions[0], Counts[0], Counts[1]);
+        break;
+    case ProceduralPrimitive::Geosphere:
+        generator.CreateGeosphere(sink, Dimensions[0], Counts[0]);
+        break;
+    case ProceduralPrimitive::Cylinder:
+        generator.CreateCylinder(sink, Dimensions[0], Dimensions[1], Dimensions[2], Counts[0], Counts[1]);
+        break;
+    case ProceduralPrimitive::Grid:
+        generator.CreateGrid(sink, Dimensions[0], Dimensions[1], Counts[0], Counts[1]);
+        break;
+    }
+}
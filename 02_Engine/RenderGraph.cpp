@@ -0,0 +1,549 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <cstdio>
+
+std::string RGState::ToString(std::uint32_t state)
+{
+    if (state == Common)
+        return "COMMON/PRESENT";
+
+    struct StateName { std::uint32_t Bit; const char* Name; };
+    static const StateName names[] =
+    {
+        { RenderTarget, "RENDER_TARGET" },
+        { DepthWrite, "DEPTH_WRITE" },
+        { DepthRead, "DEPTH_READ" },
+        { NonPixelShaderResource, "NON_PIXEL_SHADER_RESOURCE" },
+        { PixelShaderResource, "PIXEL_SHADER_RESOURCE" },
+        { CopyDest, "COPY_DEST" },
+        { CopySource, "COPY_SOURCE" },
+    };
+
+    std::string result;
+    for (const auto& n : names)
+    {
+        if ((state & n.Bit) == 0)
+            continue;
+
+        if (!result.empty())
+            result += "|";
+        result += n.Name;
+    }
+
+    if (result.empty())
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "0x%X", state);
+        result = buffer;
+    }
+
+    return result;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(RGHandle resource, std::uint32_t state)
+{
+    if (resource.IsValid())
+        mGraph->mPasses[mPass].Accesses.push_back({ resource.Index, state, false });
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(RGHandle resource, std::uint32_t state)
+{
+    if (resource.IsValid())
+        mGraph->mPasses[mPass].Accesses.push_back({ resource.Index, state, true });
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SideEffect()
+{
+    mGraph->mPasses[mPass].HasSideEffect = true;
+    return *this;
+}
+
+void RenderGraph::Reset()
+{
+    mResources.clear();
+    mPasses.clear();
+    mSchedule.clear();
+    mFinalBarriers.clear();
+    mMemoryPlan = RGMemoryPlan();
+}
+
+RGHandle RenderGraph::ImportTexture(const std::string& name, std::uint32_t initialState, std::uint32_t finalState)
+{
+    Resource resource;
+    resource.Name = name;
+    resource.IsImported = true;
+    resource.InitialState = initialState;
+    resource.FinalState = finalState;
+    mResources.push_back(resource);
+
+    RGHandle handle;
+    handle.Index = (int)mResources.size() - 1;
+    return handle;
+}
+
+RGHandle RenderGraph::CreateTexture(const std::string& name, const RGTextureDesc& desc)
+{
+    Resource resource;
+    resource.Name = name;
+    resource.IsImported = false;
+    resource.Desc = desc;
+    mResources.push_back(resource);
+
+    RGHandle handle;
+    handle.Index = (int)mResources.size() - 1;
+    return handle;
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(const std::string& name, ExecuteFn execute)
+{
+    Pass pass;
+    pass.Name = name;
+    pass.Execute = std::move(execute);
+    mPasses.push_back(std::move(pass));
+
+    return PassBuilder(this, (int)mPasses.size() - 1);
+}
+
+void RenderGraph::MarkOutput(RGHandle resource)
+{
+    if (resource.IsValid())
+        mResources[resource.Index].IsOutput = true;
+}
+
+bool RenderGraph::Compile()
+{
+    mSchedule.clear();
+    mFinalBarriers.clear();
+    mMemoryPlan = RGMemoryPlan();
+
+    CullPasses();
+
+    for (int i = 0; i < (int)mPasses.size(); ++i)
+    {
+        if (mPasses[i].IsCulled)
+            continue;
+
+        RGCompiledPass compiled;
+        compiled.Pass = i;
+        mSchedule.push_back(compiled);
+    }
+
+    BuildMemoryPlan();
+    BuildBarriers();
+    BuildSplitBarriers();
+
+    return true;
+}
+
+// 뒤에서부터 거슬러 올라가며 출력에 기여하는 패스만 남긴다.
+void RenderGraph::CullPasses()
+{
+    std::vector<bool> isNeeded(mResources.size(), false);
+    for (size_t r = 0; r < mResources.size(); ++r)
+        isNeeded[r] = mResources[r].IsOutput;
+
+    for (int i = (int)mPasses.size() - 1; i >= 0; --i)
+    {
+        Pass& pass = mPasses[i];
+
+        bool isLive = pass.HasSideEffect;
+        for (const Access& access : pass.Accesses)
+        {
+            if (access.IsWrite && isNeeded[access.Resource])
+                isLive = true;
+        }
+
+        pass.IsCulled = !isLive;
+        if (!isLive)
+            continue;
+
+        // 살아있는 패스가 읽는 리소스는 앞선 패스가 만들어야 한다.
+        // 쓰기는 부분 쓰기일 수 있으므로 앞선 쓰기도 그대로 필요한 것으로 둔다.
+        for (const Access& access : pass.Accesses)
+        {
+            if (!access.IsWrite)
+                isNeeded[access.Resource] = true;
+        }
+    }
+}
+
+// 트랜지언트 리소스의 수명을 구하고, 수명이 겹치지 않는 리소스끼리 같은 메모리를 쓰도록 배치
+void RenderGraph::BuildMemoryPlan()
+{
+    std::vector<RGMemoryPlacement> placements;
+    std::vector<int> placementIndex(mResources.size(), -1);
+
+    for (int s = 0; s < (int)mSchedule.size(); ++s)
+    {
+        const Pass& pass = mPasses[mSchedule[s].Pass];
+        for (const Access& access : pass.Accesses)
+        {
+            Resource& resource = mResources[access.Resource];
+            if (resource.IsImported)
+                continue;
+
+            int& index = placementIndex[access.Resource];
+            if (index < 0)
+            {
+                RGMemoryPlacement placement;
+                placement.Resource = access.Resource;
+                placement.Size = resource.Desc.SizeInBytes;
+                placement.FirstPass = s;
+                placement.LastPass = s;
+                placements.push_back(placement);
+                index = (int)placements.size() - 1;
+
+                // 처음 사용하는 상태로 리소스를 만든다.
+                resource.InitialState = access.State;
+                resource.FinalState = access.State;
+            }
+            else
+            {
+                placements[index].LastPass = s;
+            }
+        }
+    }
+
+    // 큰 리소스부터 배치
+    std::vector<int> order(placements.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = (int)i;
+    std::sort(order.begin(), order.end(), [&placements](int a, int b)
+    {
+        if (placements[a].Size != placements[b].Size)
+            return placements[a].Size > placements[b].Size;
+        return placements[a].Resource < placements[b].Resource;
+    });
+
+    std::vector<int> placed;
+    for (int i : order)
+    {
+        RGMemoryPlacement& current = placements[i];
+        const std::uint64_t alignment = std::max<std::uint64_t>(mResources[current.Resource].Desc.Alignment, 1);
+
+        // 수명이 겹치는 리소스들
+        std::vector<const RGMemoryPlacement*> overlapping;
+        for (int j : placed)
+        {
+            const RGMemoryPlacement& other = placements[j];
+            if (other.FirstPass <= current.LastPass && current.FirstPass <= other.LastPass)
+                overlapping.push_back(&other);
+        }
+
+        // 후보 위치 : 0, 그리고 겹치는 리소스들의 끝
+        std::vector<std::uint64_t> candidates(1, 0);
+        for (const RGMemoryPlacement* other : overlapping)
+            candidates.push_back(other->Offset + other->Size);
+        std::sort(candidates.begin(), candidates.end());
+
+        for (std::uint64_t candidate : candidates)
+        {
+            std::uint64_t offset = (candidate + alignment - 1) / alignment * alignment;
+
+            bool isFree = true;
+            for (const RGMemoryPlacement* other : overlapping)
+            {
+                if (offset < other->Offset + other->Size && other->Offset < offset + current.Size)
+                {
+                    isFree = false;
+                    break;
+                }
+            }
+
+            if (isFree)
+            {
+                current.Offset = offset;
+                break;
+            }
+        }
+
+        placed.push_back(i);
+
+        mMemoryPlan.HeapSize = std::max(mMemoryPlan.HeapSize, current.Offset + current.Size);
+        mMemoryPlan.UnaliasedSize += (current.Size + alignment - 1) / alignment * alignment;
+    }
+
+    mMemoryPlan.Placements = placements;
+}
+
+// 이번 패스부터 다음 쓰기 전까지 이어지는 읽기 상태를 모두 합친다.
+// 여러 패스가 서로 다른 상태로 읽더라도 전환은 한 번만 일어난다.
+std::uint32_t RenderGraph::GatherReadState(int resource, size_t scheduleIndex)const
+{
+    std::uint32_t state = 0;
+
+    for (size_t s = scheduleIndex; s < mSchedule.size(); ++s)
+    {
+        const Pass& pass = mPasses[mSchedule[s].Pass];
+
+        bool isWritten = false;
+        for (const Access& access : pass.Accesses)
+        {
+            if (access.Resource != resource)
+                continue;
+
+            if (access.IsWrite)
+                isWritten = true;
+            else
+                state |= access.State;
+        }
+
+        if (isWritten)
+            break;
+    }
+
+    return state;
+}
+
+void RenderGraph::BuildBarriers()
+{
+    std::vector<std::uint32_t> currentState(mResources.size(), 0);
+    for (size_t r = 0; r < mResources.size(); ++r)
+        currentState[r] = mResources[r].InitialState;
+
+    // 같은 메모리를 앞서 사용한 리소스 (앨리어싱 배리어용)
+    std::vector<int> aliasBefore(mResources.size(), -1);
+    const auto& placements = mMemoryPlan.Placements;
+    for (const RGMemoryPlacement& current : placements)
+    {
+        int latestPass = -1;
+        for (const RGMemoryPlacement& other : placements)
+        {
+            if (&other == &current || other.LastPass >= current.FirstPass)
+                continue;
+
+            bool isOverlapping = current.Offset < other.Offset + other.Size && other.Offset < current.Offset + current.Size;
+            if (isOverlapping && other.LastPass > latestPass)
+            {
+                latestPass = other.LastPass;
+                aliasBefore[current.Resource] = other.Resource;
+            }
+        }
+    }
+
+    for (size_t s = 0; s < mSchedule.size(); ++s)
+    {
+        RGCompiledPass& compiled = mSchedule[s];
+        const Pass& pass = mPasses[compiled.Pass];
+
+        for (const Access& access : pass.Accesses)
+        {
+            const Resource& resource = mResources[access.Resource];
+
+            // 트랜지언트 리소스를 처음 쓰는 곳에서 앨리어싱 배리어
+            const RGMemoryPlacement* placement = resource.IsImported ? nullptr : FindPlacement(access.Resource);
+            if (placement != nullptr && placement->FirstPass == (int)s)
+            {
+                bool isAdded = false;
+                for (const RGBarrier& b : compiled.Barriers)
+                    isAdded |= (b.Type == RGBarrierType::Aliasing && b.Resource == access.Resource);
+
+                if (!isAdded)
+                {
+                    RGBarrier barrier;
+                    barrier.Type = RGBarrierType::Aliasing;
+                    barrier.Resource = access.Resource;
+                    barrier.AliasBefore = aliasBefore[access.Resource];
+                    compiled.Barriers.push_back(barrier);
+                }
+            }
+
+            std::uint32_t& state = currentState[access.Resource];
+            std::uint32_t targetState = access.State;
+
+            if (!access.IsWrite)
+            {
+                // 이미 필요한 읽기 상태를 모두 포함하고 있으면 전환하지 않는다.
+                if (!RGState::IsWriteState(state) && state != RGState::Common && (state & access.State) == access.State)
+                    continue;
+
+                targetState = GatherReadState(access.Resource, s);
+            }
+
+            if (state == targetState)
+                continue;
+
+            // 같은 패스에서 이미 전환한 리소스는 대상 상태를 합친다.
+            bool isMerged = false;
+            for (RGBarrier& b : compiled.Barriers)
+            {
+                if (b.Type == RGBarrierType::Transition && b.Resource == access.Resource)
+                {
+                    if (!RGState::IsWriteState(b.StateAfter) && !RGState::IsWriteState(targetState))
+                        b.StateAfter |= targetState;
+                    else
+                        b.StateAfter = targetState;
+                    state = b.StateAfter;
+                    isMerged = true;
+                    break;
+                }
+            }
+            if (isMerged)
+                continue;
+
+            RGBarrier barrier;
+            barrier.Type = RGBarrierType::Transition;
+            barrier.Resource = access.Resource;
+            barrier.StateBefore = state;
+            barrier.StateAfter = targetState;
+            compiled.Barriers.push_back(barrier);
+
+            state = targetState;
+        }
+    }
+
+    // 프레임 끝 : 임포트 리소스는 요청한 상태로, 트랜지언트 리소스는 생성 상태로 되돌린다.
+    for (size_t r = 0; r < mResources.size(); ++r)
+    {
+        const Resource& resource = mResources[r];
+        if (!resource.IsImported && FindPlacement((int)r) == nullptr)
+            continue;
+
+        if (currentState[r] == resource.FinalState)
+            continue;
+
+        RGBarrier barrier;
+        barrier.Type = RGBarrierType::Transition;
+        barrier.Resource = (int)r;
+        barrier.StateBefore = currentState[r];
+        barrier.StateAfter = resource.FinalState;
+        mFinalBarriers.push_back(barrier);
+    }
+}
+
+// 전환 지점과 직전 사용 사이에 다른 패스가 있으면 Split 배리어로 나눈다.
+void RenderGraph::BuildSplitBarriers()
+{
+    auto splitBarrier = [this](RGBarrier& barrier, int scheduleIndex)
+    {
+        if (barrier.Type != RGBarrierType::Transition)
+            return;
+
+        int lastUse = FindLastUse(barrier.Resource, scheduleIndex);
+        if (lastUse < 0 || lastUse >= scheduleIndex - 1)
+            return;
+
+        RGBarrier begin = barrier;
+        begin.Split = RGSplit::Begin;
+        mSchedule[lastUse].PostBarriers.push_back(begin);
+
+        barrier.Split = RGSplit::End;
+    };
+
+    for (int s = 0; s < (int)mSchedule.size(); ++s)
+    {
+        for (RGBarrier& barrier : mSchedule[s].Barriers)
+            splitBarrier(barrier, s);
+    }
+
+    // 프레임 끝 배리어는 임포트 리소스만 나눈다.
+    // (트랜지언트는 마지막 사용 후 다른 리소스가 같은 메모리를 쓸 수 있다)
+    for (RGBarrier& barrier : mFinalBarriers)
+    {
+        if (mResources[barrier.Resource].IsImported)
+            splitBarrier(barrier, (int)mSchedule.size());
+    }
+}
+
+int RenderGraph::FindLastUse(int resource, int beforeScheduleIndex)const
+{
+    for (int s = beforeScheduleIndex - 1; s >= 0; --s)
+    {
+        for (const Access& access : mPasses[mSchedule[s].Pass].Accesses)
+        {
+            if (access.Resource == resource)
+                return s;
+        }
+    }
+    return -1;
+}
+
+const RGMemoryPlacement* RenderGraph::FindPlacement(int resource)const
+{
+    for (const RGMemoryPlacement& placement : mMemoryPlan.Placements)
+    {
+        if (placement.Resource == resource)
+            return &placement;
+    }
+    return nullptr;
+}
+
+std::string RenderGraph::Dump()const
+{
+    std::string out;
+    char line[512];
+
+    int culledCount = 0;
+    for (const Pass& pass : mPasses)
+        culledCount += pass.IsCulled ? 1 : 0;
+
+    snprintf(line, sizeof(line), "RenderGraph: %d passes (%d culled), %d resources\n",
+        (int)mPasses.size(), culledCount, (int)mResources.size());
+    out += line;
+
+    auto appendBarrier = [this, &out, &line](const RGBarrier& b)
+    {
+        if (b.Type == RGBarrierType::Aliasing)
+        {
+            snprintf(line, sizeof(line), "    alias    %-16s (before: %s)\n",
+                mResources[b.Resource].Name.c_str(),
+                b.AliasBefore >= 0 ? mResources[b.AliasBefore].Name.c_str() : "any");
+        }
+        else
+        {
+            const char* kind = b.Split == RGSplit::Begin ? "begin  " : (b.Split == RGSplit::End ? "end    " : "barrier");
+            snprintf(line, sizeof(line), "    %s  %-16s %s -> %s\n",
+                kind,
+                mResources[b.Resource].Name.c_str(),
+                RGState::ToString(b.StateBefore).c_str(),
+                RGState::ToString(b.StateAfter).c_str());
+        }
+        out += line;
+    };
+
+    for (size_t s = 0; s < mSchedule.size(); ++s)
+    {
+        const RGCompiledPass& compiled = mSchedule[s];
+        snprintf(line, sizeof(line), "[%d] %s (%d barriers before, %d after)\n",
+            (int)s, mPasses[compiled.Pass].Name.c_str(), (int)compiled.Barriers.size(), (int)compiled.PostBarriers.size());
+        out += line;
+
+        for (const RGBarrier& b : compiled.Barriers)
+            appendBarrier(b);
+        for (const RGBarrier& b : compiled.PostBarriers)
+            appendBarrier(b);
+    }
+
+    if (!mFinalBarriers.empty())
+    {
+        out += "[end]\n";
+        for (const RGBarrier& b : mFinalBarriers)
+            appendBarrier(b);
+    }
+
+    for (const Pass& pass : mPasses)
+    {
+        if (pass.IsCulled)
+        {
+            snprintf(line, sizeof(line), "culled: %s\n", pass.Name.c_str());
+            out += line;
+        }
+    }
+
+    snprintf(line, sizeof(line), "memory: heap %.2f MB (unaliased %.2f MB)\n",
+        mMemoryPlan.HeapSize / (1024.0 * 1024.0), mMemoryPlan.UnaliasedSize / (1024.0 * 1024.0));
+    out += line;
+
+    for (const RGMemoryPlacement& p : mMemoryPlan.Placements)
+    {
+        snprintf(line, sizeof(line), "    %-16s offset %10llu size %10llu passes [%d, %d]\n",
+            mResources[p.Resource].Name.c_str(),
+            (unsigned long long)p.Offset, (unsigned long long)p.Size, p.FirstPass, p.LastPass);
+        out += line;
+    }
+
+    return out;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+// 패스 실행 시 넘겨받는 컨텍스트 (D3D12 실행기에서 정의)
+class RenderGraphContext;
+
+// 리소스 상태 비트 (값은 D3D12_RESOURCE_STATES와 동일)
+// 그래프 컴파일은 D3D12 헤더 없이 CPU만으로 동작한다.
+namespace RGState
+{
+    const std::uint32_t Common              = 0;
+    const std::uint32_t Present             = 0;
+    const std::uint32_t RenderTarget        = 0x4;
+    const std::uint32_t DepthWrite          = 0x10;
+    const std::uint32_t DepthRead           = 0x20;
+    const std::uint32_t NonPixelShaderResource = 0x40;
+    const std::uint32_t PixelShaderResource = 0x80;
+    const std::uint32_t CopyDest            = 0x400;
+    const std::uint32_t CopySource          = 0x800;
+
+    // 쓰기 상태는 다른 상태와 합칠 수 없다.
+    inline bool IsWriteState(std::uint32_t state)
+    {
+        return (state & (RenderTarget | DepthWrite | CopyDest)) != 0;
+    }
+
+    std::string ToString(std::uint32_t state);
+}
+
+struct RGHandle
+{
+    int Index = -1;
+
+    bool IsValid()const { return Index >= 0; }
+};
+
+// 트랜지언트 텍스처 정보
+struct RGTextureDesc
+{
+    std::uint32_t Width = 0;
+    std::uint32_t Height = 0;
+    std::uint32_t Format = 0;       // DXGI_FORMAT (리소스 포맷)
+    std::uint32_t ViewFormat = 0;   // RTV/DSV에 사용할 포맷 (typeless 리소스용)
+    bool IsDepthStencil = false;
+
+    // 힙 배치용 크기/정렬 (실행기가 디바이스에 물어보고 채운다)
+    std::uint64_t SizeInBytes = 0;
+    std::uint64_t Alignment = 65536;
+};
+
+enum class RGBarrierType
+{
+    Transition,
+    Aliasing
+};
+
+// Split 배리어 : 마지막 사용 직후 Begin, 다음 사용 직전 End
+// 사이에 있는 다른 패스와 전환이 겹칠 수 있다.
+enum class RGSplit
+{
+    None,
+    Begin,
+    End
+};
+
+struct RGBarrier
+{
+    RGBarrierType Type = RGBarrierType::Transition;
+    int Resource = -1;
+    int AliasBefore = -1;           // Aliasing: 같은 메모리를 먼저 쓰던 리소스 (-1이면 알 수 없음)
+    std::uint32_t StateBefore = 0;
+    std::uint32_t StateAfter = 0;
+    RGSplit Split = RGSplit::None;
+};
+
+// 컴파일된 패스 : 실행 전에 Barriers를, 실행 후에 PostBarriers를 각각 한 번의 ResourceBarrier 호출로 제출한다.
+struct RGCompiledPass
+{
+    int Pass = -1;
+    std::vector<RGBarrier> Barriers;
+    std::vector<RGBarrier> PostBarriers;    // Split Begin
+};
+
+// 트랜지언트 리소스의 힙 배치 결과
+struct RGMemoryPlacement
+{
+    int Resource = -1;
+    std::uint64_t Offset = 0;
+    std::uint64_t Size = 0;
+    int FirstPass = 0;  // 스케줄 인덱스
+    int LastPass = 0;
+};
+
+struct RGMemoryPlan
+{
+    std::uint64_t HeapSize = 0;         // 앨리어싱 적용 후 필요한 힙 크기
+    std::uint64_t UnaliasedSize = 0;    // 앨리어싱 없이 따로 만들었을 때 크기
+    std::vector<RGMemoryPlacement> Placements;
+};
+
+// 프레임 그래프
+// 매 프레임 패스가 읽고 쓰는 리소스를 선언하면 Compile에서
+//  1. 결과에 기여하지 않는 패스 제거
+//  2. 패스 사이의 최소 배리어 계산 (패스 단위로 묶음)
+//  3. 수명이 겹치지 않는 트랜지언트 리소스를 같은 힙 메모리에 앨리어싱
+// 을 수행한다.
+class RenderGraph
+{
+public:
+    using ExecuteFn = std::function<void(RenderGraphContext&)>;
+
+    class PassBuilder
+    {
+    public:
+        PassBuilder(RenderGraph* graph, int pass) : mGraph(graph), mPass(pass) {}
+
+        PassBuilder& Read(RGHandle resource, std::uint32_t state);
+        PassBuilder& Write(RGHandle resource, std::uint32_t state);
+        PassBuilder& SideEffect();  // 출력이 없어도 제거하지 않는다. (Present 등)
+
+        int PassIndex()const { return mPass; }
+
+    private:
+        RenderGraph* mGraph = nullptr;
+        int mPass = -1;
+    };
+
+public:
+    // 매 프레임 그래프를 다시 선언하기 전에 호출
+    void Reset();
+
+    // 외부에서 관리하는 리소스 (백버퍼, Scene/Game 텍스처 등)
+    RGHandle ImportTexture(const std::string& name, std::uint32_t initialState, std::uint32_t finalState);
+    // 그래프가 관리하는 트랜지언트 리소스
+    RGHandle CreateTexture(const std::string& name, const RGTextureDesc& desc);
+
+    PassBuilder AddPass(const std::string& name, ExecuteFn execute);
+
+    // 프레임 결과로 남아야 하는 리소스
+    void MarkOutput(RGHandle resource);
+
+    bool Compile();
+
+    // 컴파일된 스케줄과 메모리 배치를 문자열로 출력
+    std::string Dump()const;
+
+public:
+    int GetResourceCount()const { return (int)mResources.size(); }
+    const std::string& GetResourceName(int resource)const { return mResources[resource].Name; }
+    bool IsImported(int resource)const { return mResources[resource].IsImported; }
+    RGTextureDesc& GetTextureDesc(int resource) { return mResources[resource].Desc; }
+    const RGTextureDesc& GetTextureDesc(int resource)const { return mResources[resource].Desc; }
+    // Imported : 프레임 시작 상태, Transient : 리소스 생성 상태
+    std::uint32_t GetInitialState(int resource)const { return mResources[resource].InitialState; }
+
+    int GetPassCount()const { return (int)mPasses.size(); }
+    const std::string& GetPassName(int pass)const { return mPasses[pass].Name; }
+    bool IsPassCulled(int pass)const { return mPasses[pass].IsCulled; }
+    const ExecuteFn& GetPassExecute(int pass)const { return mPasses[pass].Execute; }
+
+    const std::vector<RGCompiledPass>& GetSchedule()const { return mSchedule; }
+    const std::vector<RGBarrier>& GetFinalBarriers()const { return mFinalBarriers; }
+    const RGMemoryPlan& GetMemoryPlan()const { return mMemoryPlan; }
+
+    // 트랜지언트 리소스의 배치 정보 (배치되지 않았으면 nullptr)
+    const RGMemoryPlacement* FindPlacement(int resource)const;
+
+private:
+    struct Resource
+    {
+        std::string Name;
+        bool IsImported = false;
+        bool IsOutput = false;
+        RGTextureDesc Desc;
+
+        // Imported : 프레임 시작/끝 상태
+        // Transient : 처음 사용하는 상태 (리소스 생성 상태이자 프레임 끝에 돌아갈 상태)
+        std::uint32_t InitialState = 0;
+        std::uint32_t FinalState = 0;
+    };
+
+    struct Access
+    {
+        int Resource = -1;
+        std::uint32_t State = 0;
+        bool IsWrite = false;
+    };
+
+    struct Pass
+    {
+        std::string Name;
+        ExecuteFn Execute;
+        std::vector<Access> Accesses;
+        bool HasSideEffect = false;
+        bool IsCulled = false;
+    };
+
+    void CullPasses();
+    void BuildMemoryPlan();
+    void BuildBarriers();
+    void BuildSplitBarriers();
+
+    std::uint32_t GatherReadState(int resource, size_t scheduleIndex)const;
+    int FindLastUse(int resource, int beforeScheduleIndex)const;
+
+private:
+    std::vector<Resource> mResources;
+    std::vector<Pass> mPasses;
+
+    std::vector<RGCompiledPass> mSchedule;
+    std::vector<RGBarrier> mFinalBarriers;
+    RGMemoryPlan mMemoryPlan;
+};
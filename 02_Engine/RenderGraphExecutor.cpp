@@ -0,0 +1,358 @@
+#include "RenderGraphExecutor.h"
+
+using Microsoft::WRL::ComPtr;
+
+void RenderGraphExecutor::Initialize(ID3D12Device* device)
+{
+    md3dDevice = device;
+
+    mRtvDescriptorSize = md3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+    mDsvDescriptorSize = md3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+
+    EnsureDescriptorCapacity(8);
+}
+
+void RenderGraphExecutor::BindImported(RGHandle resource, ID3D12Resource* d3dResource,
+    D3D12_CPU_DESCRIPTOR_HANDLE rtv, D3D12_CPU_DESCRIPTOR_HANDLE dsv)
+{
+    if (!resource.IsValid())
+        return;
+
+    if ((int)mBindings.size() <= resource.Index)
+        mBindings.resize(resource.Index + 1);
+
+    mBindings[resource.Index].Resource = d3dResource;
+    mBindings[resource.Index].RTV = rtv;
+    mBindings[resource.Index].DSV = dsv;
+}
+
+bool RenderGraphExecutor::Compile(RenderGraph& graph, UINT64 completedFence, UINT64 frameFence)
+{
+    // GPU가 다 쓴 이전 리소스 해제
+    mRetired.erase(std::remove_if(mRetired.begin(), mRetired.end(),
+        [completedFence](const RetiredObject& r) { return r.Fence <= completedFence; }), mRetired.end());
+
+    FillAllocationInfo(graph);
+    graph.Compile();
+
+    mBindings.resize(graph.GetResourceCount());
+
+    // 외부 리소스는 그래프에 선언한 시작 상태를 그대로 믿는다.
+    // (리사이즈 등으로 다시 만들어진 리소스의 예전 상태가 남지 않도록 매 프레임 다시 등록)
+    for (ID3D12Resource* resource : mImportedResources)
+        mStateTracker.Untrack(resource);
+    mImportedResources.clear();
+
+    for (int i = 0; i < graph.GetResourceCount(); ++i)
+    {
+        if (!graph.IsImported(i) || mBindings[i].Resource == nullptr)
+            continue;
+
+        mStateTracker.SetState(mBindings[i].Resource, (D3D12_RESOURCE_STATES)graph.GetInitialState(i));
+        mImportedResources.push_back(mBindings[i].Resource);
+    }
+
+    const RGMemoryPlan& plan = graph.GetMemoryPlan();
+    bool isPlanChanged = false;
+
+    // 힙이 작으면 새로 만든다. (이전 힙 위의 리소스는 모두 다시 만든다)
+    if (plan.HeapSize > mHeapSize)
+    {
+        if (mHeap != nullptr)
+            Retire(mHeap.Get(), frameFence);
+
+        for (TransientEntry& entry : mTransients)
+        {
+            if (entry.Resource != nullptr)
+            {
+                mStateTracker.Untrack(entry.Resource.Get());
+                Retire(entry.Resource.Get(), frameFence);
+            }
+            entry = TransientEntry();
+        }
+
+        D3D12_HEAP_DESC heapDesc = {};
+        heapDesc.SizeInBytes = plan.HeapSize;
+        heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+        heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+        ThrowIfFailed(md3dDevice->CreateHeap(&heapDesc, IID_PPV_ARGS(&mHeap)));
+
+        mHeapSize = plan.HeapSize;
+        isPlanChanged = true;
+    }
+
+    for (TransientEntry& entry : mTransients)
+        entry.IsUsed = false;
+
+    // 배치마다 쓰는 슬롯 (뷰 핸들은 힙이 더 커지지 않는 마지막에 채운다)
+    std::vector<int> slots(plan.Placements.size());
+    for (size_t p = 0; p < plan.Placements.size(); ++p)
+    {
+        const RGMemoryPlacement& placement = plan.Placements[p];
+        const std::string& name = graph.GetResourceName(placement.Resource);
+        const RGTextureDesc& desc = graph.GetTextureDesc(placement.Resource);
+        UINT initialState = graph.GetInitialState(placement.Resource);
+
+        // 지난 프레임과 같은 리소스면 재사용
+        int found = -1;
+        for (int i = 0; i < (int)mTransients.size(); ++i)
+        {
+            if (mTransients[i].Resource != nullptr && !mTransients[i].IsUsed && mTransients[i].Name == name)
+            {
+                found = i;
+                break;
+            }
+        }
+
+        if (found >= 0)
+        {
+            TransientEntry& entry = mTransients[found];
+            if (entry.Offset != placement.Offset || entry.InitialState != initialState || !IsSameDesc(entry.Desc, desc))
+            {
+                mStateTracker.Untrack(entry.Resource.Get());
+                Retire(entry.Resource.Get(), frameFence);
+                entry.Resource = nullptr;
+                found = -1;
+            }
+        }
+
+        if (found < 0)
+        {
+            // 빈 슬롯 (슬롯 인덱스가 곧 RTV/DSV 인덱스)
+            for (int i = 0; i < (int)mTransients.size(); ++i)
+            {
+                if (mTransients[i].Resource == nullptr)
+                {
+                    found = i;
+                    break;
+                }
+            }
+            if (found < 0)
+            {
+                mTransients.push_back(TransientEntry());
+                found = (int)mTransients.size() - 1;
+                EnsureDescriptorCapacity((UINT)mTransients.size());
+            }
+
+            TransientEntry& entry = mTransients[found];
+            entry.Name = name;
+            entry.Desc = desc;
+            entry.Offset = placement.Offset;
+            entry.InitialState = initialState;
+            CreateTransient(entry, (UINT)found);
+
+            isPlanChanged = true;
+        }
+
+        TransientEntry& entry = mTransients[found];
+        entry.IsUsed = true;
+        slots[p] = found;
+
+        mBindings[placement.Resource].Resource = entry.Resource.Get();
+    }
+
+    // 루프 중에 EnsureDescriptorCapacity가 힙을 다시 만들면 앞에서 구한 핸들은 놓인 힙을 가리키므로
+    // 마지막 힙에서 한 번에 구한다.
+    for (size_t p = 0; p < plan.Placements.size(); ++p)
+    {
+        RGResourceBinding& binding = mBindings[plan.Placements[p].Resource];
+        binding.RTV = CD3DX12_CPU_DESCRIPTOR_HANDLE(mRtvHeap->GetCPUDescriptorHandleForHeapStart(), slots[p], mRtvDescriptorSize);
+        binding.DSV = CD3DX12_CPU_DESCRIPTOR_HANDLE(mDsvHeap->GetCPUDescriptorHandleForHeapStart(), slots[p], mDsvDescriptorSize);
+    }
+
+    // 이번 프레임에 쓰지 않은 리소스 정리
+    for (TransientEntry& entry : mTransients)
+    {
+        if (!entry.IsUsed && entry.Resource != nullptr)
+        {
+            mStateTracker.Untrack(entry.Resource.Get());
+            Retire(entry.Resource.Get(), frameFence);
+            entry = TransientEntry();
+            isPlanChanged = true;
+        }
+    }
+
+    return isPlanChanged;
+}
+
+void RenderGraphExecutor::Execute(const RenderGraph& graph, ID3D12GraphicsCommandList* cmdList)
+{
+    RenderGraphContext context(cmdList, mBindings);
+
+    for (const RGCompiledPass& compiled : graph.GetSchedule())
+    {
+        SubmitBarriers(compiled.Barriers, cmdList);
+
+        const RenderGraph::ExecuteFn& execute = graph.GetPassExecute(compiled.Pass);
+        if (execute)
+            execute(context);
+
+        SubmitBarriers(compiled.PostBarriers, cmdList);
+    }
+
+    SubmitBarriers(graph.GetFinalBarriers(), cmdList);
+}
+
+// 배리어를 상태 추적기에 넘기고 한 번에 제출 (이미 같은 상태인 전환은 버려진다)
+void RenderGraphExecutor::SubmitBarriers(const std::vector<RGBarrier>& barriers, ID3D12GraphicsCommandList* cmdList)
+{
+    for (const RGBarrier& b : barriers)
+    {
+        ID3D12Resource* resource = mBindings[b.Resource].Resource;
+
+        if (b.Type == RGBarrierType::Aliasing)
+        {
+            ID3D12Resource* before = b.AliasBefore >= 0 ? mBindings[b.AliasBefore].Resource : nullptr;
+            mStateTracker.Aliasing(before, resource);
+        }
+        else if (b.Split == RGSplit::Begin)
+        {
+            mStateTracker.BeginTransition(resource, (D3D12_RESOURCE_STATES)b.StateAfter);
+        }
+        else if (b.Split == RGSplit::End)
+        {
+            mStateTracker.EndTransition(resource);
+        }
+        else
+        {
+            mStateTracker.Transition(resource, (D3D12_RESOURCE_STATES)b.StateAfter);
+        }
+    }
+
+    mStateTracker.Flush(cmdList);
+}
+
+// 트랜지언트 리소스의 실제 크기/정렬을 디바이스에 물어본다.
+void RenderGraphExecutor::FillAllocationInfo(RenderGraph& graph)
+{
+    for (int i = 0; i < graph.GetResourceCount(); ++i)
+    {
+        if (graph.IsImported(i))
+            continue;
+
+        RGTextureDesc& desc = graph.GetTextureDesc(i);
+
+        // 같은 설정의 리소스가 있으면 다시 묻지 않는다.
+        bool isCached = false;
+        for (const TransientEntry& entry : mTransients)
+        {
+            if (entry.Resource != nullptr && IsSameDesc(entry.Desc, desc))
+            {
+                desc.SizeInBytes = entry.Desc.SizeInBytes;
+                desc.Alignment = entry.Desc.Alignment;
+                isCached = true;
+                break;
+            }
+        }
+        if (isCached)
+            continue;
+
+        D3D12_RESOURCE_DESC texDesc = CD3DX12_RESOURCE_DESC::Tex2D((DXGI_FORMAT)desc.Format, desc.Width, desc.Height, 1, 1, 1, 0,
+            desc.IsDepthStencil ? D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL : D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+
+        D3D12_RESOURCE_ALLOCATION_INFO info = md3dDevice->GetResourceAllocationInfo(0, 1, &texDesc);
+        desc.SizeInBytes = info.SizeInBytes;
+        desc.Alignment = info.Alignment;
+    }
+}
+
+void RenderGraphExecutor::CreateTransient(TransientEntry& entry, UINT descriptorIndex)
+{
+    const RGTextureDesc& desc = entry.Desc;
+    DXGI_FORMAT viewFormat = (DXGI_FORMAT)(desc.ViewFormat != 0 ? desc.ViewFormat : desc.Format);
+
+    D3D12_RESOURCE_DESC texDesc = CD3DX12_RESOURCE_DESC::Tex2D((DXGI_FORMAT)desc.Format, desc.Width, desc.Height, 1, 1, 1, 0,
+        desc.IsDepthStencil ? D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL : D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+
+    D3D12_CLEAR_VALUE clearValue = {};
+    clearValue.Format = viewFormat;
+    if (desc.IsDepthStencil)
+    {
+        clearValue.DepthStencil.Depth = 1.0f;
+        clearValue.DepthStencil.Stencil = 0;
+    }
+    else
+    {
+        clearValue.Color[3] = 1.0f;
+    }
+
+    ThrowIfFailed(md3dDevice->CreatePlacedResource(
+        mHeap.Get(),
+        entry.Offset,
+        &texDesc,
+        (D3D12_RESOURCE_STATES)entry.InitialState,
+        &clearValue,
+        IID_PPV_ARGS(&entry.Resource)));
+
+    mStateTracker.SetState(entry.Resource.Get(), (D3D12_RESOURCE_STATES)entry.InitialState);
+
+    CreateViews(entry, descriptorIndex);
+}
+
+void RenderGraphExecutor::Retire(ID3D12Pageable* object, UINT64 fence)
+{
+    RetiredObject retired;
+    retired.Fence = fence;
+    retired.Object = object;
+    mRetired.push_back(retired);
+}
+
+// RTV/DSV는 기록 시점에 복사되므로 CPU 힙은 언제든 다시 만들 수 있다.
+void RenderGraphExecutor::EnsureDescriptorCapacity(UINT count)
+{
+    if (count <= mDescriptorCapacity)
+        return;
+
+    UINT capacity = std::max<UINT>(count, mDescriptorCapacity * 2);
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = capacity;
+    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mRtvHeap)));
+
+    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
+    ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mDsvHeap)));
+
+    mDescriptorCapacity = capacity;
+
+    // 기존 리소스의 뷰를 새 힙에 다시 만든다.
+    for (UINT i = 0; i < (UINT)mTransients.size(); ++i)
+    {
+        if (mTransients[i].Resource != nullptr)
+            CreateViews(mTransients[i], i);
+    }
+}
+
+void RenderGraphExecutor::CreateViews(const TransientEntry& entry, UINT descriptorIndex)
+{
+    DXGI_FORMAT viewFormat = (DXGI_FORMAT)(entry.Desc.ViewFormat != 0 ? entry.Desc.ViewFormat : entry.Desc.Format);
+
+    if (entry.Desc.IsDepthStencil)
+    {
+        D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+        dsvDesc.Format = viewFormat;
+        dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+        dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
+        dsvDesc.Texture2D.MipSlice = 0;
+
+        CD3DX12_CPU_DESCRIPTOR_HANDLE dsv(mDsvHeap->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, mDsvDescriptorSize);
+        md3dDevice->CreateDepthStencilView(entry.Resource.Get(), &dsvDesc, dsv);
+    }
+    else
+    {
+        D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
+        rtvDesc.Format = viewFormat;
+        rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+
+        CD3DX12_CPU_DESCRIPTOR_HANDLE rtv(mRtvHeap->GetCPUDescriptorHandleForHeapStart(), descriptorIndex, mRtvDescriptorSize);
+        md3dDevice->CreateRenderTargetView(entry.Resource.Get(), &rtvDesc, rtv);
+    }
+}
+
+bool RenderGraphExecutor::IsSameDesc(const RGTextureDesc& a, const RGTextureDesc& b)
+{
+    return a.Width == b.Width && a.Height == b.Height && a.Format == b.Format
+        && a.ViewFormat == b.ViewFormat && a.IsDepthStencil == b.IsDepthStencil;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "RenderGraph.h"
+#include "ResourceStateTracker.h"
+
+// 그래프 리소스 하나에 대응하는 실제 D3D12 리소스와 뷰
+struct RGResourceBinding
+{
+    ID3D12Resource* Resource = nullptr;
+    D3D12_CPU_DESCRIPTOR_HANDLE RTV = {};
+    D3D12_CPU_DESCRIPTOR_HANDLE DSV = {};
+};
+
+// 패스 실행 함수에 넘겨주는 컨텍스트
+class RenderGraphContext
+{
+public:
+    RenderGraphContext(ID3D12GraphicsCommandList* cmdList, const std::vector<RGResourceBinding>& bindings)
+        : CommandList(cmdList), mBindings(bindings) {}
+
+    ID3D12Resource* GetResource(RGHandle resource)const { return mBindings[resource.Index].Resource; }
+    D3D12_CPU_DESCRIPTOR_HANDLE GetRTV(RGHandle resource)const { return mBindings[resource.Index].RTV; }
+    D3D12_CPU_DESCRIPTOR_HANDLE GetDSV(RGHandle resource)const { return mBindings[resource.Index].DSV; }
+
+public:
+    ID3D12GraphicsCommandList* CommandList = nullptr;
+
+private:
+    const std::vector<RGResourceBinding>& mBindings;
+};
+
+// RenderGraph를 D3D12 커맨드 리스트에 기록하는 실행기
+// 트랜지언트 리소스는 하나의 힙에 Placed Resource로 만들어 앨리어싱하고,
+// 같은 설정이면 다음 프레임에도 그대로 재사용한다.
+class RenderGraphExecutor
+{
+public:
+    RenderGraphExecutor() = default;
+    RenderGraphExecutor(const RenderGraphExecutor& rhs) = delete;
+    RenderGraphExecutor& operator=(const RenderGraphExecutor& rhs) = delete;
+
+    void Initialize(ID3D12Device* device);
+
+    // 외부 리소스 연결 (그래프 선언 후, Compile 전에 호출)
+    void BindImported(RGHandle resource, ID3D12Resource* d3dResource,
+        D3D12_CPU_DESCRIPTOR_HANDLE rtv = {}, D3D12_CPU_DESCRIPTOR_HANDLE dsv = {});
+
+    // 그래프 컴파일 + 트랜지언트 리소스 준비
+    // completedFence : GPU가 끝낸 펜스 값 (이전 리소스 해제용)
+    // frameFence : 이번 프레임 제출 후 Signal할 펜스 값
+    // 힙 배치가 바뀌었으면 true
+    bool Compile(RenderGraph& graph, UINT64 completedFence, UINT64 frameFence);
+
+    // 배리어와 패스를 커맨드 리스트에 기록
+    void Execute(const RenderGraph& graph, ID3D12GraphicsCommandList* cmdList);
+
+    UINT64 GetHeapSize()const { return mHeapSize; }
+    const ResourceStateTracker& GetStateTracker()const { return mStateTracker; }
+
+private:
+    struct TransientEntry
+    {
+        std::string Name;
+        RGTextureDesc Desc;
+        UINT64 Offset = 0;
+        UINT InitialState = 0;
+        Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+        bool IsUsed = false;
+    };
+
+    struct RetiredObject
+    {
+        UINT64 Fence = 0;
+        Microsoft::WRL::ComPtr<ID3D12Pageable> Object;
+    };
+
+    void FillAllocationInfo(RenderGraph& graph);
+    void CreateTransient(TransientEntry& entry, UINT descriptorIndex);
+    void CreateViews(const TransientEntry& entry, UINT descriptorIndex);
+    void Retire(ID3D12Pageable* object, UINT64 fence);
+    void EnsureDescriptorCapacity(UINT count);
+    void SubmitBarriers(const std::vector<RGBarrier>& barriers, ID3D12GraphicsCommandList* cmdList);
+
+    static bool IsSameDesc(const RGTextureDesc& a, const RGTextureDesc& b);
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+
+    Microsoft::WRL::ComPtr<ID3D12Heap> mHeap;
+    UINT64 mHeapSize = 0;
+
+    std::vector<TransientEntry> mTransients;
+    std::vector<RGResourceBinding> mBindings;   // 그래프 리소스 인덱스 -> 실제 리소스
+
+    // 트랜지언트 리소스용 RTV/DSV (CPU 전용)
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mRtvHeap;
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mDsvHeap;
+    UINT mDescriptorCapacity = 0;
+    UINT mRtvDescriptorSize = 0;
+    UINT mDsvDescriptorSize = 0;
+
+    // 리소스 상태 추적 (그래프가 계산한 배리어 중 실제로 필요한 것만 제출)
+    ResourceStateTracker mStateTracker;
+    std::vector<ID3D12Resource*> mImportedResources;    // 지난 프레임에 연결된 외부 리소스
+
+    // GPU가 아직 사용 중일 수 있는 이전 힙/리소스
+    std::vector<RetiredObject> mRetired;
+};
@@ -0,0 +1,131 @@
+#include "RenderTargetPool.h"
+#include "GpuMemoryAllocator.h"
+#include "DeferredReleaseQueue.h"
+
+using Microsoft::WRL::ComPtr;
+
+void RenderTargetPool::Initialize(
+    ID3D12Device* device,
+    GpuMemoryAllocator* allocator,
+    GpuDescriptorHeap* descriptorHeap,
+    DeferredReleaseQueue* releaseQueue,
+    UINT capacity,
+    UINT bucketSize)
+{
+    md3dDevice = device;
+    mAllocator = allocator;
+    mDescriptorHeap = descriptorHeap;
+    mReleaseQueue = releaseQueue;
+    mCache.SetBucketSize(bucketSize);
+
+    mRtvHeap.Initialize(md3dDevice, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, capacity);
+}
+
+PooledRenderTarget* RenderTargetPool::Acquire(UINT width, UINT height, DXGI_FORMAT format)
+{
+    // 요청 크기 이상이면서 면적이 가장 작은 타겟 (GPU가 다 쓴 것만), 없으면 버킷 크기로 새로 만든다.
+    return mCache.Acquire(width, height, format, [this](UINT targetWidth, UINT targetHeight, DXGI_FORMAT targetFormat)
+    {
+        return CreateTarget(targetWidth, targetHeight, targetFormat);
+    });
+}
+
+void RenderTargetPool::Release(PooledRenderTarget* target, UINT64 frame)
+{
+    assert(target == nullptr || target->IsInUse);
+    mCache.Release(target, frame);
+}
+
+void RenderTargetPool::Collect(UINT64 completedFrame, UINT64 maxIdleFrames)
+{
+    // GPU가 다 쓴 타겟이므로 바로 놓아도 된다.
+    mCache.Collect(completedFrame, maxIdleFrames, [this](PooledRenderTarget& target) { DestroyTarget(target, 0); });
+}
+
+void RenderTargetPool::Clear(UINT64 fence)
+{
+    mCache.Clear([this, fence](PooledRenderTarget& target) { DestroyTarget(target, fence); });
+}
+
+UINT64 RenderTargetPool::GetMemoryUsage()const
+{
+    UINT64 total = 0;
+    for (const auto& target : mCache.GetTargets())
+    {
+        D3D12_RESOURCE_DESC desc = target->Resource->GetDesc();
+        total += md3dDevice->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+    }
+    return total;
+}
+
+std::unique_ptr<PooledRenderTarget> RenderTargetPool::CreateTarget(UINT width, UINT height, DXGI_FORMAT format)
+{
+    auto target = std::make_unique<PooledRenderTarget>();
+    target->Width = width;
+    target->Height = height;
+    target->Format = format;
+
+    D3D12_RESOURCE_DESC texDesc = {};
+    texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    texDesc.Width = width;
+    texDesc.Height = height;
+    texDesc.DepthOrArraySize = 1;
+    texDesc.MipLevels = 1;
+    texDesc.Format = format;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.SampleDesc.Quality = 0;
+    texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+    D3D12_CLEAR_VALUE clearValue = {};
+    clearValue.Format = format;
+    clearValue.Color[0] = 0.0f;
+    clearValue.Color[1] = 0.0f;
+    clearValue.Color[2] = 0.0f;
+    clearValue.Color[3] = 1.0f;
+
+    if (mAllocator != nullptr)
+    {
+        target->Resource = mAllocator->CreateResource(
+            D3D12_HEAP_TYPE_DEFAULT,
+            texDesc,
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+            &clearValue);
+    }
+    else
+    {
+        CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
+        ThrowIfFailed(md3dDevice->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &texDesc,
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+            &clearValue,
+            IID_PPV_ARGS(&target->Resource)));
+    }
+
+    target->RTV = mRtvHeap.Allocate();
+    md3dDevice->CreateRenderTargetView(target->Resource.Get(), nullptr, target->RTV.CPU);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Format = format;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+
+    target->SRV = mDescriptorHeap->AllocatePersistent();
+    md3dDevice->CreateShaderResourceView(target->Resource.Get(), &srvDesc, target->SRV.CPU);
+
+    return target;
+}
+
+void RenderTargetPool::DestroyTarget(PooledRenderTarget& target, UINT64 fence)
+{
+    // RTV는 기록할 때 읽히므로 바로 재사용해도 되고, SRV는 통합 힙이 펜스로 회수한다.
+    mRtvHeap.Free(target.RTV);
+    mDescriptorHeap->FreePersistent(target.SRV);
+
+    if (mReleaseQueue != nullptr)
+        mReleaseQueue->Enqueue(fence, target.Resource);
+    target.Resource = nullptr;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "DescriptorHeap.h"
+#include "../01_Core/RenderTargetCache.h"
+
+class GpuMemoryAllocator;
+class DeferredReleaseQueue;
+
+// 풀에서 빌려주는 컬러 렌더 타겟 (RTV + 셰이더용 SRV 포함)
+// 텍스처는 PIXEL_SHADER_RESOURCE 상태로 만들어지고, 빌린 쪽도 그 상태로 돌려줘야 한다.
+struct PooledRenderTarget
+{
+    Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+    DescriptorHandle RTV;       // 풀 전용 RTV 힙
+    DescriptorHandle SRV;       // 통합 힙의 영구 영역
+
+    UINT Width = 0;             // 실제 텍스처 크기 (요청 크기 이상, 버킷 단위로 올림)
+    UINT Height = 0;
+    DXGI_FORMAT Format = DXGI_FORMAT_UNKNOWN;
+
+    UINT64 ReleaseFrame = 0;    // 반환된 프레임 (이 프레임이 끝나야 다시 빌려줄 수 있다)
+    bool IsInUse = false;
+};
+
+// 크기/포맷별 렌더 타겟 캐시
+// 패널 크기가 조금씩 바뀌어도 버킷 안이면 같은 텍스처를 쓰고 뷰포트만 줄여서 그린다.
+// 재사용 규칙은 RenderTargetCache가 정하고, 여기서는 텍스처와 디스크립터를 만들고 놓는다.
+class RenderTargetPool
+{
+public:
+    // 요청 면적의 이 배수를 넘는 타겟에는 그리지 않는다. (Acquire, IsFit 공통)
+    static constexpr UINT64 MaxAreaRatio = RenderTargetCache<PooledRenderTarget>::MaxAreaRatio;
+
+public:
+    RenderTargetPool() = default;
+    RenderTargetPool(const RenderTargetPool& rhs) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool& rhs) = delete;
+
+    void Initialize(
+        ID3D12Device* device,
+        GpuMemoryAllocator* allocator,
+        GpuDescriptorHeap* descriptorHeap,
+        DeferredReleaseQueue* releaseQueue,
+        UINT capacity = 32,
+        UINT bucketSize = 64);
+
+    // width x height 이상인 타겟을 빌린다. 너무 큰 타겟(면적 MaxAreaRatio배 초과)은 재사용하지 않는다.
+    PooledRenderTarget* Acquire(UINT width, UINT height, DXGI_FORMAT format);
+
+    // 빌린 타겟에 width x height를 계속 그려도 되는지 (Acquire와 같은 기준)
+    bool IsFit(const PooledRenderTarget& target, UINT width, UINT height)const { return mCache.IsFit(target, width, height); }
+
+    // frame 이후로는 쓰지 않는다는 뜻 (completedFrame이 frame 이상이 되면 다시 빌려준다)
+    void Release(PooledRenderTarget* target, UINT64 frame);
+
+    // completedFrame : GPU가 다 쓴 마지막 프레임
+    // 반환된 뒤 maxIdleFrames 동안 아무도 빌리지 않은 타겟은 해제한다.
+    void Collect(UINT64 completedFrame, UINT64 maxIdleFrames = 120);
+
+    // 빌려준 타겟까지 모두 해제한다. 텍스처는 fence가 끝난 뒤 놓이므로 GPU를 기다리지 않아도 된다.
+    void Clear(UINT64 fence);
+
+    UINT GetTargetCount()const { return (UINT)mCache.GetTargets().size(); }
+    UINT64 GetMemoryUsage()const;
+
+private:
+    std::unique_ptr<PooledRenderTarget> CreateTarget(UINT width, UINT height, DXGI_FORMAT format);
+    // 텍스처는 fence가 지난 뒤 해제 큐에서 놓인다.
+    void DestroyTarget(PooledRenderTarget& target, UINT64 fence);
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+    GpuMemoryAllocator* mAllocator = nullptr;
+    GpuDescriptorHeap* mDescriptorHeap = nullptr;
+    DeferredReleaseQueue* mReleaseQueue = nullptr;
+
+    StagingDescriptorHeap mRtvHeap;
+
+    RenderTargetCache<PooledRenderTarget> mCache;
+};
@@ -0,0 +1,89 @@
+#include "ResourceStateTracker.h"
+
+static_assert(ResourceStateTable::AllSubresources == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+    "ResourceStateTable::AllSubresources must match D3D12");
+
+// D3D12에서 다른 상태와 합칠 수 없는 쓰기 상태
+static std::uint32_t GetWriteStates()
+{
+    return D3D12_RESOURCE_STATE_RENDER_TARGET |
+        D3D12_RESOURCE_STATE_UNORDERED_ACCESS |
+        D3D12_RESOURCE_STATE_DEPTH_WRITE |
+        D3D12_RESOURCE_STATE_STREAM_OUT |
+        D3D12_RESOURCE_STATE_COPY_DEST |
+        D3D12_RESOURCE_STATE_RESOLVE_DEST;
+}
+
+ResourceStateTracker::ResourceStateTracker()
+    : mTable(GetWriteStates())
+{
+}
+
+void ResourceStateTracker::SetState(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresourceCount)
+{
+    mTable.SetState(resource, (std::uint32_t)state, subresourceCount);
+}
+
+D3D12_RESOURCE_STATES ResourceStateTracker::GetState(ID3D12Resource* resource, UINT subresource)const
+{
+    return (D3D12_RESOURCE_STATES)mTable.GetState(resource, subresource);
+}
+
+void ResourceStateTracker::Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource)
+{
+    mTable.Transition(resource, (std::uint32_t)after, subresource);
+}
+
+void ResourceStateTracker::BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource)
+{
+    mTable.BeginTransition(resource, (std::uint32_t)after, subresource);
+}
+
+void ResourceStateTracker::EndTransition(ID3D12Resource* resource, UINT subresource)
+{
+    mTable.EndTransition(resource, subresource);
+}
+
+void ResourceStateTracker::Flush(ID3D12GraphicsCommandList* cmdList)
+{
+    const std::vector<StateBarrier>& pending = mTable.GetPending();
+    if (pending.empty())
+        return;
+
+    // 상태 표에는 포인터 값만 있으므로 원래 리소스 포인터로 되돌린다.
+    auto toResource = [](const void* resource) { return const_cast<ID3D12Resource*>(static_cast<const ID3D12Resource*>(resource)); };
+
+    mBarriers.clear();
+    for (const StateBarrier& b : pending)
+    {
+        switch (b.Type)
+        {
+        case StateBarrierType::Aliasing:
+            mBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Aliasing(toResource(b.Resource), toResource(b.ResourceAfter)));
+            break;
+        case StateBarrierType::UAV:
+            mBarriers.push_back(CD3DX12_RESOURCE_BARRIER::UAV(toResource(b.Resource)));
+            break;
+        case StateBarrierType::Transition:
+        {
+            D3D12_RESOURCE_BARRIER_FLAGS flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            if (b.Split == StateBarrierSplit::Begin)
+                flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+            else if (b.Split == StateBarrierSplit::End)
+                flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+
+            mBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(toResource(b.Resource),
+                (D3D12_RESOURCE_STATES)b.StateBefore, (D3D12_RESOURCE_STATES)b.StateAfter, b.Subresource, flags));
+            break;
+        }
+        }
+    }
+
+    cmdList->ResourceBarrier((UINT)mBarriers.size(), mBarriers.data());
+    mTable.ClearPending();
+}
+
+bool ResourceStateTracker::IsReadState(D3D12_RESOURCE_STATES state)
+{
+    return state != D3D12_RESOURCE_STATE_COMMON && (state & GetWriteStates()) == 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/ResourceStateTable.h"
+
+// 리소스(서브리소스)의 현재 상태를 기억하고 배리어를 모아서 제출하는 상태 추적기
+// Transition은 바로 제출하지 않고 쌓아두었다가 Flush에서 한 번의 ResourceBarrier로 제출한다.
+// 드로우/복사 전에 Flush를 호출해야 한다.
+// 상태 계산은 ResourceStateTable(01_Core)이 하고, 여기서는 D3D12 배리어로 바꿔서 제출만 한다.
+// 커맨드 리스트 하나와 같은 스레드에서만 사용한다.
+class ResourceStateTracker
+{
+public:
+    ResourceStateTracker();
+    ResourceStateTracker(const ResourceStateTracker& rhs) = delete;
+    ResourceStateTracker& operator=(const ResourceStateTracker& rhs) = delete;
+
+    // 리소스 등록 (이미 있으면 상태를 덮어쓴다)
+    void SetState(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresourceCount = 1);
+    void Untrack(ID3D12Resource* resource) { mTable.Untrack(resource); }
+    bool IsTracked(ID3D12Resource* resource)const { return mTable.IsTracked(resource); }
+
+    D3D12_RESOURCE_STATES GetState(ID3D12Resource* resource,
+        UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)const;
+
+    // 상태 전환 요청 (필요 없는 전환은 버린다)
+    void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after,
+        UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+    // Split 배리어 : Begin과 End 사이의 작업과 전환이 겹칠 수 있다.
+    // Begin 이후 End 전까지 리소스를 사용하면 안 된다.
+    void BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after,
+        UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+    void EndTransition(ID3D12Resource* resource,
+        UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+    void Aliasing(ID3D12Resource* before, ID3D12Resource* after) { mTable.Aliasing(before, after); }
+    void UAV(ID3D12Resource* resource) { mTable.UAV(resource); }
+
+    // 쌓인 배리어를 한 번에 제출
+    void Flush(ID3D12GraphicsCommandList* cmdList);
+
+    UINT GetPendingCount()const { return (UINT)mTable.GetPending().size(); }
+    const std::vector<StateBarrier>& GetPending()const { return mTable.GetPending(); }
+
+    const ResourceStateTrackerStats& GetStats()const { return mTable.GetStats(); }
+    void ResetStats() { mTable.ResetStats(); }
+
+    // 쓰기 상태가 없는 읽기 상태끼리는 합쳐서 한 번에 전환할 수 있다.
+    static bool IsReadState(D3D12_RESOURCE_STATES state);
+
+private:
+    ResourceStateTable mTable;
+    std::vector<D3D12_RESOURCE_BARRIER> mBarriers;  // Flush에서 변환한 배리어 (재사용)
+};
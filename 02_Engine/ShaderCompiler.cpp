@@ -0,0 +1,106 @@
+#include "ShaderCompiler.h"
+#include "../01_Core/MappedFile.h"
+
+namespace
+{
+    std::string GetDirectory(const std::string& path)
+    {
+        const size_t slash = path.find_last_of("\\/");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    // include 파일을 열 때마다 경로를 기록하는 핸들러
+    // 상대 경로는 include한 파일의 폴더, 원본 파일의 폴더 순서로 찾는다.
+    class TrackingInclude : public ID3DInclude
+    {
+    public:
+        TrackingInclude(const std::string& sourcePath, std::vector<std::string>& dependencies)
+            : mSourceDirectory(GetDirectory(sourcePath)), mDependencies(dependencies)
+        {
+        }
+
+        HRESULT __stdcall Open(D3D_INCLUDE_TYPE includeType, LPCSTR fileName, LPCVOID parentData, LPCVOID* data, UINT* bytes)override
+        {
+            std::vector<std::string> candidates;
+            if (includeType == D3D_INCLUDE_LOCAL)
+            {
+                auto parent = mDirectories.find(parentData);
+                if (parent != mDirectories.end())
+                    candidates.push_back(parent->second + fileName);
+            }
+            candidates.push_back(mSourceDirectory + fileName);
+
+            for (const std::string& path : candidates)
+            {
+                auto file = std::make_unique<MappedFile>();
+                if (!file->Open(path))
+                    continue;
+
+                // 빈 파일도 포인터가 필요하다.
+                static const char empty = 0;
+                *data = file->GetData() != nullptr ? (LPCVOID)file->GetData() : (LPCVOID)&empty;
+                *bytes = (UINT)file->GetSize();
+
+                mDirectories[*data] = GetDirectory(path);
+                mFiles[*data] = std::move(file);
+
+                if (std::find(mDependencies.begin(), mDependencies.end(), path) == mDependencies.end())
+                    mDependencies.push_back(path);
+                return S_OK;
+            }
+
+            return E_FAIL;
+        }
+
+        HRESULT __stdcall Close(LPCVOID data)override
+        {
+            mDirectories.erase(data);
+            mFiles.erase(data);
+            return S_OK;
+        }
+
+    private:
+        std::string mSourceDirectory;
+        std::vector<std::string>& mDependencies;
+
+        std::unordered_map<LPCVOID, std::string> mDirectories;
+        std::unordered_map<LPCVOID, std::unique_ptr<MappedFile>> mFiles;
+    };
+}
+
+std::string D3DShaderCompiler::GetIdentity()const
+{
+    return "d3dcompiler_" + std::to_string(D3D_COMPILER_VERSION);
+}
+
+bool D3DShaderCompiler::Compile(const ShaderCompileDesc& desc, ShaderCompileOutput& output)
+{
+    MappedFile source;
+    if (!source.Open(desc.SourcePath))
+    {
+        output.Errors = "Cannot open shader source: " + desc.SourcePath + "\n";
+        return false;
+    }
+
+    std::vector<D3D_SHADER_MACRO> macros;
+    for (const auto& define : desc.Defines)
+        macros.push_back({ define.first.c_str(), define.second.c_str() });
+    macros.push_back({ nullptr, nullptr });
+
+    TrackingInclude include(desc.SourcePath, output.Dependencies);
+
+    Microsoft::WRL::ComPtr<ID3DBlob> byteCode;
+    Microsoft::WRL::ComPtr<ID3DBlob> errors;
+    HRESULT hr = D3DCompile(source.GetData(), source.GetSize(), desc.SourcePath.c_str(), macros.data(), &include,
+        desc.EntryPoint.c_str(), desc.Target.c_str(), desc.Flags, 0, &byteCode, &errors);
+
+    if (errors != nullptr)
+        output.Errors.assign((const char*)errors->GetBufferPointer(), errors->GetBufferSize());
+
+    if (FAILED(hr))
+        return false;
+
+    const std::uint8_t* data = (const std::uint8_t*)byteCode->GetBufferPointer();
+    output.Bytecode.assign(data, data + byteCode->GetBufferSize());
+    return true;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "../01_Core/ShaderCache.h"
+
+// D3DCompile(FXC)을 쓰는 셰이더 컴파일러
+// 원본을 직접 읽어서 메모리에서 컴파일하고, 연 include 파일을 모두 기록해서 캐시의 의존 파일로 넘긴다.
+class D3DShaderCompiler : public IShaderCompiler
+{
+public:
+    virtual std::string GetIdentity()const override;
+    virtual bool Compile(const ShaderCompileDesc& desc, ShaderCompileOutput& output)override;
+};
@@ -0,0 +1,26 @@
+//***************************************************************************************
+// Quantization.hlsli
+//
+// Decodes quantized vertex attributes written by VertexQuantizer (VertexLayout.h).
+// Unorm8 colors and half UVs are expanded by the input assembler and need no decode.
+//***************************************************************************************
+
+#ifndef QUANTIZATION_HLSLI
+#define QUANTIZATION_HLSLI
+
+// Positions are stored as half in [-1, 1] relative to the mesh bounds.
+float3 DecodePosition(float3 q, float3 scale, float3 offset)
+{
+    return q * scale + offset;
+}
+
+// Octahedral unit vector from R16G16_SNORM.
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e.xy, 1.0f - abs(e.x) - abs(e.y));
+    if (n.z < 0.0f)
+        n.xy = (1.0f - abs(n.yx)) * (n.xy >= 0.0f ? 1.0f : -1.0f);
+    return normalize(n);
+}
+
+#endif // QUANTIZATION_HLSLI
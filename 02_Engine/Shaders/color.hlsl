@@ -3,10 +3,16 @@
 //
 // Transforms and colors geometry.
 //***************************************************************************************
+
+#include "Quantization.hlsli"
  
 cbuffer cbPerObject : register(b0)
 {
 	float4x4 gWorld; 
+	float3 gPositionScale;      // quantized position -> local space
+	float cbPerObjectPad0;
+	float3 gPositionOffset;
+	float cbPerObjectPad1;
 };
 
 cbuffer cbPass : register(b1)
@@ -29,8 +35,8 @@ cbuffer cbPass : register(b1)
 
 struct VertexIn
 {
-	float3 PosL  : POSITION;
-    float4 Color : COLOR;
+	float3 PosL  : POSITION;    // stream 0, R16G16B16A16_FLOAT
+    float4 Color : COLOR;       // stream 1, R8G8B8A8_UNORM
 };
 
 struct VertexOut
@@ -44,7 +50,8 @@ VertexOut VS(VertexIn vin)
 	VertexOut vout;
 	
 	// Transform to homogeneous clip space.
-    float4 posW = mul(float4(vin.PosL, 1.0f), gWorld);
+    float3 posL = DecodePosition(vin.PosL, gPositionScale, gPositionOffset);
+    float4 posW = mul(float4(posL, 1.0f), gWorld);
     vout.PosH = mul(posW, gViewProj);
 	
 	// Just pass vertex color into the pixel shader.
@@ -53,9 +60,23 @@ VertexOut VS(VertexIn vin)
     return vout;
 }
 
+// Depth-only passes bind stream 0 (position) only.
+float4 VSDepth(float3 PosL : POSITION) : SV_POSITION
+{
+    float3 posL = DecodePosition(PosL, gPositionScale, gPositionOffset);
+    float4 posW = mul(float4(posL, 1.0f), gWorld);
+    return mul(posW, gViewProj);
+}
+
 float4 PS(VertexOut pin) : SV_Target
 {
+#ifdef DEBUG_DEPTH
+    // Visualize linear view depth (SV_POSITION.w holds view space z).
+    float depth = saturate((pin.PosH.w - gNearZ) / (gFarZ - gNearZ));
+    return float4(sqrt(depth).xxx, 1.0f);
+#else
     return pin.Color;
+#endif
 }
 
 
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "d3dUtil.h"
+#include "GpuMemoryAllocator.h"
 
 template<typename T>
 class UploadBuffer
 {
 public:
-    UploadBuffer(ID3D12Device* device, UINT elementCount, bool isConstantBuffer) : 
+    // allocator: if non-null, the buffer is placed in one of its upload heap blocks.
+    UploadBuffer(ID3D12Device* device, UINT elementCount, bool isConstantBuffer, GpuMemoryAllocator* allocator = nullptr) : 
         mIsConstantBuffer(isConstantBuffer)
     {
         mElementByteSize = sizeof(T);
@@ -21,17 +23,27 @@ public:
         if(isConstantBuffer)
             mElementByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(T));
 
-        CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
-        CD3DX12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(mElementByteSize * elementCount);
+        if(allocator != nullptr)
+        {
+            mUploadBuffer = allocator->CreateBuffer(
+                D3D12_HEAP_TYPE_UPLOAD,
+                (UINT64)mElementByteSize * elementCount,
+                D3D12_RESOURCE_STATE_GENERIC_READ);
+        }
+        else
+        {
+            CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
+            CD3DX12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(mElementByteSize * elementCount);
 
-        ThrowIfFailed(device->CreateCommittedResource(
-            &uploadHeap,
-            D3D12_HEAP_FLAG_NONE,
-            &uploadDesc,
-            D3D12_RESOURCE_STATE_GENERIC_READ,
-            nullptr,
-            IID_PPV_ARGS(&mUploadBuffer)
-        ));
+            ThrowIfFailed(device->CreateCommittedResource(
+                &uploadHeap,
+                D3D12_HEAP_FLAG_NONE,
+                &uploadDesc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&mUploadBuffer)
+            ));
+        }
 
         ThrowIfFailed(mUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mMappedData)));
 
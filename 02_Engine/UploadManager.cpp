@@ -0,0 +1,413 @@
+#include "UploadManager.h"
+#include "GpuMemoryAllocator.h"
+
+using Microsoft::WRL::ComPtr;
+
+bool UploadFuture::IsReady()const
+{
+    return mManager == nullptr || mManager->IsComplete(mFence);
+}
+
+void UploadFuture::Wait()const
+{
+    if (mManager != nullptr)
+        mManager->WaitForFence(mFence);
+}
+
+void UploadFuture::WaitOnQueue(ID3D12CommandQueue* queue)const
+{
+    if (mManager != nullptr)
+        mManager->WaitOnQueue(queue, mFence);
+}
+
+UploadManager::~UploadManager()
+{
+    Shutdown();
+}
+
+void UploadManager::Initialize(ID3D12Device* device, UINT64 ringSize, GpuMemoryAllocator* allocator)
+{
+    md3dDevice = device;
+    mAllocator = allocator;
+
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    ThrowIfFailed(md3dDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&mCopyQueue)));
+    mCopyQueue->SetName(L"UploadManager Copy Queue");
+
+    ThrowIfFailed(md3dDevice->CreateCommandAllocator(
+        D3D12_COMMAND_LIST_TYPE_COPY,
+        IID_PPV_ARGS(&mCurrentAllocator)));
+
+    ThrowIfFailed(md3dDevice->CreateCommandList(
+        0,
+        D3D12_COMMAND_LIST_TYPE_COPY,
+        mCurrentAllocator.Get(),
+        nullptr,
+        IID_PPV_ARGS(&mCommandList)));
+    mCommandList->Close();
+
+    mTimeline.Initialize(md3dDevice);
+
+    // 스테이징 링은 처음부터 끝까지 Map해 둔다.
+    mRingSize = ringSize;
+    if (mAllocator != nullptr)
+    {
+        mRing = mAllocator->CreateBuffer(D3D12_HEAP_TYPE_UPLOAD, mRingSize, D3D12_RESOURCE_STATE_GENERIC_READ);
+    }
+    else
+    {
+        CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
+        CD3DX12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(mRingSize);
+        ThrowIfFailed(md3dDevice->CreateCommittedResource(
+            &uploadHeap,
+            D3D12_HEAP_FLAG_NONE,
+            &uploadDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&mRing)));
+    }
+    ThrowIfFailed(mRing->Map(0, nullptr, reinterpret_cast<void**>(&mRingCPU)));
+
+    mRingHead = 0;
+    mRingUsed = 0;
+    mRingPendingSize = 0;
+    mRingRegions.clear();
+}
+
+void UploadManager::Shutdown()
+{
+    if (md3dDevice == nullptr)
+        return;
+
+    UINT64 fence = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        fence = SubmitLocked();
+    }
+    WaitForFence(fence);
+
+    if (mRing != nullptr)
+        mRing->Unmap(0, nullptr);
+    mRingCPU = nullptr;
+    mRing = nullptr;
+
+    mRingRegions.clear();
+    mRetiredAllocators.clear();
+    mRetiredBuffers.clear();
+    mPendingBuffers.clear();
+
+    mCommandList = nullptr;
+    mCurrentAllocator = nullptr;
+    mCopyQueue = nullptr;
+    md3dDevice = nullptr;
+}
+
+ComPtr<ID3D12Resource> UploadManager::CreateDefaultBuffer(
+    const void* initData,
+    UINT64 byteSize,
+    GpuMemoryAllocator* allocator)
+{
+    ComPtr<ID3D12Resource> defaultBuffer;
+
+    if (allocator != nullptr)
+    {
+        defaultBuffer = allocator->CreateBuffer(D3D12_HEAP_TYPE_DEFAULT, byteSize, D3D12_RESOURCE_STATE_COMMON);
+    }
+    else
+    {
+        CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+        ThrowIfFailed(md3dDevice->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_COMMON,
+            nullptr,
+            IID_PPV_ARGS(defaultBuffer.GetAddressOf())));
+    }
+
+    CopyBuffer(defaultBuffer.Get(), 0, initData, byteSize);
+
+    return defaultBuffer;
+}
+
+void UploadManager::CopyBuffer(ID3D12Resource* dst, UINT64 dstOffset, const void* data, UINT64 byteSize)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Staging staging = AllocateStaging(byteSize, 4);
+    memcpy(staging.CPU, data, (size_t)byteSize);
+
+    // 버퍼는 COMMON -> COPY_DEST로 암시적 승격되므로 배리어가 필요 없다.
+    BeginRecording();
+    mCommandList->CopyBufferRegion(dst, dstOffset, staging.Resource, staging.Offset, byteSize);
+    ++mPendingCopies;
+}
+
+void UploadManager::AllocateBufferCopies(const BufferCopyRegion* regions, UINT count, void** data)
+{
+    // 구간마다 4바이트 정렬
+    UINT64 totalSize = 0;
+    for (UINT i = 0; i < count; ++i)
+        totalSize += (regions[i].ByteSize + 3) & ~3ull;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Staging staging = AllocateStaging(totalSize, 4);
+
+    // GPU는 제출한 뒤에야 스테이징을 읽으므로 채우기 전에 복사를 기록해도 된다.
+    BeginRecording();
+    UINT64 offset = 0;
+    for (UINT i = 0; i < count; ++i)
+    {
+        mCommandList->CopyBufferRegion(regions[i].Resource, regions[i].Offset, staging.Resource, staging.Offset + offset, regions[i].ByteSize);
+        data[i] = staging.CPU + offset;
+        offset += (regions[i].ByteSize + 3) & ~3ull;
+    }
+    mPendingCopies += count;
+}
+
+void UploadManager::CopyBufferRegion(ID3D12Resource* dst, UINT64 dstOffset, ID3D12Resource* src, UINT64 srcOffset, UINT64 byteSize)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // src도 COMMON -> COPY_SOURCE로 암시적 승격된다. (버퍼는 다른 큐가 읽는 중이어도 된다)
+    BeginRecording();
+    mCommandList->CopyBufferRegion(dst, dstOffset, src, srcOffset, byteSize);
+    ++mPendingCopies;
+}
+
+void UploadManager::CopyTexture(ID3D12Resource* dst, UINT firstSubresource, UINT numSubresources, const D3D12_SUBRESOURCE_DATA* data)
+{
+    D3D12_RESOURCE_DESC desc = dst->GetDesc();
+
+    std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(numSubresources);
+    std::vector<UINT> numRows(numSubresources);
+    std::vector<UINT64> rowSizes(numSubresources);
+    UINT64 totalBytes = 0;
+    md3dDevice->GetCopyableFootprints(&desc, firstSubresource, numSubresources, 0,
+        layouts.data(), numRows.data(), rowSizes.data(), &totalBytes);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Staging staging = AllocateStaging(totalBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    // 행 피치가 256바이트 정렬이라 한 행씩 옮긴다.
+    for (UINT i = 0; i < numSubresources; ++i)
+    {
+        const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[i];
+        const UINT64 dstSlicePitch = (UINT64)layout.Footprint.RowPitch * numRows[i];
+
+        for (UINT z = 0; z < layout.Footprint.Depth; ++z)
+        {
+            BYTE* dstSlice = staging.CPU + layout.Offset + dstSlicePitch * z;
+            const BYTE* srcSlice = reinterpret_cast<const BYTE*>(data[i].pData) + data[i].SlicePitch * z;
+            for (UINT y = 0; y < numRows[i]; ++y)
+            {
+                memcpy(dstSlice + (UINT64)layout.Footprint.RowPitch * y,
+                    srcSlice + data[i].RowPitch * y,
+                    (size_t)rowSizes[i]);
+            }
+        }
+    }
+
+    BeginRecording();
+    for (UINT i = 0; i < numSubresources; ++i)
+    {
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout = layouts[i];
+        layout.Offset += staging.Offset;
+
+        CD3DX12_TEXTURE_COPY_LOCATION dstLocation(dst, firstSubresource + i);
+        CD3DX12_TEXTURE_COPY_LOCATION srcLocation(staging.Resource, layout);
+        mCommandList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+    }
+    ++mPendingCopies;
+}
+
+UploadFuture UploadManager::Submit()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return UploadFuture(this, SubmitLocked());
+}
+
+bool UploadManager::IsComplete(UINT64 fence)
+{
+    return mTimeline.IsComplete(fence);
+}
+
+void UploadManager::WaitForFence(UINT64 fence)
+{
+    mTimeline.Wait(fence);
+}
+
+void UploadManager::WaitOnQueue(ID3D12CommandQueue* queue, UINT64 fence)
+{
+    if (!mTimeline.IsComplete(fence))
+        ThrowIfFailed(queue->Wait(mTimeline.GetFence(), fence));
+}
+
+UINT64 UploadManager::GetRingUsed()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ReleaseCompleted();
+    return mRingUsed;
+}
+
+UploadManager::Staging UploadManager::AllocateStaging(UINT64 size, UINT64 alignment)
+{
+    Staging staging;
+
+    // 링보다 큰 업로드는 전용 업로드 버퍼를 만들어서 제출이 끝날 때까지 들고 있는다.
+    if (size > mRingSize)
+    {
+        ComPtr<ID3D12Resource> buffer;
+        if (mAllocator != nullptr)
+        {
+            buffer = mAllocator->CreateBuffer(D3D12_HEAP_TYPE_UPLOAD, size, D3D12_RESOURCE_STATE_GENERIC_READ);
+        }
+        else
+        {
+            CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
+            CD3DX12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+            ThrowIfFailed(md3dDevice->CreateCommittedResource(
+                &uploadHeap,
+                D3D12_HEAP_FLAG_NONE,
+                &uploadDesc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&buffer)));
+        }
+
+        ThrowIfFailed(buffer->Map(0, nullptr, reinterpret_cast<void**>(&staging.CPU)));
+        staging.Resource = buffer.Get();
+        staging.Offset = 0;
+        mPendingBuffers.push_back(buffer);
+        return staging;
+    }
+
+    for (;;)
+    {
+        ReleaseCompleted();
+
+        // 아무것도 안 쓰고 있으면 처음부터
+        if (mRingUsed == 0)
+            mRingHead = 0;
+
+        // 끝에 연속으로 들어갈 자리가 없으면 남은 부분을 건너뛰고 처음부터
+        UINT64 offset = (mRingHead + alignment - 1) & ~(alignment - 1);
+        UINT64 needed = 0;
+        if (offset + size > mRingSize)
+        {
+            offset = 0;
+            needed = (mRingSize - mRingHead) + size;
+        }
+        else
+        {
+            needed = (offset - mRingHead) + size;
+        }
+
+        if (mRingUsed + needed <= mRingSize)
+        {
+            mRingHead = offset + size;
+            if (mRingHead == mRingSize)
+                mRingHead = 0;
+            mRingUsed += needed;
+            mRingPendingSize += needed;
+
+            staging.Resource = mRing.Get();
+            staging.Offset = offset;
+            staging.CPU = mRingCPU + offset;
+            return staging;
+        }
+
+        // 링이 가득 참: 기록 중인 복사를 먼저 내보내고 가장 오래된 구간이 끝나길 기다린다.
+        if (mPendingCopies > 0)
+            SubmitLocked();
+
+        assert(!mRingRegions.empty());
+        WaitForFence(mRingRegions.front().Fence);
+    }
+}
+
+void UploadManager::BeginRecording()
+{
+    if (mIsRecording)
+        return;
+
+    // GPU가 다 쓴 할당자는 재사용, 없으면 새로 만든다.
+    if (mCurrentAllocator == nullptr)
+    {
+        if (!mRetiredAllocators.empty() && IsComplete(mRetiredAllocators.front().Fence))
+        {
+            mCurrentAllocator = mRetiredAllocators.front().Allocator;
+            mRetiredAllocators.pop_front();
+            ThrowIfFailed(mCurrentAllocator->Reset());
+        }
+        else
+        {
+            ThrowIfFailed(md3dDevice->CreateCommandAllocator(
+                D3D12_COMMAND_LIST_TYPE_COPY,
+                IID_PPV_ARGS(&mCurrentAllocator)));
+        }
+    }
+
+    ThrowIfFailed(mCommandList->Reset(mCurrentAllocator.Get(), nullptr));
+    mIsRecording = true;
+}
+
+UINT64 UploadManager::SubmitLocked()
+{
+    if (!mIsRecording)
+        return mTimeline.GetLastSignaled();
+
+    ThrowIfFailed(mCommandList->Close());
+    ID3D12CommandList* cmdsLists[] = { mCommandList.Get() };
+    mCopyQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+
+    const UINT64 fence = mTimeline.Signal(mCopyQueue.Get());
+
+    RetiredAllocator retiredAllocator;
+    retiredAllocator.Fence = fence;
+    retiredAllocator.Allocator = std::move(mCurrentAllocator);
+    mRetiredAllocators.push_back(std::move(retiredAllocator));
+    mCurrentAllocator = nullptr;
+
+    if (mRingPendingSize > 0)
+    {
+        RingRegion region;
+        region.Fence = fence;
+        region.Size = mRingPendingSize;
+        mRingRegions.push_back(region);
+        mRingPendingSize = 0;
+    }
+
+    for (auto& buffer : mPendingBuffers)
+    {
+        RetiredBuffer retired;
+        retired.Fence = fence;
+        retired.Resource = std::move(buffer);
+        mRetiredBuffers.push_back(std::move(retired));
+    }
+    mPendingBuffers.clear();
+
+    mIsRecording = false;
+    mPendingCopies = 0;
+
+    return fence;
+}
+
+void UploadManager::ReleaseCompleted()
+{
+    UINT64 completedFence = mTimeline.GetCompletedValue();
+
+    while (!mRingRegions.empty() && mRingRegions.front().Fence <= completedFence)
+    {
+        mRingUsed -= mRingRegions.front().Size;
+        mRingRegions.pop_front();
+    }
+
+    while (!mRetiredBuffers.empty() && mRetiredBuffers.front().Fence <= completedFence)
+        mRetiredBuffers.pop_front();
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "GpuTimeline.h"
+#include <deque>
+#include <mutex>
+
+class GpuMemoryAllocator;
+class UploadManager;
+
+// Submit()이 돌려주는 업로드 완료 표시
+// 복사 큐의 펜스 값 하나라서 값으로 복사해서 들고 다니면 된다.
+class UploadFuture
+{
+public:
+    UploadFuture() = default;
+    UploadFuture(UploadManager* manager, UINT64 fence) : mManager(manager), mFence(fence) {}
+
+    bool IsValid()const { return mManager != nullptr; }
+    UINT64 GetFence()const { return mFence; }
+
+    // GPU 복사가 끝났는지
+    bool IsReady()const;
+
+    // CPU에서 복사가 끝날 때까지 대기
+    void Wait()const;
+
+    // queue가 복사가 끝난 뒤에 실행되도록 GPU 쪽 대기를 건다. (CPU는 막히지 않음)
+    void WaitOnQueue(ID3D12CommandQueue* queue)const;
+
+private:
+    UploadManager* mManager = nullptr;
+    UINT64 mFence = 0;
+};
+
+// AllocateBufferCopies가 기록할 복사 하나 (스테이징 -> Resource의 Offset)
+struct BufferCopyRegion
+{
+    ID3D12Resource* Resource = nullptr;
+    UINT64 Offset = 0;
+    UINT64 ByteSize = 0;
+};
+
+// 스테이징 링 + 전용 복사 큐로 버퍼/텍스처 업로드를 모아서 처리
+// - 스테이징 버퍼는 하나를 계속 Map해 두고 링으로 돌려 쓴다. 각 구간은 펜스로 회수.
+// - 기록한 복사는 Submit() 때 한 번에 복사 큐로 제출되고, 결과는 UploadFuture로 받는다.
+// - 복사 큐를 거친 리소스는 COMMON 상태로 돌아오므로 (상태 decay),
+//   다른 큐에서는 버퍼/텍스처 모두 읽기 상태로 암시적 승격되어 배리어 없이 쓸 수 있다.
+class UploadManager
+{
+public:
+    UploadManager() = default;
+    UploadManager(const UploadManager& rhs) = delete;
+    UploadManager& operator=(const UploadManager& rhs) = delete;
+    ~UploadManager();
+
+    // allocator를 넘기면 스테이징 링도 서브 할당기에서 만든다.
+    void Initialize(ID3D12Device* device, UINT64 ringSize = 32 * 1024 * 1024, GpuMemoryAllocator* allocator = nullptr);
+    void Shutdown();
+
+    bool IsInitialized()const { return md3dDevice != nullptr; }
+
+    // 기본 힙 버퍼를 만들고 initData 복사를 기록한다. (반환 리소스는 COMMON 상태)
+    Microsoft::WRL::ComPtr<ID3D12Resource> CreateDefaultBuffer(
+        const void* initData,
+        UINT64 byteSize,
+        GpuMemoryAllocator* allocator = nullptr);
+
+    // dst는 COMMON 상태여야 한다.
+    void CopyBuffer(ID3D12Resource* dst, UINT64 dstOffset, const void* data, UINT64 byteSize);
+    // CopyBuffer와 같지만 원본을 받아서 복사하지 않고 스테이징 자리(data[i])를 돌려준다. 호출한 쪽이 최종 형식으로 바로 쓴다.
+    // 모든 구간을 스테이징 한 곳에 이어서 잡으므로 구간 사이에서 링이 차서 제출되는 일은 없다.
+    // 다음 Submit()이나 다음 업로드 기록 전에 다 써야 한다. (링이 차면 그때 제출된다) 쓰기 결합 메모리라 읽지 않고 쓰기만 한다.
+    void AllocateBufferCopies(const BufferCopyRegion* regions, UINT count, void** data);
+    // GPU 버퍼 -> GPU 버퍼 (둘 다 COMMON 상태, 같은 제출 안에서 src에 쓴 복사가 없어야 한다)
+    void CopyBufferRegion(ID3D12Resource* dst, UINT64 dstOffset, ID3D12Resource* src, UINT64 srcOffset, UINT64 byteSize);
+    void CopyTexture(ID3D12Resource* dst, UINT firstSubresource, UINT numSubresources, const D3D12_SUBRESOURCE_DATA* data);
+
+    // 지금까지 기록한 복사를 복사 큐로 제출 (기록한 것이 없으면 마지막 제출의 future)
+    UploadFuture Submit();
+
+    bool IsComplete(UINT64 fence);
+    void WaitForFence(UINT64 fence);
+    void WaitOnQueue(ID3D12CommandQueue* queue, UINT64 fence);
+
+    ID3D12CommandQueue* GetCopyQueue()const { return mCopyQueue.Get(); }
+
+    UINT64 GetRingSize()const { return mRingSize; }
+    UINT64 GetRingUsed();
+
+private:
+    struct Staging
+    {
+        ID3D12Resource* Resource = nullptr;
+        UINT64 Offset = 0;
+        BYTE* CPU = nullptr;
+    };
+
+    // 제출 한 번이 쓴 링 구간 (Fence가 끝나면 Size만큼 회수)
+    struct RingRegion
+    {
+        UINT64 Fence = 0;
+        UINT64 Size = 0;
+    };
+
+    struct RetiredAllocator
+    {
+        UINT64 Fence = 0;
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> Allocator;
+    };
+
+    struct RetiredBuffer
+    {
+        UINT64 Fence = 0;
+        Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+    };
+
+    // mMutex를 잡은 상태에서 호출
+    Staging AllocateStaging(UINT64 size, UINT64 alignment);
+    void BeginRecording();
+    UINT64 SubmitLocked();
+    void ReleaseCompleted();
+
+private:
+    ID3D12Device* md3dDevice = nullptr;
+    GpuMemoryAllocator* mAllocator = nullptr;
+
+    std::mutex mMutex;
+
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue> mCopyQueue;
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mCommandList;
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mCurrentAllocator;
+    std::deque<RetiredAllocator> mRetiredAllocators;
+    bool mIsRecording = false;
+    UINT mPendingCopies = 0;
+
+    GpuTimeline mTimeline;
+
+    // 스테이징 링
+    Microsoft::WRL::ComPtr<ID3D12Resource> mRing;
+    BYTE* mRingCPU = nullptr;
+    UINT64 mRingSize = 0;
+    UINT64 mRingHead = 0;               // 다음 할당 위치
+    UINT64 mRingUsed = 0;               // 제출 대기 + GPU 사용 중인 크기
+    UINT64 mRingPendingSize = 0;        // 아직 제출되지 않은 크기
+    std::deque<RingRegion> mRingRegions;
+
+    // 링보다 큰 업로드는 임시 버퍼로 처리
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> mPendingBuffers;
+    std::deque<RetiredBuffer> mRetiredBuffers;
+};
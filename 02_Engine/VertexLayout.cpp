@@ -0,0 +1,90 @@
+#include "VertexLayout.h"
+
+#include <cmath>
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+namespace
+{
+    // 납작한 축 (평면 격자의 y 등)의 반지름
+    const float MinPositionScale = 1.0e-6f;
+
+    float SignNotZero(float value)
+    {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+}
+
+void VertexQuantizer::GetPositionTransform(const BoundingBox& bounds, XMFLOAT3& scale, XMFLOAT3& offset)
+{
+    scale.x = std::max<float>(bounds.Extents.x, MinPositionScale);
+    scale.y = std::max<float>(bounds.Extents.y, MinPositionScale);
+    scale.z = std::max<float>(bounds.Extents.z, MinPositionScale);
+    offset = bounds.Center;
+}
+
+XMHALF4 VertexQuantizer::EncodePosition(const XMFLOAT3& position, const XMFLOAT3& scale, const XMFLOAT3& offset)
+{
+    return XMHALF4(
+        (position.x - offset.x) / scale.x,
+        (position.y - offset.y) / scale.y,
+        (position.z - offset.z) / scale.z,
+        1.0f);
+}
+
+XMSHORTN2 VertexQuantizer::EncodeOctahedral(const XMFLOAT3& direction)
+{
+    // 팔면체 |x| + |y| + |z| = 1에 투영하고, 아래쪽 반은 위쪽 바깥 삼각형으로 접는다.
+    const float length = std::fabs(direction.x) + std::fabs(direction.y) + std::fabs(direction.z);
+    if (length == 0.0f)
+        return XMSHORTN2(0.0f, 0.0f);
+
+    float x = direction.x / length;
+    float y = direction.y / length;
+    if (direction.z < 0.0f)
+    {
+        const float foldedX = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float foldedY = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+    return XMSHORTN2(x, y);
+}
+
+XMFLOAT3 VertexQuantizer::DecodeOctahedral(const XMSHORTN2& encoded)
+{
+    XMFLOAT2 xy;
+    XMStoreFloat2(&xy, XMLoadShortN2(&encoded));
+
+    XMFLOAT3 direction(xy.x, xy.y, 1.0f - std::fabs(xy.x) - std::fabs(xy.y));
+    if (direction.z < 0.0f)
+    {
+        direction.x = (1.0f - std::fabs(xy.y)) * SignNotZero(xy.x);
+        direction.y = (1.0f - std::fabs(xy.x)) * SignNotZero(xy.y);
+    }
+
+    XMFLOAT3 result;
+    XMStoreFloat3(&result, XMVector3Normalize(XMLoadFloat3(&direction)));
+    return result;
+}
+
+XMUBYTEN4 VertexQuantizer::EncodeColor(const XMFLOAT4& color)
+{
+    return XMUBYTEN4(color.x, color.y, color.z, color.w);
+}
+
+XMHALF2 VertexQuantizer::EncodeTexCoord(const XMFLOAT2& texC)
+{
+    return XMHALF2(texC.x, texC.y);
+}
+
+QuantizedVertex VertexQuantizer::Encode(const GeometryGenerator::Vertex& vertex, const XMFLOAT3& scale, const XMFLOAT3& offset)
+{
+    QuantizedVertex result;
+    result.Position = EncodePosition(vertex.Position, scale, offset);
+    result.Normal = EncodeOctahedral(vertex.Normal);
+    result.TangentU = EncodeOctahedral(vertex.TangentU);
+    result.TexC = EncodeTexCoord(vertex.TexC);
+    return result;
+}
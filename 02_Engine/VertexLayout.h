@@ -0,0 +1,190 @@
+#pragma once
+
+#include "d3dUtil.h"
+#include "GeometryGenerator.h"
+
+// 정점 구조체 설명 -> D3D12_INPUT_ELEMENT_DESC (컴파일 타임)
+// 멤버 순서대로 속성을 나열하면 형식(DXGI_FORMAT)과 오프셋을 타입에서 만든다.
+//
+//   struct Vertex { XMHALF4 Pos; XMUBYTEN4 Color; };
+//   using Layout = VertexLayout<Vertex,
+//       VertexAttribute<VertexSemantic::Position, XMHALF4>,
+//       VertexAttribute<VertexSemantic::Color, XMUBYTEN4>>;
+//   psoDesc.InputLayout = Layout::GetDesc();
+//
+// 속성 크기의 합이 sizeof(Vertex)와 다르면 (멤버를 빠뜨렸거나 패딩이 있으면) 컴파일 오류
+//
+// 정점 스트림을 나눌 때는 스트림마다 구조체와 VertexLayout을 만들고 VertexStreamLayout으로 묶는다.
+// 입력 슬롯은 나열한 순서대로 0, 1, ...이고, GetDesc(1)은 스트림 0만 쓰는 레이아웃이다. (깊이 전용 패스)
+
+// C++ 타입 -> DXGI_FORMAT (지원하지 않는 타입은 정의가 없어서 컴파일 오류)
+template<typename T>
+struct VertexFormatOf;
+
+#define VERTEX_FORMAT_OF(Type, Format) \
+    template<> struct VertexFormatOf<Type> { static constexpr DXGI_FORMAT Value = Format; }
+
+VERTEX_FORMAT_OF(float, DXGI_FORMAT_R32_FLOAT);
+VERTEX_FORMAT_OF(DirectX::XMFLOAT2, DXGI_FORMAT_R32G32_FLOAT);
+VERTEX_FORMAT_OF(DirectX::XMFLOAT3, DXGI_FORMAT_R32G32B32_FLOAT);
+VERTEX_FORMAT_OF(DirectX::XMFLOAT4, DXGI_FORMAT_R32G32B32A32_FLOAT);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMHALF2, DXGI_FORMAT_R16G16_FLOAT);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMHALF4, DXGI_FORMAT_R16G16B16A16_FLOAT);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMSHORTN2, DXGI_FORMAT_R16G16_SNORM);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMSHORTN4, DXGI_FORMAT_R16G16B16A16_SNORM);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMUSHORTN2, DXGI_FORMAT_R16G16_UNORM);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMUSHORTN4, DXGI_FORMAT_R16G16B16A16_UNORM);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMBYTEN4, DXGI_FORMAT_R8G8B8A8_SNORM);
+VERTEX_FORMAT_OF(DirectX::PackedVector::XMUBYTEN4, DXGI_FORMAT_R8G8B8A8_UNORM);
+
+#undef VERTEX_FORMAT_OF
+
+// 셰이더 입력 시맨틱 이름
+namespace VertexSemantic
+{
+    struct Position { static constexpr const char* Name = "POSITION"; };
+    struct Normal   { static constexpr const char* Name = "NORMAL"; };
+    struct Tangent  { static constexpr const char* Name = "TANGENT"; };
+    struct Color    { static constexpr const char* Name = "COLOR"; };
+    struct TexCoord { static constexpr const char* Name = "TEXCOORD"; };
+}
+
+template<typename TSemantic, typename TType, UINT TSemanticIndex = 0>
+struct VertexAttribute
+{
+    using Semantic = TSemantic;
+    using Type = TType;
+    static constexpr UINT SemanticIndex = TSemanticIndex;
+    static constexpr DXGI_FORMAT Format = VertexFormatOf<TType>::Value;
+
+    // 입력 어셈블러는 4바이트 정렬된 오프셋만 받는다.
+    static_assert(sizeof(TType) % 4 == 0, "vertex attribute size must be a multiple of 4 bytes");
+};
+
+namespace VertexLayoutDetail
+{
+    // 속성 순서대로 오프셋을 쌓는다.
+    template<typename... TAttributes>
+    constexpr std::array<D3D12_INPUT_ELEMENT_DESC, sizeof...(TAttributes)> MakeElements()
+    {
+        std::array<D3D12_INPUT_ELEMENT_DESC, sizeof...(TAttributes)> elements = { {
+            { TAttributes::Semantic::Name, TAttributes::SemanticIndex, TAttributes::Format, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }...
+        } };
+
+        constexpr UINT sizes[] = { (UINT)sizeof(typename TAttributes::Type)... };
+        UINT offset = 0;
+        for (std::size_t i = 0; i < sizeof...(TAttributes); ++i)
+        {
+            elements[i].AlignedByteOffset = offset;
+            offset += sizes[i];
+        }
+        return elements;
+    }
+
+    // 스트림 레이아웃의 원소를 이어 붙이면서 입력 슬롯을 매긴다.
+    template<std::size_t TCount, std::size_t TStreamCount>
+    constexpr void AppendStream(
+        std::array<D3D12_INPUT_ELEMENT_DESC, TCount>& elements,
+        std::size_t& count,
+        UINT slot,
+        const std::array<D3D12_INPUT_ELEMENT_DESC, TStreamCount>& stream)
+    {
+        for (std::size_t i = 0; i < TStreamCount; ++i)
+        {
+            elements[count] = stream[i];
+            elements[count].InputSlot = slot;
+            ++count;
+        }
+    }
+
+    template<typename... TStreams>
+    constexpr std::array<D3D12_INPUT_ELEMENT_DESC, (0 + ... + TStreams::ElementCount)> MakeStreamElements()
+    {
+        std::array<D3D12_INPUT_ELEMENT_DESC, (0 + ... + TStreams::ElementCount)> elements = {};
+        std::size_t count = 0;
+        UINT slot = 0;
+        (AppendStream(elements, count, slot++, TStreams::Elements), ...);
+        return elements;
+    }
+}
+
+template<typename TVertex, typename... TAttributes>
+class VertexLayout
+{
+public:
+    static constexpr UINT ElementCount = sizeof...(TAttributes);
+    static constexpr UINT Stride = (0 + ... + (UINT)sizeof(typename TAttributes::Type));
+
+    static_assert(ElementCount > 0, "vertex layout needs at least one attribute");
+    static_assert(Stride == sizeof(TVertex), "vertex attributes do not cover the vertex struct");
+
+    static constexpr std::array<D3D12_INPUT_ELEMENT_DESC, ElementCount> Elements = VertexLayoutDetail::MakeElements<TAttributes...>();
+
+    static D3D12_INPUT_LAYOUT_DESC GetDesc() { return { Elements.data(), ElementCount }; }
+};
+
+// 여러 정점 스트림 (TStreams는 VertexLayout)
+template<typename... TStreams>
+class VertexStreamLayout
+{
+public:
+    static constexpr UINT StreamCount = sizeof...(TStreams);
+    static constexpr UINT ElementCount = (0 + ... + TStreams::ElementCount);
+
+    static constexpr std::array<UINT, StreamCount> Strides = { { TStreams::Stride... } };
+    static constexpr std::array<D3D12_INPUT_ELEMENT_DESC, ElementCount> Elements = VertexLayoutDetail::MakeStreamElements<TStreams...>();
+
+    // 앞 streamCount개 스트림만 쓰는 레이아웃 (원소가 스트림 순서라 앞부분만 넘기면 된다)
+    static D3D12_INPUT_LAYOUT_DESC GetDesc(UINT streamCount = StreamCount)
+    {
+        constexpr UINT elementCounts[] = { TStreams::ElementCount... };
+        UINT count = 0;
+        for (UINT i = 0; i < streamCount && i < StreamCount; ++i)
+            count += elementCounts[i];
+        return { Elements.data(), count };
+    }
+
+    // 한 정점에 쓰는 바이트 (앞 streamCount개 스트림)
+    static UINT GetStride(UINT streamCount = StreamCount)
+    {
+        UINT stride = 0;
+        for (UINT i = 0; i < streamCount && i < StreamCount; ++i)
+            stride += Strides[i];
+        return stride;
+    }
+};
+
+// GeometryGenerator::Vertex(44바이트)를 양자화한 정점 (20바이트)
+struct QuantizedVertex
+{
+    DirectX::PackedVector::XMHALF4 Position;    // 경계 상자 기준 [-1, 1] (w = 1)
+    DirectX::PackedVector::XMSHORTN2 Normal;    // 팔면체 인코딩
+    DirectX::PackedVector::XMSHORTN2 TangentU;  // 팔면체 인코딩
+    DirectX::PackedVector::XMHALF2 TexC;
+
+    using Layout = VertexLayout<QuantizedVertex,
+        VertexAttribute<VertexSemantic::Position, DirectX::PackedVector::XMHALF4>,
+        VertexAttribute<VertexSemantic::Normal, DirectX::PackedVector::XMSHORTN2>,
+        VertexAttribute<VertexSemantic::Tangent, DirectX::PackedVector::XMSHORTN2>,
+        VertexAttribute<VertexSemantic::TexCoord, DirectX::PackedVector::XMHALF2>>;
+};
+
+// 속성 양자화. 셰이더 쪽 복원은 Shaders/Quantization.hlsli
+// 위치는 경계 상자 기준으로 [-1, 1]에 맞춰 half로 저장하고, 그릴 때 PosL = q * scale + offset으로 되돌린다.
+class VertexQuantizer
+{
+public:
+    // 위치 복원 변환 (scale = 상자 반지름, offset = 상자 중심). 납작한 축은 0으로 나누지 않도록 작은 값을 쓴다.
+    static void GetPositionTransform(const DirectX::BoundingBox& bounds, DirectX::XMFLOAT3& scale, DirectX::XMFLOAT3& offset);
+
+    static DirectX::PackedVector::XMHALF4 EncodePosition(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& scale, const DirectX::XMFLOAT3& offset);
+
+    // 단위 벡터 -> 팔면체 좌표 [-1, 1]^2 (snorm16이면 오차가 0.01도 미만)
+    static DirectX::PackedVector::XMSHORTN2 EncodeOctahedral(const DirectX::XMFLOAT3& direction);
+    static DirectX::XMFLOAT3 DecodeOctahedral(const DirectX::PackedVector::XMSHORTN2& encoded);
+
+    static DirectX::PackedVector::XMUBYTEN4 EncodeColor(const DirectX::XMFLOAT4& color);
+    static DirectX::PackedVector::XMHALF2 EncodeTexCoord(const DirectX::XMFLOAT2& texC);
+
+    static QuantizedVertex Encode(const GeometryGenerator::Vertex& vertex, const DirectX::XMFLOAT3& scale, const DirectX::XMFLOAT3& offset);
+};
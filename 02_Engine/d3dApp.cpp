@@ -33,6 +33,8 @@ D3DApp::D3DApp(HINSTANCE hInstance)
 
 D3DApp::~D3DApp()
 {
+	StopRenderThread();
+
 	if (md3dDevice != nullptr)
 		FlushCommandQueue();
 }
@@ -61,6 +63,9 @@ void D3DApp::Set4xMsaaState(bool value)
 {
 	if (m4xMsaaState != value)
 	{
+		// 렌더 스레드가 스왑체인을 쓰고 있지 않을 때까지 대기
+		WaitForRenderThreadIdle();
+
 		m4xMsaaState = value;
 
 		// Recreate the swapchain and buffers with new multisample settings.
@@ -69,12 +74,30 @@ void D3DApp::Set4xMsaaState(bool value)
 	}
 }
 
+bool D3DApp::GetRenderThreadState()const
+{
+	return mRenderThreadState;
+}
+
+void D3DApp::SetRenderThreadState(bool value)
+{
+	// 실행 중에는 변경하지 않는다.
+	if (mRenderThread.joinable())
+		return;
+
+	mRenderThreadState = value;
+}
+
 int D3DApp::Run()
 {
 	MSG msg = { 0 };
 
 	mTimer.Reset();
 
+	// 렌더 스레드 사용 시 Draw는 렌더 스레드에서 호출된다.
+	if (mRenderThreadState)
+		StartRenderThread();
+
 	while (msg.message != WM_QUIT)
 	{
 		// If there are Window messages then process them.
@@ -92,18 +115,75 @@ int D3DApp::Run()
 			{
 				//CalculateFrameStats();
 				Update(mTimer);
-				Draw(mTimer);
+
+				if (!mRenderThreadState)
+					Draw(mTimer);
 			}
 			else
 			{
 				Sleep(100);
 			}
+
+			// 렌더 스레드에서 예외가 발생했으면 메인 스레드에서 다시 던진다.
+			if (mRenderThreadState && mFramePipeline.IsShutdown() && mRenderThreadException)
+			{
+				StopRenderThread();
+				std::rethrow_exception(mRenderThreadException);
+			}
 		}
 	}
 
+	StopRenderThread();
+
 	return (int)msg.wParam;
 }
 
+void D3DApp::StartRenderThread()
+{
+	if (mRenderThread.joinable())
+		return;
+
+	mRenderThreadException = nullptr;
+	mRenderThread = std::thread(&D3DApp::RenderThreadMain, this);
+}
+
+void D3DApp::StopRenderThread()
+{
+	if (!mRenderThread.joinable())
+		return;
+
+	// 렌더 스레드가 받은 프레임을 모두 제출할 때까지 기다린 후 종료
+	WaitForRenderThreadIdle();
+	mFramePipeline.Shutdown();
+	mRenderThread.join();
+}
+
+void D3DApp::RenderThreadMain()
+{
+	try
+	{
+		mRenderTimer.Reset();
+
+		// 게임 스레드가 프레임 스냅샷을 넘겨줄 때마다 기록/제출
+		while (mFramePipeline.WaitForFrame())
+		{
+			mRenderTimer.Tick();
+			Draw(mRenderTimer);
+		}
+	}
+	catch (...)
+	{
+		mRenderThreadException = std::current_exception();
+		mFramePipeline.Shutdown();
+	}
+}
+
+void D3DApp::WaitForRenderThreadIdle()
+{
+	if (mRenderThread.joinable())
+		mFramePipeline.WaitIdle();
+}
+
 bool D3DApp::Initialize()
 {
 	if (!InitMainWindow())
@@ -112,6 +192,9 @@ bool D3DApp::Initialize()
 	if (!InitDirect3D())
 		return false;
 
+	// FrameResource 수만큼 프레임 스냅샷 슬롯 준비
+	mFramePipeline.Initialize(gNumFrameResources);
+
 	// Do the initial resize code.
 	OnResize();
 
@@ -144,15 +227,25 @@ void D3DApp::OnResize()
 	assert(mSwapChain);
 	assert(mDirectCmdListAlloc);
 
-	// Flush before changing any resources.
-	FlushCommandQueue();
+	// 렌더 스레드가 넘겨받은 프레임을 모두 제출할 때까지 대기
+	WaitForRenderThreadIdle();
+
+	// 스왑 체인 버퍼는 진행 중인 프레임이 참조하지 않아야 ResizeBuffers를 할 수 있으므로
+	// 백버퍼에 그린 프레임만 기다린다. (업로드/리사이즈 등 다른 작업과 큐 전체는 기다리지 않는다)
+	for (int i = 0; i < SwapChainBufferCount; ++i)
+		mTimeline.Wait(mBackBufferFences[i]);
 
 	ThrowIfFailed(mCommandList->Reset(mDirectCmdListAlloc.Get(), nullptr));
 
 	// Release the previous resources we will be recreating.
 	for (int i = 0; i < SwapChainBufferCount; ++i)
+	{
 		mSwapChainBuffer[i].Reset();
-	mDepthStencilBuffer.Reset();
+		mBackBufferFences[i] = 0;
+	}
+
+	// 깊이 버퍼는 제출한 프레임이 아직 쓰고 있을 수 있으므로 그 프레임들이 끝난 뒤 해제한다.
+	mDeferredRelease.Enqueue(mTimeline.GetLastSignaled(), mDepthStencilBuffer);
 
 	// Resize the swap chain.
 	ThrowIfFailed(mSwapChain->ResizeBuffers(
@@ -227,8 +320,8 @@ void D3DApp::OnResize()
 	ID3D12CommandList* cmdsLists[] = { mCommandList.Get() };
 	mCommandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
 
-	// Wait until resize is complete.
-	FlushCommandQueue();
+	// 다음 프레임이 같은 큐에서 실행되므로 완료를 기다릴 필요가 없다.
+	mTimeline.Signal(mCommandQueue.Get());
 
 	// Update the viewport transform to cover the client area.
 	mScreenViewport.TopLeftX = 0;
@@ -453,8 +546,13 @@ if (FAILED(hardwareResult))
 		IID_PPV_ARGS(&md3dDevice)));
 }
 
-ThrowIfFailed(md3dDevice->CreateFence(0, D3D12_FENCE_FLAG_NONE,
-	IID_PPV_ARGS(&mFence)));
+mTimeline.Initialize(md3dDevice.Get());
+
+mGpuAllocator.Initialize(md3dDevice.Get());
+mUploadManager.Initialize(md3dDevice.Get(), 32 * 1024 * 1024, &mGpuAllocator);
+mJobSystem.Initialize();
+mShaderCache.Open("ShaderCache.bin", &mShaderCompiler);
+mPipelineCache.Initialize(md3dDevice.Get(), "PipelineCache.bin", &mJobSystem, &mDeferredRelease);
 
 mRtvDescriptorSize = md3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 mDsvDescriptorSize = md3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
@@ -543,26 +641,9 @@ void D3DApp::CreateSwapChain()
 
 void D3DApp::FlushCommandQueue()
 {
-	// Advance the fence value to mark commands up to this fence point.
-	mCurrentFence++;
-
-	// Add an instruction to the command queue to set a new fence point.  Because we 
-	// are on the GPU timeline, the new fence point won't be set until the GPU finishes
-	// processing all the commands prior to this Signal().
-	ThrowIfFailed(mCommandQueue->Signal(mFence.Get(), mCurrentFence));
-
-	// Wait until the GPU has completed commands up to this fence point.
-	if (mFence->GetCompletedValue() < mCurrentFence)
-	{
-		HANDLE eventHandle = CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS);
-
-		// Fire event when GPU hits current fence.  
-		ThrowIfFailed(mFence->SetEventOnCompletion(mCurrentFence, eventHandle));
-
-		// Wait until the GPU hits current fence event is fired.
-		WaitForSingleObject(eventHandle, INFINITE);
-		CloseHandle(eventHandle);
-	}
+	// 종료/초기화처럼 GPU를 완전히 비워야 할 때만 사용
+	mTimeline.WaitIdle(mCommandQueue.Get());
+	mDeferredRelease.ReleaseCompleted(mTimeline.GetCompletedValue());
 }
 
 ID3D12Resource* D3DApp::CurrentBackBuffer()const
@@ -10,7 +10,17 @@
 #endif
 
 #include "d3dUtil.h"
+#include "FramePipeline.h"
+#include "GpuMemoryAllocator.h"
+#include "UploadManager.h"
+#include "GpuTimeline.h"
+#include "DeferredReleaseQueue.h"
+#include "ShaderCompiler.h"
+#include "PipelineStateCache.h"
 #include "../01_Core/GameTimer.h"
+#include "../01_Core/JobSystem.h"
+#include <thread>
+#include <exception>
 
 // Link necessary d3d12 libraries.
 #pragma comment(lib,"d3dcompiler.lib")
@@ -38,6 +48,10 @@ public:
     bool Get4xMsaaState()const;
     void Set4xMsaaState(bool value);
 
+    // 게임 스레드/렌더 스레드 분리 여부 (Run 호출 전에 설정)
+    bool GetRenderThreadState()const;
+    void SetRenderThreadState(bool value);
+
     int Run();
 
     virtual bool Initialize();
@@ -62,6 +76,12 @@ protected:
 
     void FlushCommandQueue();
 
+    // 렌더 스레드 관리
+    void StartRenderThread();
+    void StopRenderThread();
+    void RenderThreadMain();
+    void WaitForRenderThreadIdle();
+
     ID3D12Resource* CurrentBackBuffer()const;
     D3D12_CPU_DESCRIPTOR_HANDLE CurrentBackBufferView()const;
     D3D12_CPU_DESCRIPTOR_HANDLE DepthStencilView()const;
@@ -91,12 +111,26 @@ protected:
     // Used to keep track of the �delta-time?and game time (?.4).
     GameTimer mTimer;
 
+    // 렌더 스레드 관련 변수
+    bool mRenderThreadState = false;            // 렌더 스레드 사용 여부
+    FramePipeline mFramePipeline;               // 게임 스레드 -> 렌더 스레드 스냅샷 교환
+    std::thread mRenderThread;                  // 렌더 스레드
+    GameTimer mRenderTimer;                     // 렌더 스레드 전용 타이머
+    std::exception_ptr mRenderThreadException;  // 렌더 스레드에서 발생한 예외
+
     Microsoft::WRL::ComPtr<IDXGIFactory4> mdxgiFactory;
     Microsoft::WRL::ComPtr<IDXGISwapChain> mSwapChain;
     Microsoft::WRL::ComPtr<ID3D12Device> md3dDevice;
+    GpuMemoryAllocator mGpuAllocator;          // Placed Resource 서브 할당기
+    UploadManager mUploadManager;              // 스테이징 링 + 복사 큐 업로드
+
+    GpuTimeline mTimeline;                     // 직접 큐 펜스
+    DeferredReleaseQueue mDeferredRelease;     // 펜스가 지나면 해제할 리소스
 
-    Microsoft::WRL::ComPtr<ID3D12Fence> mFence;
-    UINT64 mCurrentFence = 0;
+    JobSystem mJobSystem;                      // 작업자 스레드 풀 (셰이더 변형 컴파일 등)
+    D3DShaderCompiler mShaderCompiler;
+    ShaderCache mShaderCache;                  // 디스크 셰이더 바이트코드 캐시
+    PipelineStateCache mPipelineCache;         // PSO 중복 제거 + 파이프라인 라이브러리
 
     Microsoft::WRL::ComPtr<ID3D12CommandQueue> mCommandQueue;
     Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mDirectCmdListAlloc;
@@ -105,6 +139,7 @@ protected:
     static const int SwapChainBufferCount = 2;
     int mCurrBackBuffer = 0;
     Microsoft::WRL::ComPtr<ID3D12Resource> mSwapChainBuffer[SwapChainBufferCount];
+    UINT64 mBackBufferFences[SwapChainBufferCount] = {};   // 백버퍼에 마지막으로 그린 프레임의 펜스 (ResizeBuffers 전 대기)
     Microsoft::WRL::ComPtr<ID3D12Resource> mDepthStencilBuffer;
 
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mRtvHeap;
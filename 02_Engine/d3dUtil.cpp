@@ -1,5 +1,8 @@
 
 #include "d3dUtil.h"
+#include "ResourceStateTracker.h"
+#include "GpuMemoryAllocator.h"
+#include "../01_Core/ShaderCache.h"
 #include <comdef.h>
 #include <fstream>
 
@@ -40,51 +43,62 @@ Microsoft::WRL::ComPtr<ID3D12Resource> d3dUtil::CreateDefaultBuffer(
     ID3D12GraphicsCommandList* cmdList,
     const void* initData,
     UINT64 byteSize,
-    Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer)
+    Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
+    ResourceStateTracker* stateTracker,
+    GpuMemoryAllocator* allocator)
 {
     ComPtr<ID3D12Resource> defaultBuffer;
 
-    CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
-    CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
-    ThrowIfFailed(device->CreateCommittedResource(
-        &heapProps,
-        D3D12_HEAP_FLAG_NONE,
-        &bufferDesc,
-		D3D12_RESOURCE_STATE_COMMON,
-        nullptr,
-        IID_PPV_ARGS(defaultBuffer.GetAddressOf())));
-
-    CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
-    CD3DX12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
-    ThrowIfFailed(device->CreateCommittedResource(
-        &uploadHeap,
-		D3D12_HEAP_FLAG_NONE,
-        &uploadDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
-
+    if (allocator != nullptr)
+    {
+        defaultBuffer = allocator->CreateBuffer(D3D12_HEAP_TYPE_DEFAULT, byteSize, D3D12_RESOURCE_STATE_COMMON);
+        uploadBuffer = allocator->CreateBuffer(D3D12_HEAP_TYPE_UPLOAD, byteSize, D3D12_RESOURCE_STATE_GENERIC_READ);
+    }
+    else
+    {
+        CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+        ThrowIfFailed(device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_COMMON,
+            nullptr,
+            IID_PPV_ARGS(defaultBuffer.GetAddressOf())));
+
+        CD3DX12_HEAP_PROPERTIES uploadHeap(D3D12_HEAP_TYPE_UPLOAD);
+        CD3DX12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+        ThrowIfFailed(device->CreateCommittedResource(
+            &uploadHeap,
+            D3D12_HEAP_FLAG_NONE,
+            &uploadDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
+    }
 
     D3D12_SUBRESOURCE_DATA subResourceData = {};
     subResourceData.pData = initData;
     subResourceData.RowPitch = byteSize;
     subResourceData.SlicePitch = subResourceData.RowPitch;
 
-    CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-        defaultBuffer.Get(),
-        D3D12_RESOURCE_STATE_COMMON,
-        D3D12_RESOURCE_STATE_COPY_DEST
-    );
-	cmdList->ResourceBarrier(1, &barrier);
-
+    // 버퍼는 COMMON -> COPY_DEST로 암시적 승격되므로 복사 전 배리어가 필요 없다.
     UpdateSubresources<1>(cmdList, defaultBuffer.Get(), uploadBuffer.Get(), 0, 0, 1, &subResourceData);
 
-    barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-        defaultBuffer.Get(),
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        D3D12_RESOURCE_STATE_GENERIC_READ
-    );
-	cmdList->ResourceBarrier(1, &barrier);
+    if (stateTracker != nullptr)
+    {
+        stateTracker->SetState(defaultBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST);
+        stateTracker->Transition(defaultBuffer.Get(), D3D12_RESOURCE_STATE_GENERIC_READ);
+    }
+    else
+    {
+        CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+            defaultBuffer.Get(),
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            D3D12_RESOURCE_STATE_GENERIC_READ
+        );
+        cmdList->ResourceBarrier(1, &barrier);
+    }
 
     return defaultBuffer;
 }
@@ -95,10 +109,7 @@ ComPtr<ID3DBlob> d3dUtil::CompileShader(
 	const std::string& entrypoint,
 	const std::string& target)
 {
-	UINT compileFlags = 0;
-#if defined(DEBUG) || defined(_DEBUG)  
-	compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
+	UINT compileFlags = GetShaderCompileFlags();
 
 	HRESULT hr = S_OK;
 
@@ -115,6 +126,61 @@ ComPtr<ID3DBlob> d3dUtil::CompileShader(
 	return byteCode;
 }
 
+ComPtr<ID3DBlob> d3dUtil::CompileShader(
+	ShaderCache& cache,
+	const std::wstring& filename,
+	const D3D_SHADER_MACRO* defines,
+	const std::string& entrypoint,
+	const std::string& target)
+{
+	ShaderCompileDesc desc;
+	desc.SourcePath = WStringToAnsi(filename);
+	desc.EntryPoint = entrypoint;
+	desc.Target = target;
+	desc.Flags = GetShaderCompileFlags();
+	for (const D3D_SHADER_MACRO* define = defines; define != nullptr && define->Name != nullptr; ++define)
+		desc.Defines.emplace_back(define->Name, define->Definition != nullptr ? define->Definition : "");
+
+	ShaderBytecode bytecode;
+	std::string errors;
+	const bool isCompiled = cache.GetOrCompile(desc, bytecode, &errors);
+
+	if (!errors.empty())
+		OutputDebugStringA(errors.c_str());
+
+	if (!isCompiled)
+		ThrowIfFailed(E_FAIL);
+
+	// 캐시의 바이트코드는 다음 Save까지만 유효하므로 블롭으로 복사해 둔다.
+	return CreateBlob(bytecode.Data, bytecode.Size);
+}
+
+ComPtr<ID3DBlob> d3dUtil::CreateBlob(const void* data, size_t size)
+{
+	ComPtr<ID3DBlob> blob;
+	ThrowIfFailed(D3DCreateBlob(size, &blob));
+	CopyMemory(blob->GetBufferPointer(), data, size);
+
+	return blob;
+}
+
+UINT d3dUtil::GetShaderCompileFlags()
+{
+	UINT compileFlags = 0;
+#if defined(DEBUG) || defined(_DEBUG)  
+	compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+	return compileFlags;
+}
+
+std::string d3dUtil::WStringToAnsi(const std::wstring& str)
+{
+	int size = WideCharToMultiByte(CP_ACP, 0, str.c_str(), (int)str.size(), nullptr, 0, nullptr, nullptr);
+	std::string result(size, '\0');
+	WideCharToMultiByte(CP_ACP, 0, str.c_str(), (int)str.size(), &result[0], size, nullptr, nullptr);
+	return result;
+}
+
 std::wstring DxException::ToString()const
 {
     // Get the string description of the error code.
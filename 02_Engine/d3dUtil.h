@@ -30,6 +30,10 @@
 
 extern const int gNumFrameResources;
 
+class ResourceStateTracker;
+class GpuMemoryAllocator;
+class ShaderCache;
+
 inline void d3dSetDebugName(IDXGIObject* obj, const char* name)
 {
     if(obj)
@@ -113,18 +117,37 @@ public:
 
     static Microsoft::WRL::ComPtr<ID3DBlob> LoadBinary(const std::wstring& filename);
 
+    // stateTracker를 넘기면 GENERIC_READ 전환을 추적기에 쌓아두고 (호출한 쪽에서 Flush),
+    // 아니면 바로 제출한다.
+    // allocator를 넘기면 두 버퍼 모두 힙 블록 안의 Placed Resource로 만든다.
     static Microsoft::WRL::ComPtr<ID3D12Resource> CreateDefaultBuffer(
         ID3D12Device* device,
         ID3D12GraphicsCommandList* cmdList,
         const void* initData,
         UINT64 byteSize,
-        Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer);
+        Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer,
+        ResourceStateTracker* stateTracker = nullptr,
+        GpuMemoryAllocator* allocator = nullptr);
+
+	static Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(
+		const std::wstring& filename,
+		const D3D_SHADER_MACRO* defines,
+		const std::string& entrypoint,
+		const std::string& target);
 
+	// 셰이더 캐시를 거쳐서 컴파일 (원본/include가 그대로면 캐시 파일의 바이트코드를 쓴다)
 	static Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(
+		ShaderCache& cache,
 		const std::wstring& filename,
 		const D3D_SHADER_MACRO* defines,
 		const std::string& entrypoint,
 		const std::string& target);
+
+	// 메모리의 바이트코드를 블롭으로 복사
+	static Microsoft::WRL::ComPtr<ID3DBlob> CreateBlob(const void* data, size_t size);
+
+	static UINT GetShaderCompileFlags();
+	static std::string WStringToAnsi(const std::wstring& str);
 };
 
 class DxException
@@ -145,15 +168,38 @@ public:
 // geometries are stored in one vertex and index buffer.  It provides the offsets
 // and data needed to draw a subset of geometry stores in the vertex and index 
 // buffers so that we can implement the technique described by Figure 6.3.
-struct SubmeshGeometry
+// 서브메시의 거친 LOD (같은 정점을 쓰는 다른 인덱스 구간)
+struct SubmeshLod
 {
 	UINT IndexCount = 0;
 	UINT StartIndexLocation = 0;
+	float ScreenSize = 0.0f;	// 화면 높이 대비 크기가 이보다 작으면 이 LOD를 쓴다.
+};
+
+struct SubmeshGeometry
+{
+	UINT IndexCount = 0;
+	UINT StartIndexLocation = 0;	// IndexFormat 크기 단위 (한 버퍼에 16/32비트 구간이 섞일 수 있다)
 	INT BaseVertexLocation = 0;
 
+	// UNKNOWN이면 MeshGeometry::IndexFormat (LOD도 같은 형식)
+	DXGI_FORMAT IndexFormat = DXGI_FORMAT_UNKNOWN;
+
     // Bounding box of the geometry defined by this submesh. 
     // This is used in later chapters of the book.
 	DirectX::BoundingBox Bounds;
+
+	// LOD 0은 위의 IndexCount/StartIndexLocation, 여기는 LOD 1부터
+	std::vector<SubmeshLod> Lods;
+};
+
+// 정점 스트림 하나. 스트림 0은 위치만, 1부터 나머지 속성이라 깊이 전용 패스는 스트림 0만 바인딩한다.
+struct VertexStream
+{
+	Microsoft::WRL::ComPtr<ID3DBlob> BufferCPU = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12Resource> BufferGPU = nullptr;
+	UINT ByteStride = 0;
+	UINT ByteSize = 0;
 };
 
 struct MeshGeometry
@@ -163,52 +209,58 @@ struct MeshGeometry
 
 	// System memory copies.  Use Blobs because the vertex/index format can be generic.
 	// It is up to the client to cast appropriately.  
-	Microsoft::WRL::ComPtr<ID3DBlob> VertexBufferCPU = nullptr;
 	Microsoft::WRL::ComPtr<ID3DBlob> IndexBufferCPU  = nullptr;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> VertexBufferGPU = nullptr;
 	Microsoft::WRL::ComPtr<ID3D12Resource> IndexBufferGPU = nullptr;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> VertexBufferUploader = nullptr;
-	Microsoft::WRL::ComPtr<ID3D12Resource> IndexBufferUploader = nullptr;
+	// 입력 슬롯 순서대로 (MaxVertexStreams 이하)
+	static const UINT MaxVertexStreams = 4;
+	std::vector<VertexStream> VertexStreams;
 
     // Data about the buffers.
-	UINT VertexByteStride = 0;
-	UINT VertexBufferByteSize = 0;
 	DXGI_FORMAT IndexFormat = DXGI_FORMAT_R16_UINT;
 	UINT IndexBufferByteSize = 0;
 
+	// 양자화된 위치 복원 : PosL = q * PositionScale + PositionOffset (양자화하지 않았으면 1, 0)
+	DirectX::XMFLOAT3 PositionScale = { 1.0f, 1.0f, 1.0f };
+	DirectX::XMFLOAT3 PositionOffset = { 0.0f, 0.0f, 0.0f };
+
 	// A MeshGeometry may store multiple geometries in one vertex/index buffer.
 	// Use this container to define the Submesh geometries so we can draw
 	// the Submeshes individually.
 	std::unordered_map<std::string, SubmeshGeometry> DrawArgs;
 
-	D3D12_VERTEX_BUFFER_VIEW VertexBufferView()const
+	UINT GetVertexStreamCount()const { return (UINT)VertexStreams.size(); }
+
+	D3D12_VERTEX_BUFFER_VIEW VertexBufferView(UINT stream = 0)const
 	{
 		D3D12_VERTEX_BUFFER_VIEW vbv;
-		vbv.BufferLocation = VertexBufferGPU->GetGPUVirtualAddress();
-		vbv.StrideInBytes = VertexByteStride;
-		vbv.SizeInBytes = VertexBufferByteSize;
+		vbv.BufferLocation = VertexStreams[stream].BufferGPU->GetGPUVirtualAddress();
+		vbv.StrideInBytes = VertexStreams[stream].ByteStride;
+		vbv.SizeInBytes = VertexStreams[stream].ByteSize;
 
 		return vbv;
 	}
 
-	D3D12_INDEX_BUFFER_VIEW IndexBufferView()const
+	// 앞 streamCount개 스트림의 뷰 (IASetVertexBuffers(0, streamCount, views)에 그대로 넘긴다)
+	UINT VertexBufferViews(D3D12_VERTEX_BUFFER_VIEW* views, UINT streamCount)const
+	{
+		streamCount = std::min<UINT>(streamCount, GetVertexStreamCount());
+		for (UINT i = 0; i < streamCount; ++i)
+			views[i] = VertexBufferView(i);
+		return streamCount;
+	}
+
+	// format은 서브메시의 IndexFormat (UNKNOWN이면 IndexFormat)
+	D3D12_INDEX_BUFFER_VIEW IndexBufferView(DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN)const
 	{
 		D3D12_INDEX_BUFFER_VIEW ibv;
 		ibv.BufferLocation = IndexBufferGPU->GetGPUVirtualAddress();
-		ibv.Format = IndexFormat;
+		ibv.Format = format == DXGI_FORMAT_UNKNOWN ? IndexFormat : format;
 		ibv.SizeInBytes = IndexBufferByteSize;
 
 		return ibv;
 	}
-
-	// We can free this memory after we finish upload to the GPU.
-	void DisposeUploaders()
-	{
-		VertexBufferUploader = nullptr;
-		IndexBufferUploader = nullptr;
-	}
 };
 
 struct Light
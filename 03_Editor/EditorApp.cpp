@@ -13,7 +13,44 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE prevInstance,
 
 	try
 	{
+		// -bakeshaders : 창을 만들지 않고 셰이더 변형을 모두 컴파일해서 캐시에 저장한 뒤 종료
+		if (cmdLine != nullptr && strstr(cmdLine, "-bakeshaders") != nullptr)
+			return EditorApp::BakeShaders();
+
+		// -importbench <파일> : 창을 만들지 않고 메시 임포트 속도만 측정
+		if (cmdLine != nullptr && strstr(cmdLine, "-importbench") != nullptr)
+		{
+			std::string path = strstr(cmdLine, "-importbench") + strlen("-importbench");
+			path.erase(0, std::min<size_t>(path.find_first_not_of(" \t"), path.size()));
+			if (!path.empty() && path[0] == '"')
+				path = path.substr(1, path.find('"', 1) - 1);
+			else
+				path.erase(std::min<size_t>(path.find_first_of(" \t"), path.size()));
+			return EditorApp::BenchmarkImport(path);
+		}
+
+		// -geobench : 창을 만들지 않고 기본 도형 생성 속도만 측정
+		if (cmdLine != nullptr && strstr(cmdLine, "-geobench") != nullptr)
+			return EditorApp::BenchmarkGeometry();
+
 		EditorApp theApp(hInstance);
+
+		// -renderthread : 게임 스레드/렌더 스레드 분리
+		if (cmdLine != nullptr && strstr(cmdLine, "-renderthread") != nullptr)
+			theApp.SetRenderThreadState(true);
+
+		// -warmup : 첫 프레임 전에 PSO를 모두 컴파일 (벤치마크 실행용)
+		if (cmdLine != nullptr && strstr(cmdLine, "-warmup") != nullptr)
+			theApp.SetPipelineWarmupState(true);
+
+		// -meshbench : 초기화할 때 쿠킹된 메시 로드 속도(GB/s)를 측정해서 디버그 출력
+		if (cmdLine != nullptr && strstr(cmdLine, "-meshbench") != nullptr)
+			theApp.SetMeshBenchmarkState(true);
+
+		// -depthprepass : 위치 스트림만 읽는 깊이 프리패스를 먼저 그린다.
+		if (cmdLine != nullptr && strstr(cmdLine, "-depthprepass") != nullptr)
+			theApp.SetDepthPrepassState(true);
+
 		if (!theApp.Initialize())
 			return 0;
 
@@ -33,8 +70,28 @@ EditorApp::EditorApp(HINSTANCE hInstance)
 
 EditorApp::~EditorApp()
 {
+	StopRenderThread();
+
 	if (md3dDevice != nullptr)
 		FlushCommandQueue();
+
+	// 핫 리로드 중인 컴파일을 끝내고, 다시 컴파일한 셰이더가 있으면 캐시 파일 갱신
+	mShaderWatcher.Stop();
+	mJobSystem.Wait(mShaderReloadJob);
+	mShaderCache.Save();
+
+	// 새로 컴파일한 PSO가 있으면 파이프라인 라이브러리 저장
+	OutputDebugStringA(mPipelineCache.GetStatsString().c_str());
+	mPipelineCache.Save();
+
+	char text[256];
+	snprintf(text, sizeof(text),
+		"Vertex fetch (estimated from FIFO cache ACMR): depth %.1f MB (interleaved %.1f MB), color %.1f MB, IA bindings %llu / %llu draws\n",
+		mVertexFetchStats.DepthBytes / (1024.0 * 1024.0),
+		mVertexFetchStats.DepthInterleavedBytes / (1024.0 * 1024.0),
+		mVertexFetchStats.ColorBytes / (1024.0 * 1024.0),
+		mVertexFetchStats.InputBindings, mVertexFetchStats.Draws);
+	OutputDebugStringA(text);
 }
 
 bool EditorApp::Initialize()
@@ -47,7 +104,7 @@ bool EditorApp::Initialize()
 
 	ThrowIfFailed(mCommandList->Reset(mDirectCmdListAlloc.Get(), nullptr));
 
-	// ī޶ ʱ ġ 
+	// 카메라 초기 위치 설정
 	mSceneCamera.SetPosition(0.0f, 2.0f, -15.0f);
 	mSceneCamera.UpdateViewMatrix();
 
@@ -56,23 +113,39 @@ bool EditorApp::Initialize()
 
 	BuildRootSignature();
 	BuildShadersAndInputLayout();
+
+	// 씬 메시가 함께 쓰는 정점/인덱스 버퍼 (스트림은 SceneVertexLayout 순서)
+	mGeometryArena.Initialize(md3dDevice.Get(), &mUploadManager, &mGpuAllocator,
+		SceneVertexLayout::Strides.data(), SceneVertexLayout::StreamCount, 256 * 1024, 1024 * 1024);
+	mProceduralMeshCache.Open("ProceduralMesh_", 64 * 1024 * 1024);
 	BuildShapeGeometry();
+	if (mMeshBenchmarkState)
+		RunMeshBenchmark();
 	BuildRenderItems();
 	BuildFrameResources();
 	BuildDescriptorHeaps();
 	BuildConstantBufferViews();
 	BuildPSOs();
-	SceneHeapsInit();				// Scene Heap 
-	GameHeapsInit();				// Game Heap 
 
-	// 2) ImGui + Texture SRV Heap 
-	D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-	srvHeapDesc.NumDescriptors = 100; // ˳ϰ
-	srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	// 새로 컴파일한 셰이더가 있으면 캐시 파일 갱신
+	const ShaderCache::Stats& shaderStats = mShaderCache.GetStats();
+	OutputDebugStringA(("ShaderCache: " + std::to_string(shaderStats.Hits) + " hits, " +
+		std::to_string(shaderStats.Misses + shaderStats.Invalidated) + " compiled\n").c_str());
+	mShaderCache.Save();
+
+	// 새로 컴파일한 PSO는 종료할 때 저장한다. (지금 저장하면 작업 스레드의 컴파일을 기다려야 한다)
+
+	// 셰이더 파일이 바뀌면 백그라운드에서 다시 컴파일 (핫 리로드)
+	if (mShaderWatcher.AddDirectory("..\\02_Engine\\Shaders", true))
+		mShaderWatcher.Start();
+
+	mRenderTargetPool.Initialize(md3dDevice.Get(), &mGpuAllocator, &mDescriptorHeap, &mDeferredRelease);	// 뷰 렌더 타겟 풀
+	mGpuFrameTimer.Initialize(md3dDevice.Get(), mCommandQueue.Get(), gNumFrameResources);	// 동적 해상도용 GPU 프레임 시간
+
+	mGraphExecutor.Initialize(md3dDevice.Get());	// 프레임 그래프 실행기
 
-	md3dDevice->CreateDescriptorHeap(&srvHeapDesc,
-		IID_PPV_ARGS(&mSrvDescriptorHeap));
+	// 지오메트리 업로드가 끝난 뒤에 직접 큐가 실행되도록 GPU에서 대기
+	mUploadManager.Submit().WaitOnQueue(mCommandQueue.Get());
 
 	ThrowIfFailed(mCommandList->Close());
 	ID3D12CommandList* cmdsLists[] = { mCommandList.Get() };
@@ -80,15 +153,19 @@ bool EditorApp::Initialize()
 
 	FlushCommandQueue();
 
-	//  UI ʱȭ
+	OutputDebugStringA(mGpuAllocator.GetStatsString().c_str());
+	OutputDebugStringA(mGeometryArena.GetStatsString("scene").c_str());
+
+	// 에디터 UI 초기화
 	mEditorUI.Initialize(
 		this,
 		mhMainWnd,
 		md3dDevice.Get(),
 		mCommandQueue.Get(),
-		mSrvDescriptorHeap.Get(),
+		&mDescriptorHeap,
 		mBackBufferFormat,
-		gNumFrameResources
+		gNumFrameResources,
+		mRenderThreadState
 	);
 
 	return true;
@@ -113,117 +190,188 @@ void EditorApp::SetRenderItemTransform(RenderItem* Item, const XMFLOAT3& Pos, co
 
 	XMStoreFloat4x4(&Item->World, world);
 	Item->NumFramesDirty = gNumFrameResources;
+
+	// 모든 뷰를 다시 그리도록 씬 편집 카운터 증가
+	++mSceneVersion;
+}
+
+void EditorApp::SetIsWireFrame(bool IsWireFrame)
+{
+	if (mIsWireframe == IsWireFrame)
+		return;
+
+	// 와이어프레임은 Scene뷰에만 적용된다.
+	mIsWireframe = IsWireFrame;
+	++mViews[(int)EditorView::Scene].SettingsVersion;
 }
 
 void EditorApp::OnResize()
 {
 	D3DApp::OnResize();
 
-	mSceneCamera.SetLens(0.25f * MathHelper::Pi, AspectRatio(), 1.0f, 1000.0f);
-	mGameCamera.SetLens(0.25f * MathHelper::Pi, AspectRatio(), 1.0f, 1000.0f);
-	
-	// â ũⰡ ٲ𶧸 Scene Heap ٽ ֱ
-	SceneHeapsInit();	
+	// Scene/Game 렌더 타겟과 카메라 종횡비는 창이 아니라 패널 크기를 따라간다. (PrepareView)
 }
 
+// 게임 스레드 : 시뮬레이션 후 프레임 스냅샷 작성
 void EditorApp::Update(const GameTimer& gt)
 {
 	OnKeyboardInput(gt);
 
-	mCurrFrameResourceIndex = (mCurrFrameResourceIndex + 1) % gNumFrameResources;
-	mCurrFrameResource = mFrameResources[mCurrFrameResourceIndex].get();
-
-	if (mCurrFrameResource->Fence != 0 && mFence->GetCompletedValue() < mCurrFrameResource->Fence)
+	// 렌더 스레드가 N 프레임 전 슬롯을 다 쓸 때까지 대기
+	int slot = mFramePipeline.BeginWrite();
+	if (slot < 0)
+		return;
+
+	// GPU가 해당 FrameResource를 다 쓸 때까지 대기
+	// (게임 스레드 ~ GPU 전체 지연이 gNumFrameResources 프레임을 넘지 않는다)
+	FrameResource* frameResource = mFrameResources[slot].get();
+	mTimeline.Wait(frameResource->Fence);
+
+	// 이 슬롯의 이전 스냅샷까지 GPU가 끝냈으므로 그때까지 반환된 렌더 타겟은 다시 빌려줄 수 있다.
+	if (mFrameSerial >= (UINT64)gNumFrameResources)
+		mRenderTargetPool.Collect(mFrameSerial - gNumFrameResources);
+
+	// 셰이더 핫 리로드 (PSO 교체는 여기, 프레임 경계에서만 일어난다)
+	UpdateHotReload();
+
+	// 동적 해상도 배율 갱신 (이번 프레임 뷰 크기에 반영)
+	// 이 슬롯을 마지막으로 쓴 프레임의 GPU 시간을 쓴다. (위에서 그 프레임의 펜스를 기다렸다)
+	// CPU 프레임 시간은 대기/UI 비용이 섞여서 해상도를 줄여도 줄지 않는다.
+	// 뷰를 하나도 그리지 않은 프레임은 시간이 짧게 나오므로 측정에서 뺀다.
+	RenderSnapshot& snapshot = *mRenderSnapshots[slot];
+	bool isAnyViewRendered = false;
+	for (const ViewRenderInfo& info : snapshot.Views)
+		isAnyViewRendered |= info.ShouldRender;
+
+	float gpuFrameMs = 0.0f;
+	if (mGpuFrameTimer.ReadFrameMs(slot, gpuFrameMs) && mDynamicResolutionState && isAnyViewRendered)
+		mDynamicResolution.Update(gpuFrameMs);
+
+	// 에디터 UI 구성 (오브젝트 Transform 등이 여기서 바뀐다)
+	// 패널이 보이는 뷰만 PrepareView가 불려서 IsVisible이 켜진다.
+	for (ViewState& state : mViews)
+		state.IsVisible = false;
+
+	// 위에서 이 슬롯의 펜스를 기다렸으므로 mFrameSerial - gNumFrameResources번까지의 스냅샷은 GPU가 끝냈다.
+	const UINT64 completedFrames = mFrameSerial >= (UINT64)gNumFrameResources ? mFrameSerial - gNumFrameResources + 1 : 0;
+	mEditorUI.BuildFrame(mFrameSerial, completedFrames);
+
+	// 이번 프레임의 뷰 렌더 타겟 (UI에서 패널이 그려지지 않은 뷰는 이전 크기 유지)
+	for (int i = 0; i < (int)EditorView::Count; ++i)
 	{
-		HANDLE eventHandle = CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS);
-		ThrowIfFailed(mFence->SetEventOnCompletion(mCurrFrameResource->Fence, eventHandle));
-		WaitForSingleObject(eventHandle, INFINITE);
-		CloseHandle(eventHandle);
+		if (mViews[i].Target == nullptr)
+			UpdateViewTarget((EditorView)i);
+
+		ViewState& state = mViews[i];
+		ViewRenderInfo& info = snapshot.Views[i];
+		info.Texture = state.Target->Resource.Get();
+		info.RTV = state.Target->RTV.CPU;
+		info.TargetWidth = state.Target->Width;
+		info.TargetHeight = state.Target->Height;
+		info.Width = state.RenderWidth;
+		info.Height = state.RenderHeight;
+
+		// 패널이 안 보이거나 마지막으로 그린 뒤 바뀐 게 없으면 이전 텍스처를 그대로 쓴다.
+		const ViewVersion version = GetViewVersion((EditorView)i);
+		info.Pipeline = version.Pipeline;
+		info.DepthPipeline = version.DepthPipeline;
+		info.ShouldRender = state.IsVisible && version != state.Rendered;
+		if (info.ShouldRender)
+			state.Rendered = version;
 	}
 
-	UpdateObjectCBs(gt);
-	UpdateMainPassCB(gt);
-	UpdateMainPassCB2(gt);
+	// 핫 리로드로 교체된 PSO (이 스냅샷부터는 쓰지 않는다)
+	snapshot.RetiredPipelines.swap(mRetiredPSOs);
+	mRetiredPSOs.clear();
+
+	UpdateObjectCBs(gt, snapshot);
+	UpdateMainPassCB(gt, snapshot);
+	UpdateMainPassCB2(gt, snapshot);
+	snapshot.UI.Capture(ImGui::GetDrawData());
+
+	// 렌더 스레드로 넘기기
+	++mFrameSerial;
+	mFramePipeline.EndWrite();
 }
 
+// 렌더 스레드 : 프레임 스냅샷으로 커맨드 기록 및 제출
 void EditorApp::Draw(const GameTimer& gt)
 {
-	auto cmdListAlloc = mCurrFrameResource->CmdListAlloc;
-
-	// Ŀǵ Ʈ Reset ( )
-	ThrowIfFailed(cmdListAlloc->Reset());
-	ThrowIfFailed(mCommandList->Reset(cmdListAlloc.Get(), nullptr));
+	int slot = mFramePipeline.BeginRead();
+	if (slot < 0)
+		return;
 
-	// Viewport/Scissor 
-	mCommandList->RSSetViewports(1, &mScreenViewport);
-	mCommandList->RSSetScissorRects(1, &mScissorRect);
+	mCurrFrameResourceIndex = slot;
+	mCurrFrameResource = mFrameResources[slot].get();
 
-	// Scene View   ׸
-	if (mIsWireframe)
-		mCommandList->SetPipelineState(mPSOs["opaque_wireframe"].Get());
-	else
-		mCommandList->SetPipelineState(mPSOs["opaque"].Get());
-	DrawSceneView();
-
-	// Game View   ׸
-	mCommandList->SetPipelineState(mPSOs["opaque"].Get());
-	DrawGameView();
-
-	CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		CurrentBackBuffer(),
-		D3D12_RESOURCE_STATE_PRESENT,
-		D3D12_RESOURCE_STATE_RENDER_TARGET
-	);
-	mCommandList->ResourceBarrier(1, &barrier);
+	RenderSnapshot& snapshot = *mRenderSnapshots[slot];
 
-	mCommandList->ClearRenderTargetView(CurrentBackBufferView(), Colors::LightSteelBlue, 0, nullptr);
-	mCommandList->ClearDepthStencilView(DepthStencilView(), D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
+	// 스냅샷의 상수 데이터를 FrameResource에 업로드
+	UploadFrameConstants(snapshot);
 
-	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = CurrentBackBufferView();
-	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = DepthStencilView();
-	mCommandList->OMSetRenderTargets(1, &rtvHandle, true, &dsvHandle);
+	auto cmdListAlloc = mCurrFrameResource->CmdListAlloc;
 
+	// 커맨드 리스트 Reset (한 번만)
+	ThrowIfFailed(cmdListAlloc->Reset());
+	ThrowIfFailed(mCommandList->Reset(cmdListAlloc.Get(), nullptr));
 
-	ID3D12DescriptorHeap* descriptorHeaps[] = { mCbvHeap.Get() };
-	mCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+	// GPU가 끝낸 프레임의 리소스/디스크립터 회수 후 통합 힙 설정 (프레임 동안 힙을 바꾸지 않는다)
+	const UINT64 completedFence = mTimeline.GetCompletedValue();
+	mDeferredRelease.ReleaseCompleted(completedFence);
+	mDescriptorHeap.ReleaseCompleted(completedFence);
+	mGeometryArena.ReleaseCompleted(completedFence);
+	mDescriptorHeap.Bind(mCommandList.Get());
 
-	mCommandList->SetGraphicsRootSignature(mRootSignature.Get());
+	// 이 프레임의 GPU 시간 측정 시작 (게임 스레드가 같은 슬롯을 다시 쓸 때 읽는다)
+	mGpuFrameTimer.Begin(mCommandList.Get(), slot);
 
-	int passCbvIndex = mPassCbvOffset + mCurrFrameResourceIndex;
-	auto passCbvHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(mCbvHeap->GetGPUDescriptorHandleForHeapStart());
-	passCbvHandle.Offset(passCbvIndex, mCbvSrvUavDescriptorSize);
-	mCommandList->SetGraphicsRootDescriptorTable(1, passCbvHandle);
+	// Viewport/Scissor 설정
+	mCommandList->RSSetViewports(1, &mScreenViewport);
+	mCommandList->RSSetScissorRects(1, &mScissorRect);
 
-	barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		CurrentBackBuffer(),
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		D3D12_RESOURCE_STATE_PRESENT
-	);
-	mCommandList->ResourceBarrier(1, &barrier);
+	// 프레임 그래프 구성 및 컴파일 (배리어, 트랜지언트 리소스는 그래프가 관리)
+	BuildFrameGraph(snapshot);
+	if (mGraphExecutor.Compile(mFrameGraph, completedFence, mTimeline.GetLastSignaled() + 1))
+		OutputDebugStringA(mFrameGraph.Dump().c_str());
 
-	//  UI ׸
-	mEditorUI.Draw(mCommandList.Get());
+	mGraphExecutor.Execute(mFrameGraph, mCommandList.Get());
 
+	mGpuFrameTimer.End(mCommandList.Get(), slot);
 	ThrowIfFailed(mCommandList->Close());
 
 	ID3D12CommandList* cmdsLists[] = { mCommandList.Get() };
 	mCommandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
 
+	// 추가 뷰포트 창 (렌더 스레드 미사용 시에만 활성화)
+	if (!mRenderThreadState)
+		mEditorUI.RenderPlatformWindows();
+
+	const int backBuffer = mCurrBackBuffer;
 	ThrowIfFailed(mSwapChain->Present(0, 0));
 	mCurrBackBuffer = (mCurrBackBuffer + 1) % SwapChainBufferCount;
 
-	mCurrFrameResource->Fence = ++mCurrentFence;
+	mCurrFrameResource->Fence = mTimeline.Signal(mCommandQueue.Get());
+	mBackBufferFences[backBuffer] = mCurrFrameResource->Fence;
 
-	mCommandQueue->Signal(mFence.Get(), mCurrentFence);
+	// 이전 스냅샷들은 모두 이 펜스 전에 제출되었으므로 교체된 PSO는 이 펜스가 지나면 놓아도 된다.
+	for (PipelineHandle pipeline : snapshot.RetiredPipelines)
+		mPipelineCache.Retire(pipeline, mCurrFrameResource->Fence);
+	snapshot.RetiredPipelines.clear();
+
+	// 이번 프레임에 쓴 링 영역 디스크립터는 이 펜스가 지나면 회수
+	mDescriptorHeap.FinishFrame(mCurrFrameResource->Fence);
+
+	// 슬롯을 게임 스레드에 돌려주기
+	mFramePipeline.EndRead();
 }
 
-// 콺 Ŭ  
+// 마우스 클릭 했을 때
 void EditorApp::OnMouseDown(WPARAM btnState, int x, int y)
 {
-	// Scene信 Ŀ Ǿ    
+	// Scene뷰에 포커싱이 되어 있지 않으면 실행 안함
 	if (!mEditorUI.GetIsSceneViewFocused()) return;
 
-	// 콺 Ŭ Ȱȭ  ġ 
+	// 마우스 클릭 활성화 및 위치 저장
 	IsMouseDown = true;
 	mLastMousePos.x = x;
 	mLastMousePos.y = y;
@@ -231,27 +379,27 @@ void EditorApp::OnMouseDown(WPARAM btnState, int x, int y)
 	SetCapture(mhMainWnd);
 }
 
-// 콺 Ŭ  
+// 마우스 클릭 끝냈을 때
 void EditorApp::OnMouseUp(WPARAM btnState, int x, int y)
 {
-	// 콺 Ŭ Ȱȭ
+	// 마우스 클릭 비활성화
 	IsMouseDown = false;
 
-	// Scene信 Ŀ Ǿ    
+	// Scene뷰에 포커싱이 되어 있지 않으면 실행 안함
 	if (!mEditorUI.GetIsSceneViewFocused()) return;
 
 	ReleaseCapture();
 }
 
-// 콺  
+// 마우스를 움직일 때
 void EditorApp::OnMouseMove(WPARAM btnState, int x, int y)
 {
-	// Scene信 Ŀ Ǿ    
-	// 콺 Ŭ ȵ ¶  
+	// Scene뷰에 포커싱이 되어 있지 않으면 실행 안함
+	// 마우스 클릭이 안된 상태라면 실행 안함
 	if (!mEditorUI.GetIsSceneViewFocused()) return;
 	if (!IsMouseDown) return;
 
-	// Ŭ ϰ ִ 
+	// 우클릭을 하고 있는 경우
 	if ((btnState & MK_RBUTTON) != 0)
 	{
 		float dx = XMConvertToRadians(0.25f * static_cast<float>(x - mLastMousePos.x));
@@ -271,19 +419,19 @@ void EditorApp::OnKeyboardInput(const GameTimer& gt)
 
 	const float dt = gt.DeltaTime();
 
-	// ,  ̵
+	// 앞, 뒤 이동
 	if (GetAsyncKeyState('W') & 0x8000)
 		mSceneCamera.Walk(10.0f * dt);
 	if (GetAsyncKeyState('S') & 0x8000)
 		mSceneCamera.Walk(-10.0f * dt);
 
-	// ,  ̵
+	// 좌, 우 이동
 	if (GetAsyncKeyState('A') & 0x8000)
 		mSceneCamera.Strafe(-10.0f * dt);
 	if (GetAsyncKeyState('D') & 0x8000)
 		mSceneCamera.Strafe(10.0f * dt);
 
-	// ,  ̵
+	// 상, 하 이동
 	if (GetAsyncKeyState('Q') & 0x8000)
 		mSceneCamera.Fly(-10.0f * dt);
 	if (GetAsyncKeyState('E') & 0x8000)
@@ -292,34 +440,62 @@ void EditorApp::OnKeyboardInput(const GameTimer& gt)
 	mSceneCamera.UpdateViewMatrix();
 }
 
-void EditorApp::UpdateObjectCBs(const GameTimer& gt)
+void EditorApp::UpdateObjectCBs(const GameTimer& gt, RenderSnapshot& snapshot)
 {
-	auto currObjectCB = mCurrFrameResource->ObjectCB.get();
-	for (auto& e : mAllRitems)
+	snapshot.OpaqueItems.resize(mOpaqueRitems.size());
+
+	for (size_t i = 0; i < mOpaqueRitems.size(); ++i)
 	{
-		if (e->NumFramesDirty > 0)
+		RenderItem* e = mOpaqueRitems[i];
+		RenderItemSnapshot& item = snapshot.OpaqueItems[i];
+
+		// 슬롯이 FrameResource와 1:1이므로 NumFramesDirty는 슬롯 단위로 소모된다.
+		item.IsDirty = e->NumFramesDirty > 0;
+		if (item.IsDirty)
 		{
 			XMMATRIX world = XMLoadFloat4x4(&e->World);
+			XMStoreFloat4x4(&item.ObjConstants.World, XMMatrixTranspose(world));
+			item.ObjConstants.PositionScale = e->Geo->PositionScale;
+			item.ObjConstants.PositionOffset = e->Geo->PositionOffset;
 
-			ObjectConstants objConstants;
-			XMStoreFloat4x4(&objConstants.World, XMMatrixTranspose(world));
+			e->NumFramesDirty--;
+		}
 
-			currObjectCB->CopyData(e->ObjCBIndex, objConstants);
+		item.ObjCBIndex = e->ObjCBIndex;
+		item.Geo = e->Geo;
+		item.PrimitiveType = e->PrimitiveType;
 
-			e->NumFramesDirty--;
+		// 아레나 구간은 Compact로 옮겨질 수 있으므로 프레임마다 읽는다.
+		if (e->ArenaMesh != GeometryArena::InvalidHandle)
+		{
+			const GeometryRange range = mGeometryArena.GetRange(e->ArenaMesh);
+			item.Arena = &mGeometryArena;
+			item.IndexCount = range.IndexCount;
+			item.StartIndexLocation = range.StartIndex;
+			item.BaseVertexLocation = range.BaseVertex;
+			item.IndexFormat = range.IndexFormat;
+		}
+		else
+		{
+			item.Arena = nullptr;
+			item.IndexCount = e->IndexCount;
+			item.StartIndexLocation = e->StartIndexLocation;
+			item.BaseVertexLocation = e->BaseVertexLocation;
+			item.IndexFormat = e->IndexFormat;
 		}
+		item.Acmr = e->Acmr;
 	}
 }
 
-// Ӹ 뵥 Ʈ
-void EditorApp::UpdateMainPassCB(const GameTimer& gt)
+// 프레임마다 공용데이터 업데이트
+void EditorApp::UpdateMainPassCB(const GameTimer& gt, RenderSnapshot& snapshot)
 {
-	// ī޶ View/Projection  
-	XMMATRIX view = mSceneCamera.GetView();				// ī޶    ٶ󺸴
-	XMMATRIX proj = mSceneCamera.GetProj();				//   (FOV, Near/Far )
-	XMMATRIX viewProj = XMMatrixMultiply(view, proj);	// ȭ鿡 Ѹ  ʿ  
+	// 카메라 View/Projection 행렬 계산
+	XMMATRIX view = mSceneCamera.GetView();				// 카메라가 월드 공간을 어떻게 바라보는지
+	XMMATRIX proj = mSceneCamera.GetProj();				// 원근 투영 정보(FOV, Near/Far 등)
+	XMMATRIX viewProj = XMMatrixMultiply(view, proj);	// 화면에 뿌릴 때 필요한 최종 행렬
 
-	//  
+	// 역행렬 계산
 	XMVECTOR detView = XMMatrixDeterminant(view);
 	XMMATRIX invView = XMMatrixInverse(&detView, view);
 
@@ -329,7 +505,7 @@ void EditorApp::UpdateMainPassCB(const GameTimer& gt)
 	XMVECTOR detViewProj = XMMatrixDeterminant(viewProj);
 	XMMATRIX invViewProj = XMMatrixInverse(&detViewProj, viewProj);
 
-	// mMainPassCB 
+	// mMainPassCB에 저장
 	XMStoreFloat4x4(&mMainPassCB.View, XMMatrixTranspose(view));
 	XMStoreFloat4x4(&mMainPassCB.InvView, XMMatrixTranspose(invView));
 	XMStoreFloat4x4(&mMainPassCB.Proj, XMMatrixTranspose(proj));
@@ -337,32 +513,32 @@ void EditorApp::UpdateMainPassCB(const GameTimer& gt)
 	XMStoreFloat4x4(&mMainPassCB.ViewProj, XMMatrixTranspose(viewProj));
 	XMStoreFloat4x4(&mMainPassCB.InvViewProj, XMMatrixTranspose(invViewProj));
 
-	// ī޶ Position 
+	// 카메라 Position 저장
 	mMainPassCB.EyePosW = mSceneCamera.GetPosition3f();;
 
-	// ȭ ũ   
-	mMainPassCB.RenderTargetSize = XMFLOAT2((float)mClientWidth, (float)mClientHeight);
-	mMainPassCB.InvRenderTargetSize = XMFLOAT2(1.0f / mClientWidth, 1.0f / mClientHeight);
+	// 화면 크기 관련 정보 저장
+	const ViewState& viewState = mViews[(int)EditorView::Scene];
+	mMainPassCB.RenderTargetSize = XMFLOAT2((float)viewState.RenderWidth, (float)viewState.RenderHeight);
+	mMainPassCB.InvRenderTargetSize = XMFLOAT2(1.0f / viewState.RenderWidth, 1.0f / viewState.RenderHeight);
 	mMainPassCB.NearZ = 1.0f;
 	mMainPassCB.FarZ = 1000.0f;
 
-	//  ð 
+	// 게임 시간 저장
 	mMainPassCB.TotalTime = gt.TotalTime();
 	mMainPassCB.DeltaTime = gt.DeltaTime();
 
-	// GPU (PassDB)  ( 0 )
-	auto currPassCB = mCurrFrameResource->PassCB.get();
-	currPassCB->CopyData(0, mMainPassCB);
+	// 스냅샷에 저장 (렌더 스레드에서 PassCB 슬롯 0번에 업로드)
+	snapshot.ScenePassCB = mMainPassCB;
 }
 
-void EditorApp::UpdateMainPassCB2(const GameTimer& gt)
+void EditorApp::UpdateMainPassCB2(const GameTimer& gt, RenderSnapshot& snapshot)
 {
-	// ī޶ View/Projection  
-	XMMATRIX view = mGameCamera.GetView();				// ī޶    ٶ󺸴
-	XMMATRIX proj = mGameCamera.GetProj();				//   (FOV, Near/Far )
-	XMMATRIX viewProj = XMMatrixMultiply(view, proj);	// ȭ鿡 Ѹ  ʿ  
+	// 카메라 View/Projection 행렬 계산
+	XMMATRIX view = mGameCamera.GetView();				// 카메라가 월드 공간을 어떻게 바라보는지
+	XMMATRIX proj = mGameCamera.GetProj();				// 원근 투영 정보(FOV, Near/Far 등)
+	XMMATRIX viewProj = XMMatrixMultiply(view, proj);	// 화면에 뿌릴 때 필요한 최종 행렬
 
-	//  
+	// 역행렬 계산
 	XMVECTOR detView = XMMatrixDeterminant(view);
 	XMMATRIX invView = XMMatrixInverse(&detView, view);
 
@@ -372,7 +548,7 @@ void EditorApp::UpdateMainPassCB2(const GameTimer& gt)
 	XMVECTOR detViewProj = XMMatrixDeterminant(viewProj);
 	XMMATRIX invViewProj = XMMatrixInverse(&detViewProj, viewProj);
 
-	// mMainPassCB 
+	// mMainPassCB에 저장
 	XMStoreFloat4x4(&mMainPassCB.View, XMMatrixTranspose(view));
 	XMStoreFloat4x4(&mMainPassCB.InvView, XMMatrixTranspose(invView));
 	XMStoreFloat4x4(&mMainPassCB.Proj, XMMatrixTranspose(proj));
@@ -380,39 +556,50 @@ void EditorApp::UpdateMainPassCB2(const GameTimer& gt)
 	XMStoreFloat4x4(&mMainPassCB.ViewProj, XMMatrixTranspose(viewProj));
 	XMStoreFloat4x4(&mMainPassCB.InvViewProj, XMMatrixTranspose(invViewProj));
 
-	// ī޶ Position 
+	// 카메라 Position 저장
 	mMainPassCB.EyePosW = mGameCamera.GetPosition3f();;
 
-	// ȭ ũ   
-	mMainPassCB.RenderTargetSize = XMFLOAT2((float)mClientWidth, (float)mClientHeight);
-	mMainPassCB.InvRenderTargetSize = XMFLOAT2(1.0f / mClientWidth, 1.0f / mClientHeight);
+	// 화면 크기 관련 정보 저장
+	const ViewState& viewState = mViews[(int)EditorView::Game];
+	mMainPassCB.RenderTargetSize = XMFLOAT2((float)viewState.RenderWidth, (float)viewState.RenderHeight);
+	mMainPassCB.InvRenderTargetSize = XMFLOAT2(1.0f / viewState.RenderWidth, 1.0f / viewState.RenderHeight);
 	mMainPassCB.NearZ = 1.0f;
 	mMainPassCB.FarZ = 1000.0f;
 
-	//  ð 
+	// 게임 시간 저장
 	mMainPassCB.TotalTime = gt.TotalTime();
 	mMainPassCB.DeltaTime = gt.DeltaTime();
 
-	// GPU (PassDB)  ( 1 )
+	// 스냅샷에 저장 (렌더 스레드에서 PassCB 슬롯 1번에 업로드)
+	snapshot.GamePassCB = mMainPassCB;
+}
+
+// 렌더 스레드 : 스냅샷의 상수 데이터를 현재 FrameResource에 복사
+void EditorApp::UploadFrameConstants(const RenderSnapshot& snapshot)
+{
+	auto currObjectCB = mCurrFrameResource->ObjectCB.get();
+	for (const auto& item : snapshot.OpaqueItems)
+	{
+		if (item.IsDirty)
+			currObjectCB->CopyData(item.ObjCBIndex, item.ObjConstants);
+	}
+
 	auto currPassCB = mCurrFrameResource->PassCB.get();
-	currPassCB->CopyData(1, mMainPassCB);
+	currPassCB->CopyData(0, snapshot.ScenePassCB);
+	currPassCB->CopyData(1, snapshot.GamePassCB);
 }
 
 void EditorApp::BuildDescriptorHeaps()
 {
 	UINT objCount = (UINT)mOpaqueRitems.size();
 
-	UINT numDescriptors = (objCount + 2) * gNumFrameResources;
+	// 영구 영역 : 오브젝트 CBV + Scene/Game SRV + ImGui 텍스처
+	// 링 영역 : 프레임마다 복사하는 Pass CBV 등
+	mDescriptorHeap.Initialize(md3dDevice.Get(), 1024, 1024);
+	mStagingHeap.Initialize(md3dDevice.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 64);
 
-	mPassCbvOffset = objCount * gNumFrameResources;
-
-	D3D12_DESCRIPTOR_HEAP_DESC cbvHeapDesc;
-	cbvHeapDesc.NumDescriptors = numDescriptors;
-	cbvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	cbvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	cbvHeapDesc.NodeMask = 0;
-	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&cbvHeapDesc,
-		IID_PPV_ARGS(&mCbvHeap)));
+	mObjectCbvs = mDescriptorHeap.AllocatePersistent(objCount * gNumFrameResources);
+	mPassCbvs = mStagingHeap.Allocate(2 * gNumFrameResources);
 }
 
 void EditorApp::BuildConstantBufferViews()
@@ -430,9 +617,8 @@ void EditorApp::BuildConstantBufferViews()
 
 			cbAddress += i * objCBByteSize;
 
-			int heapIndex = frameIndex * objCount + i;
-			auto handle = CD3DX12_CPU_DESCRIPTOR_HANDLE(mCbvHeap->GetCPUDescriptorHandleForHeapStart());
-			handle.Offset(heapIndex, mCbvSrvUavDescriptorSize);
+			UINT heapIndex = frameIndex * objCount + i;
+			auto handle = mObjectCbvs.Offset(heapIndex, mCbvSrvUavDescriptorSize).CPU;
 
 			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
 			cbvDesc.BufferLocation = cbAddress;
@@ -449,13 +635,11 @@ void EditorApp::BuildConstantBufferViews()
 		auto passCB = mFrameResources[frameIndex]->PassCB->Resource();
 		D3D12_GPU_VIRTUAL_ADDRESS cbAddress = passCB->GetGPUVirtualAddress();
 
-		// FrameResource ȿ Pass CB 2 ִٰ 
+		// FrameResource 안에 Pass CB가 2개씩 있다고 가정
 		for (int passIndex = 0; passIndex < 2; ++passIndex)
 		{
-			auto handle = CD3DX12_CPU_DESCRIPTOR_HANDLE(mCbvHeap->GetCPUDescriptorHandleForHeapStart());
-
-			int heapIndex = mPassCbvOffset + frameIndex * 2 + passIndex;
-			handle.Offset(heapIndex, mCbvSrvUavDescriptorSize);
+			UINT heapIndex = frameIndex * 2 + passIndex;
+			auto handle = mPassCbvs.Offset(heapIndex, mStagingHeap.GetDescriptorSize()).CPU;
 
 			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
 			cbvDesc.BufferLocation = cbAddress + passIndex * passCBByteSize;
@@ -498,134 +682,741 @@ void EditorApp::BuildRootSignature()
 		serializedRootSig->GetBufferPointer(),
 		serializedRootSig->GetBufferSize(),
 		IID_PPV_ARGS(mRootSignature.GetAddressOf())));
+
+	// PSO 캐시 키는 루트 시그니처의 직렬화된 내용으로 만든다.
+	mPipelineCache.RegisterRootSignature(mRootSignature.Get(),
+		serializedRootSig->GetBufferPointer(), serializedRootSig->GetBufferSize());
 }
 
 void EditorApp::BuildShadersAndInputLayout()
 {
-	mShaders["standardVS"] = d3dUtil::CompileShader(L"..\\02_Engine\\Shaders\\color.hlsl", nullptr, "VS", "vs_5_1");
-	mShaders["opaquePS"] = d3dUtil::CompileShader(L"..\\02_Engine\\Shaders\\color.hlsl", nullptr, "PS", "ps_5_1");
+	// 쓰는 변형만 요청해서 작업 스레드에서 같이 컴파일한다.
+	// 원본과 include가 바뀌지 않았으면 캐시 파일의 바이트코드를 그대로 쓴다.
+	DeclareShaderPrograms(mShaderPermutations);
+	mShaderPermutations.Request("color", {});
 
-	mInputLayout =
-	{
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-		{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-	};
+	std::string errors;
+	const bool isCompiled = mShaderPermutations.CompileRequested(mShaderCache, mJobSystem, d3dUtil::GetShaderCompileFlags(), &errors);
+	if (!errors.empty())
+		OutputDebugStringA(errors.c_str());
+	if (!isCompiled)
+		ThrowIfFailed(E_FAIL);
+
+	UpdateShaderBlobs();
+
+	// 입력 레이아웃은 정점 스트림 구조체 설명에서 만든다. (SceneVertexLayout, FrameResource.h)
 }
 
-void EditorApp::BuildShapeGeometry()
+void EditorApp::UpdateShaderBlobs()
 {
-	GeometryGenerator geoGen;
-	GeometryGenerator::MeshData box = geoGen.CreateBox(1.5f, 0.5f, 1.5f, 3);
-	GeometryGenerator::MeshData grid = geoGen.CreateGrid(20.0f, 30.0f, 60, 40);
-	GeometryGenerator::MeshData sphere = geoGen.CreateSphere(0.5f, 20, 20);
-	GeometryGenerator::MeshData cylinder = geoGen.CreateCylinder(0.5f, 0.3f, 3.0f, 20, 20);
+	const ShaderVariantKey colorVariant = mShaderPermutations.GetVariantKey("color", {});
+	const std::vector<std::uint8_t>* colorVS = mShaderPermutations.GetBytecode("color", colorVariant, "VS");
+	const std::vector<std::uint8_t>* colorPS = mShaderPermutations.GetBytecode("color", colorVariant, "PS");
+	const std::vector<std::uint8_t>* depthVS = mShaderPermutations.GetBytecode("color", colorVariant, "VSDepth");
+	mShaders["standardVS"] = d3dUtil::CreateBlob(colorVS->data(), colorVS->size());
+	mShaders["opaquePS"] = d3dUtil::CreateBlob(colorPS->data(), colorPS->size());
+	mShaders["depthVS"] = d3dUtil::CreateBlob(depthVS->data(), depthVS->size());
+}
 
-	UINT boxVertexOffset = 0;
-	UINT gridVertexOffset = (UINT)box.Vertices.size();
-	UINT sphereVertexOffset = gridVertexOffset + (UINT)grid.Vertices.size();
-	UINT cylinderVertexOffset = sphereVertexOffset + (UINT)sphere.Vertices.size();
+void EditorApp::DeclareShaderPrograms(ShaderPermutationSet& permutations)
+{
+	ShaderProgramDesc color;
+	color.Name = "color";
+	color.SourcePath = "..\\02_Engine\\Shaders\\color.hlsl";
+	color.Stages = { { "VS", "vs_5_1" }, { "VSDepth", "vs_5_1" }, { "PS", "ps_5_1" } };
+	color.KeywordGroups = { { "", "DEBUG_DEPTH" } };	// 디버그 표시 모드
+	permutations.AddProgram(color);
+}
 
-	UINT boxIndexOffset = 0;
-	UINT gridIndexOffset = (UINT)box.Indices32.size();
-	UINT sphereIndexOffset = gridIndexOffset + (UINT)grid.Indices32.size();
-	UINT cylinderIndexOffset = sphereIndexOffset + (UINT)sphere.Indices32.size();
+int EditorApp::BakeShaders()
+{
+	// 콘솔에서 실행했으면 결과를 콘솔에 출력
+	FILE* console = nullptr;
+	if (AttachConsole(ATTACH_PARENT_PROCESS))
+		freopen_s(&console, "CONOUT$", "w", stdout);
+
+	JobSystem jobSystem;
+	jobSystem.Initialize();
+
+	D3DShaderCompiler compiler;
+	ShaderCache cache;
+	cache.Open("ShaderCache.bin", &compiler);
+
+	ShaderPermutationSet permutations;
+	DeclareShaderPrograms(permutations);
+	permutations.RequestAll();
+
+	// 실행할 때와 같은 플래그여야 캐시가 맞으므로 Debug/Release 빌드마다 따로 굽는다.
+	std::string errors;
+	const bool isCompiled = permutations.CompileRequested(cache, jobSystem, d3dUtil::GetShaderCompileFlags(), &errors);
+	const bool isSaved = cache.Save();
+
+	const ShaderPermutationSet::Stats& stats = permutations.GetStats();
+	const ShaderCache::Stats& cacheStats = cache.GetStats();
+
+	char line[256];
+	snprintf(line, sizeof(line),
+		"Shader bake: %u programs, %u variants, %u cached, %u compiled, %u failed (%.1f ms, %u workers)%s\n",
+		(UINT)permutations.GetProgramCount(),
+		stats.Requested,
+		cacheStats.Hits,
+		cacheStats.Misses + cacheStats.Invalidated - cacheStats.Failures,
+		stats.Failures,
+		stats.CompileMs,
+		jobSystem.GetWorkerCount(),
+		isSaved ? "" : " - failed to save cache");
+
+	const std::string report = errors + line;
+	OutputDebugStringA(report.c_str());
+	printf("%s", report.c_str());
+
+	if (console != nullptr)
+		fclose(console);
+
+	return isCompiled && isSaved ? 0 : 1;
+}
 
-	SubmeshGeometry boxSubmesh;
-	boxSubmesh.IndexCount = (UINT)box.Indices32.size();
-	boxSubmesh.StartIndexLocation = boxIndexOffset;
-	boxSubmesh.BaseVertexLocation = boxVertexOffset;
+int EditorApp::BenchmarkImport(const std::string& path)
+{
+	FILE* console = nullptr;
+	if (AttachConsole(ATTACH_PARENT_PROCESS))
+		freopen_s(&console, "CONOUT$", "w", stdout);
+
+	JobSystem jobSystem;
+	jobSystem.Initialize();
+
+	// 첫 번째는 파일을 OS 캐시에 올리는 실행이라 결과에서 뺀다.
+	const int iterations = 5;
+	MeshImporter::Stats best;
+	std::string report;
+	bool isImported = true;
+	GeometryGenerator::MeshData mesh;
+	for (int i = 0; i <= iterations && isImported; ++i)
+	{
+		MeshImporter::Stats stats;
+		std::string error;
+		mesh = GeometryGenerator::MeshData();
+		isImported = MeshImporter::Import(path, jobSystem, mesh, &error, &stats);
+		if (!isImported)
+			report = error + "\n";
+		else if (i > 0 && (best.TotalMs == 0.0 || stats.TotalMs < best.TotalMs))
+			best = stats;
+	}
 
-	SubmeshGeometry gridSubmesh;
-	gridSubmesh.IndexCount = (UINT)grid.Indices32.size();
-	gridSubmesh.StartIndexLocation = gridIndexOffset;
-	gridSubmesh.BaseVertexLocation = gridVertexOffset;
+	if (isImported)
+	{
+		char line[512];
+		snprintf(line, sizeof(line),
+			"Import bench: %s\n"
+			"  %.1f MB, %u triangles, %u vertices, %u chunks, %u workers\n"
+			"  best of %d : parse %.1f ms, merge %.1f ms, total %.1f ms (%.2f GB/s, %.1f M triangles/s)\n",
+			path.c_str(),
+			(double)best.Bytes / (1024.0 * 1024.0), best.Triangles, best.Vertices, best.Chunks, jobSystem.GetWorkerCount(),
+			iterations, best.ParseMs, best.MergeMs, best.TotalMs,
+			(double)best.Bytes / (best.TotalMs * 1.0e6), best.Triangles / (best.TotalMs * 1000.0));
+		report = line;
+
+		// 임포트한 메시에 최적화를 적용했을 때 정점 캐시 효율
+		report += MeshOptimizer::GetStatsString(path, MeshOptimizer::Optimize(mesh));
+
+		// 최적화한 삼각형 순서로 메시렛 분할
+		MeshletBuilder::MeshletData meshlets;
+		report += MeshletBuilder::GetStatsString(path, MeshletBuilder::Build(mesh, meshlets));
+	}
 
-	SubmeshGeometry sphereSubmesh;
-	sphereSubmesh.IndexCount = (UINT)sphere.Indices32.size();
-	sphereSubmesh.StartIndexLocation = sphereIndexOffset;
-	sphereSubmesh.BaseVertexLocation = sphereVertexOffset;
+	OutputDebugStringA(report.c_str());
+	printf("%s", report.c_str());
 
-	SubmeshGeometry cylinderSubmesh;
-	cylinderSubmesh.IndexCount = (UINT)cylinder.Indices32.size();
-	cylinderSubmesh.StartIndexLocation = cylinderIndexOffset;
-	cylinderSubmesh.BaseVertexLocation = cylinderVertexOffset;
+	if (console != nullptr)
+		fclose(console);
 
-	auto totalVertexCount =
-		box.Vertices.size() +
-		grid.Vertices.size() +
-		sphere.Vertices.size() +
-		cylinder.Vertices.size();
+	return isImported ? 0 : 1;
+}
 
-	std::vector<Vertex> vertices(totalVertexCount);
+int EditorApp::BenchmarkGeometry()
+{
+	FILE* console = nullptr;
+	if (AttachConsole(ATTACH_PARENT_PROCESS))
+		freopen_s(&console, "CONOUT$", "w", stdout);
 
-	UINT k = 0;
-	for (size_t i = 0; i < box.Vertices.size(); ++i, ++k)
+	JobSystem jobSystem;
+	jobSystem.Initialize();
+
+	GeometryGenerator serialGen;
+	GeometryGenerator parallelGen(&jobSystem);
+
+	// 도형마다 가장 높은 분할 수준 (지오스피어 / 박스는 6단계가 상한)
+	struct Case
+	{
+		const char* Name;
+		std::function<GeometryGenerator::MeshData(GeometryGenerator&)> Create;
+	};
+	const Case cases[] =
+	{
+		{ "geosphere 6", [](GeometryGenerator& g) { return g.CreateGeosphere(1.0f, 6); } },
+		{ "box 6", [](GeometryGenerator& g) { return g.CreateBox(1.0f, 1.0f, 1.0f, 6); } },
+		{ "sphere 1024x1024", [](GeometryGenerator& g) { return g.CreateSphere(1.0f, 1024, 1024); } },
+		{ "cylinder 1024x1024", [](GeometryGenerator& g) { return g.CreateCylinder(1.0f, 0.5f, 2.0f, 1024, 1024); } },
+		{ "grid 1025x1025", [](GeometryGenerator& g) { return g.CreateGrid(100.0f, 100.0f, 1025, 1025); } },
+	};
+
+	// 가장 빠른 실행 시간 (ms)
+	const int iterations = 5;
+	auto measure = [&](GeometryGenerator& generator, const Case& c, GeometryGenerator::MeshData& mesh)
+	{
+		double bestMs = 0.0;
+		for (int i = 0; i < iterations; ++i)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			mesh = c.Create(generator);
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			bestMs = i == 0 ? ms : std::min<double>(bestMs, ms);
+		}
+		return bestMs;
+	};
+
+	char line[512];
+	snprintf(line, sizeof(line), "Geometry bench: best of %d, %u workers\n", iterations, jobSystem.GetWorkerCount());
+	std::string report = line;
+
+	for (const Case& c : cases)
 	{
-		vertices[k].Pos = box.Vertices[i].Position;
-		vertices[k].Color = XMFLOAT4(DirectX::Colors::DarkGreen);
+		GeometryGenerator::MeshData mesh;
+		const double serialMs = measure(serialGen, c, mesh);
+		const double parallelMs = measure(parallelGen, c, mesh);
+
+		const size_t triangles = mesh.Indices32.size() / 3;
+		const double bytes = (double)(mesh.Vertices.size() * sizeof(GeometryGenerator::Vertex) + mesh.Indices32.size() * sizeof(std::uint32_t));
+		snprintf(line, sizeof(line),
+			"  %-20s %8zu vertices %8zu triangles : serial %7.2f ms, parallel %7.2f ms (x%.2f, %.2f GB/s)\n",
+			c.Name, mesh.Vertices.size(), triangles, serialMs, parallelMs,
+			serialMs / parallelMs, bytes / (parallelMs * 1.0e6));
+		report += line;
 	}
 
-	for (size_t i = 0; i < grid.Vertices.size(); ++i, ++k)
+	// 변마다 중점을 하나만 만들었을 때와 삼각형마다 따로 만들었을 때 (분할 한 번에 삼각형당 정점 6개)
 	{
-		vertices[k].Pos = grid.Vertices[i].Position;
-		vertices[k].Color = XMFLOAT4(DirectX::Colors::ForestGreen);
+		GeometryGenerator::MeshData mesh = parallelGen.CreateGeosphere(1.0f, 6);
+		const size_t unweldedVertices = mesh.Indices32.size() / 3 / 4 * 6;
+		snprintf(line, sizeof(line), "  geosphere 6 welded : %zu vertices (without sharing %zu, %.1f%%)\n",
+			mesh.Vertices.size(), unweldedVertices, 100.0 * mesh.Vertices.size() / unweldedVertices);
+		report += line;
 	}
 
-	for (size_t i = 0; i < sphere.Vertices.size(); ++i, ++k)
+	// 씬 정점 형식 (양자화 위치 + 색 스트림)으로 만들기
+	// MeshData 경로 : 생성 -> 정점 캐시/fetch 순서 -> 스트림 분리 -> 스테이징 복사 (이전 BuildShapeGeometry)
+	// 싱크 경로 : 생성기가 스테이징에 바로 쓴다. (여기서는 스테이징 대신 미리 잡은 메모리)
 	{
-		vertices[k].Pos = sphere.Vertices[i].Position;
-		vertices[k].Color = XMFLOAT4(DirectX::Colors::Crimson);
+		const UINT slices = 1024;
+		const XMFLOAT3 positionScale(1.0f, 1.0f, 1.0f);
+		const XMFLOAT3 positionOffset(0.0f, 0.0f, 0.0f);
+		const XMFLOAT4 color(DirectX::Colors::Crimson);
+
+		std::vector<std::uint8_t> staging;
+		VertexCopyCounter meshDataCopies;
+		VertexCopyCounter sinkCopies;
+		double meshDataMs = 0.0;
+		double sinkMs = 0.0;
+		for (int i = 0; i < iterations; ++i)
+		{
+			meshDataCopies = VertexCopyCounter();
+			auto start = std::chrono::high_resolution_clock::now();
+			{
+				GeometryGenerator::MeshData mesh = parallelGen.CreateSphere(1.0f, slices, slices);
+				meshDataCopies.AddCopy(mesh.Vertices.size());
+
+				MeshOptimizer::OptimizeVertexCache(mesh.Indices32, (UINT)mesh.Vertices.size(), MeshOptimizer::DefaultCacheSize);
+				MeshOptimizer::OptimizeVertexFetch(mesh);
+				meshDataCopies.AddCopy(mesh.Vertices.size());
+
+				const size_t vertexCount = mesh.Vertices.size();
+				std::vector<VertexPosition> positions(vertexCount);
+				std::vector<VertexColor> colors(vertexCount);
+				for (size_t v = 0; v < vertexCount; ++v)
+				{
+					positions[v].Pos = VertexQuantizer::EncodePosition(mesh.Vertices[v].Position, positionScale, positionOffset);
+					colors[v].Color = VertexQuantizer::EncodeColor(color);
+				}
+				meshDataCopies.AddCopy(vertexCount);
+
+				const size_t positionBytes = vertexCount * sizeof(VertexPosition);
+				const size_t colorBytes = vertexCount * sizeof(VertexColor);
+				staging.resize(positionBytes + colorBytes + mesh.Indices32.size() * sizeof(std::uint32_t));
+				memcpy(staging.data(), positions.data(), positionBytes);
+				memcpy(staging.data() + positionBytes, colors.data(), colorBytes);
+				memcpy(staging.data() + positionBytes + colorBytes, mesh.Indices32.data(), mesh.Indices32.size() * sizeof(std::uint32_t));
+				meshDataCopies.AddCopy(vertexCount);
+				meshDataCopies.Vertices = vertexCount;
+			}
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			meshDataMs = i == 0 ? ms : std::min<double>(meshDataMs, ms);
+
+			sinkCopies = VertexCopyCounter();
+			start = std::chrono::high_resolution_clock::now();
+			{
+				SceneVertexSink sink(nullptr, positionScale, positionOffset, color, &sinkCopies);
+				parallelGen.CreateSphere(sink, 1.0f, slices, slices);
+				sink.Finish();
+			}
+			const double sinkRunMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			sinkMs = i == 0 ? sinkRunMs : std::min<double>(sinkMs, sinkRunMs);
+		}
+
+		snprintf(line, sizeof(line),
+			"  scene format, sphere %ux%u (%llu vertices) : MeshData path %.2f copies/vertex %.2f ms, sink %.2f copies/vertex %.2f ms\n",
+			slices, slices, (unsigned long long)sinkCopies.Vertices,
+			meshDataCopies.GetCopiesPerVertex(), meshDataMs,
+			sinkCopies.GetCopiesPerVertex(), sinkMs);
+		report += line;
 	}
 
-	for (size_t i = 0; i < cylinder.Vertices.size(); ++i, ++k)
+	// 절차적 메시 캐시 : 처음 (생성 + 정점 캐시 최적화 + 파일 쓰기) / 메모리 / 디스크 (새 캐시 = 다시 실행한 것처럼)
+	// 매핑은 읽을 때 페이지를 가져오므로 모두 스테이징으로 복사하는 시간까지 잰다.
 	{
-		vertices[k].Pos = cylinder.Vertices[i].Position;
-		vertices[k].Color = XMFLOAT4(DirectX::Colors::SteelBlue);
+		const ProceduralMeshDesc desc = ProceduralMeshDesc::Sphere(1.0f, 1024, 1024);
+		const XMFLOAT3 positionScale(1.0f, 1.0f, 1.0f);
+		const XMFLOAT3 positionOffset(0.0f, 0.0f, 0.0f);
+		const XMFLOAT4 color(DirectX::Colors::Crimson);
+		const std::uint64_t formatKey = 0;
+
+		auto build = [&](const ProceduralMeshDesc& meshDesc, ProceduralMesh& mesh)
+		{
+			SceneVertexSink sink(&mesh, positionScale, positionOffset, color);
+			meshDesc.Create(parallelGen, sink);
+			sink.Finish();
+		};
+
+		std::vector<std::uint8_t> staging;
+		auto measureCache = [&](ProceduralMeshCache& cache)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			std::shared_ptr<const ProceduralMesh> mesh = cache.GetOrCreate(desc, formatKey, build);
+
+			const size_t indexBytes = (size_t)mesh->GetIndexCount() * sizeof(std::uint32_t);
+			staging.resize((size_t)mesh->GetByteSize());
+			size_t offset = 0;
+			for (UINT i = 0; i < mesh->GetStreamCount(); ++i)
+			{
+				const size_t streamBytes = (size_t)mesh->GetVertexStride(i) * mesh->GetVertexCount();
+				memcpy(staging.data() + offset, mesh->GetVertexData(i), streamBytes);
+				offset += streamBytes;
+			}
+			memcpy(staging.data() + offset, mesh->GetIndices(), indexBytes);
+			return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		};
+
+		ProceduralMeshCache cache;
+		cache.Open("GeoBench_", 1024ull * 1024 * 1024);
+		const std::string path = cache.GetFilePath(desc, formatKey);
+		std::remove(path.c_str());
+
+		const double buildMs = measureCache(cache);
+		const double memoryMs = measureCache(cache);
+
+		ProceduralMeshCache restartedCache;
+		restartedCache.Open("GeoBench_", 1024ull * 1024 * 1024);
+		const double diskMs = measureCache(restartedCache);
+		restartedCache.Close();
+		std::remove(path.c_str());
+
+		snprintf(line, sizeof(line),
+			"  procedural cache, sphere %ux%u (%.2f MB) : build %.2f ms, memory hit %.2f ms, disk hit %.2f ms\n",
+			desc.Counts[0], desc.Counts[1], staging.size() / (1024.0 * 1024.0), buildMs, memoryMs, diskMs);
+		report += line;
+	}
+
+	OutputDebugStringA(report.c_str());
+	printf("%s", report.c_str());
+
+	if (console != nullptr)
+		fclose(console);
+
+	return 0;
+}
+
+SceneVertexSink::SceneVertexSink(GeometryArena* arena, const XMFLOAT3& positionScale, const XMFLOAT3& positionOffset, const XMFLOAT4& color, VertexCopyCounter* counter) :
+	mArena(arena),
+	mPositionScale(positionScale),
+	mPositionOffset(positionOffset),
+	mColor(VertexQuantizer::EncodeColor(color)),
+	mCounter(counter)
+{
+}
+
+SceneVertexSink::SceneVertexSink(ProceduralMesh* mesh, const XMFLOAT3& positionScale, const XMFLOAT3& positionOffset, const XMFLOAT4& color, VertexCopyCounter* counter) :
+	mMesh(mesh),
+	mPositionScale(positionScale),
+	mPositionOffset(positionOffset),
+	mColor(VertexQuantizer::EncodeColor(color)),
+	mCounter(counter)
+{
+}
+
+void SceneVertexSink::Begin(std::uint32_t vertexCount, std::uint32_t indexCount)
+{
+	mVertexCount = vertexCount;
+	mIndexCount = indexCount;
+
+	if (mArena != nullptr)
+	{
+		void* streams[SceneVertexLayout::StreamCount];
+		mHandle = mArena->AllocateMapped(vertexCount, indexCount, streams, &mIndexData);
+		if (mHandle == GeometryArena::InvalidHandle)
+			ThrowIfFailed(E_OUTOFMEMORY);
+
+		mPositions = static_cast<VertexPosition*>(streams[0]);
+		mColors = static_cast<VertexColor*>(streams[1]);
+		mIndexStride = GeometryArena::GetIndexStride(vertexCount);
+
+		// 최적화는 스테이징을 다시 읽어야 하므로 자체 버퍼에서 한다.
+		mOwnedIndices.resize(indexCount);
+		mIndices = mOwnedIndices.data();
+		return;
+	}
+
+	if (mMesh != nullptr)
+	{
+		mMesh->Allocate(vertexCount, indexCount, SceneVertexLayout::Strides.data(), SceneVertexLayout::StreamCount);
+		mMesh->SetPositionTransform(&mPositionScale.x, &mPositionOffset.x);
+
+		mPositions = reinterpret_cast<VertexPosition*>(mMesh->GetVertexData(0));
+		mColors = reinterpret_cast<VertexColor*>(mMesh->GetVertexData(1));
+		mIndices = mMesh->GetIndices();
+		mIndexData = mIndices;
+		mIndexStride = 4;
+		return;
 	}
 
-	std::vector<std::uint16_t> indices;
-	indices.insert(indices.end(), std::begin(box.GetIndices16()), std::end(box.GetIndices16()));
-	indices.insert(indices.end(), std::begin(grid.GetIndices16()), std::end(grid.GetIndices16()));
-	indices.insert(indices.end(), std::begin(sphere.GetIndices16()), std::end(sphere.GetIndices16()));
-	indices.insert(indices.end(), std::begin(cylinder.GetIndices16()), std::end(cylinder.GetIndices16()));
+	mOwnedPositions.resize(vertexCount);
+	mOwnedColors.resize(vertexCount);
+	mOwnedIndices.resize(indexCount);
+	mPositions = mOwnedPositions.data();
+	mColors = mOwnedColors.data();
+	mIndices = mOwnedIndices.data();
+	mIndexData = mIndices;
+	mIndexStride = 4;
+}
+
+GeometryArena::Handle SceneVertexSink::Finish()
+{
+	// 정점은 생성 순서 그대로 두고 삼각형 순서만 바꾼다. (정점을 옮기면 스테이징에 다시 써야 한다)
+	mCacheBefore = MeshOptimizer::AnalyzeVertexCache(mIndices, mIndexCount, mVertexCount, MeshOptimizer::DefaultCacheSize, MeshOptimizer::CacheType::Fifo);
+	MeshOptimizer::OptimizeVertexCache(mIndices, mIndexCount, mVertexCount, MeshOptimizer::DefaultCacheSize);
+	mCacheAfter = MeshOptimizer::AnalyzeVertexCache(mIndices, mIndexCount, mVertexCount, MeshOptimizer::DefaultCacheSize, MeshOptimizer::CacheType::Fifo);
+
+	// 아레나는 정점 수로 인덱스 크기를 골랐으므로 (GetIndexStride) 항상 들어간다.
+	if (mIndexData != mIndices)
+		IndexCodec::Convert(mIndices, mIndexCount, mIndexData, mIndexStride);
 
-	const UINT vbByteSize = (UINT)vertices.size() * sizeof(Vertex);
-	const UINT ibByteSize = (UINT)indices.size() * sizeof(std::uint16_t);
+	if (mCounter != nullptr)
+	{
+		mCounter->AddCopy(mVertexCount);
+		mCounter->Vertices += mVertexCount;
+	}
+	return mHandle;
+}
 
+void EditorApp::BuildShapeGeometry()
+{
+	// 정점을 만들기 전에 양자화 변환이 정해져야 하므로 경계 상자는 도형 매개변수로 바로 구한다. (네 메시가 같은 값을 쓴다)
+	const XMFLOAT3 boxSize(1.5f, 0.5f, 1.5f);
+	const float gridWidth = 20.0f;
+	const float gridDepth = 30.0f;
+	const float sphereRadius = 0.5f;
+	const float cylinderBottomRadius = 0.5f;
+	const float cylinderTopRadius = 0.3f;
+	const float cylinderHeight = 3.0f;
+	const float cylinderRadius = std::max<float>(cylinderBottomRadius, cylinderTopRadius);
+
+	const XMFLOAT3 center(0.0f, 0.0f, 0.0f);
+	BoundingBox bounds(center, XMFLOAT3(0.5f * boxSize.x, 0.5f * boxSize.y, 0.5f * boxSize.z));
+	BoundingBox::CreateMerged(bounds, bounds, BoundingBox(center, XMFLOAT3(0.5f * gridWidth, 0.0f, 0.5f * gridDepth)));
+	BoundingBox::CreateMerged(bounds, bounds, BoundingBox(center, XMFLOAT3(sphereRadius, sphereRadius, sphereRadius)));
+	BoundingBox::CreateMerged(bounds, bounds, BoundingBox(center, XMFLOAT3(cylinderRadius, 0.5f * cylinderHeight, cylinderRadius)));
+
+	XMFLOAT3 positionScale;
+	XMFLOAT3 positionOffset;
+	VertexQuantizer::GetPositionTransform(bounds, positionScale, positionOffset);
+
+	// 절차적 메시 캐시에서 씬 정점 형식(양자화 위치 + 색)으로 꺼내 아레나 업로드 스테이징에 복사한다.
+	// 캐시에 없으면 생성기가 캐시 메시에 바로 쓰고 (정점 캐시 최적화까지 해서) 디스크에도 남기므로 다음 실행부터는 생성하지 않는다.
+	// 스테이징 복사는 기록만 해 두고 Initialize에서 한 번에 복사 큐로 제출한다.
+	Hasher layoutHasher;
+	for (UINT stride : SceneVertexLayout::Strides)
+		layoutHasher.Add(stride);
+	for (float value : { positionScale.x, positionScale.y, positionScale.z, positionOffset.x, positionOffset.y, positionOffset.z })
+		layoutHasher.Add(value);
+
+	// 캐시에 없던 메시는 생성 -> 캐시 -> 스테이징으로 두 번, 있던 메시는 캐시 -> 스테이징으로 한 번 쓴다.
+	// 인덱스도 같다. (생성기가 캐시 메시의 인덱스 자리에 바로 쓰고 그 자리에서 정점 캐시 순서로 바꾼다)
+	GeometryGenerator geoGen(&mJobSystem);
+	VertexCopyCounter missCopies;
+	VertexCopyCounter hitCopies;
+	auto addToArena = [&](const std::string& name, const XMVECTORF32& color, const ProceduralMeshDesc& desc)
+	{
+		// 색도 정점 스트림에 들어가므로 키에 넣는다.
+		const std::uint64_t formatKey = Hasher(layoutHasher).Add(color.f[0]).Add(color.f[1]).Add(color.f[2]).Add(color.f[3]).Get();
+		bool created = false;
+		std::shared_ptr<const ProceduralMesh> mesh = mProceduralMeshCache.GetOrCreate(desc, formatKey,
+			[&](const ProceduralMeshDesc& meshDesc, ProceduralMesh& target)
+			{
+				SceneVertexSink sink(&target, positionScale, positionOffset, XMFLOAT4(color));
+				meshDesc.Create(geoGen, sink);
+				sink.Finish();
+				created = true;
+
+				char text[256];
+				snprintf(text, sizeof(text), "%s: %u vertices, FIFO ACMR %.3f -> %.3f\n",
+					name.c_str(), sink.GetVertexCount(), sink.GetCacheBefore().Acmr, sink.GetCacheAfter().Acmr);
+				OutputDebugStringA(text);
+			});
+
+		const UINT vertexCount = mesh->GetVertexCount();
+		void* streams[SceneVertexLayout::StreamCount];
+		void* indices = nullptr;
+		const GeometryArena::Handle handle = mGeometryArena.AllocateMapped(vertexCount, mesh->GetIndexCount(), streams, &indices);
+		if (handle == GeometryArena::InvalidHandle)
+			ThrowIfFailed(E_OUTOFMEMORY);
+
+		for (UINT i = 0; i < SceneVertexLayout::StreamCount; ++i)
+			memcpy(streams[i], mesh->GetVertexData(i), (size_t)SceneVertexLayout::Strides[i] * vertexCount);
+		IndexCodec::Convert(mesh->GetIndices(), mesh->GetIndexCount(), indices, GeometryArena::GetIndexStride(vertexCount));
+
+		VertexCopyCounter& copies = created ? missCopies : hitCopies;
+		if (created)
+			copies.AddCopy(vertexCount);
+		copies.AddCopy(vertexCount);
+		copies.Vertices += vertexCount;
+
+		mArenaMeshes[name] = handle;
+
+		// 정점 fetch 통계용 (그릴 때 삼각형 수에 곱한다)
+		mArenaMeshAcmr[name] = MeshOptimizer::AnalyzeVertexCache(mesh->GetIndices(), mesh->GetIndexCount(), vertexCount, MeshOptimizer::DefaultCacheSize, MeshOptimizer::CacheType::Fifo).Acmr;
+	};
+	addToArena("box", DirectX::Colors::DarkGreen, ProceduralMeshDesc::Box(boxSize.x, boxSize.y, boxSize.z, 3));
+	addToArena("grid", DirectX::Colors::ForestGreen, ProceduralMeshDesc::Grid(gridWidth, gridDepth, 60, 40));
+	addToArena("sphere", DirectX::Colors::Crimson, ProceduralMeshDesc::Sphere(sphereRadius, 20, 20));
+	addToArena("cylinder", DirectX::Colors::SteelBlue, ProceduralMeshDesc::Cylinder(cylinderBottomRadius, cylinderTopRadius, cylinderHeight, 20, 20));
+
+	char text[256];
+	snprintf(text, sizeof(text), "Shape geometry: cache miss %llu vertices, %.2f CPU copies per vertex (generator -> cache -> staging), "
+		"cache hit %llu vertices, %.2f CPU copies per vertex (cache -> staging)\n",
+		(unsigned long long)missCopies.Vertices, missCopies.GetCopiesPerVertex(),
+		(unsigned long long)hitCopies.Vertices, hitCopies.GetCopiesPerVertex());
+	OutputDebugStringA(text);
+	OutputDebugStringA(mProceduralMeshCache.GetStatsString().c_str());
+
+	// 정점/인덱스는 아레나에 있고 여기는 위치 복원 값만 (RenderItem::ArenaMesh로 그린다)
 	auto geo = std::make_unique<MeshGeometry>();
 	geo->Name = "shapeGeo";
+	geo->PositionScale = positionScale;
+	geo->PositionOffset = positionOffset;
 
-	ThrowIfFailed(D3DCreateBlob(vbByteSize, &geo->VertexBufferCPU));
-	CopyMemory(geo->VertexBufferCPU->GetBufferPointer(), vertices.data(), vbByteSize);
+	mGeometries[geo->Name] = std::move(geo);
+}
 
-	ThrowIfFailed(D3DCreateBlob(ibByteSize, &geo->IndexBufferCPU));
-	CopyMemory(geo->IndexBufferCPU->GetBufferPointer(), indices.data(), ibByteSize);
+void EditorApp::RunMeshBenchmark()
+{
+	const std::string path = "MeshBench.mesh";
 
-	geo->VertexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(),
-		mCommandList.Get(), vertices.data(), vbByteSize, geo->VertexBufferUploader);
+	// 큰 메시 하나를 쿠킹 (정점 약 100만 개, 인덱스 약 600만 개)
+	GeometryGenerator geoGen;
+	GeometryGenerator::MeshData grid = geoGen.CreateGrid(100.0f, 100.0f, 1025, 1025);
+	const UINT64 index32Bytes = (UINT64)grid.Indices32.size() * sizeof(std::uint32_t);
 
-	geo->IndexBufferGPU = d3dUtil::CreateDefaultBuffer(md3dDevice.Get(),
-		mCommandList.Get(), indices.data(), ibByteSize, geo->IndexBufferUploader);
+	// 16비트 인덱스로 그릴 수 있는 조각으로 나눈다. (조각마다 서브메시 하나, 경계 정점은 복제)
+	const std::vector<IndexBufferBuilder::Part> parts = IndexBufferBuilder::SplitForIndex16(grid);
 
-	geo->VertexByteStride = sizeof(Vertex);
-	geo->VertexBufferByteSize = vbByteSize;
-	geo->IndexFormat = DXGI_FORMAT_R16_UINT;
-	geo->IndexBufferByteSize = ibByteSize;
+	BoundingBox bounds;
+	BoundingBox::CreateFromPoints(bounds, grid.Vertices.size(), &grid.Vertices[0].Position, sizeof(GeometryGenerator::Vertex));
 
-	geo->DrawArgs["box"] = boxSubmesh;
-	geo->DrawArgs["grid"] = gridSubmesh;
-	geo->DrawArgs["sphere"] = sphereSubmesh;
-	geo->DrawArgs["cylinder"] = cylinderSubmesh;
+	XMFLOAT3 positionScale;
+	XMFLOAT3 positionOffset;
+	VertexQuantizer::GetPositionTransform(bounds, positionScale, positionOffset);
 
-	mGeometries[geo->Name] = std::move(geo);
+	std::vector<VertexPosition> positions(grid.Vertices.size());
+	std::vector<VertexColor> colors(grid.Vertices.size());
+	for (size_t i = 0; i < grid.Vertices.size(); ++i)
+	{
+		positions[i].Pos = VertexQuantizer::EncodePosition(grid.Vertices[i].Position, positionScale, positionOffset);
+		colors[i].Color = VertexQuantizer::EncodeColor(XMFLOAT4(DirectX::Colors::ForestGreen));
+	}
+
+	MeshFileDesc desc;
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		const IndexBufferBuilder::Part& part = parts[i];
+
+		BoundingBox partBounds;
+		BoundingBox::CreateFromPoints(partBounds, part.VertexCount, &grid.Vertices[part.BaseVertex].Position, sizeof(GeometryGenerator::Vertex));
+
+		MeshFileSubmesh submesh;
+		snprintf(submesh.Name, sizeof(submesh.Name), "grid%zu", i);
+		submesh.IndexCount = part.IndexCount;
+		submesh.StartIndex = part.StartIndex;
+		submesh.BaseVertex = (INT)part.BaseVertex;
+		submesh.Bounds = MeshLoader::ToFileBounds(partBounds);
+		desc.Submeshes.push_back(submesh);
+	}
+
+	// 조각으로 나눴으므로 16비트에 들어간다. 파일에는 압축해서 저장한다.
+	const UINT indexStride = IndexCodec::GetIndexStride(IndexCodec::GetMaxIndex(grid.Indices32.data(), grid.Indices32.size()));
+	std::vector<std::uint8_t> indices(grid.Indices32.size() * indexStride);
+	IndexCodec::Convert(grid.Indices32.data(), grid.Indices32.size(), indices.data(), indexStride);
+
+	desc.VertexStreams.push_back({ positions.data(), (UINT)sizeof(VertexPosition) });
+	desc.VertexStreams.push_back({ colors.data(), (UINT)sizeof(VertexColor) });
+	desc.VertexCount = (UINT)grid.Vertices.size();
+	desc.Indices = indices.data();
+	desc.IndexStride = indexStride;
+	desc.IndexCount = (UINT)grid.Indices32.size();
+	desc.CompressIndices = true;
+	desc.Bounds = MeshLoader::ToFileBounds(bounds);
+	memcpy(desc.PositionScale, &positionScale, sizeof(desc.PositionScale));
+	memcpy(desc.PositionOffset, &positionOffset, sizeof(desc.PositionOffset));
+
+	// 메시렛 표도 같이 쿠킹 (파일 크기와 로드 시간에 포함된다)
+	// 메시렛 정점은 정점 버퍼 전체 기준 번호이므로 잠깐 조각의 BaseVertex를 더한 인덱스로 만든다.
+	for (const IndexBufferBuilder::Part& part : parts)
+	{
+		for (UINT i = part.StartIndex; i < part.StartIndex + part.IndexCount; ++i)
+			grid.Indices32[i] += part.BaseVertex;
+	}
+	MeshletBuilder::MeshletData meshlets;
+	OutputDebugStringA(MeshletBuilder::GetStatsString("meshBench", MeshletBuilder::Build(grid, meshlets)).c_str());
+	desc.Meshlets = std::move(meshlets.Meshlets);
+	desc.MeshletVertices = std::move(meshlets.Vertices);
+	desc.MeshletTriangles = std::move(meshlets.Triangles);
+
+	if (!MeshFile::Write(path, desc))
+	{
+		OutputDebugStringA("MeshBench: failed to write MeshBench.mesh\n");
+		return;
+	}
+
+	// 열기 + 매핑 -> 업로드 링 복사 + GPU 복사 완료까지 (파일은 방금 썼으므로 OS 캐시에 있다)
+	const int iterations = 8;
+	UINT64 totalBytes = 0;
+	double openMs = 0.0;
+	double copyMs = 0.0;
+	double decodeMs = 0.0;
+	double totalMs = 0.0;
+	UINT64 fileIndexBytes = 0;
+	for (int i = 0; i < iterations; ++i)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		MeshLoader::Stats stats;
+		std::unique_ptr<MeshGeometry> geo = MeshLoader::Load(path, "meshBench", mUploadManager, &mGpuAllocator, &stats);
+		if (geo == nullptr)
+		{
+			OutputDebugStringA("MeshBench: failed to load MeshBench.mesh\n");
+			return;
+		}
+		mUploadManager.Submit().Wait();
+
+		totalMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		totalBytes += stats.Bytes;
+		openMs += stats.OpenMs;
+		copyMs += stats.CopyMs;
+		decodeMs += stats.DecodeMs;
+		fileIndexBytes = stats.FileIndexBytes;
+	}
+
+	char text[512];
+	snprintf(text, sizeof(text),
+		"MeshBench: %.1f MB x %d, open %.3f ms, copy %.2f ms (%.2f GB/s), total %.2f ms (%.2f GB/s)\n",
+		(double)totalBytes / iterations / (1024.0 * 1024.0), iterations,
+		openMs / iterations,
+		copyMs / iterations, (double)totalBytes / (copyMs * 1.0e6),
+		totalMs / iterations, (double)totalBytes / (totalMs * 1.0e6));
+	OutputDebugStringA(text);
+
+	const UINT64 indexBytes = (UINT64)desc.IndexStride * desc.IndexCount;
+	snprintf(text, sizeof(text),
+		"MeshBench indices: 32-bit %.1f MB -> %u-bit x %zu parts %.1f MB -> compressed %.1f MB (%.2f bits/triangle), decode %.2f ms (%.2f GB/s)\n",
+		(double)index32Bytes / (1024.0 * 1024.0),
+		desc.IndexStride * 8, parts.size(), (double)indexBytes / (1024.0 * 1024.0),
+		(double)fileIndexBytes / (1024.0 * 1024.0), fileIndexBytes * 8.0 / (desc.IndexCount / 3),
+		decodeMs / iterations, (double)indexBytes * iterations / (decodeMs * 1.0e6));
+	OutputDebugStringA(text);
+
+	// 지오메트리 아레나 : 조각을 모두 넣고 하나 걸러 지운 뒤 Compact (GPU 복사로 빈틈을 없앤다)
+	// 용량은 조각 크기의 합 + TLSF 크기 등급 여유 (GeometryArena::Compact와 같은 가장 큰 구간의 1/16 + 16)
+	// 인덱스는 16비트 칸 단위이고 32비트 구간은 정렬로 한 칸까지 빌 수 있다.
+	UINT64 arenaVertices = 0;
+	UINT64 arenaIndices = 0;
+	UINT64 largestVertices = 0;
+	UINT64 largestIndices = 0;
+	for (const IndexBufferBuilder::Part& part : parts)
+	{
+		const UINT64 indexSlots = (UINT64)part.IndexCount * (GeometryArena::GetIndexStride(part.VertexCount) / 2);
+		arenaVertices += part.VertexCount;
+		arenaIndices += indexSlots + 1;
+		largestVertices = std::max<UINT64>(largestVertices, part.VertexCount);
+		largestIndices = std::max<UINT64>(largestIndices, indexSlots);
+	}
+
+	GeometryArena arena;
+	arena.Initialize(md3dDevice.Get(), &mUploadManager, &mGpuAllocator,
+		SceneVertexLayout::Strides.data(), SceneVertexLayout::StreamCount,
+		(UINT)(arenaVertices + largestVertices / 16 + 16), (UINT)(arenaIndices + largestIndices / 16 + 16));
+
+	std::vector<GeometryArena::Handle> arenaParts;
+	for (const IndexBufferBuilder::Part& part : parts)
+	{
+		// 메시렛용으로 더해 둔 BaseVertex를 다시 빼서 조각 기준 인덱스로
+		std::vector<std::uint32_t> partIndices(grid.Indices32.begin() + part.StartIndex, grid.Indices32.begin() + part.StartIndex + part.IndexCount);
+		for (std::uint32_t& index : partIndices)
+			index -= part.BaseVertex;
+
+		const void* streams[SceneVertexLayout::StreamCount] = { &positions[part.BaseVertex], &colors[part.BaseVertex] };
+		const GeometryArena::Handle handle = arena.Allocate(streams, part.VertexCount, partIndices);
+		if (handle == GeometryArena::InvalidHandle)
+		{
+			OutputDebugStringA(arena.GetStatsString("meshBench (out of space)").c_str());
+			ThrowIfFailed(E_OUTOFMEMORY);
+		}
+		arenaParts.push_back(handle);
+	}
+	mUploadManager.Submit().Wait();
+
+	// 아직 그린 프레임이 없으므로 바로 돌려받는다.
+	const UINT64 completedFence = mTimeline.GetCompletedValue();
+	for (size_t i = 0; i < arenaParts.size(); i += 2)
+		arena.Free(arenaParts[i], completedFence);
+	arena.ReleaseCompleted(completedFence);
+	OutputDebugStringA(arena.GetStatsString("meshBench (freed)").c_str());
+
+	auto compactStart = std::chrono::high_resolution_clock::now();
+	arena.Compact(completedFence).Wait();
+	const double compactMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - compactStart).count();
+
+	OutputDebugStringA(arena.GetStatsString("meshBench (compacted)").c_str());
+	snprintf(text, sizeof(text), "MeshBench arena compact: %.2f ms\n", compactMs);
+	OutputDebugStringA(text);
+
+	arena.ReleaseCompleted(completedFence);
+	arena.Shutdown();
+
+	std::remove(path.c_str());
 }
 
 void EditorApp::BuildPSOs()
+{
+	RequestPSOs(mPSOs);
+
+	// 벤치마크 실행은 컴파일 때문에 튀는 프레임이 없도록 첫 프레임 전에 모두 끝낸다.
+	if (mPipelineWarmupState)
+		mPipelineCache.WaitForPending();
+}
+
+void EditorApp::RequestPSOs(std::unordered_map<std::string, PipelineHandle>& psos)
 {
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC opaquePsoDesc;
 
 	ZeroMemory(&opaquePsoDesc, sizeof(D3D12_GRAPHICS_PIPELINE_STATE_DESC));
-	opaquePsoDesc.InputLayout = { mInputLayout.data(), (UINT)mInputLayout.size() };
+	opaquePsoDesc.InputLayout = SceneVertexLayout::GetDesc();
 	opaquePsoDesc.pRootSignature = mRootSignature.Get();
 	opaquePsoDesc.VS =
 	{
@@ -648,11 +1439,114 @@ void EditorApp::BuildPSOs()
 	opaquePsoDesc.SampleDesc.Count = m4xMsaaState ? 4 : 1;
 	opaquePsoDesc.SampleDesc.Quality = m4xMsaaState ? (m4xMsaaQuality - 1) : 0;
 	opaquePsoDesc.DSVFormat = mDepthStencilFormat;
-	ThrowIfFailed(md3dDevice->CreateGraphicsPipelineState(&opaquePsoDesc, IID_PPV_ARGS(&mPSOs["opaque"])));
+
+	// 프리패스가 채운 깊이와 같은 값도 통과시킨다. (프리패스 PSO가 아직 없으면 평소처럼 깊이를 쓴다)
+	if (mDepthPrepassState)
+		opaquePsoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+
+	// 요청은 바로 돌아오고 컴파일은 작업 스레드에서 한다.
+	// 준비되기 전까지 와이어프레임은 불투명 PSO로 그리고, 불투명 PSO도 없으면 뷰를 지우기만 한다.
+	psos["opaque"] = mPipelineCache.RequestGraphicsPipelineState(opaquePsoDesc);
 
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC opaqueWireframePsoDesc = opaquePsoDesc;
 	opaqueWireframePsoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME;
-	ThrowIfFailed(md3dDevice->CreateGraphicsPipelineState(&opaqueWireframePsoDesc, IID_PPV_ARGS(&mPSOs["opaque_wireframe"])));
+	psos["opaque_wireframe"] = mPipelineCache.RequestGraphicsPipelineState(opaqueWireframePsoDesc, psos["opaque"]);
+
+	if (mDepthPrepassState)
+	{
+		// 깊이 프리패스 : 위치 스트림만 바인딩하고 픽셀 셰이더 없이 깊이만 쓴다.
+		// 렌더 타겟은 바인딩된 채로 두므로 형식은 같게 두고 쓰기만 막는다.
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC depthPsoDesc = opaquePsoDesc;
+		depthPsoDesc.InputLayout = SceneVertexLayout::GetDesc(1);
+		depthPsoDesc.VS =
+		{
+			reinterpret_cast<BYTE*>(mShaders["depthVS"]->GetBufferPointer()),
+			mShaders["depthVS"]->GetBufferSize()
+		};
+		depthPsoDesc.PS = { nullptr, 0 };
+		depthPsoDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = 0;
+		depthPsoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
+		psos["depth_prepass"] = mPipelineCache.RequestGraphicsPipelineState(depthPsoDesc);
+	}
+}
+
+// 게임 스레드 프레임 시작 : 셰이더 파일 변경 -> 작업 스레드에서 재컴파일 -> PSO 재요청 -> 모두 준비되면 교체
+void EditorApp::UpdateHotReload()
+{
+	// 셰이더 재컴파일이 끝났으면 새 바이트코드로 PSO를 요청한다. (바뀌지 않은 PSO는 같은 핸들이 나온다)
+	if (mShaderReloadJob.IsValid())
+	{
+		if (!mShaderReloadJob.IsDone())
+			return;
+
+		mJobSystem.Wait(mShaderReloadJob);	// 이미 끝났으므로 작업에서 난 예외만 다시 던진다.
+		mShaderReloadJob = JobCounter();
+
+		if (!mShaderReloadErrors.empty())
+			OutputDebugStringA(mShaderReloadErrors.c_str());
+
+		// 컴파일 에러면 이전 셰이더/PSO를 그대로 쓴다. (파일을 고치면 다시 시도)
+		if (mIsShaderReloadSucceeded)
+		{
+			UpdateShaderBlobs();
+			RequestPSOs(mPendingPSOs);
+		}
+		return;
+	}
+
+	// 새 PSO가 모두 준비되면 프레임 경계에서 한꺼번에 바꾼다. (뷰 버전의 PSO가 바뀌므로 뷰가 다시 그려진다)
+	if (!mPendingPSOs.empty())
+	{
+		bool isFailed = false;
+		for (const auto& pair : mPendingPSOs)
+		{
+			if (mPipelineCache.IsPending(pair.second))
+				return;
+			if (!mPipelineCache.IsReady(pair.second))
+				isFailed = true;
+		}
+
+		// 교체되지 않는 쪽(실패하면 새 PSO, 성공하면 이전 PSO) 중 다른 곳에서 쓰지 않는 것은 놓는다.
+		// 아직 그리지 않은 스냅샷이 이전 PSO를 들고 있으므로 렌더 스레드가 이번 스냅샷을 제출한 펜스 뒤에 놓는다.
+		if (isFailed)
+			OutputDebugStringA("Hot reload: pipeline creation failed, keeping previous pipelines\n");
+		else
+			std::swap(mPSOs, mPendingPSOs);
+
+		for (const auto& pair : mPendingPSOs)
+		{
+			bool isUsed = false;
+			for (const auto& current : mPSOs)
+				isUsed |= current.second.Index == pair.second.Index;
+			if (!isUsed)
+				mRetiredPSOs.push_back(pair.second);
+		}
+		mPendingPSOs.clear();
+		return;
+	}
+
+	std::vector<std::string> changedPaths;
+	if (!mShaderWatcher.PollChanges(changedPaths))
+		return;
+
+	for (const std::string& path : changedPaths)
+		OutputDebugStringA(("Hot reload: " + path + "\n").c_str());
+
+	// 파일 해시를 다시 계산하게 하고 요청한 변형을 모두 다시 컴파일 대상으로 돌린다.
+	// 의존 파일이 바뀌지 않은 변형은 캐시에서 바로 나오므로 바뀐 셰이더만 실제로 컴파일된다.
+	mShaderCache.InvalidateFileHashes();
+	mShaderPermutations.InvalidateAll();
+	mShaderReloadErrors.clear();
+
+	mShaderReloadJob = mJobSystem.Run([this]()
+	{
+		mIsShaderReloadSucceeded = mShaderPermutations.CompileRequested(
+			mShaderCache, mJobSystem, d3dUtil::GetShaderCompileFlags(), &mShaderReloadErrors);
+	});
+
+	// 작업자 스레드가 없으면 여기서 처리
+	if (mJobSystem.GetWorkerCount() == 0)
+		mJobSystem.Wait(mShaderReloadJob);
 }
 
 void EditorApp::BuildFrameResources()
@@ -660,7 +1554,8 @@ void EditorApp::BuildFrameResources()
 	for (int i = 0; i < gNumFrameResources; ++i)
 	{
 		mFrameResources.push_back(std::make_unique<FrameResource>(md3dDevice.Get(),
-			2, (UINT)mAllRitems.size()));
+			2, (UINT)mAllRitems.size(), &mGpuAllocator));
+		mRenderSnapshots.push_back(std::make_unique<RenderSnapshot>());
 	}
 }
 
@@ -672,9 +1567,8 @@ void EditorApp::BuildRenderItems()
 	boxRitem->ObjCBIndex = 0;
 	boxRitem->Geo = mGeometries["shapeGeo"].get();
 	boxRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-	boxRitem->IndexCount = boxRitem->Geo->DrawArgs["box"].IndexCount;
-	boxRitem->StartIndexLocation = boxRitem->Geo->DrawArgs["box"].StartIndexLocation;
-	boxRitem->BaseVertexLocation = boxRitem->Geo->DrawArgs["box"].BaseVertexLocation;
+	boxRitem->ArenaMesh = mArenaMeshes["box"];
+	boxRitem->Acmr = mArenaMeshAcmr["box"];
 	mAllRitems.push_back(std::move(boxRitem));
 
 	auto gridRitem = std::make_unique<RenderItem>();
@@ -683,9 +1577,8 @@ void EditorApp::BuildRenderItems()
 	gridRitem->ObjCBIndex = 1;
 	gridRitem->Geo = mGeometries["shapeGeo"].get();
 	gridRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-	gridRitem->IndexCount = gridRitem->Geo->DrawArgs["grid"].IndexCount;
-	gridRitem->StartIndexLocation = gridRitem->Geo->DrawArgs["grid"].StartIndexLocation;
-	gridRitem->BaseVertexLocation = gridRitem->Geo->DrawArgs["grid"].BaseVertexLocation;
+	gridRitem->ArenaMesh = mArenaMeshes["grid"];
+	gridRitem->Acmr = mArenaMeshAcmr["grid"];
 	mAllRitems.push_back(std::move(gridRitem));
 
 	UINT objCBIndex = 2;
@@ -707,36 +1600,32 @@ void EditorApp::BuildRenderItems()
 		leftCylRitem->ObjCBIndex = objCBIndex++;
 		leftCylRitem->Geo = mGeometries["shapeGeo"].get();
 		leftCylRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-		leftCylRitem->IndexCount = leftCylRitem->Geo->DrawArgs["cylinder"].IndexCount;
-		leftCylRitem->StartIndexLocation = leftCylRitem->Geo->DrawArgs["cylinder"].StartIndexLocation;
-		leftCylRitem->BaseVertexLocation = leftCylRitem->Geo->DrawArgs["cylinder"].BaseVertexLocation;
+		leftCylRitem->ArenaMesh = mArenaMeshes["cylinder"];
+		leftCylRitem->Acmr = mArenaMeshAcmr["cylinder"];
 
 		XMStoreFloat4x4(&rightCylRitem->World, rightCylWorld);
 		rightCylRitem->Name = "RightCylinder" + std::to_string(i);
 		rightCylRitem->ObjCBIndex = objCBIndex++;
 		rightCylRitem->Geo = mGeometries["shapeGeo"].get();
 		rightCylRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-		rightCylRitem->IndexCount = rightCylRitem->Geo->DrawArgs["cylinder"].IndexCount;
-		rightCylRitem->StartIndexLocation = rightCylRitem->Geo->DrawArgs["cylinder"].StartIndexLocation;
-		rightCylRitem->BaseVertexLocation = rightCylRitem->Geo->DrawArgs["cylinder"].BaseVertexLocation;
+		rightCylRitem->ArenaMesh = mArenaMeshes["cylinder"];
+		rightCylRitem->Acmr = mArenaMeshAcmr["cylinder"];
 
 		XMStoreFloat4x4(&leftSphereRitem->World, leftSphereWorld);
 		leftSphereRitem->Name = "LeftSphere" + std::to_string(i);
 		leftSphereRitem->ObjCBIndex = objCBIndex++;
 		leftSphereRitem->Geo = mGeometries["shapeGeo"].get();
 		leftSphereRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-		leftSphereRitem->IndexCount = leftSphereRitem->Geo->DrawArgs["sphere"].IndexCount;
-		leftSphereRitem->StartIndexLocation = leftSphereRitem->Geo->DrawArgs["sphere"].StartIndexLocation;
-		leftSphereRitem->BaseVertexLocation = leftSphereRitem->Geo->DrawArgs["sphere"].BaseVertexLocation;
+		leftSphereRitem->ArenaMesh = mArenaMeshes["sphere"];
+		leftSphereRitem->Acmr = mArenaMeshAcmr["sphere"];
 
 		XMStoreFloat4x4(&rightSphereRitem->World, rightSphereWorld);
 		rightSphereRitem->Name = "RightSphere" + std::to_string(i);
 		rightSphereRitem->ObjCBIndex = objCBIndex++;
 		rightSphereRitem->Geo = mGeometries["shapeGeo"].get();
 		rightSphereRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-		rightSphereRitem->IndexCount = rightSphereRitem->Geo->DrawArgs["sphere"].IndexCount;
-		rightSphereRitem->StartIndexLocation = rightSphereRitem->Geo->DrawArgs["sphere"].StartIndexLocation;
-		rightSphereRitem->BaseVertexLocation = rightSphereRitem->Geo->DrawArgs["sphere"].BaseVertexLocation;
+		rightSphereRitem->ArenaMesh = mArenaMeshes["sphere"];
+		rightSphereRitem->Acmr = mArenaMeshAcmr["sphere"];
 
 		mAllRitems.push_back(std::move(leftCylRitem));
 		mAllRitems.push_back(std::move(rightCylRitem));
@@ -748,218 +1637,295 @@ void EditorApp::BuildRenderItems()
 		mOpaqueRitems.push_back(e.get());
 }
 
-// Scene Heap 
-void EditorApp::SceneHeapsInit()
-{
-	// ؽó 
-	D3D12_RESOURCE_DESC texDesc = {};
-	texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	texDesc.Width = mClientWidth;
-	texDesc.Height = mClientHeight;
-	texDesc.DepthOrArraySize = 1;
-	texDesc.MipLevels = 1;
-	texDesc.Format = mBackBufferFormat;
-	texDesc.SampleDesc.Count = 1;
-	texDesc.SampleDesc.Quality = 0;
-	texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-	texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-	D3D12_CLEAR_VALUE clearValue = {};
-	clearValue.Format = texDesc.Format;
-	clearValue.Color[0] = 0.0f;
-	clearValue.Color[1] = 0.0f;
-	clearValue.Color[2] = 0.0f;
-	clearValue.Color[3] = 1.0f;
-
-	CD3DX12_HEAP_PROPERTIES HeapProp(D3D12_HEAP_TYPE_DEFAULT);
-	ThrowIfFailed(md3dDevice->CreateCommittedResource(
-		&HeapProp,
-		D3D12_HEAP_FLAG_NONE,
-		&texDesc,
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		&clearValue,
-		IID_PPV_ARGS(&mSceneTexture)
-	));
-
-	// RTV 
-	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-	rtvHeapDesc.NumDescriptors = 1;
-	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&mSceneRtvHeap)));
-
-	mSceneRTV = mSceneRtvHeap->GetCPUDescriptorHandleForHeapStart();
-	md3dDevice->CreateRenderTargetView(mSceneTexture.Get(), nullptr, mSceneRTV);
-
-	// ImGui SRV Heap
-	D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-	srvHeapDesc.NumDescriptors = 1;
-	srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&mSceneSRVHeap)));
-
-	// SRV 
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.Format = texDesc.Format;
-	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MipLevels = 1;
-
-	md3dDevice->CreateShaderResourceView(mSceneTexture.Get(), &srvDesc, mSceneSRVHeap->GetCPUDescriptorHandleForHeapStart());
-}
-
-// Game Heap 
-void EditorApp::GameHeapsInit()
-{
-	// ؽó 
-	D3D12_RESOURCE_DESC texDesc = {};
-	texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	texDesc.Width = mClientWidth;
-	texDesc.Height = mClientHeight;
-	texDesc.DepthOrArraySize = 1;
-	texDesc.MipLevels = 1;
-	texDesc.Format = mBackBufferFormat;
-	texDesc.SampleDesc.Count = 1;
-	texDesc.SampleDesc.Quality = 0;
-	texDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-	texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-	D3D12_CLEAR_VALUE clearValue = {};
-	clearValue.Format = texDesc.Format;
-	clearValue.Color[0] = 0.0f;
-	clearValue.Color[1] = 0.0f;
-	clearValue.Color[2] = 0.0f;
-	clearValue.Color[3] = 1.0f;
-
-	CD3DX12_HEAP_PROPERTIES HeapProp(D3D12_HEAP_TYPE_DEFAULT);
-	ThrowIfFailed(md3dDevice->CreateCommittedResource(
-		&HeapProp,
-		D3D12_HEAP_FLAG_NONE,
-		&texDesc,
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		&clearValue,
-		IID_PPV_ARGS(&mGameTexture)
-	));
-
-	// RTV 
-	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-	rtvHeapDesc.NumDescriptors = 1;
-	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&mGameRtvHeap)));
-
-	mGameRTV = mGameRtvHeap->GetCPUDescriptorHandleForHeapStart();
-	md3dDevice->CreateRenderTargetView(mGameTexture.Get(), nullptr, mGameRTV);
-
-	// ImGui SRV Heap
-	D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-	srvHeapDesc.NumDescriptors = 1;
-	srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	ThrowIfFailed(md3dDevice->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&mGameSRVHeap)));
-
-	// SRV 
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.Format = texDesc.Format;
-	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MipLevels = 1;
-
-	md3dDevice->CreateShaderResourceView(mGameTexture.Get(), &srvDesc, mGameSRVHeap->GetCPUDescriptorHandleForHeapStart());
-}
-
-// Scene 
-void EditorApp::DrawSceneView()
-{
-	CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		mSceneTexture.Get(),
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-		D3D12_RESOURCE_STATE_RENDER_TARGET
-	);
-	mCommandList->ResourceBarrier(1, &barrier);
+// 게임 스레드 : UI가 패널 크기를 알려주면 그 크기에 맞는 렌더 타겟을 준비해서 돌려준다.
+ViewImage EditorApp::PrepareView(EditorView view, UINT panelWidth, UINT panelHeight)
+{
+	ViewState& state = mViews[(int)view];
+	state.PanelWidth = std::max<UINT>(panelWidth, 1);
+	state.PanelHeight = std::max<UINT>(panelHeight, 1);
+	state.IsVisible = true;
+
+	UpdateViewTarget(view);
+
+	ViewImage image;
+	image.SRV = state.Target->SRV.GPU;
+	image.U = (float)state.RenderWidth / state.Target->Width;
+	image.V = (float)state.RenderHeight / state.Target->Height;
+	return image;
+}
+
+void EditorApp::UpdateViewTarget(EditorView view)
+{
+	ViewState& state = mViews[(int)view];
+
+	// 렌더 해상도 = 패널 크기 * 동적 해상도 배율
+	const float scale = GetViewScale();
+	const UINT prevWidth = state.RenderWidth;
+	const UINT prevHeight = state.RenderHeight;
+	state.RenderWidth = std::max<UINT>(1, (UINT)(state.PanelWidth * scale + 0.5f));
+	state.RenderHeight = std::max<UINT>(1, (UINT)(state.PanelHeight * scale + 0.5f));
+
+	if (state.RenderWidth != prevWidth || state.RenderHeight != prevHeight)
+		++state.SettingsVersion;
+
+	// 지금 타겟에 안 들어가거나 면적이 너무 많이 남으면 다른 타겟으로 바꾼다. (풀이 빌려줄 때와 같은 기준)
+	// (배율 0.5~1.0 사이의 변화는 같은 타겟 안에서 뷰포트만 바뀐다)
+	PooledRenderTarget* target = state.Target;
+	if (target == nullptr || !mRenderTargetPool.IsFit(*target, state.RenderWidth, state.RenderHeight))
+	{
+		// 이전 타겟은 이번 스냅샷부터 안 쓰므로, 이 스냅샷이 GPU에서 끝난 뒤에 다시 빌려준다.
+		mRenderTargetPool.Release(target, mFrameSerial);
+		state.Target = mRenderTargetPool.Acquire(state.RenderWidth, state.RenderHeight, mBackBufferFormat);
+		++state.SettingsVersion;
+	}
+
+	// 종횡비는 패널 기준 (바뀔 때만 다시 설정해야 카메라 버전이 매 프레임 오르지 않는다)
+	Camera& camera = (view == EditorView::Scene) ? mSceneCamera : mGameCamera;
+	const float aspect = (float)state.PanelWidth / state.PanelHeight;
+	if (camera.GetAspect() != aspect)
+		camera.SetLens(0.25f * MathHelper::Pi, aspect, 1.0f, 1000.0f);
+}
+
+ViewVersion EditorApp::GetViewVersion(EditorView view)const
+{
+	const Camera& camera = (view == EditorView::Scene) ? mSceneCamera : mGameCamera;
+
+	ViewVersion version;
+	version.Camera = camera.GetVersion();
+	version.Scene = mSceneVersion;
+	version.Settings = mViews[(int)view].SettingsVersion;
+	version.Pipeline = mPipelineCache.Resolve(GetViewPipeline(view));
+
+	// 와이어프레임은 프리패스 깊이에 선이 가려지므로 프리패스를 쓰지 않는다.
+	const bool isWireframe = view == EditorView::Scene && mIsWireframe;
+	if (mDepthPrepassState && !isWireframe)
+		version.DepthPipeline = mPipelineCache.Resolve(mPSOs.at("depth_prepass"));
+	return version;
+}
+
+PipelineHandle EditorApp::GetViewPipeline(EditorView view)const
+{
+	// 와이어프레임은 Scene뷰에만 적용된다.
+	if (view == EditorView::Scene && mIsWireframe)
+		return mPSOs.at("opaque_wireframe");
+	return mPSOs.at("opaque");
+}
+
+// 이번 프레임의 패스와 리소스 선언
+void EditorApp::BuildFrameGraph(RenderSnapshot& snapshot)
+{
+	mFrameGraph.Reset();
+
+	// Scene/Game 텍스처는 ImGui가 읽는 PIXEL_SHADER_RESOURCE 상태로 프레임을 시작하고 끝낸다.
+	RGHandle sceneColor = mFrameGraph.ImportTexture("SceneColor", RGState::PixelShaderResource, RGState::PixelShaderResource);
+	RGHandle gameColor = mFrameGraph.ImportTexture("GameColor", RGState::PixelShaderResource, RGState::PixelShaderResource);
+	RGHandle backBuffer = mFrameGraph.ImportTexture("BackBuffer", RGState::Present, RGState::Present);
+
+	// 뷰마다 깊이 버퍼를 따로 쓰지만 수명이 겹치지 않으므로 같은 메모리에 앨리어싱된다.
+	// 깊이 버퍼는 렌더 타겟과 같은 버킷 크기라서 동적 해상도가 바뀌어도 다시 만들지 않는다.
+	const ViewRenderInfo& sceneInfo = snapshot.Views[(int)EditorView::Scene];
+	const ViewRenderInfo& gameInfo = snapshot.Views[(int)EditorView::Game];
+
+	RGTextureDesc depthDesc;
+	depthDesc.Format = mDepthStencilFormat;
+	depthDesc.IsDepthStencil = true;
+
+	// 다시 그릴 필요가 없는 뷰는 패스를 넣지 않는다. (ImGui는 지난번에 그린 텍스처를 그대로 읽는다)
+	if (sceneInfo.ShouldRender)
+	{
+		depthDesc.Width = sceneInfo.TargetWidth;
+		depthDesc.Height = sceneInfo.TargetHeight;
+		RGHandle sceneDepth = mFrameGraph.CreateTexture("SceneDepth", depthDesc);
+
+		// Scene View
+		mFrameGraph.AddPass("Scene", [this, &snapshot, sceneColor, sceneDepth](RenderGraphContext& ctx)
+		{
+			DrawSceneView(snapshot, ctx.GetRTV(sceneColor), ctx.GetDSV(sceneDepth));
+		})
+			.Write(sceneColor, RGState::RenderTarget)
+			.Write(sceneDepth, RGState::DepthWrite);
+	}
 
-	D3D12_CPU_DESCRIPTOR_HANDLE DepthSV = DepthStencilView();
-	mCommandList->OMSetRenderTargets(1, &mSceneRTV, true, &DepthSV);
-	mCommandList->ClearRenderTargetView(mSceneRTV, Colors::LightSteelBlue, 0, nullptr);
-	mCommandList->ClearDepthStencilView(DepthStencilView(),
+	if (gameInfo.ShouldRender)
+	{
+		depthDesc.Width = gameInfo.TargetWidth;
+		depthDesc.Height = gameInfo.TargetHeight;
+		RGHandle gameDepth = mFrameGraph.CreateTexture("GameDepth", depthDesc);
+
+		// Game View
+		mFrameGraph.AddPass("Game", [this, &snapshot, gameColor, gameDepth](RenderGraphContext& ctx)
+		{
+			DrawGameView(snapshot, ctx.GetRTV(gameColor), ctx.GetDSV(gameDepth));
+		})
+			.Write(gameColor, RGState::RenderTarget)
+			.Write(gameDepth, RGState::DepthWrite);
+	}
+
+	// 에디터 UI (Scene/Game 텍스처를 읽어서 백버퍼에 그린다)
+	mFrameGraph.AddPass("ImGui", [this, &snapshot, backBuffer](RenderGraphContext& ctx)
+	{
+		D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = ctx.GetRTV(backBuffer);
+		ctx.CommandList->ClearRenderTargetView(rtvHandle, Colors::LightSteelBlue, 0, nullptr);
+		ctx.CommandList->OMSetRenderTargets(1, &rtvHandle, true, nullptr);
+
+		mEditorUI.Render(ctx.CommandList, snapshot.UI);
+	})
+		.Read(sceneColor, RGState::PixelShaderResource)
+		.Read(gameColor, RGState::PixelShaderResource)
+		.Write(backBuffer, RGState::RenderTarget)
+		.SideEffect();
+
+	mGraphExecutor.BindImported(sceneColor, sceneInfo.Texture, sceneInfo.RTV);
+	mGraphExecutor.BindImported(gameColor, gameInfo.Texture, gameInfo.RTV);
+	mGraphExecutor.BindImported(backBuffer, CurrentBackBuffer(), CurrentBackBufferView());
+}
+
+// Scene뷰 생성
+void EditorApp::DrawSceneView(const RenderSnapshot& snapshot, D3D12_CPU_DESCRIPTOR_HANDLE rtv, D3D12_CPU_DESCRIPTOR_HANDLE dsv)
+{
+	// 렌더 타겟 중 렌더 해상도 영역에만 그린다.
+	const ViewRenderInfo& info = snapshot.Views[(int)EditorView::Scene];
+	D3D12_VIEWPORT viewport = { 0.0f, 0.0f, (float)info.Width, (float)info.Height, 0.0f, 1.0f };
+	D3D12_RECT scissorRect = { 0, 0, (LONG)info.Width, (LONG)info.Height };
+	mCommandList->RSSetViewports(1, &viewport);
+	mCommandList->RSSetScissorRects(1, &scissorRect);
+
+	mCommandList->OMSetRenderTargets(1, &rtv, true, &dsv);
+	mCommandList->ClearRenderTargetView(rtv, Colors::LightSteelBlue, 0, nullptr);
+	mCommandList->ClearDepthStencilView(dsv,
 		D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
 
-	// 
-	ID3D12DescriptorHeap* descriptorHeaps[] = { mCbvHeap.Get() };
-	mCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+	// 렌더링 (디스크립터 힙은 Draw 시작 시 한 번만 설정)
 	mCommandList->SetGraphicsRootSignature(mRootSignature.Get());
 
-	int passCbvIndex = mPassCbvOffset + mCurrFrameResourceIndex * 2;
-	auto passCbvHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(mCbvHeap->GetGPUDescriptorHandleForHeapStart());
-	passCbvHandle.Offset(passCbvIndex, mCbvSrvUavDescriptorSize);
-	mCommandList->SetGraphicsRootDescriptorTable(1, passCbvHandle);
+	// 이번 프레임의 Pass CBV를 링 영역으로 복사
+	UINT passCbvIndex = mCurrFrameResourceIndex * 2;
+	DescriptorHandle passCbv = mDescriptorHeap.CopyToTransient(mPassCbvs.Offset(passCbvIndex, mStagingHeap.GetDescriptorSize()).CPU);
+	mCommandList->SetGraphicsRootDescriptorTable(1, passCbv.GPU);
 
-	DrawRenderItems(mCommandList.Get(), mOpaqueRitems);
+	// 아직 쓸 수 있는 PSO가 없으면 지우기만 한다. (준비되면 뷰 버전이 바뀌어서 다시 그린다)
+	if (info.Pipeline == nullptr)
+		return;
 
-	// RTV  SRV  ȯ
-	barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		mSceneTexture.Get(),
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
-	);
-	mCommandList->ResourceBarrier(1, &barrier);
+	// 깊이 프리패스 : 위치 스트림만 읽어서 깊이를 먼저 채우면 색 패스는 가려진 픽셀을 셰이딩하지 않는다.
+	if (info.DepthPipeline != nullptr)
+	{
+		mCommandList->SetPipelineState(info.DepthPipeline);
+		DrawRenderItems(mCommandList.Get(), snapshot.OpaqueItems, 1);
+	}
+
+	mCommandList->SetPipelineState(info.Pipeline);
+	DrawRenderItems(mCommandList.Get(), snapshot.OpaqueItems, SceneVertexLayout::StreamCount);
 }
 
-void EditorApp::DrawGameView()
+void EditorApp::DrawGameView(const RenderSnapshot& snapshot, D3D12_CPU_DESCRIPTOR_HANDLE rtv, D3D12_CPU_DESCRIPTOR_HANDLE dsv)
 {
-	CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		mGameTexture.Get(),
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-		D3D12_RESOURCE_STATE_RENDER_TARGET
-	);
-	mCommandList->ResourceBarrier(1, &barrier);
-
-	D3D12_CPU_DESCRIPTOR_HANDLE DepthSV = DepthStencilView();
-	mCommandList->OMSetRenderTargets(1, &mGameRTV, true, &DepthSV);
-	mCommandList->ClearRenderTargetView(mGameRTV, Colors::LightSteelBlue, 0, nullptr);
-	mCommandList->ClearDepthStencilView(DepthStencilView(),
+	// 렌더 타겟 중 렌더 해상도 영역에만 그린다.
+	const ViewRenderInfo& info = snapshot.Views[(int)EditorView::Game];
+	D3D12_VIEWPORT viewport = { 0.0f, 0.0f, (float)info.Width, (float)info.Height, 0.0f, 1.0f };
+	D3D12_RECT scissorRect = { 0, 0, (LONG)info.Width, (LONG)info.Height };
+	mCommandList->RSSetViewports(1, &viewport);
+	mCommandList->RSSetScissorRects(1, &scissorRect);
+
+	mCommandList->OMSetRenderTargets(1, &rtv, true, &dsv);
+	mCommandList->ClearRenderTargetView(rtv, Colors::LightSteelBlue, 0, nullptr);
+	mCommandList->ClearDepthStencilView(dsv,
 		D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
 
-	// 
-	ID3D12DescriptorHeap* descriptorHeaps[] = { mCbvHeap.Get() };
-	mCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+	// 렌더링 (디스크립터 힙은 Draw 시작 시 한 번만 설정)
 	mCommandList->SetGraphicsRootSignature(mRootSignature.Get());
 
-	int passCbvIndex = mPassCbvOffset + mCurrFrameResourceIndex * 2 + 1;
-	auto passCbvHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(mCbvHeap->GetGPUDescriptorHandleForHeapStart());
-	passCbvHandle.Offset(passCbvIndex, mCbvSrvUavDescriptorSize);
-	mCommandList->SetGraphicsRootDescriptorTable(1, passCbvHandle);
+	// 이번 프레임의 Pass CBV를 링 영역으로 복사
+	UINT passCbvIndex = mCurrFrameResourceIndex * 2 + 1;
+	DescriptorHandle passCbv = mDescriptorHeap.CopyToTransient(mPassCbvs.Offset(passCbvIndex, mStagingHeap.GetDescriptorSize()).CPU);
+	mCommandList->SetGraphicsRootDescriptorTable(1, passCbv.GPU);
 
-	DrawRenderItems(mCommandList.Get(), mOpaqueRitems);
+	// 아직 쓸 수 있는 PSO가 없으면 지우기만 한다. (준비되면 뷰 버전이 바뀌어서 다시 그린다)
+	if (info.Pipeline == nullptr)
+		return;
 
-	// RTV  SRV  ȯ
-	barrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		mGameTexture.Get(),
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
-	);
-	mCommandList->ResourceBarrier(1, &barrier);
+	// 깊이 프리패스 : 위치 스트림만 읽어서 깊이를 먼저 채우면 색 패스는 가려진 픽셀을 셰이딩하지 않는다.
+	if (info.DepthPipeline != nullptr)
+	{
+		mCommandList->SetPipelineState(info.DepthPipeline);
+		DrawRenderItems(mCommandList.Get(), snapshot.OpaqueItems, 1);
+	}
+
+	mCommandList->SetPipelineState(info.Pipeline);
+	DrawRenderItems(mCommandList.Get(), snapshot.OpaqueItems, SceneVertexLayout::StreamCount);
 }
 
-void EditorApp::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vector<RenderItem*>& ritems)
+void EditorApp::DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vector<RenderItemSnapshot>& ritems, UINT streamCount)
 {
 	UINT objCBByteSize = d3dUtil::CalcConstantBufferByteSize(sizeof(ObjectConstants));
 
 	auto objectCB = mCurrFrameResource->ObjectCB->Resource();
 
+	// 아레나에 있는 메시는 모두 같은 버퍼라서 버퍼/형식/토폴로지가 바뀔 때만 IA를 다시 설정한다.
+	const void* boundBuffers = nullptr;
+	DXGI_FORMAT boundIndexFormat = DXGI_FORMAT_UNKNOWN;
+	D3D12_PRIMITIVE_TOPOLOGY boundTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	UINT boundStreams = 0;
+
 	for (size_t i = 0; i < ritems.size(); ++i)
 	{
-		auto ri = ritems[i];
+		const auto* ri = &ritems[i];
+
+		const void* buffers = ri->Arena != nullptr ? static_cast<const void*>(ri->Arena) : static_cast<const void*>(ri->Geo);
+		if (buffers != boundBuffers || ri->IndexFormat != boundIndexFormat)
+		{
+			D3D12_VERTEX_BUFFER_VIEW vbvs[MeshGeometry::MaxVertexStreams];
+			D3D12_INDEX_BUFFER_VIEW ibv;
+			if (ri->Arena != nullptr)
+			{
+				boundStreams = ri->Arena->VertexBufferViews(vbvs, streamCount);
+				ibv = ri->Arena->IndexBufferView(ri->IndexFormat);
+			}
+			else
+			{
+				boundStreams = ri->Geo->VertexBufferViews(vbvs, streamCount);
+				ibv = ri->Geo->IndexBufferView(ri->IndexFormat);
+			}
+			cmdList->IASetVertexBuffers(0, boundStreams, vbvs);
+			cmdList->IASetIndexBuffer(&ibv);
+
+			boundBuffers = buffers;
+			boundIndexFormat = ri->IndexFormat;
+			++mVertexFetchStats.InputBindings;
+		}
+		++mVertexFetchStats.Draws;
+
+		if (ri->PrimitiveType != boundTopology)
+		{
+			cmdList->IASetPrimitiveTopology(ri->PrimitiveType);
+			boundTopology = ri->PrimitiveType;
+		}
 
-		auto vbv = ri->Geo->VertexBufferView();
-		cmdList->IASetVertexBuffers(0, 1, &vbv);
-		auto ibv = ri->Geo->IndexBufferView();
-		cmdList->IASetIndexBuffer(&ibv);
-		cmdList->IASetPrimitiveTopology(ri->PrimitiveType);
+		// 캐시에 적중한 인덱스는 정점을 다시 읽지 않는다.
+		const UINT64 fetchedVertices = (UINT64)(ri->IndexCount / 3 * ri->Acmr + 0.5f);
+		const UINT totalStreams = ri->Arena != nullptr ? ri->Arena->GetStreamCount() : ri->Geo->GetVertexStreamCount();
+		UINT64 fetchedBytes = 0;
+		UINT64 interleavedBytes = 0;
+		for (UINT stream = 0; stream < totalStreams; ++stream)
+		{
+			const UINT stride = ri->Arena != nullptr ? ri->Arena->GetStreamStride(stream) : ri->Geo->VertexStreams[stream].ByteStride;
+			const UINT64 streamBytes = fetchedVertices * stride;
+			interleavedBytes += streamBytes;
+			if (stream < boundStreams)
+				fetchedBytes += streamBytes;
+		}
+		if (streamCount < SceneVertexLayout::StreamCount)
+		{
+			mVertexFetchStats.DepthBytes += fetchedBytes;
+			mVertexFetchStats.DepthInterleavedBytes += interleavedBytes;
+		}
+		else
+		{
+			mVertexFetchStats.ColorBytes += fetchedBytes;
+		}
 
 		UINT cbvIndex = mCurrFrameResourceIndex * (UINT)mOpaqueRitems.size() + ri->ObjCBIndex;
-		auto cbvHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(mCbvHeap->GetGPUDescriptorHandleForHeapStart());
-		cbvHandle.Offset(cbvIndex, mCbvSrvUavDescriptorSize);
+		auto cbvHandle = mObjectCbvs.Offset(cbvIndex, mCbvSrvUavDescriptorSize).GPU;
 
 		cmdList->SetGraphicsRootDescriptorTable(0, cbvHandle);
 
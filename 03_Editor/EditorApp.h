@@ -5,6 +5,22 @@
 #include "../02_Engine/GeometryGenerator.h"
 #include "../02_Engine/FrameResource.h"
 #include "../02_Engine/Camera.h"
+#include "../02_Engine/RenderGraphExecutor.h"
+#include "../02_Engine/DescriptorHeap.h"
+#include "../02_Engine/RenderTargetPool.h"
+#include "../02_Engine/DynamicResolution.h"
+#include "../02_Engine/GpuFrameTimer.h"
+#include "../02_Engine/MeshLoader.h"
+#include "../02_Engine/MeshImporter.h"
+#include "../02_Engine/MeshOptimizer.h"
+#include "../02_Engine/MeshletBuilder.h"
+#include "../02_Engine/IndexBufferBuilder.h"
+#include "../02_Engine/GeometryArena.h"
+#include "../02_Engine/ProceduralMeshCache.h"
+#include "../01_Core/IndexCodec.h"
+#include "../01_Core/Hasher.h"
+#include "../01_Core/ShaderPermutation.h"
+#include "../01_Core/FileWatcher.h"
 
 #include "IMGUI/imgui_impl_win32.h"
 
@@ -35,6 +51,168 @@ struct RenderItem
     UINT IndexCount = 0;
     UINT StartIndexLocation = 0;
     int BaseVertexLocation = 0;
+    DXGI_FORMAT IndexFormat = DXGI_FORMAT_UNKNOWN;     // 서브메시 인덱스 형식 (UNKNOWN이면 Geo->IndexFormat)
+    float Acmr = 3.0f;                                 // 삼각형당 정점 셰이더 실행 수 (FIFO 정점 캐시 모델, 모르면 3 = 캐시 적중 없음)
+
+    GeometryArena::Handle ArenaMesh = GeometryArena::InvalidHandle;    // 아레나 구간 (있으면 그릴 구간을 프레임마다 아레나에서 읽는다)
+};
+
+// 렌더 스레드로 넘겨줄 RenderItem 정보
+struct RenderItemSnapshot
+{
+    ObjectConstants ObjConstants;   // 전치된 World 행렬
+    bool IsDirty = false;           // 이 슬롯의 ObjectCB를 갱신해야 하는지 여부
+
+    UINT ObjCBIndex = 0;
+
+    MeshGeometry* Geo = nullptr;
+    const GeometryArena* Arena = nullptr;   // 있으면 Geo 버퍼 대신 아레나 버퍼로 그린다.
+
+    D3D12_PRIMITIVE_TOPOLOGY PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+
+    UINT IndexCount = 0;
+    UINT StartIndexLocation = 0;
+    int BaseVertexLocation = 0;
+    DXGI_FORMAT IndexFormat = DXGI_FORMAT_UNKNOWN;     // 서브메시 인덱스 형식 (UNKNOWN이면 Geo->IndexFormat)
+    float Acmr = 3.0f;                                 // RenderItem::Acmr
+};
+
+// 에디터 뷰 (패널마다 따로 렌더 타겟을 가진다)
+enum class EditorView
+{
+    Scene,
+    Game,
+    Count
+};
+
+// 뷰 하나의 이번 프레임 렌더 정보
+struct ViewRenderInfo
+{
+    ID3D12Resource* Texture = nullptr;          // 풀에서 빌린 렌더 타겟
+    D3D12_CPU_DESCRIPTOR_HANDLE RTV = {};
+    UINT TargetWidth = 0;                       // 텍스처 크기 (버킷 단위)
+    UINT TargetHeight = 0;
+    UINT Width = 0;                             // 실제로 그리는 영역 (패널 크기 * 동적 해상도 배율)
+    UINT Height = 0;
+    bool ShouldRender = true;                   // false면 다시 그리지 않고 이전 텍스처를 그대로 보여준다.
+    ID3D12PipelineState* Pipeline = nullptr;    // 그릴 때 쓸 PSO (컴파일 중이면 대체 PSO, 없으면 지우기만 한다)
+    ID3D12PipelineState* DepthPipeline = nullptr;   // 깊이 프리패스 PSO (없으면 프리패스를 건너뛴다)
+};
+
+// 뷰 내용을 결정하는 상태들의 버전 (하나라도 바뀌면 다시 그린다)
+struct ViewVersion
+{
+    UINT64 Camera = 0;      // 카메라 View/Proj
+    UINT64 Scene = 0;       // 씬 편집 카운터 (오브젝트 Transform 등)
+    UINT64 Settings = 0;    // 렌더 타겟, 해상도, 표시 옵션
+    ID3D12PipelineState* Pipeline = nullptr;    // 대체 PSO로 그렸으면 진짜가 준비될 때 다시 그린다.
+    ID3D12PipelineState* DepthPipeline = nullptr;
+
+    bool operator==(const ViewVersion& rhs)const
+    {
+        return Camera == rhs.Camera && Scene == rhs.Scene && Settings == rhs.Settings &&
+            Pipeline == rhs.Pipeline && DepthPipeline == rhs.DepthPipeline;
+    }
+    bool operator!=(const ViewVersion& rhs)const { return !(*this == rhs); }
+};
+
+// 입력 어셈블러가 읽은 정점 바이트 추정 (삼각형 수 * ACMR * 바인딩한 스트림 stride)
+// 정점 캐시 적중은 다시 읽지 않으므로 정점 셰이더 실행 수만큼 읽는다고 본다. (GPU 캐시 대신 FIFO 모델로 센 값)
+struct VertexFetchStats
+{
+    UINT64 DepthBytes = 0;              // 깊이 프리패스 (스트림 0만)
+    UINT64 DepthInterleavedBytes = 0;   // 같은 draw를 모든 스트림으로 읽었다면
+    UINT64 ColorBytes = 0;              // 색 패스 (모든 스트림)
+
+    UINT64 Draws = 0;
+    UINT64 InputBindings = 0;           // IASetVertexBuffers/IASetIndexBuffer를 다시 설정한 draw 수 (같은 버퍼가 이어지면 건너뛴다)
+};
+
+// 정점 데이터가 업로드 스테이징에 닿기까지 CPU에서 정점 배열 전체를 다시 쓴 횟수
+// 생성 -> 스테이징에 바로 쓰면 정점마다 1, MeshData를 거치면 생성 / fetch 순서 / 스트림 분리 / 스테이징 복사로 4
+struct VertexCopyCounter
+{
+    UINT64 VertexWrites = 0;            // 복사 단계마다 그 단계가 쓴 정점 수를 더한다.
+    UINT64 Vertices = 0;                // 최종 정점 수
+
+    void AddCopy(UINT64 vertexCount) { VertexWrites += vertexCount; }
+    double GetCopiesPerVertex()const { return Vertices > 0 ? (double)VertexWrites / Vertices : 0.0; }
+};
+
+// GeometryGenerator 싱크 : 씬 정점 스트림 (양자화 위치 / 색)으로 바꿔서 GeometryArena::AllocateMapped의 스테이징 자리에 바로 쓴다.
+// ProceduralMesh를 넘기면 캐시할 메시에 쓰고, 둘 다 없으면 자체 버퍼에 쓴다. (벤치마크용)
+// 인덱스도 메시/자체 버퍼의 32비트 인덱스 자리에 바로 쓰고 Finish에서 그 자리에서 정점 캐시 순서로 바꾼다.
+// 아레나 스테이징은 write-combined라 다시 읽으면 느리므로 아레나에 쓸 때만 자체 버퍼에서 최적화한 뒤 정점 수에 맞는 크기(16/32비트)로 옮긴다.
+// 스테이징은 다음 업로드 기록 전에 채워야 하므로 생성 -> Finish를 이어서 부른다.
+class SceneVertexSink
+{
+public:
+    SceneVertexSink(GeometryArena* arena, const XMFLOAT3& positionScale, const XMFLOAT3& positionOffset, const XMFLOAT4& color, VertexCopyCounter* counter = nullptr);
+    SceneVertexSink(ProceduralMesh* mesh, const XMFLOAT3& positionScale, const XMFLOAT3& positionOffset, const XMFLOAT4& color, VertexCopyCounter* counter = nullptr);
+
+    void Begin(std::uint32_t vertexCount, std::uint32_t indexCount);
+    void WriteVertex(std::uint32_t i, const GeometryGenerator::Vertex& vertex)
+    {
+        mPositions[i].Pos = VertexQuantizer::EncodePosition(vertex.Position, mPositionScale, mPositionOffset);
+        mColors[i].Color = mColor;
+    }
+    void WriteIndex(std::uint32_t i, std::uint32_t index) { mIndices[i] = index; }
+
+    // 삼각형 순서를 정점 캐시에 맞게 바꿔서 인덱스 자리에 쓴다. 아레나 핸들을 돌려준다. (arena가 없으면 InvalidHandle)
+    GeometryArena::Handle Finish();
+
+    UINT GetVertexCount()const { return mVertexCount; }
+    const MeshOptimizer::CacheStats& GetCacheBefore()const { return mCacheBefore; }
+    const MeshOptimizer::CacheStats& GetCacheAfter()const { return mCacheAfter; }
+
+private:
+    GeometryArena* mArena = nullptr;
+    ProceduralMesh* mMesh = nullptr;
+    XMFLOAT3 mPositionScale;
+    XMFLOAT3 mPositionOffset;
+    XMUBYTEN4 mColor;
+    VertexCopyCounter* mCounter = nullptr;
+
+    GeometryArena::Handle mHandle = GeometryArena::InvalidHandle;
+    UINT mVertexCount = 0;
+    VertexPosition* mPositions = nullptr;
+    VertexColor* mColors = nullptr;
+    void* mIndexData = nullptr;
+    UINT mIndexStride = 4;
+    std::uint32_t* mIndices = nullptr;      // WriteIndex가 쓰는 32비트 인덱스 (아레나가 아니면 mIndexData와 같다)
+    UINT mIndexCount = 0;
+
+    // arena/mesh가 없을 때 쓰는 곳 (인덱스는 아레나의 최적화 작업 공간으로도 쓴다)
+    std::vector<VertexPosition> mOwnedPositions;
+    std::vector<VertexColor> mOwnedColors;
+    std::vector<std::uint32_t> mOwnedIndices;
+
+    MeshOptimizer::CacheStats mCacheBefore;
+    MeshOptimizer::CacheStats mCacheAfter;
+};
+
+// UI에서 뷰 텍스처를 그릴 때 필요한 정보
+struct ViewImage
+{
+    D3D12_GPU_DESCRIPTOR_HANDLE SRV = {};
+    float U = 1.0f;     // 텍스처 중 그려진 영역의 비율
+    float V = 1.0f;
+};
+
+// 게임 스레드가 만든 불변 프레임 스냅샷
+// 렌더 스레드는 게임 상태 대신 이 스냅샷만 읽어서 커맨드를 기록한다.
+struct RenderSnapshot
+{
+    std::vector<RenderItemSnapshot> OpaqueItems;    // Transform, Draw 리스트
+
+    PassConstants ScenePassCB;  // Scene뷰 카메라
+    PassConstants GamePassCB;   // Game뷰 카메라
+
+    ViewRenderInfo Views[(int)EditorView::Count];   // Scene/Game 렌더 타겟
+
+    EditorUISnapshot UI;        // ImGui DrawData 복사본
+
+    std::vector<PipelineHandle> RetiredPipelines;   // 핫 리로드로 교체된 PSO (제출한 펜스 뒤에 놓는다)
 };
 
 class EditorApp : public D3DApp
@@ -46,65 +224,110 @@ public:
     ~EditorApp();
 
 public:
-    // ʱȭ
+    // 초기화
     virtual bool Initialize()override;
 
-    // RenderItem Transform 
+    // RenderItem Transform 설정
     void SetRenderItemTransform(RenderItem* Item, const XMFLOAT3& Pos, const XMFLOAT3& RotEuler, const XMFLOAT3& Scale);
 
+    // 에디터가 쓰는 셰이더 프로그램과 키워드 선언
+    static void DeclareShaderPrograms(ShaderPermutationSet& permutations);
+
+    // -bakeshaders : 창 없이 모든 셰이더 변형을 컴파일해서 셰이더 캐시에 저장 (종료 코드 0 = 성공)
+    static int BakeShaders();
+
+    // -importbench <파일> : 창 없이 메시 파일(OBJ/PLY/glTF)을 여러 번 임포트해서 속도를 출력 (종료 코드 0 = 성공)
+    static int BenchmarkImport(const std::string& path);
+
+    // -geobench : 창 없이 기본 도형을 가장 높은 분할 수준으로 만들어서 직렬/병렬 생성 시간을 출력
+    //             씬 정점 형식으로 만들 때 MeshData를 거치는 경로와 싱크로 바로 쓰는 경로의 복사 횟수/시간도 비교
+    //             절차적 메시 캐시의 생성 / 메모리 / 디스크 시간도 비교
+    static int BenchmarkGeometry();
+
 private:
-    virtual void OnResize()override;                    // â ũ  
+    virtual void OnResize()override;                    // 창 크기 조절 시
     virtual void Update(const GameTimer& gt)override;   // 
-    virtual void Draw(const GameTimer& gt)override;     // ׸  ó
+    virtual void Draw(const GameTimer& gt)override;     // 그리기 관련 처리
 
-    virtual void OnMouseDown(WPARAM btnState, int x, int y)override;    // 콺 Ŭ 
-    virtual void OnMouseUp(WPARAM btnState, int x, int y)override;      // 콺 Ŭ  
-    virtual void OnMouseMove(WPARAM btnState, int x, int y)override;    // 콺 ̵ 
+    virtual void OnMouseDown(WPARAM btnState, int x, int y)override;    // 마우스 클릭 시
+    virtual void OnMouseUp(WPARAM btnState, int x, int y)override;      // 마우스 클릭 종료 시
+    virtual void OnMouseMove(WPARAM btnState, int x, int y)override;    // 마우스 이동 시
 
     void OnKeyboardInput(const GameTimer& gt);  // 
-    void UpdateObjectCBs(const GameTimer& gt);  // 
-    void UpdateMainPassCB(const GameTimer& gt); // 
-    void UpdateMainPassCB2(const GameTimer& gt); // 
+    void UpdateObjectCBs(const GameTimer& gt, RenderSnapshot& snapshot);  // 
+    void UpdateMainPassCB(const GameTimer& gt, RenderSnapshot& snapshot); // 
+    void UpdateMainPassCB2(const GameTimer& gt, RenderSnapshot& snapshot); // 
+    void UploadFrameConstants(const RenderSnapshot& snapshot);  // 스냅샷 -> FrameResource 상수 버퍼
 
     void BuildDescriptorHeaps();        // 
     void BuildConstantBufferViews();    // 
     void BuildRootSignature();          // 
     void BuildShadersAndInputLayout();  // 
+    void UpdateShaderBlobs();           // 컴파일된 셰이더 변형 -> mShaders
     void BuildShapeGeometry();          // 
+    void RunMeshBenchmark();            // 쿠킹된 메시 로드 속도 측정 (-meshbench)
     void BuildPSOs();                   // 
+    void RequestPSOs(std::unordered_map<std::string, PipelineHandle>& psos);  // 현재 셰이더로 PSO 요청
+    void UpdateHotReload();             // 셰이더 파일 변경 감시 및 PSO 교체
     void BuildFrameResources();         // 
     void BuildRenderItems();            // 
-    void SceneHeapsInit();              // Scene Heap 
-    void GameHeapsInit();               // Game Heap 
+    void UpdateViewTarget(EditorView view);     // 패널 크기/배율에 맞는 렌더 타겟 준비
+    ViewVersion GetViewVersion(EditorView view)const;   // 뷰의 현재 상태 버전
+    PipelineHandle GetViewPipeline(EditorView view)const;   // 뷰를 그릴 PSO
 
-    void DrawSceneView();   // Scene 
-    void DrawGameView();    // Game 
-    void DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vector<RenderItem*>& ritems);   // 
+    void BuildFrameGraph(RenderSnapshot& snapshot);     // 이번 프레임의 패스/리소스 선언
+    void DrawSceneView(const RenderSnapshot& snapshot, D3D12_CPU_DESCRIPTOR_HANDLE rtv, D3D12_CPU_DESCRIPTOR_HANDLE dsv);   // Scene뷰 생성
+    void DrawGameView(const RenderSnapshot& snapshot, D3D12_CPU_DESCRIPTOR_HANDLE rtv, D3D12_CPU_DESCRIPTOR_HANDLE dsv);    // Game뷰 생성
+    void DrawRenderItems(ID3D12GraphicsCommandList* cmdList, const std::vector<RenderItemSnapshot>& ritems, UINT streamCount);   // 앞 streamCount개 정점 스트림만 바인딩
 
 public:
-    // Get Ƽ
-    ID3D12DescriptorHeap* GetSceneSRVHeap() { return mSceneSRVHeap.Get(); }
-    ID3D12DescriptorHeap* GetGameSRVHeap() { return mGameSRVHeap.Get(); }
+    // 패널 크기를 알려주고 이번 프레임에 그릴 뷰 텍스처를 받는다. (게임 스레드, UI 구성 중)
+    ViewImage PrepareView(EditorView view, UINT panelWidth, UINT panelHeight);
+
+    // Get 프로퍼티
+    bool GetDynamicResolutionState()const { return mDynamicResolutionState; }
+    float GetViewScale()const { return mDynamicResolutionState ? mDynamicResolution.GetScale() : 1.0f; }
     std::vector<std::unique_ptr<RenderItem>>& GetAllRItems() {return mAllRitems;}
 
-    // Set Ƽ
-    void SetIsWireFrame(bool IsWireFrame) { mIsWireframe = IsWireFrame; }
+    // Set 프로퍼티
+    void SetIsWireFrame(bool IsWireFrame);
+    void SetDynamicResolutionState(bool value) { mDynamicResolutionState = value; mDynamicResolution.Reset(); }
+    void SetPipelineWarmupState(bool value) { mPipelineWarmupState = value; }
+    void SetMeshBenchmarkState(bool value) { mMeshBenchmarkState = value; }
+    void SetDepthPrepassState(bool value) { mDepthPrepassState = value; }
 
 private:
     std::vector<std::unique_ptr<FrameResource>> mFrameResources;    //
     FrameResource* mCurrFrameResource = nullptr;                    // 
     int mCurrFrameResourceIndex = 0;                                // 
 
+    std::vector<std::unique_ptr<RenderSnapshot>> mRenderSnapshots;  // FrameResource마다 하나씩 있는 프레임 스냅샷
+
     ComPtr<ID3D12RootSignature> mRootSignature = nullptr;   // 
-    ComPtr<ID3D12DescriptorHeap> mCbvHeap = nullptr;        // 
 
-    ComPtr<ID3D12DescriptorHeap> mSrvDescriptorHeap = nullptr;  //
+    // 셰이더에서 보이는 힙은 이것 하나만 사용 (오브젝트 CBV, Scene/Game SRV, ImGui SRV, 프레임별 디스크립터)
+    GpuDescriptorHeap mDescriptorHeap;
+    StagingDescriptorHeap mStagingHeap;     // Pass CBV 원본 (프레임마다 링 영역으로 복사)
+
+    DescriptorHandle mObjectCbvs;           // 오브젝트 CBV (FrameResource 수 * 오브젝트 수)
+    DescriptorHandle mPassCbvs;             // Pass CBV (FrameResource 수 * 2, Staging 힙)
 
     std::unordered_map<std::string, std::unique_ptr<MeshGeometry>> mGeometries; //
+    GeometryArena mGeometryArena;                                               // 씬 메시 정점/인덱스 (모든 메시가 같은 IA 바인딩)
+    std::unordered_map<std::string, GeometryArena::Handle> mArenaMeshes;        // 이름 -> 아레나 구간
+    std::unordered_map<std::string, float> mArenaMeshAcmr;                      // 이름 -> FIFO 정점 캐시 ACMR (정점 fetch 통계용)
+    ProceduralMeshCache mProceduralMeshCache;                                   // 기본 도형 (씬 정점 형식, 다음 실행에도 디스크에서 읽는다)
+    ShaderPermutationSet mShaderPermutations;                                   // 셰이더 변형 (요청한 것만 컴파일)
+
+    // 셰이더 핫 리로드 (파일 감시 -> 작업 스레드에서 재컴파일 -> 새 PSO가 모두 준비되면 교체)
+    FileWatcher mShaderWatcher;
+    JobCounter mShaderReloadJob;
+    bool mIsShaderReloadSucceeded = false;
+    std::string mShaderReloadErrors;
+    std::unordered_map<std::string, PipelineHandle> mPendingPSOs;              // 교체를 기다리는 PSO
+    std::vector<PipelineHandle> mRetiredPSOs;                                  // 교체되어 다음 스냅샷에 실어 보낼 PSO
     std::unordered_map<std::string, ComPtr<ID3DBlob>> mShaders;                 // 
-    std::unordered_map<std::string, ComPtr<ID3D12PipelineState>> mPSOs;         // 
-
-    std::vector<D3D12_INPUT_ELEMENT_DESC> mInputLayout; // 
+    std::unordered_map<std::string, PipelineHandle> mPSOs;                      // 작업 스레드에서 컴파일 (PipelineStateCache::Resolve로 꺼낸다)
 
     std::vector<std::unique_ptr<RenderItem>> mAllRitems;    // 
 
@@ -112,11 +335,13 @@ private:
 
     PassConstants mMainPassCB;  //
 
-    UINT mPassCbvOffset = 0;    // 
-
-    bool mIsWireframe = true;  // WireFrame 
+    bool mIsWireframe = true;  // WireFrame모드 여부
+    bool mPipelineWarmupState = false;  // 첫 프레임 전에 PSO를 모두 컴파일 (벤치마크용)
+    bool mMeshBenchmarkState = false;   // 초기화할 때 메시 로드 벤치마크 실행
+    bool mDepthPrepassState = false;    // 위치 스트림만 읽는 깊이 프리패스 후 색 패스
+    VertexFetchStats mVertexFetchStats; // 렌더 스레드에서만 갱신 (종료할 때 출력)
 
-    // 콺 Ŭ ߴ 
+    // 마우스 클릭 했는지 여부
     bool IsMouseDown = false;
 
     float mTheta = 1.5f * XM_PI;
@@ -127,19 +352,35 @@ private:
 
     EditorUI mEditorUI;
 
-    // ī޶
-    Camera mSceneCamera;    // Scene ī޶
-    Camera mGameCamera;     // Game ī޶
-
-    // Scene  
-    ComPtr<ID3D12Resource> mSceneTexture;       // ī޶   ؽó
-    ComPtr<ID3D12DescriptorHeap> mSceneSRVHeap; // ImGui SRV Heap
-    ComPtr<ID3D12DescriptorHeap> mSceneRtvHeap; // ImGui RTV Heap
-    D3D12_CPU_DESCRIPTOR_HANDLE mSceneRTV;      // mSceneTexture  RTV
-
-    // Game  
-    ComPtr<ID3D12Resource> mGameTexture;        // ī޶   ؽó
-    ComPtr<ID3D12DescriptorHeap> mGameSRVHeap;  // ImGui SRV Heap
-    ComPtr<ID3D12DescriptorHeap> mGameRtvHeap;  // ImGui RTV Heap
-    D3D12_CPU_DESCRIPTOR_HANDLE mGameRTV;       // mSceneTexture  RTV
+    // 프레임 그래프 (렌더 스레드에서만 사용)
+    RenderGraph mFrameGraph;
+    RenderGraphExecutor mGraphExecutor;
+
+    // 카메라
+    Camera mSceneCamera;    // Scene뷰 카메라
+    Camera mGameCamera;     // Game뷰 카메라
+
+    // 뷰 렌더 타겟 (게임 스레드에서 관리, 스냅샷으로 렌더 스레드에 넘긴다)
+    struct ViewState
+    {
+        PooledRenderTarget* Target = nullptr;
+        UINT PanelWidth = 1;
+        UINT PanelHeight = 1;
+        UINT RenderWidth = 1;
+        UINT RenderHeight = 1;
+
+        bool IsVisible = false;         // 이번 프레임에 UI에서 패널이 보였는지 (PrepareView 호출 여부)
+        UINT64 SettingsVersion = 1;     // 렌더 타겟/해상도/표시 옵션이 바뀔 때마다 증가
+        ViewVersion Rendered;           // 마지막으로 그린 시점의 버전
+    };
+    ViewState mViews[(int)EditorView::Count];
+
+    RenderTargetPool mRenderTargetPool;
+    DynamicResolutionController mDynamicResolution;     // 프레임 시간 예산에 맞춰 뷰 해상도 배율 조절
+    GpuFrameTimer mGpuFrameTimer;                       // 동적 해상도에 넣을 GPU 프레임 시간 (슬롯마다 타임스탬프 쿼리)
+    bool mDynamicResolutionState = true;
+
+    UINT64 mFrameSerial = 0;    // 게임 스레드가 작성한 스냅샷 번호 (렌더 타겟 반환 시점 기준)
+
+    UINT64 mSceneVersion = 1;           // 씬 편집 카운터 (뷰 무효화용)
 };
\ No newline at end of file
@@ -3,6 +3,54 @@
 
 static ExampleDescriptorHeapAllocator mSrvHeapAlloc;
 
+EditorUISnapshot::~EditorUISnapshot()
+{
+    for (ImDrawList* list : DrawLists)
+        IM_DELETE(list);
+    DrawLists.clear();
+}
+
+void EditorUISnapshot::Capture(const ImDrawData* src)
+{
+    DrawData.Clear();
+    if (src == nullptr || !src->Valid)
+        return;
+
+    // 필요한 만큼 DrawList 복사본 확보
+    while (DrawLists.Size < src->CmdLists.Size)
+        DrawLists.push_back(IM_NEW(ImDrawList)(nullptr));
+
+    for (int n = 0; n < src->CmdLists.Size; n++)
+    {
+        const ImDrawList* srcList = src->CmdLists[n];
+        ImDrawList* dstList = DrawLists[n];
+
+        dstList->CmdBuffer = srcList->CmdBuffer;
+        dstList->IdxBuffer = srcList->IdxBuffer;
+        dstList->VtxBuffer = srcList->VtxBuffer;
+        dstList->Flags = srcList->Flags;
+
+        // ImTextureData는 게임 스레드가 바꾸거나 지우므로 렌더 스레드가 읽지 않게 TexID로 바꿔 둔다.
+        for (ImDrawCmd& cmd : dstList->CmdBuffer)
+            if (cmd.TexRef._TexData != nullptr && cmd.UserCallback == nullptr)
+                cmd.TexRef = ImTextureRef(cmd.GetTexID());
+
+        DrawData.CmdLists.push_back(dstList);
+    }
+
+    DrawData.Valid = true;
+    DrawData.CmdListsCount = src->CmdListsCount;
+    DrawData.TotalIdxCount = src->TotalIdxCount;
+    DrawData.TotalVtxCount = src->TotalVtxCount;
+    DrawData.DisplayPos = src->DisplayPos;
+    DrawData.DisplaySize = src->DisplaySize;
+    DrawData.FramebufferScale = src->FramebufferScale;
+    DrawData.OwnerViewport = src->OwnerViewport;
+
+    // 텍스처 업데이트는 게임 스레드의 EndFrame에서 이미 처리했다.
+    DrawData.Textures = nullptr;
+}
+
 EditorUI::~EditorUI()
 {
     ImGui_ImplDX12_Shutdown();
@@ -15,32 +63,38 @@ bool EditorUI::Initialize(
     HWND hwnd,
     ID3D12Device* device,
     ID3D12CommandQueue* commandQueue,
-    ID3D12DescriptorHeap* srvHeap,
+    GpuDescriptorHeap* descriptorHeap,
     DXGI_FORMAT rtvFormat,
-    UINT frameCount)
+    UINT frameCount,
+    bool useRenderThread)
 {
     mEditorApp = editorApp;
     mHwnd = hwnd;
     mDevice = device;
     mCommandQueue = commandQueue;
-    mSrvHeap = srvHeap;
+    mDescriptorHeap = descriptorHeap;
     mRtvFormat = rtvFormat;
     mFrameCount = frameCount;
+    mUseRenderThread = useRenderThread;
 
-    // 1) ImGui Context 
+    // 1) ImGui Context 생성
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-    io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+
+    // 추가 뷰포트 창은 Win32 창을 가진 게임 스레드에서 그려야 하므로
+    // 렌더 스레드를 사용할 때는 멀티 뷰포트를 끈다.
+    if (!mUseRenderThread)
+        io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 
     ImGui::StyleColorsDark();
 
-    // 2) Win32 鿣 ʱȭ
+    // 2) Win32 백엔드 초기화
     if (!ImGui_ImplWin32_Init(hwnd))
         return false;
 
-    mSrvHeapAlloc.Create(device, mSrvHeap);
+    mSrvHeapAlloc.Create(mDescriptorHeap);
 
     ImGui_ImplDX12_InitInfo init_info = {};
     init_info.Device = device;
@@ -49,7 +103,7 @@ bool EditorUI::Initialize(
     init_info.RTVFormat = rtvFormat;
     init_info.DSVFormat = DXGI_FORMAT_UNKNOWN;
 
-    init_info.SrvDescriptorHeap = mSrvHeap;
+    init_info.SrvDescriptorHeap = mDescriptorHeap->GetHeap();
     init_info.SrvDescriptorAllocFn = [](ImGui_ImplDX12_InitInfo*, D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle) { return mSrvHeapAlloc.Alloc(out_cpu_handle, out_gpu_handle); };
     init_info.SrvDescriptorFreeFn = [](ImGui_ImplDX12_InitInfo*, D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle) { return mSrvHeapAlloc.Free(cpu_handle, gpu_handle); };
 
@@ -59,23 +113,38 @@ bool EditorUI::Initialize(
     return true;
 }
 
-void EditorUI::Draw(ID3D12GraphicsCommandList* commandList)
+void EditorUI::BuildFrame(UINT64 frame, UINT64 completedFrames)
 {
-    // ׸ 
+    // UI 구성 시작
     BeginFrame();
 
-    // ŷ ̽ ׸
+    // 도킹 스페이스 그리기
     DockSpaceDraw();    
 
-    //  â ׸
-    SceneViewDraw(commandList); // Scene
-    GameViewDraw(commandList);  // Game
-    HierarchyViewDraw();        // Hierarchy
-    InspectorViewDraw();        // Inspector
-    ProjectViewDraw();          // Project
+    // 개별 창들 그리기
+    SceneViewDraw();            // Scene뷰
+    GameViewDraw();             // Game뷰
+    HierarchyViewDraw();        // Hierarchy뷰
+    InspectorViewDraw();        // Inspector뷰
+    ProjectViewDraw();          // Project뷰
+
+    // UI 구성 끝
+    EndFrame(frame, completedFrames);
+}
+
+void EditorUI::Render(ID3D12GraphicsCommandList* commandList, EditorUISnapshot& snapshot)
+{
+    if (!snapshot.DrawData.Valid)
+        return;
+
+    ImGui_ImplDX12_RenderDrawData(&snapshot.DrawData, commandList);
+}
 
-    // ׸ 
-    EndFrame(commandList);
+void EditorUI::RenderPlatformWindows()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+        ImGui::RenderPlatformWindowsDefault();
 }
 
 void EditorUI::BeginFrame()
@@ -85,28 +154,51 @@ void EditorUI::BeginFrame()
     ImGui::NewFrame();
 }
 
-void EditorUI::EndFrame(ID3D12GraphicsCommandList* commandList)
+void EditorUI::EndFrame(UINT64 frame, UINT64 completedFrames)
 {
     ImGui::Render();
-    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+
+    // 폰트 아틀라스 등 텍스처 업데이트는 ImGui 컨텍스트를 가진 게임 스레드에서 처리
+    ImDrawData* drawData = ImGui::GetDrawData();
+    if (drawData->Textures != nullptr)
+    {
+        for (ImTextureData* tex : *drawData->Textures)
+        {
+            if (tex->Status != ImTextureStatus_WantDestroy)
+            {
+                mRetiredTextures.erase(tex);
+                if (tex->Status != ImTextureStatus_OK)
+                    ImGui_ImplDX12_UpdateTexture(tex);
+                continue;
+            }
+
+            // 이전 스냅샷들은 아직 렌더 스레드/GPU가 이 텍스처를 쓰고 있을 수 있다.
+            // 백엔드는 ImGui 프레임 수만 세므로 GPU가 끝낸 스냅샷으로 다시 확인한다.
+            auto it = mRetiredTextures.emplace(tex, frame).first;
+            if (completedFrames <= it->second)
+                continue;
+
+            ImGui_ImplDX12_UpdateTexture(tex);
+            if (tex->Status == ImTextureStatus_Destroyed)
+                mRetiredTextures.erase(it);
+        }
+    }
 
     ImGuiIO& io = ImGui::GetIO();
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
-    {
         ImGui::UpdatePlatformWindows();
-        ImGui::RenderPlatformWindowsDefault();
-    }
 }
 
-// ŷ ̽ ׸
+// 도킹 스페이스 그리기
 void EditorUI::DockSpaceDraw()
 {
-    // ó   DockSpace ʱȭ
+    // 처음 실행 시 DockSpace 초기화
     static bool dock_layout_initialized = false;
 
     ImGuiIO& io = ImGui::GetIO();
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-    io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+    if (!mUseRenderThread)
+        io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_MenuBar | ImGuiWindowFlags_NoDocking;
 
@@ -136,20 +228,20 @@ void EditorUI::DockSpaceDraw()
         ImGui::DockBuilderAddNode(dock_main_id, ImGuiDockNodeFlags_DockSpace);
         ImGui::DockBuilderSetNodeSize(dock_main_id, io.DisplaySize);
 
-        //  (1)
+        // 왼쪽 (1)
         ImGuiID dock_id_L = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Left, 0.423f, nullptr, &dock_main_id);
 
-        // -/Ʒ (2)
+        // 왼쪽-위/아래 (2)
         ImGuiID dock_id_LT = ImGui::DockBuilderSplitNode(dock_id_L, ImGuiDir_Up, 0.5f, nullptr, &dock_id_L);
         ImGuiID dock_id_LB = ImGui::DockBuilderSplitNode(dock_id_L, ImGuiDir_Down, 0.5f, nullptr, &dock_id_L);
 
-        //  (1)
+        // 오른쪽 (1)
         ImGuiID dock_id_R = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Right, 0.5f, nullptr, &dock_main_id);
 
-        // Ʒ (1)  
+        // 아래 (1)  
         ImGuiID dock_id_B = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Down, 0.3f, nullptr, &dock_main_id);
 
-        // â ŷ
+        // 창 도킹
         ImGui::DockBuilderDockWindow("Scene", dock_id_LT);
         ImGui::DockBuilderDockWindow("Game", dock_id_LB);
         ImGui::DockBuilderDockWindow("Hierarchy", dock_main_id);
@@ -161,90 +253,81 @@ void EditorUI::DockSpaceDraw()
     ImGui::End();
 }
 
-void EditorUI::SceneViewDraw(ID3D12GraphicsCommandList* commandList)
+void EditorUI::SceneViewDraw()
 {
-    // Scene 
-    ImGui::Begin("Scene");
+    // Scene뷰 시작
+    // 접혀 있거나 가려진 탭이면 PrepareView를 부르지 않아서 이번 프레임에 다시 그리지 않는다.
+    if (!ImGui::Begin("Scene"))
+    {
+        IsSceneViewFocused = false;
+        ImGui::End();
+        return;
+    }
 
-    // Ŀ üũ
+    // 포커싱 체크
     SetFocusTab();
 
-    //  信 Ŀ Ǿ ִ üũ
+    // 현재 뷰에 포커싱이 되어 있는지 체크
     IsSceneViewFocused = ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
 
-    // ư 
+    // 버튼 생성
     if (ImGui::Button("Wire Frame")) mEditorApp->SetIsWireFrame(true);
     ImGui::SameLine();
     if (ImGui::Button("Solid")) mEditorApp->SetIsWireFrame(false);
 
-    // GPU Descriptor Heap ε
-    ID3D12DescriptorHeap* SrvHeap = mEditorApp->GetSceneSRVHeap();
-    commandList->SetDescriptorHeaps(1, &SrvHeap);
+    ImGui::SameLine();
+    bool DynamicResolution = mEditorApp->GetDynamicResolutionState();
+    if (ImGui::Checkbox("Dynamic Res", &DynamicResolution)) mEditorApp->SetDynamicResolutionState(DynamicResolution);
+    ImGui::SameLine();
+    ImGui::Text("%d%%", (int)(mEditorApp->GetViewScale() * 100.0f + 0.5f));
 
-    // ȭ  ؼ ̹ ũ 
+    // 패널 크기 그대로 렌더링 (레터박스 없이 패널 해상도로 그린다)
     ImVec2 ImageSize = ImGui::GetContentRegionAvail();
-    float AspectRatio = 16.0f / 9.0f;
-    if (ImageSize.x / ImageSize.y > AspectRatio)
-    {
-        // ΰ ʹ    
-        ImageSize.x = ImageSize.y * AspectRatio;
-    }
-    else
-    {
-        // ΰ ʹ    
-        ImageSize.y = ImageSize.x / AspectRatio;
-    }
+    ImageSize.x = std::max<float>(ImageSize.x, 1.0f);
+    ImageSize.y = std::max<float>(ImageSize.y, 1.0f);
 
-    // ImGui ؽó 
-    ImGui::Image((ImTextureID)SrvHeap->GetGPUDescriptorHandleForHeapStart().ptr, ImageSize);
+    // ImGui에 텍스처 출력 (렌더 타겟 중 그려진 영역만)
+    ViewImage Image = mEditorApp->PrepareView(EditorView::Scene, (UINT)ImageSize.x, (UINT)ImageSize.y);
+    ImGui::Image((ImTextureID)Image.SRV.ptr, ImageSize, ImVec2(0.0f, 0.0f), ImVec2(Image.U, Image.V));
 
-    // Scene 
+    // Scene뷰 끝
     ImGui::End();
 }
 
-void EditorUI::GameViewDraw(ID3D12GraphicsCommandList* commandList)
+void EditorUI::GameViewDraw()
 {
-    // Game 
-    ImGui::Begin("Game");
+    // Game뷰 시작 (보이지 않으면 다시 그리지 않는다)
+    if (!ImGui::Begin("Game"))
+    {
+        ImGui::End();
+        return;
+    }
 
-    // Ŀ üũ
+    // 포커싱 체크
     SetFocusTab();
 
-    // Game ȭ ֱ
-    // GPU Descriptor Heap ε
-    ID3D12DescriptorHeap* SrvHeap = mEditorApp->GetGameSRVHeap();
-    commandList->SetDescriptorHeaps(1, &SrvHeap);
-
-    // ȭ  ؼ ̹ ũ 
+    // Game뷰 화면 보여주기 (패널 크기 그대로 렌더링)
     ImVec2 ImageSize = ImGui::GetContentRegionAvail();
-    float AspectRatio = 16.0f / 9.0f;
-    if (ImageSize.x / ImageSize.y > AspectRatio)
-    {
-        // ΰ ʹ    
-        ImageSize.x = ImageSize.y * AspectRatio;
-    }
-    else
-    {
-        // ΰ ʹ    
-        ImageSize.y = ImageSize.x / AspectRatio;
-    }
+    ImageSize.x = std::max<float>(ImageSize.x, 1.0f);
+    ImageSize.y = std::max<float>(ImageSize.y, 1.0f);
 
-    // ImGui ؽó 
-    ImGui::Image((ImTextureID)SrvHeap->GetGPUDescriptorHandleForHeapStart().ptr, ImageSize);
+    // ImGui에 텍스처 출력 (렌더 타겟 중 그려진 영역만)
+    ViewImage Image = mEditorApp->PrepareView(EditorView::Game, (UINT)ImageSize.x, (UINT)ImageSize.y);
+    ImGui::Image((ImTextureID)Image.SRV.ptr, ImageSize, ImVec2(0.0f, 0.0f), ImVec2(Image.U, Image.V));
 
-    // Game 
+    // Game뷰 끝
     ImGui::End();
 }
 
 void EditorUI::HierarchyViewDraw()
 {
-    // Hierarchy 
+    // Hierarchy뷰 시작
     ImGui::Begin("Hierarchy");
 
-    // Ŀ üũ
+    // 포커싱 체크
     SetFocusTab();
     
-    // Scene ִ Ʈ  ̱
+    // Scene에 있는 오브젝트 종류 보이기
     const auto& Items = mEditorApp->GetAllRItems();
     int index = 0;
     for (const auto& Item : Items)
@@ -260,25 +343,25 @@ void EditorUI::HierarchyViewDraw()
         index++;
     }
     
-    // Hierarchy 
+    // Hierarchy뷰 끝
     ImGui::End();
 }
 
 void EditorUI::InspectorViewDraw()
 {
-    // Inspector 
+    // Inspector뷰 시작
     ImGui::Begin("Inspector");
 
-    // Ŀ üũ
+    // 포커싱 체크
     SetFocusTab();
     
-    //   Ʈ  ̱
+    // 현재 선택한 오브젝트 상태 보이기
     if (mSelectedItem)
     {
         ImGui::Text("Name: %s", mSelectedItem->Name.c_str());
         ImGui::Separator();
 
-        // World Matrix о Transform 
+        // World Matrix 읽어서 Transform 분해
         XMMATRIX World = XMLoadFloat4x4(&mSelectedItem->World);
 
         XMVECTOR Scale;
@@ -287,12 +370,12 @@ void EditorUI::InspectorViewDraw()
 
         XMMatrixDecompose(&Scale, &RotQuat, &Pos, World);
 
-        // Vector -> float3 ĳ
+        // Vector -> float3로 캐싱
         XMStoreFloat3(&mPosCache, Pos);
         XMStoreFloat3(&mScaleCache, Scale);
 
-        // Euler -> Quaternion ȯ
-        //   ٲ 쿡  Rotation ĳ 
+        // Euler -> Quaternion 변환
+        // 선택한 아이템이 바뀐 경우에만 새로 Rotation 캐시 수정
         if (IsChangeSelectedItem)
         {
             XMFLOAT3 Euler = MathHelper::QuaternionToEuler(RotQuat);
@@ -300,18 +383,18 @@ void EditorUI::InspectorViewDraw()
             IsChangeSelectedItem = false;
         }
 
-        // з - Transform
+        // 분류 - Transform
         ImGui::Text("Transform");
-        // Position 
+        // Position 정보
         if (ImGui::DragFloat3("Position", (float*)&mPosCache, 0.1f))
         {
             mEditorApp->SetRenderItemTransform(mSelectedItem, mPosCache, mRotCache, mScaleCache);
         }
 
-        // Rotation 
+        // Rotation 정보
         if (ImGui::DragFloat3("Rotation", (float*)&mRotCache, 0.1f))
         {
-            //  ȯ ó
+            // 값 순환 처리
             MathHelper::WrapAngle360(mRotCache.x);
             MathHelper::WrapAngle360(mRotCache.y);
             MathHelper::WrapAngle360(mRotCache.z);
@@ -319,40 +402,40 @@ void EditorUI::InspectorViewDraw()
             mEditorApp->SetRenderItemTransform(mSelectedItem, mPosCache, mRotCache, mScaleCache);
         }
 
-        // Scale 
+        // Scale 정보
         if (ImGui::DragFloat3("Scale", (float*)&mScaleCache, 0.1f, 0.0f, 100.0f))
         {
             mEditorApp->SetRenderItemTransform(mSelectedItem, mPosCache, mRotCache, mScaleCache);
         }
     }
     
-    // Inspector 
+    // Inspector뷰 끝
     ImGui::End();
 }
 
 void EditorUI::ProjectViewDraw()
 {
-    // Project 
+    // Project뷰 시작
     ImGui::Begin("Project");
     
-    // Ŀ üũ
+    // 포커싱 체크
     SetFocusTab();
 
-    //   ̱
+    // 모든 파일 보이기
     
-    // Project 
+    // Project뷰 끝
     ImGui::End();
 }
 
 
 
-// Ŀ üũ
+// 포커싱 체크
 void EditorUI::SetFocusTab()
 {
-    // / Ŭ Ŀ   ֵ ߰
+    // 좌/우 클릭으로 포커스 설정할 수 있도록 추가
     if (ImGui::IsWindowHovered(ImGuiHoveredFlags_RootWindow) && (ImGui::IsMouseClicked(ImGuiMouseButton_Left) || ImGui::IsMouseClicked(ImGuiMouseButton_Right)))
     {
-        //  â Ŀ 
+        // 이 창을 포커스로 설정
         ImGui::SetWindowFocus();
     }
 }
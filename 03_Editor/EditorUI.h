@@ -5,61 +5,62 @@
 #include "IMGUI/imgui_impl_dx12.h"
 #include "IMGUI/imgui_internal.h"
 #include "../02_Engine/d3dx12.h"
+#include "../02_Engine/DescriptorHeap.h"
 #include <d3d12.h>
 #include <dxgi1_5.h>
 #include <tchar.h>
 #include <DirectXMath.h>
+#include <unordered_map>
 
 using namespace DirectX;
 
 class EditorApp;
 struct RenderItem;
 
+// ImGui 백엔드용 SRV 할당기
+// 따로 힙을 두지 않고 통합 디스크립터 힙의 영구 영역에서 할당한다.
 struct ExampleDescriptorHeapAllocator
 {
-    ID3D12DescriptorHeap* Heap = nullptr;
-    D3D12_DESCRIPTOR_HEAP_TYPE  HeapType = D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES;
-    D3D12_CPU_DESCRIPTOR_HANDLE HeapStartCpu;
-    D3D12_GPU_DESCRIPTOR_HANDLE HeapStartGpu;
-    UINT                        HeapHandleIncrement;
-    ImVector<int>               FreeIndices;
-
-    void Create(ID3D12Device* device, ID3D12DescriptorHeap* heap)
+    GpuDescriptorHeap* Heap = nullptr;
+
+    void Create(GpuDescriptorHeap* heap)
     {
-        IM_ASSERT(Heap == nullptr && FreeIndices.empty());
+        IM_ASSERT(Heap == nullptr);
         Heap = heap;
-        D3D12_DESCRIPTOR_HEAP_DESC desc = heap->GetDesc();
-        HeapType = desc.Type;
-        HeapStartCpu = Heap->GetCPUDescriptorHandleForHeapStart();
-        HeapStartGpu = Heap->GetGPUDescriptorHandleForHeapStart();
-        HeapHandleIncrement = device->GetDescriptorHandleIncrementSize(HeapType);
-        FreeIndices.reserve((int)desc.NumDescriptors);
-        for (int n = desc.NumDescriptors; n > 0; n--)
-            FreeIndices.push_back(n - 1);
     }
     void Destroy()
     {
         Heap = nullptr;
-        FreeIndices.clear();
     }
     void Alloc(D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_desc_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_desc_handle)
     {
-        IM_ASSERT(FreeIndices.Size > 0);
-        int idx = FreeIndices.back();
-        FreeIndices.pop_back();
-        out_cpu_desc_handle->ptr = HeapStartCpu.ptr + (idx * HeapHandleIncrement);
-        out_gpu_desc_handle->ptr = HeapStartGpu.ptr + (idx * HeapHandleIncrement);
+        DescriptorHandle handle = Heap->AllocatePersistent();
+        *out_cpu_desc_handle = handle.CPU;
+        *out_gpu_desc_handle = handle.GPU;
     }
     void Free(D3D12_CPU_DESCRIPTOR_HANDLE out_cpu_desc_handle, D3D12_GPU_DESCRIPTOR_HANDLE out_gpu_desc_handle)
     {
-        int cpu_idx = (int)((out_cpu_desc_handle.ptr - HeapStartCpu.ptr) / HeapHandleIncrement);
-        int gpu_idx = (int)((out_gpu_desc_handle.ptr - HeapStartGpu.ptr) / HeapHandleIncrement);
-        IM_ASSERT(cpu_idx == gpu_idx);
-        FreeIndices.push_back(cpu_idx);
+        (void)out_gpu_desc_handle;
+        Heap->FreePersistent(out_cpu_desc_handle);
     }
 };
 
-//  UI
+// 렌더 스레드로 넘겨줄 ImGui DrawData 복사본
+// ImGui의 DrawList는 다음 NewFrame에서 다시 쓰이므로 프레임 스냅샷마다 복사해 둔다.
+struct EditorUISnapshot
+{
+    EditorUISnapshot() = default;
+    EditorUISnapshot(const EditorUISnapshot& rhs) = delete;
+    EditorUISnapshot& operator=(const EditorUISnapshot& rhs) = delete;
+    ~EditorUISnapshot();
+
+    void Capture(const ImDrawData* src);   // DrawData 복사 (DrawList 메모리는 재사용)
+
+    ImDrawData DrawData;
+    ImVector<ImDrawList*> DrawLists;
+};
+
+// 에디터 UI
 class EditorUI
 {	
 	
@@ -72,21 +73,24 @@ public:
 		HWND hwnd,
         ID3D12Device* device,
         ID3D12CommandQueue* commandQueue,
-        ID3D12DescriptorHeap* srvHeap,
+        GpuDescriptorHeap* descriptorHeap,
         DXGI_FORMAT rtvFormat,
-        UINT frameCount);	// ʱȭ
-	void Draw(ID3D12GraphicsCommandList* commandList);   // ׸
+        UINT frameCount,
+        bool useRenderThread);	// 초기화
+	void BuildFrame(UINT64 frame, UINT64 completedFrames);  // UI 구성 (게임 스레드, frame : 작성 중인 스냅샷 번호, completedFrames : GPU가 끝낸 스냅샷 수)
+    void Render(ID3D12GraphicsCommandList* commandList, EditorUISnapshot& snapshot);   // 그리기 (렌더 스레드)
+    void RenderPlatformWindows();   // 추가 뷰포트 창 그리기 (렌더 스레드 미사용 시)
 
 private:
-    void BeginFrame();  // Draw 
-    void EndFrame(ID3D12GraphicsCommandList* commandList);  // Draw 
+    void BeginFrame();  // UI 구성 시작
+    void EndFrame(UINT64 frame, UINT64 completedFrames);    // UI 구성 끝
 
-    // ŷ ̽ ׸
+    // 도킹 스페이스 그리기
     void DockSpaceDraw();
 
-    //   ׸
-    void SceneViewDraw(ID3D12GraphicsCommandList* commandList);
-    void GameViewDraw(ID3D12GraphicsCommandList* commandList);
+    // 모든 탭 그리기
+    void SceneViewDraw();
+    void GameViewDraw();
     void HierarchyViewDraw();
     void InspectorViewDraw();
     void ProjectViewDraw();
@@ -94,11 +98,11 @@ private:
     void SetFocusTab();
 
 public:
-    // Ƽ
+    // 프로퍼티
     bool GetIsSceneViewFocused() { return IsSceneViewFocused; }
 
 private:
-    bool IsSceneViewFocused;    // Scene信 Ŀ Ǿִ 
+    bool IsSceneViewFocused;    // Scene뷰에 포커싱이 되어있는지 여부
 
 private:
     EditorApp* mEditorApp = nullptr;
@@ -108,17 +112,22 @@ private:
     ID3D12CommandQueue* mCommandQueue = nullptr;
     DXGI_FORMAT mRtvFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
     UINT mFrameCount;
+    bool mUseRenderThread = false;  // 렌더 스레드 사용 여부 (사용 시 멀티 뷰포트 비활성화)
+
+    // 통합 디스크립터 힙 (ImGui SRV도 여기서 할당)
+    GpuDescriptorHeap* mDescriptorHeap = nullptr;
 
-    // DX12 SRV Descriptor Heap 
-    ID3D12DescriptorHeap* mSrvHeap = nullptr;
+    // 폐기 요청된 ImGui 텍스처 -> 요청을 처음 본 스냅샷 번호
+    // 그 전 스냅샷들을 GPU가 다 끝낸 뒤에 백엔드에 넘겨 리소스를 놓는다.
+    std::unordered_map<ImTextureData*, UINT64> mRetiredTextures;
 
-    //   Ʈ
+    // 현재 선택한 오브젝트
     RenderItem* mSelectedItem = nullptr;
     bool IsChangeSelectedItem = false;
 
-    // νͿ  ĳ 
+    // 인스펙터에 사용할 캐시 변수들
     XMFLOAT3 mPosCache;     // Position
-    XMFLOAT3 mRotCache;     // Rotation (Euler )
+    XMFLOAT3 mRotCache;     // Rotation (Euler 각도)
     XMFLOAT3 mScaleCache;   // Scale
 
 };
@@ -0,0 +1,214 @@
+#include "TestFramework.h"
+#include "../01_Core/FenceReleaseQueue.h"
+#include "../01_Core/FenceTimeline.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // 테스트가 직접 진행시키는 펜스 (GPU 대신)
+    // WaitForValue는 GPU가 그 값까지 끝낸 것처럼 완료 값을 올린다.
+    class FakeFence : public ITimelineFence
+    {
+    public:
+        std::uint64_t GetCompletedValue() override
+        {
+            ++ReadCount;
+            return Completed;
+        }
+
+        void WaitForValue(std::uint64_t value) override
+        {
+            ++WaitCount;
+            if (Completed < value)
+                Completed = value;
+        }
+
+        std::uint64_t Completed = 0;
+        int ReadCount = 0;
+        int WaitCount = 0;
+    };
+
+    // 해제 여부를 기록하는 가짜 GPU 리소스
+    struct FakeResource
+    {
+        explicit FakeResource(std::vector<int>& log, int id) : Log(log), Id(id) {}
+        ~FakeResource() { Log.push_back(Id); }
+
+        std::vector<int>& Log;
+        int Id;
+    };
+}
+
+TEST_CASE(FenceTimeline_SignalAndComplete)
+{
+    FakeFence fence;
+    FenceTimeline timeline;
+    timeline.Initialize(&fence, 10);
+
+    CHECK_EQ(timeline.GetLastSignaled(), 10u);
+    CHECK(timeline.IsComplete(10));
+
+    const std::uint64_t a = timeline.Advance();
+    const std::uint64_t b = timeline.Advance();
+    CHECK_EQ(a, 11u);
+    CHECK_EQ(b, 12u);
+    CHECK(!timeline.IsComplete(a));
+
+    fence.Completed = 11;
+    CHECK(timeline.IsComplete(a));
+    CHECK(!timeline.IsComplete(b));
+    CHECK_EQ(timeline.GetCompletedValue(), 11u);
+}
+
+TEST_CASE(FenceTimeline_CachesCompletedValue)
+{
+    FakeFence fence;
+    FenceTimeline timeline;
+    timeline.Initialize(&fence);
+
+    const std::uint64_t value = timeline.Advance();
+    fence.Completed = value;
+    CHECK(timeline.IsComplete(value));
+
+    // 이미 끝난 것으로 본 값은 펜스를 다시 읽지 않는다.
+    const int reads = fence.ReadCount;
+    CHECK(timeline.IsComplete(value));
+    CHECK(timeline.IsComplete(value - 1));
+    CHECK_EQ(fence.ReadCount, reads);
+}
+
+TEST_CASE(FenceTimeline_WaitOnlyWhenPending)
+{
+    FakeFence fence;
+    FenceTimeline timeline;
+    timeline.Initialize(&fence);
+
+    const std::uint64_t first = timeline.Advance();
+    const std::uint64_t second = timeline.Advance();
+    fence.Completed = first;
+
+    // 끝난 값은 대기 객체를 쓰지 않는다.
+    timeline.Wait(first);
+    CHECK_EQ(fence.WaitCount, 0);
+
+    timeline.Wait(second);
+    CHECK_EQ(fence.WaitCount, 1);
+    CHECK(timeline.IsComplete(second));
+
+    timeline.Wait(second);
+    CHECK_EQ(fence.WaitCount, 1);
+}
+
+TEST_CASE(FenceTimeline_DeviceRemovedReleasesWaits)
+{
+    // 디바이스가 제거되면 펜스가 UINT64_MAX를 돌려주고 모든 값이 끝난 것으로 본다.
+    FakeFence fence;
+    FenceTimeline timeline;
+    timeline.Initialize(&fence);
+
+    const std::uint64_t value = timeline.Advance();
+    fence.Completed = UINT64_MAX;
+    CHECK(timeline.IsComplete(value));
+    timeline.Wait(value + 100);
+    CHECK_EQ(fence.WaitCount, 0);
+}
+
+TEST_CASE(FenceReleaseQueue_ReleasesInFenceOrder)
+{
+    std::vector<int> log;
+    FenceReleaseQueue queue;
+
+    // 펜스 순서와 다르게 넣어도 펜스 순서로 놓인다.
+    queue.Enqueue(3, [&log]() { log.push_back(3); });
+    queue.Enqueue(1, [&log]() { log.push_back(1); });
+    queue.Enqueue(2, [&log]() { log.push_back(2); });
+    queue.Enqueue(2, [&log]() { log.push_back(20); });
+    CHECK_EQ(queue.GetPendingCount(), 4u);
+
+    CHECK_EQ(queue.ReleaseCompleted(0), 0u);
+    CHECK_EQ(queue.ReleaseCompleted(2), 3u);
+    REQUIRE(log.size() == 3u);
+    CHECK_EQ(log[0], 1);
+    CHECK_EQ(log[1], 2);
+    CHECK_EQ(log[2], 20);
+
+    queue.ReleaseAll();
+    CHECK_EQ(log.size(), 4u);
+    CHECK_EQ(queue.GetPendingCount(), 0u);
+}
+
+TEST_CASE(FenceReleaseQueue_ReleaseMayEnqueue)
+{
+    // 해제 콜백 안에서 다시 넣어도 막히지 않는다. (디스크립터 회수 등)
+    FenceReleaseQueue queue;
+    int released = 0;
+    queue.Enqueue(1, [&]()
+    {
+        ++released;
+        queue.Enqueue(5, [&released]() { ++released; });
+    });
+
+    CHECK_EQ(queue.ReleaseCompleted(1), 1u);
+    CHECK_EQ(released, 1);
+    CHECK_EQ(queue.GetPendingCount(), 1u);
+    CHECK_EQ(queue.ReleaseCompleted(5), 1u);
+    CHECK_EQ(released, 2);
+}
+
+TEST_CASE(FenceReleaseQueue_DestructorReleasesRemaining)
+{
+    std::vector<int> log;
+    {
+        FenceReleaseQueue queue;
+        auto resource = std::make_shared<FakeResource>(log, 7);
+        queue.Enqueue(100, [resource]() {});
+        resource.reset();
+        CHECK(log.empty());
+    }
+    REQUIRE(log.size() == 1u);
+    CHECK_EQ(log[0], 7);
+}
+
+// 프레임 루프 흉내 : 창 크기 변경 때 리소스를 큐에 넣고, GPU가 끝낸 펜스만큼만 놓는다.
+// GPU를 기다리지 않고도 쓰는 중인 리소스가 먼저 놓이는 일이 없어야 한다.
+TEST_CASE(FenceTimeline_ResizeWithoutFlush)
+{
+    FakeFence fence;
+    FenceTimeline timeline;
+    timeline.Initialize(&fence);
+    FenceReleaseQueue queue;
+
+    std::vector<int> destroyed;
+    std::vector<std::uint64_t> lastUse(8, 0);
+
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        // 이번 프레임에서 쓰고 바로 교체(리사이즈)하는 리소스
+        auto resource = std::make_shared<FakeResource>(destroyed, frame);
+        const std::uint64_t fenceValue = timeline.Advance();
+        lastUse[frame] = fenceValue;
+
+        queue.Enqueue(timeline.GetLastSignaled(), [resource]() {});
+        resource.reset();
+
+        // GPU는 두 프레임 늦게 따라온다.
+        if (fenceValue > 2)
+            fence.Completed = fenceValue - 2;
+
+        queue.ReleaseCompleted(timeline.GetCompletedValue());
+        for (int id : destroyed)
+            CHECK(lastUse[id] <= fence.Completed);
+    }
+
+    CHECK_EQ(fence.WaitCount, 0);
+    CHECK_EQ(destroyed.size(), 6u);
+    CHECK_EQ(queue.GetPendingCount(), 2u);
+
+    // 종료 : 마지막 값까지 기다린 뒤 나머지를 놓는다.
+    timeline.Wait(timeline.GetLastSignaled());
+    queue.ReleaseCompleted(timeline.GetCompletedValue());
+    CHECK_EQ(destroyed.size(), 8u);
+    CHECK_EQ(fence.WaitCount, 1);
+}
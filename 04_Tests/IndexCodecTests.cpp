@@ -0,0 +1,274 @@
+#include "TestFramework.h"
+#include "../01_Core/IndexCodec.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // width x height 칸 격자 (칸마다 삼각형 두 개, 줄 순서)
+    std::vector<std::uint32_t> MakeGrid(std::uint32_t width, std::uint32_t height, std::uint32_t baseVertex)
+    {
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                const std::uint32_t v0 = baseVertex + y * (width + 1) + x;
+                const std::uint32_t v1 = v0 + 1;
+                const std::uint32_t v2 = v0 + width + 1;
+                const std::uint32_t v3 = v2 + 1;
+                indices.insert(indices.end(), { v0, v1, v2, v2, v1, v3 });
+            }
+        }
+        return indices;
+    }
+
+    std::vector<std::uint32_t> MakeRandom(Test::Random& random, std::uint32_t triangleCount, std::uint32_t vertexCount)
+    {
+        std::vector<std::uint32_t> indices(triangleCount * 3);
+        for (std::uint32_t& index : indices)
+            index = random.Next(vertexCount);
+        return indices;
+    }
+
+    std::vector<std::uint8_t> ToStride(const std::vector<std::uint32_t>& indices, std::uint32_t stride)
+    {
+        std::vector<std::uint8_t> bytes(indices.size() * stride);
+        if (!IndexCodec::Convert(indices.data(), indices.size(), bytes.data(), stride))
+            bytes.clear();
+        return bytes;
+    }
+
+    std::uint32_t LoadIndex(const std::vector<std::uint8_t>& bytes, std::size_t i, std::uint32_t stride)
+    {
+        if (stride == 2)
+        {
+            std::uint16_t value;
+            std::memcpy(&value, &bytes[i * 2], 2);
+            return value;
+        }
+        std::uint32_t value;
+        std::memcpy(&value, &bytes[i * 4], 4);
+        return value;
+    }
+
+    // 인코더가 삼각형 안 정점 순서를 회전할 수 있으므로 감기 방향만 같으면 같은 삼각형으로 본다.
+    bool IsSameTriangles(const std::vector<std::uint32_t>& indices, const std::vector<std::uint8_t>& decoded, std::uint32_t stride)
+    {
+        for (std::size_t t = 0; t < indices.size(); t += 3)
+        {
+            const std::uint32_t a = LoadIndex(decoded, t, stride);
+            const std::uint32_t b = LoadIndex(decoded, t + 1, stride);
+            const std::uint32_t c = LoadIndex(decoded, t + 2, stride);
+
+            bool isSame = false;
+            for (std::size_t r = 0; r < 3 && !isSame; ++r)
+                isSame = indices[t + r] == a && indices[t + (r + 1) % 3] == b && indices[t + (r + 2) % 3] == c;
+            if (!isSame)
+                return false;
+        }
+        return true;
+    }
+
+    // 한 번 압축하고 두 크기로 풀어서 원래 값과 비교 (16비트에 들어가지 않으면 16비트 풀기는 실패해야 한다)
+    bool IsRoundTrip(const std::vector<std::uint32_t>& indices, std::uint32_t encodeStride, std::string& error)
+    {
+        const std::vector<std::uint8_t> source = ToStride(indices, encodeStride);
+        if (source.size() != indices.size() * encodeStride)
+        {
+            error = "source does not fit the encode stride";
+            return false;
+        }
+
+        std::vector<std::uint8_t> encoded;
+        IndexCodec::Encode(source.data(), indices.size(), encodeStride, encoded);
+
+        for (std::uint32_t stride : { 2u, 4u })
+        {
+            const bool fits = IndexCodec::GetIndexStride(IndexCodec::GetMaxIndex(indices.data(), indices.size())) <= stride;
+
+            // 뒤에 표식을 두고 count개 너머에 쓰지 않는지 본다.
+            std::vector<std::uint8_t> decoded(indices.size() * stride + 16, 0xCD);
+            const bool isDecoded = IndexCodec::Decode(encoded.data(), encoded.size(), decoded.data(), indices.size(), stride);
+            if (isDecoded != fits)
+            {
+                error = "stride " + std::to_string(stride) + ": decode returned " + Test::ToString(isDecoded);
+                return false;
+            }
+            if (std::any_of(decoded.end() - 16, decoded.end(), [](std::uint8_t b) { return b != 0xCD; }))
+            {
+                error = "stride " + std::to_string(stride) + ": wrote past the end";
+                return false;
+            }
+            if (!fits)
+                continue;
+
+            if (!IsSameTriangles(indices, decoded, stride))
+            {
+                error = "stride " + std::to_string(stride) + ": indices differ";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CheckRoundTrip(const std::vector<std::uint32_t>& indices, std::uint32_t encodeStride, const char* name)
+    {
+        std::string error;
+        if (!IsRoundTrip(indices, encodeStride, error))
+            Test::Fail(__FILE__, __LINE__, std::string(name) + " (encode stride " + std::to_string(encodeStride) + "): " + error);
+    }
+}
+
+TEST_CASE(IndexCodec_GridRoundTrip)
+{
+    for (std::uint32_t stride : { 2u, 4u })
+    {
+        CheckRoundTrip(MakeGrid(1, 1, 0), stride, "1x1 grid");
+        CheckRoundTrip(MakeGrid(64, 48, 0), stride, "64x48 grid");
+        CheckRoundTrip(MakeGrid(255, 255, 0), stride, "255x255 grid");
+    }
+
+    // 16비트를 넘는 정점 번호는 32비트로만
+    CheckRoundTrip(MakeGrid(300, 300, 0), 4, "300x300 grid");
+    CheckRoundTrip(MakeGrid(16, 16, 0xFFFFFE00u), 4, "grid near 2^32");
+
+    // 격자는 거의 모든 삼각형이 앞 삼각형과 변을 공유하므로 삼각형당 1바이트 남짓
+    const std::vector<std::uint32_t> grid = MakeGrid(64, 64, 0);
+    std::vector<std::uint8_t> encoded;
+    IndexCodec::Encode(ToStride(grid, 4).data(), grid.size(), 4, encoded);
+    CHECK(encoded.size() < grid.size() / 3 * 2);
+}
+
+TEST_CASE(IndexCodec_RandomRoundTrip)
+{
+    Test::Random random(46);
+    for (int i = 0; i < 200; ++i)
+    {
+        const std::uint32_t triangleCount = random.Range(0, 500);
+        const std::uint32_t vertexCount = i % 4 == 0 ? random.Range(1, 8) : i % 4 == 1 ? random.Range(1, 0x10000) : random.Range(1, 0x7FFFFFFF);
+        const std::vector<std::uint32_t> indices = MakeRandom(random, triangleCount, vertexCount);
+
+        CheckRoundTrip(indices, 4, "random");
+        if (IndexCodec::GetMaxIndex(indices.data(), indices.size()) <= 0xFFFF)
+            CheckRoundTrip(indices, 2, "random");
+    }
+
+    // 섞은 격자 (공유 변이 FIFO 밖으로 밀려나고 회전된 삼각형이 섞인다)
+    std::vector<std::uint32_t> grid = MakeGrid(40, 40, 0);
+    for (std::size_t t = grid.size() / 3; t > 1; --t)
+    {
+        const std::size_t other = random.Next((std::uint32_t)t);
+        std::swap_ranges(grid.begin() + (t - 1) * 3, grid.begin() + t * 3, grid.begin() + other * 3);
+        std::rotate(grid.begin() + (t - 1) * 3, grid.begin() + (t - 1) * 3 + random.Next(3), grid.begin() + t * 3);
+    }
+    CheckRoundTrip(grid, 2, "shuffled grid");
+    CheckRoundTrip(grid, 4, "shuffled grid");
+
+    // 퇴화 삼각형
+    CheckRoundTrip({ 0, 0, 0, 1, 1, 2, 2, 1, 1, 5, 5, 5 }, 2, "degenerate");
+}
+
+TEST_CASE(IndexCodec_RejectsBadInput)
+{
+    const std::vector<std::uint32_t> indices = MakeGrid(8, 8, 1000);
+    std::vector<std::uint8_t> encoded;
+    IndexCodec::Encode(indices.data(), indices.size(), 4, encoded);
+
+    std::vector<std::uint32_t> decoded(indices.size());
+    REQUIRE(IndexCodec::Decode(encoded.data(), encoded.size(), decoded.data(), indices.size(), 4));
+
+    // 개수가 다르거나, 뒤에 쓰레기가 붙었거나, 지원하지 않는 크기
+    CHECK(!IndexCodec::Decode(encoded.data(), encoded.size(), decoded.data(), indices.size() - 3, 4));
+    std::vector<std::uint8_t> padded = encoded;
+    padded.push_back(0);
+    CHECK(!IndexCodec::Decode(padded.data(), padded.size(), decoded.data(), indices.size(), 4));
+    CHECK(!IndexCodec::Decode(encoded.data(), encoded.size(), decoded.data(), indices.size(), 1));
+    CHECK(!IndexCodec::Decode(encoded.data(), encoded.size(), decoded.data(), indices.size(), 8));
+
+    // 잘린 데이터는 끝을 넘어 읽지 않고 실패한다. (딱 맞는 크기로 복사해서 넘긴다)
+    for (std::size_t size = 0; size < encoded.size(); ++size)
+    {
+        const std::vector<std::uint8_t> truncated(encoded.begin(), encoded.begin() + size);
+        if (IndexCodec::Decode(truncated.data(), truncated.size(), decoded.data(), indices.size(), 4))
+        {
+            Test::Fail(__FILE__, __LINE__, "truncated to " + std::to_string(size) + " bytes was accepted");
+            break;
+        }
+    }
+
+    // 삼각형 수가 데이터보다 크면 코드를 읽기 전에 실패
+    std::vector<std::uint8_t> huge = encoded;
+    const std::uint32_t hugeCount = 0x7FFFFFFF;
+    std::memcpy(huge.data(), &hugeCount, sizeof(hugeCount));
+    CHECK(!IndexCodec::Decode(huge.data(), huge.size(), decoded.data(), (std::size_t)hugeCount * 3, 4));
+}
+
+TEST_CASE(IndexCodec_CorruptInputStaysInBounds)
+{
+    Test::Random random(146);
+    const std::vector<std::uint32_t> source = MakeRandom(random, 300, 5000);
+    std::vector<std::uint8_t> encoded;
+    IndexCodec::Encode(source.data(), source.size(), 4, encoded);
+
+    // 바이트를 바꾼 데이터는 실패하거나 count개 안에서만 쓴다. (주소 검사 빌드에서 읽기 범위도 확인된다)
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::vector<std::uint8_t> corrupted = encoded;
+        const std::uint32_t flips = random.Range(1, 4);
+        for (std::uint32_t f = 0; f < flips; ++f)
+        {
+            // 앞 4바이트(삼각형 수)는 두고 코드와 델타를 바꾼다.
+            const std::size_t at = 4 + random.Next((std::uint32_t)(corrupted.size() - 4));
+            corrupted[at] = (std::uint8_t)random.Next(256);
+        }
+        if (i % 8 == 0)
+            corrupted.resize(4 + random.Next((std::uint32_t)(corrupted.size() - 4)));
+
+        for (std::uint32_t stride : { 2u, 4u })
+        {
+            std::vector<std::uint8_t> decoded(source.size() * stride + 16, 0xCD);
+            IndexCodec::Decode(corrupted.data(), corrupted.size(), decoded.data(), source.size(), stride);
+            if (std::any_of(decoded.end() - 16, decoded.end(), [](std::uint8_t b) { return b != 0xCD; }))
+            {
+                Test::Fail(__FILE__, __LINE__, "corrupted input " + std::to_string(i) + " wrote past the end");
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(IndexCodec_Rejects16BitOverflow)
+{
+    const std::vector<std::uint32_t> indices = { 0, 1, 2, 2, 1, 0x10000 };
+    CHECK_EQ(IndexCodec::GetMaxIndex(indices.data(), indices.size()), 0x10000u);
+    CHECK_EQ(IndexCodec::GetIndexStride(0xFFFF), 2u);
+    CHECK_EQ(IndexCodec::GetIndexStride(0x10000), 4u);
+
+    // Convert는 16비트에 들어가지 않으면 dst를 건드리지 않고 실패한다.
+    std::vector<std::uint16_t> indices16(indices.size(), 0xABCD);
+    CHECK(!IndexCodec::Convert(indices.data(), indices.size(), indices16.data(), 2));
+    CHECK(std::all_of(indices16.begin(), indices16.end(), [](std::uint16_t v) { return v == 0xABCD; }));
+    CHECK(!IndexCodec::Convert(indices.data(), indices.size(), indices16.data(), 3));
+
+    // 32비트로 압축한 데이터를 16비트로 풀면 실패, 32비트로는 성공
+    std::vector<std::uint8_t> encoded;
+    IndexCodec::Encode(indices.data(), indices.size(), 4, encoded);
+    CHECK(!IndexCodec::Decode(encoded.data(), encoded.size(), indices16.data(), indices.size(), 2));
+
+    std::vector<std::uint8_t> decoded(indices.size() * 4);
+    CHECK(IndexCodec::Decode(encoded.data(), encoded.size(), decoded.data(), indices.size(), 4));
+    CHECK(IsSameTriangles(indices, decoded, 4));
+
+    // 0xFFFF까지는 16비트로 풀린다.
+    const std::vector<std::uint32_t> maxIndices = { 0xFFFF, 0, 0xFFFE };
+    encoded.clear();
+    IndexCodec::Encode(maxIndices.data(), maxIndices.size(), 4, encoded);
+    std::vector<std::uint8_t> decoded16(maxIndices.size() * 2);
+    CHECK(IndexCodec::Decode(encoded.data(), encoded.size(), decoded16.data(), maxIndices.size(), 2));
+    CHECK(IsSameTriangles(maxIndices, decoded16, 2));
+}
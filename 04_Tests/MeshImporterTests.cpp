@@ -0,0 +1,352 @@
+#include "TestFramework.h"
+#include "../01_Core/JobSystem.h"
+#include "../02_Engine/MeshImporter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    using MeshData = GeometryGenerator::MeshData;
+
+    void WriteFile(const std::string& path, const std::string& bytes)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+
+    JobSystem& GetJobs()
+    {
+        static JobSystem jobs;
+        static const bool isInitialized = (jobs.Initialize(4), true);
+        (void)isInitialized;
+        return jobs;
+    }
+
+    bool ImportObj(const std::string& text, MeshData& mesh, std::string* error = nullptr)
+    {
+        return MeshImporter::ImportObj(text.data(), text.size(), GetJobs(), mesh, error);
+    }
+
+    bool ImportPly(const std::string& bytes, MeshData& mesh, std::string* error = nullptr)
+    {
+        return MeshImporter::ImportPly(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size(), GetJobs(), mesh, error);
+    }
+
+    bool ImportGlb(const std::string& bytes, MeshData& mesh, std::string* error = nullptr)
+    {
+        return MeshImporter::ImportGltf("mesh.glb", reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size(), GetJobs(), mesh, error);
+    }
+
+    // 성공했다면 모든 인덱스가 정점 안을 가리켜야 한다.
+    bool HasValidIndices(const MeshData& mesh)
+    {
+        for (std::uint32_t index : mesh.Indices32)
+        {
+            if (index >= mesh.Vertices.size())
+                return false;
+        }
+        return mesh.Indices32.size() % 3 == 0;
+    }
+
+    void Append(std::string& bytes, const void* data, std::size_t size, bool isBigEndian = false)
+    {
+        const char* begin = static_cast<const char*>(data);
+        if (!isBigEndian)
+        {
+            bytes.append(begin, size);
+            return;
+        }
+        for (std::size_t i = size; i-- > 0;)
+            bytes.push_back(begin[i]);
+    }
+
+    const char* QuadObj =
+        "# quad\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        "f -4/-4/-1 -2/-2/-1 -1/-1/-1\n"
+        "f 1//1 2//1 3//1\r\n";
+
+    const char* QuadPlyAscii =
+        "ply\nformat ascii 1.0\ncomment quad\n"
+        "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n"
+        "property float nx\nproperty float ny\nproperty float nz\n"
+        "element face 1\nproperty uchar flags\nproperty list uchar int vertex_indices\n"
+        "end_header\n"
+        "0 0 0 0 0 1\n1 0 0 0 0 1\n1 1 0 0 0 1\n0 1 0 0 0 1\n"
+        "7 4 0 1 2 3\n";
+
+    std::string MakeTrianglePly(bool isBigEndian)
+    {
+        std::string bytes = std::string("ply\nformat ") + (isBigEndian ? "binary_big_endian" : "binary_little_endian") + " 1.0\n"
+            "element vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+            "element face 1\nproperty list uchar uint vertex_indices\nend_header\n";
+
+        const float positions[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 2 };
+        for (float value : positions)
+            Append(bytes, &value, 4, isBigEndian);
+        bytes.push_back(3);
+        const std::uint32_t indices[3] = { 0, 1, 2 };
+        for (std::uint32_t index : indices)
+            Append(bytes, &index, 4, isBigEndian);
+        return bytes;
+    }
+
+    // 위치 3개 + 16비트 인덱스 3개를 담은 .glb
+    std::string MakeTriangleGlb()
+    {
+        std::string bin;
+        const float positions[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+        const std::uint16_t indices[3] = { 0, 1, 2 };
+        Append(bin, positions, sizeof(positions));
+        Append(bin, indices, sizeof(indices));
+        while (bin.size() % 4 != 0)
+            bin.push_back('\0');
+
+        std::string json =
+            "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":44}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36},{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}],"
+            "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+            "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}],"
+            "\"meshes\":[{\"name\":\"tri\\u00e9\",\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}]}";
+        while (json.size() % 4 != 0)
+            json.push_back(' ');
+
+        std::string bytes;
+        auto appendU32 = [&bytes](std::uint32_t value) { Append(bytes, &value, 4); };
+        appendU32(0x46546C67);      // "glTF"
+        appendU32(2);
+        appendU32((std::uint32_t)(12 + 8 + json.size() + 8 + bin.size()));
+        appendU32((std::uint32_t)json.size());
+        appendU32(0x4E4F534A);      // "JSON"
+        bytes += json;
+        appendU32((std::uint32_t)bin.size());
+        appendU32(0x004E4942);      // "BIN"
+        bytes += bin;
+        return bytes;
+    }
+}
+
+TEST_CASE(Obj_MergesCornersAndFlipsWinding)
+{
+    MeshData mesh;
+    std::string error;
+    REQUIRE(ImportObj(QuadObj, mesh, &error));
+
+    // 사각형 2개 + 삼각형 2개, (위치, UV, 법선)이 같은 꼭짓점은 하나로 합친다.
+    CHECK_EQ(mesh.Indices32.size(), 12u);
+    CHECK_EQ(mesh.Vertices.size(), 7u);
+    CHECK(HasValidIndices(mesh));
+
+    // 1 2 3 -> 왼손 좌표계 감는 순서 1 3 2
+    CHECK_EQ(mesh.Indices32[0], 0u);
+    CHECK_EQ(mesh.Indices32[1], 1u);
+    CHECK_EQ(mesh.Indices32[2], 2u);
+    CHECK_EQ(mesh.Vertices[1].Position.x, 1.0f);
+    CHECK_EQ(mesh.Vertices[1].Position.y, 1.0f);
+    CHECK_EQ(mesh.Vertices[0].Normal.z, -1.0f);
+}
+
+TEST_CASE(Obj_RejectsBadInput)
+{
+    MeshData mesh;
+    std::string error;
+    CHECK(!ImportObj("v 0 0 0\nf 1 2 3\n", mesh, &error));
+    CHECK(!error.empty());
+
+    error.clear();
+    CHECK(!ImportObj("v 0 0 x\n", mesh, &error));
+    CHECK(!error.empty());
+}
+
+TEST_CASE(Ply_Ascii)
+{
+    MeshData mesh;
+    std::string error;
+    REQUIRE(ImportPly(QuadPlyAscii, mesh, &error));
+
+    // 앞의 스칼라 속성(flags)을 건너뛰고 목록을 읽는다.
+    REQUIRE(mesh.Vertices.size() == 4u);
+    REQUIRE(mesh.Indices32.size() == 6u);
+    CHECK_EQ(mesh.Indices32[0], 0u);
+    CHECK_EQ(mesh.Indices32[1], 2u);
+    CHECK_EQ(mesh.Indices32[2], 1u);
+    CHECK_EQ(mesh.Indices32[5], 2u);
+}
+
+TEST_CASE(Ply_BinaryBothEndians)
+{
+    for (bool isBigEndian : { false, true })
+    {
+        MeshData mesh;
+        std::string error;
+        REQUIRE(ImportPly(MakeTrianglePly(isBigEndian), mesh, &error));
+        REQUIRE(mesh.Vertices.size() == 3u);
+        REQUIRE(mesh.Indices32.size() == 3u);
+        CHECK_EQ(mesh.Vertices[2].Position.z, -2.0f);
+        CHECK_EQ(mesh.Indices32[1], 2u);
+    }
+}
+
+TEST_CASE(Ply_HeaderWithUnusualWhitespace)
+{
+    // '\v', '\f'로 나뉜 헤더도 토큰이 끝나야 한다. (예전에는 커서가 멈춘 채 토큰만 늘었다)
+    std::string ply = QuadPlyAscii;
+    ply.replace(ply.find("element vertex"), std::strlen("element vertex"), "element\vvertex");
+    ply.replace(ply.find("property float y"), std::strlen("property float y"), "property\ffloat y\f");
+
+    MeshData mesh;
+    std::string error;
+    CHECK(ImportPly(ply, mesh, &error));
+    CHECK_EQ(mesh.Vertices.size(), 4u);
+
+    CHECK(!ImportPly("ply\nformat ascii 1.0\n\v\f\v", mesh, &error));
+}
+
+TEST_CASE(Ply_RejectsCountsLargerThanFile)
+{
+    MeshData mesh;
+    std::string error;
+
+    // 속성이 있는 요소 : 남은 바이트로 담을 수 없는 개수
+    const std::string header = "ply\nformat binary_little_endian 1.0\n";
+    CHECK(!ImportPly(header + "element face 4000000000\nproperty list uchar uint vertex_indices\nend_header\n\x03", mesh, &error));
+    CHECK(!error.empty());
+    CHECK(!ImportPly(header + "element vertex 4000000000\nproperty float x\nend_header\n", mesh, &error));
+
+    // 속성이 없는 요소는 개수가 커도 읽을 것이 없다.
+    std::string ply = MakeTrianglePly(false);
+    ply.insert(ply.find("end_header"), "element junk 4000000000\n");
+    REQUIRE(ImportPly(ply, mesh, &error));
+    CHECK_EQ(mesh.Indices32.size(), 3u);
+}
+
+TEST_CASE(Gltf_Glb)
+{
+    MeshData mesh;
+    std::string error;
+    REQUIRE(ImportGlb(MakeTriangleGlb(), mesh, &error));
+    REQUIRE(mesh.Vertices.size() == 3u);
+    REQUIRE(mesh.Indices32.size() == 3u);
+    CHECK_EQ(mesh.Indices32[0], 0u);
+    CHECK_EQ(mesh.Indices32[1], 2u);
+    CHECK_EQ(mesh.Indices32[2], 1u);
+    CHECK_EQ(mesh.Vertices[1].Position.x, 1.0f);
+}
+
+TEST_CASE(Gltf_ExternalBuffer)
+{
+    // .gltf + 같은 폴더의 .bin
+    std::string bin;
+    const float positions[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+    Append(bin, positions, sizeof(positions));
+    WriteFile("triangle.bin", bin);
+    WriteFile("triangle.gltf",
+        "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":36,\"uri\":\"triangle.bin\"}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}]}");
+
+    MeshData mesh;
+    std::string error;
+    MeshImporter::Stats stats;
+    REQUIRE(MeshImporter::Import("triangle.gltf", GetJobs(), mesh, &error, &stats));
+    CHECK_EQ(mesh.Vertices.size(), 3u);
+    CHECK_EQ(stats.Triangles, 1u);
+
+    std::remove("triangle.bin");
+    CHECK(!MeshImporter::Import("triangle.gltf", GetJobs(), mesh, &error));
+    CHECK(!error.empty());
+}
+
+TEST_CASE(Import_ByExtension)
+{
+    WriteFile("quad.OBJ", QuadObj);
+    WriteFile("quad.ply", QuadPlyAscii);
+
+    MeshData mesh;
+    std::string error;
+    MeshImporter::Stats stats;
+    REQUIRE(MeshImporter::Import("quad.OBJ", GetJobs(), mesh, &error, &stats));
+    CHECK_EQ(stats.Triangles, 4u);
+    CHECK_EQ(stats.Vertices, 7u);
+    REQUIRE(MeshImporter::Import("quad.ply", GetJobs(), mesh, &error, &stats));
+    CHECK_EQ(stats.Triangles, 2u);
+
+    CHECK(!MeshImporter::Import("missing.obj", GetJobs(), mesh, &error));
+    CHECK(!MeshImporter::Import("quad.txt", GetJobs(), mesh, &error));
+}
+
+// 잘린 파일 : 어느 길이에서 끊겨도 멈추거나 범위 밖을 읽지 않고, 성공하면 인덱스가 유효하다.
+TEST_CASE(Import_TruncatedInputs)
+{
+    const std::string plyAscii = QuadPlyAscii;
+    const std::string plyBinary = MakeTrianglePly(false);
+    const std::string glb = MakeTriangleGlb();
+    const std::string obj = QuadObj;
+
+    MeshData mesh;
+    for (std::size_t size = 0; size < plyBinary.size(); ++size)
+    {
+        CHECK(!ImportPly(plyBinary.substr(0, size), mesh) || HasValidIndices(mesh));
+    }
+    for (std::size_t size = 0; size < glb.size(); ++size)
+    {
+        // 바이너리 청크가 잘리면 선언된 길이를 채울 수 없다.
+        CHECK(!ImportGlb(glb.substr(0, size), mesh));
+    }
+    for (std::size_t size = 0; size < plyAscii.size(); ++size)
+    {
+        CHECK(!ImportPly(plyAscii.substr(0, size), mesh) || HasValidIndices(mesh));
+    }
+    for (std::size_t size = 0; size < obj.size(); ++size)
+    {
+        CHECK(!ImportObj(obj.substr(0, size), mesh) || HasValidIndices(mesh));
+    }
+}
+
+// 바이트를 바꾸거나 넣고 빼도 결과가 유효하거나 실패해야 한다.
+TEST_CASE(Import_CorruptedInputs)
+{
+    const std::string sources[] = { QuadObj, QuadPlyAscii, MakeTrianglePly(false), MakeTrianglePly(true), MakeTriangleGlb() };
+    const char alphabet[] = "0123456789-+/ \n\r\t\v\f.efv#";
+
+    Test::Random random(41);
+    for (int iteration = 0; iteration < 3000; ++iteration)
+    {
+        const int sourceIndex = iteration % 5;
+        std::string bytes = sources[sourceIndex];
+        const std::uint32_t mutationCount = random.Range(1, 4);
+        for (std::uint32_t k = 0; k < mutationCount && !bytes.empty(); ++k)
+        {
+            const std::size_t position = random.Next((std::uint32_t)bytes.size());
+            switch (random.Next(4))
+            {
+            case 0: bytes.erase(position, 1); break;
+            case 1: bytes.insert(bytes.begin() + position, alphabet[random.Next(sizeof(alphabet) - 1)]); break;
+            case 2: bytes[position] ^= (char)(1 << random.Next(8)); break;
+            default: bytes.resize(position); break;
+            }
+        }
+
+        MeshData mesh;
+        bool isImported = false;
+        if (sourceIndex == 0)
+            isImported = ImportObj(bytes, mesh);
+        else if (sourceIndex == 4)
+            isImported = ImportGlb(bytes, mesh);
+        else
+            isImported = ImportPly(bytes, mesh);
+
+        if (isImported && !HasValidIndices(mesh))
+        {
+            Test::Fail(__FILE__, __LINE__, "bad index at iteration " + std::to_string(iteration));
+            return;
+        }
+    }
+}
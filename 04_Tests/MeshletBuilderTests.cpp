@@ -0,0 +1,321 @@
+#include "TestFramework.h"
+#include "../01_Core/MeshFile.h"
+#include "../02_Engine/MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using MeshData = GeometryGenerator::MeshData;
+    using Triangle = std::tuple<std::uint32_t, std::uint32_t, std::uint32_t>;
+
+    // 감는 순서는 두고 가장 작은 번호가 앞에 오게 돌린다.
+    Triangle MakeTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+    {
+        if (b < a && b < c)
+            return Triangle(b, c, a);
+        if (c < a && c < b)
+            return Triangle(c, a, b);
+        return Triangle(a, b, c);
+    }
+
+    void GetMeshletTriangle(const MeshletBuilder::MeshletData& data, const MeshFileMeshlet& meshlet, std::uint32_t i, std::uint32_t corners[3])
+    {
+        MeshletBuilder::UnpackTriangle(data.Triangles[meshlet.TriangleOffset + i], corners[0], corners[1], corners[2]);
+        for (int k = 0; k < 3; ++k)
+            corners[k] = data.Vertices[meshlet.VertexOffset + corners[k]];
+    }
+
+    // 메시렛 표가 원래 삼각형을 정확히 한 번씩 담고, 제한과 경계 구를 지키는지
+    bool IsValidMeshlets(const MeshData& mesh, const MeshletBuilder::MeshletData& data, std::uint32_t maxVertices, std::uint32_t maxTriangles, std::string& error)
+    {
+        std::vector<Triangle> expected;
+        for (std::size_t i = 0; i + 2 < mesh.Indices32.size(); i += 3)
+            expected.push_back(MakeTriangle(mesh.Indices32[i], mesh.Indices32[i + 1], mesh.Indices32[i + 2]));
+
+        std::vector<Triangle> actual;
+        for (std::size_t m = 0; m < data.Meshlets.size(); ++m)
+        {
+            const MeshFileMeshlet& meshlet = data.Meshlets[m];
+            if (meshlet.VertexCount > maxVertices || meshlet.TriangleCount > maxTriangles || meshlet.TriangleCount == 0 ||
+                meshlet.VertexOffset + meshlet.VertexCount > data.Vertices.size() || meshlet.TriangleOffset + meshlet.TriangleCount > data.Triangles.size())
+            {
+                error = "bad counts in meshlet " + std::to_string(m);
+                return false;
+            }
+
+            for (std::uint32_t i = 0; i < meshlet.TriangleCount; ++i)
+            {
+                std::uint32_t local[3];
+                MeshletBuilder::UnpackTriangle(data.Triangles[meshlet.TriangleOffset + i], local[0], local[1], local[2]);
+                if (local[0] >= meshlet.VertexCount || local[1] >= meshlet.VertexCount || local[2] >= meshlet.VertexCount)
+                {
+                    error = "local index out of range in meshlet " + std::to_string(m);
+                    return false;
+                }
+
+                std::uint32_t corners[3];
+                GetMeshletTriangle(data, meshlet, i, corners);
+                actual.push_back(MakeTriangle(corners[0], corners[1], corners[2]));
+            }
+
+            for (std::uint32_t i = 0; i < meshlet.VertexCount; ++i)
+            {
+                const DirectX::XMFLOAT3& p = mesh.Vertices[data.Vertices[meshlet.VertexOffset + i]].Position;
+                const float dx = p.x - meshlet.Center[0], dy = p.y - meshlet.Center[1], dz = p.z - meshlet.Center[2];
+                if (std::sqrt(dx * dx + dy * dy + dz * dz) > meshlet.Radius * 1.0001f + 1e-5f)
+                {
+                    error = "vertex outside the bounding sphere of meshlet " + std::to_string(m);
+                    return false;
+                }
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        if (expected != actual)
+        {
+            error = "meshlets do not cover every triangle exactly once";
+            return false;
+        }
+        return true;
+    }
+
+    // 원뿔이 뒷면이라고 한 카메라에서는 메시렛의 모든 삼각형이 실제로 뒷면이어야 한다. (왼손, 시계 방향이 앞면)
+    // 컬링된 메시렛 수를 돌려준다.
+    int CheckConeCulling(const MeshData& mesh, const MeshletBuilder::MeshletData& data, std::uint64_t seed, int& wrongCount)
+    {
+        Test::Random random(seed);
+        int culledCount = 0;
+        for (int c = 0; c < 64; ++c)
+        {
+            const float camera[3] = { random.NextFloat() * 20.0f - 10.0f, random.NextFloat() * 20.0f - 10.0f, random.NextFloat() * 20.0f - 10.0f };
+            for (const MeshFileMeshlet& meshlet : data.Meshlets)
+            {
+                const float v[3] = { meshlet.ConeApex[0] - camera[0], meshlet.ConeApex[1] - camera[1], meshlet.ConeApex[2] - camera[2] };
+                const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                if (length == 0.0f || (v[0] * meshlet.ConeAxis[0] + v[1] * meshlet.ConeAxis[1] + v[2] * meshlet.ConeAxis[2]) / length < meshlet.ConeCutoff)
+                    continue;
+
+                ++culledCount;
+                for (std::uint32_t i = 0; i < meshlet.TriangleCount; ++i)
+                {
+                    std::uint32_t corners[3];
+                    GetMeshletTriangle(data, meshlet, i, corners);
+                    const DirectX::XMFLOAT3& p0 = mesh.Vertices[corners[0]].Position;
+                    const DirectX::XMFLOAT3& p1 = mesh.Vertices[corners[1]].Position;
+                    const DirectX::XMFLOAT3& p2 = mesh.Vertices[corners[2]].Position;
+                    const float e1[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+                    const float e2[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+                    const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                    const float w[3] = { camera[0] - p0.x, camera[1] - p0.y, camera[2] - p0.z };
+                    if (n[0] * w[0] + n[1] * w[1] + n[2] * w[2] > 1e-4f)
+                        ++wrongCount;
+                }
+            }
+        }
+        return culledCount;
+    }
+}
+
+TEST_CASE(Meshlet_CoversEveryTriangle)
+{
+    GeometryGenerator generator;
+    const MeshData meshes[] =
+    {
+        generator.CreateBox(1.0f, 2.0f, 3.0f, 0),
+        generator.CreateSphere(1.0f, 40, 40),
+        generator.CreateGeosphere(1.0f, 3),
+        generator.CreateGrid(10.0f, 10.0f, 120, 80),
+        generator.CreateCylinder(1.0f, 0.5f, 2.0f, 30, 10),
+    };
+
+    for (const MeshData& mesh : meshes)
+    {
+        MeshletBuilder::MeshletData data;
+        const MeshletBuilder::Stats stats = MeshletBuilder::Build(mesh, data);
+        CHECK_EQ(stats.MeshletCount, (std::uint32_t)data.Meshlets.size());
+
+        std::string error;
+        if (!IsValidMeshlets(mesh, data, MeshletBuilder::DefaultMaxVertices, MeshletBuilder::DefaultMaxTriangles, error))
+            Test::Fail(__FILE__, __LINE__, error);
+    }
+}
+
+TEST_CASE(Meshlet_RespectsCustomLimits)
+{
+    GeometryGenerator generator;
+    const MeshData mesh = generator.CreateGeosphere(1.0f, 4);
+
+    const std::uint32_t limits[][2] = { { 3, 1 }, { 16, 16 }, { 128, 256 }, { 256, 512 }, { 1000, 1000 } };
+    for (const auto& limit : limits)
+    {
+        MeshletBuilder::MeshletData data;
+        MeshletBuilder::Build(mesh, data, limit[0], limit[1]);
+
+        // 한계를 넘는 값은 8비트 정점 번호에 맞게 줄어든다.
+        const std::uint32_t maxVertices = std::min<std::uint32_t>(limit[0], MeshletBuilder::MaxVerticesLimit);
+        const std::uint32_t maxTriangles = std::min<std::uint32_t>(limit[1], MeshletBuilder::MaxTrianglesLimit);
+        std::string error;
+        if (!IsValidMeshlets(mesh, data, maxVertices, maxTriangles, error))
+            Test::Fail(__FILE__, __LINE__, error + " (limit " + std::to_string(limit[0]) + "/" + std::to_string(limit[1]) + ")");
+    }
+}
+
+TEST_CASE(Meshlet_FillsLocalMeshlets)
+{
+    // 격자는 정점을 공유하는 삼각형이 많아서 메시렛이 거의 가득 찬다.
+    GeometryGenerator generator;
+    const MeshData mesh = generator.CreateGrid(10.0f, 10.0f, 101, 101);
+
+    MeshletBuilder::MeshletData data;
+    const MeshletBuilder::Stats stats = MeshletBuilder::Build(mesh, data);
+    CHECK(stats.AverageTriangles > 0.7f * MeshletBuilder::DefaultMaxTriangles);
+    CHECK(stats.AverageVertices <= (float)MeshletBuilder::DefaultMaxVertices);
+
+    // 평면의 법선은 한 방향이라 모든 메시렛을 원뿔로 컬링할 수 있다.
+    CHECK_EQ(stats.ConeCullable, 1.0f);
+}
+
+TEST_CASE(Meshlet_ConeCullingIsConservative)
+{
+    GeometryGenerator generator;
+    const MeshData meshes[] = { generator.CreateSphere(1.0f, 30, 30), generator.CreateGeosphere(2.0f, 3), generator.CreateCylinder(1.0f, 1.0f, 3.0f, 24, 6) };
+
+    int culledCount = 0;
+    int wrongCount = 0;
+    for (std::size_t i = 0; i < std::size(meshes); ++i)
+    {
+        MeshletBuilder::MeshletData data;
+        MeshletBuilder::Build(meshes[i], data);
+        culledCount += CheckConeCulling(meshes[i], data, i + 1, wrongCount);
+    }
+
+    CHECK(culledCount > 0);
+    CHECK_EQ(wrongCount, 0);
+}
+
+TEST_CASE(Meshlet_EmptyAndDegenerate)
+{
+    MeshletBuilder::MeshletData data;
+    MeshData empty;
+    CHECK_EQ(MeshletBuilder::Build(empty, data).MeshletCount, 0u);
+    CHECK(data.Vertices.empty() && data.Triangles.empty());
+
+    // 넓이가 0인 삼각형은 원뿔을 만들지 않는다. (컬링 불가)
+    MeshData degenerate;
+    degenerate.Vertices.resize(3);
+    degenerate.Vertices[1].Position = DirectX::XMFLOAT3(1.0f, 0.0f, 0.0f);
+    degenerate.Vertices[2].Position = DirectX::XMFLOAT3(2.0f, 0.0f, 0.0f);
+    degenerate.Indices32 = { 0, 1, 2, 0, 1, 2 };
+    REQUIRE(MeshletBuilder::Build(degenerate, data).MeshletCount == 1u);
+    CHECK_EQ(data.Meshlets[0].TriangleCount, 2u);
+    CHECK_EQ(data.Meshlets[0].VertexCount, 3u);
+    CHECK_EQ(data.Meshlets[0].ConeCutoff, 1.0f);
+}
+
+TEST_CASE(Meshlet_PackTriangle)
+{
+    for (std::uint32_t a : { 0u, 1u, 127u, 255u })
+    {
+        const std::uint32_t packed = MeshletBuilder::PackTriangle(a, 255 - a, a / 2);
+        CHECK_EQ(packed >> 24, 0u);
+
+        std::uint32_t x, y, z;
+        MeshletBuilder::UnpackTriangle(packed, x, y, z);
+        CHECK_EQ(x, a);
+        CHECK_EQ(y, 255 - a);
+        CHECK_EQ(z, a / 2);
+    }
+}
+
+// 메시 파일에 넣었다가 읽어도 메시렛 표가 그대로여야 한다. 범위를 벗어난 메시렛은 열지 않는다.
+TEST_CASE(Meshlet_MeshFileRoundTrip)
+{
+    GeometryGenerator generator;
+    const MeshData mesh = generator.CreateGeosphere(1.0f, 2);
+    MeshletBuilder::MeshletData data;
+    MeshletBuilder::Build(mesh, data);
+
+    std::vector<DirectX::XMFLOAT3> positions;
+    for (const GeometryGenerator::Vertex& vertex : mesh.Vertices)
+        positions.push_back(vertex.Position);
+
+    MeshFileDesc desc;
+    MeshFileVertexStream stream;
+    stream.Data = positions.data();
+    stream.Stride = sizeof(DirectX::XMFLOAT3);
+    desc.VertexStreams.push_back(stream);
+    desc.VertexCount = (std::uint32_t)positions.size();
+    desc.Indices = mesh.Indices32.data();
+    desc.IndexStride = 4;
+    desc.IndexCount = (std::uint32_t)mesh.Indices32.size();
+    MeshFileSubmesh submesh;
+    submesh.IndexCount = desc.IndexCount;
+    desc.Submeshes.push_back(submesh);
+    desc.Meshlets = data.Meshlets;
+    desc.MeshletVertices = data.Vertices;
+    desc.MeshletTriangles = data.Triangles;
+    REQUIRE(MeshFile::Write("meshlets.mesh", desc));
+
+    std::uint64_t meshletOffset = 0;
+    {
+        MeshFile file;
+        REQUIRE(file.Open("meshlets.mesh"));
+        const MeshFileHeader& header = file.GetHeader();
+        REQUIRE(header.MeshletCount == data.Meshlets.size());
+        REQUIRE(header.MeshletVertexCount == data.Vertices.size());
+        REQUIRE(header.MeshletTriangleCount == data.Triangles.size());
+        CHECK_EQ(header.MeshletOffset % 16, 0u);
+        CHECK(std::memcmp(file.GetMeshlets(), data.Meshlets.data(), data.Meshlets.size() * sizeof(MeshFileMeshlet)) == 0);
+        CHECK(std::equal(data.Vertices.begin(), data.Vertices.end(), file.GetMeshletVertices()));
+        CHECK(std::equal(data.Triangles.begin(), data.Triangles.end(), file.GetMeshletTriangles()));
+        meshletOffset = header.MeshletOffset;
+    }
+
+    // 첫 메시렛의 삼각형 수를 표보다 크게 바꾼다.
+    FILE* file = std::fopen("meshlets.mesh", "r+b");
+    REQUIRE(file != nullptr);
+    const std::uint32_t triangleCount = (std::uint32_t)data.Triangles.size() + 1;
+    std::fseek(file, (long)(meshletOffset + offsetof(MeshFileMeshlet, TriangleCount)), SEEK_SET);
+    std::fwrite(&triangleCount, sizeof(triangleCount), 1, file);
+    std::fclose(file);
+
+    MeshFile corrupted;
+    CHECK(!corrupted.Open("meshlets.mesh"));
+    std::remove("meshlets.mesh");
+}
+
+// 큰 메시의 메시렛 생성 시간과 채움 정도 (결과는 출력으로 본다)
+TEST_CASE(Meshlet_Benchmark)
+{
+    GeometryGenerator generator;
+    const struct
+    {
+        const char* Name;
+        MeshData Mesh;
+    } cases[] =
+    {
+        { "sphere 256x256", generator.CreateSphere(1.0f, 256, 256) },
+        { "geosphere 6", generator.CreateGeosphere(1.0f, 6) },
+        { "grid 400x400", generator.CreateGrid(10.0f, 10.0f, 400, 400) },
+    };
+
+    for (const auto& test : cases)
+    {
+        MeshletBuilder::MeshletData data;
+        const MeshletBuilder::Stats stats = MeshletBuilder::Build(test.Mesh, data);
+        std::printf("  %s", MeshletBuilder::GetStatsString(test.Name, stats).c_str());
+
+        CHECK_EQ(data.Triangles.size(), test.Mesh.Indices32.size() / 3);
+        CHECK(stats.AverageTriangles > 0.5f * MeshletBuilder::DefaultMaxTriangles);
+    }
+}
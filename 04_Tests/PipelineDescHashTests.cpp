@@ -0,0 +1,207 @@
+#include "TestFramework.h"
+#include "../01_Core/PipelineDescHash.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    // D3D12 enum 값
+    const std::uint32_t FillSolid = 3;
+    const std::uint32_t FillWireframe = 2;
+    const std::uint32_t CullBack = 3;
+    const std::uint32_t ComparisonLess = 2;
+    const std::uint32_t ComparisonLessEqual = 4;
+    const std::uint32_t FormatR8G8B8A8Unorm = 28;
+    const std::uint32_t FormatR16G16B16A16Float = 10;
+    const std::uint32_t FormatD24UnormS8Uint = 45;
+    const std::uint32_t TopologyTriangle = 3;
+
+    struct TestShaders
+    {
+        std::vector<std::uint8_t> VS = std::vector<std::uint8_t>(64, 0x11);
+        std::vector<std::uint8_t> PS = std::vector<std::uint8_t>(48, 0x22);
+    };
+
+    // 에디터 불투명 PSO와 같은 구성 (CD3DX12_*_DESC(D3D12_DEFAULT) 값)
+    GraphicsPipelineDesc MakeOpaqueDesc(const TestShaders& shaders)
+    {
+        GraphicsPipelineDesc desc;
+        desc.RootSignatureHash = 0x1234;
+        desc.VS = { shaders.VS.data(), shaders.VS.size() };
+        desc.PS = { shaders.PS.data(), shaders.PS.size() };
+
+        desc.BlendState.RenderTarget[0].SrcBlend = 2;
+        desc.BlendState.RenderTarget[0].DestBlend = 1;
+        desc.BlendState.RenderTarget[0].BlendOp = 1;
+        desc.BlendState.RenderTarget[0].RenderTargetWriteMask = 0xF;
+        desc.SampleMask = 0xFFFFFFFF;
+
+        desc.RasterizerState.FillMode = FillSolid;
+        desc.RasterizerState.CullMode = CullBack;
+        desc.RasterizerState.DepthClipEnable = 1;
+
+        desc.DepthStencilState.DepthEnable = 1;
+        desc.DepthStencilState.DepthWriteMask = 1;
+        desc.DepthStencilState.DepthFunc = ComparisonLess;
+        desc.DepthStencilState.StencilReadMask = 0xFF;
+        desc.DepthStencilState.StencilWriteMask = 0xFF;
+
+        PipelineInputElementDesc position;
+        position.SemanticName = "POSITION";
+        position.Format = 10;
+        PipelineInputElementDesc color;
+        color.SemanticName = "COLOR";
+        color.Format = FormatR8G8B8A8Unorm;
+        color.InputSlot = 1;
+        desc.InputLayout = { position, color };
+
+        desc.PrimitiveTopologyType = TopologyTriangle;
+        desc.NumRenderTargets = 1;
+        desc.RTVFormats[0] = FormatR8G8B8A8Unorm;
+        desc.DSVFormat = FormatD24UnormS8Uint;
+        return desc;
+    }
+}
+
+TEST_CASE(PipelineDescHash_IgnoresPointerValues)
+{
+    // 셰이더/시맨틱 이름이 다른 메모리에 있어도 내용이 같으면 같은 키
+    TestShaders a;
+    TestShaders b;
+    const std::string semantic = std::string("POSI") + "TION";
+
+    GraphicsPipelineDesc descA = MakeOpaqueDesc(a);
+    GraphicsPipelineDesc descB = MakeOpaqueDesc(b);
+    descB.InputLayout[0].SemanticName = semantic.c_str();
+    REQUIRE(descA.VS.Data != descB.VS.Data);
+    CHECK_EQ(HashGraphicsPipelineDesc(descA), HashGraphicsPipelineDesc(descB));
+}
+
+TEST_CASE(PipelineDescHash_IgnoresUnusedFields)
+{
+    TestShaders shaders;
+    const GraphicsPipelineDesc base = MakeOpaqueDesc(shaders);
+    const std::uint64_t baseHash = HashGraphicsPipelineDesc(base);
+
+    // 쓰지 않는 렌더 타겟 슬롯의 포맷
+    GraphicsPipelineDesc desc = base;
+    desc.RTVFormats[3] = FormatR16G16B16A16Float;
+    CHECK_EQ(HashGraphicsPipelineDesc(desc), baseHash);
+
+    // 블렌드가 꺼져 있으면 블렌드 인자, IndependentBlendEnable이 꺼져 있으면 1번 이후 설정
+    desc = base;
+    desc.BlendState.RenderTarget[0].SrcBlend = 5;
+    desc.BlendState.RenderTarget[1].BlendEnable = 1;
+    CHECK_EQ(HashGraphicsPipelineDesc(desc), baseHash);
+
+    // 스텐실이 꺼져 있으면 스텐실 설정
+    desc = base;
+    desc.DepthStencilState.StencilReadMask = 0x0F;
+    desc.DepthStencilState.FrontFace.StencilFunc = ComparisonLessEqual;
+    CHECK_EQ(HashGraphicsPipelineDesc(desc), baseHash);
+
+    // 정점 데이터의 InstanceDataStepRate
+    desc = base;
+    desc.InputLayout[1].InstanceDataStepRate = 4;
+    CHECK_EQ(HashGraphicsPipelineDesc(desc), baseHash);
+
+    // -0.0과 0.0
+    desc = base;
+    desc.RasterizerState.SlopeScaledDepthBias = -0.0f;
+    CHECK_EQ(HashGraphicsPipelineDesc(desc), baseHash);
+}
+
+TEST_CASE(PipelineDescHash_DetectsResultChanges)
+{
+    TestShaders shaders;
+    const GraphicsPipelineDesc base = MakeOpaqueDesc(shaders);
+    const std::uint64_t baseHash = HashGraphicsPipelineDesc(base);
+
+    std::vector<GraphicsPipelineDesc> variants;
+
+    GraphicsPipelineDesc desc = base;
+    desc.RasterizerState.FillMode = FillWireframe;
+    variants.push_back(desc);
+
+    desc = base;
+    desc.DepthStencilState.DepthFunc = ComparisonLessEqual;
+    variants.push_back(desc);
+
+    desc = base;
+    desc.RootSignatureHash = 0x1235;
+    variants.push_back(desc);
+
+    desc = base;
+    desc.PS = {};
+    variants.push_back(desc);
+
+    desc = base;
+    desc.InputLayout.pop_back();
+    variants.push_back(desc);
+
+    desc = base;
+    desc.InputLayout[1].InputSlotClass = 1;
+    desc.InputLayout[1].InstanceDataStepRate = 1;
+    variants.push_back(desc);
+
+    desc = base;
+    desc.BlendState.RenderTarget[0].RenderTargetWriteMask = 0;
+    variants.push_back(desc);
+
+    desc = base;
+    desc.NumRenderTargets = 2;
+    variants.push_back(desc);
+
+    desc = base;
+    desc.SampleCount = 4;
+    variants.push_back(desc);
+
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        const std::uint64_t hash = HashGraphicsPipelineDesc(variants[i]);
+        CHECK(hash != baseHash);
+        for (size_t j = 0; j < i; ++j)
+            CHECK(hash != HashGraphicsPipelineDesc(variants[j]));
+    }
+
+    // 셰이더 바이트코드 한 바이트
+    TestShaders changed;
+    changed.PS[47] ^= 1;
+    CHECK(HashGraphicsPipelineDesc(MakeOpaqueDesc(changed)) != baseHash);
+}
+
+TEST_CASE(PipelineDescHash_StreamOutput)
+{
+    TestShaders shaders;
+    GraphicsPipelineDesc base = MakeOpaqueDesc(shaders);
+
+    PipelineStreamOutputEntry entry;
+    entry.SemanticName = "SV_POSITION";
+    entry.ComponentCount = 4;
+    base.StreamOutputEntries.push_back(entry);
+    base.StreamOutputStrides.push_back(16);
+    const std::uint64_t baseHash = HashGraphicsPipelineDesc(base);
+
+    GraphicsPipelineDesc desc = base;
+    desc.StreamOutputStrides[0] = 32;
+    CHECK(HashGraphicsPipelineDesc(desc) != baseHash);
+
+    desc = base;
+    desc.StreamOutputEntries[0].SemanticName = "TEXCOORD";
+    CHECK(HashGraphicsPipelineDesc(desc) != baseHash);
+
+    // 스트림 출력이 없으면 스트라이드/래스터라이즈 스트림은 보지 않는다.
+    GraphicsPipelineDesc empty = MakeOpaqueDesc(shaders);
+    GraphicsPipelineDesc emptyStrides = empty;
+    emptyStrides.RasterizedStream = 1;
+    CHECK_EQ(HashGraphicsPipelineDesc(empty), HashGraphicsPipelineDesc(emptyStrides));
+}
+
+// 키는 파이프라인 라이브러리 이름으로 디스크에 남으므로 실행/플랫폼/컴파일러가 바뀌어도 같아야 한다.
+// 이 값이 바뀌면 기존 PipelineCache.bin을 모두 다시 컴파일하게 된다.
+TEST_CASE(PipelineDescHash_StableAcrossBuilds)
+{
+    TestShaders shaders;
+    CHECK_EQ(HashGraphicsPipelineDesc(MakeOpaqueDesc(shaders)), 8088697805386283366ull);
+}
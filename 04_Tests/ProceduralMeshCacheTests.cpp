@@ -0,0 +1,299 @@
+#include "TestFramework.h"
+#include "../01_Core/JobSystem.h"
+#include "../02_Engine/ProceduralMeshCache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<std::uint8_t> ReadFile(const std::string& path)
+    {
+        std::vector<std::uint8_t> bytes;
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            return bytes;
+        std::fseek(file, 0, SEEK_END);
+        bytes.resize((std::size_t)std::ftell(file));
+        std::fseek(file, 0, SEEK_SET);
+        std::fread(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+        return bytes;
+    }
+
+    void WriteFile(const std::string& path, const std::vector<std::uint8_t>& bytes)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+
+    // 위치(float3) / 법선(float3) 두 스트림으로 쓰는 싱크
+    class TestSink
+    {
+    public:
+        static const std::uint32_t StreamCount = 2;
+
+        explicit TestSink(ProceduralMesh& mesh) : mMesh(mesh) {}
+
+        void Begin(std::uint32_t vertexCount, std::uint32_t indexCount)
+        {
+            const std::uint32_t strides[StreamCount] = { 12, 12 };
+            mMesh.Allocate(vertexCount, indexCount, strides, StreamCount);
+        }
+        void WriteVertex(std::uint32_t i, const GeometryGenerator::Vertex& vertex)
+        {
+            std::memcpy(mMesh.GetVertexData(0) + i * 12, &vertex.Position, 12);
+            std::memcpy(mMesh.GetVertexData(1) + i * 12, &vertex.Normal, 12);
+        }
+        void WriteIndex(std::uint32_t i, std::uint32_t index) { mMesh.GetIndices()[i] = index; }
+
+    private:
+        ProceduralMesh& mMesh;
+    };
+
+    // 몇 번 만들었는지 세는 생성 함수
+    struct Builder
+    {
+        GeometryGenerator Generator;
+        std::atomic<int> BuildCount{ 0 };
+
+        ProceduralMeshCache::BuildFunction Get()
+        {
+            return [this](const ProceduralMeshDesc& desc, ProceduralMesh& mesh)
+            {
+                ++BuildCount;
+                TestSink sink(mesh);
+                desc.Create(Generator, sink);
+
+                const float scale[3] = { 1.0f, 2.0f, 3.0f };
+                const float offset[3] = { 4.0f, 5.0f, 6.0f };
+                mesh.SetPositionTransform(scale, offset);
+            };
+        }
+    };
+
+    bool IsSameMesh(const ProceduralMesh& a, const ProceduralMesh& b)
+    {
+        if (a.GetVertexCount() != b.GetVertexCount() || a.GetIndexCount() != b.GetIndexCount() || a.GetStreamCount() != b.GetStreamCount())
+            return false;
+        for (std::uint32_t i = 0; i < a.GetStreamCount(); ++i)
+        {
+            if (a.GetVertexStride(i) != b.GetVertexStride(i) ||
+                std::memcmp(a.GetVertexData(i), b.GetVertexData(i), (std::size_t)a.GetVertexStride(i) * a.GetVertexCount()) != 0)
+                return false;
+        }
+        return std::memcmp(a.GetIndices(), b.GetIndices(), a.GetIndexCount() * sizeof(std::uint32_t)) == 0 &&
+            std::memcmp(a.GetPositionScale(), b.GetPositionScale(), 3 * sizeof(float)) == 0 &&
+            std::memcmp(a.GetPositionOffset(), b.GetPositionOffset(), 3 * sizeof(float)) == 0;
+    }
+
+    const ProceduralMeshDesc AllShapes[] =
+    {
+        ProceduralMeshDesc::Box(1.0f, 2.0f, 3.0f, 2),
+        ProceduralMeshDesc::Sphere(1.0f, 16, 12),
+        ProceduralMeshDesc::Geosphere(1.0f, 2),
+        ProceduralMeshDesc::Cylinder(1.0f, 0.5f, 2.0f, 10, 4),
+        ProceduralMeshDesc::Grid(4.0f, 3.0f, 5, 7),
+    };
+}
+
+TEST_CASE(ProceduralMeshCache_MissThenHit)
+{
+    Builder builder;
+    ProceduralMeshCache cache;
+    cache.Open("", 1u << 20);
+
+    const ProceduralMeshDesc desc = ProceduralMeshDesc::Sphere(1.0f, 16, 12);
+    std::shared_ptr<const ProceduralMesh> a = cache.GetOrCreate(desc, 7, builder.Get());
+    std::shared_ptr<const ProceduralMesh> b = cache.GetOrCreate(desc, 7, builder.Get());
+    REQUIRE(a != nullptr);
+    CHECK(a == b);
+    CHECK_EQ(builder.BuildCount.load(), 1);
+    CHECK_EQ(cache.GetStats().Misses, 1u);
+    CHECK_EQ(cache.GetStats().Hits, 1u);
+    CHECK_EQ(cache.GetStats().DiskHits, 0u);
+
+    // 정점 형식이나 매개변수가 다르면 다른 메시
+    CHECK(cache.GetOrCreate(desc, 8, builder.Get()) != a);
+    CHECK(cache.GetOrCreate(ProceduralMeshDesc::Sphere(1.0f, 16, 13), 7, builder.Get()) != a);
+    CHECK(cache.GetOrCreate(ProceduralMeshDesc::Sphere(2.0f, 16, 12), 7, builder.Get()) != a);
+    CHECK_EQ(builder.BuildCount.load(), 4);
+    CHECK_EQ(cache.GetStats().MeshCount, 4u);
+
+    // 메모리에만 두면 파일 경로가 없다.
+    CHECK(cache.GetFilePath(desc, 7).empty());
+}
+
+TEST_CASE(ProceduralMeshCache_MatchesGenerator)
+{
+    Builder builder;
+    ProceduralMeshCache cache;
+    cache.Open("", 1u << 24);
+
+    for (const ProceduralMeshDesc& desc : AllShapes)
+    {
+        std::shared_ptr<const ProceduralMesh> mesh = cache.GetOrCreate(desc, 0, builder.Get());
+
+        GeometryGenerator::MeshData expected;
+        GeometryGenerator::MeshDataSink sink(expected);
+        desc.Create(builder.Generator, sink);
+
+        REQUIRE(mesh->GetVertexCount() == expected.Vertices.size());
+        REQUIRE(mesh->GetIndexCount() == expected.Indices32.size());
+        CHECK(std::memcmp(mesh->GetIndices(), expected.Indices32.data(), expected.Indices32.size() * sizeof(std::uint32_t)) == 0);
+        for (std::uint32_t i = 0; i < mesh->GetVertexCount(); ++i)
+        {
+            if (std::memcmp(mesh->GetVertexData(0) + i * 12, &expected.Vertices[i].Position, 12) != 0 ||
+                std::memcmp(mesh->GetVertexData(1) + i * 12, &expected.Vertices[i].Normal, 12) != 0)
+            {
+                Test::Fail(__FILE__, __LINE__, "vertex " + std::to_string(i) + " differs from the generator");
+                break;
+            }
+        }
+    }
+}
+
+TEST_CASE(ProceduralMeshCache_PersistsAcrossRuns)
+{
+    Builder builder;
+    std::shared_ptr<const ProceduralMesh> built[5];
+    {
+        ProceduralMeshCache cache;
+        cache.Open("persist_", 1u << 24);
+        for (int i = 0; i < 5; ++i)
+        {
+            std::remove(cache.GetFilePath(AllShapes[i], 1).c_str());
+            built[i] = cache.GetOrCreate(AllShapes[i], 1, builder.Get());
+        }
+        CHECK_EQ(cache.GetStats().Misses, 5u);
+        CHECK_EQ(cache.GetStats().WriteFailures, 0u);
+    }
+
+    // 새 캐시 = 다시 실행한 것처럼 (파일에서 읽고 만들지 않는다)
+    ProceduralMeshCache cache;
+    cache.Open("persist_", 1u << 24);
+    for (int i = 0; i < 5; ++i)
+    {
+        std::shared_ptr<const ProceduralMesh> loaded = cache.GetOrCreate(AllShapes[i], 1, builder.Get());
+        REQUIRE(loaded != nullptr);
+        CHECK(IsSameMesh(*loaded, *built[i]));
+    }
+    CHECK_EQ(builder.BuildCount.load(), 5);
+    CHECK_EQ(cache.GetStats().DiskHits, 5u);
+    CHECK_EQ(cache.GetStats().Misses, 0u);
+
+    // 메모리에 올라온 뒤로는 메모리에서
+    cache.GetOrCreate(AllShapes[0], 1, builder.Get());
+    CHECK_EQ(cache.GetStats().Hits, 1u);
+}
+
+TEST_CASE(ProceduralMeshCache_BadFileRebuilds)
+{
+    Builder builder;
+    const ProceduralMeshDesc desc = ProceduralMeshDesc::Geosphere(1.0f, 2);
+    const ProceduralMeshDesc other = ProceduralMeshDesc::Grid(4.0f, 3.0f, 5, 7);
+
+    std::string path;
+    std::vector<std::uint8_t> good;
+    std::vector<std::uint8_t> otherFile;
+    {
+        ProceduralMeshCache cache;
+        cache.Open("bad_", 1u << 24);
+        path = cache.GetFilePath(desc, 2);
+        std::remove(path.c_str());
+        std::remove(cache.GetFilePath(other, 2).c_str());
+        cache.GetOrCreate(desc, 2, builder.Get());
+        cache.GetOrCreate(other, 2, builder.Get());
+        good = ReadFile(path);
+        otherFile = ReadFile(cache.GetFilePath(other, 2));
+        REQUIRE(!good.empty() && !otherFile.empty());
+    }
+
+    // 잘린 파일, 다른 키로 쓴 파일은 버리고 다시 만들어서 덮어쓴다.
+    const std::vector<std::uint8_t> truncated(good.begin(), good.begin() + good.size() / 2);
+    const std::vector<std::uint8_t>* badFiles[] = { &truncated, &otherFile };
+    for (const std::vector<std::uint8_t>* bytes : badFiles)
+    {
+        WriteFile(path, *bytes);
+
+        const int buildCount = builder.BuildCount.load();
+        ProceduralMeshCache cache;
+        cache.Open("bad_", 1u << 24);
+        std::shared_ptr<const ProceduralMesh> mesh = cache.GetOrCreate(desc, 2, builder.Get());
+        REQUIRE(mesh != nullptr);
+        CHECK_EQ(builder.BuildCount.load(), buildCount + 1);
+        CHECK_EQ(cache.GetStats().DiskHits, 0u);
+        CHECK_EQ(cache.GetStats().Misses, 1u);
+        CHECK(ReadFile(path) == good);
+    }
+}
+
+TEST_CASE(ProceduralMeshCache_EvictsLeastRecentlyUsed)
+{
+    Builder builder;
+    const ProceduralMeshDesc descs[3] =
+    {
+        ProceduralMeshDesc::Sphere(1.0f, 16, 12),
+        ProceduralMeshDesc::Sphere(2.0f, 16, 12),
+        ProceduralMeshDesc::Sphere(3.0f, 16, 12),
+    };
+
+    ProceduralMeshCache cache;
+    cache.Open("", 1u << 24);
+    std::shared_ptr<const ProceduralMesh> a = cache.GetOrCreate(descs[0], 0, builder.Get());
+    const std::uint64_t meshBytes = a->GetByteSize();
+
+    // 메시 두 개만 들어가는 예산
+    cache.SetMemoryBudget(meshBytes * 2);
+    cache.GetOrCreate(descs[1], 0, builder.Get());
+    cache.GetOrCreate(descs[0], 0, builder.Get());
+    cache.GetOrCreate(descs[2], 0, builder.Get());
+    CHECK_EQ(cache.GetStats().Evictions, 1u);
+    CHECK_EQ(cache.GetStats().MeshCount, 2u);
+    CHECK_EQ(cache.GetStats().MemoryBytes, meshBytes * 2);
+
+    // 가장 오래 안 쓴 1번이 빠졌다.
+    CHECK(cache.GetOrCreate(descs[0], 0, builder.Get()) == a);
+    CHECK_EQ(builder.BuildCount.load(), 3);
+    cache.GetOrCreate(descs[1], 0, builder.Get());
+    CHECK_EQ(builder.BuildCount.load(), 4);
+
+    // 예산보다 커도 방금 쓴 메시 하나는 남고, 들고 있는 메시는 빠져도 살아 있다.
+    cache.SetMemoryBudget(0);
+    CHECK_EQ(cache.GetStats().MeshCount, 1u);
+    CHECK_EQ(a->GetVertexCount(), 2u + 11u * 17u);
+}
+
+TEST_CASE(ProceduralMeshCache_ConcurrentRequests)
+{
+    Builder builder;
+    ProceduralMeshCache cache;
+    cache.Open("", 1u << 24);
+
+    JobSystem jobs;
+    jobs.Initialize(4);
+
+    // 같은 키를 동시에 만들어도 모두 먼저 넣은 메시 하나를 받는다.
+    const std::uint32_t requestCount = 64;
+    std::vector<std::shared_ptr<const ProceduralMesh>> results(requestCount);
+    jobs.Wait(jobs.ParallelFor(requestCount, 1, [&](std::uint32_t i)
+    {
+        results[i] = cache.GetOrCreate(AllShapes[i % 5], 0, builder.Get());
+    }));
+    jobs.Shutdown();
+
+    for (std::uint32_t i = 0; i < requestCount; ++i)
+    {
+        REQUIRE(results[i] != nullptr);
+        CHECK(results[i] == results[i % 5]);
+    }
+
+    const ProceduralMeshCache::Stats stats = cache.GetStats();
+    CHECK_EQ(stats.MeshCount, 5u);
+    CHECK_EQ(stats.Hits + stats.Misses, requestCount);
+    CHECK_EQ((int)stats.Misses, builder.BuildCount.load());
+}
@@ -0,0 +1,283 @@
+#include "TestFramework.h"
+#include "../02_Engine/RenderGraph.h"
+
+namespace
+{
+    void Nothing(RenderGraphContext&) {}
+
+    RGTextureDesc MakeDesc(std::uint64_t size, std::uint64_t alignment = 65536)
+    {
+        RGTextureDesc desc;
+        desc.Width = 256;
+        desc.Height = 256;
+        desc.SizeInBytes = size;
+        desc.Alignment = alignment;
+        return desc;
+    }
+
+    int CountTransitions(const std::vector<RGBarrier>& barriers, int resource)
+    {
+        int count = 0;
+        for (const RGBarrier& b : barriers)
+            count += (b.Type == RGBarrierType::Transition && b.Resource == resource) ? 1 : 0;
+        return count;
+    }
+
+    const RGBarrier* FindTransition(const std::vector<RGBarrier>& barriers, int resource)
+    {
+        for (const RGBarrier& b : barriers)
+        {
+            if (b.Type == RGBarrierType::Transition && b.Resource == resource)
+                return &b;
+        }
+        return nullptr;
+    }
+}
+
+// 에디터 프레임 구성 : 출력에 기여하지 않는 패스만 빠진다.
+TEST_CASE(RenderGraph_CullsPassesWithoutOutput)
+{
+    RenderGraph graph;
+    RGHandle scene = graph.ImportTexture("SceneColor", RGState::PixelShaderResource, RGState::PixelShaderResource);
+    RGHandle game = graph.ImportTexture("GameColor", RGState::PixelShaderResource, RGState::PixelShaderResource);
+    RGHandle backBuffer = graph.ImportTexture("BackBuffer", RGState::Present, RGState::Present);
+    RGHandle sceneDepth = graph.CreateTexture("SceneDepth", MakeDesc(1 << 20));
+    RGHandle gameDepth = graph.CreateTexture("GameDepth", MakeDesc(1 << 20));
+    RGHandle unused = graph.CreateTexture("Unused", MakeDesc(1 << 20));
+
+    graph.AddPass("Scene", Nothing).Write(scene, RGState::RenderTarget).Write(sceneDepth, RGState::DepthWrite);
+    graph.AddPass("Game", Nothing).Write(game, RGState::RenderTarget).Write(gameDepth, RGState::DepthWrite);
+    graph.AddPass("Unused", Nothing).Write(unused, RGState::RenderTarget);
+    graph.AddPass("ImGui", Nothing)
+        .Read(scene, RGState::PixelShaderResource)
+        .Read(game, RGState::PixelShaderResource)
+        .Write(backBuffer, RGState::RenderTarget)
+        .SideEffect();
+
+    REQUIRE(graph.Compile());
+
+    CHECK(!graph.IsPassCulled(0));
+    CHECK(!graph.IsPassCulled(1));
+    CHECK(graph.IsPassCulled(2));
+    CHECK(!graph.IsPassCulled(3));
+    REQUIRE(graph.GetSchedule().size() == 3u);
+    CHECK_EQ(graph.GetSchedule()[2].Pass, 3);
+
+    // 지워진 패스의 리소스는 배치하지 않는다.
+    CHECK(graph.FindPlacement(unused.Index) == nullptr);
+    CHECK(graph.FindPlacement(sceneDepth.Index) != nullptr);
+}
+
+TEST_CASE(RenderGraph_KeepsEarlierWritesOfLiveResource)
+{
+    // 쓰기는 부분 쓰기일 수 있으므로 출력 리소스에 먼저 쓴 패스도 남는다.
+    RenderGraph graph;
+    RGHandle color = graph.ImportTexture("Color", RGState::RenderTarget, RGState::RenderTarget);
+    graph.AddPass("Clear", Nothing).Write(color, RGState::RenderTarget);
+    graph.AddPass("Draw", Nothing).Write(color, RGState::RenderTarget);
+    graph.MarkOutput(color);
+
+    REQUIRE(graph.Compile());
+    CHECK_EQ(graph.GetSchedule().size(), 2u);
+}
+
+TEST_CASE(RenderGraph_ImportedResourceReturnsToFinalState)
+{
+    RenderGraph graph;
+    RGHandle backBuffer = graph.ImportTexture("BackBuffer", RGState::Present, RGState::Present);
+    graph.AddPass("ImGui", Nothing).Write(backBuffer, RGState::RenderTarget).SideEffect();
+
+    REQUIRE(graph.Compile());
+    REQUIRE(graph.GetSchedule().size() == 1u);
+
+    const RGBarrier* begin = FindTransition(graph.GetSchedule()[0].Barriers, backBuffer.Index);
+    REQUIRE(begin != nullptr);
+    CHECK_EQ(begin->StateBefore, RGState::Present);
+    CHECK_EQ(begin->StateAfter, RGState::RenderTarget);
+
+    REQUIRE(graph.GetFinalBarriers().size() == 1u);
+    const RGBarrier& end = graph.GetFinalBarriers()[0];
+    CHECK_EQ(end.StateBefore, RGState::RenderTarget);
+    CHECK_EQ(end.StateAfter, RGState::Present);
+    CHECK(end.Split == RGSplit::None);
+}
+
+TEST_CASE(RenderGraph_TransientStartsInFirstUseState)
+{
+    // 트랜지언트는 처음 쓰는 상태로 만들어지므로 첫 쓰기 앞에는 앨리어싱 배리어만 있다.
+    RenderGraph graph;
+    RGHandle depth = graph.CreateTexture("Depth", MakeDesc(1 << 20));
+    RGHandle color = graph.ImportTexture("Color", RGState::RenderTarget, RGState::RenderTarget);
+    graph.AddPass("Draw", Nothing).Write(depth, RGState::DepthWrite).Write(color, RGState::RenderTarget);
+    graph.MarkOutput(color);
+
+    REQUIRE(graph.Compile());
+    CHECK_EQ(graph.GetInitialState(depth.Index), RGState::DepthWrite);
+
+    const std::vector<RGBarrier>& barriers = graph.GetSchedule()[0].Barriers;
+    CHECK_EQ(CountTransitions(barriers, depth.Index), 0);
+    CHECK_EQ(CountTransitions(barriers, color.Index), 0);
+    REQUIRE(barriers.size() == 1u);
+    CHECK(barriers[0].Type == RGBarrierType::Aliasing);
+    CHECK_EQ(barriers[0].AliasBefore, -1);
+    CHECK(graph.GetFinalBarriers().empty());
+}
+
+TEST_CASE(RenderGraph_MergesReadStatesIntoOneTransition)
+{
+    // 다음 쓰기 전까지의 읽기 상태를 모아서 한 번만 전환한다.
+    RenderGraph graph;
+    RGHandle shadow = graph.CreateTexture("Shadow", MakeDesc(1 << 20));
+    RGHandle color = graph.ImportTexture("Color", RGState::RenderTarget, RGState::RenderTarget);
+    graph.AddPass("Shadow", Nothing).Write(shadow, RGState::DepthWrite);
+    graph.AddPass("Culling", Nothing).Read(shadow, RGState::NonPixelShaderResource).Write(color, RGState::RenderTarget);
+    graph.AddPass("Lighting", Nothing).Read(shadow, RGState::PixelShaderResource).Write(color, RGState::RenderTarget);
+    graph.MarkOutput(color);
+
+    REQUIRE(graph.Compile());
+    REQUIRE(graph.GetSchedule().size() == 3u);
+
+    const RGBarrier* toRead = FindTransition(graph.GetSchedule()[1].Barriers, shadow.Index);
+    REQUIRE(toRead != nullptr);
+    CHECK_EQ(toRead->StateBefore, RGState::DepthWrite);
+    CHECK_EQ(toRead->StateAfter, RGState::NonPixelShaderResource | RGState::PixelShaderResource);
+    CHECK_EQ(CountTransitions(graph.GetSchedule()[2].Barriers, shadow.Index), 0);
+
+    // 프레임 끝에는 생성 상태로 돌아간다.
+    const RGBarrier* restore = FindTransition(graph.GetFinalBarriers(), shadow.Index);
+    REQUIRE(restore != nullptr);
+    CHECK_EQ(restore->StateAfter, RGState::DepthWrite);
+}
+
+TEST_CASE(RenderGraph_ReadAfterReadNeedsNoBarrier)
+{
+    RenderGraph graph;
+    RGHandle texture = graph.ImportTexture("Texture", RGState::PixelShaderResource, RGState::PixelShaderResource);
+    RGHandle color = graph.ImportTexture("Color", RGState::RenderTarget, RGState::RenderTarget);
+    graph.AddPass("A", Nothing).Read(texture, RGState::PixelShaderResource).Write(color, RGState::RenderTarget);
+    graph.AddPass("B", Nothing).Read(texture, RGState::PixelShaderResource).Write(color, RGState::RenderTarget);
+    graph.MarkOutput(color);
+
+    REQUIRE(graph.Compile());
+    for (const RGCompiledPass& pass : graph.GetSchedule())
+    {
+        CHECK(pass.Barriers.empty());
+        CHECK(pass.PostBarriers.empty());
+    }
+    CHECK(graph.GetFinalBarriers().empty());
+}
+
+TEST_CASE(RenderGraph_SplitsBarrierAcrossUnrelatedPass)
+{
+    // 쓰고 나서 한 패스 건너 읽으면 마지막 쓰기 직후 Begin, 읽기 직전 End로 나뉜다.
+    RenderGraph graph;
+    RGHandle scene = graph.ImportTexture("Scene", RGState::PixelShaderResource, RGState::PixelShaderResource);
+    RGHandle other = graph.ImportTexture("Other", RGState::RenderTarget, RGState::RenderTarget);
+    RGHandle backBuffer = graph.ImportTexture("BackBuffer", RGState::Present, RGState::Present);
+    graph.AddPass("Scene", Nothing).Write(scene, RGState::RenderTarget);
+    graph.AddPass("Other", Nothing).Write(other, RGState::RenderTarget).SideEffect();
+    graph.AddPass("Composite", Nothing).Read(scene, RGState::PixelShaderResource).Write(backBuffer, RGState::RenderTarget).SideEffect();
+
+    REQUIRE(graph.Compile());
+    const std::vector<RGCompiledPass>& schedule = graph.GetSchedule();
+    REQUIRE(schedule.size() == 3u);
+
+    const RGBarrier* begin = FindTransition(schedule[0].PostBarriers, scene.Index);
+    REQUIRE(begin != nullptr);
+    CHECK(begin->Split == RGSplit::Begin);
+    CHECK_EQ(begin->StateBefore, RGState::RenderTarget);
+    CHECK_EQ(begin->StateAfter, RGState::PixelShaderResource);
+
+    const RGBarrier* end = FindTransition(schedule[2].Barriers, scene.Index);
+    REQUIRE(end != nullptr);
+    CHECK(end->Split == RGSplit::End);
+
+    // 바로 앞 패스에서 쓴 리소스는 나누지 않는다. (Scene 첫 전환)
+    const RGBarrier* toTarget = FindTransition(schedule[0].Barriers, scene.Index);
+    REQUIRE(toTarget != nullptr);
+    CHECK(toTarget->Split == RGSplit::None);
+}
+
+TEST_CASE(RenderGraph_AliasesDisjointLifetimes)
+{
+    const std::uint64_t size = 4 << 20;
+
+    RenderGraph graph;
+    RGHandle a = graph.CreateTexture("A", MakeDesc(size));
+    RGHandle b = graph.CreateTexture("B", MakeDesc(size));
+    RGHandle color = graph.ImportTexture("Color", RGState::RenderTarget, RGState::RenderTarget);
+    graph.AddPass("WriteA", Nothing).Write(a, RGState::RenderTarget);
+    graph.AddPass("ReadA", Nothing).Read(a, RGState::PixelShaderResource).Write(color, RGState::RenderTarget);
+    graph.AddPass("WriteB", Nothing).Write(b, RGState::RenderTarget);
+    graph.AddPass("ReadB", Nothing).Read(b, RGState::PixelShaderResource).Write(color, RGState::RenderTarget);
+    graph.MarkOutput(color);
+
+    REQUIRE(graph.Compile());
+
+    const RGMemoryPlan& plan = graph.GetMemoryPlan();
+    CHECK_EQ(plan.HeapSize, size);
+    CHECK_EQ(plan.UnaliasedSize, 2 * size);
+
+    const RGMemoryPlacement* placementA = graph.FindPlacement(a.Index);
+    const RGMemoryPlacement* placementB = graph.FindPlacement(b.Index);
+    REQUIRE(placementA != nullptr && placementB != nullptr);
+    CHECK_EQ(placementA->Offset, placementB->Offset);
+    CHECK_EQ(placementA->FirstPass, 0);
+    CHECK_EQ(placementA->LastPass, 1);
+    CHECK_EQ(placementB->FirstPass, 2);
+
+    // B를 처음 쓰기 전에 A를 앞선 리소스로 하는 앨리어싱 배리어
+    bool isAliased = false;
+    for (const RGBarrier& barrier : graph.GetSchedule()[2].Barriers)
+        isAliased |= barrier.Type == RGBarrierType::Aliasing && barrier.Resource == b.Index && barrier.AliasBefore == a.Index;
+    CHECK(isAliased);
+}
+
+TEST_CASE(RenderGraph_SeparatesOverlappingLifetimes)
+{
+    const std::uint64_t alignment = 65536;
+
+    RenderGraph graph;
+    RGHandle a = graph.CreateTexture("A", MakeDesc(3 << 20));
+    RGHandle b = graph.CreateTexture("B", MakeDesc((1 << 20) + 100, alignment));
+    RGHandle color = graph.ImportTexture("Color", RGState::RenderTarget, RGState::RenderTarget);
+    graph.AddPass("Write", Nothing).Write(a, RGState::RenderTarget).Write(b, RGState::RenderTarget);
+    graph.AddPass("Read", Nothing)
+        .Read(a, RGState::PixelShaderResource)
+        .Read(b, RGState::PixelShaderResource)
+        .Write(color, RGState::RenderTarget);
+    graph.MarkOutput(color);
+
+    REQUIRE(graph.Compile());
+
+    const RGMemoryPlacement* placementA = graph.FindPlacement(a.Index);
+    const RGMemoryPlacement* placementB = graph.FindPlacement(b.Index);
+    REQUIRE(placementA != nullptr && placementB != nullptr);
+
+    // 큰 리소스가 먼저 0에 놓이고, 작은 리소스는 그 뒤 정렬된 위치에 놓인다.
+    CHECK_EQ(placementA->Offset, 0u);
+    CHECK_EQ(placementB->Offset, (std::uint64_t)(3 << 20));
+    CHECK_EQ(placementB->Offset % alignment, 0u);
+    CHECK_EQ(graph.GetMemoryPlan().HeapSize, placementB->Offset + placementB->Size);
+}
+
+TEST_CASE(RenderGraph_RecompileAfterReset)
+{
+    // 매 프레임 Reset 후 다시 선언해도 이전 프레임 결과가 남지 않는다.
+    RenderGraph graph;
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        graph.Reset();
+        RGHandle color = graph.ImportTexture("Color", RGState::Present, RGState::Present);
+        RGHandle depth = graph.CreateTexture("Depth", MakeDesc(1 << 20));
+        graph.AddPass("Draw", Nothing).Write(color, RGState::RenderTarget).Write(depth, RGState::DepthWrite).SideEffect();
+
+        REQUIRE(graph.Compile());
+        CHECK_EQ(graph.GetResourceCount(), 2);
+        CHECK_EQ(graph.GetSchedule().size(), 1u);
+        CHECK_EQ(graph.GetMemoryPlan().Placements.size(), 1u);
+        CHECK_EQ(graph.GetFinalBarriers().size(), 1u);
+    }
+
+    CHECK(!graph.Dump().empty());
+}
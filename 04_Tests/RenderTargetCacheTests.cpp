@@ -0,0 +1,233 @@
+#include "TestFramework.h"
+#include "../01_Core/RenderTargetCache.h"
+#include "../02_Engine/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // 텍스처 대신 만든 순서만 가진 타겟
+    struct FakeTarget
+    {
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        int Format = 0;
+
+        std::uint64_t ReleaseFrame = 0;
+        bool IsInUse = false;
+
+        int Id = 0;
+    };
+
+    class FakePool
+    {
+    public:
+        FakePool() { Cache.SetBucketSize(64); }
+
+        FakeTarget* Acquire(std::uint32_t width, std::uint32_t height, int format = 0)
+        {
+            return Cache.Acquire(width, height, format, [this](std::uint32_t w, std::uint32_t h, int f)
+            {
+                auto target = std::make_unique<FakeTarget>();
+                target->Width = w;
+                target->Height = h;
+                target->Format = f;
+                target->Id = CreatedCount++;
+                return target;
+            });
+        }
+
+        void Collect(std::uint64_t completedFrame, std::uint64_t maxIdleFrames)
+        {
+            Cache.Collect(completedFrame, maxIdleFrames, [this](FakeTarget&) { ++DestroyedCount; });
+        }
+
+        RenderTargetCache<FakeTarget> Cache;
+        int CreatedCount = 0;
+        int DestroyedCount = 0;
+    };
+}
+
+TEST_CASE(RenderTargetCache_RoundsToBucketAndReuses)
+{
+    FakePool pool;
+    FakeTarget* a = pool.Acquire(100, 30);
+    REQUIRE(a != nullptr);
+    CHECK_EQ(a->Width, 128u);
+    CHECK_EQ(a->Height, 64u);
+
+    // 반환한 프레임을 GPU가 끝내기 전에는 다시 빌려주지 않는다.
+    pool.Cache.Release(a, 5);
+    pool.Collect(4, 100);
+    FakeTarget* b = pool.Acquire(120, 60);
+    CHECK(b != a);
+
+    pool.Collect(5, 100);
+    FakeTarget* c = pool.Acquire(120, 60);
+    CHECK(c == a);
+    CHECK_EQ(pool.CreatedCount, 2);
+}
+
+TEST_CASE(RenderTargetCache_SkipsOtherFormatAndTooLarge)
+{
+    FakePool pool;
+    FakeTarget* large = pool.Acquire(1024, 1024);
+    FakeTarget* other = pool.Acquire(64, 64, 1);
+    pool.Cache.Release(large, 0);
+    pool.Cache.Release(other, 0);
+
+    // 면적 MaxAreaRatio배 이내면 재사용, 넘으면 새로 만든다.
+    CHECK(pool.Cache.IsFit(*large, 512, 512));
+    CHECK(!pool.Cache.IsFit(*large, 448, 448));
+    CHECK(!pool.Cache.IsFit(*large, 1025, 64));
+
+    FakeTarget* small = pool.Acquire(64, 64);
+    CHECK(small != large && small != other);
+    CHECK(pool.Acquire(512, 512) == large);
+}
+
+TEST_CASE(RenderTargetCache_CollectsIdleTargets)
+{
+    FakePool pool;
+    FakeTarget* a = pool.Acquire(64, 64);
+    FakeTarget* b = pool.Acquire(64, 64);
+    pool.Cache.Release(a, 10);
+
+    pool.Collect(100, 120);
+    CHECK_EQ(pool.DestroyedCount, 0);
+
+    // 빌려준 타겟은 오래돼도 놓지 않는다.
+    pool.Collect(130, 120);
+    CHECK_EQ(pool.DestroyedCount, 1);
+    REQUIRE(pool.Cache.GetTargets().size() == 1u);
+    CHECK(pool.Cache.GetTargets()[0].get() == b);
+}
+
+// 에디터 흐름을 흉내 낸 트레이스 : 패널 크기 변경 + 동적 해상도 배율 변화
+// 매 프레임 뷰마다 IsFit이 아니면 타겟을 바꾸고, GPU는 몇 프레임 늦게 따라온다.
+// 쓰는 중인 타겟을 다른 뷰에 빌려주거나, 너무 큰 타겟에 그리는 일이 없어야 한다.
+TEST_CASE(RenderTargetCache_TraceReplay)
+{
+    const int viewCount = 2;
+    const std::uint64_t gpuLatency = 3;
+
+    Test::Random random(33);
+    FakePool pool;
+
+    FakeTarget* targets[viewCount] = {};
+    std::uint32_t panelWidth[viewCount] = { 800, 640 };
+    std::uint32_t panelHeight[viewCount] = { 600, 480 };
+    float scale = 1.0f;
+    int switchCount = 0;
+
+    for (std::uint64_t frame = 1; frame <= 5000; ++frame)
+    {
+        const std::uint64_t completedFrame = frame > gpuLatency ? frame - gpuLatency : 0;
+        pool.Collect(completedFrame, 120);
+
+        // 가끔 패널 드래그 (여러 프레임 이어서 조금씩), 배율은 0.5~1.0을 오간다.
+        if (random.Next(50) == 0)
+        {
+            const int view = (int)random.Next(viewCount);
+            panelWidth[view] = (std::uint32_t)random.Range(1, 2000);
+            panelHeight[view] = (std::uint32_t)random.Range(1, 1200);
+        }
+        if (random.Next(10) == 0)
+            scale = std::max(0.5f, std::min(1.0f, scale + (random.NextFloat() - 0.5f) * 0.2f));
+
+        for (int view = 0; view < viewCount; ++view)
+        {
+            const std::uint32_t width = std::max<std::uint32_t>(1, (std::uint32_t)(panelWidth[view] * scale + 0.5f));
+            const std::uint32_t height = std::max<std::uint32_t>(1, (std::uint32_t)(panelHeight[view] * scale + 0.5f));
+
+            FakeTarget*& target = targets[view];
+            if (target == nullptr || !pool.Cache.IsFit(*target, width, height))
+            {
+                pool.Cache.Release(target, frame);
+                target = pool.Acquire(width, height);
+                ++switchCount;
+
+                // GPU가 아직 쓰는 타겟이면 안 된다.
+                CHECK(target->ReleaseFrame <= completedFrame);
+            }
+
+            CHECK(target->IsInUse);
+            CHECK(pool.Cache.IsFit(*target, width, height));
+        }
+        CHECK(targets[0] != targets[1]);
+
+        // 오래 안 쓴 타겟은 정리되어 개수가 늘어나기만 하지 않는다.
+        CHECK(pool.Cache.GetTargets().size() < 40u);
+    }
+
+    // 배율만 바뀌는 프레임은 대부분 같은 타겟 안에서 끝난다.
+    CHECK(switchCount < 500);
+    CHECK(pool.CreatedCount - pool.DestroyedCount == (int)pool.Cache.GetTargets().size());
+}
+
+// 배율 0.5~1.0 사이는 한 타겟 안에서 바뀐다. (동적 해상도와 풀 기준이 맞는지)
+TEST_CASE(RenderTargetCache_DynamicResolutionRangeFitsOneTarget)
+{
+    const DynamicResolutionSettings settings;
+    const float minScale = settings.MinScale;
+    const float maxScale = settings.MaxScale;
+    REQUIRE(maxScale / minScale * (maxScale / minScale) <= (float)RenderTargetCache<FakeTarget>::MaxAreaRatio);
+
+    FakePool pool;
+    for (std::uint32_t size = 64; size <= 2048; size += 37)
+    {
+        FakeTarget* target = pool.Acquire((std::uint32_t)(size * maxScale), (std::uint32_t)(size * maxScale));
+        CHECK(pool.Cache.IsFit(*target, (std::uint32_t)(size * minScale), (std::uint32_t)(size * minScale)));
+        pool.Cache.Release(target, 0);
+    }
+}
+
+// GPU 비용 = 고정 비용 + 픽셀 비용 * 배율^2 인 가짜 GPU로 컨트롤러를 돌린다.
+TEST_CASE(DynamicResolution_ConvergesToBudget)
+{
+    const DynamicResolutionSettings settings;
+    DynamicResolutionController controller(settings);
+    const float goalMs = settings.TargetFrameMs * settings.Headroom;
+
+    float scale = controller.GetScale();
+    float frameMs = 0.0f;
+    for (int frame = 0; frame < 300; ++frame)
+    {
+        frameMs = 4.0f + 24.0f * scale * scale;
+        scale = controller.Update(frameMs);
+        CHECK(scale >= settings.MinScale && scale <= settings.MaxScale);
+    }
+
+    // 예산 안으로 들어오고, 한 단계 이상 여유를 남기지 않는다.
+    CHECK(frameMs <= settings.TargetFrameMs);
+    const float upMs = 4.0f + 24.0f * (scale + settings.ScaleStep) * (scale + settings.ScaleStep);
+    CHECK(upMs > goalMs * 0.95f);
+
+    // 부하가 줄면 다시 최대 배율로 돌아간다.
+    for (int frame = 0; frame < 300; ++frame)
+        scale = controller.Update(4.0f + 6.0f * scale * scale);
+    CHECK_EQ(scale, settings.MaxScale);
+}
+
+TEST_CASE(DynamicResolution_IgnoresSpikesAndInvalidSamples)
+{
+    const DynamicResolutionSettings settings;
+    DynamicResolutionController controller(settings);
+
+    for (int frame = 0; frame < 30; ++frame)
+        controller.Update(8.0f);
+    CHECK_EQ(controller.GetScale(), settings.MaxScale);
+
+    // 측정 실패(0, NaN)는 무시한다.
+    controller.Update(0.0f);
+    controller.Update(std::nanf(""));
+    CHECK_EQ(controller.GetScale(), settings.MaxScale);
+
+    // 한 번 튀는 프레임은 잘려서 최소 배율까지 떨어뜨리지 않고, 곧 다시 올라간다.
+    controller.Update(1000.0f);
+    CHECK(controller.GetScale() > settings.MinScale);
+    for (int frame = 0; frame < 60; ++frame)
+        controller.Update(8.0f);
+    CHECK_EQ(controller.GetScale(), settings.MaxScale);
+}
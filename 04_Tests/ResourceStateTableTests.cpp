@@ -0,0 +1,267 @@
+#include "TestFramework.h"
+#include "../01_Core/ResourceStateTable.h"
+
+#include <map>
+
+namespace
+{
+    // D3D12_RESOURCE_STATES 값
+    const std::uint32_t Common = 0;
+    const std::uint32_t RenderTarget = 0x4;
+    const std::uint32_t UnorderedAccess = 0x8;
+    const std::uint32_t DepthWrite = 0x10;
+    const std::uint32_t NonPixelShaderResource = 0x40;
+    const std::uint32_t PixelShaderResource = 0x80;
+    const std::uint32_t CopyDest = 0x400;
+    const std::uint32_t CopySource = 0x800;
+
+    const std::uint32_t WriteStates = RenderTarget | UnorderedAccess | DepthWrite | CopyDest;
+
+    // 제출된 배리어를 받아서 리소스의 실제 상태를 따라가는 가짜 커맨드 리스트
+    // 전환의 Before가 실제 상태와 다르면 (D3D12 디버그 레이어 오류에 해당) 실패로 센다.
+    class FakeCommandList
+    {
+    public:
+        void SetState(const void* resource, std::uint32_t subresourceCount, std::uint32_t state)
+        {
+            for (std::uint32_t i = 0; i < subresourceCount; ++i)
+                mStates[{ resource, i }] = state;
+            mSubresourceCounts[resource] = subresourceCount;
+        }
+
+        std::uint32_t GetState(const void* resource, std::uint32_t subresource)const
+        {
+            return mStates.at({ resource, subresource });
+        }
+
+        void Submit(ResourceStateTable& table)
+        {
+            for (const StateBarrier& barrier : table.GetPending())
+            {
+                if (barrier.Type != StateBarrierType::Transition || barrier.Split == StateBarrierSplit::Begin)
+                    continue;
+
+                const std::uint32_t count = mSubresourceCounts[barrier.Resource];
+                for (std::uint32_t i = 0; i < count; ++i)
+                {
+                    if (barrier.Subresource != ResourceStateTable::AllSubresources && barrier.Subresource != i)
+                        continue;
+
+                    std::uint32_t& state = mStates[{ barrier.Resource, i }];
+                    if (state != barrier.StateBefore)
+                        ++MismatchCount;
+                    state = barrier.StateAfter;
+                }
+            }
+            ++SubmitCount;
+            table.ClearPending();
+        }
+
+        int MismatchCount = 0;
+        int SubmitCount = 0;
+
+    private:
+        std::map<std::pair<const void*, std::uint32_t>, std::uint32_t> mStates;
+        std::map<const void*, std::uint32_t> mSubresourceCounts;
+    };
+
+    int gResources[8];
+}
+
+TEST_CASE(ResourceStateTable_DropsRedundantTransition)
+{
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], CopyDest);
+
+    table.Transition(&gResources[0], CopyDest);
+    CHECK(table.GetPending().empty());
+    CHECK_EQ(table.GetStats().Dropped, 1u);
+
+    table.Transition(&gResources[0], PixelShaderResource);
+    REQUIRE(table.GetPending().size() == 1u);
+    CHECK_EQ(table.GetPending()[0].StateBefore, CopyDest);
+    CHECK_EQ(table.GetPending()[0].StateAfter, PixelShaderResource);
+    CHECK_EQ(table.GetState(&gResources[0]), PixelShaderResource);
+}
+
+TEST_CASE(ResourceStateTable_ReadSupersetSatisfiesRead)
+{
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], PixelShaderResource | NonPixelShaderResource);
+
+    // 이미 포함된 읽기 상태는 전환하지 않는다.
+    table.Transition(&gResources[0], PixelShaderResource);
+    CHECK(table.GetPending().empty());
+
+    // COMMON은 읽기 상태로 보지 않는다.
+    table.SetState(&gResources[1], Common);
+    table.Transition(&gResources[1], PixelShaderResource);
+    CHECK_EQ(table.GetPending().size(), 1u);
+
+    CHECK(table.IsReadState(CopySource | PixelShaderResource));
+    CHECK(!table.IsReadState(RenderTarget));
+    CHECK(!table.IsReadState(Common));
+}
+
+TEST_CASE(ResourceStateTable_CoalescesPendingTransitions)
+{
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], Common);
+    table.SetState(&gResources[1], PixelShaderResource);
+
+    // A->B, B->C => A->C
+    table.Transition(&gResources[0], CopyDest);
+    table.Transition(&gResources[0], PixelShaderResource);
+    REQUIRE(table.GetPending().size() == 1u);
+    CHECK_EQ(table.GetPending()[0].StateBefore, Common);
+    CHECK_EQ(table.GetPending()[0].StateAfter, PixelShaderResource);
+
+    // A->B, B->A 는 상쇄
+    table.Transition(&gResources[1], RenderTarget);
+    table.Transition(&gResources[1], PixelShaderResource);
+    CHECK_EQ(table.GetPending().size(), 1u);
+
+    table.ClearPending();
+    CHECK_EQ(table.GetStats().Submitted, 1u);
+    CHECK_EQ(table.GetStats().FlushCalls, 1u);
+    CHECK_EQ(table.GetStats().Requested, 4u);
+}
+
+TEST_CASE(ResourceStateTable_TracksSubresources)
+{
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], PixelShaderResource, 4);
+
+    table.Transition(&gResources[0], RenderTarget, 2);
+    CHECK_EQ(table.GetState(&gResources[0], 2), RenderTarget);
+    CHECK_EQ(table.GetState(&gResources[0], 1), PixelShaderResource);
+    REQUIRE(table.GetPending().size() == 1u);
+    CHECK_EQ(table.GetPending()[0].Subresource, 2u);
+    table.ClearPending();
+
+    // 전체 전환은 상태가 다른 서브리소스만 전환하고, 모두 같아지면 하나로 합친다.
+    table.Transition(&gResources[0], RenderTarget);
+    CHECK_EQ(table.GetPending().size(), 3u);
+    for (const StateBarrier& barrier : table.GetPending())
+        CHECK(barrier.Subresource != 2u && barrier.Subresource != ResourceStateTable::AllSubresources);
+    CHECK_EQ(table.GetState(&gResources[0]), RenderTarget);
+    table.ClearPending();
+
+    table.Transition(&gResources[0], PixelShaderResource);
+    REQUIRE(table.GetPending().size() == 1u);
+    CHECK_EQ(table.GetPending()[0].Subresource, ResourceStateTable::AllSubresources);
+}
+
+TEST_CASE(ResourceStateTable_SplitBarrier)
+{
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], RenderTarget);
+
+    table.BeginTransition(&gResources[0], PixelShaderResource);
+    REQUIRE(table.GetPending().size() == 1u);
+    CHECK(table.GetPending()[0].Split == StateBarrierSplit::Begin);
+    CHECK_EQ(table.GetState(&gResources[0]), PixelShaderResource);
+    table.ClearPending();
+
+    // 사이에 다른 리소스 전환이 있어도 End는 Begin과 같은 전환이다.
+    table.SetState(&gResources[1], Common);
+    table.Transition(&gResources[1], CopyDest);
+    table.EndTransition(&gResources[0]);
+    REQUIRE(table.GetPending().size() == 2u);
+    const StateBarrier& end = table.GetPending()[1];
+    CHECK(end.Split == StateBarrierSplit::End);
+    CHECK_EQ(end.StateBefore, RenderTarget);
+    CHECK_EQ(end.StateAfter, PixelShaderResource);
+    table.ClearPending();
+
+    // 이미 같은 상태면 Begin이 버려지고 End도 없다.
+    table.BeginTransition(&gResources[0], PixelShaderResource);
+    table.EndTransition(&gResources[0]);
+    CHECK(table.GetPending().empty());
+}
+
+TEST_CASE(ResourceStateTable_SplitEndIsNotCoalesced)
+{
+    // Begin/End 배리어는 일반 전환과 합치지 않는다.
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], RenderTarget);
+    table.BeginTransition(&gResources[0], PixelShaderResource);
+    table.EndTransition(&gResources[0]);
+    table.Transition(&gResources[0], CopyDest);
+
+    REQUIRE(table.GetPending().size() == 3u);
+    CHECK(table.GetPending()[2].Split == StateBarrierSplit::None);
+    CHECK_EQ(table.GetPending()[2].StateBefore, PixelShaderResource);
+}
+
+TEST_CASE(ResourceStateTable_AliasingAndUav)
+{
+    ResourceStateTable table(WriteStates);
+    table.Aliasing(&gResources[0], &gResources[1]);
+    table.UAV(&gResources[2]);
+
+    REQUIRE(table.GetPending().size() == 2u);
+    CHECK(table.GetPending()[0].Type == StateBarrierType::Aliasing);
+    CHECK(table.GetPending()[0].Resource == &gResources[0]);
+    CHECK(table.GetPending()[0].ResourceAfter == &gResources[1]);
+    CHECK(table.GetPending()[1].Type == StateBarrierType::UAV);
+}
+
+TEST_CASE(ResourceStateTable_UntrackForgetsState)
+{
+    ResourceStateTable table(WriteStates);
+    table.SetState(&gResources[0], RenderTarget);
+    CHECK(table.IsTracked(&gResources[0]));
+
+    table.Untrack(&gResources[0]);
+    CHECK(!table.IsTracked(&gResources[0]));
+    CHECK_EQ(table.GetState(&gResources[0]), Common);
+}
+
+// 임의의 전환을 쌓고 제출하기를 반복하면서
+// 가짜 커맨드 리스트가 본 실제 상태와 표의 상태가 항상 같은지 확인한다.
+TEST_CASE(ResourceStateTable_RandomReplayMatchesCommandList)
+{
+    const std::uint32_t states[] = { RenderTarget, UnorderedAccess, DepthWrite, CopyDest, CopySource,
+        PixelShaderResource, NonPixelShaderResource, PixelShaderResource | NonPixelShaderResource };
+    const std::uint32_t stateCount = sizeof(states) / sizeof(states[0]);
+    const std::uint32_t resourceCount = 6;
+
+    Test::Random random(28);
+    ResourceStateTable table(WriteStates);
+    FakeCommandList cmdList;
+
+    for (std::uint32_t r = 0; r < resourceCount; ++r)
+    {
+        const std::uint32_t subresourceCount = 1 + r % 3;
+        table.SetState(&gResources[r], Common, subresourceCount);
+        cmdList.SetState(&gResources[r], subresourceCount, Common);
+    }
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        const std::uint32_t r = random.Next(resourceCount);
+        const std::uint32_t subresourceCount = 1 + r % 3;
+        const std::uint32_t subresource = random.Next(4) == 0 ? random.Next(subresourceCount) : ResourceStateTable::AllSubresources;
+        table.Transition(&gResources[r], states[random.Next(stateCount)], subresource);
+
+        if (random.Next(8) == 0)
+        {
+            cmdList.Submit(table);
+
+            for (std::uint32_t check = 0; check < resourceCount; ++check)
+            {
+                for (std::uint32_t i = 0; i < 1 + check % 3; ++i)
+                    CHECK_EQ(table.GetState(&gResources[check], i), cmdList.GetState(&gResources[check], i));
+            }
+        }
+    }
+    cmdList.Submit(table);
+
+    CHECK_EQ(cmdList.MismatchCount, 0);
+
+    // 합치고 버린 만큼 실제 배리어는 요청보다 적다.
+    const ResourceStateTrackerStats& stats = table.GetStats();
+    CHECK(stats.Submitted < stats.Requested);
+    CHECK(stats.Dropped > 0u);
+}
@@ -0,0 +1,290 @@
+#include "TestFramework.h"
+#include "../01_Core/ShaderCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void WriteFile(const std::string& path, const std::string& text)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(text.data(), 1, text.size(), file);
+        std::fclose(file);
+    }
+
+    std::vector<std::uint8_t> ReadFile(const std::string& path)
+    {
+        std::vector<std::uint8_t> bytes;
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            return bytes;
+        std::fseek(file, 0, SEEK_END);
+        bytes.resize((std::size_t)std::ftell(file));
+        std::fseek(file, 0, SEEK_SET);
+        std::fread(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+        return bytes;
+    }
+
+    void WriteFile(const std::string& path, const std::vector<std::uint8_t>& bytes)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+
+    // 원본 + include 내용을 이어 붙인 것을 바이트코드로 내는 가짜 컴파일러
+    // 원본이 "error"로 시작하면 실패한다.
+    class FakeCompiler : public IShaderCompiler
+    {
+    public:
+        std::string GetIdentity()const override { return Identity; }
+
+        bool Compile(const ShaderCompileDesc& desc, ShaderCompileOutput& output) override
+        {
+            ++CompileCount;
+
+            const std::vector<std::uint8_t> source = ReadFile(desc.SourcePath);
+            if (source.size() >= 5 && std::string(source.begin(), source.begin() + 5) == "error")
+            {
+                output.Errors = desc.SourcePath + ": error";
+                return false;
+            }
+
+            output.Bytecode = source;
+            output.Bytecode.insert(output.Bytecode.end(), desc.EntryPoint.begin(), desc.EntryPoint.end());
+            for (const std::string& include : Includes)
+            {
+                const std::vector<std::uint8_t> bytes = ReadFile(include);
+                output.Bytecode.insert(output.Bytecode.end(), bytes.begin(), bytes.end());
+                output.Dependencies.push_back(include);
+            }
+            return true;
+        }
+
+        std::string Identity = "fake-1";
+        std::vector<std::string> Includes;
+        int CompileCount = 0;
+    };
+
+    std::string ToString(const ShaderBytecode& bytecode)
+    {
+        return std::string(reinterpret_cast<const char*>(bytecode.Data), bytecode.Size);
+    }
+
+    ShaderCompileDesc MakeDesc(const std::string& path, const std::string& entryPoint = "VS")
+    {
+        ShaderCompileDesc desc;
+        desc.SourcePath = path;
+        desc.EntryPoint = entryPoint;
+        desc.Target = "vs_5_1";
+        return desc;
+    }
+}
+
+TEST_CASE(ShaderCache_MissThenHit)
+{
+    WriteFile("hit.hlsl", "source");
+    std::remove("hit.cache");
+
+    FakeCompiler compiler;
+    ShaderCache cache;
+    cache.Open("hit.cache", &compiler);
+
+    ShaderBytecode bytecode;
+    REQUIRE(cache.GetOrCompile(MakeDesc("hit.hlsl"), bytecode));
+    CHECK_EQ(ToString(bytecode), std::string("sourceVS"));
+    REQUIRE(cache.GetOrCompile(MakeDesc("hit.hlsl"), bytecode));
+    CHECK_EQ(ToString(bytecode), std::string("sourceVS"));
+
+    CHECK_EQ(compiler.CompileCount, 1);
+    CHECK_EQ(cache.GetStats().Misses, 1u);
+    CHECK_EQ(cache.GetStats().Hits, 1u);
+
+    // 진입점이 다르면 다른 요청
+    REQUIRE(cache.GetOrCompile(MakeDesc("hit.hlsl", "PS"), bytecode));
+    CHECK_EQ(compiler.CompileCount, 2);
+}
+
+TEST_CASE(ShaderCache_PersistsAcrossRuns)
+{
+    WriteFile("persist.hlsl", "source");
+    WriteFile("persist.h", "include");
+    std::remove("persist.cache");
+
+    FakeCompiler compiler;
+    compiler.Includes.push_back("persist.h");
+    {
+        ShaderCache cache;
+        cache.Open("persist.cache", &compiler);
+        ShaderBytecode bytecode;
+        REQUIRE(cache.GetOrCompile(MakeDesc("persist.hlsl"), bytecode));
+        CHECK(cache.Save());
+    }
+
+    ShaderCache cache;
+    cache.Open("persist.cache", &compiler);
+    CHECK_EQ(cache.GetEntryCount(), 1u);
+
+    ShaderBytecode bytecode;
+    REQUIRE(cache.GetOrCompile(MakeDesc("persist.hlsl"), bytecode));
+    CHECK_EQ(ToString(bytecode), std::string("sourceVSinclude"));
+    CHECK_EQ(compiler.CompileCount, 1);
+    CHECK_EQ(cache.GetStats().Hits, 1u);
+}
+
+TEST_CASE(ShaderCache_IncludeEditInvalidates)
+{
+    WriteFile("inval.hlsl", "source");
+    WriteFile("inval.h", "old");
+    std::remove("inval.cache");
+
+    FakeCompiler compiler;
+    compiler.Includes.push_back("inval.h");
+    ShaderCache cache;
+    cache.Open("inval.cache", &compiler);
+
+    ShaderBytecode bytecode;
+    REQUIRE(cache.GetOrCompile(MakeDesc("inval.hlsl"), bytecode));
+
+    // 파일 해시는 실행 중에 캐시되므로 바뀐 걸 알려야 다시 읽는다.
+    WriteFile("inval.h", "new!");
+    REQUIRE(cache.GetOrCompile(MakeDesc("inval.hlsl"), bytecode));
+    CHECK_EQ(compiler.CompileCount, 1);
+
+    cache.InvalidateFileHashes();
+    REQUIRE(cache.GetOrCompile(MakeDesc("inval.hlsl"), bytecode));
+    CHECK_EQ(ToString(bytecode), std::string("sourceVSnew!"));
+    CHECK_EQ(compiler.CompileCount, 2);
+    CHECK_EQ(cache.GetStats().Invalidated, 1u);
+
+    // 요청마다 마지막 결과만 기억하므로 옛 바이트코드는 저장할 때 정리된다.
+    CHECK(cache.Save());
+    CHECK_EQ(cache.GetBlobCount(), 1u);
+}
+
+TEST_CASE(ShaderCache_SameContentSharesBytecode)
+{
+    WriteFile("share_a.hlsl", "same");
+    WriteFile("share_b.hlsl", "same");
+    std::remove("share.cache");
+
+    FakeCompiler compiler;
+    ShaderCache cache;
+    cache.Open("share.cache", &compiler);
+
+    ShaderBytecode a;
+    ShaderBytecode b;
+    REQUIRE(cache.GetOrCompile(MakeDesc("share_a.hlsl"), a));
+    REQUIRE(cache.GetOrCompile(MakeDesc("share_b.hlsl"), b));
+    CHECK_EQ(cache.GetEntryCount(), 2u);
+    CHECK_EQ(cache.GetBlobCount(), 1u);
+    CHECK(a.Data == b.Data);
+}
+
+TEST_CASE(ShaderCache_CompilerChangeDropsCache)
+{
+    WriteFile("compiler.hlsl", "source");
+    std::remove("compiler.cache");
+
+    FakeCompiler compiler;
+    {
+        ShaderCache cache;
+        cache.Open("compiler.cache", &compiler);
+        ShaderBytecode bytecode;
+        REQUIRE(cache.GetOrCompile(MakeDesc("compiler.hlsl"), bytecode));
+        CHECK(cache.Save());
+    }
+
+    compiler.Identity = "fake-2";
+    ShaderCache cache;
+    cache.Open("compiler.cache", &compiler);
+    CHECK_EQ(cache.GetEntryCount(), 0u);
+
+    ShaderBytecode bytecode;
+    REQUIRE(cache.GetOrCompile(MakeDesc("compiler.hlsl"), bytecode));
+    CHECK_EQ(compiler.CompileCount, 2);
+}
+
+TEST_CASE(ShaderCache_CompileFailure)
+{
+    WriteFile("fail.hlsl", "error here");
+    std::remove("fail.cache");
+
+    FakeCompiler compiler;
+    ShaderCache cache;
+    cache.Open("fail.cache", &compiler);
+
+    ShaderBytecode bytecode;
+    std::string errors;
+    CHECK(!cache.GetOrCompile(MakeDesc("fail.hlsl"), bytecode, &errors));
+    CHECK(!errors.empty());
+    CHECK_EQ(cache.GetStats().Failures, 1u);
+    CHECK_EQ(cache.GetEntryCount(), 0u);
+}
+
+// 의존 파일 개수가 망가진 캐시 : 큰 할당 없이 버리고 다시 컴파일한다.
+TEST_CASE(ShaderCache_HugeDependencyCountIsRejected)
+{
+    WriteFile("huge.hlsl", "source");
+    std::remove("huge.cache");
+
+    FakeCompiler compiler;
+    {
+        ShaderCache cache;
+        cache.Open("huge.cache", &compiler);
+        ShaderBytecode bytecode;
+        REQUIRE(cache.GetOrCompile(MakeDesc("huge.hlsl"), bytecode));
+        CHECK(cache.Save());
+    }
+
+    // 헤더(magic, version, compiler, entry/blob 수) 다음 첫 항목의 요청 키, 내용 키 뒤가 의존 파일 수
+    std::vector<std::uint8_t> bytes = ReadFile("huge.cache");
+    const std::size_t countOffset = 4 + 4 + 8 + 4 + 4 + 8 + 8;
+    REQUIRE(bytes.size() > countOffset + 4);
+    const std::uint32_t hugeCount = 0xFFFFFFF0u;
+    std::memcpy(bytes.data() + countOffset, &hugeCount, sizeof(hugeCount));
+    WriteFile("huge.cache", bytes);
+
+    ShaderCache cache;
+    cache.Open("huge.cache", &compiler);
+    CHECK_EQ(cache.GetEntryCount(), 0u);
+    CHECK(ReadFile("huge.cache").empty());
+
+    ShaderBytecode bytecode;
+    REQUIRE(cache.GetOrCompile(MakeDesc("huge.hlsl"), bytecode));
+    CHECK_EQ(compiler.CompileCount, 2);
+    CHECK(cache.Save());
+}
+
+// 캐시 파일이 어디서 잘려도 예외 없이 빈 캐시로 시작한다.
+TEST_CASE(ShaderCache_TruncatedFiles)
+{
+    WriteFile("trunc.hlsl", "source");
+    WriteFile("trunc.h", "include");
+    std::remove("trunc.cache");
+
+    FakeCompiler compiler;
+    compiler.Includes.push_back("trunc.h");
+    {
+        ShaderCache cache;
+        cache.Open("trunc.cache", &compiler);
+        ShaderBytecode bytecode;
+        REQUIRE(cache.GetOrCompile(MakeDesc("trunc.hlsl"), bytecode));
+        REQUIRE(cache.GetOrCompile(MakeDesc("trunc.hlsl", "PS"), bytecode));
+        CHECK(cache.Save());
+    }
+
+    const std::vector<std::uint8_t> bytes = ReadFile("trunc.cache");
+    for (std::size_t size = 1; size < bytes.size(); ++size)
+    {
+        WriteFile("trunc.cache", std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + size));
+
+        ShaderCache cache;
+        cache.Open("trunc.cache", &compiler);
+        CHECK_EQ(cache.GetEntryCount(), 0u);
+    }
+}
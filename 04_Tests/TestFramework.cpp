@@ -0,0 +1,79 @@
+#include "TestFramework.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+namespace
+{
+    struct TestEntry
+    {
+        const char* Name;
+        Test::TestFunction Function;
+    };
+
+    // 정적 초기화 순서와 무관하게 쓰도록 함수 안에 둔다.
+    std::vector<TestEntry>& GetTests()
+    {
+        static std::vector<TestEntry> tests;
+        return tests;
+    }
+
+    int gFailureCount = 0;
+}
+
+bool Test::Register(const char* name, TestFunction function)
+{
+    GetTests().push_back({ name, function });
+    return true;
+}
+
+void Test::Fail(const char* file, int line, const std::string& message)
+{
+    ++gFailureCount;
+    std::printf("  %s(%d): %s\n", file, line, message.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    int runCount = 0;
+    int failedCount = 0;
+    for (const TestEntry& test : GetTests())
+    {
+        if (filter != nullptr && std::strstr(test.Name, filter) == nullptr)
+            continue;
+
+        std::printf("[ RUN  ] %s\n", test.Name);
+        std::fflush(stdout);
+
+        const int failuresBefore = gFailureCount;
+        auto start = std::chrono::high_resolution_clock::now();
+        try
+        {
+            test.Function();
+        }
+        catch (const std::exception& e)
+        {
+            Test::Fail(__FILE__, __LINE__, std::string("exception: ") + e.what());
+        }
+        catch (...)
+        {
+            Test::Fail(__FILE__, __LINE__, "unknown exception");
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        const bool isFailed = gFailureCount != failuresBefore;
+        std::printf("[ %s ] %s (%.1f ms)\n", isFailed ? "FAIL" : " OK ", test.Name, ms);
+        std::fflush(stdout);
+
+        ++runCount;
+        failedCount += isFailed ? 1 : 0;
+    }
+
+    std::printf("%d tests, %d failed\n", runCount, failedCount);
+    return (runCount == 0 || failedCount != 0) ? 1 : 0;
+}
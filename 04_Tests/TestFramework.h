@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// 테스트 등록/검사 매크로 (외부 라이브러리 없이 ctest로 돌린다)
+// 테스트 파일 하나가 실행 파일 하나가 되고, main은 TestFramework.cpp에 있다.
+//
+//  TEST_CASE(RenderGraph_CullsUnusedPass)
+//  {
+//      REQUIRE(graph.Compile());
+//      CHECK_EQ(graph.GetSchedule().size(), 2u);
+//  }
+//
+// 실행 인자로 이름 일부를 주면 그 이름이 들어간 테스트만 돈다.
+namespace Test
+{
+    using TestFunction = void(*)();
+
+    bool Register(const char* name, TestFunction function);
+
+    // 실패를 기록한다. (테스트는 계속 진행)
+    void Fail(const char* file, int line, const std::string& message);
+
+    template<typename T>
+    std::string ToString(const T& value)
+    {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    }
+
+    inline std::string ToString(std::uint8_t value) { return std::to_string(value); }
+    inline std::string ToString(bool value) { return value ? "true" : "false"; }
+
+    // 같은 결과를 얻는 고정 시드 난수 (플랫폼마다 std 분포 구현이 달라서 직접 만든다)
+    class Random
+    {
+    public:
+        explicit Random(std::uint64_t seed) : mState(seed * 6364136223846793005ull + 1442695040888963407ull) {}
+
+        std::uint32_t Next()
+        {
+            mState = mState * 6364136223846793005ull + 1442695040888963407ull;
+            return (std::uint32_t)(mState >> 33);
+        }
+        // [0, count)
+        std::uint32_t Next(std::uint32_t count) { return count == 0 ? 0 : Next() % count; }
+        // [minValue, maxValue]
+        std::uint32_t Range(std::uint32_t minValue, std::uint32_t maxValue) { return minValue + Next(maxValue - minValue + 1); }
+        float NextFloat() { return (Next() & 0xFFFFFF) / float(0x1000000); }
+
+    private:
+        std::uint64_t mState;
+    };
+}
+
+#define TEST_CASE(name)                                                         \
+    static void name();                                                         \
+    static const bool name##Registered = Test::Register(#name, name);           \
+    static void name()
+
+#define CHECK(expr)                                                             \
+    do { if (!(expr)) Test::Fail(__FILE__, __LINE__, #expr); } while (0)
+
+// 실패하면 현재 테스트를 끝낸다. (뒤의 검사가 의미 없을 때)
+#define REQUIRE(expr)                                                           \
+    do { if (!(expr)) { Test::Fail(__FILE__, __LINE__, #expr); return; } } while (0)
+
+#define CHECK_EQ(actual, expected)                                              \
+    do                                                                          \
+    {                                                                           \
+        const auto& checkActual = (actual);                                     \
+        const auto& checkExpected = (expected);                                 \
+        if (!(checkActual == checkExpected))                                    \
+            Test::Fail(__FILE__, __LINE__, std::string(#actual " == " #expected " (") + \
+                Test::ToString(checkActual) + " != " + Test::ToString(checkExpected) + ")"); \
+    } while (0)
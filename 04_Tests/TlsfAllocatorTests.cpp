@@ -0,0 +1,174 @@
+#include "TestFramework.h"
+#include "../01_Core/TlsfAllocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    bool IsOverlapping(const TlsfAllocator::Allocation& a, const TlsfAllocator::Allocation& b)
+    {
+        return a.Offset < b.Offset + b.Size && b.Offset < a.Offset + a.Size;
+    }
+}
+
+TEST_CASE(Tlsf_AllocateAndFreeCoalesces)
+{
+    TlsfAllocator allocator(1 << 20);
+
+    TlsfAllocator::Allocation a = allocator.Allocate(1000);
+    TlsfAllocator::Allocation b = allocator.Allocate(2000, 256);
+    TlsfAllocator::Allocation c = allocator.Allocate(3000, 4096);
+    REQUIRE(a.IsValid() && b.IsValid() && c.IsValid());
+    CHECK_EQ(b.Offset % 256, 0u);
+    CHECK_EQ(c.Offset % 4096, 0u);
+    CHECK(!IsOverlapping(a, b) && !IsOverlapping(b, c) && !IsOverlapping(a, c));
+    CHECK_EQ(allocator.GetStats().AllocationCount, 3u);
+
+    // 가운데부터 풀어도 마지막에는 한 덩어리로 합쳐진다.
+    allocator.Free(b);
+    allocator.Free(a);
+    allocator.Free(c);
+    CHECK(allocator.IsEmpty());
+    CHECK(allocator.Validate());
+
+    const TlsfAllocator::Stats stats = allocator.GetStats();
+    CHECK_EQ(stats.FreeBlockCount, 1u);
+    CHECK_EQ(stats.LargestFreeBlock, (std::uint64_t)(1 << 20));
+    CHECK_EQ(stats.Fragmentation(), 0.0);
+}
+
+TEST_CASE(Tlsf_ExactFitWithPlacementAlignment)
+{
+    // 64KB 정렬 64KB 리소스로 힙을 빈틈없이 채울 수 있어야 한다. (GPU 힙 블록 사용 방식)
+    const std::uint64_t alignment = 65536;
+    TlsfAllocator allocator(64 * alignment);
+
+    std::vector<TlsfAllocator::Allocation> allocations;
+    for (int i = 0; i < 64; ++i)
+    {
+        TlsfAllocator::Allocation allocation = allocator.Allocate(alignment, alignment);
+        REQUIRE(allocation.IsValid());
+        allocations.push_back(allocation);
+    }
+
+    CHECK(!allocator.Allocate(1).IsValid());
+    CHECK_EQ(allocator.GetStats().FreeSize, 0u);
+
+    for (const TlsfAllocator::Allocation& allocation : allocations)
+        allocator.Free(allocation);
+    CHECK(allocator.Validate());
+    CHECK_EQ(allocator.GetStats().FreeBlockCount, 1u);
+}
+
+TEST_CASE(Tlsf_MsaaAlignmentInsideLargeBlock)
+{
+    // 4MB 정렬 (MSAA 배치 정렬) 요청은 앞에 다른 할당이 있어도 정렬된 위치에 놓인다.
+    const std::uint64_t msaaAlignment = 4 << 20;
+    TlsfAllocator allocator(64 << 20);
+
+    TlsfAllocator::Allocation small = allocator.Allocate(65536, 65536);
+    TlsfAllocator::Allocation msaa = allocator.Allocate(8 << 20, msaaAlignment);
+    REQUIRE(small.IsValid() && msaa.IsValid());
+    CHECK_EQ(msaa.Offset % msaaAlignment, 0u);
+    CHECK(!IsOverlapping(small, msaa));
+
+    // 정렬 여백은 다시 쓸 수 있다.
+    TlsfAllocator::Allocation gap = allocator.Allocate(65536, 65536);
+    REQUIRE(gap.IsValid());
+    CHECK(gap.Offset < msaa.Offset);
+    CHECK(allocator.Validate());
+}
+
+TEST_CASE(Tlsf_FailsWhenFull)
+{
+    TlsfAllocator allocator(4096);
+    CHECK(!allocator.Allocate(4097).IsValid());
+
+    TlsfAllocator::Allocation all = allocator.Allocate(4096);
+    REQUIRE(all.IsValid());
+    CHECK(!allocator.Allocate(1).IsValid());
+
+    allocator.Free(all);
+    CHECK(allocator.Allocate(4096).IsValid());
+}
+
+// 임의의 크기/정렬로 할당과 해제를 섞어서 반복한다.
+// 매 단계 내부 구조를 검사하고, 살아 있는 할당끼리 겹치지 않는지 확인한다.
+TEST_CASE(Tlsf_RandomFuzz)
+{
+    for (std::uint64_t seed = 0; seed < 100; ++seed)
+    {
+        Test::Random random(seed);
+        const std::uint64_t size = 1ull << random.Range(10, 29);
+        TlsfAllocator allocator(size);
+
+        std::vector<TlsfAllocator::Allocation> live;
+        std::uint64_t liveBytes = 0;
+        bool isFailed = false;
+
+        for (int step = 0; step < 3000 && !isFailed; ++step)
+        {
+            if (live.empty() || random.Next(3) != 0)
+            {
+                const std::uint64_t maxSize = std::max<std::uint64_t>(size / random.Range(1, 64), 1);
+                const std::uint64_t allocationSize = 1 + random.Next() % maxSize;
+                const std::uint64_t alignment = 1ull << random.Next(17);
+
+                TlsfAllocator::Allocation allocation = allocator.Allocate(allocationSize, alignment);
+                if (!allocation.IsValid())
+                    continue;
+
+                if (allocation.Offset % alignment != 0 || allocation.Offset + allocation.Size > size || allocation.Size != allocationSize)
+                {
+                    Test::Fail(__FILE__, __LINE__, "bad allocation at seed " + std::to_string(seed));
+                    isFailed = true;
+                }
+                for (const TlsfAllocator::Allocation& other : live)
+                {
+                    if (IsOverlapping(allocation, other))
+                    {
+                        Test::Fail(__FILE__, __LINE__, "overlap at seed " + std::to_string(seed));
+                        isFailed = true;
+                        break;
+                    }
+                }
+
+                live.push_back(allocation);
+                liveBytes += allocation.Size;
+            }
+            else
+            {
+                const size_t index = random.Next((std::uint32_t)live.size());
+                allocator.Free(live[index]);
+                liveBytes -= live[index].Size;
+                live[index] = live.back();
+                live.pop_back();
+            }
+
+            if (!allocator.Validate())
+            {
+                Test::Fail(__FILE__, __LINE__, "Validate failed at seed " + std::to_string(seed) + " step " + std::to_string(step));
+                isFailed = true;
+            }
+
+            // 사용량은 요청 크기 합 이상 (정렬 여백 포함)
+            const TlsfAllocator::Stats stats = allocator.GetStats();
+            if (stats.UsedSize < liveBytes || stats.UsedSize + stats.FreeSize != size || stats.AllocationCount != live.size())
+            {
+                Test::Fail(__FILE__, __LINE__, "bad stats at seed " + std::to_string(seed));
+                isFailed = true;
+            }
+        }
+
+        for (const TlsfAllocator::Allocation& allocation : live)
+            allocator.Free(allocation);
+
+        const TlsfAllocator::Stats stats = allocator.GetStats();
+        CHECK(allocator.Validate());
+        CHECK_EQ(stats.FreeBlockCount, 1u);
+        CHECK_EQ(stats.LargestFreeBlock, size);
+        if (isFailed)
+            return;
+    }
+}